@@ -31,12 +31,19 @@
 #include "http/server.hpp"
 #include "muddle/muddle_endpoint.hpp"
 #include "muddle/muddle_interface.hpp"
+#include "muddle/subscription.hpp"
 #include "network/management/network_manager.hpp"
+#include "telemetry/registry.hpp"
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <iostream>
 #include <memory>
+#include <sstream>
+#include <string>
 #include <thread>
+#include <vector>
 
 using namespace fetch;
 using ConstByteArray = byte_array::ConstByteArray;
@@ -255,8 +262,123 @@ int mainXX()
   return 0;
 }
 
-int main()
+uint16_t const BROADCAST_SERVICE = 4000;
+uint16_t const BROADCAST_CHANNEL = 1;
+
+/**
+ * Sum the values of a metric over all of its label sets
+ */
+uint64_t SumMetric(std::string const &metrics, std::string const &name)
+{
+  uint64_t total{0};
+
+  std::istringstream stream{metrics};
+  std::string        line;
+  while (std::getline(stream, line))
+  {
+    bool const matches = (line.compare(0, name.size(), name) == 0) && (line.size() > name.size()) &&
+                         ((line[name.size()] == '{') || (line[name.size()] == ' '));
+    if (matches)
+    {
+      total += static_cast<uint64_t>(std::stod(line.substr(line.rfind(' ') + 1)));
+    }
+  }
+
+  return total;
+}
+
+/**
+ * Send a series of broadcasts through a random mesh of nodes and report how many packets were
+ * needed to deliver them. Each mode should be run in a separate process, since the telemetry is
+ * shared by all the nodes.
+ */
+int RunBroadcastTrial(BroadcastMode mode)
+{
+  uint64_t const    N              = 30;
+  uint64_t const    PEERS_PER_NODE = 4;
+  uint64_t const    NUM_BROADCASTS = 100;
+  std::size_t const PAYLOAD_SIZE   = 1024;
+
+  auto network = Network::New(N, TrackerConfiguration::DefaultConfiguration());
+
+  // a random mesh, with a ring to keep it connected
+  random::LaggedFibonacciGenerator<> rng{42};
+  for (uint64_t i = 0; i < N; ++i)
+  {
+    auto &node = *network->nodes[i];
+    node.muddle->SetBroadcastMode(BROADCAST_SERVICE, BROADCAST_CHANNEL, mode);
+
+    node.muddle->ConnectTo(network->nodes[(i + 1) % N]->address, network->nodes[(i + 1) % N]->uri);
+    for (uint64_t j = 1; j < PEERS_PER_NODE; ++j)
+    {
+      auto const &peer = *network->nodes[rng() % N];
+      if (peer.address != node.address)
+      {
+        node.muddle->ConnectTo(peer.address, peer.uri);
+      }
+    }
+  }
+
+  std::atomic<uint64_t> delivered{0};
+
+  std::vector<MuddleEndpoint::SubscriptionPtr> subscriptions{};
+  for (auto &node : network->nodes)
+  {
+    subscriptions.emplace_back(
+        node->muddle->GetEndpoint().Subscribe(BROADCAST_SERVICE, BROADCAST_CHANNEL));
+    subscriptions.back()->SetMessageHandler(
+        [&delivered](Address const &, ConstByteArray const &) { ++delivered; });
+  }
+
+  sleep_for(std::chrono::seconds{10});
+
+  std::ostringstream before{};
+  telemetry::Registry::Instance().Collect(before);
+
+  ByteArray payload{};
+  payload.Resize(PAYLOAD_SIZE);
+
+  for (uint64_t i = 0; i < NUM_BROADCASTS; ++i)
+  {
+    network->nodes[rng() % N]->muddle->GetEndpoint().Broadcast(BROADCAST_SERVICE,
+                                                               BROADCAST_CHANNEL, payload);
+    sleep_for(milliseconds{100});
+  }
+
+  sleep_for(std::chrono::seconds{10});
+
+  std::ostringstream after{};
+  telemetry::Registry::Instance().Collect(after);
+
+  auto const difference = [&before, &after](std::string const &name) {
+    return SumMetric(after.str(), name) - SumMetric(before.str(), name);
+  };
+
+  std::cout << "Mode                : " << ((mode == BroadcastMode::TREE) ? "tree" : "flood")
+            << '\n';
+  std::cout << "Broadcasts          : " << NUM_BROADCASTS << '\n';
+  std::cout << "Deliveries          : " << delivered << " / " << NUM_BROADCASTS * (N - 1) << '\n';
+  std::cout << "Packets received    : " << difference("ledger_router_rx_packet_total") << '\n';
+  std::cout << "Bytes received      : " << difference("ledger_router_rx_packet_length_sum")
+            << '\n';
+  std::cout << "Duplicate broadcasts: " << difference("ledger_router_bx_duplicate_packet_total")
+            << '\n';
+  std::cout << "Prunes / grafts     : " << difference("ledger_router_broadcast_tree_prunes_total")
+            << " / " << difference("ledger_router_broadcast_tree_grafts_total") << '\n';
+
+  network->Stop();
+  return 0;
+}
+
+int main(int argc, char **argv)
 {
+  // muddle-test-net broadcast [flood|tree]
+  if ((argc > 1) && (std::string{argv[1]} == "broadcast"))
+  {
+    bool const flood = (argc > 2) && (std::string{argv[2]} == "flood");
+    return RunBroadcastTrial(flood ? BroadcastMode::FLOOD : BroadcastMode::TREE);
+  }
+
   auto config                      = fetch::muddle::TrackerConfiguration::AllOn();
   config.max_kademlia_connections  = 2;
   config.max_longrange_connections = 1;
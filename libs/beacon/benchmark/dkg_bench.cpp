@@ -0,0 +1,93 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "beacon/beacon_manager.hpp"
+#include "beacon/create_new_certificate.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace {
+
+using fetch::beacon::CreateNewCertificate;
+using fetch::beacon::ProverPtr;
+using fetch::dkg::BeaconManager;
+
+// Measures the computation one cabinet member performs during a DKG once every other member's
+// coefficients and shares have arrived: checking them, computing its secret share, checking the
+// qual coefficients and computing the public keys. The argument is the cabinet size
+void DkgMemberComputation(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+
+  auto const cabinet_size = static_cast<uint32_t>(state.range(0));
+  uint32_t   threshold    = cabinet_size / 2 + 1;
+
+  std::vector<ProverPtr>                 certificates;
+  std::set<BeaconManager::MuddleAddress> cabinet;
+  for (uint32_t i = 0; i < cabinet_size; ++i)
+  {
+    certificates.push_back(CreateNewCertificate());
+    cabinet.insert(certificates.back()->identity().identifier());
+  }
+
+  std::vector<std::unique_ptr<BeaconManager>> managers;
+  for (auto const &certificate : certificates)
+  {
+    managers.emplace_back(std::make_unique<BeaconManager>(certificate));
+    managers.back()->NewCabinet(cabinet, threshold);
+    managers.back()->GenerateCoefficients();
+  }
+
+  auto &     member  = *managers.front();
+  auto const address = certificates.front()->identity().identifier();
+  for (std::size_t i = 1; i < managers.size(); ++i)
+  {
+    auto const from = certificates[i]->identity().identifier();
+    member.AddCoefficients(from, managers[i]->GetCoefficients());
+    member.AddShares(from, managers[i]->GetOwnShares(address));
+  }
+  member.SetQual(cabinet);
+  for (std::size_t i = 1; i < managers.size(); ++i)
+  {
+    member.AddQualCoefficients(certificates[i]->identity().identifier(),
+                               managers[i]->GetQualCoefficients());
+  }
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(member.ComputeComplaints(cabinet));
+    member.ComputeSecretShare();
+    member.GetQualCoefficients();
+    benchmark::DoNotOptimize(member.ComputeQualComplaints(cabinet));
+    member.ComputePublicKeys();
+  }
+}
+
+}  // namespace
+
+BENCHMARK(DkgMemberComputation)
+    ->Arg(10)
+    ->Arg(50)
+    ->Arg(100)
+    ->Arg(200)
+    ->Unit(benchmark::kMillisecond);
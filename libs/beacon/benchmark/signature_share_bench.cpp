@@ -0,0 +1,108 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "beacon/beacon_manager.hpp"
+#include "beacon/create_new_certificate.hpp"
+#include "beacon/trusted_dealer.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace {
+
+using fetch::beacon::CreateNewCertificate;
+using fetch::beacon::ProverPtr;
+using fetch::beacon::TrustedDealer;
+using fetch::dkg::BeaconManager;
+
+// Measures the rounds per second a single node can verify, where each round consists of adding
+// the signature shares of a threshold of the cabinet and computing the group signature. The
+// first argument is the cabinet size and the second whether shares are verified in batches
+void SignatureShareVerification(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+
+  auto const cabinet_size = static_cast<uint32_t>(state.range(0));
+  bool const batch        = state.range(1) != 0;
+  double     threshold    = 0.5;
+
+  std::vector<ProverPtr>                 certificates;
+  std::set<BeaconManager::MuddleAddress> cabinet;
+  for (uint32_t i = 0; i < cabinet_size; ++i)
+  {
+    certificates.push_back(CreateNewCertificate());
+    cabinet.insert(certificates.back()->identity().identifier());
+  }
+
+  TrustedDealer                       dealer{cabinet, threshold};
+  BeaconManager::MessagePayload const message = "Hello";
+  auto const signing_threshold = static_cast<uint32_t>(threshold * cabinet_size) + 1;
+
+  std::vector<std::unique_ptr<BeaconManager>> managers;
+  std::vector<BeaconManager::SignedMessage>   shares;
+  for (auto const &certificate : certificates)
+  {
+    managers.emplace_back(std::make_unique<BeaconManager>(certificate));
+    auto &manager = *managers.back();
+    manager.NewCabinet(cabinet, signing_threshold);
+    manager.SetDkgOutput(dealer.GetDkgKeys(certificate->identity().identifier()));
+    manager.SetMessage(message);
+    shares.push_back(manager.Sign());
+  }
+
+  auto &verifier = *managers.front();
+  verifier.SetBatchVerification(batch);
+
+  for (auto _ : state)
+  {
+    verifier.SetMessage(message);
+    for (auto const &share : shares)
+    {
+      verifier.AddSignaturePart(share.identity, share.signature);
+      if (verifier.can_verify())
+      {
+        break;
+      }
+    }
+
+    verifier.VerifySignatureParts();
+    benchmark::DoNotOptimize(verifier.Verify());
+  }
+
+  state.counters["rounds_per_second"] =
+      benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+
+void CabinetArguments(benchmark::internal::Benchmark *b)
+{
+  for (int64_t cabinet_size : {10, 50, 100, 200})
+  {
+    b->Args({cabinet_size, 0});
+    b->Args({cabinet_size, 1});
+  }
+
+  b->ArgNames({"cabinet", "batch"})->Unit(benchmark::kMillisecond);
+}
+
+}  // namespace
+
+BENCHMARK(SignatureShareVerification)->Apply(CabinetArguments);
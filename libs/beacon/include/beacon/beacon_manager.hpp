@@ -74,14 +74,20 @@ public:
   void AddShares(MuddleAddress const &from, std::pair<Share, Share> const &shares);
   std::set<MuddleAddress> ComputeComplaints(std::set<MuddleAddress> const &coeff_received);
   bool VerifyComplaintAnswer(MuddleAddress const &from, ComplaintAnswer const &answer);
+  std::vector<bool> VerifyComplaintAnswers(
+      std::vector<std::pair<MuddleAddress, ComplaintAnswer>> const &answers);
   void ComputeSecretShare();
   std::vector<Coefficient> GetQualCoefficients();
   void AddQualCoefficients(MuddleAddress const &from, std::vector<Coefficient> const &coefficients);
   SharesExposedMap ComputeQualComplaints(std::set<MuddleAddress> const &coeff_received);
   MuddleAddress    VerifyQualComplaint(MuddleAddress const &from, ComplaintAnswer const &answer);
+  std::vector<MuddleAddress> VerifyQualComplaints(
+      std::vector<std::pair<MuddleAddress, ComplaintAnswer>> const &complaints);
   void             ComputePublicKeys();
   void             AddReconstructionShare(MuddleAddress const &address);
   void             VerifyReconstructionShare(MuddleAddress const &from, ExposedShare const &share);
+  void VerifyReconstructionShares(
+      std::vector<std::pair<MuddleAddress, ExposedShare>> const &shares);
   bool             RunReconstruction();
   DkgOutput        GetDkgOutput();
   void             SetDkgOutput(DkgOutput const &output);
@@ -89,8 +95,10 @@ public:
   void             NewCabinet(std::set<MuddleAddress> const &cabinet, uint32_t threshold);
   void             Reset();
 
-  AddResult     AddSignaturePart(Identity const &from, Signature const &signature);
-  bool          Verify();
+  void                  SetBatchVerification(bool enabled);
+  AddResult             AddSignaturePart(Identity const &from, Signature const &signature);
+  std::vector<Identity> VerifySignatureParts();
+  bool                  Verify();
   bool          Verify(Signature const &signature);
   static bool   Verify(byte_array::ConstByteArray const &group_public_key,
                        MessagePayload const &message, byte_array::ConstByteArray const &signature);
@@ -150,14 +158,20 @@ private:
 
   /// Message signature management
   /// @{
-  std::unordered_set<MuddleAddress>           already_signed_;
-  std::unordered_map<CabinetIndex, Signature> signature_buffer_;
-  MessagePayload                              current_message_;
-  Signature                                   group_signature_;
+  bool                                            batch_verification_{false};
+  std::unordered_set<MuddleAddress>               already_signed_;
+  std::unordered_map<CabinetIndex, Signature>     signature_buffer_;
+  std::unordered_map<CabinetIndex, SignedMessage> pending_signatures_;  ///< Awaiting verification
+  MessagePayload                                  current_message_;
+  Signature                                       group_signature_;
   /// }
 
   void AddReconstructionShare(MuddleAddress const &                  from,
                               std::pair<MuddleAddress, Share> const &share);
+  bool SharesMatchCoefficients(CabinetIndex dealer, CabinetIndex receiver, PrivateKey const &s,
+                               PrivateKey const &sprime) const;
+  bool ShareMatchesQualCoefficients(CabinetIndex dealer, CabinetIndex receiver,
+                                    PrivateKey const &s) const;
 };
 }  // namespace dkg
 
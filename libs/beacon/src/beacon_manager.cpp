@@ -20,8 +20,14 @@
 #include "core/synchronisation/protected.hpp"
 #include "crypto/ecdsa.hpp"
 #include "network/generics/milli_timer.hpp"
+#include "vectorise/threading/pool.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <future>
 #include <mutex>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -83,6 +89,57 @@ private:
 
 Protected<CurveParameters> curve_params_{};
 
+/**
+ * Worker pool shared by all beacon managers for checking the contributions of different members
+ */
+threading::Pool &VerificationPool()
+{
+  static threading::Pool pool{std::max(1u, std::thread::hardware_concurrency()), "DkgVerify"};
+  return pool;
+}
+
+/**
+ * Calls function(i) for every i in [0, count) on the verification pool. The calls must be
+ * independent of each other; results are expected to be written to per index slots and merged
+ * by the caller in index order, which keeps the outcome deterministic
+ */
+template <typename Function>
+void ParallelFor(std::size_t count, Function const &function)
+{
+  auto &            pool       = VerificationPool();
+  std::size_t const num_chunks = std::min(count, pool.concurrency());
+
+  if (num_chunks <= 1)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      function(i);
+    }
+    return;
+  }
+
+  std::vector<std::future<void>> futures;
+  futures.reserve(num_chunks);
+  for (std::size_t chunk = 0; chunk < num_chunks; ++chunk)
+  {
+    std::size_t const begin = (count * chunk) / num_chunks;
+    std::size_t const end   = (count * (chunk + 1)) / num_chunks;
+
+    futures.emplace_back(pool.Dispatch([&function, begin, end]() {
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        function(i);
+      }
+    }));
+  }
+
+  // get() rethrows anything raised by a check
+  for (auto &future : futures)
+  {
+    future.get();
+  }
+}
+
 }  // namespace
 
 constexpr char const *LOGGING_NAME = "BeaconManager";
@@ -187,23 +244,35 @@ void BeaconManager::AddShares(MuddleAddress const &from, std::pair<Share, Share>
 std::set<BeaconManager::MuddleAddress> BeaconManager::ComputeComplaints(
     std::set<MuddleAddress> const &coeff_received)
 {
-  std::set<MuddleAddress> complaints_local;
+  std::vector<std::pair<MuddleAddress, CabinetIndex>> dealers;
   for (auto &cab : coeff_received)
   {
     CabinetIndex i = identity_to_index_[cab];
     if (i != cabinet_index_)
     {
-      PublicKey rhs;
-      PublicKey lhs;
-      lhs = crypto::mcl::ComputeLHS(g__s_ij[i][cabinet_index_], GetGroupG(), GetGroupH(),
-                                    s_ij[i][cabinet_index_], sprime_ij[i][cabinet_index_]);
-      rhs = crypto::mcl::ComputeRHS(cabinet_index_, C_ik[i]);
-      if (lhs != rhs || lhs.isZero())
-      {
-        FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_,
-                       " received bad coefficients/shares from node ", i);
-        complaints_local.insert(cab);
-      }
+      dealers.emplace_back(cab, i);
+    }
+  }
+
+  // Each check only writes the g__s_ij entry of its own dealer
+  std::vector<uint8_t> failed(dealers.size(), 0);
+  ParallelFor(dealers.size(), [this, &dealers, &failed](std::size_t d) {
+    CabinetIndex const i   = dealers[d].second;
+    PublicKey const    lhs = crypto::mcl::ComputeLHS(g__s_ij[i][cabinet_index_], GetGroupG(),
+                                                  GetGroupH(), s_ij[i][cabinet_index_],
+                                                  sprime_ij[i][cabinet_index_]);
+    PublicKey const    rhs = crypto::mcl::ComputeRHS(cabinet_index_, C_ik[i]);
+    failed[d]              = static_cast<uint8_t>(lhs != rhs || lhs.isZero());
+  });
+
+  std::set<MuddleAddress> complaints_local;
+  for (std::size_t d = 0; d < dealers.size(); ++d)
+  {
+    if (failed[d] != 0)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_,
+                     " received bad coefficients/shares from node ", dealers[d].second);
+      complaints_local.insert(dealers[d].first);
     }
   }
   return complaints_local;
@@ -211,36 +280,60 @@ std::set<BeaconManager::MuddleAddress> BeaconManager::ComputeComplaints(
 
 bool BeaconManager::VerifyComplaintAnswer(MuddleAddress const &from, ComplaintAnswer const &answer)
 {
-  CabinetIndex from_index = identity_to_index_[from];
-  assert(identity_to_index_.find(answer.first) != identity_to_index_.end());
-  CabinetIndex reporter_index = identity_to_index_[answer.first];
-  // Verify shares received
-  PrivateKey s;
-  PrivateKey sprime;
-  PublicKey  lhsG;
-  PublicKey  rhsG;
-  s      = answer.second.first;
-  sprime = answer.second.second;
-  rhsG   = crypto::mcl::ComputeRHS(reporter_index, C_ik[from_index]);
-  lhsG   = crypto::mcl::ComputeLHS(GetGroupG(), GetGroupH(), s, sprime);
-  if (lhsG != rhsG || lhsG.isZero())
-  {
-    FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_, " verification for node ", from_index,
-                   " complaint answer failed");
-    return false;
+  return VerifyComplaintAnswers({{from, answer}}).front();
+}
+
+/**
+ * Checks complaint answers, each consisting of the sender of the answer and the shares it exposed
+ * for the member which complained. The checks run in parallel and their results are applied in
+ * the order given
+ *
+ * @return Whether each answer is valid
+ */
+std::vector<bool> BeaconManager::VerifyComplaintAnswers(
+    std::vector<std::pair<MuddleAddress, ComplaintAnswer>> const &answers)
+{
+  std::vector<std::pair<CabinetIndex, CabinetIndex>> indices;
+  indices.reserve(answers.size());
+  for (auto const &answer : answers)
+  {
+    assert(identity_to_index_.find(answer.second.first) != identity_to_index_.end());
+    indices.emplace_back(identity_to_index_[answer.first], identity_to_index_[answer.second.first]);
   }
 
-  FETCH_LOG_INFO(LOGGING_NAME, "Node ", cabinet_index_, " verification for node ", from_index,
-                 " complaint answer succeeded");
-  if (reporter_index == cabinet_index_)
+  std::vector<uint8_t> valid(answers.size(), 0);
+  ParallelFor(answers.size(), [this, &answers, &indices, &valid](std::size_t a) {
+    auto const &shares = answers[a].second.second;
+    valid[a]           = static_cast<uint8_t>(
+        SharesMatchCoefficients(indices[a].first, indices[a].second, shares.first, shares.second));
+  });
+
+  std::vector<bool> results(answers.size(), false);
+  for (std::size_t a = 0; a < answers.size(); ++a)
   {
-    FETCH_LOG_INFO(LOGGING_NAME, "Node ", cabinet_index_, " reset shares for ", from_index);
-    s_ij[from_index][cabinet_index_]      = s;
-    sprime_ij[from_index][cabinet_index_] = sprime;
-    g__s_ij[from_index][cabinet_index_].clear();
-    bn::G2::mul(g__s_ij[from_index][cabinet_index_], GetGroupG(), s_ij[from_index][cabinet_index_]);
+    CabinetIndex const from_index     = indices[a].first;
+    CabinetIndex const reporter_index = indices[a].second;
+    if (valid[a] == 0)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_, " verification for node ", from_index,
+                     " complaint answer failed");
+      continue;
+    }
+
+    FETCH_LOG_INFO(LOGGING_NAME, "Node ", cabinet_index_, " verification for node ", from_index,
+                   " complaint answer succeeded");
+    if (reporter_index == cabinet_index_)
+    {
+      FETCH_LOG_INFO(LOGGING_NAME, "Node ", cabinet_index_, " reset shares for ", from_index);
+      s_ij[from_index][cabinet_index_]      = answers[a].second.second.first;
+      sprime_ij[from_index][cabinet_index_] = answers[a].second.second.second;
+      g__s_ij[from_index][cabinet_index_].clear();
+      bn::G2::mul(g__s_ij[from_index][cabinet_index_], GetGroupG(),
+                  s_ij[from_index][cabinet_index_]);
+    }
+    results[a] = true;
   }
-  return true;
+  return results;
 }
 
 /**
@@ -294,33 +387,48 @@ void BeaconManager::AddQualCoefficients(MuddleAddress const &           from,
 BeaconManager::SharesExposedMap BeaconManager::ComputeQualComplaints(
     std::set<MuddleAddress> const &coeff_received)
 {
-  SharesExposedMap qual_complaints;
-
+  std::vector<std::pair<MuddleAddress, CabinetIndex>> dealers;
   for (auto const &miner : qual_)
   {
     CabinetIndex i = identity_to_index_[miner];
     if (i != cabinet_index_)
     {
-      if (coeff_received.find(miner) != coeff_received.end())
-      {
-        PublicKey rhs;
-        PublicKey lhs;
-        lhs = g__s_ij[i][cabinet_index_];
-        rhs = crypto::mcl::ComputeRHS(cabinet_index_, A_ik[i]);
-        if (lhs != rhs || rhs.isZero())
-        {
-          FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_,
-                         " received qual coefficients from node ", i, " which failed verification");
-          qual_complaints.insert({miner, {s_ij[i][cabinet_index_], sprime_ij[i][cabinet_index_]}});
-        }
-      }
-      else
-      {
-        FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_,
-                       " did not receive qual coefficients from node ", i);
-        qual_complaints.insert({miner, {s_ij[i][cabinet_index_], sprime_ij[i][cabinet_index_]}});
-      }
+      dealers.emplace_back(miner, i);
+    }
+  }
+
+  std::vector<uint8_t> failed(dealers.size(), 1);
+  ParallelFor(dealers.size(), [this, &dealers, &coeff_received, &failed](std::size_t d) {
+    if (coeff_received.find(dealers[d].first) != coeff_received.end())
+    {
+      CabinetIndex const i   = dealers[d].second;
+      PublicKey const &  lhs = g__s_ij[i][cabinet_index_];
+      PublicKey const    rhs = crypto::mcl::ComputeRHS(cabinet_index_, A_ik[i]);
+      failed[d]              = static_cast<uint8_t>(lhs != rhs || rhs.isZero());
+    }
+  });
+
+  SharesExposedMap qual_complaints;
+  for (std::size_t d = 0; d < dealers.size(); ++d)
+  {
+    auto const &       miner = dealers[d].first;
+    CabinetIndex const i     = dealers[d].second;
+    if (failed[d] == 0)
+    {
+      continue;
+    }
+
+    if (coeff_received.find(miner) != coeff_received.end())
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_,
+                     " received qual coefficients from node ", i, " which failed verification");
+    }
+    else
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_,
+                     " did not receive qual coefficients from node ", i);
     }
+    qual_complaints.insert({miner, {s_ij[i][cabinet_index_], sprime_ij[i][cabinet_index_]}});
   }
   return qual_complaints;
 }
@@ -328,38 +436,78 @@ BeaconManager::SharesExposedMap BeaconManager::ComputeQualComplaints(
 BeaconManager::MuddleAddress BeaconManager::VerifyQualComplaint(MuddleAddress const &  from,
                                                                 ComplaintAnswer const &answer)
 {
-  CabinetIndex from_index   = identity_to_index_[from];
-  CabinetIndex victim_index = identity_to_index_[answer.first];
+  return VerifyQualComplaints({{from, answer}}).front();
+}
 
-  PublicKey  lhs;
-  PublicKey  rhs;
-  PrivateKey s;
-  PrivateKey sprime;
-  s      = answer.second.first;
-  sprime = answer.second.second;
-  lhs    = crypto::mcl::ComputeLHS(GetGroupG(), GetGroupH(), s, sprime);
-  rhs    = crypto::mcl::ComputeRHS(from_index, C_ik[victim_index]);
-  if (lhs != rhs || lhs.isZero())
+/**
+ * Checks qual complaints, each consisting of the member which complained and the shares it
+ * exposed for the member complained against. The checks run in parallel
+ *
+ * @return For each complaint, the member found to be at fault
+ */
+std::vector<BeaconManager::MuddleAddress> BeaconManager::VerifyQualComplaints(
+    std::vector<std::pair<MuddleAddress, ComplaintAnswer>> const &complaints)
+{
+  std::vector<std::pair<CabinetIndex, CabinetIndex>> indices;
+  indices.reserve(complaints.size());
+  for (auto const &complaint : complaints)
   {
-    FETCH_LOG_DEBUG(LOGGING_NAME, "Node ", cabinet_index_,
-                    " received shares failing initial coefficients verification from node ",
-                    from_index, " for node ", victim_index);
-    return from;
+    indices.emplace_back(identity_to_index_[complaint.first],
+                         identity_to_index_[complaint.second.first]);
   }
 
-  bn::G2::mul(lhs, GetGroupG(), s);  // G^s
-  rhs = crypto::mcl::ComputeRHS(from_index, A_ik[victim_index]);
-  if (lhs != rhs || rhs.isZero())
+  enum : uint8_t
   {
-    FETCH_LOG_DEBUG(LOGGING_NAME, "Node ", cabinet_index_,
-                    " received shares failing qual coefficients verification from node ",
-                    from_index, " for node ", victim_index);
-    return answer.first;
-  }
+    COMPLAINER_AT_FAULT,
+    COMPLAINER_FAILS_INITIAL_CHECK,
+    VICTIM_AT_FAULT
+  };
+
+  std::vector<uint8_t> outcome(complaints.size(), COMPLAINER_AT_FAULT);
+  ParallelFor(complaints.size(), [this, &complaints, &indices, &outcome](std::size_t c) {
+    CabinetIndex const from_index   = indices[c].first;
+    CabinetIndex const victim_index = indices[c].second;
+    auto const &       shares       = complaints[c].second.second;
+
+    if (!SharesMatchCoefficients(victim_index, from_index, shares.first, shares.second))
+    {
+      outcome[c] = COMPLAINER_FAILS_INITIAL_CHECK;
+    }
+    else if (!ShareMatchesQualCoefficients(victim_index, from_index, shares.first))
+    {
+      outcome[c] = VICTIM_AT_FAULT;
+    }
+  });
+
+  std::vector<MuddleAddress> results;
+  results.reserve(complaints.size());
+  for (std::size_t c = 0; c < complaints.size(); ++c)
+  {
+    CabinetIndex const from_index   = indices[c].first;
+    CabinetIndex const victim_index = indices[c].second;
 
-  FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_, " received incorrect complaint from ",
-                 from_index);
-  return from;
+    switch (outcome[c])
+    {
+    case COMPLAINER_FAILS_INITIAL_CHECK:
+      FETCH_LOG_DEBUG(LOGGING_NAME, "Node ", cabinet_index_,
+                      " received shares failing initial coefficients verification from node ",
+                      from_index, " for node ", victim_index);
+      results.push_back(complaints[c].first);
+      break;
+    case VICTIM_AT_FAULT:
+      FETCH_LOG_DEBUG(LOGGING_NAME, "Node ", cabinet_index_,
+                      " received shares failing qual coefficients verification from node ",
+                      from_index, " for node ", victim_index);
+      results.push_back(complaints[c].second.first);
+      break;
+    default:
+      FETCH_LOG_WARN(LOGGING_NAME, "Node ", cabinet_index_, " received incorrect complaint from ",
+                     from_index);
+      results.push_back(complaints[c].first);
+      break;
+    }
+  }
+  return results;
 }
 
 /**
@@ -383,17 +531,24 @@ void BeaconManager::ComputePublicKeys()
     bn::G2::add(public_key_, public_key_, y_i[it]);
   }
   // Compute public_key_shares_ $v_j = \prod_{i \in QUAL} \prod_{k=0}^t (A_{ik})^{j^k} \bmod
-  // p$
-  for (auto const &jq : qual_)
+  // p$ as $\prod_{k=0}^t (A_k)^{j^k}$, where $A_k = \prod_{i \in QUAL} A_{ik}$, so that the
+  // polynomial is evaluated once per member rather than once per pair of members
+  std::vector<PublicKey> qual_coefficients;
+  crypto::mcl::Init(qual_coefficients, polynomial_degree_ + 1);
+  for (auto const &iq : qual_)
   {
-    CabinetIndex jt = identity_to_index_[jq];
-    for (auto const &iq : qual_)
+    CabinetIndex it = identity_to_index_[iq];
+    for (std::size_t k = 0; k <= polynomial_degree_; k++)
     {
-      CabinetIndex it = identity_to_index_[iq];
-      bn::G2::add(public_key_shares_[jt], public_key_shares_[jt], A_ik[it][0]);
-      crypto::mcl::UpdateRHS(jt, public_key_shares_[jt], A_ik[it]);
+      bn::G2::add(qual_coefficients[k], qual_coefficients[k], A_ik[it][k]);
     }
   }
+  for (auto const &jq : qual_)
+  {
+    CabinetIndex jt = identity_to_index_[jq];
+    bn::G2::add(public_key_shares_[jt], public_key_shares_[jt],
+                crypto::mcl::ComputeRHS(jt, qual_coefficients));
+  }
 
   FETCH_LOG_DEBUG(LOGGING_NAME, "Node ", cabinet_index_, " compute public keys end.");
 }
@@ -435,27 +590,71 @@ void BeaconManager::AddReconstructionShare(MuddleAddress const &
 
 void BeaconManager::VerifyReconstructionShare(MuddleAddress const &from, ExposedShare const &share)
 {
-  CabinetIndex victim_index = identity_to_index_[share.first];
-  PublicKey    lhs;
-  PublicKey    rhs;
-  PrivateKey   s;
-  PrivateKey   sprime;
-  s      = share.second.first;
-  sprime = share.second.second;
-  lhs    = crypto::mcl::ComputeLHS(GetGroupG(), GetGroupH(), s, sprime);
-  rhs    = crypto::mcl::ComputeRHS(identity_to_index_[from], C_ik[victim_index]);
+  VerifyReconstructionShares({{from, share}});
+}
 
-  if (lhs == rhs && !lhs.isZero())
+/**
+ * Checks reconstruction shares, each consisting of the sender and the shares it exposed, in
+ * parallel. Valid shares are then added in the order given
+ */
+void BeaconManager::VerifyReconstructionShares(
+    std::vector<std::pair<MuddleAddress, ExposedShare>> const &shares)
+{
+  std::vector<std::pair<CabinetIndex, CabinetIndex>> indices;
+  indices.reserve(shares.size());
+  for (auto const &share : shares)
   {
-    AddReconstructionShare(from, {share.first, share.second.first});
+    indices.emplace_back(identity_to_index_[share.first], identity_to_index_[share.second.first]);
   }
-  else
+
+  std::vector<uint8_t> valid(shares.size(), 0);
+  ParallelFor(shares.size(), [this, &shares, &indices, &valid](std::size_t e) {
+    auto const &exposed = shares[e].second.second;
+    bool const  matches = SharesMatchCoefficients(indices[e].second, indices[e].first,
+                                                  exposed.first, exposed.second);
+    valid[e]            = static_cast<uint8_t>(matches);
+  });
+
+  for (std::size_t e = 0; e < shares.size(); ++e)
   {
-    FETCH_LOG_DEBUG(LOGGING_NAME, "Node ", cabinet_index_, "received bad share from node ",
-                    identity_to_index_[from], "for reconstructing node ", victim_index);
+    auto const &share = shares[e].second;
+    if (valid[e] != 0)
+    {
+      AddReconstructionShare(shares[e].first, {share.first, share.second.first});
+    }
+    else
+    {
+      FETCH_LOG_DEBUG(LOGGING_NAME, "Node ", cabinet_index_, "received bad share from node ",
+                      indices[e].first, "for reconstructing node ", indices[e].second);
+    }
   }
 }
 
+/**
+ * Checks that the shares s, s' which dealer gave receiver are consistent with the dealer's
+ * initial coefficients
+ */
+bool BeaconManager::SharesMatchCoefficients(CabinetIndex dealer, CabinetIndex receiver,
+                                            PrivateKey const &s, PrivateKey const &sprime) const
+{
+  PublicKey const lhs = crypto::mcl::ComputeLHS(GetGroupG(), GetGroupH(), s, sprime);
+  PublicKey const rhs = crypto::mcl::ComputeRHS(receiver, C_ik[dealer]);
+  return lhs == rhs && !lhs.isZero();
+}
+
+/**
+ * Checks that the share s which dealer gave receiver is consistent with the dealer's qual
+ * coefficients
+ */
+bool BeaconManager::ShareMatchesQualCoefficients(CabinetIndex dealer, CabinetIndex receiver,
+                                                 PrivateKey const &s) const
+{
+  PublicKey lhs;
+  bn::G2::mul(lhs, GetGroupG(), s);  // G^s
+  PublicKey const rhs = crypto::mcl::ComputeRHS(receiver, A_ik[dealer]);
+  return lhs == rhs && !rhs.isZero();
+}
+
 /**
  * Run polynomial interpolation on the exposed secret shares of other cabinet members to
  * recontruct their random polynomials
@@ -567,11 +766,30 @@ void BeaconManager::Reset()
   reconstruction_shares.clear();
 }
 
+/**
+ * @brief enables or disables batch verification of signature shares.
+ *
+ * In batch mode AddSignaturePart only checks the sender and defers the (two pairing) share
+ * verification. The deferred shares are checked together by VerifySignatureParts, which costs
+ * two pairings for the whole batch unless it contains invalid shares.
+ * @param enabled whether shares should be verified in batches.
+ */
+void BeaconManager::SetBatchVerification(bool enabled)
+{
+  if (!enabled && !pending_signatures_.empty())
+  {
+    VerifySignatureParts();
+  }
+
+  batch_verification_ = enabled;
+}
+
 /**
  * @brief adds a signature share.
  * @param from is the identity of the sending node.
- * @param public_key is the public key of the peer.
  * @param signature is the signature part.
+ * @return the result of the addition. In batch mode SUCCESS only means the share has been
+ * accepted for verification.
  */
 
 BeaconManager::AddResult BeaconManager::AddSignaturePart(Identity const & from,
@@ -590,7 +808,14 @@ BeaconManager::AddResult BeaconManager::AddSignaturePart(Identity const & from,
     return AddResult::SIGNATURE_ALREADY_ADDED;
   }
 
-  uint64_t n = it->second;
+  CabinetIndex n = it->second;
+  if (batch_verification_)
+  {
+    pending_signatures_.insert({n, SignedMessage{signature, from}});
+    already_signed_.insert(from.identifier());
+    return AddResult::SUCCESS;
+  }
+
   if (!crypto::mcl::VerifySign(public_key_shares_[n], current_message_, signature, GetGroupG()))
   {
     return AddResult::INVALID_SIGNATURE;
@@ -601,11 +826,68 @@ BeaconManager::AddResult BeaconManager::AddSignaturePart(Identity const & from,
   return AddResult::SUCCESS;
 }
 
+/**
+ * @brief verifies the signature shares deferred in batch mode.
+ *
+ * Valid shares become available for computing the group signature. Senders of invalid shares
+ * are forgotten, so that a valid share from them can still be added.
+ * @return the identities of the senders of invalid shares.
+ */
+std::vector<BeaconManager::Identity> BeaconManager::VerifySignatureParts()
+{
+  std::vector<Identity> invalid_senders;
+  if (pending_signatures_.empty())
+  {
+    return invalid_senders;
+  }
+
+  std::vector<CabinetIndex> indices;
+  std::vector<PublicKey>    public_keys;
+  std::vector<Signature>    signatures;
+  indices.reserve(pending_signatures_.size());
+  public_keys.reserve(pending_signatures_.size());
+  signatures.reserve(pending_signatures_.size());
+
+  for (auto const &pending : pending_signatures_)
+  {
+    indices.push_back(pending.first);
+    public_keys.push_back(public_key_shares_[pending.first]);
+    signatures.push_back(pending.second.signature);
+  }
+
+  auto const invalid =
+      crypto::mcl::FindInvalidSignShares(public_keys, current_message_, signatures, GetGroupG());
+
+  auto next_invalid = invalid.begin();
+  for (std::size_t i = 0; i < indices.size(); ++i)
+  {
+    if ((next_invalid != invalid.end()) && (*next_invalid == i))
+    {
+      auto const &sender = pending_signatures_[indices[i]].identity;
+      already_signed_.erase(sender.identifier());
+      invalid_senders.push_back(sender);
+      ++next_invalid;
+      continue;
+    }
+
+    signature_buffer_.insert({indices[i], signatures[i]});
+  }
+
+  pending_signatures_.clear();
+  return invalid_senders;
+}
+
 /**
  * @brief verifies the group signature.
  */
 bool BeaconManager::Verify()
 {
+  VerifySignatureParts();
+  if (signature_buffer_.size() < polynomial_degree_ + 1)
+  {
+    return false;
+  }
+
   group_signature_ = crypto::mcl::LagrangeInterpolation(signature_buffer_);
   return Verify(group_signature_);
 }
@@ -664,6 +946,7 @@ void BeaconManager::SetMessage(MessagePayload next_message)
 {
   current_message_ = std::move(next_message);
   signature_buffer_.clear();
+  pending_signatures_.clear();
   already_signed_.clear();
   group_signature_.clear();
 }
@@ -715,7 +998,7 @@ BeaconManager::CabinetIndex BeaconManager::cabinet_index(MuddleAddress const &ad
 
 bool BeaconManager::can_verify()
 {
-  return signature_buffer_.size() >= polynomial_degree_ + 1;
+  return signature_buffer_.size() + pending_signatures_.size() >= polynomial_degree_ + 1;
 }
 
 std::string BeaconManager::group_public_key() const
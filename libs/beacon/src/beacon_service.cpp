@@ -271,6 +271,9 @@ BeaconService::State BeaconService::OnWaitForSetupCompletionState()
       block_entropy_being_created_ =
           std::make_shared<BlockEntropy>(active_exe_unit_->block_entropy);
 
+      // Signature shares are collected in bulk from peers, so verify them in batches
+      active_exe_unit_->manager.SetBatchVerification(true);
+
       // TODO(HUT): re-enable this check after fixing the dealer test
       /* assert(block_entropy_being_created_->IsAeonBeginning()); */
 
@@ -486,6 +489,16 @@ BeaconService::State BeaconService::OnVerifySignaturesState()
 
   MilliTimer const timer2{"Verify threshold signature", 100};
 
+  // The shares collected above are verified together, only paying for individual checks when
+  // the batch contains invalid shares
+  for (auto const &sender : active_exe_unit_->manager.VerifySignatureParts())
+  {
+    FETCH_LOG_ERROR(LOGGING_NAME, "Signature invalid. Identity: ", sender.identifier().ToBase64());
+
+    EventInvalidSignature event;
+    event_manager_->Dispatch(event);
+  }
+
   // TODO(HUT): possibility for infinite loop here I suspect.
   if (active_exe_unit_->manager.can_verify() && active_exe_unit_->manager.Verify())
   {
@@ -684,6 +684,7 @@ BeaconSetupService::State BeaconSetupService::OnWaitForReconstructionShares()
   {
     // Process reconstruction shares. Reconstruction shares from non-qual members
     // or people in qual complaints should not be considered
+    std::vector<std::pair<MuddleAddress, BeaconManager::ExposedShare>> shares_to_verify;
     for (auto const &share : reconstruction_shares_received_)
     {
       MuddleAddress from = share.first;
@@ -698,10 +699,11 @@ BeaconSetupService::State BeaconSetupService::OnWaitForReconstructionShares()
         // Check person who's shares are being exposed is a member of qual
         if (beacon_->manager.InQual(elem.first))
         {
-          beacon_->manager.VerifyReconstructionShare(from, elem);
+          shares_to_verify.emplace_back(from, elem);
         }
       }
     }
+    beacon_->manager.VerifyReconstructionShares(shares_to_verify);
 
     // Reset if reconstruction fails as this breaks the initial assumption on the
     // number of Byzantine nodes
@@ -1364,6 +1366,9 @@ std::set<BeaconSetupService::MuddleAddress> BeaconSetupService::ComputeComplaint
 void BeaconSetupService::CheckComplaintAnswers()
 {
   auto answer_messages = complaint_answers_manager_.ComplaintAnswersReceived();
+
+  // Collect the answers to verify so that they can be checked in parallel
+  std::vector<std::pair<MuddleAddress, BeaconManager::ComplaintAnswer>> answers_to_verify;
   for (auto const &sender_answers : answer_messages)
   {
     MuddleAddress from = sender_answers.first;
@@ -1375,10 +1380,7 @@ void BeaconSetupService::CheckComplaintAnswers()
       if (complaints_manager_.FindComplaint(from, share.first))
       {
         answered_complaints.insert(share.first);
-        if (!beacon_->manager.VerifyComplaintAnswer(from, share))
-        {
-          complaint_answers_manager_.AddComplaintAgainst(from);
-        }
+        answers_to_verify.emplace_back(from, share);
       }
     }
 
@@ -1388,6 +1390,15 @@ void BeaconSetupService::CheckComplaintAnswers()
       complaint_answers_manager_.AddComplaintAgainst(from);
     }
   }
+
+  auto const valid = beacon_->manager.VerifyComplaintAnswers(answers_to_verify);
+  for (std::size_t i = 0; i < answers_to_verify.size(); ++i)
+  {
+    if (!valid[i])
+    {
+      complaint_answers_manager_.AddComplaintAgainst(answers_to_verify[i].first);
+    }
+  }
 }
 
 /**
@@ -1427,6 +1438,8 @@ bool BeaconSetupService::BuildQual()
 void BeaconSetupService::CheckQualComplaints()
 {
   std::set<MuddleAddress> qual{beacon_->manager.qual()};
+
+  std::vector<std::pair<MuddleAddress, BeaconManager::ComplaintAnswer>> complaints_to_verify;
   for (const auto &complaint : qual_complaints_manager_.ComplaintsReceived())
   {
     MuddleAddress sender = complaint.first;
@@ -1435,11 +1448,15 @@ void BeaconSetupService::CheckQualComplaints()
       // Check person who's shares are being exposed is not in QUAL then don't bother with checks
       if (qual.find(share.first) != qual.end())
       {
-        qual_complaints_manager_.AddComplaintAgainst(
-            beacon_->manager.VerifyQualComplaint(sender, share));
+        complaints_to_verify.emplace_back(sender, share);
       }
     }
   }
+
+  for (auto const &culprit : beacon_->manager.VerifyQualComplaints(complaints_to_verify))
+  {
+    qual_complaints_manager_.AddComplaintAgainst(culprit);
+  }
 }
 
 /**
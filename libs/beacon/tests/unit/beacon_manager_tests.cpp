@@ -255,6 +255,11 @@ TEST(beacon_manager, dkg_and_threshold_signing)
   BeaconManager::ComplaintAnswer fail_check2 = {malicious,
                                                 beacon_managers[1]->GetReceivedShares(malicious)};
   EXPECT_EQ(malicious, beacon_managers[0]->VerifyQualComplaint(honest, fail_check2));
+  // Checking the complaints together gives the same verdicts in the same order
+  EXPECT_EQ(beacon_managers[0]->VerifyQualComplaints({{malicious, incorrect_complaint},
+                                                      {honest, fail_check1},
+                                                      {honest, fail_check2}}),
+            (std::vector<MuddleAddress>{malicious, honest, malicious}));
 
   // Verify invalid reconstruction share
   BeaconManager::ComplaintAnswer incorrect_reconstruction_share = {honest, wrong_shares};
@@ -359,4 +364,25 @@ TEST(beacon_manager, dkg_and_threshold_signing)
       BeaconManager::AddResult::SUCCESS);
   EXPECT_TRUE(beacon_managers[2]->can_verify());
   EXPECT_TRUE(beacon_managers[2]->Verify());
+
+  // In batch mode shares are accepted first and verified together
+  beacon_managers[1]->SetBatchVerification(true);
+  beacon_managers[1]->SetMessage(message);
+  beacon_managers[1]->Sign();
+  EXPECT_EQ(
+      beacon_managers[1]->AddSignaturePart(member_ptrs[0]->identity(), signed_msgs[2].signature),
+      BeaconManager::AddResult::SUCCESS);
+  EXPECT_TRUE(beacon_managers[1]->can_verify());
+
+  auto const invalid_senders = beacon_managers[1]->VerifySignatureParts();
+  ASSERT_EQ(invalid_senders.size(), 1);
+  EXPECT_EQ(invalid_senders[0].identifier(), member_ptrs[0]->identity().identifier());
+  EXPECT_FALSE(beacon_managers[1]->can_verify());
+
+  // The sender of the invalid share can still provide a valid one
+  EXPECT_EQ(
+      beacon_managers[1]->AddSignaturePart(member_ptrs[0]->identity(), signed_msgs[0].signature),
+      BeaconManager::AddResult::SUCCESS);
+  EXPECT_TRUE(beacon_managers[1]->can_verify());
+  EXPECT_TRUE(beacon_managers[1]->Verify());
 }
@@ -105,6 +105,8 @@ public:
   Address &operator=(Address &&) = default;
 
 private:
+  // These stay byte arrays rather than InlineDigests: the accessors hand out references which
+  // callers keep, and the display form (address and checksum) does not fit in an InlineDigest
   ConstByteArray address_;  ///< The address representation
   ConstByteArray display_;  ///< The display representation
 };
@@ -17,6 +17,8 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/byte_array/const_byte_array.hpp"
+
 namespace fetch {
 namespace variant {
 class Variant;
@@ -26,6 +28,8 @@ namespace chain {
 class Transaction;
 
 bool FromJsonTransaction(variant::Variant const &src, Transaction &dst);
+bool FromJsonTransaction(byte_array::ConstByteArray const &version,
+                         byte_array::ConstByteArray const &data, Transaction &dst);
 bool ToJsonTransaction(Transaction const &src, variant::Variant &dst,
                        bool include_metadata = false);
 
@@ -132,6 +132,11 @@ public:
   Signatories const &   signatories() const;
   /// @}
 
+  /// @name Wire Format
+  /// @{
+  ConstByteArray const &encoded() const;
+  /// @}
+
   /// @name Validation / Verification
   /// @{
   bool Verify();
@@ -164,9 +169,10 @@ private:
 
   /// @name Metadata
   /// @{
-  Digest digest_{};                       ///< The digest of the transaction
-  bool   verification_completed_{false};  ///< Signal that the verification has been done
-  bool   verified_{false};                ///< The cached result of the verification
+  Digest         digest_{};                       ///< The digest of the transaction
+  ConstByteArray encoded_{};                      ///< The wire bytes this was deserialized from
+  bool           verification_completed_{false};  ///< Signal that the verification has been done
+  bool           verified_{false};                ///< The cached result of the verification
   /// @}
 
   // There are only two ways to generate a transaction, each from one of the two companion classes:
@@ -19,6 +19,7 @@
 
 #include "core/bitvector.hpp"
 #include "core/byte_array/const_byte_array.hpp"
+#include "core/digest.hpp"
 #include "core/serializers/group_definitions.hpp"
 
 namespace fetch {
@@ -35,7 +36,7 @@ class TransactionLayout
 {
 public:
   using ConstByteArray = byte_array::ConstByteArray;
-  using Digest         = byte_array::ConstByteArray;
+  using Digest         = InlineDigest;
   using TokenAmount    = uint64_t;
   using BlockIndex     = uint64_t;
 
@@ -64,11 +65,11 @@ public:
   TransactionLayout &operator=(TransactionLayout &&) = default;
 
 private:
-  ConstByteArray digest_{};
-  BitVector      mask_{};
-  TokenAmount    charge_rate_{0};
-  BlockIndex     valid_from_{0};
-  BlockIndex     valid_until_{0};
+  Digest      digest_{};
+  BitVector   mask_{};
+  TokenAmount charge_rate_{0};
+  BlockIndex  valid_from_{0};
+  BlockIndex  valid_until_{0};
 
   // Native serializers
   template <typename T, typename D>
@@ -85,8 +86,7 @@ struct hash<fetch::chain::TransactionLayout>
 {
   std::size_t operator()(fetch::chain::TransactionLayout const &layout) const
   {
-    assert(layout.digest().size() >= sizeof(std::size_t));
-    return *reinterpret_cast<std::size_t const *>(layout.digest().pointer());
+    return layout.digest().Hash();
   }
 };
 
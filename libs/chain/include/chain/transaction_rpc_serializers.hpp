@@ -35,6 +35,13 @@ public:
   template <typename Serializer>
   static void Serialize(Serializer &s, Type const &tx)
   {
+    // reuse the original wire bytes of received transactions
+    if (!tx.encoded().empty())
+    {
+      s << tx.encoded();
+      return;
+    }
+
     chain::TransactionSerializer serializer{};
     serializer << tx;
     s << serializer.data();
@@ -51,13 +51,6 @@ bool FromJsonTransaction(Variant const &src, Transaction &dst)
     return false;
   }
 
-  // ensure that the version matches expectation
-  if (JSON_FORMAT_VERSION != version)
-  {
-    FETCH_LOG_INFO(LOGGING_NAME, "Unexpected version: ", version);
-    return false;
-  }
-
   // extract the data field
   ConstByteArray data{};
   if (!Extract(src, "data", data))
@@ -66,11 +59,28 @@ bool FromJsonTransaction(Variant const &src, Transaction &dst)
     return false;
   }
 
-  // convert the data field to binary
-  data = FromBase64(data);
+  return FromJsonTransaction(version, data, dst);
+}
+
+/**
+ * Convert the fields of a JSON transaction object into a transaction
+ *
+ * @param version The contents of the version field
+ * @param data The contents of the (base64 encoded) data field
+ * @param dst The transaction to be populated
+ */
+bool FromJsonTransaction(ConstByteArray const &version, ConstByteArray const &data,
+                         Transaction &dst)
+{
+  // ensure that the version matches expectation
+  if (JSON_FORMAT_VERSION != version)
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Unexpected version: ", version);
+    return false;
+  }
 
   // create the serializer and try and deserialize the transaction
-  TransactionSerializer serializer{data};
+  TransactionSerializer serializer{FromBase64(data)};
   if (!serializer.Deserialize(dst))
   {
     FETCH_LOG_INFO(LOGGING_NAME, "No data field present in payload");
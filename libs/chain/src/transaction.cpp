@@ -260,6 +260,17 @@ Transaction::Signatories const &Transaction::signatories() const
   return signatories_;
 }
 
+/**
+ * Get the serialized form of the transaction as it was received, allowing it to be stored or
+ * forwarded without being serialized again
+ *
+ * @return The wire bytes, or an empty array if the transaction was not deserialized
+ */
+Transaction::ConstByteArray const &Transaction::encoded() const
+{
+  return encoded_;
+}
+
 /**
  * Check to see if this transaction is verified
  *
@@ -21,8 +21,6 @@
 #include "logging/logging.hpp"
 #include "storage/resource_mapper.hpp"
 
-#include <utility>
-
 namespace fetch {
 namespace chain {
 namespace {
@@ -88,7 +86,7 @@ TransactionLayout::TransactionLayout(Transaction const &tx, uint32_t log2_num_la
  */
 TransactionLayout::TransactionLayout(Digest digest, BitVector const &mask, TokenAmount charge_rate,
                                      BlockIndex valid_from, BlockIndex valid_until)
-  : digest_{std::move(digest)}
+  : digest_{digest}
   , mask_{mask}
   , charge_rate_{charge_rate}
   , valid_from_{valid_from}
@@ -100,7 +98,7 @@ TransactionLayout::TransactionLayout(Digest digest, BitVector const &mask, Token
  *
  * @return The transaction digest
  */
-TransactionLayout::ConstByteArray const &TransactionLayout::digest() const
+TransactionLayout::Digest const &TransactionLayout::digest() const
 {
   return digest_;
 }
@@ -108,8 +108,8 @@ ConstByteArray Encode(ConstByteArray const &value)
 
 ConstByteArray Encode(BitVector const &bits)
 {
-  auto const *      raw_data   = reinterpret_cast<uint8_t const *>(bits.data().pointer());
-  std::size_t const raw_length = bits.data().size() * sizeof(BitVector::Block);
+  auto const *      raw_data   = reinterpret_cast<uint8_t const *>(bits.data());
+  std::size_t const raw_length = bits.blocks() * sizeof(BitVector::Block);
   std::size_t const size_bytes = bits.size() >> 3u;
   std::size_t const offset     = (raw_length - size_bytes) + 1;
 
@@ -166,8 +166,8 @@ meta::IfIsInteger<T> Decode(MsgPackSerializer &buffer, T &value)
 
 void Decode(MsgPackSerializer &buffer, BitVector &bits)
 {
-  auto *            raw_data   = reinterpret_cast<uint8_t *>(bits.data().pointer());
-  std::size_t const raw_length = bits.data().size() * sizeof(BitVector::Block);
+  auto *            raw_data   = reinterpret_cast<uint8_t *>(bits.data());
+  std::size_t const raw_length = bits.blocks() * sizeof(BitVector::Block);
   std::size_t const size_bytes = bits.size() >> 3u;
   std::size_t const offset     = (raw_length - size_bytes) + 1;
 
@@ -599,6 +599,9 @@ bool TransactionSerializer::Deserialize(Transaction &tx) const
   // compute the hash function
   tx.digest_ = hash_function.Final();
 
+  // retain the wire bytes so that the transaction can be stored without being serialized again
+  tx.encoded_ = serial_data_.SubArray(payload_start, buffer.tell() - payload_start);
+
   return true;
 }
 
@@ -19,9 +19,11 @@
 #include "chain/address.hpp"
 #include "chain/transaction.hpp"
 #include "chain/transaction_builder.hpp"
+#include "chain/transaction_rpc_serializers.hpp"
 #include "chain/transaction_serializer.hpp"
 #include "core/byte_array/decoders.hpp"
 #include "core/byte_array/encoders.hpp"
+#include "core/serializers/main_serializer.hpp"
 #include "crypto/ecdsa.hpp"
 
 #include "gtest/gtest.h"
@@ -1058,4 +1060,42 @@ TEST_F(TransactionSerializerTests, ContractWithLargeShardMask)
   EnsureAreSame(output, *tx);
 }
 
+TEST_F(TransactionSerializerTests, WireBytesAreRetained)
+{
+  auto tx = TransactionBuilder()
+                .From(addresses_[0])
+                .Transfer(addresses_[1], 256u)
+                .Signer(signers_[0]->identity())
+                .Seal()
+                .Sign(*signers_[0])
+                .Build();
+
+  // built transactions have no wire bytes
+  EXPECT_TRUE(tx->encoded().empty());
+
+  TransactionSerializer serializer;
+  serializer << *tx;
+
+  Transaction output;
+  serializer >> output;
+
+  EXPECT_EQ(output.encoded(), serializer.data());
+
+  // the stored form of a received transaction is the same as that of the original
+  fetch::serializers::MsgPackSerializer original{};
+  original << *tx;
+
+  fetch::serializers::MsgPackSerializer received{};
+  received << output;
+
+  EXPECT_EQ(received.data(), original.data());
+
+  Transaction restored;
+  received.seek(0);
+  received >> restored;
+
+  EnsureAreSame(restored, *tx);
+  EXPECT_EQ(restored.encoded(), serializer.data());
+}
+
 }  // namespace
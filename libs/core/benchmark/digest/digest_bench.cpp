@@ -0,0 +1,173 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/digest.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace {
+
+using fetch::DigestHashAdapter;
+using fetch::InlineDigest;
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+
+// The previous digest set layout, keyed directly by the byte array
+using ByteArrayDigestSet = std::unordered_set<ConstByteArray, DigestHashAdapter>;
+using InlineDigestSet    = fetch::DigestSet;
+
+// Bytes currently allocated from the heap. This includes the aligned allocations made for the
+// byte array payloads, which do not go through operator new
+std::size_t HeapInUse()
+{
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 33)
+  return mallinfo2().uordblks;
+#elif defined(__GLIBC__)
+  return static_cast<std::size_t>(mallinfo().uordblks);
+#else
+  return 0;
+#endif
+}
+
+// A set of byte arrays must own its own copy of each digest, as it would in the mempool
+ConstByteArray Own(ByteArrayDigestSet const & /*set*/, ConstByteArray const &digest)
+{
+  return digest.Copy();
+}
+
+InlineDigest Own(InlineDigestSet const & /*set*/, ConstByteArray const &digest)
+{
+  return digest;
+}
+
+std::vector<ConstByteArray> GenerateDigests(std::size_t count)
+{
+  std::mt19937_64             rng{42};
+  std::vector<ConstByteArray> digests;
+  digests.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ByteArray digest;
+    digest.Resize(32);
+    for (std::size_t j = 0; j < digest.size(); ++j)
+    {
+      digest[j] = static_cast<uint8_t>(rng());
+    }
+
+    digests.emplace_back(digest);
+  }
+
+  return digests;
+}
+
+template <typename Set>
+void DigestSet_Insert(benchmark::State &state)
+{
+  auto const digests = GenerateDigests(static_cast<std::size_t>(state.range(0)));
+
+  std::size_t bytes{0};
+  for (auto _ : state)
+  {
+    std::size_t const start = HeapInUse();
+
+    Set set{};
+    for (auto const &digest : digests)
+    {
+      set.emplace(Own(set, digest));
+    }
+
+    bytes = HeapInUse() - start;
+
+    state.PauseTiming();
+    set = Set{};
+    state.ResumeTiming();
+  }
+
+  state.counters["bytes_per_digest"] =
+      static_cast<double>(bytes) / static_cast<double>(digests.size());
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+template <typename Set>
+void DigestSet_Lookup(benchmark::State &state)
+{
+  auto const digests = GenerateDigests(static_cast<std::size_t>(state.range(0)));
+
+  Set set{};
+  for (auto const &digest : digests)
+  {
+    set.emplace(Own(set, digest));
+  }
+
+  std::vector<typename Set::value_type> const queries(digests.begin(), digests.end());
+
+  for (auto _ : state)
+  {
+    std::size_t found{0};
+    for (auto const &query : queries)
+    {
+      found += set.count(query);
+    }
+
+    benchmark::DoNotOptimize(found);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+template <typename Set>
+void DigestSet_Copy(benchmark::State &state)
+{
+  auto const digests = GenerateDigests(static_cast<std::size_t>(state.range(0)));
+
+  Set set{};
+  for (auto const &digest : digests)
+  {
+    set.emplace(Own(set, digest));
+  }
+
+  for (auto _ : state)
+  {
+    std::vector<typename Set::value_type> copied(set.begin(), set.end());
+    benchmark::DoNotOptimize(copied.data());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(DigestSet_Insert, ByteArrayDigestSet)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(DigestSet_Insert, InlineDigestSet)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(DigestSet_Lookup, ByteArrayDigestSet)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(DigestSet_Lookup, InlineDigestSet)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(DigestSet_Copy, ByteArrayDigestSet)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(DigestSet_Copy, InlineDigestSet)->Range(1 << 10, 1 << 20);
@@ -0,0 +1,180 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/containers/queue.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t QUEUE_SIZE      = 1u << 16u;
+constexpr std::size_t ELEMENTS_PER_OP = 1u << 16u;
+constexpr std::size_t BATCH_SIZE      = 32;
+
+using Element = uint64_t;
+
+// Reference queue guarded by a mutex and condition variables, as the queue was previously
+class LockedQueue
+{
+public:
+  void Push(Element element)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [this]() { return count_ < QUEUE_SIZE; });
+    buffer_[(read_ + count_) % QUEUE_SIZE] = element;
+    ++count_;
+    not_empty_.notify_one();
+  }
+
+  Element Pop()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this]() { return count_ != 0; });
+    Element const element = buffer_[read_];
+    read_                 = (read_ + 1) % QUEUE_SIZE;
+    --count_;
+    not_full_.notify_one();
+    return element;
+  }
+
+private:
+  std::mutex              mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::vector<Element>    buffer_ = std::vector<Element>(QUEUE_SIZE);
+  std::size_t             read_{0};
+  std::size_t             count_{0};
+};
+
+using MPMCQueue = fetch::core::MPMCQueue<Element, QUEUE_SIZE>;
+
+template <typename Queue>
+void PushElements(Queue &queue, std::size_t count)
+{
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    queue.Push(Element{i});
+  }
+}
+
+template <typename Queue>
+void PopElements(Queue &queue, std::size_t count)
+{
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    benchmark::DoNotOptimize(queue.Pop());
+  }
+}
+
+void PushBatches(MPMCQueue &queue, std::size_t count)
+{
+  std::array<Element, BATCH_SIZE> batch{};
+  for (std::size_t pushed = 0; pushed < count; pushed += BATCH_SIZE)
+  {
+    auto const size = std::min(BATCH_SIZE, count - pushed);
+    queue.PushBatch(batch.begin(), batch.begin() + size);
+  }
+}
+
+void PopBatches(MPMCQueue &queue, std::size_t count)
+{
+  std::vector<Element> batch;
+  batch.reserve(BATCH_SIZE);
+  for (std::size_t popped = 0; popped < count;)
+  {
+    batch.clear();
+    popped += queue.PopBatch(batch, std::min(BATCH_SIZE, count - popped), std::chrono::seconds{1});
+  }
+}
+
+// Transfers a fixed number of elements from the producers to the consumers, the producer and
+// consumer thread counts being given by the benchmark arguments
+template <typename Queue, typename Producer, typename Consumer>
+void Transfer(benchmark::State &state, Producer const &producer, Consumer const &consumer)
+{
+  auto const num_producers = static_cast<std::size_t>(state.range(0));
+  auto const num_consumers = static_cast<std::size_t>(state.range(1));
+
+  auto queue = std::make_unique<Queue>();
+
+  for (auto _ : state)
+  {
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < num_producers; ++i)
+    {
+      threads.emplace_back(producer, std::ref(*queue), ELEMENTS_PER_OP / num_producers);
+    }
+    for (std::size_t i = 0; i < num_consumers; ++i)
+    {
+      threads.emplace_back(consumer, std::ref(*queue), ELEMENTS_PER_OP / num_consumers);
+    }
+
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * ELEMENTS_PER_OP));
+}
+
+void Queue_Locked(benchmark::State &state)
+{
+  Transfer<LockedQueue>(state, PushElements<LockedQueue>, PopElements<LockedQueue>);
+}
+
+void Queue_MPMC(benchmark::State &state)
+{
+  Transfer<MPMCQueue>(state, PushElements<MPMCQueue>, PopElements<MPMCQueue>);
+}
+
+void Queue_MPMCBatch(benchmark::State &state)
+{
+  Transfer<MPMCQueue>(state, PushBatches, PopBatches);
+}
+
+void ThreadCounts(benchmark::internal::Benchmark *b)
+{
+  for (int64_t producers : {1, 2, 4, 8})
+  {
+    for (int64_t consumers : {1, 2, 4, 8})
+    {
+      b->Args({producers, consumers});
+    }
+  }
+
+  b->ArgNames({"producers", "consumers"})->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+}  // namespace
+
+BENCHMARK(Queue_Locked)->Apply(ThreadCounts);
+BENCHMARK(Queue_MPMC)->Apply(ThreadCounts);
+BENCHMARK(Queue_MPMCBatch)->Apply(ThreadCounts);
@@ -40,7 +40,9 @@ public:
     ELEMENT_BIT_SIZE = sizeof(Block) << 3u,
     LOG_BITS         = meta::Log2(ELEMENT_BIT_SIZE),
     BIT_MASK         = (1ull << LOG_BITS) - 1,
-    SIMD_SIZE        = UnderlyingArray::E_SIMD_COUNT
+    SIMD_SIZE        = UnderlyingArray::E_SIMD_COUNT,
+    INLINE_BLOCKS    = 8,  ///< Vectors of up to 512 bits are stored inline, without allocating
+    INLINE_BIT_SIZE  = INLINE_BLOCKS * ELEMENT_BIT_SIZE
   };
 
   class Iterator : public std::iterator<std::output_iterator_tag, std::size_t>
@@ -63,8 +65,12 @@ public:
   // Construction  / Destruction
   explicit BitVector(std::size_t n = 0);
   BitVector(BitVector const &other);
+  BitVector(BitVector &&other) noexcept;
   ~BitVector() = default;
 
+  BitVector &operator=(BitVector const &other);
+  BitVector &operator=(BitVector &&other) noexcept;
+
   void Resize(std::size_t bit_size);
 
   void SetAllZero();
@@ -77,14 +83,17 @@ public:
 
   void InlineAndAssign(BitVector const &a, BitVector const &b);
 
-  std::size_t            size() const;
-  uint32_t               log2_size() const;
-  std::size_t            blocks() const;
-  UnderlyingArray const &data() const;
-  UnderlyingArray &      data();
+  std::size_t  size() const;
+  uint32_t     log2_size() const;
+  std::size_t  blocks() const;
+  Block const *data() const;
+  Block *      data();
 
   std::size_t PopCount() const;
 
+  bool        Intersects(BitVector const &other) const;
+  std::size_t OrInto(BitVector &dst) const;
+
   void conditional_flip(std::size_t block, std::size_t bit, uint64_t base);
   void conditional_flip(std::size_t bit, uint64_t base);
 
@@ -115,11 +124,24 @@ public:
   Iterator end() const;
 
 private:
-  UnderlyingArray data_{};
+  Block TailMask() const;
+
+  Block           inline_[INLINE_BLOCKS]{};  ///< Storage for vectors of up to INLINE_BIT_SIZE bits
+  UnderlyingArray heap_{};                   ///< Storage for larger vectors
   std::size_t     size_{0};
   std::size_t     blocks_{0};
 };
 
+inline BitVector::Block const *BitVector::data() const
+{
+  return (blocks_ > INLINE_BLOCKS) ? heap_.pointer() : inline_;
+}
+
+inline BitVector::Block *BitVector::data()
+{
+  return (blocks_ > INLINE_BLOCKS) ? heap_.pointer() : inline_;
+}
+
 std::ostream &operator<<(std::ostream &s, BitVector const &b);
 
 namespace serializers {
@@ -139,7 +161,7 @@ public:
 
     auto array = array_constructor(block_size + 1);
 
-    auto const &underlying_blocks = mask.data();
+    auto const *underlying_blocks = mask.data();
     array.Append(bit_size);
     for (uint64_t i = 0; i < block_size; ++i)
     {
@@ -157,7 +179,7 @@ public:
 
     mask.Resize(bit_size);
     assert(mask.blocks() == block_size);
-    auto &underlying_blocks = mask.data();
+    auto *underlying_blocks = mask.data();
 
     for (uint64_t i = 0; i < block_size; ++i)
     {
@@ -17,50 +17,49 @@
 //
 //------------------------------------------------------------------------------
 
-#include "core/mutex.hpp"
-#include "core/sync/tickets.hpp"
+#include "core/sync/event_count.hpp"
 #include "meta/log2.hpp"
 #include "meta/type_traits.hpp"
 
 #include <array>
-#include <deque>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace fetch {
 namespace core {
 
 /**
- * A Single threaded index
- *
- * @tparam SIZE
+ * Queue position which is only ever advanced by a single thread
  */
-template <std::size_t SIZE>
 class SingleThreadedIndex
 {
 public:
   // Construction / Destruction
-  explicit SingleThreadedIndex(std::size_t initial)
-    : index_(initial)
-  {}
+  SingleThreadedIndex()                            = default;
   SingleThreadedIndex(SingleThreadedIndex const &) = delete;
   SingleThreadedIndex(SingleThreadedIndex &&)      = delete;
 
-  /**
-   * Post increment operator
-   *
-   * @return The new index value
-   */
-  std::size_t operator++(int)
+  std::size_t Load() const
   {
-    std::size_t index = index_++;
-    index_ &= MASK;
-
-    return index;
+    return position_.load(std::memory_order_relaxed);
   }
 
-  template <typename Function>
-  void Increment(Function &&function)
+  /**
+   * Advance the position from the expected value
+   *
+   * @param expected The current value of the position
+   * @param count The number of positions to advance by
+   * @return true, since no other thread can have advanced the position
+   */
+  bool TryAdvance(std::size_t &expected, std::size_t count)
   {
-    function((*this)++);
+    position_.store(expected + count, std::memory_order_relaxed);
+    return true;
   }
 
   // Operators
@@ -68,62 +67,60 @@ public:
   SingleThreadedIndex &operator=(SingleThreadedIndex &&) = delete;
 
 private:
-  static constexpr std::size_t MASK = SIZE - 1;
-
-  std::size_t index_{0};
-
-  // static assertions
-  static_assert(meta::IsLog2(SIZE), "Queue size must be a valid power of 2");
+  std::atomic<std::size_t> position_{0};
 };
 
 /**
- * A Multi threaded index
- *
- * @tparam SIZE
+ * Queue position which can be advanced concurrently by multiple threads
  */
-template <std::size_t SIZE>
-class MultiThreadedIndex : protected SingleThreadedIndex<SIZE>
+class MultiThreadedIndex
 {
 public:
-  using Base = SingleThreadedIndex<SIZE>;
-
   // Construction / Destruction
-  explicit MultiThreadedIndex(std::size_t initial)
-    : Base(initial)
-  {}
+  MultiThreadedIndex()                           = default;
+  MultiThreadedIndex(MultiThreadedIndex const &) = delete;
+  MultiThreadedIndex(MultiThreadedIndex &&)      = delete;
+
+  std::size_t Load() const
+  {
+    return position_.load(std::memory_order_relaxed);
+  }
 
   /**
-   * Post increment operator
+   * Attempt to advance the position from the expected value
    *
-   * @return The new index value
+   * @param expected The expected value of the position, updated to the current value on failure
+   * @param count The number of positions to advance by
+   * @return true if successful, false if another thread advanced the position first
    */
-  std::size_t operator++(int)
+  bool TryAdvance(std::size_t &expected, std::size_t count)
   {
-    FETCH_LOCK(lock_);
-    return static_cast<Base &>(*this)++;
+    return position_.compare_exchange_weak(expected, expected + count, std::memory_order_relaxed);
   }
 
-  template <typename Function>
-  void Increment(Function &&function)
-  {
-    FETCH_LOCK(lock_);
-    Base::Increment(std::forward<Function>(function));
-  }
+  // Operators
+  MultiThreadedIndex &operator=(MultiThreadedIndex const &) = delete;
+  MultiThreadedIndex &operator=(MultiThreadedIndex &&) = delete;
 
 private:
-  Mutex lock_;
+  std::atomic<std::size_t> position_{0};
 };
 
 /**
- * Single Producer, Single Consumer fixed-length queue
+ * Fixed-length, lock-free ring buffer queue
+ *
+ * Every slot of the ring carries a sequence number which records whether it is ready to be
+ * written or read for a given position. Producers and consumers claim positions by advancing
+ * their index, so pushes and pops only contend on a single atomic and never take a lock. Threads
+ * only block (on an EventCount) when the queue is full or empty.
  *
  * @tparam T The type of element to be stored in the queue
  * @tparam SIZE The max size of the queue
- * @tparam Producer The thread safety model for the producer size of the queue
- * @tparam Consumer The thread safety model for the consumer size of the queue
+ * @tparam ProducerIndex The thread safety model for the producer side of the queue
+ * @tparam ConsumerIndex The thread safety model for the consumer side of the queue
  */
-template <typename T, std::size_t SIZE, typename ProducerIndex = MultiThreadedIndex<SIZE>,
-          typename ConsumerIndex = MultiThreadedIndex<SIZE>>
+template <typename T, std::size_t SIZE, typename ProducerIndex = MultiThreadedIndex,
+          typename ConsumerIndex = MultiThreadedIndex>
 class Queue
 {
 public:
@@ -135,7 +132,7 @@ public:
   static_assert(std::is_default_constructible<T>::value, "T must be default constructable");
 
   // Construction / Destruction
-  Queue()              = default;
+  Queue();
   Queue(Queue const &) = delete;
   Queue(Queue &&)      = delete;
 
@@ -153,18 +150,53 @@ public:
                                                    std::chrono::duration<R, P> const &duration);
   /// @}
 
+  /// @name Batch Queue Interaction
+  /// @{
+  template <typename Iterator>
+  void PushBatch(Iterator begin, Iterator end);
+  template <typename R, typename P>
+  std::size_t PopBatch(std::vector<T> &values, std::size_t max_count,
+                       std::chrono::duration<R, P> const &duration);
+  /// @}
+
   // Operators
   Queue &operator=(Queue const &) = delete;
   Queue &operator=(Queue &&) = delete;
 
 protected:
-  using Array = std::array<T, SIZE>;
+  static constexpr std::size_t MASK = SIZE - 1;
+
+  struct Slot
+  {
+    std::atomic<std::size_t> sequence{0};  ///< The position for which the slot is next ready
+    T                        value{};
+  };
+
+  using Array = std::array<Slot, SIZE>;
+
+  // copies lvalue elements into the queue and moves rvalue elements
+  template <typename U>
+  using SourceIterator = std::conditional_t<std::is_lvalue_reference<U>::value,
+                                            std::remove_reference_t<U> *,
+                                            std::move_iterator<std::remove_reference_t<U> *>>;
 
-  Array         queue_{};            ///< The main element container
-  ProducerIndex write_index_{0};     ///< The write index
-  ConsumerIndex read_index_{0};      ///< The read index
-  Tickets       read_count_{0};      ///< The read semaphore/tickets object
-  Tickets       write_count_{SIZE};  ///< The write semaphore/tickets object
+  template <typename Iterator>
+  std::size_t TryPush(Iterator &it, std::size_t count);
+  template <typename OutputIterator>
+  std::size_t TryPop(OutputIterator out, std::size_t count);
+
+  std::size_t Size() const;
+
+  void OnPushed(std::size_t count, bool waited);
+  void OnPopped(std::size_t count, bool waited);
+
+  // the indices are kept apart by the slots so that producers and consumers do not falsely share
+  // a cache line
+  ProducerIndex write_index_{};  ///< The write index
+  EventCount    not_empty_;      ///< Signalled when elements are pushed
+  EventCount    not_full_;       ///< Signalled when elements are popped
+  Array         queue_{};        ///< The main element container
+  ConsumerIndex read_index_{};   ///< The read index
 
   // static asserts
   static_assert(meta::IsLog2(SIZE), "Queue size must be a valid power of 2");
@@ -172,6 +204,15 @@ protected:
   static_assert(std::is_copy_assignable<T>::value, "T must have copy assignment");
 };
 
+template <typename T, std::size_t N, typename P, typename C>
+Queue<T, N, P, C>::Queue()
+{
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    queue_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
 /**
  * Pop an element from the queue
  *
@@ -187,12 +228,15 @@ protected:
 template <typename T, std::size_t N, typename P, typename C>
 T Queue<T, N, P, C>::Pop()
 {
-  read_count_.Wait();
-
   T value;
-  read_index_.Increment([this, &value](auto const index) { value = std::move(queue_[index]); });
 
-  write_count_.Post();
+  bool const waited = TryPop(&value, 1) == 0;
+  if (waited)
+  {
+    not_empty_.Wait([this, &value]() { return TryPop(&value, 1) != 0; });
+  }
+
+  OnPopped(1, waited);
 
   return value;
 }
@@ -214,14 +258,16 @@ template <typename T, std::size_t N, typename P, typename C>
 template <typename Rep, typename Per>
 bool Queue<T, N, P, C>::Pop(T &value, std::chrono::duration<Rep, Per> const &duration)
 {
-  if (!read_count_.Wait(duration))
+  bool const waited = TryPop(&value, 1) == 0;
+  if (waited)
   {
-    return false;
+    if (!not_empty_.Wait([this, &value]() { return TryPop(&value, 1) != 0; }, duration))
+    {
+      return false;
+    }
   }
 
-  read_index_.Increment([this, &value](auto const &index) { value = std::move(queue_[index]); });
-
-  write_count_.Post();
+  OnPopped(1, waited);
 
   return true;
 }
@@ -244,12 +290,15 @@ template <typename T, std::size_t N, typename P, typename C>
 template <typename U>
 meta::EnableIfSame<T, meta::Decay<U>> Queue<T, N, P, C>::Push(U &&element)
 {
-  write_count_.Wait();
+  SourceIterator<U> it{&element};
 
-  write_index_.Increment(
-      [this, &element](auto const index) { queue_[index] = std::forward<U>(element); });
+  bool const waited = TryPush(it, 1) == 0;
+  if (waited)
+  {
+    not_full_.Wait([this, &it]() { return TryPush(it, 1) != 0; });
+  }
 
-  read_count_.Post();
+  OnPushed(1, waited);
 }
 
 /**
@@ -271,12 +320,9 @@ template <typename T, std::size_t N, typename P, typename C>
 template <typename U>
 meta::EnableIfSame<T, meta::Decay<U>> Queue<T, N, P, C>::Push(U &&element, std::size_t &count)
 {
-  write_count_.Wait();
-
-  write_index_.Increment(
-      [this, &element](auto const index) { queue_[index] = std::forward<U>(element); });
+  Push(std::forward<U>(element));
 
-  read_count_.Post(count);
+  count = Size();
 }
 
 /**
@@ -301,30 +347,307 @@ template <typename U, typename Rep, typename Per>
 meta::EnableIfSame<T, meta::Decay<U>, bool> Queue<T, N, P, C>::Push(
     U &&element, std::size_t &count, std::chrono::duration<Rep, Per> const &duration)
 {
-  if (!write_count_.Wait(duration))
+  SourceIterator<U> it{&element};
+
+  bool const waited = TryPush(it, 1) == 0;
+  if (waited)
   {
-    return false;
+    if (!not_full_.Wait([this, &it]() { return TryPush(it, 1) != 0; }, duration))
+    {
+      return false;
+    }
   }
 
-  write_index_.Increment(
-      [this, &element](auto const index) { queue_[index] = std::forward<U>(element); });
+  OnPushed(1, waited);
 
-  read_count_.Post(count);
+  count = Size();
   return true;
 }
 
+/**
+ * Push a range of elements onto the queue
+ *
+ * Elements are copied (or moved, given move iterators) into the queue in as few claims as the
+ * available space allows. If the queue is full this function will block until all of the elements
+ * have been added.
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @tparam P The producer index type
+ * @tparam C The consumer index type
+ * @tparam Iterator The forward iterator type of the range
+ * @param begin The start of the range
+ * @param end The end of the range
+ */
+template <typename T, std::size_t N, typename P, typename C>
+template <typename Iterator>
+void Queue<T, N, P, C>::PushBatch(Iterator begin, Iterator end)
+{
+  auto remaining = static_cast<std::size_t>(std::distance(begin, end));
+  while (remaining > 0)
+  {
+    std::size_t pushed = TryPush(begin, remaining);
+    bool const  waited = pushed == 0;
+    if (waited)
+    {
+      not_full_.Wait([this, &begin, &pushed, remaining]() {
+        pushed = TryPush(begin, remaining);
+        return pushed != 0;
+      });
+    }
+
+    remaining -= pushed;
+
+    OnPushed(pushed, waited);
+  }
+}
+
+/**
+ * Pop a number of elements from the queue with a specified maximum wait duration
+ *
+ * Waits for at least one element to be available and then extracts as many of the available
+ * elements as possible, up to the specified maximum.
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @tparam P The producer index type
+ * @tparam C The consumer index type
+ * @tparam Rep The tick representation for the duration
+ * @tparam Per The tick period for the duration
+ * @param values The container to which extracted elements are appended
+ * @param max_count The maximum number of elements to extract
+ * @param duration The maximum amount of time to wait for an element
+ * @return The number of elements extracted
+ */
+template <typename T, std::size_t N, typename P, typename C>
+template <typename Rep, typename Per>
+std::size_t Queue<T, N, P, C>::PopBatch(std::vector<T> &values, std::size_t max_count,
+                                        std::chrono::duration<Rep, Per> const &duration)
+{
+  std::size_t popped = TryPop(std::back_inserter(values), max_count);
+  bool const  waited = (popped == 0) && (max_count > 0);
+  if (waited)
+  {
+    not_empty_.Wait(
+        [this, &values, &popped, max_count]() {
+          popped = TryPop(std::back_inserter(values), max_count);
+          return popped != 0;
+        },
+        duration);
+  }
+
+  if (popped != 0)
+  {
+    OnPopped(popped, waited);
+  }
+
+  return popped;
+}
+
+/**
+ * Attempt to claim and populate up to the specified number of consecutive slots, without blocking
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @tparam P The producer index type
+ * @tparam C The consumer index type
+ * @tparam Iterator The type of the source iterator
+ * @param it The source of the elements, advanced past the elements which have been pushed
+ * @param count The maximum number of elements to push
+ * @return The number of elements pushed, zero if the queue is full
+ */
+template <typename T, std::size_t N, typename P, typename C>
+template <typename Iterator>
+std::size_t Queue<T, N, P, C>::TryPush(Iterator &it, std::size_t count)
+{
+  std::size_t position = write_index_.Load();
+  std::size_t claimed{0};
+
+  for (;;)
+  {
+    // count the free slots following the current position
+    claimed = 0;
+    while ((claimed < count) && (claimed < N) &&
+           (queue_[(position + claimed) & MASK].sequence.load(std::memory_order_acquire) ==
+            position + claimed))
+    {
+      ++claimed;
+    }
+
+    if (claimed == 0)
+    {
+      auto const sequence = queue_[position & MASK].sequence.load(std::memory_order_acquire);
+
+      // the slot still holds the element from the previous lap, so the queue is full
+      if (static_cast<std::ptrdiff_t>(sequence - position) < 0)
+      {
+        return 0;
+      }
+
+      // otherwise another producer has claimed the position
+      position = write_index_.Load();
+    }
+    else if (write_index_.TryAdvance(position, claimed))
+    {
+      break;
+    }
+  }
+
+  for (std::size_t i = 0; i < claimed; ++i, ++it)
+  {
+    auto &slot = queue_[(position + i) & MASK];
+
+    slot.value = *it;
+    slot.sequence.store(position + i + 1, std::memory_order_release);
+  }
+
+  return claimed;
+}
+
+/**
+ * Attempt to claim and extract up to the specified number of consecutive elements, without
+ * blocking
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @tparam P The producer index type
+ * @tparam C The consumer index type
+ * @tparam OutputIterator The type of the destination iterator
+ * @param out The destination for the extracted elements
+ * @param count The maximum number of elements to extract
+ * @return The number of elements extracted, zero if the queue is empty
+ */
+template <typename T, std::size_t N, typename P, typename C>
+template <typename OutputIterator>
+std::size_t Queue<T, N, P, C>::TryPop(OutputIterator out, std::size_t count)
+{
+  std::size_t position = read_index_.Load();
+  std::size_t claimed{0};
+
+  for (;;)
+  {
+    // count the populated slots following the current position
+    claimed = 0;
+    while ((claimed < count) && (claimed < N) &&
+           (queue_[(position + claimed) & MASK].sequence.load(std::memory_order_acquire) ==
+            position + claimed + 1))
+    {
+      ++claimed;
+    }
+
+    if (claimed == 0)
+    {
+      auto const sequence = queue_[position & MASK].sequence.load(std::memory_order_acquire);
+
+      // the slot has not been populated for this position yet, so the queue is empty
+      if (static_cast<std::ptrdiff_t>(sequence - (position + 1)) < 0)
+      {
+        return 0;
+      }
+
+      // otherwise another consumer has claimed the position
+      position = read_index_.Load();
+    }
+    else if (read_index_.TryAdvance(position, claimed))
+    {
+      break;
+    }
+  }
+
+  for (std::size_t i = 0; i < claimed; ++i, ++out)
+  {
+    auto &slot = queue_[(position + i) & MASK];
+
+    *out = std::move(slot.value);
+    slot.sequence.store(position + i + N, std::memory_order_release);
+  }
+
+  return claimed;
+}
+
+/**
+ * Get the approximate number of elements in the queue
+ *
+ * @return The number of elements
+ */
+template <typename T, std::size_t N, typename P, typename C>
+std::size_t Queue<T, N, P, C>::Size() const
+{
+  auto const read_position  = read_index_.Load();
+  auto const write_position = write_index_.Load();
+
+  return (write_position > read_position) ? (write_position - read_position) : 0;
+}
+
+/**
+ * Wake the consumers which are waiting for the elements that have been pushed
+ *
+ * Slots are released out of order, so a producer can be woken while the slot it needs is still
+ * being read by a consumer and go back to waiting, even though the wake up was meant for it. A
+ * producer which succeeds after waiting therefore passes the wake up on to another waiting
+ * producer while there is still space in the queue.
+ *
+ * @param count The number of elements pushed
+ * @param waited Whether the producer had to wait for space
+ */
+template <typename T, std::size_t N, typename P, typename C>
+void Queue<T, N, P, C>::OnPushed(std::size_t count, bool waited)
+{
+  if (count > 1)
+  {
+    not_empty_.NotifyAll();
+  }
+  else
+  {
+    not_empty_.NotifyOne();
+  }
+
+  if (waited && (Size() < N))
+  {
+    not_full_.NotifyOne();
+  }
+}
+
+/**
+ * Wake the producers which are waiting for the space that has been freed
+ *
+ * Likewise a consumer can be woken while the slot it needs is still being written, so a consumer
+ * which succeeds after waiting passes the wake up on to another waiting consumer while elements
+ * remain.
+ *
+ * @param count The number of elements popped
+ * @param waited Whether the consumer had to wait for an element
+ */
+template <typename T, std::size_t N, typename P, typename C>
+void Queue<T, N, P, C>::OnPopped(std::size_t count, bool waited)
+{
+  if (count > 1)
+  {
+    not_full_.NotifyAll();
+  }
+  else
+  {
+    not_full_.NotifyOne();
+  }
+
+  if (waited && (Size() != 0))
+  {
+    not_empty_.NotifyOne();
+  }
+}
+
 // Helpful Typedefs
 template <typename T, std::size_t N>
-using SPSCQueue = Queue<T, N, SingleThreadedIndex<N>, SingleThreadedIndex<N>>;
+using SPSCQueue = Queue<T, N, SingleThreadedIndex, SingleThreadedIndex>;
 
 template <typename T, std::size_t N>
-using SPMCQueue = Queue<T, N, SingleThreadedIndex<N>, MultiThreadedIndex<N>>;
+using SPMCQueue = Queue<T, N, SingleThreadedIndex, MultiThreadedIndex>;
 
 template <typename T, std::size_t N>
-using MPSCQueue = Queue<T, N, MultiThreadedIndex<N>, SingleThreadedIndex<N>>;
+using MPSCQueue = Queue<T, N, MultiThreadedIndex, SingleThreadedIndex>;
 
 template <typename T, std::size_t N>
-using MPMCQueue = Queue<T, N, MultiThreadedIndex<N>, MultiThreadedIndex<N>>;
+using MPMCQueue = Queue<T, N, MultiThreadedIndex, MultiThreadedIndex>;
 
 }  // namespace core
 }  // namespace fetch
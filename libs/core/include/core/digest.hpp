@@ -18,7 +18,20 @@
 //------------------------------------------------------------------------------
 
 #include "core/byte_array/const_byte_array.hpp"
+#include "core/byte_array/encoders.hpp"
+#include "core/serializers/base_types.hpp"
+#include "core/serializers/exception.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -26,8 +39,165 @@ namespace fetch {
 
 using Digest = byte_array::ConstByteArray;
 
+/**
+ * Fixed capacity digest which stores its bytes inline.
+ *
+ * Transaction hashes, block hashes and addresses are all 32 bytes long. Keeping them in a
+ * byte array costs a heap allocation and a reference counted control block per digest, which
+ * dominates the memory and cache footprint of the large digest indexed containers (mempools,
+ * chain indices). This type is trivially copyable and converts implicitly to and from a
+ * ConstByteArray so that it can be used as a drop in key for these containers.
+ *
+ * Converting a byte array longer than CAPACITY throws, so lookups with caller supplied keys
+ * should check Fits() first and treat such digests as not found.
+ */
+class InlineDigest
+{
+public:
+  static constexpr std::size_t CAPACITY = 32;
+
+  // Construction / Destruction
+  InlineDigest() = default;
+  InlineDigest(uint8_t const *data, std::size_t size);
+  InlineDigest(byte_array::ConstByteArray const &value);  // NOLINT
+  InlineDigest(InlineDigest const &) = default;
+  ~InlineDigest()                    = default;
+
+  /// @name Accessors
+  /// @{
+  uint8_t const *pointer() const;
+  std::size_t    size() const;
+  bool           empty() const;
+  std::size_t    Hash() const;
+
+  static bool Fits(byte_array::ConstByteArray const &value);
+  /// @}
+
+  /// @name Conversions
+  /// @{
+  byte_array::ConstByteArray ToConstByteArray() const;
+  byte_array::ConstByteArray ToHex() const;
+  byte_array::ConstByteArray ToBase64() const;
+
+  operator byte_array::ConstByteArray() const;  // NOLINT
+  /// @}
+
+  // Operators
+  InlineDigest &operator=(InlineDigest const &) = default;
+  bool          operator==(InlineDigest const &other) const;
+  bool          operator!=(InlineDigest const &other) const;
+  bool          operator<(InlineDigest const &other) const;
+
+private:
+  std::array<uint8_t, CAPACITY> data_{};
+  uint8_t                       size_{0};
+};
+
+static_assert(std::is_trivially_copyable<InlineDigest>::value,
+              "InlineDigest must be trivially copyable");
+
+inline InlineDigest::InlineDigest(uint8_t const *data, std::size_t size)
+  : size_{static_cast<uint8_t>(size)}
+{
+  if (size > CAPACITY)
+  {
+    throw std::length_error("Digest is too large to be stored inline");
+  }
+
+  if (size != 0)
+  {
+    std::memcpy(data_.data(), data, size);
+  }
+}
+
+inline InlineDigest::InlineDigest(byte_array::ConstByteArray const &value)
+  : InlineDigest(value.pointer(), value.size())
+{}
+
+inline uint8_t const *InlineDigest::pointer() const
+{
+  return data_.data();
+}
+
+inline std::size_t InlineDigest::size() const
+{
+  return size_;
+}
+
+inline bool InlineDigest::empty() const
+{
+  return size_ == 0;
+}
+
+/**
+ * Digests are (for all practical purposes) uniformly distributed, so the leading bytes are used
+ * directly as the hash. Unused bytes are always zero which keeps short digests well defined.
+ *
+ * @return The hash value for the digest
+ */
+inline std::size_t InlineDigest::Hash() const
+{
+  std::size_t value{0};
+  std::memcpy(&value, data_.data(), sizeof(value));
+  return value;
+}
+
+/**
+ * Determine if a byte array can be stored inline. Larger digests can never be the key of an
+ * inline digest indexed container.
+ *
+ * @param value The byte array to be checked
+ * @return true if the value can be converted, otherwise false
+ */
+inline bool InlineDigest::Fits(byte_array::ConstByteArray const &value)
+{
+  return value.size() <= CAPACITY;
+}
+
+inline byte_array::ConstByteArray InlineDigest::ToConstByteArray() const
+{
+  return {data_.data(), size_};
+}
+
+inline byte_array::ConstByteArray InlineDigest::ToHex() const
+{
+  return byte_array::ToHex(ToConstByteArray());
+}
+
+inline byte_array::ConstByteArray InlineDigest::ToBase64() const
+{
+  return empty() ? byte_array::ConstByteArray{} : byte_array::ToBase64(data_.data(), size_);
+}
+
+inline InlineDigest::operator byte_array::ConstByteArray() const
+{
+  return ToConstByteArray();
+}
+
+inline bool InlineDigest::operator==(InlineDigest const &other) const
+{
+  return (size_ == other.size_) && (data_ == other.data_);
+}
+
+inline bool InlineDigest::operator!=(InlineDigest const &other) const
+{
+  return !(*this == other);
+}
+
+inline bool InlineDigest::operator<(InlineDigest const &other) const
+{
+  int const cmp = std::memcmp(data_.data(), other.data_.data(), std::min(size_, other.size_));
+
+  return (cmp < 0) || ((cmp == 0) && (size_ < other.size_));
+}
+
 struct DigestHashAdapter
 {
+  std::size_t operator()(InlineDigest const &hash) const noexcept
+  {
+    return hash.Hash();
+  }
+
   std::size_t operator()(Digest const &hash) const noexcept
   {
     std::size_t value{0};
@@ -42,9 +212,50 @@ struct DigestHashAdapter
   }
 };
 
-using DigestSet = std::unordered_set<Digest, DigestHashAdapter>;
+using DigestSet = std::unordered_set<InlineDigest, DigestHashAdapter>;
 
 template <typename Value>
-using DigestMap = std::unordered_map<Digest, Value, DigestHashAdapter>;
+using DigestMap = std::unordered_map<InlineDigest, Value, DigestHashAdapter>;
+
+namespace serializers {
+
+// Serialised exactly like the equivalent byte array so that the wire format is unchanged
+template <typename D>
+struct StringSerializer<InlineDigest, D> : public StringSerializerImplementation<InlineDigest, D>
+{
+  using Type       = InlineDigest;
+  using DriverType = D;
+
+  template <typename Interface>
+  static void Deserialize(Interface &interface, Type &val)
+  {
+    byte_array::ConstByteArray value;
+    StringSerializerImplementation<byte_array::ConstByteArray, D>::Deserialize(interface, value);
+
+    // reject oversized input here rather than letting the conversion throw a std::length_error
+    if (value.size() > InlineDigest::CAPACITY)
+    {
+      throw SerializableException(error::TYPE_ERROR,
+                                  std::string("Digest is too large to be stored inline: ") +
+                                      std::to_string(value.size()) + " bytes");
+    }
+
+    val = InlineDigest{value};
+  }
+};
 
+}  // namespace serializers
 }  // namespace fetch
+
+namespace std {
+
+template <>
+struct hash<fetch::InlineDigest>
+{
+  std::size_t operator()(fetch::InlineDigest const &digest) const noexcept
+  {
+    return digest.Hash();
+  }
+};
+
+}  // namespace std
@@ -44,8 +44,9 @@ static constexpr uint16_t CHANNEL_RPC = 1;  // for convenience we essentially
                                             // potential RPC interface
 
 // Muddle Service Channels
-static constexpr uint16_t CHANNEL_ROUTING      = 256;  // direct only
-static constexpr uint16_t CHANNEL_ANNOUNCEMENT = 257;
+static constexpr uint16_t CHANNEL_ROUTING        = 256;  // direct only
+static constexpr uint16_t CHANNEL_ANNOUNCEMENT   = 257;
+static constexpr uint16_t CHANNEL_BROADCAST_TREE = 258;  // direct only
 
 // P2P Service Channels
 
@@ -61,6 +62,7 @@ static constexpr uint16_t CHANNEL_SECRET_KEY        = 400;
 static constexpr uint16_t CHANNEL_CONTRIBUTIONS     = 401;
 static constexpr uint16_t CHANNEL_RBC_BROADCAST     = 402;
 static constexpr uint16_t CHANNEL_CONNECTIONS_SETUP = 403;
+static constexpr uint16_t CHANNEL_ERASURE_CODED_RBC = 404;
 
 static constexpr uint16_t CHANNEL_ID_DISTRIBUTION = 450;
 
@@ -0,0 +1,153 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace fetch {
+namespace core {
+
+/**
+ * Lets threads block until a condition, maintained by lock-free code, becomes true
+ *
+ * Waiting threads register themselves before re-checking the condition under the internal mutex,
+ * and notifying threads only take the mutex when there is a registered waiter. Threads which
+ * change the condition therefore do not touch the mutex in the uncontended case, but a waiter can
+ * never miss a notification for a change made after it last evaluated the condition.
+ */
+class EventCount
+{
+public:
+  // Construction / Destruction
+  EventCount()                   = default;
+  EventCount(EventCount const &) = delete;
+  EventCount(EventCount &&)      = delete;
+  ~EventCount()                  = default;
+
+  template <typename Predicate>
+  void Wait(Predicate &&predicate);
+  template <typename Predicate, typename R, typename P>
+  bool Wait(Predicate &&predicate, std::chrono::duration<R, P> const &duration);
+
+  void NotifyOne();
+  void NotifyAll();
+
+  // Operators
+  EventCount &operator=(EventCount const &) = delete;
+  EventCount &operator=(EventCount &&) = delete;
+
+private:
+  bool HasWaiters() const;
+
+  std::mutex               mutex_;
+  std::condition_variable  cv_;
+  std::atomic<std::size_t> waiters_{0};
+};
+
+/**
+ * Block until the predicate is satisfied
+ *
+ * The predicate is evaluated with the internal mutex held and may have side effects, e.g. claiming
+ * an element from a queue, since it is only ever evaluated until it first returns true.
+ *
+ * @tparam Predicate The type of the predicate
+ * @param predicate The predicate to be satisfied
+ */
+template <typename Predicate>
+void EventCount::Wait(Predicate &&predicate)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  waiters_.fetch_add(1);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  cv_.wait(lock, predicate);
+
+  waiters_.fetch_sub(1);
+}
+
+/**
+ * Block until the predicate is satisfied or the specified duration has elapsed
+ *
+ * @tparam Predicate The type of the predicate
+ * @tparam R The representation of the duration
+ * @tparam P The period of the duration
+ * @param predicate The predicate to be satisfied
+ * @param duration The maximum duration to wait
+ * @return true if the predicate was satisfied, otherwise false
+ */
+template <typename Predicate, typename R, typename P>
+bool EventCount::Wait(Predicate &&predicate, std::chrono::duration<R, P> const &duration)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  waiters_.fetch_add(1);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  bool const success = cv_.wait_for(lock, duration, predicate);
+
+  waiters_.fetch_sub(1);
+
+  return success;
+}
+
+/**
+ * Wake one of the waiting threads, if there are any, to re-evaluate its predicate
+ */
+inline void EventCount::NotifyOne()
+{
+  if (HasWaiters())
+  {
+    {
+      FETCH_LOCK(mutex_);
+    }
+    cv_.notify_one();
+  }
+}
+
+/**
+ * Wake all of the waiting threads, if there are any, to re-evaluate their predicates
+ */
+inline void EventCount::NotifyAll()
+{
+  if (HasWaiters())
+  {
+    {
+      FETCH_LOCK(mutex_);
+    }
+    cv_.notify_all();
+  }
+}
+
+inline bool EventCount::HasWaiters() const
+{
+  // pairs with the fence in Wait: either the waiter observes the change to its condition or the
+  // notifier observes the waiter
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  return waiters_.load(std::memory_order_relaxed) != 0;
+}
+
+}  // namespace core
+}  // namespace fetch
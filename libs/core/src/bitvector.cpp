@@ -19,7 +19,65 @@
 #include "core/bitvector.hpp"
 #include "vectorise/platform.hpp"
 
+#include <algorithm>
+#include <utility>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 namespace fetch {
+namespace {
+
+/**
+ * Count the number of bits set in a sequence of blocks
+ *
+ * When AVX2 is available four blocks are counted at a time, by looking up the count of each nibble
+ * with a byte shuffle and summing the bytes of each block with a SAD against zero.
+ *
+ * @param blocks The start of the sequence
+ * @param count The number of blocks in the sequence
+ * @return The number of set bits
+ */
+std::size_t CountSetBits(BitVector::Block const *blocks, std::size_t count)
+{
+  std::size_t ret{0};
+  std::size_t i{0};
+
+#ifdef __AVX2__
+  if (count >= 4)
+  {
+    __m256i const lookup   = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,  //
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    __m256i const low_mask = _mm256_set1_epi8(0x0f);
+    __m256i       total    = _mm256_setzero_si256();
+
+    for (; (i + 4) <= count; i += 4)
+    {
+      __m256i const value = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(blocks + i));
+      __m256i const low   = _mm256_and_si256(value, low_mask);
+      __m256i const high  = _mm256_and_si256(_mm256_srli_epi16(value, 4), low_mask);
+      __m256i const bytes =
+          _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+
+      total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+
+    alignas(32) uint64_t partial[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(partial), total);
+    ret = static_cast<std::size_t>(partial[0] + partial[1] + partial[2] + partial[3]);
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    ret += static_cast<std::size_t>(platform::CountSetBits(blocks[i]));
+  }
+
+  return ret;
+}
+
+}  // namespace
 
 BitVector::BitVector(std::size_t n)
 {
@@ -27,44 +85,82 @@ BitVector::BitVector(std::size_t n)
 }
 
 BitVector::BitVector(BitVector const &other)
-  : data_(other.data_.Copy())
-  , size_(other.size_)
-  , blocks_(other.blocks_)
-{}
+{
+  *this = other;
+}
+
+BitVector &BitVector::operator=(BitVector const &other)
+{
+  if (this != &other)
+  {
+    heap_   = (other.blocks_ > INLINE_BLOCKS) ? other.heap_.Copy() : UnderlyingArray{};
+    size_   = other.size_;
+    blocks_ = other.blocks_;
+
+    std::copy(other.inline_, other.inline_ + INLINE_BLOCKS, inline_);
+  }
+
+  return *this;
+}
+
+BitVector::BitVector(BitVector &&other) noexcept
+{
+  *this = std::move(other);
+}
+
+/**
+ * Move assignment, leaves the moved-from vector empty
+ *
+ * @param other The vector to move from
+ * @return A reference to this vector
+ */
+BitVector &BitVector::operator=(BitVector &&other) noexcept
+{
+  if (this != &other)
+  {
+    heap_   = std::move(other.heap_);
+    size_   = other.size_;
+    blocks_ = other.blocks_;
+
+    std::copy(other.inline_, other.inline_ + INLINE_BLOCKS, inline_);
+
+    other.heap_   = UnderlyingArray{};
+    other.size_   = 0;
+    other.blocks_ = 0;
+  }
+
+  return *this;
+}
 
 /**
  * Resize the vector to n bits
  *
+ * Vectors of up to INLINE_BIT_SIZE bits are stored inline and do not allocate
+ *
  * @param bit_size The size in bits of the vector
  */
 void BitVector::Resize(std::size_t bit_size)
 {
-  UnderlyingArray old = data_;
-
   // calculate
   std::size_t const num_elements = (bit_size + (ELEMENT_BIT_SIZE - 1)) / ELEMENT_BIT_SIZE;
 
-  data_   = UnderlyingArray(num_elements);
+  heap_   = (num_elements > INLINE_BLOCKS) ? UnderlyingArray(num_elements) : UnderlyingArray{};
   blocks_ = num_elements;
   size_   = bit_size;
 
-  if (bit_size > 0)
-  {
-    SetAllZero();  // TODO(issue 29): Only set those
-  }
+  SetAllZero();  // TODO(issue 29): Only set those
 
   // TODO(issue 29): Copy data;
 }
 
 void BitVector::SetAllZero()
 {
-  data_.SetAllZero();
+  std::fill(data(), data() + blocks_, Block{0});
 }
 
 void BitVector::SetAllOne()
 {
-  auto *buffer = reinterpret_cast<uint8_t *>(data_.pointer());
-  std::memset(buffer, 0xFF, data_.size() * sizeof(Block));
+  std::fill(data(), data() + blocks_, ~Block{0});
 }
 
 bool BitVector::RemapTo(BitVector &dst) const
@@ -113,9 +209,9 @@ bool BitVector::Expand(BitVector const &src, BitVector &dst)
   auto const num_loops = platform::ToLog2(next_size) - platform::ToLog2(current_size);
 
   // define the various pointers to the storage
-  auto      src_buffer = reinterpret_cast<uint8_t const *>(src.data().pointer());
+  auto      src_buffer = reinterpret_cast<uint8_t const *>(src.data());
   uint16_t *int_buffer = nullptr;
-  auto      dst_buffer = reinterpret_cast<uint16_t *>(dst.data().pointer());
+  auto      dst_buffer = reinterpret_cast<uint16_t *>(dst.data());
 
   // in cases larger than 1 and additional buffer is required
   if (num_loops > 1)
@@ -124,7 +220,7 @@ bool BitVector::Expand(BitVector const &src, BitVector &dst)
     intermediate_vector = std::make_unique<BitVector>(dst.size());
 
     // update the intermediate buffer pointer
-    int_buffer = reinterpret_cast<uint16_t *>(intermediate_vector->data().pointer());
+    int_buffer = reinterpret_cast<uint16_t *>(intermediate_vector->data());
 
     // in the case of even number of loops we need to swap the intermediate and destination buffers
     // to ensure the correct final destination
@@ -190,9 +286,9 @@ bool BitVector::Contract(BitVector const &src, BitVector &dst)
   auto const num_loops = platform::ToLog2(current_size) - platform::ToLog2(next_size);
 
   // define the various pointers to the storage
-  auto     src_buffer = reinterpret_cast<uint16_t const *>(src.data().pointer());
+  auto     src_buffer = reinterpret_cast<uint16_t const *>(src.data());
   uint8_t *int_buffer = nullptr;
-  auto     dst_buffer = reinterpret_cast<uint8_t *>(dst.data().pointer());
+  auto     dst_buffer = reinterpret_cast<uint8_t *>(dst.data());
 
   // in cases larger than 1 and additional buffer is required
   if (num_loops > 1)
@@ -201,7 +297,7 @@ bool BitVector::Contract(BitVector const &src, BitVector &dst)
     intermediate_vector = std::make_unique<BitVector>(dst.size());
 
     // update the intermediate buffer pointer
-    int_buffer = reinterpret_cast<uint8_t *>(intermediate_vector->data().pointer());
+    int_buffer = reinterpret_cast<uint8_t *>(intermediate_vector->data());
 
     // in the case of even number of loops we need to swap the intermediate and destination buffers
     // to ensure the correct final destination
@@ -265,9 +361,11 @@ bool BitVector::operator!=(BitVector const &other) const
 BitVector &BitVector::operator^=(BitVector const &other)
 {
   assert(size_ == other.size_);
+  Block *      lhs = data();
+  Block const *rhs = other.data();
   for (std::size_t i = 0; i < blocks_; ++i)
   {
-    data_[i] ^= other.data_[i];
+    lhs[i] ^= rhs[i];
   }
 
   return *this;
@@ -284,9 +382,11 @@ BitVector BitVector::operator^(BitVector const &other) const
 BitVector &BitVector::operator&=(BitVector const &other)
 {
   assert(size_ == other.size_);
+  Block *      lhs = data();
+  Block const *rhs = other.data();
   for (std::size_t i = 0; i < blocks_; ++i)
   {
-    data_[i] &= other.data_[i];
+    lhs[i] &= rhs[i];
   }
 
   return *this;
@@ -302,20 +402,24 @@ BitVector BitVector::operator&(BitVector const &other) const
 
 void BitVector::InlineAndAssign(BitVector const &a, BitVector const &b)
 {
+  assert((a.blocks_ >= blocks_) && (b.blocks_ >= blocks_));
+  Block *      dst = data();
+  Block const *lhs = a.data();
+  Block const *rhs = b.data();
   for (std::size_t i = 0; i < blocks_; ++i)
   {
-    assert(i < data_.size());
-
-    data_[i] = a.data_[i] & b.data_[i];
+    dst[i] = lhs[i] & rhs[i];
   }
 }
 
 BitVector &BitVector::operator|=(BitVector const &other)
 {
   assert(size_ == other.size_);
+  Block *      lhs = data();
+  Block const *rhs = other.data();
   for (std::size_t i = 0; i < blocks_; ++i)
   {
-    data_[i] |= other.data_[i];
+    lhs[i] |= rhs[i];
   }
 
   return *this;
@@ -332,7 +436,7 @@ BitVector BitVector::operator|(BitVector const &other) const
 void BitVector::conditional_flip(std::size_t block, std::size_t bit, uint64_t base)
 {
   assert((base == 1) || (base == 0));
-  data_[block] ^= base << bit;
+  data()[block] ^= base << bit;
 }
 
 void BitVector::conditional_flip(std::size_t bit, uint64_t base)
@@ -342,7 +446,7 @@ void BitVector::conditional_flip(std::size_t bit, uint64_t base)
 
 void BitVector::flip(std::size_t block, std::size_t bit)
 {
-  data_[block] ^= 1ull << bit;
+  data()[block] ^= 1ull << bit;
 }
 
 void BitVector::flip(std::size_t bit)
@@ -352,8 +456,8 @@ void BitVector::flip(std::size_t bit)
 
 BitVector::Block BitVector::bit(std::size_t block, std::size_t b) const
 {
-  assert(block < data_.size());
-  return (data_[block] >> b) & 1u;
+  assert(block < blocks_);
+  return (data()[block] >> b) & 1u;
 }
 
 BitVector::Block BitVector::bit(std::size_t b) const
@@ -364,8 +468,8 @@ BitVector::Block BitVector::bit(std::size_t b) const
 void BitVector::set(std::size_t block, std::size_t bit, uint64_t val)
 {
   uint64_t mask_bit = 1ull << bit;
-  data_[block] &= ~mask_bit;
-  data_[block] |= val << bit;
+  data()[block] &= ~mask_bit;
+  data()[block] |= val << bit;
 }
 
 void BitVector::set(std::size_t bit, uint64_t val)
@@ -375,12 +479,14 @@ void BitVector::set(std::size_t bit, uint64_t val)
 
 BitVector::Block &BitVector::operator()(std::size_t n)
 {
-  return data_.At(n);
+  assert(n < blocks_);
+  return data()[n];
 }
 
 BitVector::Block const &BitVector::operator()(std::size_t n) const
 {
-  return data_.At(n);
+  assert(n < blocks_);
+  return data()[n];
 }
 
 std::size_t BitVector::size() const
@@ -398,26 +504,93 @@ std::size_t BitVector::blocks() const
   return blocks_;
 }
 
-BitVector::UnderlyingArray const &BitVector::data() const
+/**
+ * Count the number of bits set in the vector
+ *
+ * @return The number of set bits
+ */
+std::size_t BitVector::PopCount() const
 {
-  return data_;
+  if (blocks_ == 0)
+  {
+    return 0;
+  }
+
+  Block const *blocks = data();
+
+  std::size_t const last = blocks_ - 1;
+  return CountSetBits(blocks, last) +
+         static_cast<std::size_t>(platform::CountSetBits(blocks[last] & TailMask()));
 }
 
-BitVector::UnderlyingArray &BitVector::data()
+/**
+ * Determine if any bit is set in both this vector and the other, without allocating
+ *
+ * @param other The vector to test against, of the same size
+ * @return true if the vectors have at least one set bit in common, otherwise false
+ */
+bool BitVector::Intersects(BitVector const &other) const
 {
-  return data_;
+  assert(size_ == other.size_);
+
+  if (blocks_ == 0)
+  {
+    return false;
+  }
+
+  Block const *lhs = data();
+  Block const *rhs = other.data();
+
+  std::size_t const last = blocks_ - 1;
+  for (std::size_t i = 0; i < last; ++i)
+  {
+    if ((lhs[i] & rhs[i]) != 0u)
+    {
+      return true;
+    }
+  }
+
+  return (lhs[last] & rhs[last] & TailMask()) != 0u;
 }
 
-std::size_t BitVector::PopCount() const
+/**
+ * Set all the bits of this vector in the destination vector, without allocating
+ *
+ * @param dst The vector to be updated, of the same size
+ * @return The number of bits which were newly set in the destination
+ */
+std::size_t BitVector::OrInto(BitVector &dst) const
 {
-  std::size_t ret = 0;
+  assert(size_ == dst.size_);
+
+  Block const *src    = data();
+  Block *      target = dst.data();
 
+  std::size_t count{0};
   for (std::size_t i = 0; i < blocks_; ++i)
   {
-    ret += static_cast<std::size_t>(platform::CountSetBits(data_[i]));
+    Block added = src[i] & ~target[i];
+    if ((i + 1) == blocks_)
+    {
+      added &= TailMask();
+    }
+
+    count += static_cast<std::size_t>(platform::CountSetBits(added));
+    target[i] |= added;
   }
 
-  return std::min(ret, size_);
+  return count;
+}
+
+/**
+ * Compute the mask of the bits of the last block which are within the size of the vector
+ *
+ * @return The mask of the valid bits
+ */
+BitVector::Block BitVector::TailMask() const
+{
+  std::size_t const tail_bits = size_ & BIT_MASK;
+  return (tail_bits == 0) ? ~Block{0} : ((Block{1} << tail_bits) - 1u);
 }
 
 std::ostream &operator<<(std::ostream &s, BitVector const &b)
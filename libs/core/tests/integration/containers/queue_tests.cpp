@@ -20,11 +20,14 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <numeric>
 #include <thread>
 #include <type_traits>
 #include <vector>
@@ -211,4 +214,128 @@ TEST_F(QueueTests, ProducerConsumer_1p_50c_MPMCQueue)
   ProducerConsumerTest<1, 50>(queue);
 }
 
+TEST(QueueBatchTests, BatchesAreTransferredInOrder)
+{
+  fetch::core::SPSCQueue<int, 64> queue;
+
+  std::vector<int> input(1000);
+  std::iota(input.begin(), input.end(), 0);
+
+  std::thread producer([&queue, &input]() { queue.PushBatch(input.begin(), input.end()); });
+
+  std::vector<int> output;
+  while (output.size() < input.size())
+  {
+    ASSERT_NE(queue.PopBatch(output, 16, std::chrono::seconds{4}), 0);
+  }
+
+  producer.join();
+
+  EXPECT_EQ(output, input);
+}
+
+TEST(QueueBatchTests, BatchesFromManyProducersAreAllReceived)
+{
+  constexpr std::size_t NUM_PRODUCERS = 8;
+  constexpr std::size_t NUM_CONSUMERS = 4;
+  constexpr std::size_t NUM_ELEMENTS  = 10000;
+
+  fetch::core::MPMCQueue<std::size_t, 256> queue;
+
+  std::vector<std::thread> threads;
+  for (std::size_t p = 0; p < NUM_PRODUCERS; ++p)
+  {
+    threads.emplace_back([&queue, p]() {
+      std::vector<std::size_t> batch;
+      for (std::size_t i = 0; i < NUM_ELEMENTS; ++i)
+      {
+        batch.push_back((p * NUM_ELEMENTS) + i);
+        if (batch.size() == 10)
+        {
+          queue.PushBatch(batch.begin(), batch.end());
+          batch.clear();
+        }
+      }
+    });
+  }
+
+  std::mutex               received_mutex;
+  std::vector<std::size_t> received;
+  for (std::size_t c = 0; c < NUM_CONSUMERS; ++c)
+  {
+    threads.emplace_back([&queue, &received, &received_mutex]() {
+      std::vector<std::size_t> batch;
+      for (;;)
+      {
+        batch.clear();
+        if (queue.PopBatch(batch, 32, std::chrono::milliseconds{200}) == 0)
+        {
+          break;
+        }
+
+        FETCH_LOCK(received_mutex);
+        received.insert(received.end(), batch.begin(), batch.end());
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  std::sort(received.begin(), received.end());
+  ASSERT_EQ(received.size(), NUM_PRODUCERS * NUM_ELEMENTS);
+  for (std::size_t i = 0; i < received.size(); ++i)
+  {
+    ASSERT_EQ(received[i], i);
+  }
+}
+
+TEST(QueueBatchTests, PopTimesOutWhenEmpty)
+{
+  fetch::core::MPMCQueue<int, 4> queue;
+
+  int              value{0};
+  std::vector<int> values;
+  EXPECT_FALSE(queue.Pop(value, std::chrono::milliseconds{10}));
+  EXPECT_EQ(queue.PopBatch(values, 4, std::chrono::milliseconds{10}), 0);
+  EXPECT_TRUE(values.empty());
+}
+
+TEST(QueueBatchTests, PushTimesOutWhenFull)
+{
+  fetch::core::MPMCQueue<int, 4> queue;
+
+  std::size_t count{0};
+  for (int i = 0; i < 4; ++i)
+  {
+    EXPECT_TRUE(queue.Push(i, count, std::chrono::milliseconds{10}));
+    EXPECT_EQ(count, static_cast<std::size_t>(i + 1));
+  }
+
+  EXPECT_FALSE(queue.Push(4, count, std::chrono::milliseconds{10}));
+
+  EXPECT_EQ(queue.Pop(), 0);
+  EXPECT_TRUE(queue.Push(4, count, std::chrono::milliseconds{10}));
+}
+
+TEST(QueueBatchTests, LvaluesAreCopiedAndRvaluesAreMoved)
+{
+  fetch::core::MPMCQueue<std::shared_ptr<int>, 4> queue;
+
+  auto element = std::make_shared<int>(42);
+  queue.Push(element);
+  ASSERT_TRUE(element);
+  EXPECT_EQ(element.use_count(), 2);
+
+  queue.Push(std::move(element));
+  EXPECT_FALSE(element);
+
+  auto first  = queue.Pop();
+  auto second = queue.Pop();
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(first.use_count(), 2);
+}
+
 }  // namespace
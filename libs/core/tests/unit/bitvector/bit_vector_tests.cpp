@@ -23,6 +23,7 @@
 #include "gtest/gtest.h"
 
 #include <cstdint>
+#include <utility>
 
 using fetch::BitVector;
 
@@ -36,7 +37,7 @@ fetch::byte_array::ConstByteArray Convert(T const &value)
 
 fetch::byte_array::ConstByteArray Convert(BitVector const &value)
 {
-  auto const *raw = reinterpret_cast<uint8_t const *>(value.data().pointer());
+  auto const *raw = reinterpret_cast<uint8_t const *>(value.data());
 
   return {raw, sizeof(BitVector::Block) * value.blocks()};
 }
@@ -418,3 +419,131 @@ TEST(BitVectorTests, IterateSetBits)
   EXPECT_EQ(itr, end);
   EXPECT_EQ(expected_index_itr, expected_indexes.end());
 }
+
+TEST(BitVectorTests, PopCountIgnoresBitsBeyondSize)
+{
+  BitVector small{4};
+  small.SetAllOne();
+  EXPECT_EQ(small.PopCount(), 4);
+
+  small.set(2, 0);
+  EXPECT_EQ(small.PopCount(), 3);
+
+  BitVector large{1000};
+  large.SetAllOne();
+  EXPECT_EQ(large.PopCount(), 1000);
+
+  large.set(0, 0);
+  large.set(511, 0);
+  large.set(999, 0);
+  EXPECT_EQ(large.PopCount(), 997);
+}
+
+TEST(BitVectorTests, IntersectsOnlyWhenBitsAreShared)
+{
+  for (std::size_t size : {4u, 64u, 256u, 512u, 2048u})
+  {
+    BitVector a{size};
+    BitVector b{size};
+    EXPECT_FALSE(a.Intersects(b));
+
+    a.set(0, 1);
+    b.set(size - 1, 1);
+    EXPECT_FALSE(a.Intersects(b));
+    EXPECT_FALSE(b.Intersects(a));
+
+    b.set(0, 1);
+    EXPECT_TRUE(a.Intersects(b));
+    EXPECT_TRUE(b.Intersects(a));
+  }
+}
+
+TEST(BitVectorTests, IntersectsIgnoresBitsBeyondSize)
+{
+  BitVector a{4};
+  BitVector b{4};
+  a.SetAllOne();
+  b.SetAllOne();
+
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    a.set(i, 0);
+  }
+
+  EXPECT_FALSE(a.Intersects(b));
+}
+
+TEST(BitVectorTests, OrIntoReturnsNumberOfNewBits)
+{
+  for (std::size_t size : {16u, 512u, 1024u})
+  {
+    BitVector used{size};
+    BitVector a{size};
+    BitVector b{size};
+
+    a.set(1, 1);
+    a.set(size - 1, 1);
+    b.set(1, 1);
+    b.set(3, 1);
+
+    EXPECT_EQ(a.OrInto(used), 2);
+    EXPECT_EQ(b.OrInto(used), 1);
+    EXPECT_EQ(b.OrInto(used), 0);
+
+    EXPECT_EQ(used.PopCount(), 3);
+    EXPECT_EQ(used.bit(1), 1);
+    EXPECT_EQ(used.bit(3), 1);
+    EXPECT_EQ(used.bit(size - 1), 1);
+  }
+}
+
+TEST(BitVectorTests, CopiesAreIndependent)
+{
+  for (std::size_t size : {64u, 512u, 4096u})
+  {
+    BitVector original{size};
+    original.set(7, 1);
+
+    BitVector copy{original};
+    BitVector assigned{};
+    assigned = original;
+
+    original.set(7, 0);
+    original.set(9, 1);
+
+    EXPECT_EQ(copy.size(), size);
+    EXPECT_EQ(copy.bit(7), 1);
+    EXPECT_EQ(copy.bit(9), 0);
+    EXPECT_EQ(assigned, copy);
+    EXPECT_NE(assigned, original);
+  }
+}
+
+TEST(BitVectorTests, MovedFromVectorsAreEmpty)
+{
+  for (std::size_t size : {64u, 512u, 4096u})
+  {
+    BitVector original{size};
+    original.set(7, 1);
+
+    BitVector moved{std::move(original)};
+    EXPECT_EQ(moved.size(), size);
+    EXPECT_EQ(moved.bit(7), 1);
+    EXPECT_EQ(original.size(), 0);
+    EXPECT_EQ(original.blocks(), 0);
+    EXPECT_EQ(original.PopCount(), 0);
+
+    BitVector assigned{};
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned.size(), size);
+    EXPECT_EQ(assigned.bit(7), 1);
+    EXPECT_EQ(moved.size(), 0);
+    EXPECT_EQ(moved.blocks(), 0);
+
+    // A moved-from vector can be reused
+    moved.Resize(size);
+    moved.set(9, 1);
+    EXPECT_EQ(moved.PopCount(), 1);
+    EXPECT_EQ(assigned.bit(9), 0);
+  }
+}
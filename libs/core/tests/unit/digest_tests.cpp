@@ -0,0 +1,167 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/byte_array/decoders.hpp"
+#include "core/digest.hpp"
+#include "core/serializers/main_serializer.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace {
+
+using fetch::Digest;
+using fetch::DigestMap;
+using fetch::DigestSet;
+using fetch::InlineDigest;
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::byte_array::FromHex;
+using fetch::serializers::MsgPackSerializer;
+
+Digest const DIGEST_A =
+    FromHex("a1b3c6b2f85a6a8b0d9a1c6b9fbbab8c2a9e1e25cd5d6a4ce4d19bbbdf1d4bd5");
+Digest const DIGEST_B =
+    FromHex("0f5c1b7de7ea7ac20f8f2bbab6a3b5f1a8c0e2c6cdf8b5d9d1f3b8f2d6a4f3c7");
+
+TEST(InlineDigestTests, RoundTripsThroughConstByteArray)
+{
+  InlineDigest const digest{DIGEST_A};
+
+  EXPECT_EQ(digest.size(), 32u);
+  EXPECT_FALSE(digest.empty());
+  EXPECT_EQ(digest.ToConstByteArray(), DIGEST_A);
+  EXPECT_EQ(digest.ToHex(), DIGEST_A.ToHex());
+  EXPECT_EQ(digest.ToBase64(), DIGEST_A.ToBase64());
+
+  Digest const converted = digest;
+  EXPECT_EQ(converted, DIGEST_A);
+}
+
+TEST(InlineDigestTests, DefaultIsEmpty)
+{
+  InlineDigest const digest{};
+
+  EXPECT_TRUE(digest.empty());
+  EXPECT_EQ(digest, InlineDigest{Digest{}});
+  EXPECT_TRUE(digest.ToConstByteArray().empty());
+  EXPECT_TRUE(digest.ToBase64().empty());
+}
+
+TEST(InlineDigestTests, ComparisonsMatchByteArray)
+{
+  InlineDigest const a{DIGEST_A};
+  InlineDigest const b{DIGEST_B};
+  InlineDigest const prefix{DIGEST_A.SubArray(0, 16)};
+
+  EXPECT_EQ(a, InlineDigest{DIGEST_A.Copy()});
+  EXPECT_NE(a, b);
+  EXPECT_NE(a, prefix);
+
+  EXPECT_EQ(a < b, DIGEST_A < DIGEST_B);
+  EXPECT_EQ(b < a, DIGEST_B < DIGEST_A);
+  EXPECT_TRUE(prefix < a);
+  EXPECT_FALSE(a < prefix);
+  EXPECT_FALSE(a < a);
+
+  // mixed comparisons go through the implicit conversions
+  EXPECT_TRUE(a == DIGEST_A);
+  EXPECT_TRUE(DIGEST_A == a);
+  EXPECT_FALSE(DIGEST_B == a);
+}
+
+TEST(InlineDigestTests, OversizedDigestIsRejected)
+{
+  ByteArray oversized;
+  oversized.Resize(InlineDigest::CAPACITY + 1);
+
+  EXPECT_THROW(InlineDigest{oversized}, std::length_error);
+}
+
+TEST(InlineDigestTests, SetAndMapLookupsAcceptByteArrays)
+{
+  DigestSet set{};
+  set.insert(DIGEST_A);
+
+  EXPECT_EQ(set.count(DIGEST_A), 1u);
+  EXPECT_EQ(set.count(DIGEST_A.Copy()), 1u);
+  EXPECT_EQ(set.count(DIGEST_B), 0u);
+
+  DigestMap<int> map{};
+  map[DIGEST_A] = 1;
+  map[DIGEST_B] = 2;
+
+  EXPECT_EQ(map.size(), 2u);
+  EXPECT_EQ(map.at(DIGEST_B.Copy()), 2);
+}
+
+TEST(InlineDigestTests, SerialisedLikeByteArray)
+{
+  InlineDigest const digest{DIGEST_A};
+
+  MsgPackSerializer inline_stream{};
+  inline_stream << digest;
+
+  MsgPackSerializer byte_array_stream{};
+  byte_array_stream << DIGEST_A;
+
+  EXPECT_EQ(inline_stream.data(), byte_array_stream.data());
+
+  // a digest can be read back from a stream containing a byte array
+  InlineDigest recovered{};
+  byte_array_stream.seek(0);
+  byte_array_stream >> recovered;
+
+  EXPECT_EQ(recovered, digest);
+}
+
+TEST(InlineDigestTests, OversizedSerialisedDigestIsRejected)
+{
+  ByteArray oversized;
+  oversized.Resize(InlineDigest::CAPACITY + 1);
+
+  MsgPackSerializer stream{};
+  stream << ConstByteArray{oversized};
+
+  using Serializer = fetch::serializers::StringSerializer<InlineDigest, MsgPackSerializer>;
+
+  InlineDigest recovered{};
+  stream.seek(0);
+  EXPECT_THROW(Serializer::Deserialize(stream, recovered),
+               fetch::serializers::SerializableException);
+}
+
+TEST(InlineDigestTests, DigestSetSerialisationRoundTrip)
+{
+  DigestSet const original{DIGEST_A, DIGEST_B};
+
+  MsgPackSerializer stream{};
+  stream << original;
+
+  DigestSet recovered{};
+  stream.seek(0);
+  stream >> recovered;
+
+  EXPECT_EQ(recovered, original);
+}
+
+}  // namespace
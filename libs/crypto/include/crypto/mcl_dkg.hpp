@@ -28,6 +28,7 @@
 #include <set>
 #include <sstream>
 #include <unordered_map>
+#include <vector>
 
 namespace bn = mcl::bn256;
 
@@ -168,11 +169,22 @@ void      ComputeShares(PrivateKey &s_i, PrivateKey &sprime_i, std::vector<Priva
                         std::vector<PrivateKey> const &b_i, uint32_t index);
 std::vector<PrivateKey> InterpolatePolynom(std::vector<PrivateKey> const &a,
                                            std::vector<PrivateKey> const &b);
+PublicKey MultiScalarMul(std::vector<PublicKey> const & points,
+                         std::vector<PrivateKey> const &scalars);
+Signature MultiScalarMul(std::vector<Signature> const & points,
+                         std::vector<PrivateKey> const &scalars);
+void      BatchInverse(std::vector<PrivateKey> &values);
 
 // For signatures
 Signature SignShare(MessagePayload const &message, PrivateKey const &x_i);
 bool      VerifySign(PublicKey const &y, MessagePayload const &message, Signature const &sign,
                      Generator const &G);
+bool      VerifySignBatch(std::vector<PublicKey> const &y, MessagePayload const &message,
+                          std::vector<Signature> const &signs, Generator const &G);
+std::vector<std::size_t> FindInvalidSignShares(std::vector<PublicKey> const &y,
+                                               MessagePayload const &        message,
+                                               std::vector<Signature> const &signs,
+                                               Generator const &             G);
 Signature LagrangeInterpolation(std::unordered_map<CabinetIndex, Signature> const &shares);
 std::vector<DkgKeyInformation> TrustedDealerGenerateKeys(uint32_t cabinet_size, uint32_t threshold);
 std::pair<PrivateKey, PublicKey> GenerateKeyPair(Generator const &generator);
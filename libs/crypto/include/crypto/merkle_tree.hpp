@@ -33,6 +33,8 @@ public:
   using Container     = std::vector<Digest>;
   using Iterator      = Container::iterator;
   using ConstIterator = Container::const_iterator;
+  using Proof         = std::vector<Digest>;
+  using Proofs        = std::vector<Proof>;
 
   explicit MerkleTree(std::size_t count);
   MerkleTree(MerkleTree const &rhs) = delete;
@@ -57,6 +59,14 @@ public:
 
   void CalculateRoot() const;
 
+  /// @name Inclusion Proofs
+  /// @{
+  Proof       GetProof(std::size_t index) const;
+  Proofs      GetProofs() const;
+  static bool VerifyProof(Digest const &leaf, std::size_t index, std::size_t count,
+                          Proof const &proof, Digest const &root);
+  /// @}
+
   Digest &operator[](std::size_t n);
 
 private:
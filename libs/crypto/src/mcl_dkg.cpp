@@ -20,9 +20,14 @@
 
 #include "mcl/bn256.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <random>
 #include <stdexcept>
+#include <string>
 #include <unordered_map>
 
 namespace bn = mcl::bn256;
@@ -79,6 +84,121 @@ DkgKeyInformation::DkgKeyInformation(PublicKey              group_public_key1,
   , private_key_share{std::move(secret_key_shares1)}
 {}
 
+namespace {
+
+/**
+ * Splits a scalar into little endian windows of the given number of bits
+ */
+std::vector<uint32_t> ScalarWindows(PrivateKey const &scalar, uint32_t window_bits)
+{
+  std::string const hex = scalar.getStr(16);
+
+  std::vector<uint32_t> windows((hex.size() * 4 + window_bits - 1) / window_bits, 0);
+  for (std::size_t i = 0; i < hex.size(); ++i)
+  {
+    char const c = hex[hex.size() - 1 - i];
+    uint32_t   nibble{0};
+    if (c >= '0' && c <= '9')
+    {
+      nibble = static_cast<uint32_t>(c - '0');
+    }
+    else if (c >= 'a' && c <= 'f')
+    {
+      nibble = static_cast<uint32_t>(c - 'a' + 10);
+    }
+    else
+    {
+      nibble = static_cast<uint32_t>(c - 'A' + 10);
+    }
+
+    for (uint32_t bit = 0; bit < 4; ++bit)
+    {
+      if ((nibble >> bit) & 1u)
+      {
+        auto const position = static_cast<uint32_t>(i * 4 + bit);
+        windows[position / window_bits] |= 1u << (position % window_bits);
+      }
+    }
+  }
+
+  return windows;
+}
+
+/**
+ * Pippenger's bucket method. Each window of c bits costs one addition per point plus 2^(c+1)
+ * additions to combine the buckets, instead of a full double-and-add per point
+ */
+template <typename Point>
+Point PippengerMultiScalarMul(std::vector<Point> const &     points,
+                              std::vector<PrivateKey> const &scalars)
+{
+  assert(points.size() == scalars.size());
+
+  Point result;
+  if (points.size() < 4)
+  {
+    Point term;
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+      Point::mul(term, points[i], scalars[i]);
+      Point::add(result, result, term);
+    }
+    return result;
+  }
+
+  uint32_t window_bits{2};
+  while ((std::size_t{1} << (window_bits + 2)) < points.size() && window_bits < 16)
+  {
+    ++window_bits;
+  }
+
+  std::vector<std::vector<uint32_t>> windows;
+  windows.reserve(scalars.size());
+  std::size_t num_windows{0};
+  for (auto const &scalar : scalars)
+  {
+    windows.push_back(ScalarWindows(scalar, window_bits));
+    num_windows = std::max(num_windows, windows.back().size());
+  }
+
+  std::vector<Point> buckets((std::size_t{1} << window_bits) - 1);
+  for (std::size_t w = num_windows; w-- > 0;)
+  {
+    for (uint32_t bit = 0; bit < window_bits; ++bit)
+    {
+      Point::dbl(result, result);
+    }
+
+    for (auto &bucket : buckets)
+    {
+      bucket.clear();
+    }
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+      if (w < windows[i].size() && windows[i][w] != 0)
+      {
+        auto &bucket = buckets[windows[i][w] - 1];
+        Point::add(bucket, bucket, points[i]);
+      }
+    }
+
+    // sum_d d * bucket_d, accumulated as a running sum from the largest digit down
+    Point running;
+    Point window_sum;
+    for (std::size_t d = buckets.size(); d-- > 0;)
+    {
+      Point::add(running, running, buckets[d]);
+      Point::add(window_sum, window_sum, running);
+    }
+    Point::add(result, result, window_sum);
+  }
+
+  return result;
+}
+
+}  // namespace
+
 void SetGenerator(Generator &generator_g, std::string const &string_to_hash)
 {
   assert(!string_to_hash.empty());
@@ -119,30 +239,91 @@ PublicKey ComputeLHS(Generator const &G, Generator const &H, PrivateKey const &s
   return ComputeLHS(tmpG, G, H, share1, share2);
 }
 
+/**
+ * Adds sum_{k >= 1} input[k] * (rank + 1)^k to rhsG. The evaluation point is a small cabinet
+ * index, so Horner's rule costs one short scalar multiplication per coefficient
+ */
 void UpdateRHS(uint32_t rank, PublicKey &rhsG, std::vector<PublicKey> const &input)
 {
-  PrivateKey tmpF{1};
-  PublicKey  tmpG;
   assert(!input.empty());
-  for (uint32_t k = 1; k < input.size(); k++)
+  if (input.size() == 1)
+  {
+    return;
+  }
+
+  PrivateKey const point{rank + 1};  // adjust rank in computation
+  PublicKey        acc = input.back();
+  for (std::size_t k = input.size() - 1; k > 1; --k)
   {
-    bn::Fr::pow(tmpF, rank + 1, k);  // adjust rank in computation
-    bn::G2::mul(tmpG, input[k], tmpF);
-    bn::G2::add(rhsG, rhsG, tmpG);
+    bn::G2::mul(acc, acc, point);
+    bn::G2::add(acc, acc, input[k - 1]);
   }
+  bn::G2::mul(acc, acc, point);
+  bn::G2::add(rhsG, rhsG, acc);
 }
 
 PublicKey ComputeRHS(uint32_t rank, std::vector<PublicKey> const &input)
 {
-  PrivateKey tmpF;
-  PublicKey  tmpG, rhsG;
   assert(!input.empty());
-  // initialise rhsG
-  rhsG = input[0];
+  PublicKey rhsG = input[0];
   UpdateRHS(rank, rhsG, input);
   return rhsG;
 }
 
+/**
+ * Computes sum_i scalars[i] * points[i] with a multi-scalar multiplication
+ *
+ * @param points Group elements
+ * @param scalars Scalar for each group element
+ * @return The linear combination
+ */
+PublicKey MultiScalarMul(std::vector<PublicKey> const & points,
+                         std::vector<PrivateKey> const &scalars)
+{
+  return PippengerMultiScalarMul(points, scalars);
+}
+
+Signature MultiScalarMul(std::vector<Signature> const & points,
+                         std::vector<PrivateKey> const &scalars)
+{
+  return PippengerMultiScalarMul(points, scalars);
+}
+
+/**
+ * Inverts every element in place with a single field inversion (Montgomery's trick)
+ *
+ * @param values Non-zero field elements to be inverted
+ */
+void BatchInverse(std::vector<PrivateKey> &values)
+{
+  if (values.empty())
+  {
+    return;
+  }
+
+  // prefix[i] holds the product of values[0..i)
+  std::vector<PrivateKey> prefix(values.size());
+  PrivateKey              acc{1};
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    if (values[i].isZero())
+    {
+      throw std::invalid_argument("BatchInverse: zero has no inverse");
+    }
+    prefix[i] = acc;
+    bn::Fr::mul(acc, acc, values[i]);
+  }
+
+  bn::Fr::inv(acc, acc);
+  for (std::size_t i = values.size(); i-- > 0;)
+  {
+    PrivateKey inverse;
+    bn::Fr::mul(inverse, acc, prefix[i]);
+    bn::Fr::mul(acc, acc, values[i]);
+    values[i] = inverse;
+  }
+}
+
 /**
  * Given two polynomials (f and f') with coefficients a_i and b_i, we compute the evaluation of
  * these polynomials at different points
@@ -156,18 +337,19 @@ PublicKey ComputeRHS(uint32_t rank, std::vector<PublicKey> const &input)
 void ComputeShares(PrivateKey &s_i, PrivateKey &sprime_i, std::vector<PrivateKey> const &a_i,
                    std::vector<PrivateKey> const &b_i, uint32_t index)
 {
-  PrivateKey pow, tmpF;
   assert(a_i.size() == b_i.size());
   assert(!a_i.empty());
-  s_i      = a_i[0];
-  sprime_i = b_i[0];
-  for (uint32_t k = 1; k < a_i.size(); k++)
+
+  // Horner's rule
+  PrivateKey const point{index + 1};  // adjust index in computation
+  s_i      = a_i.back();
+  sprime_i = b_i.back();
+  for (std::size_t k = a_i.size() - 1; k > 0; --k)
   {
-    bn::Fr::pow(pow, index + 1, k);  // adjust index in computation
-    bn::Fr::mul(tmpF, pow, b_i[k]);  // j^k * b_i[k]
-    bn::Fr::add(sprime_i, sprime_i, tmpF);
-    bn::Fr::mul(tmpF, pow, a_i[k]);  // j^k * a_i[k]
-    bn::Fr::add(s_i, s_i, tmpF);
+    bn::Fr::mul(s_i, s_i, point);
+    bn::Fr::add(s_i, s_i, a_i[k - 1]);
+    bn::Fr::mul(sprime_i, sprime_i, point);
+    bn::Fr::add(sprime_i, sprime_i, b_i[k - 1]);
   }
 }
 
@@ -186,16 +368,26 @@ std::vector<PrivateKey> InterpolatePolynom(std::vector<PrivateKey> const &a,
   {
     throw std::invalid_argument("mcl_interpolate_polynom: bad m");
   }
+
+  // The Newton denominators prod_{i < k} (a_k - a_i) do not depend on the partial results, so they
+  // are all inverted together
+  std::vector<PrivateKey> denominators(m, PrivateKey{1});
+  PrivateKey              diff;
+  for (std::size_t k = 1; k < m; k++)
+  {
+    for (std::size_t i = 0; i < k; i++)
+    {
+      bn::Fr::sub(diff, a[k], a[i]);
+      bn::Fr::mul(denominators[k], denominators[k], diff);
+    }
+  }
+  BatchInverse(denominators);
+
   std::vector<PrivateKey> prod{a}, res;
   res.resize(m);
   for (std::size_t k = 0; k < m; k++)
   {
-    PrivateKey t1{1};
-    for (auto i = static_cast<long>(k - 1); i >= 0; i--)
-    {
-      bn::Fr::mul(t1, t1, a[k]);
-      bn::Fr::add(t1, t1, prod[static_cast<std::size_t>(i)]);
-    }
+    PrivateKey t1 = denominators[k];
 
     PrivateKey t2{0};
     for (auto i = static_cast<long>(k - 1); i >= 0; i--)
@@ -203,7 +395,6 @@ std::vector<PrivateKey> InterpolatePolynom(std::vector<PrivateKey> const &a,
       bn::Fr::mul(t2, t2, a[k]);
       bn::Fr::add(t2, t2, res[static_cast<std::size_t>(i)]);
     }
-    bn::Fr::inv(t1, t1);
 
     bn::Fr::sub(t2, b[k], t2);
     bn::Fr::mul(t1, t1, t2);
@@ -278,6 +469,169 @@ bool VerifySign(PublicKey const &y, MessagePayload const &message, Signature con
   return e1 == e2;
 }
 
+namespace {
+
+using Indices = std::vector<std::size_t>;
+
+/**
+ * Draws a random 64 bit coefficient for a batch verification. Small coefficients keep the scalar
+ * multiplications cheap while leaving a forger a 2^-64 chance of passing an invalid batch
+ */
+PrivateKey RandomBatchCoefficient(std::random_device &rd)
+{
+  PrivateKey const word{1u << 16u};
+  PrivateKey       coefficient{rd()};
+
+  bn::Fr::mul(coefficient, coefficient, word);
+  bn::Fr::mul(coefficient, coefficient, word);
+  bn::Fr::add(coefficient, coefficient, PrivateKey{rd()});
+
+  return coefficient;
+}
+
+/**
+ * Checks e(sum r_i sign_i, G) == e(H(m), sum r_i y_i) over the selected shares, which holds for
+ * random r_i only if every share satisfies e(sign_i, G) == e(H(m), y_i)
+ */
+bool VerifyCombination(std::vector<PublicKey> const &y, Signature const &PH,
+                       std::vector<Signature> const &signs, Generator const &G,
+                       Indices::const_iterator begin, Indices::const_iterator end,
+                       std::random_device &rd)
+{
+  Signature combined_sign;
+  PublicKey combined_key;
+
+  if (std::distance(begin, end) == 1)
+  {
+    combined_sign = signs[*begin];
+    combined_key  = y[*begin];
+  }
+  else
+  {
+    Signature sign_term;
+    PublicKey key_term;
+    for (auto it = begin; it != end; ++it)
+    {
+      PrivateKey const coefficient = RandomBatchCoefficient(rd);
+
+      bn::G1::mul(sign_term, signs[*it], coefficient);
+      bn::G1::add(combined_sign, combined_sign, sign_term);
+      bn::G2::mul(key_term, y[*it], coefficient);
+      bn::G2::add(combined_key, combined_key, key_term);
+    }
+  }
+
+  bn::Fp12 e1, e2;
+  bn::pairing(e1, combined_sign, G);
+  bn::pairing(e2, PH, combined_key);
+
+  return e1 == e2;
+}
+
+/**
+ * Bisects a range of shares whose combination is known to be invalid until the invalid shares
+ * are isolated. When the first half passes the second half must contain an invalid share, so it
+ * is split without being checked as a whole
+ */
+void BisectInvalid(std::vector<PublicKey> const &y, Signature const &PH,
+                   std::vector<Signature> const &signs, Generator const &G,
+                   Indices::const_iterator begin, Indices::const_iterator end,
+                   std::random_device &rd, Indices &invalid)
+{
+  auto const count = std::distance(begin, end);
+  if (count == 1)
+  {
+    invalid.push_back(*begin);
+    return;
+  }
+
+  auto const middle = begin + (count / 2);
+  if (VerifyCombination(y, PH, signs, G, begin, middle, rd))
+  {
+    BisectInvalid(y, PH, signs, G, middle, end, rd, invalid);
+    return;
+  }
+
+  BisectInvalid(y, PH, signs, G, begin, middle, rd, invalid);
+  if (!VerifyCombination(y, PH, signs, G, middle, end, rd))
+  {
+    BisectInvalid(y, PH, signs, G, middle, end, rd, invalid);
+  }
+}
+
+Signature HashToG1(MessagePayload const &message)
+{
+  Signature PH;
+  bn::Fp    Hm;
+  Hm.setHashOf(message.pointer(), message.size());
+  bn::mapToG1(PH, Hm);
+  return PH;
+}
+
+}  // namespace
+
+/**
+ * Verifies a batch of signature shares of the same message with a single pair of pairings, using
+ * a random linear combination of the shares
+ *
+ * @param y Public key shares of the signers
+ * @param message Message that was signed
+ * @param signs Signature shares, where signs[i] was produced by the owner of y[i]
+ * @param G Generator used in DKG
+ * @return true if every share is valid
+ */
+bool VerifySignBatch(std::vector<PublicKey> const &y, MessagePayload const &message,
+                     std::vector<Signature> const &signs, Generator const &G)
+{
+  assert(y.size() == signs.size());
+  if (signs.empty())
+  {
+    return true;
+  }
+
+  Indices indices(signs.size());
+  std::iota(indices.begin(), indices.end(), 0);
+
+  std::random_device rd;
+  return VerifyCombination(y, HashToG1(message), signs, G, indices.cbegin(), indices.cend(), rd);
+}
+
+/**
+ * Verifies a batch of signature shares of the same message and identifies the invalid ones. The
+ * whole batch is checked first, falling back to bisection only when it fails
+ *
+ * @param y Public key shares of the signers
+ * @param message Message that was signed
+ * @param signs Signature shares, where signs[i] was produced by the owner of y[i]
+ * @param G Generator used in DKG
+ * @return Positions of the invalid shares in ascending order
+ */
+std::vector<std::size_t> FindInvalidSignShares(std::vector<PublicKey> const &y,
+                                               MessagePayload const &        message,
+                                               std::vector<Signature> const &signs,
+                                               Generator const &             G)
+{
+  assert(y.size() == signs.size());
+
+  Indices invalid;
+  if (signs.empty())
+  {
+    return invalid;
+  }
+
+  Indices indices(signs.size());
+  std::iota(indices.begin(), indices.end(), 0);
+
+  std::random_device rd;
+  Signature const    PH = HashToG1(message);
+  if (!VerifyCombination(y, PH, signs, G, indices.cbegin(), indices.cend(), rd))
+  {
+    BisectInvalid(y, PH, signs, G, indices.cbegin(), indices.cend(), rd, invalid);
+  }
+
+  return invalid;
+}
+
 /**
  * Computes the group signature using the indices and signature shares of threshold_ + 1
  * parties
@@ -292,7 +646,6 @@ Signature LagrangeInterpolation(std::unordered_map<CabinetIndex, Signature> cons
   {
     return shares.begin()->second;
   }
-  Signature res;
 
   PrivateKey a{1};
   for (auto &p : shares)
@@ -300,9 +653,15 @@ Signature LagrangeInterpolation(std::unordered_map<CabinetIndex, Signature> cons
     a *= bn::Fr(p.first + 1);
   }
 
+  // The share of member i is weighted by a / b_i, where b_i = (i + 1) prod_{j != i} (j - i)
+  std::vector<Signature>  signatures;
+  std::vector<PrivateKey> coefficients;
+  signatures.reserve(shares.size());
+  coefficients.reserve(shares.size());
+
   for (auto &p1 : shares)
   {
-    auto b = static_cast<bn::Fr>(p1.first + 1);
+    PrivateKey b{p1.first + 1};
     for (auto &p2 : shares)
     {
       if (p2.first != p1.first)
@@ -310,11 +669,17 @@ Signature LagrangeInterpolation(std::unordered_map<CabinetIndex, Signature> cons
         b *= static_cast<bn::Fr>(p2.first) - static_cast<bn::Fr>(p1.first);
       }
     }
-    Signature t;
-    bn::G1::mul(t, p1.second, a / b);
-    res += t;
+    signatures.push_back(p1.second);
+    coefficients.push_back(b);
   }
-  return res;
+
+  BatchInverse(coefficients);
+  for (auto &coefficient : coefficients)
+  {
+    bn::Fr::mul(coefficient, coefficient, a);
+  }
+
+  return MultiScalarMul(signatures, coefficients);
 }
 
 /**
@@ -24,12 +24,65 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <stdexcept>
 
 namespace fetch {
 namespace crypto {
 
 using HashArray = MerkleTree::Digest;
 using Container = MerkleTree::Container;
+using Levels    = std::vector<Container>;
+
+namespace {
+
+/**
+ * Build every level of the tree, from the (padded) leaf nodes up to the root, in the same way as
+ * MerkleTree::CalculateRoot
+ *
+ * @param leaf_nodes The non-empty set of leaf nodes
+ * @return The levels of the tree, the last of which only contains the root
+ */
+Levels CalculateLevels(Container const &leaf_nodes)
+{
+  assert(!leaf_nodes.empty());
+
+  Levels levels{leaf_nodes};
+  while (!platform::IsLog2(uint64_t(levels.back().size())))
+  {
+    levels.back().emplace_back();
+  }
+
+  while (levels.back().size() > 1)
+  {
+    Container const &children = levels.back();
+
+    Container parents{};
+    parents.reserve(children.size() / 2);
+    for (std::size_t i = 0; i < children.size(); i += 2)
+    {
+      parents.emplace_back(Hash<crypto::SHA256>(children[i] + children[i + 1]));
+    }
+
+    levels.emplace_back(std::move(parents));
+  }
+
+  return levels;
+}
+
+MerkleTree::Proof ExtractProof(Levels const &levels, std::size_t index)
+{
+  MerkleTree::Proof proof{};
+  proof.reserve(levels.size() - 1);
+
+  for (std::size_t level = 0; level + 1 < levels.size(); ++level, index >>= 1u)
+  {
+    proof.emplace_back(levels[level][index ^ 1u]);
+  }
+
+  return proof;
+}
+
+}  // namespace
 
 MerkleTree::MerkleTree(std::size_t count)
   : leaf_nodes_{count}
@@ -80,6 +133,87 @@ void MerkleTree::CalculateRoot() const
   root_ = hashes[0];
 }
 
+/**
+ * Generate the inclusion proof for a leaf node of the tree
+ *
+ * @param index The index of the leaf node
+ * @return The sibling hashes on the path from the leaf node to the root
+ */
+MerkleTree::Proof MerkleTree::GetProof(std::size_t index) const
+{
+  if (index >= leaf_nodes_.size())
+  {
+    throw std::out_of_range("Merkle proof requested for a leaf node outside of the tree");
+  }
+
+  return ExtractProof(CalculateLevels(leaf_nodes_), index);
+}
+
+/**
+ * Generate the inclusion proofs for all the leaf nodes of the tree. This only builds the tree
+ * once, rather than once per proof.
+ *
+ * @return The proofs indexed by leaf node
+ */
+MerkleTree::Proofs MerkleTree::GetProofs() const
+{
+  Proofs proofs{};
+
+  if (!leaf_nodes_.empty())
+  {
+    auto const levels = CalculateLevels(leaf_nodes_);
+
+    proofs.reserve(leaf_nodes_.size());
+    for (std::size_t index = 0; index < leaf_nodes_.size(); ++index)
+    {
+      proofs.emplace_back(ExtractProof(levels, index));
+    }
+  }
+
+  return proofs;
+}
+
+/**
+ * Check that a leaf node is part of a tree with a given root
+ *
+ * @param leaf The value of the leaf node
+ * @param index The index of the leaf node
+ * @param count The total number of leaf nodes in the tree
+ * @param proof The inclusion proof for the leaf node
+ * @param root The expected root of the tree
+ * @return true if the proof is valid, otherwise false
+ */
+bool MerkleTree::VerifyProof(Digest const &leaf, std::size_t index, std::size_t count,
+                             Proof const &proof, Digest const &root)
+{
+  if (index >= count)
+  {
+    return false;
+  }
+
+  // the depth of the tree is fixed by the number of leaf nodes
+  std::size_t depth = 0;
+  while ((std::size_t{1} << depth) < count)
+  {
+    ++depth;
+  }
+
+  if (proof.size() != depth)
+  {
+    return false;
+  }
+
+  Digest node = leaf;
+  for (auto const &sibling : proof)
+  {
+    node = (index & 1u) ? Hash<crypto::SHA256>(sibling + node)
+                        : Hash<crypto::SHA256>(node + sibling);
+    index >>= 1u;
+  }
+
+  return node == root;
+}
+
 MerkleTree::Digest const &MerkleTree::root() const
 {
   return root_;
@@ -20,9 +20,12 @@
 
 #include "gtest/gtest.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <ostream>
+#include <stdexcept>
+#include <vector>
 
 using namespace fetch::crypto::mcl;
 using namespace fetch::byte_array;
@@ -141,6 +144,46 @@ TEST(MclDkgTests, ComputeLhsRhs)
   EXPECT_EQ(rhs, rhs_test);
 }
 
+TEST(MclDkgTests, MultiScalarMulAndBatchInverse)
+{
+  details::MCLInitialiser();
+
+  Generator generator;
+  SetGenerator(generator);
+
+  for (std::size_t count : {1u, 3u, 17u, 100u})
+  {
+    std::vector<PublicKey>  points(count);
+    std::vector<PrivateKey> scalars(count);
+    PublicKey               expected;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      PrivateKey exponent;
+      exponent.setRand();
+      bn::G2::mul(points[i], generator, exponent);
+      scalars[i].setRand();
+
+      PublicKey term;
+      bn::G2::mul(term, points[i], scalars[i]);
+      bn::G2::add(expected, expected, term);
+    }
+
+    EXPECT_EQ(MultiScalarMul(points, scalars), expected);
+
+    std::vector<PrivateKey> inverses{scalars};
+    BatchInverse(inverses);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      PrivateKey product;
+      bn::Fr::mul(product, scalars[i], inverses[i]);
+      EXPECT_EQ(product, PrivateKey{1});
+    }
+  }
+
+  std::vector<PrivateKey> with_zero{PrivateKey{2}, PrivateKey{0}};
+  EXPECT_THROW(BatchInverse(with_zero), std::invalid_argument);
+}
+
 TEST(MclDkgTests, Interpolation)
 {
   details::MCLInitialiser();
@@ -232,6 +275,45 @@ TEST(MclDkgTests, Signing)
   EXPECT_TRUE(VerifySign(outputs[0].group_public_key, message, group_signature, group_g));
 }
 
+TEST(MclDkgTests, BatchSigningVerification)
+{
+  details::MCLInitialiser();
+
+  uint32_t cabinet_size = 50;
+  uint32_t threshold    = 26;
+
+  auto outputs = TrustedDealerGenerateKeys(cabinet_size, threshold);
+
+  Generator group_g;
+  SetGenerator(group_g);
+
+  MessagePayload         message = "Hello";
+  std::vector<PublicKey> public_keys;
+  std::vector<Signature> signatures;
+  for (uint32_t i = 0; i < cabinet_size; ++i)
+  {
+    public_keys.push_back(outputs[i].public_key_shares[i]);
+    signatures.push_back(SignShare(message, outputs[i].private_key_share));
+  }
+
+  EXPECT_TRUE(VerifySignBatch(public_keys, message, signatures, group_g));
+  EXPECT_TRUE(FindInvalidSignShares(public_keys, message, signatures, group_g).empty());
+
+  // Shares which are valid for another member or another message are both rejected
+  signatures[7]  = signatures[8];
+  signatures[31] = SignShare("Goodbye", outputs[31].private_key_share);
+
+  EXPECT_FALSE(VerifySignBatch(public_keys, message, signatures, group_g));
+  EXPECT_EQ(FindInvalidSignShares(public_keys, message, signatures, group_g),
+            (std::vector<std::size_t>{7, 31}));
+
+  // A lone invalid share is found as well
+  std::vector<PublicKey> single_key{public_keys[7]};
+  std::vector<Signature> single_signature{signatures[7]};
+  EXPECT_EQ(FindInvalidSignShares(single_key, message, single_signature, group_g),
+            (std::vector<std::size_t>{0}));
+}
+
 TEST(MclDkgTests, GenerateKeys)
 {
   details::MCLInitialiser();
@@ -25,6 +25,9 @@
 
 #include "gtest/gtest.h"
 
+#include <stdexcept>
+#include <string>
+
 using namespace fetch;
 using namespace fetch::crypto;
 
@@ -198,3 +201,38 @@ TEST(crypto_merkle_tree, same_result_after_move)
   EXPECT_EQ(tree.root().size(), 256 / 8);
   EXPECT_EQ(tree.root(), root_before);
 }
+
+TEST(crypto_merkle_tree, proofs_verify_against_the_root)
+{
+  for (std::size_t count : {1u, 2u, 5u, 8u, 13u})
+  {
+    MerkleTree tree{count};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      tree[i] = Hash<crypto::SHA256>(std::to_string(i));
+    }
+    tree.CalculateRoot();
+
+    auto const proofs = tree.GetProofs();
+    ASSERT_EQ(proofs.size(), count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      EXPECT_EQ(proofs[i], tree.GetProof(i));
+      EXPECT_TRUE(MerkleTree::VerifyProof(tree[i], i, count, proofs[i], tree.root()));
+
+      // the proof is bound to the leaf, its position and the size of the tree
+      EXPECT_FALSE(MerkleTree::VerifyProof(Hash<crypto::SHA256>("other"), i, count, proofs[i],
+                                           tree.root()));
+      EXPECT_FALSE(MerkleTree::VerifyProof(tree[i], i, count * 2 + 1, proofs[i], tree.root()));
+      if (count > 1)
+      {
+        EXPECT_FALSE(
+            MerkleTree::VerifyProof(tree[i], (i + 1) % count, count, proofs[i], tree.root()));
+      }
+    }
+  }
+
+  MerkleTree tree{3};
+  EXPECT_THROW(tree.GetProof(3), std::out_of_range);
+}
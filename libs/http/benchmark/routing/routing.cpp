@@ -0,0 +1,143 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "http/method.hpp"
+#include "http/route.hpp"
+#include "http/router.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::http::Method;
+using fetch::http::Route;
+using fetch::http::Router;
+using fetch::http::ViewParameters;
+
+struct MountedRoute
+{
+  Method method;
+  Route  route;
+};
+
+// Routes of the kind mounted by the HTTP modules of a constellation node
+std::vector<MountedRoute> CreateRoutes()
+{
+  std::vector<MountedRoute> routes;
+
+  auto const add = [&routes](Method method, ByteArray const &path) {
+    routes.push_back(MountedRoute{method, Route::FromString(path)});
+  };
+
+  for (std::string const module : {"token", "contract", "status", "health", "mainchain", "p2p",
+                                   "muddle", "dag", "dmlf", "telemetry", "ledger", "debug"})
+  {
+    add(Method::GET, ByteArray{"/api/" + module + "/"});
+    add(Method::GET, ByteArray{"/api/" + module + "/status"});
+    add(Method::POST, ByteArray{"/api/" + module + "/submit"});
+    add(Method::GET, ByteArray{"/api/" + module + "/(digest=[a-fA-F0-9]{64})/"});
+  }
+
+  add(Method::POST, "/api/contract/(identifier=[1-9A-HJ-NP-Za-km-z]{48,50})/(query=.+)");
+  add(Method::GET, "/api/tx/(digest=[a-fA-F0-9]{64})/");
+  add(Method::GET, "/");
+
+  return routes;
+}
+
+struct Request
+{
+  Method         method;
+  ConstByteArray path;
+};
+
+std::vector<Request> const REQUESTS = {
+    {Method::GET, "/api/status"},
+    {Method::GET, "/api/ledger/status"},
+    {Method::GET, "/api/tx/0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef/"},
+    {Method::POST, "/api/contract/MnrRHdvCkdZodEwM855vemS5V3p2hiWmcSQ8JEzD4ZjPdsYtB/balance"},
+    {Method::GET, "/api/unknown/path"}};
+
+void Routing_LinearScan(benchmark::State &state)
+{
+  auto           routes = CreateRoutes();
+  ViewParameters params;
+
+  std::size_t matched = 0;
+  for (auto _ : state)
+  {
+    for (auto const &request : REQUESTS)
+    {
+      for (auto &mounted : routes)
+      {
+        if ((mounted.method == request.method) && mounted.route.Match(request.path, params))
+        {
+          ++matched;
+          break;
+        }
+      }
+    }
+  }
+
+  benchmark::DoNotOptimize(matched);
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(REQUESTS.size()));
+}
+
+void Routing_Router(benchmark::State &state)
+{
+  auto   routes = CreateRoutes();
+  Router router;
+  for (std::size_t i = 0; i < routes.size(); ++i)
+  {
+    router.Add(routes[i].method, routes[i].route.prefix(), i);
+  }
+
+  ViewParameters params;
+
+  std::size_t matched = 0;
+  for (auto _ : state)
+  {
+    for (auto const &request : REQUESTS)
+    {
+      for (auto index : router.Candidates(request.method, request.path))
+      {
+        if (routes[index].route.Match(request.path, params))
+        {
+          ++matched;
+          break;
+        }
+      }
+    }
+  }
+
+  benchmark::DoNotOptimize(matched);
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(REQUESTS.size()));
+}
+
+}  // namespace
+
+BENCHMARK(Routing_LinearScan);
+BENCHMARK(Routing_Router);
@@ -19,6 +19,7 @@
 
 #include "core/byte_array/byte_array.hpp"
 #include "core/byte_array/const_byte_array.hpp"
+#include "http/segment_matcher.hpp"
 #include "http/validators.hpp"
 #include "http/view_parameters.hpp"
 #include "logging/logging.hpp"
@@ -26,6 +27,7 @@
 #include <cstddef>
 #include <functional>
 #include <regex>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -128,6 +130,13 @@ public:
     return path_;
   }
 
+  /// The literal part of the route before its first parameter, which every matching path starts
+  /// with
+  byte_array::ConstByteArray const &prefix() const
+  {
+    return prefix_;
+  }
+
   ParameterList path_parameters() const
   {
     return path_parameters_;
@@ -154,6 +163,11 @@ public:
 private:
   void AddMatch(byte_array::ByteArray const &value)
   {
+    if (match_.empty())
+    {
+      prefix_ = value;
+    }
+
     match_.push_back([value](std::size_t &i, byte_array::ByteArray const &path, ViewParameters &) {
       bool ret = path.Match(value, i);
       if (ret)
@@ -179,9 +193,28 @@ private:
     byte_array::ByteArray var = value.SubArray(0, i);
     ++i;
 
-    std::string reg = "^" + std::string(value.SubArray(i, value.size() - i));
+    std::string const pattern = std::string(value.SubArray(i, value.size() - i));
+
+    SegmentMatcher matcher;
+    if (SegmentMatcher::Compile(pattern, matcher))
+    {
+      match_.push_back([matcher, var](std::size_t &i, byte_array::ByteArray const &path,
+                                      ViewParameters &params) {
+        std::size_t const length = matcher.Match(path.pointer() + i, path.size() - i);
+        if (length == SegmentMatcher::NO_MATCH)
+        {
+          return false;
+        }
+
+        params[var] = path.SubArray(i, length);
+        i += length;
+
+        return true;
+      });
+      return var;
+    }
 
-    std::regex rgx(reg);
+    std::regex rgx("^" + pattern);
     match_.push_back(
         [rgx, var](std::size_t &i, byte_array::ByteArray const &path, ViewParameters &params) {
           std::string s = std::string(path.SubArray(i));
@@ -210,6 +243,7 @@ private:
 
   byte_array::ByteArray original_;
   byte_array::ByteArray path_;
+  byte_array::ByteArray prefix_;
   MatchingVector        match_;
   ParameterList         path_parameters_;
   ValidatorMap          validators_;
@@ -0,0 +1,75 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "http/method.hpp"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace http {
+
+/**
+ * Index of the routes mounted on a server, used to avoid testing every route against every
+ * request.
+ *
+ * Routes are registered by the literal prefix preceding their first parameter (see
+ * Route::prefix) in a radix tree per method. Looking a path up walks the tree once along the path
+ * and yields the routes whose prefix the path starts with, which are the only ones that can match
+ * it. Candidates are returned in registration order, so that testing them in turn selects the same
+ * route as testing every route would.
+ */
+class Router
+{
+public:
+  using RouteIndex   = std::size_t;
+  using RouteIndices = std::vector<RouteIndex>;
+
+  Router()               = default;
+  Router(Router const &) = delete;
+  Router(Router &&)      = default;
+  ~Router()              = default;
+
+  Router &operator=(Router const &) = delete;
+  Router &operator=(Router &&) = default;
+
+  void         Add(Method method, byte_array::ConstByteArray const &prefix, RouteIndex index);
+  RouteIndices Candidates(Method method, byte_array::ConstByteArray const &path) const;
+
+private:
+  struct Node
+  {
+    using NodePtr = std::unique_ptr<Node>;
+
+    std::string          label;
+    std::vector<NodePtr> children;
+    RouteIndices         routes;
+
+    Node *FindChild(char c) const;
+  };
+
+  std::map<Method, Node> roots_;
+};
+
+}  // namespace http
+}  // namespace fetch
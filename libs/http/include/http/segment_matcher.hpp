@@ -0,0 +1,77 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace fetch {
+namespace http {
+
+/**
+ * Matcher for the parameter patterns of a route which consist of a single (possibly repeated)
+ * character class, e.g. "[a-fA-F0-9]{64}", "\d+" or ".+", which covers the patterns used by the
+ * HTTP interfaces in practice.
+ *
+ * Matching such a pattern greedily from the current position gives the same result as an anchored
+ * std::regex_search of it, at a fraction of the cost and without copying the path. Patterns which
+ * are not of this form are rejected by Compile() and must be matched with std::regex instead.
+ */
+class SegmentMatcher
+{
+public:
+  static constexpr std::size_t NO_MATCH = std::numeric_limits<std::size_t>::max();
+
+  static bool Compile(std::string const &pattern, SegmentMatcher &matcher);
+
+  /// Returns the number of characters matched at the start of `data`, or NO_MATCH
+  std::size_t Match(uint8_t const *data, std::size_t size) const
+  {
+    std::size_t const limit = (size < max_) ? size : max_;
+
+    std::size_t length = 0;
+    while ((length < limit) && accepted_[data[length]])
+    {
+      ++length;
+    }
+
+    return (length < min_) ? NO_MATCH : length;
+  }
+
+private:
+  using CharacterSet = std::bitset<256>;
+
+  static constexpr std::size_t UNBOUNDED = std::numeric_limits<std::size_t>::max();
+
+  static bool ParseAtom(std::string const &pattern, std::size_t &pos, CharacterSet &accepted);
+  static bool ParseClass(std::string const &pattern, std::size_t &pos, CharacterSet &accepted);
+  static bool ParseEscape(std::string const &pattern, std::size_t &pos, CharacterSet &accepted,
+                          int &literal);
+  static bool ParseQuantifier(std::string const &pattern, std::size_t &pos, std::size_t &min,
+                              std::size_t &max);
+
+  CharacterSet accepted_{};
+  std::size_t  min_{1};
+  std::size_t  max_{1};
+};
+
+}  // namespace http
+}  // namespace fetch
@@ -28,6 +28,7 @@
 #include "http/request.hpp"
 #include "http/response.hpp"
 #include "http/route.hpp"
+#include "http/router.hpp"
 #include "http/status.hpp"
 #include "http/tagged_tree.hpp"
 #include "logging/logging.hpp"
@@ -182,16 +183,11 @@ public:
         m(req);
       }
 
-      // finding the view that matches the URL
+      // finding the view that matches the URL, out of the ones whose literal prefix it starts with
       ViewParameters params;
-      for (auto &v : views_)
+      for (auto const index : router_.Candidates(req.method(), req.uri()))
       {
-        // skip all views that don't match the required method
-        if (v.method != req.method())
-        {
-          continue;
-        }
-
+        auto &v = views_[index];
         if (v.route.Match(req.uri(), params))
         {
           // checking that the correct level of authentication is present
@@ -291,6 +287,7 @@ public:
       route.AddValidator(param.name, std::move(v));
     }
 
+    router_.Add(method, route.prefix(), views_.size());
     views_.push_back(
         {std::move(description), method, std::move(route), view, std::move(authenticator)});
   }
@@ -339,6 +336,7 @@ private:
 
   std::vector<RequestMiddleware>  pre_view_middleware_;
   MountedViews                    views_;
+  Router                          router_;
   std::vector<ResponseMiddleware> post_view_middleware_;
 
   NetworkManager                   networkManager_;
@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "http/router.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace fetch {
+namespace http {
+
+Router::Node *Router::Node::FindChild(char c) const
+{
+  for (auto const &child : children)
+  {
+    if (child->label[0] == c)
+    {
+      return child.get();
+    }
+  }
+
+  return nullptr;
+}
+
+void Router::Add(Method method, byte_array::ConstByteArray const &prefix, RouteIndex index)
+{
+  std::string key{static_cast<std::string>(prefix)};
+  Node *      node = &roots_[method];
+
+  std::size_t pos = 0;
+  while (pos < key.size())
+  {
+    Node *child = node->FindChild(key[pos]);
+    if (child == nullptr)
+    {
+      auto leaf   = std::make_unique<Node>();
+      leaf->label = key.substr(pos);
+      leaf->routes.push_back(index);
+      node->children.push_back(std::move(leaf));
+      return;
+    }
+
+    // length of the common prefix of the remaining key and the label of the child
+    std::size_t common = 0;
+    while ((common < child->label.size()) && ((pos + common) < key.size()) &&
+           (child->label[common] == key[pos + common]))
+    {
+      ++common;
+    }
+
+    if (common < child->label.size())
+    {
+      // split the child at the point where it diverges from the key
+      auto tail      = std::make_unique<Node>();
+      tail->label    = child->label.substr(common);
+      tail->children = std::move(child->children);
+      tail->routes   = std::move(child->routes);
+
+      child->label.resize(common);
+      child->children.clear();
+      child->routes.clear();
+      child->children.push_back(std::move(tail));
+    }
+
+    node = child;
+    pos += common;
+  }
+
+  node->routes.push_back(index);
+}
+
+Router::RouteIndices Router::Candidates(Method method, byte_array::ConstByteArray const &path) const
+{
+  RouteIndices candidates;
+
+  auto it = roots_.find(method);
+  if (it == roots_.end())
+  {
+    return candidates;
+  }
+
+  auto const *data = path.char_pointer();
+  std::size_t pos  = 0;
+
+  Node const *node = &it->second;
+  candidates.insert(candidates.end(), node->routes.begin(), node->routes.end());
+
+  while (pos < path.size())
+  {
+    node = node->FindChild(data[pos]);
+    if ((node == nullptr) || (node->label.size() > (path.size() - pos)) ||
+        (std::memcmp(node->label.data(), data + pos, node->label.size()) != 0))
+    {
+      break;
+    }
+
+    pos += node->label.size();
+    candidates.insert(candidates.end(), node->routes.begin(), node->routes.end());
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+  return candidates;
+}
+
+}  // namespace http
+}  // namespace fetch
@@ -0,0 +1,312 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "http/segment_matcher.hpp"
+
+#include <cctype>
+#include <cstddef>
+#include <string>
+
+namespace fetch {
+namespace http {
+namespace {
+
+constexpr int NO_LITERAL = -1;
+
+void AddRange(std::bitset<256> &set, int first, int last)
+{
+  for (int c = first; c <= last; ++c)
+  {
+    set.set(static_cast<std::size_t>(c));
+  }
+}
+
+bool ParseNumber(std::string const &pattern, std::size_t &pos, std::size_t &value)
+{
+  std::size_t const start = pos;
+
+  value = 0;
+  while ((pos < pattern.size()) && (std::isdigit(static_cast<unsigned char>(pattern[pos])) != 0))
+  {
+    // patterns with absurd repetition counts are left to std::regex
+    if (value > 100000u)
+    {
+      return false;
+    }
+    value = (value * 10u) + static_cast<std::size_t>(pattern[pos] - '0');
+    ++pos;
+  }
+
+  return pos != start;
+}
+
+}  // namespace
+
+constexpr std::size_t SegmentMatcher::NO_MATCH;
+constexpr std::size_t SegmentMatcher::UNBOUNDED;
+
+bool SegmentMatcher::Compile(std::string const &pattern, SegmentMatcher &matcher)
+{
+  SegmentMatcher compiled;
+  std::size_t    pos = 0;
+
+  if (!ParseAtom(pattern, pos, compiled.accepted_) ||
+      !ParseQuantifier(pattern, pos, compiled.min_, compiled.max_) || (pos != pattern.size()))
+  {
+    return false;
+  }
+
+  matcher = compiled;
+  return true;
+}
+
+bool SegmentMatcher::ParseAtom(std::string const &pattern, std::size_t &pos,
+                               CharacterSet &accepted)
+{
+  if (pos >= pattern.size())
+  {
+    return false;
+  }
+
+  char const c = pattern[pos++];
+  switch (c)
+  {
+  case '[':
+    return ParseClass(pattern, pos, accepted);
+
+  case '\\':
+  {
+    int literal = NO_LITERAL;
+    if (!ParseEscape(pattern, pos, accepted, literal))
+    {
+      return false;
+    }
+    if (literal != NO_LITERAL)
+    {
+      accepted.set(static_cast<std::size_t>(literal));
+    }
+    return true;
+  }
+
+  case '.':
+    accepted.set();
+    accepted.reset('\n');
+    accepted.reset('\r');
+    return true;
+
+  case '(':
+  case ')':
+  case '|':
+  case '*':
+  case '+':
+  case '?':
+  case '{':
+  case '}':
+  case '^':
+  case '$':
+  case ']':
+    return false;
+
+  default:
+    accepted.set(static_cast<unsigned char>(c));
+    return true;
+  }
+}
+
+bool SegmentMatcher::ParseClass(std::string const &pattern, std::size_t &pos,
+                                CharacterSet &accepted)
+{
+  CharacterSet set{};
+
+  bool const negated = (pos < pattern.size()) && (pattern[pos] == '^');
+  if (negated)
+  {
+    ++pos;
+  }
+
+  // an empty class never matches anything, which is not worth supporting
+  if ((pos < pattern.size()) && (pattern[pos] == ']'))
+  {
+    return false;
+  }
+
+  while (pos < pattern.size())
+  {
+    char const c = pattern[pos++];
+    if (c == ']')
+    {
+      accepted = negated ? ~set : set;
+      return true;
+    }
+
+    int first = static_cast<unsigned char>(c);
+    if (c == '\\')
+    {
+      int literal = NO_LITERAL;
+      if (!ParseEscape(pattern, pos, set, literal))
+      {
+        return false;
+      }
+      if (literal == NO_LITERAL)
+      {
+        continue;
+      }
+      first = literal;
+    }
+
+    // ranges, where a trailing '-' is taken literally
+    if (((pos + 1) < pattern.size()) && (pattern[pos] == '-') && (pattern[pos + 1] != ']'))
+    {
+      ++pos;
+      int last = static_cast<unsigned char>(pattern[pos++]);
+      if (last == '\\')
+      {
+        CharacterSet ignored{};
+        last = NO_LITERAL;
+        if (!ParseEscape(pattern, pos, ignored, last) || (last == NO_LITERAL))
+        {
+          return false;
+        }
+      }
+      if (last < first)
+      {
+        return false;
+      }
+      AddRange(set, first, last);
+    }
+    else
+    {
+      set.set(static_cast<std::size_t>(first));
+    }
+  }
+
+  // unterminated class
+  return false;
+}
+
+bool SegmentMatcher::ParseEscape(std::string const &pattern, std::size_t &pos,
+                                 CharacterSet &accepted, int &literal)
+{
+  if (pos >= pattern.size())
+  {
+    return false;
+  }
+
+  char const   c = pattern[pos++];
+  CharacterSet set{};
+  switch (c)
+  {
+  case 'd':
+  case 'D':
+    AddRange(set, '0', '9');
+    break;
+
+  case 'w':
+  case 'W':
+    AddRange(set, '0', '9');
+    AddRange(set, 'A', 'Z');
+    AddRange(set, 'a', 'z');
+    set.set('_');
+    break;
+
+  case 's':
+  case 'S':
+    for (char w : std::string{" \t\n\r\f\v"})
+    {
+      set.set(static_cast<unsigned char>(w));
+    }
+    break;
+
+  default:
+    // other letters and digits are either special (\b, \n, \1, ...) or invalid
+    if (std::isalnum(static_cast<unsigned char>(c)) != 0)
+    {
+      return false;
+    }
+    literal = static_cast<unsigned char>(c);
+    return true;
+  }
+
+  accepted |= (std::isupper(static_cast<unsigned char>(c)) != 0) ? ~set : set;
+  return true;
+}
+
+bool SegmentMatcher::ParseQuantifier(std::string const &pattern, std::size_t &pos,
+                                     std::size_t &min, std::size_t &max)
+{
+  min = 1;
+  max = 1;
+
+  if (pos >= pattern.size())
+  {
+    return true;
+  }
+
+  switch (pattern[pos])
+  {
+  case '+':
+    min = 1;
+    max = UNBOUNDED;
+    ++pos;
+    break;
+
+  case '*':
+    min = 0;
+    max = UNBOUNDED;
+    ++pos;
+    break;
+
+  case '?':
+    min = 0;
+    max = 1;
+    ++pos;
+    break;
+
+  case '{':
+    ++pos;
+    if (!ParseNumber(pattern, pos, min))
+    {
+      return false;
+    }
+    max = min;
+    if ((pos < pattern.size()) && (pattern[pos] == ','))
+    {
+      ++pos;
+      max = UNBOUNDED;
+      if ((pos < pattern.size()) && (pattern[pos] != '}') && !ParseNumber(pattern, pos, max))
+      {
+        return false;
+      }
+    }
+    if ((pos >= pattern.size()) || (pattern[pos] != '}') || (max < min))
+    {
+      return false;
+    }
+    ++pos;
+    break;
+
+  default:
+    return true;
+  }
+
+  // lazy quantifiers are left to std::regex
+  return (pos >= pattern.size()) || (pattern[pos] != '?');
+}
+
+}  // namespace http
+}  // namespace fetch
@@ -0,0 +1,157 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "http/method.hpp"
+#include "http/route.hpp"
+#include "http/router.hpp"
+#include "http/segment_matcher.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::http::Method;
+using fetch::http::Route;
+using fetch::http::Router;
+using fetch::http::SegmentMatcher;
+using fetch::http::ViewParameters;
+
+std::size_t RegexMatch(std::string const &pattern, std::string const &input)
+{
+  std::regex  rgx("^" + pattern);
+  std::smatch matches;
+  if (std::regex_search(input, matches, rgx))
+  {
+    return static_cast<std::size_t>(matches[0].length());
+  }
+  return SegmentMatcher::NO_MATCH;
+}
+
+std::size_t SegmentMatch(SegmentMatcher const &matcher, std::string const &input)
+{
+  return matcher.Match(reinterpret_cast<uint8_t const *>(input.data()), input.size());
+}
+
+TEST(SegmentMatcherTests, compiled_patterns_match_like_regex)
+{
+  std::vector<std::string> const patterns = {
+      "[a-fA-F0-9]{64}", "[1-9A-HJ-NP-Za-km-z]{48,50}", ".+", "\\d+", "\\w*", "[^/]+",
+      "[a-z]?",          "x{2,}",                       "[\\d_-]+", "\\.", "[.]{1,3}"};
+  std::vector<std::string> const inputs = {
+      "",
+      "/",
+      "a",
+      "abc/def",
+      "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef",
+      "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdefff/more",
+      "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcde",
+      "MnrRHdvCkdZodEwM855vemS5V3p2hiWmcSQ8JEzD4ZjPdsYtB/query",
+      "42_-x",
+      "xxxx",
+      "....",
+      "-",
+      "\nabc"};
+
+  for (auto const &pattern : patterns)
+  {
+    SegmentMatcher matcher;
+    ASSERT_TRUE(SegmentMatcher::Compile(pattern, matcher)) << pattern;
+
+    for (auto const &input : inputs)
+    {
+      EXPECT_EQ(SegmentMatch(matcher, input), RegexMatch(pattern, input))
+          << "pattern: " << pattern << " input: " << input;
+    }
+  }
+}
+
+TEST(SegmentMatcherTests, unsupported_patterns_are_rejected)
+{
+  SegmentMatcher matcher;
+  for (std::string const pattern :
+       {"", "abc", "(a)", "a|b", "[a-z]+?", "[]", "[z-a]", "[abc", "\\b", "a{2", "a{3,1}", "^a"})
+  {
+    EXPECT_FALSE(SegmentMatcher::Compile(pattern, matcher)) << pattern;
+  }
+}
+
+TEST(RouteTests, parameters_are_extracted)
+{
+  auto route = Route::FromString("/api/contract/(identifier=[1-9A-HJ-NP-Za-km-z]{48,50})/"
+                                 "(query=.+)");
+  EXPECT_EQ(route.prefix(), ConstByteArray{"/api/contract/"});
+
+  ViewParameters params;
+  ASSERT_TRUE(
+      route.Match("/api/contract/MnrRHdvCkdZodEwM855vemS5V3p2hiWmcSQ8JEzD4ZjPdsYtB/balance",
+                  params));
+  EXPECT_EQ(params["identifier"],
+            ConstByteArray{"MnrRHdvCkdZodEwM855vemS5V3p2hiWmcSQ8JEzD4ZjPdsYtB"});
+  EXPECT_EQ(params["query"], ConstByteArray{"balance"});
+
+  EXPECT_FALSE(route.Match("/api/contract/tooshort/balance", params));
+  EXPECT_FALSE(route.Match("/api/contract/MnrRHdvCkdZodEwM855vemS5V3p2hiWmcSQ8JEzD4ZjPdsYtB/",
+                           params));
+}
+
+TEST(RouteTests, regex_fallback_is_still_supported)
+{
+  auto route = Route::FromString("/items/(id=(ab|cd)+)");
+
+  ViewParameters params;
+  EXPECT_FALSE(route.Match("/items/abcd", params));  // ambiguous matches are rejected
+  EXPECT_FALSE(route.Match("/items/xy", params));
+
+  auto plain = Route::FromString("/pages/(name=[a-z]+?)");
+  ASSERT_TRUE(plain.Match("/pages/a", params));
+  EXPECT_EQ(params["name"], ConstByteArray{"a"});
+}
+
+TEST(RouterTests, candidates_are_the_routes_whose_prefix_starts_the_path)
+{
+  Router router;
+  router.Add(Method::GET, "/api/status", 0);
+  router.Add(Method::GET, "/api/status/tx/", 1);
+  router.Add(Method::GET, "/api/tx/", 2);
+  router.Add(Method::POST, "/api/contract/", 3);
+  router.Add(Method::GET, "/", 4);
+  router.Add(Method::GET, "/api/", 5);
+  router.Add(Method::GET, "/api/status", 6);
+
+  using Indices = Router::RouteIndices;
+  EXPECT_EQ(router.Candidates(Method::GET, "/api/status"), (Indices{0, 4, 5, 6}));
+  EXPECT_EQ(router.Candidates(Method::GET, "/api/status/tx/abcd"), (Indices{0, 1, 4, 5, 6}));
+  EXPECT_EQ(router.Candidates(Method::GET, "/api/tx/abcd"), (Indices{2, 4, 5}));
+  EXPECT_EQ(router.Candidates(Method::GET, "/api/contract/abc"), (Indices{4, 5}));
+  EXPECT_EQ(router.Candidates(Method::POST, "/api/contract/abc"), (Indices{3}));
+  EXPECT_EQ(router.Candidates(Method::POST, "/api/status"), (Indices{}));
+  EXPECT_EQ(router.Candidates(Method::DELETE, "/"), (Indices{}));
+  EXPECT_EQ(router.Candidates(Method::GET, "/ap"), (Indices{4}));
+}
+
+}  // namespace
@@ -0,0 +1,110 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/byte_array/encoders.hpp"
+#include "json/document.hpp"
+#include "json/reader.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::json::JSONDocument;
+using fetch::json::JSONHandler;
+using fetch::json::JSONReader;
+
+// roughly the size of a serialised transfer transaction
+constexpr std::size_t TX_SIZE = 300;
+
+// Builds a bulk JSON transaction submission, as sent to the contract HTTP interface
+ConstByteArray CreateBulkSubmission(std::size_t count)
+{
+  std::mt19937 rng{42};
+
+  ByteArray payload;
+  payload.Resize(TX_SIZE);
+
+  ByteArray document;
+  document.Append("[");
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    for (std::size_t j = 0; j < TX_SIZE; ++j)
+    {
+      payload[j] = static_cast<uint8_t>(rng());
+    }
+
+    document.Append((i == 0) ? "" : ",", R"({"ver": "1.2", "data": ")", payload.ToBase64(),
+                    R"(", "metadata": {"digest": "0x", "nonce": )", std::to_string(i), "}}");
+  }
+  document.Append("]");
+
+  return document;
+}
+
+class CountingHandler : public JSONHandler
+{
+public:
+  bool OnString(ConstByteArray const &value) override
+  {
+    bytes += value.size();
+    return true;
+  }
+
+  std::size_t bytes{0};
+};
+
+void JsonParse_Document(benchmark::State &state)
+{
+  auto const document = CreateBulkSubmission(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    JSONDocument doc{document};
+    benchmark::DoNotOptimize(doc.root().size());
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(document.size()));
+}
+
+void JsonParse_Reader(benchmark::State &state)
+{
+  auto const document = CreateBulkSubmission(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    CountingHandler handler;
+    JSONReader{document}.Parse(handler);
+    benchmark::DoNotOptimize(handler.bytes);
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(document.size()));
+}
+
+}  // namespace
+
+BENCHMARK(JsonParse_Document)->Arg(1)->Arg(100)->Arg(10000);
+BENCHMARK(JsonParse_Reader)->Arg(1)->Arg(100)->Arg(10000);
@@ -0,0 +1,114 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "json/exceptions.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fetch {
+namespace json {
+
+/**
+ * Receives the events produced by a JSONReader.
+ *
+ * Each callback returns whether parsing should continue. The default implementations ignore the
+ * event, so handlers only need to override the events which they are interested in.
+ */
+class JSONHandler
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+
+  JSONHandler()          = default;
+  virtual ~JSONHandler() = default;
+
+  virtual bool OnNull();
+  virtual bool OnBool(bool value);
+  virtual bool OnInteger(int64_t value);
+  virtual bool OnFloat(double value);
+  virtual bool OnString(ConstByteArray const &value);
+  virtual bool OnKey(ConstByteArray const &key);
+  virtual bool OnStartObject();
+  virtual bool OnEndObject();
+  virtual bool OnStartArray();
+  virtual bool OnEndArray();
+};
+
+/**
+ * Event driven JSON parser.
+ *
+ * Unlike the JSONDocument, the reader does not build a tree of the document. It checks the
+ * document in a single pass and reports each value to a JSONHandler as it is encountered. Strings
+ * and keys are reported as slices of the original document, with escape sequences left as they
+ * are (as in the JSONDocument), so no string data is copied. The contents of strings, which make
+ * up the bulk of most documents, are scanned 16 bytes at a time.
+ *
+ * As with the JSONDocument, the top level value must be an object or an array. Malformed documents
+ * raise a JSONParseException.
+ */
+class JSONReader
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+
+  explicit JSONReader(ConstByteArray document);
+  JSONReader(JSONReader const &) = delete;
+  JSONReader(JSONReader &&)      = delete;
+  ~JSONReader()                  = default;
+
+  JSONReader &operator=(JSONReader const &) = delete;
+  JSONReader &operator=(JSONReader &&) = delete;
+
+  bool Parse(JSONHandler &handler);
+
+private:
+  enum class State
+  {
+    VALUE,
+    VALUE_OR_END,
+    KEY,
+    KEY_OR_END,
+    COLON,
+    COMMA_OR_END,
+    DONE
+  };
+
+  void           SkipWhitespace();
+  ConstByteArray ConsumeString();
+  bool           ConsumeValue(JSONHandler &handler);
+  bool           ConsumeKeyword(JSONHandler &handler);
+  bool           ConsumeNumber(JSONHandler &handler);
+  bool           CloseContainer(JSONHandler &handler);
+  void           CompleteValue();
+
+  JSONParseException Error(char const *reason) const;
+
+  ConstByteArray const document_;
+  uint8_t const *      data_{nullptr};
+  std::size_t          size_{0};
+  std::size_t          pos_{0};
+  State                state_{State::VALUE};
+  std::vector<char>    containers_{};
+};
+
+}  // namespace json
+}  // namespace fetch
@@ -0,0 +1,443 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/consumers.hpp"
+#include "json/exceptions.hpp"
+#include "json/reader.hpp"
+
+#include <emmintrin.h>
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <utility>
+
+namespace fetch {
+namespace json {
+namespace {
+
+constexpr int         NUMBER_INT   = 0;
+constexpr int         NUMBER_FLOAT = 1;
+constexpr std::size_t BLOCK_SIZE   = 16;
+
+bool IsWhitespace(uint8_t c)
+{
+  return (c == ' ') || (c == '\n') || (c == '\r') || (c == '\t');
+}
+
+/**
+ * Find the first quote or backslash in the document at or after a given position
+ *
+ * @param data The document
+ * @param size The size of the document
+ * @param pos The position to start searching from
+ * @return The position of the character found, or at least size if there is none
+ */
+std::size_t FindStringDelimiter(uint8_t const *data, std::size_t size, std::size_t pos)
+{
+  __m128i const quotes      = _mm_set1_epi8('"');
+  __m128i const backslashes = _mm_set1_epi8('\\');
+
+  while ((pos + BLOCK_SIZE) <= size)
+  {
+    __m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(data + pos));
+    __m128i const found =
+        _mm_or_si128(_mm_cmpeq_epi8(block, quotes), _mm_cmpeq_epi8(block, backslashes));
+
+    auto const mask = static_cast<uint32_t>(_mm_movemask_epi8(found));
+    if (mask != 0)
+    {
+      return pos + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+
+    pos += BLOCK_SIZE;
+  }
+
+  while ((pos < size) && (data[pos] != '"') && (data[pos] != '\\'))
+  {
+    ++pos;
+  }
+
+  return pos;
+}
+
+/**
+ * Convert the text of an integer (as accepted by the NumberConsumer) to its value
+ *
+ * @param first The start of the text
+ * @param last The end of the text
+ * @param value The output value
+ * @return true if successful, false if the value does not fit in 64 bits
+ */
+bool ParseInteger(uint8_t const *first, uint8_t const *last, int64_t &value)
+{
+  bool const negative = (*first == '-');
+  if (negative)
+  {
+    ++first;
+  }
+
+  auto const max   = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+  auto const limit = negative ? (max + 1u) : max;
+
+  uint64_t magnitude = 0;
+  for (; first != last; ++first)
+  {
+    auto const digit = static_cast<uint64_t>(*first - '0');
+    if (magnitude > ((limit - digit) / 10u))
+    {
+      return false;
+    }
+    magnitude = (magnitude * 10u) + digit;
+  }
+
+  if (negative && (magnitude != 0))
+  {
+    value = -static_cast<int64_t>(magnitude - 1u) - 1;
+  }
+  else
+  {
+    value = static_cast<int64_t>(magnitude);
+  }
+
+  return true;
+}
+
+}  // namespace
+
+bool JSONHandler::OnNull()
+{
+  return true;
+}
+
+bool JSONHandler::OnBool(bool /*value*/)
+{
+  return true;
+}
+
+bool JSONHandler::OnInteger(int64_t /*value*/)
+{
+  return true;
+}
+
+bool JSONHandler::OnFloat(double /*value*/)
+{
+  return true;
+}
+
+bool JSONHandler::OnString(ConstByteArray const & /*value*/)
+{
+  return true;
+}
+
+bool JSONHandler::OnKey(ConstByteArray const & /*key*/)
+{
+  return true;
+}
+
+bool JSONHandler::OnStartObject()
+{
+  return true;
+}
+
+bool JSONHandler::OnEndObject()
+{
+  return true;
+}
+
+bool JSONHandler::OnStartArray()
+{
+  return true;
+}
+
+bool JSONHandler::OnEndArray()
+{
+  return true;
+}
+
+JSONReader::JSONReader(ConstByteArray document)
+  : document_{std::move(document)}
+  , data_{document_.pointer()}
+  , size_{document_.size()}
+{}
+
+/**
+ * Parse the document, reporting its contents to the handler
+ *
+ * @param handler The handler to receive the events
+ * @return true if the whole document was parsed, false if the handler stopped parsing early
+ */
+bool JSONReader::Parse(JSONHandler &handler)
+{
+  pos_   = 0;
+  state_ = State::VALUE;
+  containers_.clear();
+
+  SkipWhitespace();
+  if ((pos_ >= size_) || ((data_[pos_] != '{') && (data_[pos_] != '[')))
+  {
+    throw Error("Expecting a list or object as initial element");
+  }
+
+  for (;;)
+  {
+    SkipWhitespace();
+    if (pos_ >= size_)
+    {
+      break;
+    }
+
+    uint8_t const c       = data_[pos_];
+    bool          proceed = true;
+
+    switch (state_)
+    {
+    case State::VALUE_OR_END:
+      proceed = (c == ']') ? CloseContainer(handler) : ConsumeValue(handler);
+      break;
+
+    case State::VALUE:
+      proceed = ConsumeValue(handler);
+      break;
+
+    case State::KEY_OR_END:
+      if (c == '}')
+      {
+        proceed = CloseContainer(handler);
+        break;
+      }
+      // Falls through.
+    case State::KEY:
+      if (c != '"')
+      {
+        throw Error("Expected object key");
+      }
+      state_  = State::COLON;
+      proceed = handler.OnKey(ConsumeString());
+      break;
+
+    case State::COLON:
+      if (c != ':')
+      {
+        throw Error("Expected ':' after object key");
+      }
+      ++pos_;
+      state_ = State::VALUE;
+      break;
+
+    case State::COMMA_OR_END:
+      if (c == ',')
+      {
+        ++pos_;
+        state_ = (containers_.back() == '}') ? State::KEY : State::VALUE;
+      }
+      else if (c == containers_.back())
+      {
+        proceed = CloseContainer(handler);
+      }
+      else
+      {
+        throw Error("Expected ',' or end of object or array");
+      }
+      break;
+
+    case State::DONE:
+      throw Error("Unexpected data after the end of the document");
+    }
+
+    if (!proceed)
+    {
+      return false;
+    }
+  }
+
+  if (state_ != State::DONE)
+  {
+    throw Error("Object or array indicators are unbalanced.");
+  }
+
+  return true;
+}
+
+void JSONReader::SkipWhitespace()
+{
+  while ((pos_ < size_) && IsWhitespace(data_[pos_]))
+  {
+    ++pos_;
+  }
+}
+
+/**
+ * Consume the string starting at the current position
+ *
+ * @return The contents of the string, excluding the quotes
+ */
+JSONReader::ConstByteArray JSONReader::ConsumeString()
+{
+  std::size_t const start = pos_ + 1;
+
+  std::size_t pos = start;
+  for (;;)
+  {
+    pos = FindStringDelimiter(data_, size_, pos);
+    if (pos >= size_)
+    {
+      throw Error("Unterminated string");
+    }
+
+    if (data_[pos] == '"')
+    {
+      break;
+    }
+
+    // skip over the escaped character
+    pos += 2;
+  }
+
+  pos_ = pos + 1;
+  return document_.SubArray(start, pos - start);
+}
+
+bool JSONReader::ConsumeValue(JSONHandler &handler)
+{
+  switch (data_[pos_])
+  {
+  case '{':
+    containers_.push_back('}');
+    ++pos_;
+    state_ = State::KEY_OR_END;
+    return handler.OnStartObject();
+
+  case '[':
+    containers_.push_back(']');
+    ++pos_;
+    state_ = State::VALUE_OR_END;
+    return handler.OnStartArray();
+
+  case '"':
+  {
+    auto const value = ConsumeString();
+    CompleteValue();
+    return handler.OnString(value);
+  }
+
+  case 't':
+  case 'f':
+  case 'n':
+    return ConsumeKeyword(handler);
+
+  default:
+    return ConsumeNumber(handler);
+  }
+}
+
+bool JSONReader::ConsumeKeyword(JSONHandler &handler)
+{
+  auto const consume = [this](char const *keyword) {
+    std::size_t const length = std::strlen(keyword);
+    if (((size_ - pos_) < length) || (std::memcmp(data_ + pos_, keyword, length) != 0))
+    {
+      return false;
+    }
+
+    pos_ += length;
+    CompleteValue();
+    return true;
+  };
+
+  if (consume("true"))
+  {
+    return handler.OnBool(true);
+  }
+
+  if (consume("false"))
+  {
+    return handler.OnBool(false);
+  }
+
+  if (consume("null"))
+  {
+    return handler.OnNull();
+  }
+
+  throw Error("Unrecognised token");
+}
+
+bool JSONReader::ConsumeNumber(JSONHandler &handler)
+{
+  uint64_t  end  = pos_;
+  int const type = byte_array::consumers::NumberConsumer<NUMBER_INT, NUMBER_FLOAT>(document_, end);
+
+  if (type == NUMBER_INT)
+  {
+    int64_t value{0};
+    if (!ParseInteger(data_ + pos_, data_ + end, value))
+    {
+      throw Error("Failed to convert integer");
+    }
+
+    pos_ = end;
+    CompleteValue();
+    return handler.OnInteger(value);
+  }
+
+  if (type == NUMBER_FLOAT)
+  {
+    std::string const str(data_ + pos_, data_ + end);
+
+    errno = 0;
+    auto const value = static_cast<double>(std::strtold(str.c_str(), nullptr));
+    if ((errno == ERANGE) || !std::isfinite(value))
+    {
+      errno = 0;
+      throw Error("Failed to convert floating point number");
+    }
+
+    pos_ = end;
+    CompleteValue();
+    return handler.OnFloat(value);
+  }
+
+  throw Error("Unable to parse number");
+}
+
+bool JSONReader::CloseContainer(JSONHandler &handler)
+{
+  char const closing = containers_.back();
+  containers_.pop_back();
+  ++pos_;
+  CompleteValue();
+
+  return (closing == '}') ? handler.OnEndObject() : handler.OnEndArray();
+}
+
+void JSONReader::CompleteValue()
+{
+  state_ = containers_.empty() ? State::DONE : State::COMMA_OR_END;
+}
+
+JSONParseException JSONReader::Error(char const *reason) const
+{
+  return JSONParseException(std::string{reason} + " at offset " + std::to_string(pos_));
+}
+
+}  // namespace json
+}  // namespace fetch
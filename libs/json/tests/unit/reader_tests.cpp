@@ -0,0 +1,180 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "json/document.hpp"
+#include "json/exceptions.hpp"
+#include "json/reader.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::json::JSONDocument;
+using fetch::json::JSONHandler;
+using fetch::json::JSONParseException;
+using fetch::json::JSONReader;
+
+// Records the events of the reader in a compact textual form
+class RecordingHandler : public JSONHandler
+{
+public:
+  bool OnNull() override
+  {
+    events << "null ";
+    return true;
+  }
+
+  bool OnBool(bool value) override
+  {
+    events << (value ? "true " : "false ");
+    return true;
+  }
+
+  bool OnInteger(int64_t value) override
+  {
+    events << value << ' ';
+    return true;
+  }
+
+  bool OnFloat(double value) override
+  {
+    events << value << "f ";
+    return true;
+  }
+
+  bool OnString(ConstByteArray const &value) override
+  {
+    events << '"' << value << "\" ";
+    return true;
+  }
+
+  bool OnKey(ConstByteArray const &key) override
+  {
+    events << key << ": ";
+    return true;
+  }
+
+  bool OnStartObject() override
+  {
+    events << "{ ";
+    return true;
+  }
+
+  bool OnEndObject() override
+  {
+    events << "} ";
+    return true;
+  }
+
+  bool OnStartArray() override
+  {
+    events << "[ ";
+    return --remaining_arrays_ >= 0;
+  }
+
+  bool OnEndArray() override
+  {
+    events << "] ";
+    return true;
+  }
+
+  void StopAfterArrays(int count)
+  {
+    remaining_arrays_ = count;
+  }
+
+  std::ostringstream events;
+
+private:
+  int remaining_arrays_{1000};
+};
+
+std::string Events(ConstByteArray const &document)
+{
+  RecordingHandler handler;
+  JSONReader       reader{document};
+  EXPECT_TRUE(reader.Parse(handler));
+  return handler.events.str();
+}
+
+TEST(JsonReaderTests, events_are_reported_in_document_order)
+{
+  EXPECT_EQ(Events(R"({
+    "empty": {},
+    "array": [1, -2, 2.5e1, true, false, null],
+    "nested": [{"value": "text"}, []]
+  })"),
+            "{ empty: { } array: [ 1 -2 25f true false null ] nested: [ { value: \"text\" } [ "
+            "] ] } ");
+}
+
+TEST(JsonReaderTests, strings_are_slices_of_the_document_with_escapes_left_as_is)
+{
+  // long enough to be scanned in several blocks, with escapes on and across block boundaries
+  EXPECT_EQ(Events(R"(["0123456789abcd\"0123456789abcde\\", "\\\"", ""])"),
+            R"([ "0123456789abcd\"0123456789abcde\\" "\\\"" "" ] )");
+}
+
+TEST(JsonReaderTests, integers_cover_the_full_range)
+{
+  EXPECT_EQ(Events("[9223372036854775807, -9223372036854775808, 0, -0]"),
+            "[ 9223372036854775807 -9223372036854775808 0 0 ] ");
+
+  RecordingHandler handler;
+  JSONReader       reader{"[9223372036854775808]"};
+  EXPECT_THROW(reader.Parse(handler), JSONParseException);
+}
+
+TEST(JsonReaderTests, handler_can_stop_parsing)
+{
+  RecordingHandler handler;
+  handler.StopAfterArrays(1);
+
+  JSONReader reader{R"([1, [2, 3], 4])"};
+  EXPECT_FALSE(reader.Parse(handler));
+  EXPECT_EQ(handler.events.str(), "[ 1 [ ");
+}
+
+TEST(JsonReaderTests, malformed_documents_are_rejected)
+{
+  for (char const *document :
+       {"", "  ", "5", "\"text\"", "{", "[", "[1,]", "[1 2]", "{\"a\" 1}", "{\"a\":1,}", "{1: 2}",
+        "[}", "{]", "[] []", "[tru]", "[\"abc", "[1e999]", "[-]"})
+  {
+    RecordingHandler handler;
+    JSONReader       reader{document};
+    EXPECT_THROW(reader.Parse(handler), JSONParseException) << document;
+  }
+}
+
+TEST(JsonReaderTests, agrees_with_document_on_strings_and_numbers)
+{
+  char const *text = R"({"a": 3, "b": 2.3e-2, "c": 2e+9, "d": "hel\"lo"})";
+
+  JSONDocument doc{text};
+  EXPECT_EQ(Events(text), "{ a: " + std::to_string(doc["a"].As<int64_t>()) +
+                              " b: 0.023f c: 2e+09f d: \"" + doc["d"].As<std::string>() + "\" } ");
+}
+
+}  // namespace
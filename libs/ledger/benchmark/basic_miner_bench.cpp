@@ -0,0 +1,143 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_layout.hpp"
+#include "core/bitvector.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/main_chain.hpp"
+#include "ledger/miner/basic_miner.hpp"
+#include "ledger/miner/mining_pool.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::chain::TransactionLayout;
+using fetch::ledger::BasicMiner;
+using fetch::ledger::Block;
+using fetch::ledger::MainChain;
+using fetch::ledger::MiningPool;
+
+using Layouts = std::vector<TransactionLayout>;
+
+constexpr uint32_t    LOG2_NUM_LANES = 4;
+constexpr uint32_t    NUM_LANES      = 1u << LOG2_NUM_LANES;
+constexpr std::size_t NUM_SLICES     = 128;
+
+// Transactions using a couple of lanes each (the lane of the sender and of any recipient or
+// contract), with a spread of charge rates
+Layouts GenerateLayouts(std::size_t count)
+{
+  std::mt19937_64                         rng{42};
+  std::poisson_distribution<uint32_t>     num_lanes(1.0);
+  std::uniform_int_distribution<uint32_t> lane(0, NUM_LANES - 1);
+  std::uniform_int_distribution<uint64_t> charge_rate(1, 1000);
+
+  Layouts layouts;
+  layouts.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ByteArray digest;
+    digest.Resize(32);
+    for (std::size_t j = 0; j < digest.size(); ++j)
+    {
+      digest[j] = static_cast<uint8_t>(rng());
+    }
+
+    BitVector mask{NUM_LANES};
+    for (uint32_t j = 0, lanes = 1 + num_lanes(rng); j < lanes; ++j)
+    {
+      mask.set(lane(rng), 1);
+    }
+
+    layouts.emplace_back(digest, mask, charge_rate(rng), 0, 1000);
+  }
+
+  return layouts;
+}
+
+void MiningPool_PackBlock(benchmark::State &state)
+{
+  auto const layouts = GenerateLayouts(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto pool = std::make_unique<MiningPool>(LOG2_NUM_LANES);
+    for (auto const &layout : layouts)
+    {
+      pool->Add(layout);
+    }
+    Block block;
+    block.slices.resize(NUM_SLICES);
+    state.ResumeTiming();
+
+    for (auto &slice : block.slices)
+    {
+      pool->PackSlice(slice);
+    }
+
+    state.PauseTiming();
+    pool.reset();
+    state.ResumeTiming();
+  }
+}
+
+void BasicMiner_GenerateBlock(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+
+  auto const layouts = GenerateLayouts(static_cast<std::size_t>(state.range(0)));
+
+  MainChain chain{MainChain::Mode::IN_MEMORY_DB};
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto miner = std::make_unique<BasicMiner>(LOG2_NUM_LANES);
+    for (auto const &layout : layouts)
+    {
+      miner->EnqueueTransaction(layout);
+    }
+    Block block;
+    block.previous_hash = chain.GetHeaviestBlockHash();
+    block.block_number  = 1;
+    state.ResumeTiming();
+
+    miner->GenerateBlock(block, NUM_LANES, NUM_SLICES, chain);
+
+    state.PauseTiming();
+    miner.reset();
+    state.ResumeTiming();
+  }
+}
+
+}  // namespace
+
+BENCHMARK(MiningPool_PackBlock)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BasicMiner_GenerateBlock)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
@@ -18,6 +18,7 @@
 
 #include "bloom_filter/bloom_filter.hpp"
 #include "ledger/chain/main_chain.hpp"
+#include "ledger/chain/time_travelogue.hpp"
 #include "ledger/testing/block_generator.hpp"
 
 #include "benchmark/benchmark.h"
@@ -135,9 +136,73 @@ void MainChain_Persistent_AddBlocksOutOfOrder(benchmark::State &state)
   }
 }
 
+// A main chain of the requested length with a side branch forking off right after genesis
+struct ForkedChain
+{
+  explicit ForkedChain(std::size_t length)
+  {
+    static constexpr std::size_t NUM_LANES  = 1;
+    static constexpr std::size_t NUM_SLICES = 2;
+
+    BlockGenerator gen{NUM_LANES, NUM_SLICES};
+
+    auto const genesis = gen.Generate();
+
+    main_tip = genesis;
+    for (std::size_t i = 0; i < length; ++i)
+    {
+      main_tip = gen.Generate(main_tip);
+      chain.AddBlock(*main_tip);
+      main_blocks.push_back(main_tip);
+    }
+
+    fork_tip = genesis;
+    for (std::size_t i = 0; i < length / 2; ++i)
+    {
+      fork_tip = gen.Generate(fork_tip);
+      chain.AddBlock(*fork_tip);
+    }
+  }
+
+  MainChain                chain{MainChain::Mode::IN_MEMORY_DB};
+  BlockArray               main_blocks;
+  BlockGenerator::BlockPtr main_tip;
+  BlockGenerator::BlockPtr fork_tip;
+};
+
+void MainChain_InMemory_PathToCommonAncestor(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+
+  ForkedChain forked{static_cast<std::size_t>(state.range(0))};
+
+  for (auto _ : state)
+  {
+    fetch::ledger::Blocks blocks;
+    forked.chain.GetPathToCommonAncestor(blocks, forked.fork_tip->hash, forked.main_tip->hash, 10);
+    benchmark::DoNotOptimize(blocks);
+  }
+}
+
+void MainChain_InMemory_TimeTravel(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+
+  ForkedChain forked{static_cast<std::size_t>(state.range(0))};
+
+  auto const &start = forked.main_blocks[forked.main_blocks.size() / 2];
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(forked.chain.TimeTravel(start->hash, 100));
+  }
+}
+
 }  // namespace
 
 BENCHMARK(MainChain_InMemory_AddBlocksSequentially);
 BENCHMARK(MainChain_Persistent_AddBlocksSequentially);
 BENCHMARK(MainChain_InMemory_AddBlocksOutOfOrder);
 BENCHMARK(MainChain_Persistent_AddBlocksOutOfOrder);
+BENCHMARK(MainChain_InMemory_PathToCommonAncestor)->Range(1 << 8, 1 << 14);
+BENCHMARK(MainChain_InMemory_TimeTravel)->Range(1 << 8, 1 << 14);
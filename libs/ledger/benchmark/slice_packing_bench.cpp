@@ -0,0 +1,231 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_layout.hpp"
+#include "core/bitvector.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/miner/mining_pool.hpp"
+#include "ledger/miner/optimisation/binary_annealer.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::chain::TransactionLayout;
+using fetch::ledger::Block;
+using fetch::ledger::MiningPool;
+using fetch::optimisers::BinaryAnnealer;
+
+using Layouts = std::vector<TransactionLayout>;
+
+constexpr uint32_t    LOG2_NUM_LANES   = 4;
+constexpr uint32_t    NUM_LANES        = 1u << LOG2_NUM_LANES;
+constexpr std::size_t NUM_SLICES       = 32;
+constexpr std::size_t NUM_TRANSACTIONS = 20000;
+constexpr std::size_t BATCH_SIZE       = 256;
+
+// Transactions using one to four lanes, with a spread of charge rates
+Layouts GenerateLayouts(std::size_t count)
+{
+  std::mt19937_64                         rng{7};
+  std::uniform_int_distribution<uint32_t> num_lanes(1, 4);
+  std::uniform_int_distribution<uint32_t> lane(0, NUM_LANES - 1);
+  std::uniform_int_distribution<uint64_t> charge_rate(1, 1000);
+
+  Layouts layouts;
+  layouts.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ByteArray digest;
+    digest.Resize(32);
+    for (std::size_t j = 0; j < digest.size(); ++j)
+    {
+      digest[j] = static_cast<uint8_t>(rng());
+    }
+
+    BitVector mask{NUM_LANES};
+    for (uint32_t j = 0, lanes = num_lanes(rng); j < lanes; ++j)
+    {
+      mask.set(lane(rng), 1);
+    }
+
+    layouts.emplace_back(digest, mask, charge_rate(rng), 0, 1000);
+  }
+
+  return layouts;
+}
+
+// Pack a slice from the best paying candidates, formulated as the selection of transactions which
+// maximises the fee while penalising every pair of transactions which share a lane
+uint64_t PackSliceAnnealed(BinaryAnnealer &annealer, Layouts &remaining)
+{
+  std::size_t const batch_size = std::min(BATCH_SIZE, remaining.size());
+
+  uint64_t max_fee{0};
+  for (std::size_t i = 0; i < batch_size; ++i)
+  {
+    max_fee = std::max(max_fee, remaining[i].charge_rate());
+  }
+
+  annealer.Resize(batch_size);
+  for (std::size_t i = 0; i < batch_size; ++i)
+  {
+    annealer.Insert(i, i, -static_cast<double>(remaining[i].charge_rate()));
+
+    for (std::size_t j = i + 1; j < batch_size; ++j)
+    {
+      if (remaining[i].mask().Intersects(remaining[j].mask()))
+      {
+        annealer.Insert(i, j, 2.0 * static_cast<double>(max_fee));
+      }
+    }
+  }
+  annealer.Normalise();
+
+  BinaryAnnealer::StateType solution;
+  annealer.FindMinimum(solution);
+
+  // drop any transaction which still collides with the slice
+  BitVector         used{NUM_LANES};
+  uint64_t          fee{0};
+  std::vector<bool> taken(remaining.size(), false);
+  for (std::size_t i = 0; i < batch_size; ++i)
+  {
+    if ((solution[i] != 0) && !remaining[i].mask().Intersects(used))
+    {
+      remaining[i].mask().OrInto(used);
+      fee += remaining[i].charge_rate();
+      taken[i] = true;
+    }
+  }
+
+  std::size_t index{0};
+  remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                 [&taken, &index](TransactionLayout const &) {
+                                   return taken[index++];
+                                 }),
+                  remaining.end());
+
+  return fee;
+}
+
+void Greedy_PackBlock(benchmark::State &state)
+{
+  auto const layouts = GenerateLayouts(NUM_TRANSACTIONS);
+
+  uint64_t fee{0};
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto pool = std::make_unique<MiningPool>(LOG2_NUM_LANES);
+    for (auto const &layout : layouts)
+    {
+      pool->Add(layout);
+    }
+    Block block;
+    block.slices.resize(NUM_SLICES);
+    state.ResumeTiming();
+
+    for (auto &slice : block.slices)
+    {
+      pool->PackSlice(slice);
+    }
+
+    state.PauseTiming();
+    fee = 0;
+    for (auto const &slice : block.slices)
+    {
+      for (auto const &layout : slice)
+      {
+        fee += layout.charge_rate();
+      }
+    }
+    pool.reset();
+    state.ResumeTiming();
+  }
+
+  state.counters["fee"] = static_cast<double>(fee);
+}
+
+// The first argument is the time budget for each slice in microseconds (zero to run the schedule
+// once) and the second is the number of replicas
+void Annealer_PackBlock(benchmark::State &state)
+{
+  auto layouts = GenerateLayouts(NUM_TRANSACTIONS);
+  std::sort(layouts.begin(), layouts.end(),
+            [](TransactionLayout const &a, TransactionLayout const &b) {
+              return a.charge_rate() > b.charge_rate();
+            });
+
+  BinaryAnnealer annealer;
+  annealer.SetSweeps(100);
+  annealer.SetBetaStart(0.1);
+  annealer.SetBetaEnd(20.0);
+  annealer.SetTimeBudget(std::chrono::microseconds{state.range(0)});
+  annealer.SetReplicas(static_cast<std::size_t>(state.range(1)));
+
+  uint64_t fee{0};
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    Layouts remaining = layouts;
+    fee               = 0;
+    state.ResumeTiming();
+
+    for (std::size_t slice = 0; slice < NUM_SLICES; ++slice)
+    {
+      fee += PackSliceAnnealed(annealer, remaining);
+    }
+  }
+
+  state.counters["fee"] = static_cast<double>(fee);
+}
+
+void AnnealerArguments(benchmark::internal::Benchmark *b)
+{
+  auto const threads = static_cast<int64_t>(std::max(1u, std::thread::hardware_concurrency()));
+
+  for (int64_t budget_us : {0, 200, 1000, 5000})
+  {
+    b->Args({budget_us, 1});
+    if (threads > 1)
+    {
+      b->Args({budget_us, threads});
+    }
+  }
+
+  b->ArgNames({"budget_us", "replicas"})->Unit(benchmark::kMillisecond);
+}
+
+}  // namespace
+
+BENCHMARK(Greedy_PackBlock)->Unit(benchmark::kMillisecond);
+BENCHMARK(Annealer_PackBlock)->Apply(AnnealerArguments);
@@ -0,0 +1,177 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_serializer.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/storage_unit/transaction_log_store.hpp"
+#include "ledger/storage_unit/transaction_store.hpp"
+#include "tx_generation.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using fetch::chain::TransactionSerializer;
+using fetch::ledger::TransactionLogStore;
+using fetch::ledger::TransactionStore;
+
+namespace {
+
+using TxArray = std::vector<Transaction>;
+
+constexpr std::size_t NUM_TXS = 4000;
+
+// transactions as they are received from the network, carrying their wire bytes
+TxArray const &ReceivedTransactions()
+{
+  static TxArray const txs = [] {
+    ECDSASigner signer;
+
+    TxArray received{};
+    for (std::size_t i = 0; i < NUM_TXS; ++i)
+    {
+      fetch::random::LinearCongruentialGenerator rng{i};
+
+      auto const tx = TransactionBuilder()
+                          .From(fetch::chain::Address{signer.identity()})
+                          .ValidUntil(1000)
+                          .TargetChainCode("fetch.token", fetch::BitVector{})
+                          .Action("transfer")
+                          .Data(GenerateRandomArray(16, rng))
+                          .Signer(signer.identity())
+                          .Seal()
+                          .Sign(signer)
+                          .Build();
+
+      TransactionSerializer serializer{};
+      serializer << *tx;
+
+      TransactionSerializer deserializer{serializer.data()};
+      received.emplace_back();
+      deserializer >> received.back();
+    }
+
+    return received;
+  }();
+
+  return txs;
+}
+
+uint64_t FileSize(std::string const &filename)
+{
+  std::ifstream file{filename, std::ios::binary | std::ios::ate};
+  return file ? static_cast<uint64_t>(file.tellg()) : 0;
+}
+
+template <typename Store>
+void Ingest(Store &store, TxArray const &txs, std::size_t batch_size)
+{
+  for (std::size_t i = 0; i < txs.size(); i += batch_size)
+  {
+    auto const end = std::min(i + batch_size, txs.size());
+    store.AddBatch(TxArray{txs.begin() + static_cast<std::ptrdiff_t>(i),
+                           txs.begin() + static_cast<std::ptrdiff_t>(end)});
+  }
+}
+
+void TransactionStore_Ingest(benchmark::State &state)
+{
+  auto const &txs        = ReceivedTransactions();
+  auto const  batch_size = static_cast<std::size_t>(state.range(0));
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto store = std::make_unique<TransactionStore>();
+    store->New("transaction_store_bench.db", "transaction_store_bench.index.db");
+    state.ResumeTiming();
+
+    Ingest(*store, txs, batch_size);
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(txs.size()));
+  state.counters["bytes_on_disk"] = static_cast<double>(
+      FileSize("transaction_store_bench.db") + FileSize("transaction_store_bench.index.db"));
+}
+
+void TransactionLogStore_Ingest(benchmark::State &state)
+{
+  auto const &txs        = ReceivedTransactions();
+  auto const  batch_size = static_cast<std::size_t>(state.range(0));
+
+  uint64_t size_on_disk{0};
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto store = std::make_unique<TransactionLogStore>();
+    store->New("transaction_log_store_bench");
+    state.ResumeTiming();
+
+    Ingest(*store, txs, batch_size);
+
+    size_on_disk = store->GetSizeOnDisk();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(txs.size()));
+  state.counters["bytes_on_disk"] = static_cast<double>(size_on_disk);
+}
+
+template <typename Store>
+void Lookup(benchmark::State &state, Store &store)
+{
+  auto const &txs = ReceivedTransactions();
+  Ingest(store, txs, 1000);
+
+  std::size_t index{0};
+  for (auto _ : state)
+  {
+    Transaction tx{};
+    benchmark::DoNotOptimize(store.Get(txs[index].digest(), tx));
+
+    index = (index + 1) % txs.size();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+void TransactionStore_Get(benchmark::State &state)
+{
+  TransactionStore store{};
+  store.New("transaction_store_bench.db", "transaction_store_bench.index.db");
+
+  Lookup(state, store);
+}
+
+void TransactionLogStore_Get(benchmark::State &state)
+{
+  TransactionLogStore store{};
+  store.New("transaction_log_store_bench");
+
+  Lookup(state, store);
+}
+
+}  // namespace
+
+BENCHMARK(TransactionStore_Ingest)->Arg(1)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(TransactionLogStore_Ingest)->Arg(1)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(TransactionStore_Get);
+BENCHMARK(TransactionLogStore_Get);
@@ -0,0 +1,105 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/digest.hpp"
+#include "core/mutex.hpp"
+#include "ledger/chain/block.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Index over the ancestry of every connected block known to the main chain, forks included.
+ *
+ * Each entry keeps a pointer to its parent and a skip pointer to an ancestor further down the
+ * chain. Skip targets are chosen from the block number alone (the same scheme used by Bitcoin's
+ * block index), so any ancestor can be reached in O(log n) hops and two blocks at the same height
+ * share skip heights, which is what makes fork-point detection logarithmic as well.
+ *
+ * The index only stores hashes and block numbers and is guarded by its own mutex, so it can be
+ * queried without holding the main chain lock and without touching the block store. Blocks which
+ * are too old to be of interest can be pruned, after which queries that reach below the pruned
+ * height fail as if the blocks were unknown.
+ */
+class BlockAncestryIndex
+{
+public:
+  using BlockHashes = std::vector<BlockHash>;
+
+  // Construction / Destruction
+  BlockAncestryIndex()                              = default;
+  BlockAncestryIndex(BlockAncestryIndex const &rhs) = delete;
+  BlockAncestryIndex(BlockAncestryIndex &&rhs)      = delete;
+  ~BlockAncestryIndex()                             = default;
+
+  /// @name Updates
+  /// @{
+  bool        Add(BlockHash const &hash, BlockHash const &previous_hash, uint64_t block_number);
+  std::size_t Remove(BlockHash const &hash);
+  std::size_t Prune(uint64_t lowest_block_number);
+  void        Clear();
+  /// @}
+
+  /// @name Queries
+  /// @{
+  bool        Contains(BlockHash const &hash) const;
+  bool        GetBlockNumber(BlockHash const &hash, uint64_t &block_number) const;
+  BlockHash   GetAncestor(BlockHash const &hash, uint64_t block_number) const;
+  BlockHash   GetCommonAncestor(BlockHash const &left, BlockHash const &right) const;
+  bool        IsAncestor(BlockHash const &ancestor, BlockHash const &descendant) const;
+  BlockHashes GetChainSlice(BlockHash const &tip, uint64_t lowest_block_number,
+                            std::size_t limit) const;
+  std::size_t size() const;
+  /// @}
+
+  static uint64_t SkipBlockNumber(uint64_t block_number);
+
+  // Operators
+  BlockAncestryIndex &operator=(BlockAncestryIndex const &rhs) = delete;
+  BlockAncestryIndex &operator=(BlockAncestryIndex &&rhs) = delete;
+
+private:
+  struct Node
+  {
+    InlineDigest const *hash{nullptr};  ///< Points at the key of this node in the map
+    uint64_t            block_number{0};
+    Node *              parent{nullptr};
+    Node const *        skip{nullptr};
+    Node *              first_child{nullptr};
+    Node *              next_sibling{nullptr};
+  };
+
+  using NodeMap = DigestMap<Node>;
+
+  Node const *Find(BlockHash const &hash) const;
+
+  Node const *Ancestor(Node const *node, uint64_t block_number) const;
+  Node const *CommonAncestor(Node const *left, Node const *right) const;
+
+  mutable Mutex lock_;
+  NodeMap       nodes_;  ///< Element addresses are stable, so nodes link to each other directly
+  uint64_t      lowest_block_number_{0};  ///< Blocks below this number have been pruned
+};
+
+}  // namespace ledger
+}  // namespace fetch
@@ -26,6 +26,7 @@
 #include "core/mutex.hpp"
 #include "crypto/fnv.hpp"
 #include "ledger/chain/block.hpp"
+#include "ledger/chain/block_ancestry_index.hpp"
 #include "meta/type_util.hpp"
 #include "network/generics/milli_timer.hpp"
 #include "storage/object_store.hpp"
@@ -34,6 +35,7 @@
 
 #include <cstdint>
 #include <fstream>
+#include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -130,6 +132,8 @@ public:
   using BlockHashes          = std::vector<BlockHash>;
   using BlockHashSet         = std::unordered_set<BlockHash>;
   using TransactionLayoutSet = std::unordered_set<chain::TransactionLayout>;
+  using TransactionLayoutRefs =
+      std::vector<std::reference_wrapper<chain::TransactionLayout const>>;
   using Travelogue           = TimeTravelogue;
   using DirtyMap = std::map<BlockHash, uint64_t>;  // Map of hash to the time until is becomes valid
 
@@ -181,6 +185,11 @@ public:
             BehaviourWhenLimit behaviour = BehaviourWhenLimit::RETURN_MOST_RECENT) const;
   /// @}
 
+  /// @name Ancestry Index
+  /// @{
+  BlockAncestryIndex const &GetAncestryIndex() const;
+  /// @}
+
   /// @name Tips
   /// @{
   BlockHashSet GetTips() const;
@@ -198,6 +207,8 @@ public:
   /// @{
   DigestSet DetectDuplicateTransactions(BlockHash const &           starting_hash,
                                         TransactionLayoutSet const &transactions) const;
+  DigestSet DetectDuplicateTransactions(BlockHash const &            starting_hash,
+                                        TransactionLayoutRefs const &transactions) const;
   /// @}
 
   // Operators
@@ -208,11 +219,11 @@ public:
 
 private:
   using DbRecord      = BlockDbRecord;
-  using BlockMap      = std::unordered_map<BlockHash, BlockPtr>;
-  using References    = std::unordered_multimap<BlockHash, BlockHash>;
-  using TipsMap       = std::unordered_map<BlockHash, Tip>;
+  using BlockMap      = DigestMap<BlockPtr>;
+  using References    = std::unordered_multimap<InlineDigest, BlockHash, DigestHashAdapter>;
+  using TipsMap       = DigestMap<Tip>;
   using BlockHashList = std::list<BlockHash>;
-  using LooseBlockMap = std::unordered_map<BlockHash, BlockHashList>;
+  using LooseBlockMap = DigestMap<BlockHashList>;
   using BlockStore    = fetch::storage::ObjectStore<DbRecord>;
   using BlockStorePtr = std::unique_ptr<BlockStore>;
   using RMutex        = std::recursive_mutex;
@@ -303,6 +314,9 @@ private:
 
   bool RemoveTree(BlockHash const &removed_hash, BlockHashSet &invalidated_blocks);
 
+  template <typename Layouts>
+  DigestSet DetectDuplicates(BlockHash const &starting_hash, Layouts const &transactions) const;
+
   void FlushToDisk(bool flush_bloom = false);
 
   Mode          mode_{Mode::IN_MEMORY_DB};
@@ -314,6 +328,8 @@ private:
   mutable RMutex   lock_;         ///< Mutex protecting block_chain_, tips_ & heaviest_
   mutable BlockMap block_chain_;  ///< All recent blocks are kept in memory
 
+  BlockAncestryIndex ancestry_;  ///< Ancestry of the connected, untrimmed blocks, has its own lock
+
   // The whole tree of previous-next relations among cached blocks
   mutable References forward_references_;
   TipsMap            tips_;          ///< Keep track of the tips
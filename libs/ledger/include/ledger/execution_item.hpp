@@ -18,6 +18,7 @@
 //------------------------------------------------------------------------------
 
 #include "core/bitvector.hpp"
+#include "core/digest.hpp"
 #include "ledger/executor_interface.hpp"
 #include "logging/logging.hpp"
 
@@ -42,17 +43,18 @@ public:
   static constexpr char const *LOGGING_NAME = "ExecutionItem";
 
   // Construction / Destruction
-  ExecutionItem(Digest digest, BlockIndex block, SliceIndex slice, BitVector const &shards);
+  ExecutionItem(InlineDigest const &digest, BlockIndex block, SliceIndex slice,
+                BitVector const &shards);
   ExecutionItem(ExecutionItem const &) = delete;
   ExecutionItem(ExecutionItem &&)      = delete;
   ~ExecutionItem()                     = default;
 
   /// @name Accessors
   /// @{
-  Digest const &   digest() const;
-  BitVector const &shards() const;
-  Result const &   result() const;
-  TokenAmount      fee() const;
+  InlineDigest const &digest() const;
+  BitVector const &   shards() const;
+  Result const &      result() const;
+  TokenAmount         fee() const;
   /// @}
 
   void Execute(ExecutorInterface &executor);
@@ -65,23 +67,23 @@ public:
 private:
   using AtomicFee = std::atomic<uint64_t>;
 
-  Digest      digest_;
-  BlockIndex  block_{0};
-  SliceIndex  slice_{0};
-  BitVector   shards_;
-  Result      result_;
-  TokenAmount fee_{0};
+  InlineDigest digest_;
+  BlockIndex   block_{0};
+  SliceIndex   slice_{0};
+  BitVector    shards_;
+  Result       result_;
+  TokenAmount  fee_{0};
 };
 
-inline ExecutionItem::ExecutionItem(Digest digest, BlockIndex block, SliceIndex slice,
-                                    BitVector const &shards)
-  : digest_(std::move(digest))
+inline ExecutionItem::ExecutionItem(InlineDigest const &digest, BlockIndex block,
+                                    SliceIndex slice, BitVector const &shards)
+  : digest_(digest)
   , block_{block}
   , slice_{slice}
   , shards_(shards)
 {}
 
-inline Digest const &ExecutionItem::digest() const
+inline InlineDigest const &ExecutionItem::digest() const
 {
   return digest_;
 }
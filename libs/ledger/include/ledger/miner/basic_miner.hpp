@@ -22,10 +22,10 @@
 #include "core/mutex.hpp"
 #include "ledger/block_packer_interface.hpp"
 #include "ledger/chain/block.hpp"
+#include "ledger/miner/mining_pool.hpp"
 #include "ledger/miner/transaction_layout_queue.hpp"
 #include "meta/log2.hpp"
 #include "telemetry/telemetry.hpp"
-#include "vectorise/threading/pool.hpp"
 
 #include <cstddef>
 #include <cstdint>
@@ -34,13 +34,12 @@ namespace fetch {
 namespace ledger {
 
 /**
- * Simplistic greedy search algorithm for generating / packing blocks. Has rudimentary support to
- * parallelize the packing over a number of threads.
+ * Simplistic greedy search algorithm for generating / packing blocks.
  *
- * Internally the miner maintains 2 queues. One which is the pending queue which is populated when
- * a new transaction is added to the miner. When block generation begins, this pending queue is
- * transferred to the main queue when it is evaluated in order to generate new blocks. During this
- * operation the main queue is locked.
+ * Internally the miner maintains a pending queue, which is populated when a new transaction is
+ * added to the miner, and the mining pool. When block generation begins, the pending queue is
+ * transferred to the mining pool, from which the slices of the new block are packed in order of
+ * charge rate. During this operation the mining pool is locked.
  */
 class BasicMiner : public ledger::BlockPackerInterface
 {
@@ -71,23 +70,11 @@ public:
   BasicMiner &operator=(BasicMiner &&) = delete;
 
 private:
-  using ThreadPool = threading::Pool;
-  using Queue      = TransactionLayoutQueue;
-
-  /// @name Packing Operations
-  /// @{
-  static void GenerateSlices(Queue &transactions, Block &block, std::size_t offset,
-                             std::size_t interval, std::size_t num_lanes);
-  static void GenerateSlice(Queue &transactions, Block::Slice &slice, std::size_t slice_index,
-                            std::size_t num_lanes);
-  static bool SortByFee(TransactionLayout const &a, TransactionLayout const &b);
-  /// @}
+  using Queue = TransactionLayoutQueue;
 
   /// @name Configuration
   /// @{
-  uint32_t       log2_num_lanes_;   ///< The log2 of the number of lanes
-  uint32_t const max_num_threads_;  ///< The configured maximum number of threads
-  ThreadPool     thread_pool_;      ///< The thread pool used to dispatch work
+  uint32_t log2_num_lanes_;  ///< The log2 of the number of lanes
   /// @}
 
   /// @name Pending Queue
@@ -99,7 +86,7 @@ private:
   /// @name Central Mining Pool Queue
   /// @{
   mutable Mutex mining_pool_lock_;  ///< Mining pool lock (priority 0)
-  Queue         mining_pool_;       ///< The main mining queue for the node
+  MiningPool    mining_pool_;       ///< The main mining pool for the node
   /// @}
 
   /// @name Telemetry
@@ -0,0 +1,141 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_layout.hpp"
+#include "core/digest.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/miner/transaction_layout_queue.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * The pool of transactions from which the BasicMiner packs blocks.
+ *
+ * Transactions are kept in a bucket for each of the lanes they use (transactions which use no lanes
+ * have a bucket of their own), ordered by decreasing charge rate and then by the order in which
+ * they were added. Since the order is maintained as transactions are added, packing does not need
+ * to sort the pool, and a slice is packed by only visiting the heads of the buckets of the lanes
+ * which are still free in it.
+ */
+class MiningPool
+{
+public:
+  using TransactionLayout     = chain::TransactionLayout;
+  using TransactionLayoutRefs = std::vector<std::reference_wrapper<TransactionLayout const>>;
+
+  // Construction / Destruction
+  explicit MiningPool(uint32_t log2_num_lanes);
+  MiningPool(MiningPool const &) = delete;
+  MiningPool(MiningPool &&)      = delete;
+  ~MiningPool()                  = default;
+
+  /// @name Accessors
+  /// @{
+  std::size_t           size() const;
+  bool                  empty() const;
+  bool                  Has(Digest const &digest) const;
+  TransactionLayoutRefs TxLayouts() const;
+  /// @}
+
+  /// @name Basic Operations
+  /// @{
+  bool        Add(TransactionLayout const &layout);
+  void        Splice(TransactionLayoutQueue &queue);
+  bool        Remove(Digest const &digest);
+  std::size_t Remove(DigestSet const &digests);
+
+  template <typename Predicate>
+  std::size_t RemoveIf(Predicate &&predicate);
+  /// @}
+
+  /// @name Packing
+  /// @{
+  void PackSlice(Block::Slice &slice);
+  /// @}
+
+  // Operators
+  MiningPool &operator=(MiningPool const &) = delete;
+  MiningPool &operator=(MiningPool &&) = delete;
+
+private:
+  using Lanes = std::vector<uint32_t>;
+
+  struct Entry
+  {
+    TransactionLayout layout;
+    uint64_t          sequence{0};
+    Lanes             lanes{};  ///< The lanes used by the transaction
+  };
+
+  /// Packing order of the entries: highest charge rate first, then first come first served
+  struct PackingOrder
+  {
+    bool operator()(Entry const *a, Entry const *b) const;
+  };
+
+  using Entries = DigestMap<Entry>;
+  using Bucket  = std::set<Entry *, PackingOrder>;
+  using Buckets = std::vector<Bucket>;
+
+  void              Index(Entry &entry);
+  void              Unindex(Entry &entry);
+  Entries::iterator Erase(Entries::iterator it);
+
+  uint32_t const num_lanes_;
+  uint64_t       next_sequence_{0};
+  Entries        entries_{};
+  Buckets        buckets_;  ///< A bucket per lane, then one for transactions which use no lanes
+};
+
+/**
+ * Remove the transactions for which the predicate holds
+ *
+ * @param predicate The predicate, called with each of the transaction layouts in the pool
+ * @return The number of transactions removed
+ */
+template <typename Predicate>
+std::size_t MiningPool::RemoveIf(Predicate &&predicate)
+{
+  std::size_t count{0};
+
+  for (auto it = entries_.begin(); it != entries_.end();)
+  {
+    if (predicate(static_cast<TransactionLayout const &>(it->second.layout)))
+    {
+      it = Erase(it);
+      ++count;
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  return count;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -20,131 +20,131 @@
 #include "core/bitvector.hpp"
 #include "core/random/lcg.hpp"
 #include "core/random/lfg.hpp"
-#include "logging/logging.hpp"
-#include "math/approx_exp.hpp"
+#include "vectorise/threading/pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace fetch {
 namespace optimisers {
 
+/**
+ * Simulated annealer for binary quadratic optimisation problems
+ *
+ *   E(s) = sum_i h_i s_i + sum_{i < j} J_ij s_i s_j,  s_i in {0, 1}
+ *
+ * The couplings are stored in compressed sparse row form and every replica keeps the local field
+ * of each site (h_i plus the couplings to the sites which are set). The energy change of a flip
+ * is therefore read off directly and only the neighbours of a flipped site are updated.
+ *
+ * A number of independent replicas are annealed concurrently on a thread pool and the best state
+ * found by any of them is kept. When a time budget is set, each replica keeps restarting the
+ * schedule from a new random state until the budget has been used.
+ */
 class BinaryAnnealer
 {
 public:
   static constexpr char const *LOGGING_NAME = "BinaryAnnealer";
 
-  using SpinType  = int16_t;
-  using StateType = std::vector<SpinType>;
-
-  using exp_type      = math::ApproxExpImplementation<0>;
-  using BitDataType   = uint64_t;
+  using SpinType      = int16_t;
+  using StateType     = std::vector<SpinType>;
   using BitVectorType = BitVector;
   using CostType      = double;
+  using Clock         = std::chrono::steady_clock;
+  using Duration      = Clock::duration;
 
   void Anneal()
   {
-    Initialise();
-    SetBeta(beta0_);
-
-    double        db = (beta1_ - beta0_) / double(sweeps_ - 1);
-    BitVectorType B;
-    B.Resize(size_);
+    BuildCouplings();
 
-    for (std::size_t k = 0; k < sweeps_; ++k)
-    {
-      attempts_ += double(size_);
+    std::size_t const num_replicas = std::max<std::size_t>(replicas_, 1);
+    bool const        timed        = budget_ > Duration::zero();
+    auto const        deadline     = Clock::now() + budget_;
 
-      std::size_t block = 0;
-      std::size_t bit   = 0;
+    std::vector<Result> results;
+    results.reserve(num_replicas);
 
-      double   r           = sim_rng_.AsDouble();
-      double   TlogR       = std::log(r) / beta_ / 2. / normalisation_constant_;
-      CostType approxTlogR = CostType(TlogR);
-
-      for (std::size_t i = 0; i < size_; ++i)
+    if (num_replicas == 1)
+    {
+      results.emplace_back(RunReplica(init_rng_(), timed, deadline));
+    }
+    else
+    {
+      if (!pool_ || (pool_->concurrency() != NumThreads(num_replicas)))
       {
-        //        assert( i ==( block * 8*sizeof(BitDataType) + bit ));
-        assert(i < sites_.size());
-
-        Site const &s         = sites_[i];
-        uint64_t    state_bit = state_.bit(block, bit);
-        uint64_t    update    = 0;
-
-        int p = 0;
-        switch (B.blocks())
-        {
-        case 0:
-          break;
-        case 1:
-        case 2:
-          B(0) = s.couplings(0) & state_(0);
-          B(1) = s.couplings(1) & state_(1);
-          p    = __builtin_popcountl(B(0)) + __builtin_popcountl(B(1));
-
-          break;
-
-        case 3:
-        case 4:
-          B(0) = s.couplings(0) & state_(0);
-          B(1) = s.couplings(1) & state_(1);
-          B(2) = s.couplings(2) & state_(2);
-          B(3) = s.couplings(3) & state_(3);
-          p    = __builtin_popcountl(B(0)) + __builtin_popcountl(B(1)) + __builtin_popcountl(B(2)) +
-              __builtin_popcountl(B(3));
-          break;
-
-        default:
-          B.InlineAndAssign(s.couplings, state_);
-          p = static_cast<int>(B.PopCount());
-          break;
-        }
-
-        CostType C;
-        C      = -CostType(p) - s.local_field;
-        update = (approxTlogR <= C);
-        //        update =
-        switch (state_bit)
-        {
-        case 0:
+        pool_ = std::make_unique<threading::Pool>(NumThreads(num_replicas), "Annealer");
+      }
 
-          break;
-        case 1:
-          C      = CostType(p) + s.local_field;
-          update = (approxTlogR <= C);
-          break;
-        }
+      std::vector<std::future<Result>> futures;
+      futures.reserve(num_replicas);
+      for (std::size_t i = 0; i < num_replicas; ++i)
+      {
+        futures.emplace_back(pool_->Dispatch(
+            [this, timed, deadline](uint64_t seed) { return RunReplica(seed, timed, deadline); },
+            init_rng_()));
+      }
 
-        if (update)
-        {
-          state_.conditional_flip(block, bit, update);
-        }
-        ++bit;
-        block += (bit >= 8 * sizeof(BitDataType));
-        bit &= (8 * sizeof(BitDataType) - 1);
+      for (auto &future : futures)
+      {
+        results.emplace_back(future.get());
       }
+    }
+
+    // keep the best state found by any of the replicas
+    auto const best = std::min_element(
+        results.begin(), results.end(),
+        [](Result const &a, Result const &b) { return a.energy < b.energy; });
 
-      SetBeta(beta() + db);
+    state_.Resize(size_);
+    for (std::size_t i = 0; i < size_; ++i)
+    {
+      state_.set(i, best->spins[i]);
     }
+
+    SetBeta(beta1_);
   }
 
+  /**
+   * Scale the problem such that the largest coupling has a magnitude of one
+   *
+   * The annealing temperatures are relative to this scale, while energies are still reported in
+   * the original units.
+   */
   void Normalise()
   {
-    if (coupling_magnitude_ == 1.0)
+    CostType magnitude = 0;
+    for (auto const &edge : edges_)
     {
-      return;
+      magnitude = std::max(magnitude, std::fabs(edge.weight));
     }
-    if (coupling_magnitude_ == 0.0)
+
+    if ((magnitude == 0.0) || (magnitude == 1.0))
     {
       return;
     }
 
-    for (std::size_t i = 0; i < size_; ++i)
+    for (auto &field : local_fields_)
     {
-      assert(i < sites_.size());
+      field /= magnitude;
+    }
 
-      sites_[i].local_field /= coupling_magnitude_;
+    for (auto &edge : edges_)
+    {
+      edge.weight /= magnitude;
     }
 
-    normalisation_constant_ *= coupling_magnitude_;
-    coupling_magnitude_ = 1.0;
+    normalisation_constant_ *= magnitude;
+    couplings_dirty_ = true;
   }
 
   CostType FindMinimum()
@@ -158,9 +158,8 @@ public:
     Anneal();
     CostType ret = Energy();
 
-    // TODO(issue 30): Optimise
-
     state.clear();
+    state.reserve(size_);
 
     for (std::size_t i = 0; i < size_; ++i)
     {
@@ -170,64 +169,81 @@ public:
     return ret;
   }
 
+  /**
+   * Compute the energy of the current state
+   *
+   * @return The energy, in the units of the inserted values
+   */
   CostType Energy() const
   {
-    CostType    ret   = 0;
-    std::size_t block = 0;
-    std::size_t bit   = 0;
+    CostType ret = 0;
 
     for (std::size_t i = 0; i < size_; ++i)
     {
-      assert(i == (block * 8 * sizeof(BitDataType) + bit));
-      Site const &s = sites_[i];
-
-      BitVectorType B    = s.couplings & state_;
-      CostType      sign = CostType(state_.bit(block, bit));
+      if (state_.bit(i) != 0u)
+      {
+        ret += local_fields_[i];
+      }
+    }
 
-      ret += sign * (2 * s.local_field + coupling_magnitude_ * static_cast<int>(B.PopCount()));
-      ++bit;
-      block += (bit >= 8 * sizeof(BitDataType));
-      bit &= (8 * sizeof(BitDataType) - 1);
+    for (auto const &edge : edges_)
+    {
+      if ((state_.bit(edge.i) != 0u) && (state_.bit(edge.j) != 0u))
+      {
+        ret += edge.weight;
+      }
     }
-    return CostType(ret * 0.5 * normalisation_constant_);
+
+    return ret * normalisation_constant_;
   }
 
   void Resize(std::size_t n, std::size_t /*m*/ = std::size_t(-1))
   {
-    sites_.resize(n);
-    for (std::size_t i = 0; i < n; ++i)
-    {
-      Site &s = sites_[i];
-      s.couplings.Resize(n);
-      s.couplings.SetAllZero();
-
-      s.local_field = 0;
-    }
+    local_fields_.assign(n, 0);
+    edges_.clear();
+    edge_index_.clear();
+    couplings_dirty_ = true;
 
     state_.Resize(n);
     state_.SetAllZero();
-    size_               = n;
-    coupling_magnitude_ = 0;
+    size_ = n;
   }
 
+  /**
+   * Set the local field of a site (when i == j) or the coupling between two sites
+   *
+   * @param i The first site
+   * @param j The second site
+   * @param val The value of the field or coupling
+   */
   void Insert(std::size_t i, std::size_t j, CostType const &val)
   {
+    assert(i < size_);
+    assert(j < size_);
+
     if (i == j)
     {
-      assert(j < sites_.size());
+      local_fields_[j] = val;
+      return;
+    }
 
-      sites_[j].local_field = val;
+    if (j < i)
+    {
+      std::swap(i, j);
+    }
+
+    auto const key    = (static_cast<uint64_t>(i) * size_) + j;
+    auto const result = edge_index_.emplace(key, edges_.size());
+    if (result.second)
+    {
+      edges_.push_back(Edge{i, j, val});
     }
     else
     {
-      assert((coupling_magnitude_ == 0) || (coupling_magnitude_ == val));
-      assert(i < sites_.size());
-      assert(j < sites_.size());
-
-      sites_[i].couplings.set(j, 1);
-      sites_[j].couplings.set(i, 1);
-      coupling_magnitude_ = val;
+      edges_[result.first->second].weight = val;
     }
+
+    couplings_dirty_ = true;
   }
 
   std::size_t size() const
@@ -238,13 +254,13 @@ public:
   void SetBeta(double beta)
   {
     beta_ = beta;
-    fexp_.SetCoefficient(2 * beta_);
   }
 
   double beta() const
   {
     return beta_;
   }
+
   std::size_t sweeps() const
   {
     return sweeps_;
@@ -254,19 +270,52 @@ public:
   {
     sweeps_ = sweeps;
   }
+
   void SetBetaStart(double const &b0)
   {
     beta0_ = b0;
   }
+
   void SetBetaEnd(double const &b1)
   {
     beta1_ = b1;
   }
 
+  /**
+   * Set the number of independent replicas to anneal, concurrently if the machine allows
+   *
+   * @param replicas The number of replicas
+   */
+  void SetReplicas(std::size_t replicas)
+  {
+    replicas_ = replicas;
+  }
+
+  std::size_t replicas() const
+  {
+    return replicas_;
+  }
+
+  /**
+   * Set the wall clock time for which each annealing run keeps searching. A zero budget runs the
+   * schedule once per replica.
+   *
+   * @param budget The time budget
+   */
+  template <typename R, typename P>
+  void SetTimeBudget(std::chrono::duration<R, P> const &budget)
+  {
+    budget_ = std::chrono::duration_cast<Duration>(budget);
+  }
+
+  /**
+   * Set the current state to a random one
+   *
+   * This has no effect on annealing, as Anneal() starts every replica from its own random state and
+   * replaces the current state with the best one found.
+   */
   void Initialise()
   {
-    attempts_ = 0;
-    accepted_ = 0;
     state_.Resize(size_);
     for (std::size_t i = 0; i < state_.blocks(); ++i)
     {
@@ -281,36 +330,213 @@ public:
 
   void Reset()
   {
-    attempts_           = 0;
-    accepted_           = 0;
-    coupling_magnitude_ = 0, normalisation_constant_ = 1.0;
+    normalisation_constant_ = 1.0;
 
     state_.SetAllZero();
-    sites_.clear();
+    local_fields_.clear();
+    edges_.clear();
+    edge_index_.clear();
+    couplings_dirty_ = true;
 
     size_ = 0;
   }
 
 private:
-  double   attempts_           = 0;
-  double   accepted_           = 0;
-  CostType coupling_magnitude_ = 0, normalisation_constant_ = 1.0;
+  struct Edge
+  {
+    std::size_t i;
+    std::size_t j;
+    CostType    weight;
+  };
 
-  struct Site
+  struct Result
   {
-    BitVectorType couplings;
-    CostType      local_field;
+    std::vector<uint8_t> spins;
+    CostType             energy{std::numeric_limits<CostType>::max()};
   };
 
-  BitVectorType     state_;
-  std::vector<Site> sites_;
-  double            beta_, beta0_ = 0.1, beta1_ = 3;
+  struct Replica
+  {
+    std::vector<uint8_t>                spins;
+    std::vector<CostType>               fields;
+    CostType                            energy{0};
+    random::LinearCongruentialGenerator rng;
+  };
+
+  static std::size_t NumThreads(std::size_t replicas)
+  {
+    return std::min<std::size_t>(replicas, std::max(1u, std::thread::hardware_concurrency()));
+  }
+
+  /**
+   * Build the compressed sparse row form of the couplings, with each coupling stored for both of
+   * the sites involved
+   */
+  void BuildCouplings()
+  {
+    if (!couplings_dirty_)
+    {
+      return;
+    }
+
+    row_offsets_.assign(size_ + 1, 0);
+    for (auto const &edge : edges_)
+    {
+      ++row_offsets_[edge.i + 1];
+      ++row_offsets_[edge.j + 1];
+    }
+
+    for (std::size_t i = 0; i < size_; ++i)
+    {
+      row_offsets_[i + 1] += row_offsets_[i];
+    }
+
+    columns_.resize(2 * edges_.size());
+    weights_.resize(2 * edges_.size());
+
+    std::vector<std::size_t> next(row_offsets_.begin(), row_offsets_.end() - 1);
+    for (auto const &edge : edges_)
+    {
+      columns_[next[edge.i]]   = static_cast<uint32_t>(edge.j);
+      weights_[next[edge.i]++] = edge.weight;
+      columns_[next[edge.j]]   = static_cast<uint32_t>(edge.i);
+      weights_[next[edge.j]++] = edge.weight;
+    }
+
+    couplings_dirty_ = false;
+  }
+
+  /**
+   * Anneal a single replica from random initial states, until the schedule has been run once or
+   * the time budget has been used
+   *
+   * @param seed The seed of the replica
+   * @param timed Whether to run until the deadline
+   * @param deadline The time at which to stop searching
+   * @return The best state found by the replica
+   */
+  Result RunReplica(uint64_t seed, bool timed, Clock::time_point const &deadline) const
+  {
+    double const beta_step = (sweeps_ > 1) ? (beta1_ - beta0_) / double(sweeps_ - 1) : 0.0;
+
+    Replica replica;
+    replica.rng.Seed(seed);
+
+    Result best;
+    do
+    {
+      Randomise(replica);
+
+      double beta = beta0_;
+      for (std::size_t k = 0; k < sweeps_; ++k)
+      {
+        Sweep(replica, beta);
+        beta += beta_step;
+
+        if (timed && (Clock::now() >= deadline))
+        {
+          break;
+        }
+      }
+
+      // finish in the nearest local minimum
+      Sweep(replica, std::numeric_limits<double>::infinity());
+
+      if (replica.energy < best.energy)
+      {
+        best.spins  = replica.spins;
+        best.energy = replica.energy;
+      }
+    } while (timed && (Clock::now() < deadline));
+
+    return best;
+  }
+
+  void Randomise(Replica &replica) const
+  {
+    replica.spins.resize(size_);
+    for (auto &spin : replica.spins)
+    {
+      spin = static_cast<uint8_t>(replica.rng() >> 63u);
+    }
+
+    replica.fields.assign(local_fields_.begin(), local_fields_.end());
+    replica.energy = 0;
+
+    for (std::size_t i = 0; i < size_; ++i)
+    {
+      if (replica.spins[i] == 0)
+      {
+        continue;
+      }
+
+      replica.energy += local_fields_[i];
+      for (std::size_t k = row_offsets_[i]; k < row_offsets_[i + 1]; ++k)
+      {
+        replica.fields[columns_[k]] += weights_[k];
+      }
+    }
+
+    for (std::size_t i = 0; i < size_; ++i)
+    {
+      if (replica.spins[i] != 0)
+      {
+        // every coupling between two set sites has been added to the fields of both
+        replica.energy += 0.5 * (replica.fields[i] - local_fields_[i]);
+      }
+    }
+  }
+
+  /**
+   * Attempt to flip every site once, using the Metropolis criterion
+   *
+   * @param replica The replica to be updated
+   * @param beta The inverse temperature
+   */
+  void Sweep(Replica &replica, double beta) const
+  {
+    for (std::size_t i = 0; i < size_; ++i)
+    {
+      CostType const delta = (replica.spins[i] != 0) ? -replica.fields[i] : replica.fields[i];
+
+      if ((delta > 0) && (replica.rng.AsDouble() >= std::exp(-2.0 * beta * delta)))
+      {
+        continue;
+      }
+
+      replica.spins[i] ^= 1u;
+      replica.energy += delta;
+
+      CostType const sign = (replica.spins[i] != 0) ? 1.0 : -1.0;
+      for (std::size_t k = row_offsets_[i]; k < row_offsets_[i + 1]; ++k)
+      {
+        replica.fields[columns_[k]] += sign * weights_[k];
+      }
+    }
+  }
+
+  CostType normalisation_constant_ = 1.0;
+
+  // problem definition
+  std::vector<CostType>                     local_fields_;
+  std::vector<Edge>                         edges_;
+  std::unordered_map<uint64_t, std::size_t> edge_index_;
+
+  // couplings in compressed sparse row form
+  bool                  couplings_dirty_{true};
+  std::vector<uint32_t> row_offsets_;
+  std::vector<uint32_t> columns_;
+  std::vector<CostType> weights_;
+
+  BitVectorType state_;
+  double        beta_ = 0.1, beta0_ = 0.1, beta1_ = 3;
 
-  std::size_t                         sweeps_ = 10;
-  std::size_t                         size_   = 0;
-  exp_type                            fexp_;
-  random::LinearCongruentialGenerator sim_rng_;
-  random::LaggedFibonacciGenerator<>  init_rng_;
+  std::size_t                        sweeps_   = 10;
+  std::size_t                        size_     = 0;
+  std::size_t                        replicas_ = 1;
+  Duration                           budget_{Duration::zero()};
+  random::LaggedFibonacciGenerator<> init_rng_;
+  std::unique_ptr<threading::Pool>   pool_;
 };
 
 }  // namespace optimisers
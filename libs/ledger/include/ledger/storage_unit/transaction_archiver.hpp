@@ -22,7 +22,15 @@
 #include "core/state_machine.hpp"
 #include "telemetry/telemetry.hpp"
 
+#include <vector>
+
 namespace fetch {
+namespace chain {
+
+class Transaction;
+
+}  // namespace chain
+
 namespace ledger {
 
 class TransactionPoolInterface;
@@ -31,7 +39,8 @@ class TransactionStoreInterface;
 /**
  * The transaction archiver manages transactions between a pool and a store. Once a transaction
  * has been confirmed it will be placed in a queue which will result in the transaction being
- * committed to persistent storage.
+ * committed to persistent storage. Confirmed transactions are collected into batches, each of
+ * which is written to the store in a single operation.
  *
  *                       ┌─────────────┐               ┌─────────────┐
  *                       │ Transaction │               │ Transaction │
@@ -66,10 +75,11 @@ public:
   StateMachinePtr const &GetStateMachine() const;
 
 private:
-  static const std::size_t BATCH_SIZE = 100;
+  static const std::size_t BATCH_SIZE = 1000;
 
   using ConfirmationQueue = core::MPMCQueue<Digest, 1u << 15u>;
   using Digests           = std::vector<Digest>;
+  using TxArray           = std::vector<chain::Transaction>;
 
   State OnCollecting();
   State OnFlushing();
@@ -0,0 +1,164 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/digest.hpp"
+#include "core/mutex.hpp"
+#include "ledger/storage_unit/transaction_store_interface.hpp"
+#include "storage/fetch_mmap.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Transaction store built from append-only segment files.
+ *
+ * Transactions are immutable, so rather than keeping them in a document store with a mutable
+ * Merkle index, each one is appended to the active segment as a record holding its digest and its
+ * wire bytes. Once the active segment reaches the configured size it is sealed and a new one is
+ * started. Reads come straight from read-only mappings of the segments. The digest index is held
+ * in memory and is rebuilt by scanning the segments when the store is loaded, truncating any
+ * partially written record at the end of the log.
+ *
+ * Files for a store with the prefix `txs` are:
+ *
+ *   txs.manifest       The id of the oldest retained segment
+ *   txs.00000000.seg   Segment files, each starting with an 8 byte header, followed by records
+ *
+ * Segment record layout:
+ *
+ *   ┌──────────┬──────────────┬─────────────┬─────────────────────────┐
+ *   │ size (4) │ checksum (4) │ digest (32) │ wire bytes (size bytes) │
+ *   └──────────┴──────────────┴─────────────┴─────────────────────────┘
+ *
+ * When a maximum number of segments is configured, the oldest segment (and the transactions it
+ * holds) is dropped each time sealing a segment would exceed it.
+ */
+class TransactionLogStore : public TransactionStoreInterface
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using TxArray        = std::vector<chain::Transaction>;
+
+  struct Config
+  {
+    uint64_t segment_size{64ull << 20u};  ///< Size at which the active segment is sealed
+    uint64_t max_segments{0};             ///< Maximum number of segments retained, 0 for all
+  };
+
+  // Construction / Destruction
+  TransactionLogStore() = default;
+  explicit TransactionLogStore(Config const &config);
+  TransactionLogStore(TransactionLogStore const &) = delete;
+  TransactionLogStore(TransactionLogStore &&)      = delete;
+  ~TransactionLogStore() override                  = default;
+
+  // Database control
+  void New(std::string const &prefix);
+  void Load(std::string const &prefix, bool create = true);
+
+  /// @name Transaction Storage Interface
+  /// @{
+  void        Add(chain::Transaction const &tx) override;
+  std::size_t AddBatch(TxArray const &txs) override;
+  bool        Has(Digest const &tx_digest) const override;
+  bool        Get(Digest const &tx_digest, chain::Transaction &tx) const override;
+  uint64_t    GetCount() const override;
+  /// @}
+
+  /// @name Low Level Subtree Access
+  /// @{
+  TxArray PullSubtree(Digest const &partial_digest, uint64_t bit_count, uint64_t pull_limit);
+  /// @}
+
+  /// @name Segment Information
+  /// @{
+  uint64_t GetNumSegments() const;
+  uint64_t GetSizeOnDisk() const;
+  /// @}
+
+  // Operators
+  TransactionLogStore &operator=(TransactionLogStore const &) = delete;
+  TransactionLogStore &operator=(TransactionLogStore &&) = delete;
+
+private:
+  using Buffer = std::vector<uint8_t>;
+
+  struct Location
+  {
+    uint64_t segment{0};  ///< The id of the segment holding the record
+    uint64_t offset{0};   ///< The offset of the wire bytes in the segment
+    uint32_t size{0};     ///< The size of the wire bytes
+  };
+
+  struct Segment
+  {
+    uint64_t         size{0};  ///< The number of bytes written to the segment
+    mio::mmap_source map{};    ///< Read only mapping, refreshed on demand for the active segment
+  };
+
+  /**
+   * Orders digests by their bits taken least significant first from each byte. This is the bit
+   * order of the storage keys, so that a subtree is a contiguous range of the index.
+   */
+  struct SubtreeOrder
+  {
+    bool operator()(InlineDigest const &a, InlineDigest const &b) const;
+  };
+
+  using Index    = std::map<InlineDigest, Location, SubtreeOrder>;
+  using Segments = std::map<uint64_t, Segment>;
+
+  /// @name Helpers - not thread safe
+  /// @{
+  void        Reset();
+  void        Append(Digest const &digest, ConstByteArray const &encoded, Buffer &buffer);
+  void        Write(Buffer const &buffer);
+  void        RecoverActiveSegment();
+  void        OpenSegment(uint64_t id, bool create);
+  void        SealActiveSegment();
+  void        DropOldestSegment();
+  void        ScanSegment(uint64_t id, bool is_last);
+  void        MapSegment(uint64_t id, Segment &segment) const;
+  void        WriteManifest() const;
+  std::string SegmentFilename(uint64_t id) const;
+  bool        Read(Location const &location, chain::Transaction &tx) const;
+  /// @}
+
+  Config const config_{};
+
+  mutable Mutex    lock_;
+  std::string      prefix_{};
+  Index            index_{};
+  mutable Segments segments_{};      ///< All retained segments, the last one being active
+  std::fstream     active_file_{};   ///< Append handle of the active segment
+  uint64_t         active_id_{0};    ///< The id of the active segment
+  bool             is_open_{false};  ///< Whether New or Load has been called
+};
+
+}  // namespace ledger
+}  // namespace fetch
@@ -21,6 +21,7 @@
 #include "ledger/storage_unit/transaction_store_interface.hpp"
 #include "storage/object_store.hpp"
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -44,10 +45,11 @@ public:
 
   /// @name Transaction Storage Interface
   /// @{
-  void     Add(chain::Transaction const &tx) override;
-  bool     Has(Digest const &tx_digest) const override;
-  bool     Get(Digest const &tx_digest, chain::Transaction &tx) const override;
-  uint64_t GetCount() const override;
+  void        Add(chain::Transaction const &tx) override;
+  std::size_t AddBatch(TxArray const &txs) override;
+  bool        Has(Digest const &tx_digest) const override;
+  bool        Get(Digest const &tx_digest, chain::Transaction &tx) const override;
+  uint64_t    GetCount() const override;
   /// @}
 
   /// @mame Low Level Subtree Access
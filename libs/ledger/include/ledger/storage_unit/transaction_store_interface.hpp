@@ -17,20 +17,20 @@
 //
 //------------------------------------------------------------------------------
 
+#include "chain/transaction.hpp"
 #include "core/digest.hpp"
 
-namespace fetch {
-namespace chain {
-
-class Transaction;
-
-}  // namespace chain
+#include <cstddef>
+#include <vector>
 
+namespace fetch {
 namespace ledger {
 
 class TransactionStoreInterface
 {
 public:
+  using TxArray = std::vector<chain::Transaction>;
+
   // Construction / Destruction
   TransactionStoreInterface()          = default;
   virtual ~TransactionStoreInterface() = default;
@@ -45,6 +45,27 @@ public:
    */
   virtual void Add(chain::Transaction const &tx) = 0;
 
+  /**
+   * Add a batch of transactions to the store, skipping those which are already present
+   *
+   * @param txs The transactions to be added to storage
+   * @return The number of transactions which were added
+   */
+  virtual std::size_t AddBatch(TxArray const &txs)
+  {
+    std::size_t added{0};
+    for (auto const &tx : txs)
+    {
+      if (!Has(tx.digest()))
+      {
+        Add(tx);
+        ++added;
+      }
+    }
+
+    return added;
+  }
+
   /**
    * Check to see if requested transaction exists
    *
@@ -79,6 +79,7 @@ template <typename CLOCK>
 typename TransactionStatusCacheImpl<CLOCK>::TxStatus TransactionStatusCacheImpl<CLOCK>::Query(
     Digest digest) const
 {
+  if (InlineDigest::Fits(digest))
   {
     FETCH_LOCK(mtx_);
 
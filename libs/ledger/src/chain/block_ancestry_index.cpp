@@ -0,0 +1,455 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/block_ancestry_index.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+constexpr uint64_t ClearLowestBit(uint64_t value)
+{
+  return value & (value - 1u);
+}
+
+}  // namespace
+
+/**
+ * Determine the block number that the skip pointer of a block with the given number refers to.
+ *
+ * Even block numbers skip by their lowest set bit, odd ones a little less far, so that paths
+ * with different starting points quickly join the same sequence of skip targets.
+ *
+ * @param block_number The block number of the block
+ * @return The block number of the skip target
+ */
+uint64_t BlockAncestryIndex::SkipBlockNumber(uint64_t block_number)
+{
+  if (block_number < 2u)
+  {
+    return 0;
+  }
+
+  return ((block_number & 1u) != 0u) ? ClearLowestBit(ClearLowestBit(block_number - 1u)) + 1u
+                                     : ClearLowestBit(block_number);
+}
+
+/**
+ * Add a block to the index. The parent must already be present, except for a block numbered zero
+ * which starts a new root.
+ *
+ * @param hash The hash of the block
+ * @param previous_hash The hash of the parent block
+ * @param block_number The block number of the block
+ * @return true if the block is (now) present in the index, otherwise false
+ */
+bool BlockAncestryIndex::Add(BlockHash const &hash, BlockHash const &previous_hash,
+                             uint64_t block_number)
+{
+  if (!InlineDigest::Fits(hash))
+  {
+    return false;
+  }
+
+  FETCH_LOCK(lock_);
+
+  if (nodes_.find(hash) != nodes_.end())
+  {
+    return true;
+  }
+
+  Node *parent{nullptr};
+  if (block_number != 0)
+  {
+    auto const parent_it =
+        InlineDigest::Fits(previous_hash) ? nodes_.find(previous_hash) : nodes_.end();
+    if ((parent_it == nodes_.end()) || (parent_it->second.block_number + 1u != block_number))
+    {
+      return false;
+    }
+
+    parent = &parent_it->second;
+  }
+
+  auto const it = nodes_.emplace(hash, Node{}).first;
+
+  Node &node        = it->second;
+  node.hash         = &it->first;
+  node.block_number = block_number;
+  node.parent       = parent;
+
+  if (parent)
+  {
+    node.skip = Ancestor(parent, SkipBlockNumber(block_number));
+
+    node.next_sibling   = parent->first_child;
+    parent->first_child = &node;
+  }
+
+  return true;
+}
+
+/**
+ * Remove a block, and every block built on top of it, from the index
+ *
+ * @param hash The hash of the block to be removed
+ * @return The number of entries removed
+ */
+std::size_t BlockAncestryIndex::Remove(BlockHash const &hash)
+{
+  if (!InlineDigest::Fits(hash))
+  {
+    return 0;
+  }
+
+  FETCH_LOCK(lock_);
+
+  auto const it = nodes_.find(hash);
+  if (it == nodes_.end())
+  {
+    return 0;
+  }
+
+  Node *root = &it->second;
+
+  // unlink the subtree from its parent
+  if (root->parent)
+  {
+    Node **link = &root->parent->first_child;
+    while (*link != root)
+    {
+      link = &(*link)->next_sibling;
+    }
+    *link = root->next_sibling;
+  }
+
+  // collect the whole subtree before erasing anything, since the keys are owned by the map
+  std::vector<Node *> removed{root};
+  for (std::size_t i = 0; i < removed.size(); ++i)
+  {
+    for (Node *child = removed[i]->first_child; child != nullptr; child = child->next_sibling)
+    {
+      removed.push_back(child);
+    }
+  }
+
+  for (Node *node : removed)
+  {
+    nodes_.erase(*node->hash);
+  }
+
+  return removed.size();
+}
+
+/**
+ * Remove every block below a given block number from the index. The blocks at that number
+ * become roots, and skip pointers that led below it are dropped, which does not affect queries
+ * that stay above the pruned height.
+ *
+ * @param lowest_block_number The block number of the lowest blocks to be kept
+ * @return The number of entries removed
+ */
+std::size_t BlockAncestryIndex::Prune(uint64_t lowest_block_number)
+{
+  FETCH_LOCK(lock_);
+
+  if (lowest_block_number <= lowest_block_number_)
+  {
+    return 0;
+  }
+
+  lowest_block_number_ = lowest_block_number;
+
+  // unlink the blocks that are kept before erasing anything, since the keys are owned by the map
+  for (auto &entry : nodes_)
+  {
+    Node &node = entry.second;
+    if (node.block_number < lowest_block_number)
+    {
+      continue;
+    }
+
+    if ((node.parent != nullptr) && (node.parent->block_number < lowest_block_number))
+    {
+      node.parent       = nullptr;
+      node.next_sibling = nullptr;
+    }
+
+    if ((node.skip != nullptr) && (node.skip->block_number < lowest_block_number))
+    {
+      node.skip = nullptr;
+    }
+  }
+
+  std::size_t removed{0};
+  for (auto it = nodes_.begin(); it != nodes_.end();)
+  {
+    if (it->second.block_number < lowest_block_number)
+    {
+      it = nodes_.erase(it);
+      ++removed;
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  return removed;
+}
+
+/**
+ * Remove all the entries from the index
+ */
+void BlockAncestryIndex::Clear()
+{
+  FETCH_LOCK(lock_);
+  nodes_.clear();
+  lowest_block_number_ = 0;
+}
+
+/**
+ * Determine if a block is present in the index
+ *
+ * @param hash The hash of the block
+ * @return true if present, otherwise false
+ */
+bool BlockAncestryIndex::Contains(BlockHash const &hash) const
+{
+  FETCH_LOCK(lock_);
+  return Find(hash) != nullptr;
+}
+
+/**
+ * Look up the block number of an indexed block
+ *
+ * @param hash The hash of the block
+ * @param[out] block_number The block number, if found
+ * @return true if the block was found, otherwise false
+ */
+bool BlockAncestryIndex::GetBlockNumber(BlockHash const &hash, uint64_t &block_number) const
+{
+  FETCH_LOCK(lock_);
+
+  auto const *node = Find(hash);
+  if (node == nullptr)
+  {
+    return false;
+  }
+
+  block_number = node->block_number;
+  return true;
+}
+
+/**
+ * Find the ancestor of a block at a given block number
+ *
+ * @param hash The hash of the block to start from
+ * @param block_number The block number of the requested ancestor
+ * @return The hash of the ancestor, or an empty hash if it can not be determined
+ */
+BlockHash BlockAncestryIndex::GetAncestor(BlockHash const &hash, uint64_t block_number) const
+{
+  FETCH_LOCK(lock_);
+
+  auto const *ancestor = Ancestor(Find(hash), block_number);
+
+  return ancestor ? BlockHash{*ancestor->hash} : BlockHash{};
+}
+
+/**
+ * Find the most recent block that two blocks have in common, i.e. the point at which their
+ * branches fork
+ *
+ * @param left The hash of the first block
+ * @param right The hash of the second block
+ * @return The hash of the common ancestor, or an empty hash if it can not be determined
+ */
+BlockHash BlockAncestryIndex::GetCommonAncestor(BlockHash const &left,
+                                                BlockHash const &right) const
+{
+  FETCH_LOCK(lock_);
+
+  auto const *ancestor = CommonAncestor(Find(left), Find(right));
+
+  return ancestor ? BlockHash{*ancestor->hash} : BlockHash{};
+}
+
+/**
+ * Determine if one block lies on the chain leading to another. A block is considered to be an
+ * ancestor of itself.
+ *
+ * @param ancestor The hash of the possible ancestor
+ * @param descendant The hash of the possible descendant
+ * @return true if both blocks are indexed and the relation holds, otherwise false
+ */
+bool BlockAncestryIndex::IsAncestor(BlockHash const &ancestor, BlockHash const &descendant) const
+{
+  FETCH_LOCK(lock_);
+
+  auto const *ancestor_node = Find(ancestor);
+
+  return (ancestor_node != nullptr) &&
+         (Ancestor(Find(descendant), ancestor_node->block_number) == ancestor_node);
+}
+
+/**
+ * Collect the hashes of the blocks on the chain leading to a tip, starting from a given block
+ * number and moving towards the tip
+ *
+ * @param tip The hash of the block which ends the chain
+ * @param lowest_block_number The block number of the first block of the slice
+ * @param limit The maximum number of hashes returned
+ * @return The hashes in increasing block number order, empty if the slice can not be determined
+ */
+BlockAncestryIndex::BlockHashes BlockAncestryIndex::GetChainSlice(BlockHash const &tip,
+                                                                  uint64_t    lowest_block_number,
+                                                                  std::size_t limit) const
+{
+  FETCH_LOCK(lock_);
+
+  BlockHashes slice{};
+
+  auto const *tip_node = Find(tip);
+  if ((tip_node == nullptr) || (limit == 0) || (lowest_block_number > tip_node->block_number) ||
+      (lowest_block_number < lowest_block_number_))
+  {
+    return slice;
+  }
+
+  uint64_t const highest_block_number =
+      std::min(tip_node->block_number, lowest_block_number + (limit - 1u));
+
+  slice.resize(highest_block_number - lowest_block_number + 1u);
+
+  auto const *node = Ancestor(tip_node, highest_block_number);
+  for (auto it = slice.rbegin(); it != slice.rend(); ++it, node = node->parent)
+  {
+    assert(node != nullptr);
+    *it = *node->hash;
+  }
+
+  return slice;
+}
+
+/**
+ * Get the number of blocks present in the index
+ *
+ * @return The number of blocks
+ */
+std::size_t BlockAncestryIndex::size() const
+{
+  FETCH_LOCK(lock_);
+  return nodes_.size();
+}
+
+BlockAncestryIndex::Node const *BlockAncestryIndex::Find(BlockHash const &hash) const
+{
+  if (!InlineDigest::Fits(hash))
+  {
+    return nullptr;
+  }
+
+  auto const it = nodes_.find(hash);
+  return (it == nodes_.end()) ? nullptr : &it->second;
+}
+
+/**
+ * Internal: Walk down to the ancestor of a node at a given block number, taking a skip pointer
+ * whenever it does not overshoot the target.
+ */
+BlockAncestryIndex::Node const *BlockAncestryIndex::Ancestor(Node const *node,
+                                                             uint64_t    block_number) const
+{
+  if ((node == nullptr) || (block_number > node->block_number) ||
+      (block_number < lowest_block_number_))
+  {
+    return nullptr;
+  }
+
+  while (node->block_number > block_number)
+  {
+    uint64_t const skip_number = SkipBlockNumber(node->block_number);
+    uint64_t const next_number = SkipBlockNumber(node->block_number - 1u);
+
+    // only take the skip if the parent's skip would not get us strictly closer to the target
+    bool const take_skip =
+        (node->skip != nullptr) &&
+        ((skip_number == block_number) ||
+         ((skip_number > block_number) &&
+          !((next_number + 2u < skip_number) && (next_number >= block_number))));
+
+    node = take_skip ? node->skip : node->parent;
+    assert(node != nullptr);
+  }
+
+  return node;
+}
+
+/**
+ * Internal: Find the common ancestor of two nodes. Once both sides are at the same height their
+ * skip pointers lead to the same block numbers, so whenever the skip targets differ the fork must
+ * lie below them and both sides can jump together.
+ */
+BlockAncestryIndex::Node const *BlockAncestryIndex::CommonAncestor(Node const *left,
+                                                                   Node const *right) const
+{
+  if ((left == nullptr) || (right == nullptr))
+  {
+    return nullptr;
+  }
+
+  // branches which only join below the pruned height have no common ancestor in the index
+  if (Ancestor(left, lowest_block_number_) != Ancestor(right, lowest_block_number_))
+  {
+    return nullptr;
+  }
+
+  if (left->block_number > right->block_number)
+  {
+    left = Ancestor(left, right->block_number);
+  }
+  else if (right->block_number > left->block_number)
+  {
+    right = Ancestor(right, left->block_number);
+  }
+
+  while (left != right)
+  {
+    assert(left->block_number == right->block_number);
+
+    if (left->skip != right->skip)
+    {
+      left  = left->skip;
+      right = right->skip;
+    }
+    else
+    {
+      left  = left->parent;
+      right = right->parent;
+    }
+  }
+
+  return left;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -90,6 +90,7 @@ MainChain::MainChain(Mode mode, bool dirty_block_functionality)
 
   // add the block to the cache
   AddBlockToCache(genesis);
+  ancestry_.Add(genesis->hash, genesis->previous_hash, genesis->block_number);
 
   // add the tip for this block
   AddTip(genesis);
@@ -112,6 +113,7 @@ void MainChain::Reset()
   loose_blocks_.clear();
   block_chain_.clear();
   forward_references_.clear();
+  ancestry_.Clear();
 
   if (block_store_)
   {
@@ -128,6 +130,7 @@ void MainChain::Reset()
 
   // add the block to the cache
   AddBlockToCache(genesis);
+  ancestry_.Add(genesis->hash, genesis->previous_hash, genesis->block_number);
 
   // add the tip for this block
   AddTip(genesis);
@@ -449,6 +452,9 @@ BlockPtr MainChain::GetHeaviestBlock() const
  */
 bool MainChain::RemoveTree(BlockHash const &removed_hash, BlockHashSet &invalidated_blocks)
 {
+  // the index knows the whole progeny, including blocks which are no longer cached
+  ancestry_.Remove(removed_hash);
+
   // check if the block is actually found in this chain
   BlockPtr root;
   bool     retVal{LookupBlock(removed_hash, root)};
@@ -700,6 +706,31 @@ MainChain::Travelogue MainChain::TimeTravel(BlockHash current_hash, std::size_t
   // cache the heaviest block
   auto const heaviest = GetHeaviestBlock();
 
+  std::size_t const output_limit = std::min(limit, std::size_t{UPPER_BOUND});
+
+  // On the heaviest branch the blocks ahead are known from the ancestry index, so there is no need
+  // to resolve forward references one block at a time
+  uint64_t block_number{0};
+  if (!current_hash.empty() && ancestry_.IsAncestor(current_hash, heaviest->hash) &&
+      ancestry_.GetBlockNumber(current_hash, block_number))
+  {
+    for (auto const &hash : ancestry_.GetChainSlice(heaviest->hash, block_number + 1, output_limit))
+    {
+      auto block = LookupBlock(hash);
+      if (!block)
+      {
+        FETCH_LOG_ERROR(LOGGING_NAME, "Block lookup failure during TT, for block: 0x", ToHex(hash));
+
+        return {heaviest->hash, heaviest->block_number};
+      }
+
+      result.push_back(std::move(block));
+    }
+
+    return {heaviest->hash, heaviest->block_number, TravelogueStatus::HEAVIEST_BRANCH,
+            std::move(result)};
+  }
+
   BlockPtr block;
   if (current_hash.empty())
   {
@@ -721,8 +752,6 @@ MainChain::Travelogue MainChain::TimeTravel(BlockHash current_hash, std::size_t
   // We have the block we want to sync forward from. Check if it is on the heaviest chain.
   bool const on_heaviest_branch = (block && (block->chain_label == heaviest_.ChainLabel()));
 
-  std::size_t const output_limit = std::min(limit, std::size_t{UPPER_BOUND});
-
   bool not_done = true;
   for (current_hash = std::move(next_hash);
        // stop once we have gathered enough blocks or passed the tip
@@ -780,13 +809,52 @@ bool MainChain::GetPathToCommonAncestor(Blocks &blocks, BlockHash tip_hash, Bloc
   limit = std::min(limit, uint64_t{MainChain::UPPER_BOUND});
   MilliTimer myTimer("MainChain::GetPathToCommonAncestor", 500);
 
+  // clear the output structure
+  blocks.clear();
+
+  // When both blocks are indexed the fork point is found without the chain lock, and only the
+  // blocks which are actually returned need to be looked up
+  uint64_t   tip_number{0};
+  uint64_t   common_number{0};
+  auto const common_hash = ancestry_.GetCommonAncestor(tip_hash, node_hash);
+  if (!common_hash.empty() && ancestry_.GetBlockNumber(tip_hash, tip_number) &&
+      ancestry_.GetBlockNumber(common_hash, common_number))
+  {
+    uint64_t  count = std::min(limit, tip_number - common_number + 1);
+    BlockHash start_hash{tip_hash};
+
+    switch (behaviour)
+    {
+    case BehaviourWhenLimit::RETURN_LEAST_RECENT:
+      if (count == 0)
+      {
+        return true;
+      }
+      start_hash = ancestry_.GetAncestor(tip_hash, common_number + count - 1);
+      break;
+    case BehaviourWhenLimit::RETURN_MOST_RECENT:
+      // the tip itself is always returned
+      count = std::max(count, uint64_t{1});
+      break;
+    }
+
+    if (!start_hash.empty())
+    {
+      blocks = GetChainPreceding(start_hash, count);
+      if (blocks.size() == count)
+      {
+        return true;
+      }
+    }
+
+    // the index changed underneath us, fall back to walking the chain
+    blocks.clear();
+  }
+
   FETCH_LOCK(lock_);
 
   bool success{true};
 
-  // clear the output structure
-  blocks.clear();
-
   BlockPtr left, right;
 
   BlockHash left_hash  = std::move(tip_hash);
@@ -879,6 +947,17 @@ bool MainChain::GetPathToCommonAncestor(Blocks &blocks, BlockHash tip_hash, Bloc
   return success;
 }
 
+/**
+ * Get the index over the ancestry of the connected blocks which have not been trimmed. It has its
+ * own lock, so it can be queried without synchronising with the rest of the chain.
+ *
+ * @return The ancestry index
+ */
+BlockAncestryIndex const &MainChain::GetAncestryIndex() const
+{
+  return ancestry_;
+}
+
 /**
  * Retrieve a block with a specific hash
  *
@@ -1057,6 +1136,9 @@ void MainChain::RecoverFromFile(Mode mode)
     // Copy head block so as to walk down the chain
     BlockPtr next = std::make_shared<Block>(*head);
 
+    // remember the ancestry seen along the way, so that it can be indexed from genesis upwards
+    BlockHashes ancestry{head->hash};
+
     while (LoadBlock(next->previous_hash, *next))
     {
       if (next->block_number != block_index - 1)
@@ -1068,6 +1150,7 @@ void MainChain::RecoverFromFile(Mode mode)
       }
 
       block_index = next->block_number;
+      ancestry.push_back(next->hash);
     }
 
     if (block_index != 0)
@@ -1081,6 +1164,14 @@ void MainChain::RecoverFromFile(Mode mode)
       FETCH_LOG_INFO(LOGGING_NAME,
                      "Recovering main chain with heaviest block: ", head->block_number);
 
+      // index the recovered chain, the hashes were collected from head down to genesis
+      for (std::size_t i = ancestry.size(); i > 0; --i)
+      {
+        uint64_t const   block_number  = ancestry.size() - i;
+        BlockHash const &previous_hash = (block_number == 0) ? chain::ZERO_HASH : ancestry[i];
+        ancestry_.Add(ancestry[i - 1], previous_hash, block_number);
+      }
+
       // Add heaviest to cache
       CacheBlock(head);
 
@@ -1276,6 +1367,10 @@ void MainChain::TrimCache()
         ++chain_it;
       }
     }
+
+    // The ancestry index is trimmed along with the cache so that it does not grow forever either.
+    // Queries about older blocks fall back to walking the stored chain
+    ancestry_.Prune(trim_threshold + 1);
   }
 
   // Debug and sanity check
@@ -1469,7 +1564,8 @@ BlockStatus MainChain::InsertBlock(BlockPtr const &block, bool evaluate_loose_bl
     return BlockStatus::INVALID;
   }
 
-  if (block->hash == block->previous_hash)
+  if ((block->hash == block->previous_hash) || !InlineDigest::Fits(block->hash) ||
+      !InlineDigest::Fits(block->previous_hash))
   {
     FETCH_LOG_WARN(LOGGING_NAME, "Block discard due to invalid digests");
     return BlockStatus::INVALID;
@@ -1570,6 +1666,7 @@ BlockStatus MainChain::InsertBlock(BlockPtr const &block, bool evaluate_loose_bl
   // Add block
   FETCH_LOG_DEBUG(LOGGING_NAME, "Adding block to chain: 0x", block->hash.ToHex());
   AddBlockToCache(block);
+  ancestry_.Add(block->hash, block->previous_hash, block->block_number);
 
   // If the heaviest branch has been updated we should determine if any blocks should be flushed
   // to disk
@@ -1639,6 +1736,12 @@ bool MainChain::LookupBlockFromCache(BlockHash const &hash, BlockPtr &block) con
 {
   FETCH_LOCK(lock_);
 
+  // digests which are too large to be stored inline are never cached
+  if (!InlineDigest::Fits(hash))
+  {
+    return false;
+  }
+
   // perform the lookup
   auto const it = block_chain_.find(hash);
   if ((block_chain_.end() != it))
@@ -1691,7 +1794,7 @@ bool MainChain::LookupBlockFromStorage(BlockHash const &hash, BlockPtr &block,
  */
 bool MainChain::IsBlockInCache(BlockHash const &hash) const
 {
-  return block_chain_.find(hash) != block_chain_.end();
+  return InlineDigest::Fits(hash) && (block_chain_.find(hash) != block_chain_.end());
 }
 
 /**
@@ -1990,6 +2093,19 @@ void MainChain::SetHeadHash(BlockHash const &hash)
  */
 DigestSet MainChain::DetectDuplicateTransactions(BlockHash const &           starting_hash,
                                                  TransactionLayoutSet const &transactions) const
+{
+  return DetectDuplicates(starting_hash, transactions);
+}
+
+DigestSet MainChain::DetectDuplicateTransactions(BlockHash const &            starting_hash,
+                                                 TransactionLayoutRefs const &transactions) const
+{
+  return DetectDuplicates(starting_hash, transactions);
+}
+
+template <typename Layouts>
+DigestSet MainChain::DetectDuplicates(BlockHash const &starting_hash,
+                                      Layouts const &  transactions) const
 {
   MilliTimer const timer{"DuplicateTransactionsCheck", 100};
 
@@ -2005,7 +2121,7 @@ DigestSet MainChain::DetectDuplicateTransactions(BlockHash const &           sta
   }
 
   DigestSet potential_duplicates{};
-  for (auto const &tx_layout : transactions)
+  for (chain::TransactionLayout const &tx_layout : transactions)
   {
     std::pair<bool, std::size_t> const result =
         bloom_filter_.Match(tx_layout.digest(), tx_layout.valid_until());
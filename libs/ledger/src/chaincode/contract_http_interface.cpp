@@ -22,6 +22,7 @@
 #include "core/serializers/main_serializer.hpp"
 #include "http/json_response.hpp"
 #include "json/document.hpp"
+#include "json/reader.hpp"
 #include "ledger/chaincode/chain_code_factory.hpp"
 #include "ledger/chaincode/contract.hpp"
 #include "ledger/chaincode/contract_context.hpp"
@@ -84,12 +85,12 @@ std::string GenerateTimestamp()
   return {buffer};
 }
 
-bool CreateTxFromJson(Variant const &tx_obj, std::vector<ConstByteArray> &txs,
-                      TransactionProcessor &processor)
+bool CreateTxFromJson(ConstByteArray const &version, ConstByteArray const &data,
+                      std::vector<ConstByteArray> &txs, TransactionProcessor &processor)
 {
   auto tx = std::make_shared<chain::Transaction>();
 
-  if (chain::FromJsonTransaction(tx_obj, *tx))
+  if (chain::FromJsonTransaction(version, data, *tx))
   {
     if (tx->charge_limit() > chain::Transaction::MAXIMUM_TX_CHARGE_LIMIT)
     {
@@ -127,6 +128,192 @@ bool CreateTxFromBuffer(ConstByteArray const &encoded_tx, std::vector<ConstByteA
   return false;
 }
 
+/**
+ * Collects the transactions of a JSON request as it is parsed.
+ *
+ * The request is either a single transaction object or an array of them. Only the "ver" and
+ * "data" fields of each transaction object are of interest, so they are picked out of the parse
+ * events directly rather than from a Variant built for the whole document.
+ */
+class JsonTxCollector : public json::JSONHandler
+{
+public:
+  struct JsonTx
+  {
+    ConstByteArray version;
+    ConstByteArray data;
+  };
+
+  using JsonTxs = std::vector<JsonTx>;
+
+  JsonTxCollector()                        = default;
+  JsonTxCollector(JsonTxCollector const &) = delete;
+  JsonTxCollector(JsonTxCollector &&)      = delete;
+  ~JsonTxCollector() override              = default;
+
+  JsonTxCollector &operator=(JsonTxCollector const &) = delete;
+  JsonTxCollector &operator=(JsonTxCollector &&) = delete;
+
+  /// The transaction objects found in the request
+  JsonTxs const &txs() const
+  {
+    return txs_;
+  }
+
+  /// The number of elements in the request, including those which are not objects
+  std::size_t received() const
+  {
+    return received_;
+  }
+
+  bool OnNull() override
+  {
+    OnValue();
+    return true;
+  }
+
+  bool OnBool(bool /*value*/) override
+  {
+    OnValue();
+    return true;
+  }
+
+  bool OnInteger(int64_t /*value*/) override
+  {
+    OnValue();
+    return true;
+  }
+
+  bool OnFloat(double /*value*/) override
+  {
+    OnValue();
+    return true;
+  }
+
+  bool OnString(ConstByteArray const &value) override
+  {
+    OnValue();
+
+    if (depth_ == tx_depth_)
+    {
+      if (field_ == Field::VERSION)
+      {
+        txs_.back().version = value;
+      }
+      else if (field_ == Field::DATA)
+      {
+        txs_.back().data = value;
+      }
+    }
+
+    return true;
+  }
+
+  bool OnKey(ConstByteArray const &key) override
+  {
+    if (depth_ == tx_depth_)
+    {
+      if (key == "ver")
+      {
+        field_ = Field::VERSION;
+      }
+      else if (key == "data")
+      {
+        field_ = Field::DATA;
+      }
+      else
+      {
+        field_ = Field::OTHER;
+      }
+    }
+
+    return true;
+  }
+
+  bool OnStartObject() override
+  {
+    OnValue();
+    ++depth_;
+
+    if (depth_ == tx_depth_)
+    {
+      txs_.emplace_back();
+      field_ = Field::OTHER;
+    }
+
+    return true;
+  }
+
+  bool OnEndObject() override
+  {
+    if (depth_ == tx_depth_)
+    {
+      // so that the values of arrays at the same depth are not taken as fields
+      field_ = Field::OTHER;
+    }
+
+    --depth_;
+    return true;
+  }
+
+  bool OnStartArray() override
+  {
+    if (depth_ == 0)
+    {
+      // the request is a list of transactions
+      tx_depth_ = 2;
+    }
+
+    OnValue();
+    ++depth_;
+
+    return true;
+  }
+
+  bool OnEndArray() override
+  {
+    --depth_;
+    return true;
+  }
+
+private:
+  enum class Field
+  {
+    OTHER,
+    VERSION,
+    DATA
+  };
+
+  /// Called at the start of every value in the document, before it is entered
+  void OnValue()
+  {
+    // count every element of the top level, whether or not it can be a transaction
+    if ((depth_ + 1) == tx_depth_)
+    {
+      ++received_;
+    }
+
+    // a value which is not a string invalidates the field it is assigned to
+    if (depth_ == tx_depth_)
+    {
+      if (field_ == Field::VERSION)
+      {
+        txs_.back().version = ConstByteArray{};
+      }
+      else if (field_ == Field::DATA)
+      {
+        txs_.back().data = ConstByteArray{};
+      }
+    }
+  }
+
+  JsonTxs     txs_{};
+  std::size_t depth_{0};
+  std::size_t tx_depth_{1};
+  Field       field_{Field::OTHER};
+  std::size_t received_{0};
+};
+
 constexpr char const *LOGGING_NAME = "ContractHttpInterface";
 
 }  // namespace
@@ -379,32 +566,17 @@ http::HTTPResponse ContractHttpInterface::OnTransaction(http::HTTPRequest const
 ContractHttpInterface::SubmitTxStatus ContractHttpInterface::SubmitJsonTx(
     http::HTTPRequest const &request, TxHashes &txs)
 {
-  std::size_t submitted{0};
-  std::size_t expected_count{0};
-
-  // parse the JSON request
-  json::JSONDocument doc{request.body()};
-
   FETCH_LOG_DEBUG(LOGGING_NAME, "NEW TRANSACTION RECEIVED");
   FETCH_LOG_DEBUG(LOGGING_NAME, request.body());
 
-  if (doc.root().IsArray())
-  {
-    expected_count = doc.root().size();
-    for (std::size_t i = 0, end = doc.root().size(); i < end; ++i)
-    {
-      auto const success = CreateTxFromJson(doc[i], txs, processor_);
-      if (success)
-      {
-        ++submitted;
-      }
-    }
-  }
-  else
-  {
-    expected_count = 1;
+  // parse the JSON request
+  JsonTxCollector collector{};
+  json::JSONReader{request.body()}.Parse(collector);
 
-    auto const success = CreateTxFromJson(doc.root(), txs, processor_);
+  std::size_t submitted{0};
+  for (auto const &tx : collector.txs())
+  {
+    auto const success = CreateTxFromJson(tx.version, tx.data, txs, processor_);
     if (success)
     {
       ++submitted;
@@ -414,7 +586,7 @@ ContractHttpInterface::SubmitTxStatus ContractHttpInterface::SubmitJsonTx(
   FETCH_LOG_DEBUG(LOGGING_NAME, "Submitted ", submitted, " transactions from ",
                   request.originating_address(), ':', request.originating_port());
 
-  return SubmitTxStatus{submitted, expected_count};
+  return SubmitTxStatus{submitted, collector.received()};
 }
 
 ContractHttpInterface::SubmitTxStatus ContractHttpInterface::SubmitBulkTx(
@@ -0,0 +1,299 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "ledger/miner/mining_pool.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+bool MiningPool::PackingOrder::operator()(Entry const *a, Entry const *b) const
+{
+  auto const a_charge_rate = a->layout.charge_rate();
+  auto const b_charge_rate = b->layout.charge_rate();
+
+  if (a_charge_rate != b_charge_rate)
+  {
+    return a_charge_rate > b_charge_rate;
+  }
+
+  return a->sequence < b->sequence;
+}
+
+/**
+ * Construct an empty mining pool
+ *
+ * @param log2_num_lanes Log2 of the number of lanes of the blocks to be packed
+ */
+MiningPool::MiningPool(uint32_t log2_num_lanes)
+  : num_lanes_{1u << log2_num_lanes}
+  , buckets_(num_lanes_ + 1u)
+{}
+
+std::size_t MiningPool::size() const
+{
+  return entries_.size();
+}
+
+bool MiningPool::empty() const
+{
+  return entries_.empty();
+}
+
+bool MiningPool::Has(Digest const &digest) const
+{
+  if (!InlineDigest::Fits(digest))
+  {
+    return false;
+  }
+
+  return entries_.find(digest) != entries_.end();
+}
+
+/**
+ * Get references to all of the transaction layouts in the pool (in no particular order)
+ *
+ * @return The transaction layouts
+ */
+MiningPool::TransactionLayoutRefs MiningPool::TxLayouts() const
+{
+  TransactionLayoutRefs layouts{};
+  layouts.reserve(entries_.size());
+
+  for (auto const &element : entries_)
+  {
+    layouts.emplace_back(element.second.layout);
+  }
+
+  return layouts;
+}
+
+/**
+ * Add a transaction layout to the pool
+ *
+ * @param layout The transaction layout to be added
+ * @return true if successful, false if the transaction is already present or its mask does not
+ * match the number of lanes
+ */
+bool MiningPool::Add(TransactionLayout const &layout)
+{
+  auto const &mask = layout.mask();
+  if (mask.size() != num_lanes_)
+  {
+    return false;
+  }
+
+  auto const result = entries_.emplace(layout.digest(), Entry{layout, next_sequence_, {}});
+  if (!result.second)
+  {
+    return false;
+  }
+
+  ++next_sequence_;
+
+  Entry &entry = result.first->second;
+  for (uint32_t lane = 0; lane < num_lanes_; ++lane)
+  {
+    if (mask.bit(lane) != 0u)
+    {
+      entry.lanes.push_back(lane);
+    }
+  }
+
+  Index(entry);
+
+  return true;
+}
+
+/**
+ * Move the contents of the specified queue into the pool, in order
+ *
+ * After the operation the input queue will be empty
+ *
+ * @param queue The queue to be moved into the pool
+ */
+void MiningPool::Splice(TransactionLayoutQueue &queue)
+{
+  for (auto const &layout : queue)
+  {
+    Add(layout);
+  }
+
+  queue.Erase(queue.cbegin(), queue.cend());
+}
+
+/**
+ * Remove a transaction specified by a digest
+ *
+ * @param digest The digest of the transaction to be removed
+ * @return true if successful, otherwise false
+ */
+bool MiningPool::Remove(Digest const &digest)
+{
+  if (!InlineDigest::Fits(digest))
+  {
+    return false;
+  }
+
+  auto it = entries_.find(digest);
+  if (it == entries_.end())
+  {
+    return false;
+  }
+
+  Erase(it);
+
+  return true;
+}
+
+/**
+ * Remove a set of transactions from the pool
+ *
+ * @param digests The set of the transaction digests to be removed
+ * @return The number of transactions removed from the pool
+ */
+std::size_t MiningPool::Remove(DigestSet const &digests)
+{
+  std::size_t count{0};
+
+  for (auto const &digest : digests)
+  {
+    if (Remove(digest))
+    {
+      ++count;
+    }
+  }
+
+  return count;
+}
+
+/**
+ * Greedily pack a slice with the transactions in the pool, removing them from it
+ *
+ * Transactions are considered in packing order, and each one which does not use any of the lanes
+ * already used in the slice is added to it. Transactions which collide with the slice can never
+ * fit into it afterwards, so the buckets of the free lanes are each scanned at most once and the
+ * buckets of the used lanes are not visited at all.
+ *
+ * @param slice The slice to be populated
+ */
+void MiningPool::PackSlice(Block::Slice &slice)
+{
+  using Cursor = Bucket::iterator;
+
+  BitVector           used{num_lanes_};
+  std::vector<Cursor> cursors{};
+  cursors.reserve(buckets_.size());
+  for (auto &bucket : buckets_)
+  {
+    cursors.emplace_back(bucket.begin());
+  }
+
+  auto const collides = [&used](Entry const *entry) {
+    return entry->layout.mask().Intersects(used);
+  };
+
+  std::size_t free_lanes = num_lanes_;
+  while (free_lanes > 0)
+  {
+    // find the best transaction which fits in the slice, out of the heads of the free buckets
+    Entry *best{nullptr};
+    for (std::size_t index = 0; index < buckets_.size(); ++index)
+    {
+      if ((index < num_lanes_) && (used.bit(index) != 0u))
+      {
+        continue;
+      }
+
+      auto &cursor = cursors[index];
+      auto  end    = buckets_[index].end();
+      while ((cursor != end) && collides(*cursor))
+      {
+        ++cursor;
+      }
+
+      if ((cursor != end) && ((best == nullptr) || PackingOrder{}(*cursor, best)))
+      {
+        best = *cursor;
+      }
+    }
+
+    if (best == nullptr)
+    {
+      break;
+    }
+
+    slice.push_back(best->layout);
+
+    free_lanes -= best->layout.mask().OrInto(used);
+
+    // the buckets of the lanes used by the transaction are not visited again, but the bucket of
+    // transactions which use no lanes is, so its cursor must be moved past the transaction first
+    if (best->lanes.empty())
+    {
+      ++cursors.back();
+    }
+
+    Erase(entries_.find(best->layout.digest()));
+  }
+}
+
+void MiningPool::Index(Entry &entry)
+{
+  if (entry.lanes.empty())
+  {
+    buckets_.back().insert(&entry);
+    return;
+  }
+
+  for (auto const lane : entry.lanes)
+  {
+    buckets_[lane].insert(&entry);
+  }
+}
+
+void MiningPool::Unindex(Entry &entry)
+{
+  if (entry.lanes.empty())
+  {
+    buckets_.back().erase(&entry);
+    return;
+  }
+
+  for (auto const lane : entry.lanes)
+  {
+    buckets_[lane].erase(&entry);
+  }
+}
+
+MiningPool::Entries::iterator MiningPool::Erase(Entries::iterator it)
+{
+  assert(it != entries_.end());
+
+  Unindex(it->second);
+  return entries_.erase(it);
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -103,31 +103,21 @@ TransactionArchiver::State TransactionArchiver::OnCollecting()
 
 TransactionArchiver::State TransactionArchiver::OnFlushing()
 {
-  // check if we need to transition from this state
-  if (digests_.empty())
-  {
-    return State::COLLECTING;
-  }
+  // lookup the confirmed transactions in the pool
+  TxArray txs{};
+  txs.reserve(digests_.size());
 
-  // flush a transaction to the archive
+  for (auto const &current : digests_)
   {
-    auto const &current = digests_.back();
-
     chain::Transaction tx{};
-    if (archive_.Has(current))
+    if (pool_.Get(current, tx))
     {
-      // no op
-      duplicate_total_->increment();
+      txs.emplace_back(std::move(tx));
     }
-    else if (pool_.Get(current, tx))
+    else if (archive_.Has(current))
     {
-      // add the transaction to the store
-      archive_.Add(tx);
-
-      // remove the transaction from the pool
-      pool_.Remove(current);
-
-      additions_total_->increment();
+      // no op
+      duplicate_total_->increment();
     }
     else
     {
@@ -137,12 +127,22 @@ TransactionArchiver::State TransactionArchiver::OnFlushing()
     }
   }
 
-  // remove the current element
-  digests_.pop_back();
+  // flush the transactions to the archive as a single batch
+  std::size_t const added = txs.empty() ? 0 : archive_.AddBatch(txs);
 
-  processed_total_->increment();
+  // remove the transactions from the pool
+  for (auto const &tx : txs)
+  {
+    pool_.Remove(tx.digest());
+  }
 
-  return State::FLUSHING;
+  additions_total_->add(added);
+  duplicate_total_->add(txs.size() - added);
+  processed_total_->add(digests_.size());
+
+  digests_.clear();
+
+  return State::COLLECTING;
 }
 
 telemetry::CounterPtr TransactionArchiver::CreateCounter(char const *name,
@@ -35,7 +35,7 @@ void TxFinderProtocol::IssueCallForMissingTxs(DigestSet const &digests)
 {
   for (auto const &digest : digests)
   {
-    resource_queue_.Push(digest);
+    resource_queue_.Push(digest.ToConstByteArray());
   }
 }
 
@@ -0,0 +1,777 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_serializer.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "crypto/fnv_detail.hpp"
+#include "ledger/storage_unit/transaction_log_store.hpp"
+#include "logging/logging.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+constexpr char const *LOGGING_NAME = "TransactionLogStore";
+
+using Checksum = crypto::detail::FNV<crypto::detail::FNVConfig<uint32_t>>;
+using TxArray  = TransactionLogStore::TxArray;
+
+constexpr uint32_t SEGMENT_MAGIC       = 0x4c585446;  // "FTXL"
+constexpr uint32_t MANIFEST_MAGIC      = 0x4d585446;  // "FTXM"
+constexpr uint32_t FORMAT_VERSION      = 1;
+constexpr uint64_t SEGMENT_HEADER_SIZE = 2 * sizeof(uint32_t);
+constexpr uint64_t DIGEST_SIZE         = InlineDigest::CAPACITY;
+constexpr uint64_t RECORD_HEADER_SIZE  = (2 * sizeof(uint32_t)) + DIGEST_SIZE;
+
+uint8_t ReverseBits(uint8_t value)
+{
+  value = static_cast<uint8_t>(((value & 0xF0u) >> 4u) | ((value & 0x0Fu) << 4u));
+  value = static_cast<uint8_t>(((value & 0xCCu) >> 2u) | ((value & 0x33u) << 2u));
+  value = static_cast<uint8_t>(((value & 0xAAu) >> 1u) | ((value & 0x55u) << 1u));
+  return value;
+}
+
+template <typename T>
+void AppendValue(std::vector<uint8_t> &buffer, T const &value)
+{
+  auto const *raw = reinterpret_cast<uint8_t const *>(&value);
+  buffer.insert(buffer.end(), raw, raw + sizeof(T));
+}
+
+template <typename T>
+T ReadValue(uint8_t const *data)
+{
+  T value{};
+  std::memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+uint32_t CalculateChecksum(uint8_t const *digest, uint8_t const *encoded, std::size_t size)
+{
+  Checksum checksum{};
+  checksum.update(digest, DIGEST_SIZE);
+  checksum.update(encoded, size);
+  return checksum.context();
+}
+
+bool FileExists(std::string const &filename)
+{
+  return std::ifstream{filename}.good();
+}
+
+/**
+ * Determine if the first bit_count bits (least significant first from each byte) of the digest
+ * match those of the partial digest
+ */
+bool MatchesSubtree(InlineDigest const &digest, InlineDigest const &partial, uint64_t bit_count)
+{
+  uint64_t const full_bytes = bit_count / 8u;
+  uint64_t const rem_bits   = bit_count % 8u;
+
+  if (std::memcmp(digest.pointer(), partial.pointer(), full_bytes) != 0)
+  {
+    return false;
+  }
+
+  if (rem_bits == 0)
+  {
+    return true;
+  }
+
+  auto const mask = static_cast<uint8_t>((1u << rem_bits) - 1u);
+  return ((digest.pointer()[full_bytes] ^ partial.pointer()[full_bytes]) & mask) == 0;
+}
+
+}  // namespace
+
+bool TransactionLogStore::SubtreeOrder::operator()(InlineDigest const &a,
+                                                   InlineDigest const &b) const
+{
+  std::size_t const length = std::min(a.size(), b.size());
+
+  for (std::size_t i = 0; i < length; ++i)
+  {
+    if (a.pointer()[i] != b.pointer()[i])
+    {
+      return ReverseBits(a.pointer()[i]) < ReverseBits(b.pointer()[i]);
+    }
+  }
+
+  return a.size() < b.size();
+}
+
+TransactionLogStore::TransactionLogStore(Config const &config)
+  : config_{config}
+{}
+
+/**
+ * Create a new, empty, log replacing any existing one with the same prefix
+ *
+ * @param prefix The prefix of the files of the log
+ */
+void TransactionLogStore::New(std::string const &prefix)
+{
+  FETCH_LOCK(lock_);
+
+  Reset();
+  prefix_ = prefix;
+
+  // remove the segments of any previous log
+  std::ifstream manifest{prefix_ + ".manifest", std::ios::binary};
+  uint64_t      id = 0;
+  if (manifest)
+  {
+    uint32_t header[2] = {0, 0};
+    manifest.read(reinterpret_cast<char *>(header), sizeof(header));
+    manifest.read(reinterpret_cast<char *>(&id), sizeof(id));
+  }
+
+  while (std::remove(SegmentFilename(id).c_str()) == 0)
+  {
+    ++id;
+  }
+
+  active_id_ = 0;
+  OpenSegment(active_id_, true);
+  WriteManifest();
+
+  is_open_ = true;
+}
+
+/**
+ * Load an existing log, rebuilding the digest index from its segments
+ *
+ * @param prefix The prefix of the files of the log
+ * @param create Flag to signal if the log should be created if it doesn't exist
+ */
+void TransactionLogStore::Load(std::string const &prefix, bool create)
+{
+  std::ifstream manifest{prefix + ".manifest", std::ios::binary};
+  if (!manifest)
+  {
+    if (!create)
+    {
+      throw std::runtime_error("Unable to find transaction log: " + prefix);
+    }
+
+    New(prefix);
+    return;
+  }
+
+  uint32_t header[2] = {0, 0};
+  uint64_t first_id  = 0;
+  manifest.read(reinterpret_cast<char *>(header), sizeof(header));
+  manifest.read(reinterpret_cast<char *>(&first_id), sizeof(first_id));
+
+  if (!manifest || (header[0] != MANIFEST_MAGIC) || (header[1] != FORMAT_VERSION))
+  {
+    throw std::runtime_error("Invalid transaction log manifest: " + prefix);
+  }
+
+  FETCH_LOCK(lock_);
+
+  Reset();
+  prefix_ = prefix;
+
+  // the retained segments are consecutive from the first one in the manifest
+  uint64_t last_id = first_id;
+  while (FileExists(SegmentFilename(last_id)))
+  {
+    ++last_id;
+  }
+
+  if (last_id == first_id)
+  {
+    OpenSegment(first_id, true);
+  }
+  else
+  {
+    for (uint64_t id = first_id; id < last_id; ++id)
+    {
+      ScanSegment(id, id + 1 == last_id);
+    }
+  }
+
+  is_open_ = true;
+
+  FETCH_LOG_INFO(LOGGING_NAME, "Loaded ", index_.size(), " transactions from ", segments_.size(),
+                 " segments");
+}
+
+/**
+ * Add a transaction to the log
+ *
+ * @param tx The transaction to set added to storage
+ */
+void TransactionLogStore::Add(chain::Transaction const &tx)
+{
+  AddBatch(TxArray{tx});
+}
+
+/**
+ * Add a batch of transactions to the log with a single write to the active segment (or one per
+ * segment, should the batch cross a segment boundary). Received transactions are written using
+ * their original wire bytes.
+ *
+ * @param txs The transactions to be added to storage
+ * @return The number of transactions which were added
+ */
+std::size_t TransactionLogStore::AddBatch(TxArray const &txs)
+{
+  FETCH_LOCK(lock_);
+
+  if (!is_open_)
+  {
+    throw std::runtime_error("Transaction log has not been opened");
+  }
+
+  std::vector<InlineDigest> pending{};
+  Buffer                    buffer{};
+  uint64_t                  segment_size = segments_.at(active_id_).size;
+  std::size_t               added{0};
+
+  try
+  {
+    for (auto const &tx : txs)
+    {
+      if (tx.digest().size() != DIGEST_SIZE)
+      {
+        FETCH_LOG_WARN(LOGGING_NAME, "Unable to store tx with invalid digest");
+        continue;
+      }
+
+      if (index_.find(tx.digest()) != index_.end())
+      {
+        continue;
+      }
+
+      // seal the active segment once it is full
+      if (segment_size >= config_.segment_size && segment_size > SEGMENT_HEADER_SIZE)
+      {
+        Write(buffer);
+        buffer.clear();
+        pending.clear();
+
+        SealActiveSegment();
+        segment_size = segments_.at(active_id_).size;
+      }
+
+      ConstByteArray encoded = tx.encoded();
+      if (encoded.empty())
+      {
+        chain::TransactionSerializer serializer{};
+        serializer << tx;
+        encoded = serializer.data();
+      }
+
+      Append(tx.digest(), encoded, buffer);
+
+      Location const location{active_id_, segment_size + RECORD_HEADER_SIZE,
+                              static_cast<uint32_t>(encoded.size())};
+
+      index_.emplace(tx.digest(), location);
+      pending.emplace_back(tx.digest());
+
+      segment_size += RECORD_HEADER_SIZE + encoded.size();
+      ++added;
+    }
+
+    Write(buffer);
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to add batch of ", txs.size(), " txs to log: ", ex.what());
+
+    // forget the transactions which did not make it to the log
+    for (auto const &digest : pending)
+    {
+      index_.erase(digest);
+    }
+
+    added -= pending.size();
+  }
+
+  return added;
+}
+
+/**
+ * Check to see if requested transaction exists
+ *
+ * @param tx_digest The transaction digest to be searched for
+ * @return true if present, otherwise false
+ */
+bool TransactionLogStore::Has(Digest const &tx_digest) const
+{
+  if (!InlineDigest::Fits(tx_digest))
+  {
+    return false;
+  }
+
+  FETCH_LOCK(lock_);
+  return index_.find(tx_digest) != index_.end();
+}
+
+/**
+ * Lookup a transaction from the log
+ *
+ * @param tx_digest The transaction digest to lookup
+ * @param tx The output transaction to be populated
+ * @return true if successful, otherwise false
+ */
+bool TransactionLogStore::Get(Digest const &tx_digest, chain::Transaction &tx) const
+{
+  if (!InlineDigest::Fits(tx_digest))
+  {
+    return false;
+  }
+
+  FETCH_LOCK(lock_);
+
+  auto const it = index_.find(tx_digest);
+  if (it == index_.end())
+  {
+    return false;
+  }
+
+  try
+  {
+    return Read(it->second, tx);
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to get tx: 0x", tx_digest.ToHex(),
+                   " from log: ", ex.what());
+  }
+
+  return false;
+}
+
+/**
+ * Get the total number of transactions in this log
+ *
+ * @return The number of transactions stored
+ */
+uint64_t TransactionLogStore::GetCount() const
+{
+  FETCH_LOCK(lock_);
+  return index_.size();
+}
+
+/**
+ * Pull a sub tree from the log with the given starting prefix for the digest
+ *
+ * @param partial_digest The partial digest for the subtree
+ * @param bit_count The bit count of the partial digest for the subtree
+ * @param pull_limit The maximum number of transactions to be retrieved
+ * @return The extracted subtree of transactions from the log
+ */
+TxArray TransactionLogStore::PullSubtree(Digest const &partial_digest, uint64_t bit_count,
+                                         uint64_t pull_limit)
+{
+  TxArray ret{};
+
+  if (partial_digest.size() != DIGEST_SIZE)
+  {
+    return ret;
+  }
+
+  bit_count = std::min(bit_count, DIGEST_SIZE * 8u);
+
+  // the first key of the subtree has all the bits after the prefix cleared
+  InlineDigest const partial{partial_digest};
+  uint8_t            start[DIGEST_SIZE] = {};
+  std::memcpy(start, partial.pointer(), bit_count / 8u);
+  if (bit_count % 8u != 0)
+  {
+    auto const mask          = static_cast<uint8_t>((1u << (bit_count % 8u)) - 1u);
+    start[bit_count / 8u] = static_cast<uint8_t>(partial.pointer()[bit_count / 8u] & mask);
+  }
+
+  FETCH_LOCK(lock_);
+
+  for (auto it = index_.lower_bound(InlineDigest{start, DIGEST_SIZE});
+       (it != index_.end()) && (ret.size() < pull_limit) &&
+       MatchesSubtree(it->first, partial, bit_count);
+       ++it)
+  {
+    chain::Transaction tx{};
+    if (Read(it->second, tx))
+    {
+      ret.emplace_back(std::move(tx));
+    }
+  }
+
+  return ret;
+}
+
+/**
+ * Get the number of segments currently retained by the log, including the active one
+ *
+ * @return The number of segments
+ */
+uint64_t TransactionLogStore::GetNumSegments() const
+{
+  FETCH_LOCK(lock_);
+  return segments_.size();
+}
+
+/**
+ * Get the total size of the segments retained by the log
+ *
+ * @return The size in bytes
+ */
+uint64_t TransactionLogStore::GetSizeOnDisk() const
+{
+  FETCH_LOCK(lock_);
+
+  uint64_t size{0};
+  for (auto const &segment : segments_)
+  {
+    size += segment.second.size;
+  }
+
+  return size;
+}
+
+void TransactionLogStore::Reset()
+{
+  if (active_file_.is_open())
+  {
+    active_file_.close();
+  }
+
+  segments_.clear();
+  index_.clear();
+  is_open_ = false;
+}
+
+/**
+ * Encode a record for a transaction onto the end of the buffer
+ */
+void TransactionLogStore::Append(Digest const &digest, ConstByteArray const &encoded,
+                                 Buffer &buffer)
+{
+  if (encoded.size() > std::numeric_limits<uint32_t>::max())
+  {
+    throw std::runtime_error("Transaction is too large to be logged");
+  }
+
+  auto const size = static_cast<uint32_t>(encoded.size());
+
+  AppendValue(buffer, size);
+  AppendValue(buffer, CalculateChecksum(digest.pointer(), encoded.pointer(), encoded.size()));
+  buffer.insert(buffer.end(), digest.pointer(), digest.pointer() + DIGEST_SIZE);
+  buffer.insert(buffer.end(), encoded.pointer(), encoded.pointer() + encoded.size());
+}
+
+/**
+ * Append the buffer to the active segment and flush it
+ */
+void TransactionLogStore::Write(Buffer const &buffer)
+{
+  if (buffer.empty())
+  {
+    return;
+  }
+
+  active_file_.write(reinterpret_cast<char const *>(buffer.data()),
+                     static_cast<std::streamsize>(buffer.size()));
+  active_file_.flush();
+
+  if (!active_file_)
+  {
+    RecoverActiveSegment();
+    throw std::runtime_error("Failed to write to transaction log segment");
+  }
+
+  segments_.at(active_id_).size += buffer.size();
+}
+
+/**
+ * Recover from a failed write, which leaves the stream in a failed state and may have written
+ * part of a buffer. The active segment is truncated back to its last complete record and reopened,
+ * or, should that not be possible, sealed so that writing continues in a new segment. A partial
+ * record at the end of a sealed segment is skipped when the log is loaded.
+ */
+void TransactionLogStore::RecoverActiveSegment()
+{
+  auto const filename = SegmentFilename(active_id_);
+  auto const size     = segments_.at(active_id_).size;
+
+  active_file_.close();
+  active_file_.clear();
+
+  if (::truncate(filename.c_str(), static_cast<off_t>(size)) == 0)
+  {
+    OpenSegment(active_id_, false);
+  }
+  else
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to truncate transaction log segment: ", filename,
+                   ", starting a new one");
+
+    SealActiveSegment();
+  }
+}
+
+/**
+ * Open a segment as the active segment, creating it if required
+ */
+void TransactionLogStore::OpenSegment(uint64_t id, bool create)
+{
+  auto const filename = SegmentFilename(id);
+
+  if (create)
+  {
+    std::ofstream file{filename, std::ios::binary | std::ios::trunc};
+    uint32_t const header[2] = {SEGMENT_MAGIC, FORMAT_VERSION};
+    file.write(reinterpret_cast<char const *>(header), sizeof(header));
+  }
+
+  active_file_.open(filename, std::ios::in | std::ios::out | std::ios::binary | std::ios::ate);
+  if (!active_file_)
+  {
+    throw std::runtime_error("Unable to open transaction log segment: " + filename);
+  }
+
+  active_id_ = id;
+
+  auto &segment = segments_[id];
+  segment.size  = static_cast<uint64_t>(active_file_.tellp());
+}
+
+/**
+ * Seal the active segment, start a new one and apply the retention policy
+ */
+void TransactionLogStore::SealActiveSegment()
+{
+  active_file_.close();
+
+  // the active mapping is refreshed on demand, so only the full mapping remains
+  auto &sealed = segments_.at(active_id_);
+  MapSegment(active_id_, sealed);
+
+  OpenSegment(active_id_ + 1, true);
+
+  while ((config_.max_segments != 0) && (segments_.size() > config_.max_segments))
+  {
+    DropOldestSegment();
+  }
+}
+
+/**
+ * Remove the oldest segment from the log, along with the transactions it holds
+ */
+void TransactionLogStore::DropOldestSegment()
+{
+  auto it = segments_.begin();
+
+  uint64_t const id      = it->first;
+  auto &         segment = it->second;
+
+  if (segment.map.size() < segment.size)
+  {
+    MapSegment(id, segment);
+  }
+
+  auto const *data = reinterpret_cast<uint8_t const *>(segment.map.data());
+  for (uint64_t offset = SEGMENT_HEADER_SIZE; offset + RECORD_HEADER_SIZE <= segment.size;)
+  {
+    auto const size = ReadValue<uint32_t>(data + offset);
+
+    auto const record = index_.find(InlineDigest{data + offset + 8u, DIGEST_SIZE});
+    if ((record != index_.end()) && (record->second.segment == id))
+    {
+      index_.erase(record);
+    }
+
+    offset += RECORD_HEADER_SIZE + size;
+  }
+
+  segments_.erase(it);
+  WriteManifest();
+
+  if (std::remove(SegmentFilename(id).c_str()) != 0)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to remove segment: ", SegmentFilename(id));
+  }
+}
+
+/**
+ * Rebuild the index entries of a segment. A partially written record at the end of the last
+ * segment is truncated, and that segment becomes the active one.
+ */
+void TransactionLogStore::ScanSegment(uint64_t id, bool is_last)
+{
+  auto const filename = SegmentFilename(id);
+
+  // a crash can leave the last segment before its header was written
+  std::ifstream file{filename, std::ios::binary | std::ios::ate};
+  if (is_last && (static_cast<uint64_t>(file.tellg()) < SEGMENT_HEADER_SIZE))
+  {
+    OpenSegment(id, true);
+    return;
+  }
+
+  auto &segment = segments_[id];
+  MapSegment(id, segment);
+
+  auto const *data      = reinterpret_cast<uint8_t const *>(segment.map.data());
+  auto const  file_size = static_cast<uint64_t>(segment.map.size());
+
+  bool const valid_header = (file_size >= SEGMENT_HEADER_SIZE) &&
+                            (ReadValue<uint32_t>(data) == SEGMENT_MAGIC) &&
+                            (ReadValue<uint32_t>(data + 4u) == FORMAT_VERSION);
+
+  if (!valid_header)
+  {
+    throw std::runtime_error("Invalid transaction log segment: " + filename);
+  }
+
+  uint64_t offset = SEGMENT_HEADER_SIZE;
+  while (offset + RECORD_HEADER_SIZE <= file_size)
+  {
+    auto const     size     = ReadValue<uint32_t>(data + offset);
+    auto const     checksum = ReadValue<uint32_t>(data + offset + 4u);
+    uint8_t const *digest   = data + offset + 8u;
+    uint8_t const *encoded  = digest + DIGEST_SIZE;
+
+    if ((size == 0) || (offset + RECORD_HEADER_SIZE + size > file_size) ||
+        (checksum != CalculateChecksum(digest, encoded, size)))
+    {
+      break;
+    }
+
+    index_.emplace(InlineDigest{digest, DIGEST_SIZE},
+                   Location{id, offset + RECORD_HEADER_SIZE, size});
+
+    offset += RECORD_HEADER_SIZE + size;
+  }
+
+  segment.size = offset;
+
+  if (offset != file_size)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Discarding ", file_size - offset,
+                   " bytes of incomplete records from: ", filename);
+  }
+
+  if (is_last)
+  {
+    if (offset != file_size)
+    {
+      segment.map.unmap();
+
+      if (::truncate(filename.c_str(), static_cast<off_t>(offset)) != 0)
+      {
+        throw std::runtime_error("Unable to truncate transaction log segment: " + filename);
+      }
+    }
+
+    OpenSegment(id, false);
+  }
+}
+
+/**
+ * (Re)map the whole of a segment for reading
+ */
+void TransactionLogStore::MapSegment(uint64_t id, Segment &segment) const
+{
+  std::error_code error{};
+
+  segment.map.unmap();
+  segment.map.map(SegmentFilename(id), error);
+
+  if (error)
+  {
+    throw std::runtime_error("Unable to map transaction log segment: " + SegmentFilename(id) +
+                             " (" + error.message() + ")");
+  }
+}
+
+/**
+ * Record the oldest retained segment. The manifest is replaced atomically.
+ */
+void TransactionLogStore::WriteManifest() const
+{
+  auto const filename  = prefix_ + ".manifest";
+  auto const temporary = filename + ".tmp";
+
+  uint64_t const first_id  = segments_.empty() ? active_id_ : segments_.begin()->first;
+  uint32_t const header[2] = {MANIFEST_MAGIC, FORMAT_VERSION};
+
+  {
+    std::ofstream file{temporary, std::ios::binary | std::ios::trunc};
+    file.write(reinterpret_cast<char const *>(header), sizeof(header));
+    file.write(reinterpret_cast<char const *>(&first_id), sizeof(first_id));
+
+    if (!file)
+    {
+      throw std::runtime_error("Unable to write transaction log manifest: " + filename);
+    }
+  }
+
+  if (std::rename(temporary.c_str(), filename.c_str()) != 0)
+  {
+    throw std::runtime_error("Unable to replace transaction log manifest: " + filename);
+  }
+}
+
+std::string TransactionLogStore::SegmentFilename(uint64_t id) const
+{
+  std::ostringstream oss;
+  oss << prefix_ << '.' << std::setw(8) << std::setfill('0') << id << ".seg";
+  return oss.str();
+}
+
+/**
+ * Read a transaction from the mapping of its segment
+ */
+bool TransactionLogStore::Read(Location const &location, chain::Transaction &tx) const
+{
+  auto &segment = segments_.at(location.segment);
+
+  // records appended since the active segment was last mapped need a fresh mapping
+  if (location.offset + location.size > segment.map.size())
+  {
+    MapSegment(location.segment, segment);
+  }
+
+  // the transaction owns its buffers, so the wire bytes are copied out of the mapping once
+  byte_array::ByteArray encoded{};
+  encoded.Resize(location.size);
+  std::memcpy(encoded.pointer(), segment.map.data() + location.offset, location.size);
+
+  chain::TransactionSerializer serializer{encoded};
+  return serializer.Deserialize(tx);
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -41,6 +41,11 @@ void TransactionMemoryPool::Add(chain::Transaction const &tx)
  */
 bool TransactionMemoryPool::Has(Digest const &tx_digest) const
 {
+  if (!InlineDigest::Fits(tx_digest))
+  {
+    return false;
+  }
+
   FETCH_LOCK(lock_);
   return transaction_store_.find(tx_digest) != transaction_store_.end();
 }
@@ -56,6 +61,11 @@ bool TransactionMemoryPool::Get(Digest const &tx_digest, chain::Transaction &tx)
 {
   bool success{false};
 
+  if (!InlineDigest::Fits(tx_digest))
+  {
+    return success;
+  }
+
   FETCH_LOCK(lock_);
 
   auto it = transaction_store_.find(tx_digest);
@@ -86,6 +96,11 @@ uint64_t TransactionMemoryPool::GetCount() const
  */
 void TransactionMemoryPool::Remove(Digest const &tx_digest)
 {
+  if (!InlineDigest::Fits(tx_digest))
+  {
+    return;
+  }
+
   FETCH_LOCK(lock_);
   transaction_store_.erase(tx_digest);
 }
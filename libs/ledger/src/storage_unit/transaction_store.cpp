@@ -70,6 +70,47 @@ void TransactionStore::Add(chain::Transaction const &tx)
   }
 }
 
+/**
+ * Add a batch of transactions to the store under a single lock of the archive, flushing it once.
+ * Received transactions are written using their original wire bytes.
+ *
+ * @param txs The transactions to be added to storage
+ * @return The number of transactions which were added
+ */
+std::size_t TransactionStore::AddBatch(TxArray const &txs)
+{
+  Archive::KeyObjectPairs batch{};
+  batch.reserve(txs.size());
+
+  try
+  {
+    archive_.WithLock([this, &txs, &batch]() {
+      DigestSet batched{};
+
+      for (auto const &tx : txs)
+      {
+        auto rid = CreateResourceId(tx.digest());
+
+        if (batched.emplace(tx.digest()).second && !archive_.LocklessHas(rid))
+        {
+          batch.emplace_back(std::move(rid), tx);
+        }
+      }
+
+      archive_.LocklessSetBatch(batch);
+    });
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to add batch of ", txs.size(), " txs to store: ",
+                   ex.what());
+
+    return 0;
+  }
+
+  return batch.size();
+}
+
 /**
  * Check to see if requested transaction exists
  *
@@ -0,0 +1,287 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "ledger/chain/block_ancestry_index.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::ledger::BlockAncestryIndex;
+using fetch::ledger::BlockHash;
+
+constexpr std::size_t NO_PARENT = std::numeric_limits<std::size_t>::max();
+
+BlockHash MakeHash(std::size_t value)
+{
+  ByteArray hash;
+  hash.Resize(32);
+  for (std::size_t i = 0; i < hash.size(); ++i)
+  {
+    hash[i] = static_cast<uint8_t>(value >> ((i % sizeof(value)) * 8u));
+  }
+  hash[31] = 0xAB;
+
+  return hash;
+}
+
+// A forked block tree with the naive answers to compare the index against
+class BlockAncestryIndexTests : public ::testing::Test
+{
+protected:
+  void BuildTree(std::size_t count)
+  {
+    std::mt19937_64 rng{42};
+
+    Append(NO_PARENT);
+    while (parents_.size() < count)
+    {
+      // mostly extend one of the recent blocks, sometimes fork from deep down
+      std::size_t const size  = parents_.size();
+      std::size_t const reach = ((rng() % 16u) == 0) ? size : std::min<std::size_t>(size, 4u);
+      Append(size - 1 - (rng() % reach));
+    }
+  }
+
+  void Append(std::size_t parent)
+  {
+    std::size_t const index = parents_.size();
+
+    parents_.push_back(parent);
+    numbers_.push_back((parent == NO_PARENT) ? 0 : numbers_[parent] + 1);
+
+    ASSERT_TRUE(index_.Add(MakeHash(index), (parent == NO_PARENT) ? BlockHash{} : MakeHash(parent),
+                           numbers_[index]));
+  }
+
+  std::size_t NaiveAncestor(std::size_t block, uint64_t block_number) const
+  {
+    while (numbers_[block] > block_number)
+    {
+      block = parents_[block];
+    }
+    return block;
+  }
+
+  std::size_t NaiveCommonAncestor(std::size_t left, std::size_t right) const
+  {
+    while (left != right)
+    {
+      if (numbers_[left] >= numbers_[right])
+      {
+        left = parents_[left];
+      }
+      else
+      {
+        right = parents_[right];
+      }
+    }
+    return left;
+  }
+
+  std::vector<std::size_t> parents_;
+  std::vector<uint64_t>    numbers_;
+  BlockAncestryIndex       index_;
+};
+
+TEST_F(BlockAncestryIndexTests, skip_targets_are_below_the_block)
+{
+  EXPECT_EQ(BlockAncestryIndex::SkipBlockNumber(0), 0);
+  EXPECT_EQ(BlockAncestryIndex::SkipBlockNumber(1), 0);
+
+  for (uint64_t block_number = 2; block_number < 10000; ++block_number)
+  {
+    EXPECT_LT(BlockAncestryIndex::SkipBlockNumber(block_number), block_number - 1);
+  }
+}
+
+TEST_F(BlockAncestryIndexTests, blocks_need_a_known_parent_with_the_previous_number)
+{
+  BuildTree(3);
+
+  EXPECT_FALSE(index_.Add(MakeHash(100), MakeHash(99), 1));
+  EXPECT_FALSE(index_.Add(MakeHash(100), MakeHash(0), 2));
+  EXPECT_TRUE(index_.Add(MakeHash(100), MakeHash(0), 1));
+
+  // adding a known block again is not an error
+  EXPECT_TRUE(index_.Add(MakeHash(100), MakeHash(0), 1));
+  EXPECT_EQ(index_.size(), 4);
+
+  uint64_t block_number{0};
+  EXPECT_TRUE(index_.GetBlockNumber(MakeHash(100), block_number));
+  EXPECT_EQ(block_number, 1);
+  EXPECT_FALSE(index_.GetBlockNumber(MakeHash(99), block_number));
+}
+
+TEST_F(BlockAncestryIndexTests, ancestors_match_a_walk_of_the_parents)
+{
+  BuildTree(3000);
+  std::mt19937_64 rng{7};
+
+  for (std::size_t i = 0; i < 2000; ++i)
+  {
+    std::size_t const block        = rng() % parents_.size();
+    uint64_t const    block_number = rng() % (numbers_[block] + 1);
+
+    EXPECT_EQ(index_.GetAncestor(MakeHash(block), block_number),
+              MakeHash(NaiveAncestor(block, block_number)));
+  }
+
+  EXPECT_TRUE(index_.GetAncestor(MakeHash(10), numbers_[10] + 1).empty());
+  EXPECT_TRUE(index_.GetAncestor(MakeHash(5000), 0).empty());
+}
+
+TEST_F(BlockAncestryIndexTests, common_ancestors_match_a_walk_of_the_parents)
+{
+  BuildTree(3000);
+  std::mt19937_64 rng{11};
+
+  for (std::size_t i = 0; i < 2000; ++i)
+  {
+    std::size_t const left  = rng() % parents_.size();
+    std::size_t const right = rng() % parents_.size();
+
+    auto const expected = NaiveCommonAncestor(left, right);
+
+    EXPECT_EQ(index_.GetCommonAncestor(MakeHash(left), MakeHash(right)), MakeHash(expected));
+    EXPECT_TRUE(index_.IsAncestor(MakeHash(expected), MakeHash(left)));
+    EXPECT_EQ(index_.IsAncestor(MakeHash(left), MakeHash(right)), expected == left);
+  }
+}
+
+TEST_F(BlockAncestryIndexTests, chain_slices_run_from_the_lowest_block_towards_the_tip)
+{
+  BuildTree(500);
+
+  auto const tip = static_cast<std::size_t>(
+      std::max_element(numbers_.begin(), numbers_.end()) - numbers_.begin());
+  auto const tip_number = numbers_[tip];
+
+  auto const slice = index_.GetChainSlice(MakeHash(tip), 10, 25);
+  ASSERT_EQ(slice.size(), 25);
+  for (std::size_t i = 0; i < slice.size(); ++i)
+  {
+    EXPECT_EQ(slice[i], MakeHash(NaiveAncestor(tip, 10 + i)));
+  }
+
+  // slices are cut short at the tip
+  EXPECT_EQ(index_.GetChainSlice(MakeHash(tip), tip_number - 2, 25).size(), 3);
+  EXPECT_TRUE(index_.GetChainSlice(MakeHash(tip), tip_number + 1, 25).empty());
+}
+
+TEST_F(BlockAncestryIndexTests, removing_a_block_removes_its_progeny)
+{
+  BuildTree(1000);
+
+  std::size_t const removed = 300;
+
+  std::vector<bool> survives(parents_.size());
+  for (std::size_t block = 0; block < parents_.size(); ++block)
+  {
+    survives[block] = (numbers_[block] < numbers_[removed]) ||
+                      (NaiveAncestor(block, numbers_[removed]) != removed);
+  }
+
+  auto const expected_removed =
+      static_cast<std::size_t>(std::count(survives.begin(), survives.end(), false));
+
+  EXPECT_EQ(index_.Remove(MakeHash(removed)), expected_removed);
+  EXPECT_EQ(index_.size(), parents_.size() - expected_removed);
+  EXPECT_EQ(index_.Remove(MakeHash(removed)), 0);
+
+  for (std::size_t block = 0; block < parents_.size(); ++block)
+  {
+    ASSERT_EQ(index_.Contains(MakeHash(block)), survives[block]);
+  }
+
+  // the remaining tree is still consistent and can grow again from the parent
+  auto const survivor = static_cast<std::size_t>(
+      std::find(survives.rbegin(), survives.rend(), true).base() - survives.begin() - 1);
+
+  ASSERT_TRUE(index_.Add(MakeHash(removed), MakeHash(parents_[removed]), numbers_[removed]));
+  EXPECT_EQ(index_.GetCommonAncestor(MakeHash(removed), MakeHash(survivor)),
+            MakeHash(NaiveCommonAncestor(removed, survivor)));
+
+  index_.Clear();
+  EXPECT_EQ(index_.size(), 0);
+}
+
+TEST_F(BlockAncestryIndexTests, pruning_keeps_the_answers_above_the_pruned_height)
+{
+  BuildTree(3000);
+  std::mt19937_64 rng{13};
+
+  uint64_t const lowest = numbers_[1500];
+
+  auto const expected_removed = static_cast<std::size_t>(std::count_if(
+      numbers_.begin(), numbers_.end(), [lowest](uint64_t number) { return number < lowest; }));
+
+  EXPECT_EQ(index_.Prune(lowest), expected_removed);
+  EXPECT_EQ(index_.size(), parents_.size() - expected_removed);
+  EXPECT_EQ(index_.Prune(lowest), 0);
+
+  for (std::size_t i = 0; i < 2000; ++i)
+  {
+    std::size_t const left  = rng() % parents_.size();
+    std::size_t const right = rng() % parents_.size();
+
+    if ((numbers_[left] < lowest) || (numbers_[right] < lowest))
+    {
+      EXPECT_EQ(index_.Contains(MakeHash(left)), numbers_[left] >= lowest);
+      continue;
+    }
+
+    uint64_t const block_number = lowest + (rng() % (numbers_[left] - lowest + 1));
+    EXPECT_EQ(index_.GetAncestor(MakeHash(left), block_number),
+              MakeHash(NaiveAncestor(left, block_number)));
+    EXPECT_TRUE(index_.GetAncestor(MakeHash(left), lowest - 1).empty());
+
+    // branches which join below the pruned height have no common ancestor any more
+    auto const expected = NaiveCommonAncestor(left, right);
+    auto const common   = index_.GetCommonAncestor(MakeHash(left), MakeHash(right));
+    if (numbers_[expected] < lowest)
+    {
+      EXPECT_TRUE(common.empty());
+    }
+    else
+    {
+      EXPECT_EQ(common, MakeHash(expected));
+    }
+  }
+
+  // the tree can still grow on top of the pruned height
+  std::size_t const tip = parents_.size() - 1;
+  ASSERT_GE(numbers_[tip], lowest);
+  Append(tip);
+  EXPECT_EQ(index_.GetAncestor(MakeHash(tip + 1), lowest), MakeHash(NaiveAncestor(tip, lowest)));
+
+  index_.Clear();
+  Append(NO_PARENT);
+  EXPECT_EQ(index_.GetAncestor(MakeHash(tip + 2), 0), MakeHash(tip + 2));
+}
+
+}  // namespace
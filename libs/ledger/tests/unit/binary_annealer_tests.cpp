@@ -0,0 +1,204 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/miner/optimisation/binary_annealer.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+using fetch::optimisers::BinaryAnnealer;
+
+using CostType  = BinaryAnnealer::CostType;
+using StateType = BinaryAnnealer::StateType;
+
+struct Problem
+{
+  std::vector<CostType>              fields;
+  std::vector<std::vector<CostType>> couplings;
+};
+
+// A packing like problem: every site is rewarded and conflicting sites are penalised
+Problem GenerateProblem(std::size_t size, double density, uint64_t seed)
+{
+  std::mt19937_64                 rng{seed};
+  std::uniform_int_distribution<> reward(1, 100);
+  std::bernoulli_distribution     conflict(density);
+
+  Problem problem;
+  problem.fields.resize(size);
+  problem.couplings.assign(size, std::vector<CostType>(size, 0));
+
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    problem.fields[i] = -reward(rng);
+
+    for (std::size_t j = i + 1; j < size; ++j)
+    {
+      if (conflict(rng))
+      {
+        problem.couplings[i][j] = 200;
+      }
+    }
+  }
+
+  return problem;
+}
+
+void Load(BinaryAnnealer &annealer, Problem const &problem)
+{
+  annealer.Resize(problem.fields.size());
+  for (std::size_t i = 0; i < problem.fields.size(); ++i)
+  {
+    annealer.Insert(i, i, problem.fields[i]);
+    for (std::size_t j = i + 1; j < problem.fields.size(); ++j)
+    {
+      if (problem.couplings[i][j] != 0)
+      {
+        annealer.Insert(i, j, problem.couplings[i][j]);
+      }
+    }
+  }
+}
+
+CostType Evaluate(Problem const &problem, StateType const &state)
+{
+  CostType energy = 0;
+  for (std::size_t i = 0; i < state.size(); ++i)
+  {
+    if (state[i] == 0)
+    {
+      continue;
+    }
+
+    energy += problem.fields[i];
+    for (std::size_t j = i + 1; j < state.size(); ++j)
+    {
+      if (state[j] != 0)
+      {
+        energy += problem.couplings[i][j];
+      }
+    }
+  }
+
+  return energy;
+}
+
+CostType BruteForceMinimum(Problem const &problem)
+{
+  std::size_t const size = problem.fields.size();
+  CostType          best = std::numeric_limits<CostType>::max();
+
+  StateType state(size);
+  for (uint64_t bits = 0; bits < (1ull << size); ++bits)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      state[i] = static_cast<BinaryAnnealer::SpinType>((bits >> i) & 1u);
+    }
+
+    best = std::min(best, Evaluate(problem, state));
+  }
+
+  return best;
+}
+
+TEST(BinaryAnnealerTests, FindsGroundStateOfSmallProblems)
+{
+  for (uint64_t seed = 0; seed < 5; ++seed)
+  {
+    auto const problem = GenerateProblem(14, 0.3, seed);
+
+    BinaryAnnealer annealer;
+    Load(annealer, problem);
+    annealer.Normalise();
+    annealer.SetSweeps(1000);
+    annealer.SetBetaEnd(20);
+    annealer.SetReplicas(16);
+
+    StateType      state;
+    CostType const energy = annealer.FindMinimum(state);
+
+    EXPECT_DOUBLE_EQ(energy, BruteForceMinimum(problem));
+    EXPECT_DOUBLE_EQ(energy, Evaluate(problem, state));
+  }
+}
+
+TEST(BinaryAnnealerTests, NormalisationDoesNotChangeReportedEnergy)
+{
+  auto const problem = GenerateProblem(12, 0.4, 42);
+
+  BinaryAnnealer annealer;
+  Load(annealer, problem);
+  annealer.Normalise();
+  annealer.SetSweeps(1000);
+  annealer.SetBetaEnd(20);
+  annealer.SetReplicas(16);
+
+  StateType      state;
+  CostType const energy = annealer.FindMinimum(state);
+
+  EXPECT_NEAR(energy, Evaluate(problem, state), 1e-9);
+  EXPECT_NEAR(energy, BruteForceMinimum(problem), 1e-9);
+}
+
+TEST(BinaryAnnealerTests, RepeatedInsertionsReplaceCouplings)
+{
+  BinaryAnnealer annealer;
+  annealer.Resize(2);
+  annealer.Insert(0, 0, -1);
+  annealer.Insert(1, 1, -1);
+  annealer.Insert(0, 1, 10);
+  annealer.Insert(1, 0, 0.5);
+
+  StateType state;
+  EXPECT_DOUBLE_EQ(annealer.FindMinimum(state), -1.5);
+  EXPECT_EQ(state, (StateType{1, 1}));
+}
+
+TEST(BinaryAnnealerTests, TimeBudgetReturnsBestStateFoundInTime)
+{
+  auto const problem = GenerateProblem(400, 0.05, 7);
+
+  BinaryAnnealer annealer;
+  Load(annealer, problem);
+  annealer.SetSweeps(1000000);
+  annealer.SetReplicas(2);
+  annealer.SetTimeBudget(std::chrono::milliseconds{50});
+
+  auto const start = std::chrono::steady_clock::now();
+
+  StateType      state;
+  CostType const energy = annealer.FindMinimum(state);
+
+  auto const elapsed = std::chrono::steady_clock::now() - start;
+
+  EXPECT_GE(elapsed, std::chrono::milliseconds{50});
+  EXPECT_LT(elapsed, std::chrono::seconds{5});
+  EXPECT_NEAR(energy, Evaluate(problem, state), 1e-6);
+  EXPECT_LT(energy, 0);
+}
+
+}  // namespace
@@ -0,0 +1,210 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_layout.hpp"
+#include "core/bitvector.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/digest.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/miner/mining_pool.hpp"
+#include "ledger/miner/transaction_layout_queue.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <random>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::chain::TransactionLayout;
+using fetch::ledger::Block;
+using fetch::ledger::MiningPool;
+using fetch::ledger::TransactionLayoutQueue;
+
+using Layouts = std::vector<TransactionLayout>;
+
+constexpr uint32_t LOG2_NUM_LANES = 3;
+constexpr uint32_t NUM_LANES      = 1u << LOG2_NUM_LANES;
+
+class MiningPoolTests : public ::testing::Test
+{
+protected:
+  TransactionLayout CreateLayout(std::initializer_list<uint32_t> lanes, uint64_t charge_rate)
+  {
+    BitVector mask{NUM_LANES};
+    for (auto const lane : lanes)
+    {
+      mask.set(lane, 1);
+    }
+
+    return CreateLayout(mask, charge_rate);
+  }
+
+  TransactionLayout CreateLayout(BitVector const &mask, uint64_t charge_rate)
+  {
+    ByteArray digest;
+    digest.Resize(32);
+    for (std::size_t i = 0; i < digest.size(); ++i)
+    {
+      digest[i] = static_cast<uint8_t>(rng_());
+    }
+
+    return {digest, mask, charge_rate, 0, 100};
+  }
+
+  std::mt19937_64 rng_{42};
+  MiningPool      pool_{LOG2_NUM_LANES};
+};
+
+// The packing algorithm the pool replaces: a greedy scan of the whole pool, sorted by charge rate
+Block::Slice PackSliceByScanning(Layouts &pool)
+{
+  Block::Slice slice;
+  BitVector    used{NUM_LANES};
+
+  for (auto it = pool.begin(); (it != pool.end()) && (used.PopCount() != NUM_LANES);)
+  {
+    if ((used & it->mask()).PopCount() == 0)
+    {
+      used |= it->mask();
+      slice.push_back(*it);
+      it = pool.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  return slice;
+}
+
+TEST_F(MiningPoolTests, duplicates_are_rejected)
+{
+  auto const tx1 = CreateLayout({0}, 10);
+  auto const tx2 = CreateLayout({1}, 10);
+
+  EXPECT_TRUE(pool_.Add(tx1));
+  EXPECT_FALSE(pool_.Add(tx1));
+  EXPECT_TRUE(pool_.Add(tx2));
+  EXPECT_EQ(pool_.size(), 2u);
+
+  TransactionLayoutQueue queue;
+  queue.Add(tx1);
+  queue.Add(CreateLayout({2}, 10));
+
+  pool_.Splice(queue);
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(pool_.size(), 3u);
+}
+
+TEST_F(MiningPoolTests, layouts_for_a_different_number_of_lanes_are_rejected)
+{
+  EXPECT_FALSE(pool_.Add(CreateLayout(BitVector{NUM_LANES * 2}, 10)));
+  EXPECT_TRUE(pool_.empty());
+}
+
+TEST_F(MiningPoolTests, slices_are_packed_by_charge_rate_then_arrival)
+{
+  auto const low           = CreateLayout({0, 1}, 1);
+  auto const first         = CreateLayout({1, 2}, 5);
+  auto const second        = CreateLayout({2, 3}, 5);
+  auto const high          = CreateLayout({3}, 9);
+  auto const unconstrained = CreateLayout({}, 2);
+
+  for (auto const &layout : {low, first, second, high, unconstrained})
+  {
+    pool_.Add(layout);
+  }
+
+  Block::Slice slice;
+  pool_.PackSlice(slice);
+  EXPECT_EQ(slice, (Block::Slice{high, first, unconstrained}));
+
+  slice.clear();
+  pool_.PackSlice(slice);
+  EXPECT_EQ(slice, (Block::Slice{second, low}));
+
+  EXPECT_TRUE(pool_.empty());
+}
+
+TEST_F(MiningPoolTests, removed_transactions_are_not_packed)
+{
+  auto const tx1 = CreateLayout({0}, 3);
+  auto const tx2 = CreateLayout({1}, 2);
+  auto const tx3 = CreateLayout({2}, 1);
+
+  for (auto const &layout : {tx1, tx2, tx3})
+  {
+    pool_.Add(layout);
+  }
+
+  EXPECT_TRUE(pool_.Remove(tx1.digest()));
+  EXPECT_FALSE(pool_.Remove(tx1.digest()));
+  EXPECT_EQ(pool_.RemoveIf(
+                [](TransactionLayout const &layout) { return layout.charge_rate() == 1; }),
+            1u);
+
+  Block::Slice slice;
+  pool_.PackSlice(slice);
+  EXPECT_EQ(slice, (Block::Slice{tx2}));
+  EXPECT_FALSE(pool_.Has(tx2.digest()));
+}
+
+TEST_F(MiningPoolTests, packing_matches_sorting_and_scanning_the_pool)
+{
+  std::poisson_distribution<uint32_t>     num_lanes(1.5);
+  std::uniform_int_distribution<uint32_t> lane(0, NUM_LANES - 1);
+  std::uniform_int_distribution<uint64_t> charge_rate(1, 20);
+
+  Layouts reference;
+  for (std::size_t i = 0; i < 2000; ++i)
+  {
+    BitVector mask{NUM_LANES};
+    for (uint32_t j = 0, count = num_lanes(rng_); j < count; ++j)
+    {
+      mask.set(lane(rng_), 1);
+    }
+
+    auto const layout = CreateLayout(mask, charge_rate(rng_));
+    pool_.Add(layout);
+    reference.push_back(layout);
+  }
+
+  std::stable_sort(reference.begin(), reference.end(),
+                   [](TransactionLayout const &a, TransactionLayout const &b) {
+                     return a.charge_rate() > b.charge_rate();
+                   });
+
+  while (!reference.empty())
+  {
+    Block::Slice slice;
+    pool_.PackSlice(slice);
+
+    ASSERT_EQ(slice, PackSliceByScanning(reference));
+    ASSERT_EQ(pool_.size(), reference.size());
+  }
+}
+
+}  // namespace
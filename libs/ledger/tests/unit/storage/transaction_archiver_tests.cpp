@@ -29,6 +29,7 @@ using testing::_;
 using testing::InSequence;
 using testing::Return;
 using testing::NiceMock;
+using testing::SizeIs;
 using fetch::ledger::TransactionArchiver;
 
 class TransactionArchiverTests : public ::testing::Test
@@ -60,7 +61,7 @@ protected:
 
 MATCHER_P(IsTransaction, digest, "")  // NOLINT
 {
-  return arg.digest() == digest;
+  return (arg.size() == 1) && (arg.front().digest() == digest);
 }
 
 TEST_F(TransactionArchiverTests, BasicCheck)
@@ -82,7 +83,7 @@ TEST_F(TransactionArchiverTests, BasicCheck)
     // set up expectations
     InSequence seq;
     EXPECT_CALL(pool_, Get(current, _)).Times(1);
-    EXPECT_CALL(store_, Add(IsTransaction(current))).Times(1);
+    EXPECT_CALL(store_, AddBatch(IsTransaction(current))).Times(1);
     EXPECT_CALL(pool_, Remove(current)).Times(1);
 
     // signal to the archiver that the transaction has been confirmed
@@ -128,7 +129,7 @@ TEST_F(TransactionArchiverTests, CheckRecoveryFromLookupFailure)
     // check the state machine does its job
     InSequence seq;
     EXPECT_CALL(pool_, Get(current, _)).Times(1);
-    EXPECT_CALL(store_, Add(IsTransaction(current))).Times(1);
+    EXPECT_CALL(store_, AddBatch(IsTransaction(current))).Times(1);
     EXPECT_CALL(pool_, Remove(current)).Times(1);
 
     CycleStateMachine();
@@ -138,4 +139,32 @@ TEST_F(TransactionArchiverTests, CheckRecoveryFromLookupFailure)
   EXPECT_FALSE(pool_.pool.Has(current));
 }
 
+TEST_F(TransactionArchiverTests, CheckConfirmationsAreArchivedAsOneBatch)
+{
+  auto const txs = tx_gen_.GenerateRandomTxs(10);
+
+  for (auto const &tx : txs)
+  {
+    pool_.pool.Add(*tx);
+    archiver_.Confirm(tx->digest());
+  }
+
+  EXPECT_CALL(store_, AddBatch(SizeIs(txs.size()))).Times(1);
+  CycleStateMachine();
+
+  for (auto const &tx : txs)
+  {
+    EXPECT_TRUE(store_.pool.Has(tx->digest()));
+    EXPECT_FALSE(pool_.pool.Has(tx->digest()));
+  }
+
+  // confirming an archived transaction again is a no op
+  archiver_.Confirm(txs.front()->digest());
+
+  EXPECT_CALL(store_, AddBatch(_)).Times(0);
+  CycleStateMachine();
+
+  EXPECT_TRUE(store_.pool.Has(txs.front()->digest()));
+}
+
 }  // namespace
@@ -0,0 +1,331 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction.hpp"
+#include "chain/transaction_serializer.hpp"
+#include "ledger/storage_unit/transaction_log_store.hpp"
+#include "transaction_generator.hpp"
+
+#include <sys/resource.h>
+
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using fetch::chain::Transaction;
+using fetch::ledger::TransactionLogStore;
+
+using StorePtr = std::unique_ptr<TransactionLogStore>;
+using TxArray  = TransactionLogStore::TxArray;
+
+constexpr char const *PREFIX = "transaction_log_store_tests";
+
+class TransactionLogStoreTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    store_ = std::make_unique<TransactionLogStore>();
+    store_->New(PREFIX);
+  }
+
+  void CreateStore(uint64_t segment_size, uint64_t max_segments = 0)
+  {
+    TransactionLogStore::Config config{};
+    config.segment_size = segment_size;
+    config.max_segments = max_segments;
+
+    store_ = std::make_unique<TransactionLogStore>(config);
+    store_->New(PREFIX);
+  }
+
+  void Reload()
+  {
+    store_ = std::make_unique<TransactionLogStore>();
+    store_->Load(PREFIX, false);
+  }
+
+  TxArray GenerateTxs(std::size_t count)
+  {
+    TxArray txs{};
+    for (auto const &tx : tx_gen_.GenerateRandomTxs(count))
+    {
+      txs.emplace_back(*tx);
+    }
+
+    return txs;
+  }
+
+  void ExpectStored(TxArray const &txs)
+  {
+    for (auto const &tx : txs)
+    {
+      Transaction stored{};
+      ASSERT_TRUE(store_->Get(tx.digest(), stored));
+
+      EXPECT_EQ(stored.digest(), tx.digest());
+      EXPECT_EQ(stored.data(), tx.data());
+    }
+  }
+
+  TransactionGenerator tx_gen_;
+  StorePtr             store_;
+};
+
+TEST_F(TransactionLogStoreTests, AddAndGet)
+{
+  auto const txs = GenerateTxs(5);
+
+  for (std::size_t i = 0; i < txs.size(); ++i)
+  {
+    EXPECT_EQ(store_->GetCount(), i);
+    EXPECT_FALSE(store_->Has(txs.at(i).digest()));
+
+    store_->Add(txs.at(i));
+
+    EXPECT_EQ(store_->GetCount(), i + 1);
+    EXPECT_TRUE(store_->Has(txs.at(i).digest()));
+  }
+
+  ExpectStored(txs);
+
+  Transaction missing{};
+  EXPECT_FALSE(store_->Get(GenerateTxs(1).front().digest(), missing));
+}
+
+TEST_F(TransactionLogStoreTests, OversizedDigestsAreNotFound)
+{
+  auto const txs = GenerateTxs(1);
+  store_->Add(txs.front());
+
+  // a valid digest followed by a trailing byte can not be stored inline
+  auto const oversized = txs.front().digest() + fetch::byte_array::ConstByteArray{"0"};
+
+  Transaction missing{};
+  EXPECT_FALSE(store_->Has(oversized));
+  EXPECT_FALSE(store_->Get(oversized, missing));
+}
+
+TEST_F(TransactionLogStoreTests, BatchSkipsDuplicates)
+{
+  auto txs = GenerateTxs(10);
+
+  // received transactions carry their wire bytes, built ones do not
+  for (std::size_t i = 0; i < txs.size(); i += 2)
+  {
+    fetch::chain::TransactionSerializer serializer{};
+    serializer << txs.at(i);
+
+    fetch::chain::TransactionSerializer received{serializer.data()};
+    received >> txs.at(i);
+  }
+
+  // the first transaction is already present and the last is repeated
+  store_->Add(txs.front());
+
+  auto batch = txs;
+  batch.emplace_back(batch.back());
+
+  EXPECT_EQ(store_->AddBatch(batch), txs.size() - 1);
+  EXPECT_EQ(store_->GetCount(), txs.size());
+  EXPECT_EQ(store_->AddBatch(batch), 0);
+
+  ExpectStored(txs);
+}
+
+TEST_F(TransactionLogStoreTests, ReloadRebuildsIndex)
+{
+  CreateStore(1024);
+
+  auto const txs = GenerateTxs(50);
+  store_->AddBatch(TxArray{txs.begin(), txs.begin() + 25});
+  for (auto it = txs.begin() + 25; it != txs.end(); ++it)
+  {
+    store_->Add(*it);
+  }
+
+  auto const num_segments = store_->GetNumSegments();
+  auto const size_on_disk = store_->GetSizeOnDisk();
+  EXPECT_GT(num_segments, 1);
+
+  Reload();
+
+  EXPECT_EQ(store_->GetCount(), txs.size());
+  EXPECT_EQ(store_->GetNumSegments(), num_segments);
+  EXPECT_EQ(store_->GetSizeOnDisk(), size_on_disk);
+  ExpectStored(txs);
+
+  // the log can be appended to after being loaded
+  auto const more = GenerateTxs(5);
+  EXPECT_EQ(store_->AddBatch(more), more.size());
+
+  Reload();
+
+  EXPECT_EQ(store_->GetCount(), txs.size() + more.size());
+  ExpectStored(more);
+}
+
+TEST_F(TransactionLogStoreTests, TornRecordIsDiscardedOnLoad)
+{
+  auto const txs = GenerateTxs(5);
+  store_->AddBatch(txs);
+
+  auto const size_on_disk = store_->GetSizeOnDisk();
+  store_.reset();
+
+  // simulate a crash part way through writing a record
+  {
+    std::ofstream segment{std::string{PREFIX} + ".00000000.seg",
+                          std::ios::binary | std::ios::app};
+    uint32_t const header[2] = {1000, 0};
+    segment.write(reinterpret_cast<char const *>(header), sizeof(header));
+    segment.write("partial", 7);
+  }
+
+  Reload();
+
+  EXPECT_EQ(store_->GetCount(), txs.size());
+  EXPECT_EQ(store_->GetSizeOnDisk(), size_on_disk);
+  ExpectStored(txs);
+
+  auto const more = GenerateTxs(1);
+  store_->Add(more.front());
+
+  Reload();
+
+  EXPECT_EQ(store_->GetCount(), txs.size() + 1);
+  ExpectStored(more);
+}
+
+TEST_F(TransactionLogStoreTests, FailedWriteLeavesTheLogUsable)
+{
+  auto const txs = GenerateTxs(5);
+  store_->AddBatch(TxArray{txs.begin(), txs.begin() + 2});
+
+  auto const size_on_disk = store_->GetSizeOnDisk();
+
+  // make the next write fail part way through by limiting the size of files
+  rlimit original{};
+  ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &original), 0);
+
+  rlimit limited   = original;
+  limited.rlim_cur = static_cast<rlim_t>(size_on_disk + 10);
+
+  auto const previous_handler = std::signal(SIGXFSZ, SIG_IGN);
+  ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &limited), 0);
+
+  auto const added = store_->AddBatch(TxArray{txs.begin() + 2, txs.end()});
+
+  ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &original), 0);
+  std::signal(SIGXFSZ, previous_handler);
+
+  EXPECT_EQ(added, 0);
+  EXPECT_EQ(store_->GetCount(), 2);
+  EXPECT_EQ(store_->GetSizeOnDisk(), size_on_disk);
+
+  // the log carries on from its last complete record
+  EXPECT_EQ(store_->AddBatch(TxArray{txs.begin() + 2, txs.end()}), 3);
+
+  Reload();
+
+  EXPECT_EQ(store_->GetCount(), txs.size());
+  ExpectStored(txs);
+}
+
+TEST_F(TransactionLogStoreTests, RetentionDropsOldestSegments)
+{
+  CreateStore(1024, 2);
+
+  auto const txs = GenerateTxs(60);
+  for (auto const &tx : txs)
+  {
+    store_->Add(tx);
+  }
+
+  EXPECT_EQ(store_->GetNumSegments(), 2);
+  EXPECT_LT(store_->GetCount(), txs.size());
+
+  // the most recent transactions are retained
+  EXPECT_TRUE(store_->Has(txs.back().digest()));
+  EXPECT_FALSE(store_->Has(txs.front().digest()));
+
+  auto const count = store_->GetCount();
+
+  Reload();
+
+  EXPECT_EQ(store_->GetNumSegments(), 2);
+  EXPECT_EQ(store_->GetCount(), count);
+  ExpectStored(TxArray{txs.end() - 1, txs.end()});
+}
+
+TEST_F(TransactionLogStoreTests, PullSubtree)
+{
+  auto const txs = GenerateTxs(64);
+  store_->AddBatch(txs);
+
+  auto const bit = [](fetch::Digest const &digest, uint64_t index) {
+    return ((digest[index / 8u] >> (index % 8u)) & 1u) != 0;
+  };
+
+  for (uint64_t bit_count : {0u, 1u, 3u, 9u})
+  {
+    auto const &partial = txs.front().digest();
+
+    std::set<fetch::Digest> expected{};
+    for (auto const &tx : txs)
+    {
+      bool matches = true;
+      for (uint64_t i = 0; i < bit_count; ++i)
+      {
+        matches &= (bit(tx.digest(), i) == bit(partial, i));
+      }
+
+      if (matches)
+      {
+        expected.insert(tx.digest());
+      }
+    }
+
+    std::set<fetch::Digest> pulled{};
+    for (auto const &tx : store_->PullSubtree(partial, bit_count, txs.size()))
+    {
+      pulled.insert(tx.digest());
+    }
+
+    EXPECT_EQ(pulled, expected);
+    EXPECT_EQ(store_->PullSubtree(partial, bit_count, 1).size(), 1);
+  }
+}
+
+TEST_F(TransactionLogStoreTests, MissingLogIsNotCreated)
+{
+  TransactionLogStore store{};
+  EXPECT_THROW(store.Load("transaction_log_store_tests_missing", false), std::runtime_error);
+}
+
+}  // namespace
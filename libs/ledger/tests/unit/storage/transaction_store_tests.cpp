@@ -18,6 +18,7 @@
 
 #include "chain/transaction.hpp"
 #include "chain/transaction_builder.hpp"
+#include "chain/transaction_serializer.hpp"
 #include "ledger/storage_unit/transaction_store.hpp"
 #include "transaction_generator.hpp"
 
@@ -82,4 +83,47 @@ TEST_F(TransactionStoreTests, SimpleCheck)
   }
 }
 
+TEST_F(TransactionStoreTests, BatchCheck)
+{
+  auto const txs = tx_gen_.GenerateRandomTxs(10);
+
+  // received transactions carry their wire bytes, built ones do not
+  TransactionStore::TxArray batch{};
+  for (std::size_t i = 0; i < txs.size(); ++i)
+  {
+    if (i % 2 == 0)
+    {
+      fetch::chain::TransactionSerializer serializer{};
+      serializer << *txs.at(i);
+
+      fetch::chain::TransactionSerializer received{serializer.data()};
+      batch.emplace_back();
+      received >> batch.back();
+
+      ASSERT_FALSE(batch.back().encoded().empty());
+    }
+    else
+    {
+      batch.emplace_back(*txs.at(i));
+    }
+  }
+
+  // the first transaction is already present and the last is repeated
+  store_.Add(batch.front());
+  batch.emplace_back(batch.back());
+
+  EXPECT_EQ(store_.AddBatch(batch), txs.size() - 1);
+  EXPECT_EQ(store_.GetCount(), txs.size());
+  EXPECT_EQ(store_.AddBatch(batch), 0);
+
+  for (auto const &tx : txs)
+  {
+    fetch::chain::Transaction stored{};
+    ASSERT_TRUE(store_.Get(tx->digest(), stored));
+
+    EXPECT_EQ(stored.digest(), tx->digest());
+    EXPECT_EQ(stored.data(), tx->data());
+  }
+}
+
 }  // namespace
@@ -17,11 +17,14 @@
 //------------------------------------------------------------------------------
 
 #include "math/activation_functions/elu.hpp"
+#include "math/activation_functions/gelu.hpp"
 #include "math/activation_functions/leaky_relu.hpp"
 #include "math/activation_functions/relu.hpp"
 #include "math/activation_functions/sigmoid.hpp"
 #include "math/activation_functions/softmax.hpp"
 #include "math/tensor/tensor.hpp"
+#include "math/trigonometry.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
 
 #include "benchmark/benchmark.h"
 
@@ -29,6 +32,9 @@
 
 using namespace fetch::math;
 
+using fetch::fixed_point::fp32_t;
+using fetch::fixed_point::fp64_t;
+
 template <typename T, SizeType L, SizeType H, SizeType W>
 void BM_Elu(benchmark::State &state)
 {
@@ -123,6 +129,72 @@ BENCHMARK_TEMPLATE(BM_Sigmoid, int, 256, 256, 256)->Unit(benchmark::kMillisecond
 BENCHMARK_TEMPLATE(BM_Sigmoid, float, 256, 256, 256)->Unit(benchmark::kMillisecond);
 BENCHMARK_TEMPLATE(BM_Sigmoid, double, 256, 256, 256)->Unit(benchmark::kMillisecond);
 
+// fixed point inputs are random, so that exp is not short cut by zeros
+template <typename T, SizeType L, SizeType H, SizeType W>
+void BM_SigmoidRandom(benchmark::State &state)
+{
+  Tensor<T> input({L, H, W});
+  Tensor<T> output({L, H, W});
+  input.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    Sigmoid<Tensor<T>>(input, output);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_SigmoidRandom, float, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SigmoidRandom, fp32_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SigmoidRandom, fp64_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_SigmoidRandom, float, 64, 64, 64)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SigmoidRandom, fp32_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SigmoidRandom, fp64_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+
+template <typename T, SizeType L, SizeType H, SizeType W>
+void BM_TanH(benchmark::State &state)
+{
+  Tensor<T> input({L, H, W});
+  Tensor<T> output({L, H, W});
+  input.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    TanH<Tensor<T>>(input, output);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_TanH, float, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_TanH, fp32_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_TanH, fp64_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_TanH, float, 64, 64, 64)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_TanH, fp32_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_TanH, fp64_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+
+template <typename T, SizeType L, SizeType H, SizeType W>
+void BM_Gelu(benchmark::State &state)
+{
+  Tensor<T> input({L, H, W});
+  Tensor<T> output({L, H, W});
+  input.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    Gelu<Tensor<T>>(input, output);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_Gelu, float, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Gelu, double, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Gelu, fp32_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Gelu, fp64_t, 2, 8, 128)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_Gelu, float, 64, 64, 64)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gelu, double, 64, 64, 64)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gelu, fp32_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gelu, fp64_t, 64, 64, 64)->Unit(benchmark::kMillisecond);
+
 template <typename T, SizeType L, SizeType H>
 void BM_Softmax(benchmark::State &state)
 {
@@ -147,4 +219,21 @@ BENCHMARK_TEMPLATE(BM_Softmax, int, 256, 256)->Unit(benchmark::kMicrosecond);
 BENCHMARK_TEMPLATE(BM_Softmax, float, 256, 256)->Unit(benchmark::kMicrosecond);
 BENCHMARK_TEMPLATE(BM_Softmax, double, 256, 256)->Unit(benchmark::kMicrosecond);
 
+template <typename T, SizeType L, SizeType H>
+void BM_SoftmaxRandom(benchmark::State &state)
+{
+  Tensor<T> input({L, H});
+  Tensor<T> output({L, H});
+  input.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    Softmax<Tensor<T>>(input, output);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_SoftmaxRandom, float, 256, 256)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SoftmaxRandom, fp32_t, 256, 256)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SoftmaxRandom, fp64_t, 256, 256)->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_MAIN();
@@ -18,12 +18,16 @@
 //------------------------------------------------------------------------------
 
 #include "math/fundamental_operators.hpp"
+#include "math/kernels/elementwise.hpp"
+#include "math/meta/math_type_traits.hpp"
 #include "math/standard_functions/exp.hpp"
 #include "math/standard_functions/pow.hpp"
 #include "math/trigonometry.hpp"
+#include "vectorise/math/exp.hpp"
 #include "vectorise/math/max.hpp"
 
 #include <cassert>
+#include <type_traits>
 
 namespace fetch {
 namespace math {
@@ -36,7 +40,7 @@ namespace math {
  * @param ret
  */
 template <typename ArrayType>
-void Gelu(ArrayType const &t, ArrayType &ret)
+meta::IfIsMathNonFixedPointArray<ArrayType, void> Gelu(ArrayType const &t, ArrayType &ret)
 {
   assert(t.size() == ret.size());
   using DataType = typename ArrayType::Type;
@@ -58,6 +62,34 @@ void Gelu(ArrayType const &t, ArrayType &ret)
   Multiply(ret, half, ret);
 }
 
+/**
+ * Guassian error linear unit (approximated) for fixed point arrays, evaluated in a single pass a
+ * register at a time. The operations are those of the implementation above in the same order, so
+ * the results are bit-exact with it
+ * @tparam ArrayType
+ * @param t
+ * @param ret
+ */
+template <typename ArrayType>
+meta::IfIsMathFixedPointArray<ArrayType, void> Gelu(ArrayType const &t, ArrayType &ret)
+{
+  using DataType = typename ArrayType::Type;
+
+  DataType one{1};
+  DataType half   = Type<DataType>("0.5");
+  DataType coeff1 = Type<DataType>("0.797885");
+  DataType coeff2 = Type<DataType>("0.035677");
+
+  kernels::ApplyElementwise(t, ret, [one, half, coeff1, coeff2](auto const &x, auto &y) {
+    using RegisterType = std::decay_t<decltype(x)>;
+
+    // x^3 is computed as x * x * x by Pow
+    RegisterType cube = (x * x) * x;
+    RegisterType t1   = x * RegisterType(coeff1) + cube * RegisterType(coeff2);
+    y = (x * (vectorise::TanH(t1) + RegisterType(one))) * RegisterType(half);
+  });
+}
+
 template <typename ArrayType>
 ArrayType Gelu(ArrayType const &t)
 {
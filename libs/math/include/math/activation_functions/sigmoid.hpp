@@ -18,7 +18,10 @@
 //------------------------------------------------------------------------------
 
 #include "math/fundamental_operators.hpp"
+#include "math/kernels/elementwise.hpp"
+#include "math/meta/math_type_traits.hpp"
 #include "math/standard_functions/exp.hpp"
+#include "vectorise/math/exp.hpp"
 
 namespace fetch {
 namespace math {
@@ -30,7 +33,7 @@ namespace math {
  * @param ret
  */
 template <typename ArrayType>
-void Sigmoid(ArrayType const &t, ArrayType &ret)
+meta::IfIsMathNonFixedPointArray<ArrayType, void> Sigmoid(ArrayType const &t, ArrayType &ret)
 {
   using Type = typename ArrayType::Type;
 
@@ -55,6 +58,19 @@ void Sigmoid(ArrayType const &t, ArrayType &ret)
   }
 }
 
+/**
+ * The sigmoid function for fixed point arrays, computed a register at a time with the same
+ * operations as above
+ * @tparam ArrayType
+ * @param t
+ * @param ret
+ */
+template <typename ArrayType>
+meta::IfIsMathFixedPointArray<ArrayType, void> Sigmoid(ArrayType const &t, ArrayType &ret)
+{
+  kernels::ApplyElementwise(t, ret, [](auto const &x, auto &y) { y = vectorise::Sigmoid(x); });
+}
+
 template <typename ArrayType>
 ArrayType Sigmoid(ArrayType const &t)
 {
@@ -47,21 +47,30 @@ void Softmax1DImplementation(ArrayType1 const &array, ArrayType2 &ret)
 
   auto it1 = array.begin();
   auto it2 = ret.begin();
-  auto sum = Type(0);
   while (it1.is_valid())
   {
-    *it2 = static_cast<Type>(Exp(*it1 - array_max));
-    sum  = static_cast<Type>(sum + *it2);
+    *it2 = static_cast<Type>(*it1 - array_max);
     ++it2;
     ++it1;
   }
 
+  // exp(x) is evaluated over the whole array, so that fixed point types are vectorised
+  Exp(ret, ret);
+
+  auto sum = Type(0);
   auto it3 = ret.begin();  // TODO (private 855): Fix implicitly deleted copy const. for iterator
   while (it3.is_valid())
   {
-    *it3 = static_cast<Type>(*it3 / sum);
+    sum = static_cast<Type>(sum + *it3);
     ++it3;
   }
+
+  auto it4 = ret.begin();
+  while (it4.is_valid())
+  {
+    *it4 = static_cast<Type>(*it4 / sum);
+    ++it4;
+  }
 }
 
 /**
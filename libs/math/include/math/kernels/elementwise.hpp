@@ -0,0 +1,421 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/base_types.hpp"
+#include "math/exceptions/exceptions.hpp"
+#include "math/meta/math_type_traits.hpp"
+#include "vectorise/memory/range.hpp"
+#include "vectorise/memory/shared_array.hpp"
+#include "vectorise/threading/pool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace math {
+namespace kernels {
+
+namespace details {
+
+/// tensors smaller than this are evaluated on the calling thread
+constexpr SizeType PARALLEL_MINIMUM_ELEMENTS = SizeType{1} << 15;
+
+/// rows are split between threads at multiples of this, so that every part starts on a whole
+/// register for all of the element types
+constexpr SizeType ROW_ALIGNMENT = 64;
+
+inline SizeType EvaluationThreadCount()
+{
+  return std::max(SizeType{1}, static_cast<SizeType>(std::thread::hardware_concurrency()));
+}
+
+/// the calling thread takes a share of the work, so the pool has one thread fewer
+inline threading::Pool &EvaluationPool()
+{
+  static threading::Pool pool{EvaluationThreadCount() - 1, "Kernels"};
+  return pool;
+}
+
+/// set on pool threads, so that kernels evaluating tensors themselves do not wait on the pool
+inline bool &IsEvaluationThread()
+{
+  static thread_local bool is_evaluation_thread{false};
+  return is_evaluation_thread;
+}
+
+template <typename T>
+meta::IfIsFixedPoint<T, uint32_t> TakeState()
+{
+  uint32_t const state = T::fp_state;
+  T::StateClear();
+  return state;
+}
+
+template <typename T>
+meta::IfIsNotFixedPoint<T, uint32_t> TakeState()
+{
+  return 0;
+}
+
+template <typename T>
+meta::IfIsFixedPoint<T, void> MergeState(uint32_t state)
+{
+  T::fp_state |= state;
+}
+
+template <typename T>
+meta::IfIsNotFixedPoint<T, void> MergeState(uint32_t /*state*/)
+{}
+
+/**
+ * Evaluates a kernel over a destination tensor and N input tensors, which have the shape of the
+ * destination or are broadcast to it following the numpy rules
+ */
+template <typename ArrayType, std::size_t N>
+class Evaluation
+{
+public:
+  using Type            = typename ArrayType::Type;
+  using VectorSliceType = typename ArrayType::VectorSliceType;
+
+  Evaluation(ArrayType &ret, std::array<ArrayType const *, N> const &arrays)
+    : ret_(ret)
+    , arrays_(arrays)
+  {
+    SizeVector const &shape = ret_.shape();
+
+    flat_ = (ret_.height() == ret_.padded_height());
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      operands_[i] = MakeOperand(*arrays_[i], shape);
+      flat_        = flat_ && operands_[i].same_shape;
+    }
+
+    // without padding or broadcasting the tensors are evaluated as a single column
+    height_  = flat_ ? ret_.size() : ret_.height();
+    columns_ = (height_ == 0) ? 0 : ret_.size() / height_;
+  }
+
+  template <typename Kernel>
+  void Run(Kernel const &kernel)
+  {
+    if (ret_.size() == 0)
+    {
+      return;
+    }
+
+    std::vector<Block> const blocks = Split();
+
+    if ((blocks.size() == 1) || IsEvaluationThread())
+    {
+      for (auto const &block : blocks)
+      {
+        Run(kernel, block, std::make_index_sequence<N>());
+      }
+      return;
+    }
+
+    std::vector<std::future<uint32_t>> futures;
+    for (std::size_t i = 1; i < blocks.size(); ++i)
+    {
+      Block const block = blocks[i];
+      futures.emplace_back(EvaluationPool().Dispatch([this, &kernel, block]() {
+        IsEvaluationThread() = true;
+        TakeState<Type>();
+
+        Run(kernel, block, std::make_index_sequence<N>());
+
+        IsEvaluationThread() = false;
+        return TakeState<Type>();
+      }));
+    }
+
+    // every block has to finish before returning, since they refer to the tensors and kernel
+    std::exception_ptr error{};
+    try
+    {
+      Run(kernel, blocks.front(), std::make_index_sequence<N>());
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+
+    uint32_t state{0};
+    for (auto &future : futures)
+    {
+      try
+      {
+        state |= future.get();
+      }
+      catch (...)
+      {
+        error = std::current_exception();
+      }
+    }
+
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+
+    // errors raised on the pool threads are reported on the calling thread
+    MergeState<Type>(state);
+  }
+
+private:
+  struct Operand
+  {
+    bool       same_shape{false};
+    bool       repeat_rows{false};
+    SizeVector offset_strides{};
+  };
+
+  struct Block
+  {
+    SizeType column_begin;
+    SizeType column_end;
+    SizeType row_begin;
+    SizeType row_end;
+  };
+
+  static Operand MakeOperand(ArrayType const &array, SizeVector const &shape)
+  {
+    SizeVector const &array_shape = array.shape();
+    if (array_shape.size() > shape.size())
+    {
+      throw exceptions::WrongShape("tensor of rank " + std::to_string(array_shape.size()) +
+                                   " cannot be broadcast to rank " +
+                                   std::to_string(shape.size()));
+    }
+
+    // dimensions are matched from the last one, missing leading dimensions have size 1
+    SizeType const leading = shape.size() - array_shape.size();
+    auto const     size_of = [&array_shape, leading](SizeType dimension) {
+      return (dimension < leading) ? SizeType{1} : array_shape[dimension - leading];
+    };
+
+    Operand operand;
+    operand.same_shape = (array_shape == shape);
+
+    if (size_of(0) != shape[0])
+    {
+      if (size_of(0) != 1)
+      {
+        throw exceptions::WrongShape("tensor height " + std::to_string(size_of(0)) +
+                                     " cannot be broadcast to " + std::to_string(shape[0]));
+      }
+      operand.repeat_rows = true;
+    }
+
+    // the offset into the data of the input for each dimension of the result after the first
+    SizeType stride{array.padded_height()};
+    for (SizeType dimension = 1; dimension < shape.size(); ++dimension)
+    {
+      SizeType const size = size_of(dimension);
+      if ((size != shape[dimension]) && (size != 1))
+      {
+        throw exceptions::WrongShape("tensor dimension " + std::to_string(size) +
+                                     " cannot be broadcast to " +
+                                     std::to_string(shape[dimension]));
+      }
+
+      if (dimension < leading)
+      {
+        operand.offset_strides.emplace_back(0);
+      }
+      else if (dimension == leading)
+      {
+        // the first dimension of the input runs along the columns of the result
+        operand.offset_strides.emplace_back((size == 1) ? SizeType{0} : SizeType{1});
+      }
+      else
+      {
+        operand.offset_strides.emplace_back((size == 1) ? SizeType{0} : stride);
+        stride *= size;
+      }
+    }
+
+    return operand;
+  }
+
+  /// splits the columns, or the rows if there are too few columns, between the threads
+  std::vector<Block> Split() const
+  {
+    SizeType const elements = height_ * columns_;
+    SizeType const count    = std::min(EvaluationThreadCount(),
+                                    std::max(SizeType{1}, elements / PARALLEL_MINIMUM_ELEMENTS));
+
+    std::vector<Block> blocks;
+    if (count == 1)
+    {
+      blocks.push_back({0, columns_, 0, height_});
+    }
+    else if (columns_ >= count)
+    {
+      for (SizeType i = 0; i < count; ++i)
+      {
+        blocks.push_back({columns_ * i / count, columns_ * (i + 1) / count, 0, height_});
+      }
+    }
+    else
+    {
+      SizeType const parts = (count + columns_ - 1) / columns_;
+      SizeType rows = (height_ + parts - 1) / parts;
+      rows          = ((rows + ROW_ALIGNMENT - 1) / ROW_ALIGNMENT) * ROW_ALIGNMENT;
+
+      for (SizeType column = 0; column < columns_; ++column)
+      {
+        for (SizeType row = 0; row < height_; row += rows)
+        {
+          blocks.push_back({column, column + 1, row, std::min(height_, row + rows)});
+        }
+      }
+    }
+
+    return blocks;
+  }
+
+  template <typename Kernel, std::size_t... I>
+  void Run(Kernel const &kernel, Block const &block, std::index_sequence<I...> /*indices*/)
+  {
+    memory::Range const range(std::size_t(block.row_begin), std::size_t(block.row_end));
+
+    // broadcast rows are repeated into a column of their own
+    std::array<memory::SharedArray<Type>, N> repeated;
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      if (operands_[i].repeat_rows)
+      {
+        repeated[i] = memory::SharedArray<Type>(ret_.padded_height());
+      }
+    }
+
+    std::array<VectorSliceType, N> slices;
+    for (SizeType column = block.column_begin; column < block.column_end; ++column)
+    {
+      for (std::size_t i = 0; i < N; ++i)
+      {
+        slices[i] = Slice(i, column, repeated[i], block);
+      }
+
+      auto ret_slice = Slice(ret_, column);
+      ret_slice.in_parallel().RangedApplyMultiple(range, Kernel(kernel), slices[I]...);
+    }
+  }
+
+  VectorSliceType Slice(ArrayType const &array, SizeType column) const
+  {
+    if (flat_)
+    {
+      return array.data().slice(0, array.data().size());
+    }
+
+    return array.data().slice(array.padded_height() * column, array.padded_height());
+  }
+
+  VectorSliceType Slice(std::size_t i, SizeType column, memory::SharedArray<Type> &repeated,
+                        Block const &block) const
+  {
+    Operand const &  operand = operands_[i];
+    ArrayType const &array   = *arrays_[i];
+
+    if (operand.same_shape)
+    {
+      return Slice(array, column);
+    }
+
+    // finds the data of the input that is broadcast to this column of the result
+    SizeType          offset{0};
+    SizeType          remaining = column;
+    SizeVector const &shape     = ret_.shape();
+    for (SizeType dimension = 1; dimension < shape.size(); ++dimension)
+    {
+      offset += (remaining % shape[dimension]) * operand.offset_strides[dimension - 1];
+      remaining /= shape[dimension];
+    }
+
+    if (!operand.repeat_rows)
+    {
+      return array.data().slice(offset, array.padded_height());
+    }
+
+    Type const value = array.data()[offset];
+    for (SizeType row = block.row_begin; row < block.row_end; ++row)
+    {
+      repeated[row] = value;
+    }
+
+    return repeated.slice(0, repeated.size());
+  }
+
+  ArrayType &                      ret_;
+  std::array<ArrayType const *, N> arrays_;
+  std::array<Operand, N>           operands_{};
+  bool                             flat_{false};
+  SizeType                         height_{0};
+  SizeType                         columns_{0};
+};
+
+}  // namespace details
+
+/**
+ * Evaluates kernel(x..., y) into ret a register at a time, in a single pass over memory, so that
+ * chains of elementwise operations do not need intermediate tensors. The inputs either have the
+ * shape of ret or are broadcast to it following the numpy rules, e.g. a bias of shape {n, 1}
+ * against a batch of shape {n, b}. Large tensors are split between threads; the fixed point error
+ * state raised on them is merged into that of the calling thread.
+ *
+ * The padding of the tensors is neither read nor written. The parts of a column that do not fill
+ * a whole register are handled with scalar registers, so the kernel should accept both.
+ * @param ret output tensor, which may also be one of the inputs
+ * @param kernel functor taking a register for each input and the output register
+ * @param arrays input tensors
+ */
+template <typename ArrayType, typename Kernel, typename... Arrays>
+void Evaluate(ArrayType &ret, Kernel const &kernel, Arrays const &... arrays)
+{
+  details::Evaluation<ArrayType, sizeof...(Arrays)> evaluation(ret, {{&arrays...}});
+  evaluation.Run(kernel);
+}
+
+/**
+ * Applies kernel(x, y) to every element of array, writing the result into ret
+ * @param array input tensor
+ * @param ret output tensor of the same shape, may be the input tensor
+ * @param kernel functor taking an input register and an output register
+ */
+template <typename ArrayType, typename Kernel>
+void ApplyElementwise(ArrayType const &array, ArrayType &ret, Kernel const &kernel)
+{
+  assert(array.shape() == ret.shape());
+  Evaluate(ret, kernel, array);
+}
+
+}  // namespace kernels
+}  // namespace math
+}  // namespace fetch
@@ -17,8 +17,10 @@
 //
 //------------------------------------------------------------------------------
 
+#include "math/kernels/elementwise.hpp"
 #include "math/meta/math_type_traits.hpp"
 #include "vectorise/fixed_point/fixed_point.hpp"
+#include "vectorise/math/exp.hpp"
 
 #include <cassert>
 
@@ -61,7 +63,7 @@ meta::IfIsArithmetic<Type, Type> Exp(Type const &x)
 }
 
 template <typename ArrayType>
-meta::IfIsMathArray<ArrayType, void> Exp(ArrayType const &array, ArrayType &ret)
+meta::IfIsMathNonFixedPointArray<ArrayType, void> Exp(ArrayType const &array, ArrayType &ret)
 {
   assert(ret.shape() == array.shape());
   auto it1 = array.cbegin();
@@ -74,6 +76,16 @@ meta::IfIsMathArray<ArrayType, void> Exp(ArrayType const &array, ArrayType &ret)
   }
 }
 
+/**
+ * Fixed point arrays are evaluated a register at a time, with results and fp_state bit-exact with
+ * the scalar Exp
+ */
+template <typename ArrayType>
+meta::IfIsMathFixedPointArray<ArrayType, void> Exp(ArrayType const &array, ArrayType &ret)
+{
+  kernels::ApplyElementwise(array, ret, [](auto const &x, auto &y) { y = vectorise::Exp(x); });
+}
+
 template <typename ArrayType>
 meta::IfIsMathArray<ArrayType, ArrayType> Exp(ArrayType const &array)
 {
@@ -17,8 +17,10 @@
 //
 //------------------------------------------------------------------------------
 
+#include "math/kernels/elementwise.hpp"
 #include "math/kernels/trigonometry.hpp"
 #include "math/meta/math_type_traits.hpp"
+#include "vectorise/math/exp.hpp"
 
 #include <cassert>
 
@@ -245,7 +247,8 @@ fetch::math::meta::IfIsMathArray<ArrayType, ArrayType> CosH(ArrayType const &x)
  * @param x - array
  */
 template <typename ArrayType>
-fetch::math::meta::IfIsMathArray<ArrayType, void> TanH(ArrayType const &x, ArrayType &ret)
+fetch::math::meta::IfIsMathNonFixedPointArray<ArrayType, void> TanH(ArrayType const &x,
+                                                                    ArrayType &      ret)
 {
   assert(ret.size() == x.size());
   kernels::TanH s;
@@ -259,6 +262,17 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> TanH(ArrayType const &x, Array
   }
 }
 
+/**
+ * maps every element of the fixed point array x to ret = TanH(x), a register at a time
+ * @param x - array
+ */
+template <typename ArrayType>
+fetch::math::meta::IfIsMathFixedPointArray<ArrayType, void> TanH(ArrayType const &x,
+                                                                 ArrayType &      ret)
+{
+  kernels::ApplyElementwise(x, ret, [](auto const &a, auto &b) { b = vectorise::TanH(a); });
+}
+
 template <typename ArrayType>
 fetch::math::meta::IfIsMathArray<ArrayType, ArrayType> TanH(ArrayType const &x)
 {
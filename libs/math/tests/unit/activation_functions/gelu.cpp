@@ -47,6 +47,46 @@ TYPED_TEST(GeluTest, exact_value_test)
       fetch::math::Type<DataType>("2.8") * fetch::math::function_tolerance<DataType>()));
 }
 
+// the fixed point implementation is fused into a single vectorised pass, check it against the
+// scalar operations of the unfused implementation on a shape that does not fill whole registers
+TYPED_TEST(GeluTest, matches_scalar_implementation)
+{
+  using DataType = typename TypeParam::Type;
+
+  TypeParam input{{11, 3, 5}};
+  DataType  step = fetch::math::Type<DataType>("0.15");
+  DataType  x    = DataType{-12};
+  for (auto &e : input)
+  {
+    e = x;
+    x = x + step;
+  }
+
+  TypeParam output = fetch::math::Gelu(input);
+
+  DataType const one{1};
+  DataType const three{3};
+  DataType const half   = fetch::math::Type<DataType>("0.5");
+  DataType const coeff1 = fetch::math::Type<DataType>("0.797885");
+  DataType const coeff2 = fetch::math::Type<DataType>("0.035677");
+  kernels::TanH  tanh;
+
+  auto it  = input.cbegin();
+  auto rit = output.cbegin();
+  while (it.is_valid())
+  {
+    DataType in = *it;
+    DataType t1 = in * coeff1 + fetch::math::Pow(in, three) * coeff2;
+    DataType t2;
+    tanh(t1, t2);
+    DataType expected = (in * (t2 + one)) * half;
+
+    ASSERT_EQ(*rit, expected) << "x = " << in;
+    ++it;
+    ++rit;
+  }
+}
+
 }  // namespace test
 }  // namespace math
 }  // namespace fetch
@@ -190,6 +190,44 @@ TYPED_TEST(SigmoidTest, sigmoid_11)
   ASSERT_TRUE(output.AllClose(numpy_output, fetch::math::function_tolerance<DataType>()));
 }
 
+// the fixed point implementation is vectorised, check it against a scalar implementation on
+// shapes with and without padding, and over the range where exp saturates
+TYPED_TEST(SigmoidTest, matches_scalar_implementation)
+{
+  using SizeType = fetch::math::SizeType;
+  using DataType = typename TypeParam::Type;
+
+  for (SizeType height : {SizeType{13}, SizeType{16}})
+  {
+    TypeParam input{{height, 7}};
+    DataType  step = fetch::math::Type<DataType>("0.5");
+    DataType  x    = DataType{-25};
+    for (auto &e : input)
+    {
+      e = x;
+      x = x + step;
+    }
+
+    TypeParam output = fetch::math::Sigmoid(input);
+
+    for (SizeType i = 0; i < input.size(); ++i)
+    {
+      DataType const in = input.At(i % height, i / height);
+      DataType       expected;
+      if (in >= DataType{0})
+      {
+        expected = DataType{1} / (DataType{1} + fetch::math::Exp(-in));
+      }
+      else
+      {
+        DataType const e = fetch::math::Exp(in);
+        expected         = e / (e + DataType{1});
+      }
+      ASSERT_EQ(output.At(i % height, i / height), expected) << "x = " << in;
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace math
 }  // namespace fetch
@@ -112,6 +112,39 @@ TYPED_TEST(SoftmaxTest, exact_values_test)
                                   function_tolerance<DataType>()));
 }
 
+TYPED_TEST(SoftmaxTest, matches_scalar_implementation)
+{
+  using DataType = typename TypeParam::Type;
+
+  // a length that does not fill whole registers
+  std::size_t n = 37;
+  TypeParam   input{n};
+  DataType    step = fetch::math::Type<DataType>("0.3");
+  DataType    x    = DataType{-5};
+  for (auto &e : input)
+  {
+    e = x;
+    x = x + step;
+  }
+
+  TypeParam output{n};
+  fetch::math::Softmax(input, output);
+
+  DataType const array_max = fetch::math::Max(input);
+  TypeParam      expected{n};
+  DataType       sum{0};
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    expected[i] = fetch::math::Exp(input[i] - array_max);
+    sum         = sum + expected[i];
+  }
+
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    ASSERT_EQ(output[i], expected[i] / sum);
+  }
+}
+
 }  // namespace test
 }  // namespace math
 }  // namespace fetch
@@ -27,6 +27,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
+#include <thread>
 
 namespace fetch {
 namespace math {
@@ -2316,6 +2317,35 @@ TYPED_TEST(NanInfinityTest, trig_function_nan_inf_tests)
   EXPECT_TRUE(TypeParam::IsStateNaN());
 }
 
+template <typename T>
+class StateTest : public ::testing::Test
+{
+};
+
+TYPED_TEST_CASE(StateTest, FixedPointTypes);
+TYPED_TEST(StateTest, state_is_thread_local)
+{
+  TypeParam::StateClear();
+  TypeParam::Sqrt(-TypeParam::_1);
+  EXPECT_TRUE(TypeParam::IsStateNaN());
+
+  bool other_thread_started_clear{false};
+  bool other_thread_overflowed{false};
+  std::thread([&other_thread_started_clear, &other_thread_overflowed]() {
+    other_thread_started_clear = (TypeParam::fp_state == TypeParam::STATE_OK);
+    TypeParam::Exp(TypeParam::MAX_EXP + TypeParam::_1);
+    other_thread_overflowed = TypeParam::IsStateOverflow();
+  }).join();
+
+  EXPECT_TRUE(other_thread_started_clear);
+  EXPECT_TRUE(other_thread_overflowed);
+
+  // the operations of the other thread do not affect the state of this one
+  EXPECT_TRUE(TypeParam::IsStateNaN());
+  EXPECT_FALSE(TypeParam::IsStateOverflow());
+  TypeParam::StateClear();
+}
+
 }  // namespace test
 }  // namespace math
 }  // namespace fetch
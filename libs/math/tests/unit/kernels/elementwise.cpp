@@ -0,0 +1,180 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/exceptions/exceptions.hpp"
+#include "math/kernels/elementwise.hpp"
+#include "math/tensor/tensor.hpp"
+#include "test_types.hpp"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+namespace fetch {
+namespace math {
+namespace test {
+
+namespace {
+
+template <typename ArrayType>
+ArrayType MakeArray(SizeVector const &shape, int offset)
+{
+  using DataType = typename ArrayType::Type;
+
+  ArrayType array{shape};
+  int       i{offset};
+  for (auto &e : array)
+  {
+    e = static_cast<DataType>((i % 17) - 8);
+    ++i;
+  }
+
+  return array;
+}
+
+// the broadcast element of array for an index into a tensor of the given shape
+template <typename ArrayType>
+typename ArrayType::Type BroadcastAt(ArrayType const &array, SizeVector const &shape,
+                                     SizeType index)
+{
+  SizeVector const &array_shape = array.shape();
+  SizeType const    leading     = shape.size() - array_shape.size();
+
+  SizeVector indices(array_shape.size());
+  for (SizeType dimension = 0; dimension < shape.size(); ++dimension)
+  {
+    SizeType const i = index % shape[dimension];
+    index /= shape[dimension];
+
+    if (dimension >= leading)
+    {
+      indices[dimension - leading] = (array_shape[dimension - leading] == 1) ? 0 : i;
+    }
+  }
+
+  return array.data()[array.ComputeIndex(indices)];
+}
+
+template <typename ArrayType>
+void ExpectMultiplyAdd(SizeVector const &shape, SizeVector const &a_shape,
+                       SizeVector const &b_shape, SizeVector const &c_shape)
+{
+  auto const a = MakeArray<ArrayType>(a_shape, 0);
+  auto const b = MakeArray<ArrayType>(b_shape, 5);
+  auto const c = MakeArray<ArrayType>(c_shape, 11);
+
+  ArrayType ret{shape};
+  kernels::Evaluate(
+      ret, [](auto const &x, auto const &y, auto const &z, auto &r) { r = (x * y) + z; }, a, b, c);
+
+  SizeVector indices(shape.size());
+  for (SizeType i = 0; i < ret.size(); ++i)
+  {
+    SizeType index = i;
+    for (SizeType dimension = 0; dimension < shape.size(); ++dimension)
+    {
+      indices[dimension] = index % shape[dimension];
+      index /= shape[dimension];
+    }
+
+    auto const expected =
+        (BroadcastAt(a, shape, i) * BroadcastAt(b, shape, i)) + BroadcastAt(c, shape, i);
+    ASSERT_EQ(ret.data()[ret.ComputeIndex(indices)], expected) << "at element " << i;
+  }
+}
+
+}  // namespace
+
+template <typename T>
+class ElementwiseKernelTest : public ::testing::Test
+{
+};
+
+TYPED_TEST_CASE(ElementwiseKernelTest, TensorFloatingTypes);
+
+TYPED_TEST(ElementwiseKernelTest, same_shape)
+{
+  // with and without padding, and large enough to be split between threads
+  for (SizeVector const &shape : std::vector<SizeVector>{
+           {13, 7}, {16, 7}, {1, 1}, {5}, {3, 4, 5}, {32, 2048}, {70000, 1}, {1000, 77}})
+  {
+    ExpectMultiplyAdd<TypeParam>(shape, shape, shape, shape);
+  }
+}
+
+TYPED_TEST(ElementwiseKernelTest, broadcast)
+{
+  // a bias against a batch
+  ExpectMultiplyAdd<TypeParam>({13, 9}, {13, 9}, {13, 9}, {13, 1});
+  ExpectMultiplyAdd<TypeParam>({16, 9}, {16, 1}, {16, 9}, {16, 1});
+
+  // a row against a matrix, and scalars
+  ExpectMultiplyAdd<TypeParam>({13, 9}, {1, 9}, {13, 9}, {1, 1});
+  ExpectMultiplyAdd<TypeParam>({40000, 3}, {40000, 3}, {1, 3}, {40000, 1});
+
+  // leading dimensions missing or of size one
+  ExpectMultiplyAdd<TypeParam>({5, 3, 4}, {5, 3, 4}, {3, 4}, {5, 1, 4});
+  ExpectMultiplyAdd<TypeParam>({5, 3, 4}, {1, 3, 1}, {4}, {5, 3, 4});
+}
+
+TYPED_TEST(ElementwiseKernelTest, output_may_be_an_input)
+{
+  auto       a        = MakeArray<TypeParam>({13, 7}, 0);
+  auto const b        = MakeArray<TypeParam>({13, 1}, 3);
+  auto const expected = a + b;
+
+  kernels::Evaluate(a, [](auto const &x, auto const &y, auto &r) { r = x + y; }, a, b);
+
+  EXPECT_TRUE(a.AllClose(expected));
+}
+
+TYPED_TEST(ElementwiseKernelTest, rejects_incompatible_shapes)
+{
+  auto const kernel = [](auto const &x, auto &r) { r = x; };
+
+  TypeParam ret{{13, 7}};
+  EXPECT_THROW(kernels::Evaluate(ret, kernel, TypeParam{{12, 7}}), exceptions::WrongShape);
+  EXPECT_THROW(kernels::Evaluate(ret, kernel, TypeParam{{13, 6}}), exceptions::WrongShape);
+  EXPECT_THROW(kernels::Evaluate(ret, kernel, TypeParam{{1, 13, 7}}), exceptions::WrongShape);
+}
+
+// the overflow is raised on whichever thread evaluates the last elements
+TEST(ElementwiseKernelStateTest, fixed_point_state_is_merged)
+{
+  using DataType   = fixed_point::fp32_t;
+  using TensorType = Tensor<DataType>;
+
+  for (SizeVector const &shape : std::vector<SizeVector>{{13, 7}, {70000, 1}, {32, 2048}})
+  {
+    TensorType x{shape};
+    x.Fill(DataType{2});
+    x.At(shape[0] - 1, shape[1] - 1) = DataType{30000};
+
+    TensorType ret{shape};
+    DataType::StateClear();
+    kernels::Evaluate(ret, [](auto const &a, auto &r) { r = a * a; }, x);
+
+    EXPECT_TRUE(DataType::IsStateOverflow());
+    EXPECT_EQ(ret.data()[0], DataType{4});
+  }
+  DataType::StateClear();
+}
+
+}  // namespace test
+}  // namespace math
+}  // namespace fetch
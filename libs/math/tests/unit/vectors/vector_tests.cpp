@@ -25,9 +25,11 @@
 
 #include "gtest/gtest.h"
 
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace fetch {
 namespace math {
@@ -112,6 +114,12 @@ using MyFPTypes =
                      fetch::vectorise::VectorRegister<fetch::fixed_point::fp32_t, 256>,
                      fetch::vectorise::VectorRegister<fetch::fixed_point::fp64_t, 128>,
                      fetch::vectorise::VectorRegister<fetch::fixed_point::fp64_t, 256>>;
+
+using MyExpTypes =
+    ::testing::Types<fetch::vectorise::VectorRegister<fetch::fixed_point::fp32_t, 32>,
+                     fetch::vectorise::VectorRegister<fetch::fixed_point::fp32_t, 256>,
+                     fetch::vectorise::VectorRegister<fetch::fixed_point::fp64_t, 64>,
+                     fetch::vectorise::VectorRegister<fetch::fixed_point::fp64_t, 256>>;
 #else
 using MyTypes = ::testing::Types<fetch::vectorise::VectorRegister<float, 32>,
                                  fetch::vectorise::VectorRegister<int32_t, 32>,
@@ -123,6 +131,8 @@ using MyTypes = ::testing::Types<fetch::vectorise::VectorRegister<float, 32>,
 using MyFPTypes =
     ::testing::Types<fetch::vectorise::VectorRegister<fetch::fixed_point::fp32_t, 32>,
                      fetch::vectorise::VectorRegister<fetch::fixed_point::fp64_t, 64>>;
+
+using MyExpTypes = MyFPTypes;
 #endif
 
 TYPED_TEST_CASE(VectorRegisterTest, MyTypes);
@@ -221,22 +231,15 @@ TYPED_TEST(VectorRegisterTest, minmax_tests)
   TypeParam va{a};
   TypeParam vb{b};
 
-  auto      vsum  = va + vb;
-  auto      vdiff = va - vb;
-  TypeParam vprod;
-  if (sizeof(type) > 1)
-  {
-    vprod = va * vb;
-  }
-  auto vdiv = va / vb;
+  auto vsum  = va + vb;
+  auto vdiff = va - vb;
+  auto vprod = va * vb;
+  auto vdiv  = va / vb;
 
   TypeParam vtmp1{sum}, vtmp2{diff}, vtmp3{prod}, vtmp4{div};
   EXPECT_TRUE(all_equal_to(vtmp1, vsum));
   EXPECT_TRUE(all_equal_to(vtmp2, vdiff));
-  if (sizeof(type) > 1)
-  {
-    EXPECT_TRUE(all_equal_to(vtmp3, vprod));
-  }
+  EXPECT_TRUE(all_equal_to(vtmp3, vprod));
   EXPECT_TRUE(all_equal_to(vtmp4, vdiv));
 
   type reduce1 = reduce(vsum);
@@ -526,6 +529,142 @@ TYPED_TEST(VectorNaNInfTest, nan_inf_tests)
   }
 }
 
+// Special values, the limits of Exp, multiples of ln2 and a sweep over [-1.25, 1.25] * MAX_EXP
+template <typename type>
+std::vector<type> ExpTestValues()
+{
+  using BaseType = typename type::Type;
+
+  std::vector<type> values{type::NaN,
+                           type::POSITIVE_INFINITY,
+                           type::NEGATIVE_INFINITY,
+                           type::_0,
+                           type::_1,
+                           -type::_1,
+                           type::FP_MAX,
+                           type::FP_MIN,
+                           type::MAX_EXP,
+                           type::MIN_EXP,
+                           type::MAX_EXP + type::CONST_SMALLEST_FRACTION,
+                           type::MIN_EXP - type::CONST_SMALLEST_FRACTION};
+
+  for (BaseType k = 0; k * type::CONST_LN2.Data() < type::MAX_EXP.Data(); ++k)
+  {
+    for (BaseType d = -1; d <= 1; ++d)
+    {
+      values.emplace_back(type::FromBase(k * type::CONST_LN2.Data() + d));
+      values.emplace_back(type::FromBase(-k * type::CONST_LN2.Data() + d));
+    }
+  }
+
+  BaseType const range = type::MAX_EXP.Data() + type::MAX_EXP.Data() / 4;
+  BaseType const step  = range / 4099;
+  for (BaseType x = -range; x < range; x += step)
+  {
+    values.emplace_back(type::FromBase(x));
+  }
+
+  return values;
+}
+
+template <typename TypeParam, typename ScalarFunction, typename VectorFunction>
+void ExpectSameAsScalar(std::vector<typename TypeParam::type> const &values,
+                        ScalarFunction const &scalar_function,
+                        VectorFunction const &vector_function)
+{
+  using type = typename TypeParam::type;
+
+  alignas(32) type A[TypeParam::E_BLOCK_COUNT], C[TypeParam::E_BLOCK_COUNT],
+      D[TypeParam::E_BLOCK_COUNT];
+
+  for (std::size_t j = 0; j + TypeParam::E_BLOCK_COUNT <= values.size(); ++j)
+  {
+    // each register holds a sliding window of the values, so special values share registers
+    uint32_t scalar_state{type::STATE_OK};
+    for (std::size_t i = 0; i < TypeParam::E_BLOCK_COUNT; ++i)
+    {
+      A[i] = values[j + i];
+      type::StateClear();
+      C[i] = scalar_function(A[i]);
+      scalar_state |= type::fp_state;
+    }
+
+    type::StateClear();
+    vector_function(TypeParam(A)).Store(D);
+    EXPECT_EQ(type::fp_state, scalar_state);
+
+    for (std::size_t i = 0; i < TypeParam::E_BLOCK_COUNT; ++i)
+    {
+      EXPECT_EQ(C[i].Data(), D[i].Data()) << "x = " << A[i];
+    }
+  }
+  type::StateClear();
+}
+
+template <typename T>
+class VectorExpTest : public ::testing::Test
+{
+};
+TYPED_TEST_CASE(VectorExpTest, MyExpTypes);
+TYPED_TEST(VectorExpTest, exp_is_bit_exact)
+{
+  using type = typename TypeParam::type;
+
+  ExpectSameAsScalar<TypeParam>(
+      ExpTestValues<type>(), [](type const &x) { return type::Exp(x); },
+      [](TypeParam const &x) { return fetch::vectorise::Exp(x); });
+}
+
+TYPED_TEST(VectorExpTest, tanh_is_bit_exact)
+{
+  using type = typename TypeParam::type;
+
+  ExpectSameAsScalar<TypeParam>(
+      ExpTestValues<type>(), [](type const &x) { return type::TanH(x); },
+      [](TypeParam const &x) { return fetch::vectorise::TanH(x); });
+}
+
+TYPED_TEST(VectorExpTest, sigmoid_is_bit_exact)
+{
+  using type = typename TypeParam::type;
+
+  // as computed by math::Sigmoid
+  auto sigmoid = [](type const &x) {
+    if (x >= type{0})
+    {
+      type const e = type::Exp(-x);
+      return type{1} / (type{1} + e);
+    }
+    type const e = type::Exp(x);
+    return e / (e + type{1});
+  };
+
+  ExpectSameAsScalar<TypeParam>(ExpTestValues<type>(), sigmoid, [](TypeParam const &x) {
+    return fetch::vectorise::Sigmoid(x);
+  });
+}
+
+template <typename T>
+class VectorDivisionTest : public ::testing::Test
+{
+};
+TYPED_TEST_CASE(VectorDivisionTest, MyFPTypes);
+TYPED_TEST(VectorDivisionTest, division_is_bit_exact)
+{
+  using type = typename TypeParam::type;
+
+  std::vector<type> values = ExpTestValues<type>();
+  for (auto const &divisor : {type::NaN, type::POSITIVE_INFINITY, type::NEGATIVE_INFINITY,
+                              type::_0, type::CONST_SMALLEST_FRACTION,
+                              -type::CONST_SMALLEST_FRACTION, type::_half, -type::_1,
+                              type::CONST_E, type::FP_MAX, type::FP_MIN})
+  {
+    ExpectSameAsScalar<TypeParam>(
+        values, [divisor](type const &x) { return x / divisor; },
+        [divisor](TypeParam const &x) { return x / TypeParam(divisor); });
+  }
+}
+
 }  // namespace test
 }  // namespace math
 }  // namespace fetch
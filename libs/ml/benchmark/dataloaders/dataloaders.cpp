@@ -0,0 +1,252 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/random/lcg.hpp"
+#include "math/tensor/tensor.hpp"
+#include "ml/dataloaders/code2vec_context_loaders/context_loader.hpp"
+#include "ml/dataloaders/mapped_dataloader.hpp"
+#include "ml/dataloaders/mapped_dataset.hpp"
+#include "ml/dataloaders/prefetching_dataloader.hpp"
+#include "ml/dataloaders/tensor_dataloader.hpp"
+#include "ml/dataloaders/word2vec_loaders/sgns_w2v_dataloader.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using SizeType   = fetch::math::SizeType;
+using TensorType = fetch::math::Tensor<float>;
+using LoaderPtr  = std::shared_ptr<fetch::ml::dataloaders::DataLoader<TensorType>>;
+
+constexpr SizeType BATCH_SIZE = 64;
+
+std::pair<TensorType, TensorType> MakeTensorData(SizeType num_samples)
+{
+  TensorType data({784, num_samples});
+  TensorType labels({10, num_samples});
+  data.FillUniformRandom();
+  labels.FillUniformRandom();
+
+  return {labels, data};
+}
+
+std::shared_ptr<fetch::ml::dataloaders::TensorDataLoader<TensorType>> MakeTensorLoader()
+{
+  auto const dataset = MakeTensorData(2048);
+
+  auto loader = std::make_shared<fetch::ml::dataloaders::TensorDataLoader<TensorType>>();
+  loader->AddData({dataset.second}, dataset.first);
+  return loader;
+}
+
+// writes the same kind of dataset as MakeTensorData to a mapped dataset file
+std::string MakeMappedDataset(SizeType num_samples)
+{
+  std::string const filename = "benchmark_mapped_dataset_" + std::to_string(num_samples) + ".bin";
+
+  auto const dataset = MakeTensorData(num_samples);
+
+  fetch::ml::dataloaders::MappedDatasetWriter<TensorType> writer{filename, {10}, {{784}},
+                                                                 num_samples};
+  writer.Write(dataset.first, {dataset.second});
+  writer.Close();
+
+  return filename;
+}
+
+std::shared_ptr<fetch::ml::dataloaders::MappedDataLoader<TensorType>> MakeMappedLoader()
+{
+  static auto const filename = MakeMappedDataset(2048);
+
+  return std::make_shared<fetch::ml::dataloaders::MappedDataLoader<TensorType>>(filename);
+}
+
+// the w2v loader drops anything but letters, so spell the word index out in letters
+std::string MakeWord(SizeType index)
+{
+  std::string word{"w"};
+  do
+  {
+    word.push_back(static_cast<char>('a' + (index % 26)));
+    index /= 26;
+  } while (index > 0);
+
+  return word;
+}
+
+std::vector<std::string> MakeSentences(SizeType num_sentences, SizeType sentence_length)
+{
+  fetch::random::LinearCongruentialGenerator rng{};
+
+  std::vector<std::string> sentences{};
+  for (SizeType i = 0; i < num_sentences; ++i)
+  {
+    std::ostringstream sentence;
+    for (SizeType j = 0; j < sentence_length; ++j)
+    {
+      sentence << MakeWord(rng() % 500) << ' ';
+    }
+    sentences.emplace_back(sentence.str());
+  }
+
+  return sentences;
+}
+
+std::shared_ptr<fetch::ml::dataloaders::GraphW2VLoader<TensorType>> MakeW2VLoader()
+{
+  static auto const sentences = MakeSentences(200, 50);
+
+  auto loader = std::make_shared<fetch::ml::dataloaders::GraphW2VLoader<TensorType>>(
+      5, 5, fetch::fixed_point::fp64_t{1}, 1000000);
+  loader->BuildVocabAndData(sentences);
+  loader->InitUnigramTable(100000, false);
+  return loader;
+}
+
+std::shared_ptr<fetch::ml::dataloaders::C2VLoader<TensorType>> MakeC2VLoader()
+{
+  fetch::random::LinearCongruentialGenerator rng{};
+
+  std::ostringstream data;
+  for (SizeType function = 0; function < 500; ++function)
+  {
+    data << "function" << function;
+    for (SizeType context = 0; context < 20; ++context)
+    {
+      data << " word" << (rng() % 200) << ',' << (rng() % 1000) << ",word" << (rng() % 200);
+    }
+    data << '\n';
+  }
+
+  auto loader = std::make_shared<fetch::ml::dataloaders::C2VLoader<TensorType>>(20);
+  loader->AddDataAsString(data.str());
+  return loader;
+}
+
+// stands in for the forward and backward pass of a training step
+void Train(std::chrono::microseconds duration)
+{
+  auto const end = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < end)
+  {
+  }
+}
+
+/**
+ * range(0): 0 for the synchronous loader, otherwise the ring size of the prefetching loader
+ * range(1): microseconds of simulated training per batch
+ */
+void RunBatches(benchmark::State &state, LoaderPtr loader)
+{
+  if (state.range(0) != 0)
+  {
+    loader = std::make_shared<fetch::ml::dataloaders::PrefetchingDataLoader<TensorType>>(
+        loader, static_cast<SizeType>(state.range(0)));
+  }
+
+  std::chrono::microseconds const step{state.range(1)};
+
+  for (auto _ : state)
+  {
+    bool is_done_set{false};
+    auto batch = loader->PrepareBatch(BATCH_SIZE, is_done_set);
+    benchmark::DoNotOptimize(batch.first.data());
+
+    Train(step);
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(BATCH_SIZE));
+}
+
+void BM_TensorLoader(benchmark::State &state)
+{
+  RunBatches(state, MakeTensorLoader());
+}
+
+void BM_MappedLoader(benchmark::State &state)
+{
+  RunBatches(state, MakeMappedLoader());
+}
+
+void BM_W2VLoader(benchmark::State &state)
+{
+  RunBatches(state, MakeW2VLoader());
+}
+
+void BM_C2VLoader(benchmark::State &state)
+{
+  RunBatches(state, MakeC2VLoader());
+}
+
+void CreateRanges(benchmark::internal::Benchmark *b)
+{
+  for (int64_t ring_size : {0, 4})
+  {
+    for (int64_t step : {0, 200})
+    {
+      b->Args({ring_size, step});
+    }
+  }
+}
+
+/**
+ * Time taken for a loader to be ready to produce batches, given a dataset of range(0) samples
+ */
+void BM_TensorLoaderStartup(benchmark::State &state)
+{
+  auto const num_samples = static_cast<SizeType>(state.range(0));
+  auto const dataset     = MakeTensorData(num_samples);
+
+  for (auto _ : state)
+  {
+    fetch::ml::dataloaders::TensorDataLoader<TensorType> loader;
+    loader.AddData({dataset.second}, dataset.first);
+    benchmark::DoNotOptimize(loader.Size());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_MappedLoaderStartup(benchmark::State &state)
+{
+  auto const filename = MakeMappedDataset(static_cast<SizeType>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    fetch::ml::dataloaders::MappedDataLoader<TensorType> loader{filename};
+    benchmark::DoNotOptimize(loader.Size());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK(BM_TensorLoader)->Apply(CreateRanges)->UseRealTime();
+BENCHMARK(BM_MappedLoader)->Apply(CreateRanges)->UseRealTime();
+BENCHMARK(BM_W2VLoader)->Apply(CreateRanges)->UseRealTime();
+BENCHMARK(BM_C2VLoader)->Apply(CreateRanges)->UseRealTime();
+
+BENCHMARK(BM_TensorLoaderStartup)->Arg(2048)->Arg(32768)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MappedLoaderStartup)->Arg(2048)->Arg(32768)->Unit(benchmark::kMicrosecond);
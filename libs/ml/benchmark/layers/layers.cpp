@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/tensor/tensor.hpp"
+#include "ml/core/graph.hpp"
+#include "ml/layers/fully_connected.hpp"
+#include "ml/ops/placeholder.hpp"
+#include "ml/ops/tanh.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <memory>
+#include <string>
+
+namespace {
+
+using SizeType = fetch::math::SizeType;
+
+/**
+ * A fully connected layer, of which the bias add is broadcast along the batch, followed by a tanh
+ */
+template <typename TensorType>
+struct LayerGraph
+{
+  LayerGraph(SizeType batch_size, SizeType input_size, SizeType output_size)
+    : graph(std::make_shared<fetch::ml::Graph<TensorType>>())
+  {
+    input = graph->template AddNode<fetch::ml::ops::PlaceHolder<TensorType>>("Input", {});
+
+    std::string layer = graph->template AddNode<fetch::ml::layers::FullyConnected<TensorType>>(
+        "FC", {input}, input_size, output_size);
+    output = graph->template AddNode<fetch::ml::ops::TanH<TensorType>>("TanH", {layer});
+    graph->Compile();
+
+    data = TensorType({input_size, batch_size});
+    data.FillUniformRandom();
+    graph->SetInput(input, data);
+
+    error_signal = TensorType({output_size, batch_size});
+    error_signal.FillUniformRandom();
+  }
+
+  std::shared_ptr<fetch::ml::Graph<TensorType>> graph;
+  std::string                                   input;
+  std::string                                   output;
+  TensorType                                    data;
+  TensorType                                    error_signal;
+};
+
+}  // namespace
+
+template <typename T, SizeType B, SizeType I, SizeType O>
+void BM_FullyConnectedForward(benchmark::State &state)
+{
+  using TensorType = fetch::math::Tensor<T>;
+
+  LayerGraph<TensorType> layer(B, I, O);
+
+  for (auto _ : state)
+  {
+    // setting the input clears the cached outputs of the nodes
+    layer.graph->SetInput(layer.input, layer.data);
+    benchmark::DoNotOptimize(layer.graph->Evaluate(layer.output, false));
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_FullyConnectedForward, float, 32, 128, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FullyConnectedForward, float, 128, 512, 512)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FullyConnectedForward, float, 1024, 64, 64)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FullyConnectedForward, fetch::fixed_point::fp32_t, 32, 128, 128)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FullyConnectedForward, fetch::fixed_point::fp32_t, 128, 512, 512)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FullyConnectedForward, fetch::fixed_point::fp32_t, 1024, 64, 64)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FullyConnectedForward, fetch::fixed_point::fp64_t, 32, 128, 128)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FullyConnectedForward, fetch::fixed_point::fp64_t, 1024, 64, 64)
+    ->Unit(benchmark::kMicrosecond);
+
+template <typename T, SizeType B, SizeType I, SizeType O>
+void BM_FullyConnectedBackward(benchmark::State &state)
+{
+  using TensorType = fetch::math::Tensor<T>;
+
+  LayerGraph<TensorType> layer(B, I, O);
+  layer.graph->Evaluate(layer.output, true);
+
+  for (auto _ : state)
+  {
+    layer.graph->BackPropagate(layer.output, layer.error_signal);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_FullyConnectedBackward, float, 32, 128, 128)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FullyConnectedBackward, float, 1024, 64, 64)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FullyConnectedBackward, fetch::fixed_point::fp32_t, 32, 128, 128)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FullyConnectedBackward, fetch::fixed_point::fp32_t, 1024, 64, 64)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
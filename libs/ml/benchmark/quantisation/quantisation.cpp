@@ -0,0 +1,152 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/tensor/tensor.hpp"
+#include "ml/core/graph.hpp"
+#include "ml/layers/convolution_1d.hpp"
+#include "ml/layers/fully_connected.hpp"
+#include "ml/ops/activation.hpp"
+#include "ml/ops/placeholder.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <memory>
+#include <string>
+
+/**
+ * Inference latency and size of the weights of float, fixed point and quantised graphs. The
+ * quantised graphs are the float or fixed point graph after Graph::Quantise.
+ */
+
+namespace {
+
+using SizeType = fetch::math::SizeType;
+
+/**
+ * Two fully connected layers with a relu in between
+ */
+template <typename TensorType>
+struct DenseGraph
+{
+  DenseGraph(SizeType batch_size, SizeType input_size, SizeType hidden_size, SizeType output_size)
+    : graph(std::make_shared<fetch::ml::Graph<TensorType>>())
+  {
+    input = graph->template AddNode<fetch::ml::ops::PlaceHolder<TensorType>>("Input", {});
+
+    std::string hidden = graph->template AddNode<fetch::ml::layers::FullyConnected<TensorType>>(
+        "FC1", {input}, input_size, hidden_size, fetch::ml::details::ActivationType::RELU);
+    output = graph->template AddNode<fetch::ml::layers::FullyConnected<TensorType>>(
+        "FC2", {hidden}, hidden_size, output_size);
+    graph->Compile();
+
+    data = TensorType({input_size, batch_size});
+    data.FillUniformRandom();
+  }
+
+  std::shared_ptr<fetch::ml::Graph<TensorType>> graph;
+  std::string                                   input;
+  std::string                                   output;
+  TensorType                                    data;
+};
+
+/**
+ * A 1D convolution layer with a relu
+ */
+template <typename TensorType>
+struct ConvolutionGraph
+{
+  ConvolutionGraph(SizeType batch_size, SizeType input_channels, SizeType length,
+                   SizeType output_channels, SizeType kernel_size)
+    : graph(std::make_shared<fetch::ml::Graph<TensorType>>())
+  {
+    input = graph->template AddNode<fetch::ml::ops::PlaceHolder<TensorType>>("Input", {});
+
+    output = graph->template AddNode<fetch::ml::layers::Convolution1D<TensorType>>(
+        "Conv1D", {input}, output_channels, input_channels, kernel_size, SizeType{1},
+        fetch::ml::details::ActivationType::RELU);
+    graph->Compile();
+
+    data = TensorType({input_channels, length, batch_size});
+    data.FillUniformRandom();
+  }
+
+  std::shared_ptr<fetch::ml::Graph<TensorType>> graph;
+  std::string                                   input;
+  std::string                                   output;
+  TensorType                                    data;
+};
+
+template <typename GraphType>
+void RunInference(benchmark::State &state, GraphType &g, bool quantised)
+{
+  if (quantised)
+  {
+    g.graph->Quantise();
+  }
+
+  for (auto _ : state)
+  {
+    // setting the input clears the cached outputs of the nodes
+    g.graph->SetInput(g.input, g.data);
+    benchmark::DoNotOptimize(g.graph->Evaluate(g.output, false));
+  }
+
+  state.counters["weights_bytes"] = static_cast<double>(g.graph->WeightsSizeInBytes());
+}
+
+}  // namespace
+
+template <typename T, bool Q, SizeType B, SizeType I, SizeType H, SizeType O>
+void BM_DenseInference(benchmark::State &state)
+{
+  DenseGraph<fetch::math::Tensor<T>> g(B, I, H, O);
+  RunInference(state, g, Q);
+}
+
+BENCHMARK_TEMPLATE(BM_DenseInference, float, false, 1, 784, 256, 10)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DenseInference, float, true, 1, 784, 256, 10)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DenseInference, fetch::fixed_point::fp32_t, false, 1, 784, 256, 10)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DenseInference, fetch::fixed_point::fp32_t, true, 1, 784, 256, 10)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DenseInference, float, false, 64, 784, 256, 10)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DenseInference, float, true, 64, 784, 256, 10)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DenseInference, fetch::fixed_point::fp32_t, false, 64, 784, 256, 10)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DenseInference, fetch::fixed_point::fp32_t, true, 64, 784, 256, 10)
+    ->Unit(benchmark::kMicrosecond);
+
+template <typename T, bool Q, SizeType B, SizeType C, SizeType L, SizeType O, SizeType K>
+void BM_ConvolutionInference(benchmark::State &state)
+{
+  ConvolutionGraph<fetch::math::Tensor<T>> g(B, C, L, O, K);
+  RunInference(state, g, Q);
+}
+
+BENCHMARK_TEMPLATE(BM_ConvolutionInference, float, false, 8, 32, 128, 64, 5)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_ConvolutionInference, float, true, 8, 32, 128, 64, 5)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_ConvolutionInference, fetch::fixed_point::fp32_t, false, 8, 32, 128, 64, 5)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_ConvolutionInference, fetch::fixed_point::fp32_t, true, 8, 32, 128, 64, 5)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
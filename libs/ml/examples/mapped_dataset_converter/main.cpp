@@ -0,0 +1,359 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/base_types.hpp"
+#include "math/tensor/tensor.hpp"
+#include "ml/dataloaders/mapped_dataset.hpp"
+#include "ml/dataloaders/word2vec_loaders/sgns_w2v_dataloader.hpp"
+#include "ml/utilities/mnist_utilities.hpp"
+#include "ml/utilities/word2vec_utilities.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using DataType   = fetch::fixed_point::FixedPoint<32, 32>;
+using TensorType = fetch::math::Tensor<DataType>;
+using SizeType   = fetch::math::SizeType;
+using SizeVector = fetch::math::SizeVector;
+using WriterType = fetch::ml::dataloaders::MappedDatasetWriter<TensorType>;
+
+namespace {
+
+constexpr SizeType BATCH_SIZE = 1024;
+
+/**
+ * Collects single samples into batches for the writer
+ */
+class Batcher
+{
+public:
+  using BatchType = std::pair<TensorType, std::vector<TensorType>>;
+
+  Batcher(SizeVector const &label_shape, std::vector<SizeVector> const &data_shapes)
+  {
+    batch_.first = MakeBatch(label_shape);
+    for (auto const &shape : data_shapes)
+    {
+      batch_.second.emplace_back(MakeBatch(shape));
+    }
+  }
+
+  /// Adds a sample, returning true once the batch is full
+  bool Add(TensorType const &label, std::vector<TensorType> const &data)
+  {
+    auto label_view = batch_.first.View(position_);
+    label_view.Assign(label);
+
+    for (SizeType i = 0; i < data.size(); ++i)
+    {
+      auto data_view = batch_.second.at(i).View(position_);
+      data_view.Assign(data.at(i));
+    }
+
+    ++position_;
+    return position_ == BATCH_SIZE;
+  }
+
+  bool empty() const
+  {
+    return position_ == 0;
+  }
+
+  /// Returns the samples added since the last call, which may be fewer than a full batch
+  BatchType Take()
+  {
+    BatchType batch{Shrink(batch_.first), {}};
+    for (auto const &tensor : batch_.second)
+    {
+      batch.second.emplace_back(Shrink(tensor));
+    }
+
+    position_ = 0;
+    return batch;
+  }
+
+private:
+  static TensorType MakeBatch(SizeVector shape)
+  {
+    shape.emplace_back(BATCH_SIZE);
+    return TensorType{shape};
+  }
+
+  TensorType Shrink(TensorType const &tensor) const
+  {
+    SizeVector shape = tensor.shape();
+    shape.back()     = position_;
+
+    TensorType batch{shape};
+    for (SizeType i = 0; i < position_; ++i)
+    {
+      auto view = batch.View(i);
+      view.Assign(tensor.View(i));
+    }
+
+    return batch;
+  }
+
+  BatchType batch_{};
+  SizeType  position_{0};
+};
+
+std::vector<std::string> SplitRow(std::string const &line)
+{
+  std::vector<std::string> fields;
+  std::stringstream        stream(line);
+  std::string              field;
+
+  while (std::getline(stream, field, ','))
+  {
+    fields.emplace_back(field);
+  }
+
+  return fields;
+}
+
+/**
+ * Converts the mnist image and label files, with the labels one hot encoded
+ */
+void ConvertMnist(std::string const &images_file, std::string const &labels_file,
+                  std::string const &output_file)
+{
+  auto images = fetch::ml::utilities::read_mnist_images<TensorType>(images_file);
+  auto labels = fetch::ml::utilities::read_mnist_labels<TensorType>(labels_file);
+  labels      = fetch::ml::utilities::convert_labels_to_onehot(labels);
+
+  SizeType const num_samples = images.shape().back();
+
+  WriterType writer{output_file,
+                    {labels.shape().at(0)},
+                    {{images.shape().at(0), images.shape().at(1)}},
+                    num_samples};
+  writer.Write(labels, {images});
+  writer.Close();
+}
+
+/**
+ * Converts a csv file of numbers, one sample per row. The first label_columns columns of each row
+ * hold the label, the rest the data. The file is streamed in batches, so it need not fit in memory
+ */
+void ConvertCsv(std::string const &input_file, std::string const &output_file,
+                SizeType label_columns, bool skip_header)
+{
+  std::ifstream input(input_file);
+  if (!input.is_open())
+  {
+    throw std::runtime_error("Cannot open file `" + input_file + "`");
+  }
+
+  // first pass, count the samples
+  std::string line;
+  SizeType    num_columns{0};
+  SizeType    num_samples{0};
+  bool        header{skip_header};
+
+  while (std::getline(input, line))
+  {
+    if (header || line.empty())
+    {
+      header = false;
+      continue;
+    }
+
+    if (num_columns == 0)
+    {
+      num_columns = SplitRow(line).size();
+    }
+
+    ++num_samples;
+  }
+
+  if ((num_samples == 0) || (num_columns <= label_columns))
+  {
+    throw std::runtime_error("No label and data columns found in `" + input_file + "`");
+  }
+
+  // second pass, write the samples out a batch at a time
+  input.clear();
+  input.seekg(0);
+  header = skip_header;
+
+  SizeType const data_columns = num_columns - label_columns;
+  WriterType     writer{output_file, {label_columns}, {{data_columns}}, num_samples};
+  Batcher        batcher{{label_columns}, {{data_columns}}};
+
+  TensorType labels({label_columns, 1});
+  TensorType data({data_columns, 1});
+
+  while (std::getline(input, line))
+  {
+    if (header || line.empty())
+    {
+      header = false;
+      continue;
+    }
+
+    auto const fields = SplitRow(line);
+    if (fields.size() != num_columns)
+    {
+      throw std::runtime_error("Row with " + std::to_string(fields.size()) +
+                               " columns, expected " + std::to_string(num_columns));
+    }
+
+    for (SizeType i = 0; i < num_columns; ++i)
+    {
+      auto const value = fetch::math::Type<DataType>(fields.at(i));
+
+      if (i < label_columns)
+      {
+        labels.At(i, 0) = value;
+      }
+      else
+      {
+        data.At(i - label_columns, 0) = value;
+      }
+    }
+
+    if (batcher.Add(labels, {data}))
+    {
+      auto const batch = batcher.Take();
+      writer.Write(batch.first, batch.second);
+    }
+  }
+
+  if (!batcher.empty())
+  {
+    auto const batch = batcher.Take();
+    writer.Write(batch.first, batch.second);
+  }
+
+  writer.Close();
+}
+
+/**
+ * Runs a skipgram dataloader over a text corpus for one epoch and writes out the samples, so that
+ * training can start from the mapped dataset rather than rebuilding the vocabulary and samples
+ */
+void ConvertWord2Vec(std::string const &corpus_file, std::string const &output_file,
+                     SizeType window_size, SizeType negative_samples)
+{
+  fetch::ml::dataloaders::GraphW2VLoader<TensorType> loader(
+      window_size, negative_samples, fetch::math::Type<fetch::fixed_point::fp64_t>("0.001"),
+      fetch::math::numeric_max<SizeType>());
+  loader.BuildVocabAndData({fetch::ml::utilities::ReadFile(corpus_file)});
+  loader.InitUnigramTable();
+  loader.SaveVocab(output_file + ".vocab");
+
+  auto const without_batch = [](TensorType const &tensor) {
+    SizeVector shape = tensor.shape();
+    shape.pop_back();
+    return shape;
+  };
+
+  // subsampling and negative sampling are random, so the samples are collected over a single
+  // epoch before the dataset is laid out
+  auto sample = loader.GetNext();
+
+  SizeVector              label_shape = without_batch(sample.first);
+  std::vector<SizeVector> data_shapes{};
+  for (auto const &tensor : sample.second)
+  {
+    data_shapes.emplace_back(without_batch(tensor));
+  }
+
+  Batcher                         batcher{label_shape, data_shapes};
+  std::vector<Batcher::BatchType> batches{};
+  SizeType                        num_samples{0};
+
+  for (;;)
+  {
+    ++num_samples;
+    if (batcher.Add(sample.first, sample.second))
+    {
+      batches.emplace_back(batcher.Take());
+    }
+
+    if (loader.IsDone())
+    {
+      break;
+    }
+
+    sample = loader.GetNext();
+  }
+
+  if (!batcher.empty())
+  {
+    batches.emplace_back(batcher.Take());
+  }
+
+  WriterType writer{output_file, label_shape, data_shapes, num_samples};
+  for (auto const &batch : batches)
+  {
+    writer.Write(batch.first, batch.second);
+  }
+
+  writer.Close();
+}
+
+}  // namespace
+
+int main(int ac, char **av)
+{
+  if (ac < 2)
+  {
+    std::cout << "Usage : " << av[0] << " mnist IMAGES LABELS OUTPUT" << std::endl;
+    std::cout << "        " << av[0] << " csv INPUT OUTPUT LABEL_COLUMNS [header]" << std::endl;
+    std::cout << "        " << av[0] << " w2v CORPUS OUTPUT [WINDOW_SIZE] [NEGATIVE_SAMPLES]"
+              << std::endl;
+    return 1;
+  }
+
+  std::string const format{av[1]};
+  std::string       output_file{};
+
+  if ((format == "mnist") && (ac == 5))
+  {
+    output_file = av[4];
+    ConvertMnist(av[2], av[3], output_file);
+  }
+  else if ((format == "csv") && ((ac == 5) || (ac == 6)))
+  {
+    output_file = av[3];
+    bool const skip_header = (ac == 6) && (std::string{av[5]} == "header");
+    ConvertCsv(av[2], output_file, std::stoul(av[4]), skip_header);
+  }
+  else if ((format == "w2v") && (ac >= 4) && (ac <= 6))
+  {
+    output_file = av[3];
+    SizeType const window_size      = (ac > 4) ? std::stoul(av[4]) : 2;
+    SizeType const negative_samples = (ac > 5) ? std::stoul(av[5]) : 5;
+    ConvertWord2Vec(av[2], output_file, window_size, negative_samples);
+  }
+  else
+  {
+    std::cout << "Unknown format or wrong number of arguments" << std::endl;
+    return 1;
+  }
+
+  std::cout << "Wrote " << output_file << std::endl;
+  return 0;
+}
@@ -121,6 +121,14 @@ public:
   void       ApplySparseGradients(std::vector<TensorType> &grad, std::vector<SizeSet> &update_rows);
   void       SetWeight(std::string const &node_name, TensorType const &data);
 
+  /////////////////////////////////////
+  /// public quantisation functions ///
+  /////////////////////////////////////
+
+  void     Quantise();
+  void     Dequantise();
+  SizeType WeightsSizeInBytes();
+
   //////////////////////////////////////////////////////
   /// public serialisation & weight export functions ///
   //////////////////////////////////////////////////////
@@ -199,6 +207,9 @@ private:
   template <typename TensorIteratorType>
   void ApplyGradients(TensorIteratorType &grad_it);
 
+  template <typename Function>
+  void ApplyToQuantisables(Function const &function);
+
   template <typename TensorIteratorType, typename VectorIteratorType>
   void ApplySparseGradients(TensorIteratorType &grad_it, VectorIteratorType &rows_it);
 
@@ -0,0 +1,92 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ml/dataloaders/mapped_dataset.hpp"
+#include "ml/dataloaders/tensor_dataloader.hpp"
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#pragma GCC diagnostic ignored "-Wpedantic"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#include "mio/mmap.hpp"
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace dataloaders {
+
+/**
+ * Dataloader over a mapped dataset file (see MappedDatasetLayout), as written by
+ * MappedDatasetWriter.
+ *
+ * The file is mapped read only rather than loaded, so construction only reads the header and the
+ * dataset may be larger than memory; the operating system pages samples in as they are used.
+ * PrepareBatch copies each sample straight from the mapping into the batch tensors, which are
+ * reused between calls while the batch size stays the same.
+ *
+ * Test and validation splits, random mode and cursors behave as for the TensorDataLoader.
+ */
+template <typename TensorType>
+class MappedDataLoader : public TensorDataLoader<TensorType>
+{
+public:
+  using SizeType   = fetch::math::SizeType;
+  using SizeVector = fetch::math::SizeVector;
+  using DataType   = typename TensorType::Type;
+  using ReturnType = std::pair<TensorType, std::vector<TensorType>>;
+
+  explicit MappedDataLoader(std::string const &filename);
+  MappedDataLoader(MappedDataLoader const &) = delete;
+  MappedDataLoader(MappedDataLoader &&)      = delete;
+  ~MappedDataLoader() override               = default;
+
+  ReturnType GetNext() override;
+  ReturnType PrepareBatch(SizeType batch_size, bool &is_done_set) override;
+
+  bool AddData(std::vector<TensorType> const &data, TensorType const &labels) override;
+
+  LoaderType LoaderCode() override
+  {
+    return LoaderType::MAPPED;
+  }
+
+  MappedDataLoader &operator=(MappedDataLoader const &) = delete;
+  MappedDataLoader &operator=(MappedDataLoader &&) = delete;
+
+private:
+  void CopySample(SizeType column, SizeType sample, TensorType &tensor, SizeType position) const;
+  TensorType MakeTensor(SizeType column, SizeType batch_size) const;
+
+  mio::mmap_source    map_{};
+  MappedDatasetLayout layout_{};
+  ReturnType          batch_{};  ///< Batch tensors returned by PrepareBatch
+};
+
+}  // namespace dataloaders
+}  // namespace ml
+}  // namespace fetch
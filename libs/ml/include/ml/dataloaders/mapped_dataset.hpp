@@ -0,0 +1,173 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/base_types.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace dataloaders {
+
+/**
+ * Layout of a mapped dataset file, a columnar format which is read by MappedDataLoader straight
+ * out of a memory mapping of the file.
+ *
+ *   ┌─────────────┬────────────────────┬──────────┬──────────┬─────┬──────────┐
+ *   │ header (32) │ column descriptors │ column 0 │ column 1 │ ... │ column N │
+ *   └─────────────┴────────────────────┴──────────┴──────────┴─────┴──────────┘
+ *
+ *   header:             magic "FETCHMLD" (8), version (4), element type (4), element size (4),
+ *                       number of columns (4), number of samples (8)
+ *   column descriptor:  offset (8), rank (8), dimensions (8 * rank)
+ *
+ * Column 0 holds the labels and columns 1 to N hold the data inputs. The shape of a column is the
+ * shape of a single sample, without the trailing batch dimension. Each column stores the samples
+ * one after another, with the elements of a sample in the (column major) order of the tensor and
+ * no padding. Columns start at 64 byte aligned offsets. All values are in host byte order.
+ */
+struct MappedDatasetLayout
+{
+  using SizeType   = fetch::math::SizeType;
+  using SizeVector = fetch::math::SizeVector;
+
+  static constexpr uint32_t VERSION     = 1;
+  static constexpr SizeType HEADER_SIZE = 32;
+  static constexpr SizeType ALIGNMENT   = 64;
+
+  uint32_t                element_type{0};
+  uint32_t                element_size{0};
+  SizeType                num_samples{0};
+  std::vector<SizeVector> shapes{};   ///< Shape of a single sample in each column
+  std::vector<SizeType>   offsets{};  ///< Offset of each column from the start of the file
+
+  SizeType SampleElements(SizeType column) const;
+  SizeType SampleBytes(SizeType column) const;
+  SizeType FileSize() const;
+
+  void                       ComputeOffsets();
+  std::vector<uint8_t>       Encode() const;
+  static MappedDatasetLayout Decode(uint8_t const *data, SizeType size);
+};
+
+/**
+ * Identifies the element type of a mapped dataset, so that a file is only ever read back as the
+ * type it was written with.
+ */
+template <typename T>
+constexpr uint32_t MappedElementType();
+
+template <>
+constexpr uint32_t MappedElementType<int8_t>()
+{
+  return 1;
+}
+
+template <>
+constexpr uint32_t MappedElementType<int16_t>()
+{
+  return 2;
+}
+
+template <>
+constexpr uint32_t MappedElementType<int32_t>()
+{
+  return 3;
+}
+
+template <>
+constexpr uint32_t MappedElementType<int64_t>()
+{
+  return 4;
+}
+
+template <>
+constexpr uint32_t MappedElementType<float>()
+{
+  return 5;
+}
+
+template <>
+constexpr uint32_t MappedElementType<double>()
+{
+  return 6;
+}
+
+template <>
+constexpr uint32_t MappedElementType<fixed_point::fp32_t>()
+{
+  return 7;
+}
+
+template <>
+constexpr uint32_t MappedElementType<fixed_point::fp64_t>()
+{
+  return 8;
+}
+
+template <>
+constexpr uint32_t MappedElementType<fixed_point::fp128_t>()
+{
+  return 9;
+}
+
+/**
+ * Writes a mapped dataset file. The number of samples is fixed up front so that the columns can be
+ * laid out, after which batches of samples are streamed into the file, so a dataset does not need
+ * to fit into memory to be converted.
+ */
+template <typename TensorType>
+class MappedDatasetWriter
+{
+public:
+  using SizeType   = fetch::math::SizeType;
+  using SizeVector = fetch::math::SizeVector;
+  using DataType   = typename TensorType::Type;
+
+  MappedDatasetWriter(std::string const &filename, SizeVector const &label_shape,
+                      std::vector<SizeVector> const &data_shapes, SizeType num_samples);
+  MappedDatasetWriter(MappedDatasetWriter const &) = delete;
+  MappedDatasetWriter(MappedDatasetWriter &&)      = delete;
+  ~MappedDatasetWriter();
+
+  void Write(TensorType const &labels, std::vector<TensorType> const &data);
+  void Close();
+
+  SizeType size() const;
+
+  MappedDatasetWriter &operator=(MappedDatasetWriter const &) = delete;
+  MappedDatasetWriter &operator=(MappedDatasetWriter &&) = delete;
+
+private:
+  void WriteColumn(SizeType column, TensorType const &tensor);
+
+  std::string           filename_;
+  MappedDatasetLayout   layout_{};
+  std::ofstream         file_{};
+  SizeType              written_{0};  ///< Number of samples written so far
+  std::vector<DataType> buffer_{};
+};
+
+}  // namespace dataloaders
+}  // namespace ml
+}  // namespace fetch
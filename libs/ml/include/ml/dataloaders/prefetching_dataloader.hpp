@@ -0,0 +1,150 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/random/lcg.hpp"
+#include "ml/dataloaders/dataloader.hpp"
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace dataloaders {
+
+/**
+ * Wraps another dataloader and assembles its batches on a background thread, ahead of the
+ * training thread asking for them.
+ *
+ * Batches are written into a ring of preallocated tensors, in the order that the wrapped loader
+ * produces its samples, so the batches (and is_done_set) returned by PrepareBatch are the same as
+ * those returned by the wrapped loader's own PrepareBatch. A batch returned by PrepareBatch stays
+ * valid until the next call. Prefetching pauses at the end of each epoch, so the wrapped loader
+ * never runs into the next epoch before the optimiser has finished the current one.
+ *
+ * Optionally samples are shuffled through a buffer of the given size. The shuffle is seeded with
+ * SetSeed, so for a given seed the order of the batches is deterministic.
+ *
+ * Changing the mode, the batch size or the wrapped loader's settings drops any batches which have
+ * been prefetched but not yet returned. The pipeline is stopped at the point at which the ring is
+ * full (or prefetching has paused), so the samples dropped are also deterministic.
+ */
+template <typename TensorType>
+class PrefetchingDataLoader : public DataLoader<TensorType>
+{
+public:
+  using SizeType      = fetch::math::SizeType;
+  using ReturnType    = std::pair<TensorType, std::vector<TensorType>>;
+  using DataLoaderPtr = std::shared_ptr<DataLoader<TensorType>>;
+
+  static constexpr SizeType DEFAULT_RING_SIZE = 4;
+
+  explicit PrefetchingDataLoader(DataLoaderPtr loader, SizeType ring_size = DEFAULT_RING_SIZE,
+                                 SizeType shuffle_buffer_size = 0);
+  PrefetchingDataLoader(PrefetchingDataLoader const &) = delete;
+  PrefetchingDataLoader(PrefetchingDataLoader &&)      = delete;
+  ~PrefetchingDataLoader() override;
+
+  ReturnType GetNext() override;
+  ReturnType PrepareBatch(SizeType batch_size, bool &is_done_set) override;
+
+  bool AddData(std::vector<TensorType> const &data, TensorType const &label) override;
+
+  SizeType Size() const override;
+  bool     IsDone() const override;
+  void     Reset() override;
+  void     SetTestRatio(fixed_point::fp32_t new_test_ratio) override;
+  void     SetValidationRatio(fixed_point::fp32_t new_validation_ratio) override;
+  void     SetMode(DataLoaderMode new_mode) override;
+  bool     IsModeAvailable(DataLoaderMode mode) override;
+  void     SetRandomMode(bool random_mode_state) override;
+  void     SetSeed(SizeType seed) override;
+
+  LoaderType LoaderCode() override
+  {
+    return LoaderType::PREFETCHING;
+  }
+
+  PrefetchingDataLoader &operator=(PrefetchingDataLoader const &) = delete;
+  PrefetchingDataLoader &operator=(PrefetchingDataLoader &&) = delete;
+
+protected:
+  void UpdateCursor() override;
+
+private:
+  struct Slot
+  {
+    ReturnType         batch;
+    bool               is_done_set{false};  ///< The wrapped loader was reset during the batch
+    bool               is_done{false};      ///< The wrapped loader is done after the batch
+    std::exception_ptr error{};
+  };
+
+  using SizeVector = fetch::math::SizeVector;
+  using Slots      = std::vector<Slot>;
+  using Samples    = std::vector<ReturnType>;
+
+  /// @name Pipeline control - only called from the training thread
+  /// @{
+  void Start(SizeType batch_size);
+  void Stop(bool wait_until_idle = true);
+  bool CanProduce() const;
+  /// @}
+
+  /// @name Producer - not thread safe
+  /// @{
+  void       Run();
+  void       FillBatch(Slot &slot);
+  bool       SourceDone() const;
+  void       ResetSource();
+  ReturnType NextSample();
+  /// @}
+
+  DataLoaderPtr  loader_;
+  SizeType const ring_size_;
+  SizeType const shuffle_buffer_size_;
+
+  // producer state, only accessed by the worker while it is running
+  Samples                                    shuffle_buffer_{};
+  fetch::random::LinearCongruentialGenerator shuffle_rng_{};
+
+  SizeVector              label_shape_{};  ///< Shape of a single label, as returned by GetNext
+  std::vector<SizeVector> data_shapes_{};  ///< Shapes of a single sample's data tensors
+
+  mutable std::mutex      lock_;
+  std::condition_variable condition_;
+  std::thread             worker_;
+  Slots                   ring_{};
+  SizeType                batch_size_{0};
+  SizeType                produced_{0};  ///< Number of batches written into the ring
+  SizeType                released_{0};  ///< Number of slots handed back by the training thread
+  SizeType                paused_at_{0};  ///< Number of batches produced when prefetching paused
+  bool                    holding_{false};  ///< The last returned batch still occupies its slot
+  bool                    paused_{false};   ///< Paused at the end of an epoch or on an error
+  bool                    idle_{false};     ///< The worker is waiting for space in the ring
+  bool                    stop_{false};
+  bool                    is_done_{false};  ///< IsDone as of the last returned batch
+};
+
+}  // namespace dataloaders
+}  // namespace ml
+}  // namespace fetch
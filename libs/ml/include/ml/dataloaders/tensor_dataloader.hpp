@@ -87,8 +87,9 @@ protected:
   std::shared_ptr<SizeType> validation_count_ = std::make_shared<SizeType>(0);
   std::shared_ptr<SizeType> count_            = train_count_;
 
-  void UpdateRanges();
-  void UpdateCursor() override;
+  void     UpdateRanges();
+  void     UpdateCursor() override;
+  SizeType NextIndex();
 };
 
 }  // namespace dataloaders
@@ -39,7 +39,9 @@ enum class LoaderType : uint8_t
   SGNS,
   W2V,
   COMMODITY,
-  C2V
+  C2V,
+  PREFETCHING,
+  MAPPED
 };
 
 enum class SliceType : uint8_t
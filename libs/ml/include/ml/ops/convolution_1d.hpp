@@ -18,6 +18,7 @@
 //------------------------------------------------------------------------------
 
 #include "ml/ops/ops.hpp"
+#include "ml/ops/quantisable.hpp"
 
 #include <cassert>
 #include <memory>
@@ -28,7 +29,7 @@ namespace ml {
 namespace ops {
 
 template <class T>
-class Convolution1D : public Ops<T>
+class Convolution1D : public Ops<T>, public Quantisable<T>
 {
 public:
   using TensorType    = T;
@@ -64,6 +65,9 @@ public:
   std::vector<typename TensorType::SizeType> ComputeOutputShape(
       VecTensorType const &inputs) const override;
 
+  void     Quantise(TensorType const &weights) override;
+  SizeType WeightsInput() const override;
+
   static constexpr OpType OpCode()
   {
     return OpType::OP_CONVOLUTION_1D;
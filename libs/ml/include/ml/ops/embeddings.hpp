@@ -17,6 +17,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "ml/ops/quantisable.hpp"
 #include "ml/ops/weights.hpp"
 
 #include <cassert>
@@ -35,7 +36,7 @@ struct OpEmbeddingsSaveableParams;
 namespace ops {
 
 template <class T>
-class Embeddings : public fetch::ml::ops::Weights<T>
+class Embeddings : public fetch::ml::ops::Weights<T>, public Quantisable<T>
 {
 public:
   using TensorType    = T;
@@ -63,6 +64,8 @@ public:
 
   std::vector<SizeType> ComputeOutputShape(VecTensorType const &inputs) const override;
 
+  void Quantise(TensorType const &weights) override;
+
   static constexpr OpType OpCode()
   {
     return OpType::OP_EMBEDDINGS;
@@ -18,6 +18,7 @@
 //------------------------------------------------------------------------------
 
 #include "ml/ops/ops.hpp"
+#include "ml/ops/quantisable.hpp"
 
 #include <memory>
 #include <vector>
@@ -27,7 +28,7 @@ namespace ml {
 namespace ops {
 
 template <class T>
-class MatrixMultiply : public fetch::ml::ops::Ops<T>
+class MatrixMultiply : public fetch::ml::ops::Ops<T>, public Quantisable<T>
 {
 public:
   using TensorType    = T;
@@ -56,6 +57,8 @@ public:
                                    TensorType const &   error_signal) override;
   std::vector<SizeType>   ComputeOutputShape(VecTensorType const &inputs) const override;
 
+  void Quantise(TensorType const &weights) override;
+
   static constexpr OpType OpCode()
   {
     return OpType::OP_MATRIX_MULTIPLY;
@@ -100,6 +103,7 @@ private:
   void UpdateContainersForward(VecTensorType const &inputs);
   void UpdateContainersBackward(VecTensorType const &inputs, TensorType const &error_signal);
   void DotWithTranspose(TensorType const &a, TensorType const &b, TensorType &ret);
+  bool UseQuantisedWeights(TensorType const &a) const;
   void BackDotWithTranspose(TensorType const &a, TensorType const &b, TensorType const &err_signal,
                             TensorType &err_ret_1, TensorType &err_ret_2);
 };
@@ -0,0 +1,103 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/base_types.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace ops {
+
+/**
+ * A weights matrix converted to int8 for inference. Every row, i.e. output channel, has its own
+ * scale, which maps the largest magnitude in the row to 127. Products with it are accumulated in
+ * int32 and scaled back to the type of the tensor.
+ * @tparam T tensor type of the weights
+ */
+template <class T>
+class QuantisedWeights
+{
+public:
+  using TensorType = T;
+  using DataType   = typename TensorType::Type;
+  using SizeType   = fetch::math::SizeType;
+
+  QuantisedWeights() = default;
+  explicit QuantisedWeights(TensorType const &weights);
+
+  void Dot(TensorType const &x, TensorType &ret);
+
+  DataType At(SizeType row, SizeType column) const;
+
+  bool     empty() const;
+  SizeType rows() const;
+  SizeType columns() const;
+  SizeType SizeInBytes() const;
+
+private:
+  SizeType            rows_{0};
+  SizeType            columns_{0};
+  SizeType            stride_{0};
+  std::vector<int8_t> values_{};
+  std::vector<double> scales_{};
+
+  // the input to Dot, quantised a column at a time
+  std::vector<int8_t>  input_values_{};
+  std::vector<double>  input_scales_{};
+  std::vector<int32_t> products_{};
+};
+
+/**
+ * Interface of the ops that can run inference with int8 weights, see Graph::Quantise
+ * @tparam T tensor type
+ */
+template <class T>
+class Quantisable
+{
+public:
+  using TensorType = T;
+  using SizeType   = fetch::math::SizeType;
+
+  virtual ~Quantisable() = default;
+
+  /**
+   * Converts the weights to int8, which are then used by forward passes outside of training
+   * @param weights the weights of the op, or of the input returned by WeightsInput
+   */
+  virtual void Quantise(TensorType const &weights) = 0;
+
+  /// index of the input that holds the weights, for ops that do not hold their own
+  virtual SizeType WeightsInput() const;
+
+  void Dequantise();
+
+  bool IsQuantised() const;
+
+  SizeType QuantisedElements() const;
+  SizeType QuantisedSizeInBytes() const;
+
+protected:
+  QuantisedWeights<TensorType> quantised_weights_{};
+};
+
+}  // namespace ops
+}  // namespace ml
+}  // namespace fetch
@@ -94,6 +94,8 @@ struct MapSerializer<ml::model::Model<TensorType>, D>
     case ml::LoaderType::W2V:
     case ml::LoaderType::COMMODITY:
     case ml::LoaderType::C2V:
+    case ml::LoaderType::PREFETCHING:
+    case ml::LoaderType::MAPPED:
     {
       throw ml::exceptions::NotImplemented(
           "Serialization for current dataloader type not implemented yet.");
@@ -161,6 +163,8 @@ struct MapSerializer<ml::model::Model<TensorType>, D>
     case ml::LoaderType::W2V:
     case ml::LoaderType::COMMODITY:
     case ml::LoaderType::C2V:
+    case ml::LoaderType::PREFETCHING:
+    case ml::LoaderType::MAPPED:
     {
       throw ml::exceptions::NotImplemented(
           "serialization for current dataloader type not implemented yet.");
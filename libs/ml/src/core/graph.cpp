@@ -19,8 +19,11 @@
 #include "math/tensor/tensor.hpp"
 #include "math/tensor/tensor_slice_iterator.hpp"
 #include "ml/core/graph.hpp"
+#include "ml/ops/quantisable.hpp"
 #include "ml/ops/weights.hpp"
 
+#include <unordered_map>
+
 namespace fetch {
 
 namespace ml {
@@ -464,6 +467,79 @@ void Graph<TensorType>::ApplySparseGradients(std::vector<TensorType> &grad,
   }
 }
 
+/**
+ * Post-training quantisation: converts the weights of all the matrix multiplications, convolutions
+ * and embeddings in the graph and its subgraphs to int8 with a scale per output channel. Forward
+ * passes that are not training then compute with the int8 weights, accumulating in int32. The
+ * original weights are kept, so training can carry on, but Quantise has to be called again for
+ * inference to pick up any changes to them.
+ * @tparam TensorType
+ */
+template <typename TensorType>
+void Graph<TensorType>::Quantise()
+{
+  Compile();
+
+  ApplyToQuantisables([](std::shared_ptr<ops::Quantisable<TensorType>> const &quantisable_ptr,
+                         TrainablePtrType const &trainable_ptr) {
+    quantisable_ptr->Quantise(trainable_ptr->GetWeights());
+  });
+
+  // cached outputs were computed with the original weights
+  ResetGraphCache(false);
+}
+
+/**
+ * Drops the int8 weights made by Quantise, so that inference uses the original weights again
+ * @tparam TensorType
+ */
+template <typename TensorType>
+void Graph<TensorType>::Dequantise()
+{
+  ApplyToQuantisables([](std::shared_ptr<ops::Quantisable<TensorType>> const &quantisable_ptr,
+                         TrainablePtrType const & /*trainable_ptr*/) {
+    quantisable_ptr->Dequantise();
+  });
+
+  ResetGraphCache(false);
+}
+
+/**
+ * Memory taken by the weights that inference reads, i.e. by the int8 weights and their scales
+ * in place of the original weights they were quantised from
+ * @tparam TensorType
+ * @return size in bytes
+ */
+template <typename TensorType>
+math::SizeType Graph<TensorType>::WeightsSizeInBytes()
+{
+  std::unordered_map<ops::Trainable<TensorType> const *, SizeType> quantised_sizes;
+  ApplyToQuantisables(
+      [&quantised_sizes](std::shared_ptr<ops::Quantisable<TensorType>> const &quantisable_ptr,
+                         TrainablePtrType const &                             trainable_ptr) {
+        if (quantisable_ptr->IsQuantised())
+        {
+          quantised_sizes[trainable_ptr.get()] += quantisable_ptr->QuantisedSizeInBytes();
+        }
+      });
+
+  SizeType ret{0};
+  for (auto const &trainable_ptr : GetTrainables())
+  {
+    auto it = quantised_sizes.find(trainable_ptr.get());
+    if (it != quantised_sizes.end())
+    {
+      ret += it->second;
+    }
+    else
+    {
+      ret += trainable_ptr->GetWeights().size() * sizeof(DataType);
+    }
+  }
+
+  return ret;
+}
+
 /**
  * Method for directly inserting nodes to graph - used for serialisation
  * @tparam T
@@ -871,6 +947,50 @@ void Graph<TensorType>::ApplyGradients(TensorIteratorType &grad_it)
                                                            &Graph<TensorType>::ApplyGradients);
 }
 
+/**
+ * Calls function with every quantisable op in the graph and its subgraphs, together with the
+ * trainable holding its weights: the op itself, or the node feeding its weights input. Ops of which
+ * the weights are not trainable, e.g. products of two activations, are skipped.
+ * @tparam TensorType
+ * @tparam Function
+ * @param function
+ */
+template <typename TensorType>
+template <typename Function>
+void Graph<TensorType>::ApplyToQuantisables(Function const &function)
+{
+  for (auto const &n : nodes_)
+  {
+    OpPtrType op_ptr = n.second->GetOp();
+
+    auto quantisable_ptr = std::dynamic_pointer_cast<ops::Quantisable<TensorType>>(op_ptr);
+    if (quantisable_ptr)
+    {
+      auto trainable_ptr = std::dynamic_pointer_cast<ops::Trainable<TensorType>>(op_ptr);
+      if (!trainable_ptr)
+      {
+        std::vector<std::string> const input_names = n.second->GetInputNames();
+        if (quantisable_ptr->WeightsInput() < input_names.size())
+        {
+          trainable_ptr = std::dynamic_pointer_cast<ops::Trainable<TensorType>>(
+              nodes_.at(input_names.at(quantisable_ptr->WeightsInput()))->GetOp());
+        }
+      }
+
+      if (trainable_ptr)
+      {
+        function(quantisable_ptr, trainable_ptr);
+      }
+    }
+
+    auto graph_ptr = std::dynamic_pointer_cast<Graph<TensorType>>(op_ptr);
+    if (graph_ptr)
+    {
+      graph_ptr->ApplyToQuantisables(function);
+    }
+  }
+}
+
 /**
  * RecursiveApply is used to apply a function to all trainables and collect the results,
  * and then recursively invoke this function for any nodes which are graphs. Using this
@@ -0,0 +1,202 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ml/dataloaders/mapped_dataloader.hpp"
+
+#include "math/tensor/tensor.hpp"
+#include "ml/exceptions/exceptions.hpp"
+
+#include <cstring>
+#include <system_error>
+
+namespace fetch {
+namespace ml {
+namespace dataloaders {
+
+/**
+ * Maps the dataset file and reads its layout
+ * @tparam TensorType
+ * @param filename mapped dataset file, as written by MappedDatasetWriter
+ */
+template <typename TensorType>
+MappedDataLoader<TensorType>::MappedDataLoader(std::string const &filename)
+{
+  std::error_code error{};
+  map_.map(filename, error);
+
+  if (error)
+  {
+    throw exceptions::InvalidFile("Cannot map file `" + filename + "`: " + error.message());
+  }
+
+  layout_ = MappedDatasetLayout::Decode(reinterpret_cast<uint8_t const *>(map_.data()),
+                                        static_cast<SizeType>(map_.size()));
+
+  if ((layout_.element_type != MappedElementType<DataType>()) ||
+      (layout_.element_size != sizeof(DataType)))
+  {
+    throw exceptions::InvalidFile("Mapped dataset `" + filename +
+                                  "` was written with a different element type");
+  }
+
+  if (layout_.num_samples == 0)
+  {
+    throw exceptions::InvalidFile("Mapped dataset `" + filename + "` has no samples");
+  }
+
+  this->one_sample_label_shape_ = layout_.shapes.at(0);
+  this->one_sample_label_shape_.emplace_back(1);
+
+  this->one_sample_data_shapes_.clear();
+  for (SizeType column = 1; column < layout_.shapes.size(); ++column)
+  {
+    this->one_sample_data_shapes_.emplace_back(layout_.shapes.at(column));
+    this->one_sample_data_shapes_.back().emplace_back(1);
+  }
+
+  this->n_samples_ = layout_.num_samples;
+  this->UpdateRanges();
+}
+
+template <typename TensorType>
+typename MappedDataLoader<TensorType>::ReturnType MappedDataLoader<TensorType>::GetNext()
+{
+  SizeType const index = this->NextIndex();
+
+  ReturnType ret{MakeTensor(0, 1), {}};
+  CopySample(0, index, ret.first, 0);
+
+  for (SizeType column = 1; column < layout_.shapes.size(); ++column)
+  {
+    ret.second.emplace_back(MakeTensor(column, 1));
+    CopySample(column, index, ret.second.back(), 0);
+  }
+
+  return ret;
+}
+
+/**
+ * Fills the batch tensors straight from the mapping. The returned tensors are reused by the next
+ * call, unless the batch size changes
+ * @tparam TensorType
+ * @param batch_size i.e. batch size of returned Tensors
+ * @return pair of label tensor and vector of data tensors with specified batch size
+ */
+template <typename TensorType>
+typename MappedDataLoader<TensorType>::ReturnType MappedDataLoader<TensorType>::PrepareBatch(
+    SizeType batch_size, bool &is_done_set)
+{
+  if (batch_.second.empty() || (batch_.first.shape().back() != batch_size))
+  {
+    batch_.first = MakeTensor(0, batch_size);
+    batch_.second.clear();
+
+    for (SizeType column = 1; column < layout_.shapes.size(); ++column)
+    {
+      batch_.second.emplace_back(MakeTensor(column, batch_size));
+    }
+  }
+
+  for (SizeType position = 0; position < batch_size; ++position)
+  {
+    // check if end of data
+    if (this->IsDone())
+    {
+      is_done_set = true;
+      this->Reset();
+    }
+
+    SizeType const index = this->NextIndex();
+
+    CopySample(0, index, batch_.first, position);
+    for (SizeType column = 1; column < layout_.shapes.size(); ++column)
+    {
+      CopySample(column, index, batch_.second.at(column - 1), position);
+    }
+  }
+
+  return batch_;
+}
+
+template <typename TensorType>
+bool MappedDataLoader<TensorType>::AddData(std::vector<TensorType> const & /*data*/,
+                                           TensorType const & /*labels*/)
+{
+  throw exceptions::NotImplemented(
+      "Mapped datasets are read only, they are written with MappedDatasetWriter");
+}
+
+/**
+ * Copies a single sample of a column into a position along the batch dimension of a tensor
+ * @tparam TensorType
+ */
+template <typename TensorType>
+void MappedDataLoader<TensorType>::CopySample(SizeType column, SizeType sample, TensorType &tensor,
+                                              SizeType position) const
+{
+  SizeType const height   = layout_.shapes.at(column).front();
+  SizeType const elements = layout_.SampleElements(column);
+  SizeType const columns  = elements / height;
+  SizeType const padded   = tensor.padded_height();
+
+  auto const *source = reinterpret_cast<uint8_t const *>(map_.data()) +
+                       layout_.offsets.at(column) + sample * elements * sizeof(DataType);
+  auto *target = reinterpret_cast<uint8_t *>(tensor.data().pointer() + position * columns * padded);
+
+  // the mapped samples are unpadded, so unless the tensor has no padding either each column of the
+  // sample is copied separately
+  if (padded == height)
+  {
+    std::memcpy(target, source, elements * sizeof(DataType));
+    return;
+  }
+
+  for (SizeType i = 0; i < columns; ++i)
+  {
+    std::memcpy(target + i * padded * sizeof(DataType), source + i * height * sizeof(DataType),
+                height * sizeof(DataType));
+  }
+}
+
+template <typename TensorType>
+TensorType MappedDataLoader<TensorType>::MakeTensor(SizeType column, SizeType batch_size) const
+{
+  SizeVector shape = layout_.shapes.at(column);
+  shape.emplace_back(batch_size);
+
+  return TensorType{shape};
+}
+
+///////////////////////////////
+/// EXPLICIT INSTANTIATIONS ///
+///////////////////////////////
+
+// TODO(ML-438)
+// template class MappedDataLoader<math::Tensor<std::int8_t>>;
+// template class MappedDataLoader<math::Tensor<std::int16_t>>;
+template class MappedDataLoader<math::Tensor<std::int32_t>>;
+template class MappedDataLoader<math::Tensor<std::int64_t>>;
+template class MappedDataLoader<math::Tensor<float>>;
+template class MappedDataLoader<math::Tensor<double>>;
+template class MappedDataLoader<math::Tensor<fixed_point::fp32_t>>;
+template class MappedDataLoader<math::Tensor<fixed_point::fp64_t>>;
+template class MappedDataLoader<math::Tensor<fixed_point::fp128_t>>;
+
+}  // namespace dataloaders
+}  // namespace ml
+}  // namespace fetch
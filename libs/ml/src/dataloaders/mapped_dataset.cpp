@@ -0,0 +1,435 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ml/dataloaders/mapped_dataset.hpp"
+
+#include "math/tensor/tensor.hpp"
+#include "ml/exceptions/exceptions.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace fetch {
+namespace ml {
+namespace dataloaders {
+
+constexpr uint32_t                      MappedDatasetLayout::VERSION;
+constexpr MappedDatasetLayout::SizeType MappedDatasetLayout::HEADER_SIZE;
+constexpr MappedDatasetLayout::SizeType MappedDatasetLayout::ALIGNMENT;
+
+namespace {
+
+using SizeType   = fetch::math::SizeType;
+using SizeVector = fetch::math::SizeVector;
+
+constexpr char     MAGIC[]       = {'F', 'E', 'T', 'C', 'H', 'M', 'L', 'D'};
+constexpr SizeType MAX_COLUMNS   = 1024;
+constexpr SizeType MAX_RANK      = 16;
+constexpr SizeType MAX_ELEM_SIZE = 16;
+
+template <typename T>
+void Put(std::vector<uint8_t> &buffer, T value)
+{
+  auto const *bytes = reinterpret_cast<uint8_t const *>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+/**
+ * Reads values from the encoded layout, failing rather than reading past its end
+ */
+class Reader
+{
+public:
+  Reader(uint8_t const *data, SizeType size)
+    : data_{data}
+    , size_{size}
+  {}
+
+  template <typename T>
+  T Get()
+  {
+    if (size_ - offset_ < sizeof(T))
+    {
+      throw exceptions::InvalidFile("Mapped dataset header is truncated");
+    }
+
+    T value{};
+    std::memcpy(&value, data_ + offset_, sizeof(T));
+    offset_ += sizeof(T);
+
+    return value;
+  }
+
+  void Skip(SizeType size)
+  {
+    if (size_ - offset_ < size)
+    {
+      throw exceptions::InvalidFile("Mapped dataset header is truncated");
+    }
+
+    offset_ += size;
+  }
+
+private:
+  uint8_t const *data_;
+  SizeType       size_;
+  SizeType       offset_{0};
+};
+
+SizeType CheckedMultiply(SizeType a, SizeType b)
+{
+  if ((a != 0) && (b > std::numeric_limits<SizeType>::max() / a))
+  {
+    throw exceptions::InvalidFile("Mapped dataset is too large");
+  }
+
+  return a * b;
+}
+
+SizeType AlignUp(SizeType value)
+{
+  return (value + MappedDatasetLayout::ALIGNMENT - 1) & ~(MappedDatasetLayout::ALIGNMENT - 1);
+}
+
+}  // namespace
+
+MappedDatasetLayout::SizeType MappedDatasetLayout::SampleElements(SizeType column) const
+{
+  SizeType elements{1};
+  for (auto const &dim : shapes.at(column))
+  {
+    elements = CheckedMultiply(elements, dim);
+  }
+
+  return elements;
+}
+
+MappedDatasetLayout::SizeType MappedDatasetLayout::SampleBytes(SizeType column) const
+{
+  return CheckedMultiply(SampleElements(column), element_size);
+}
+
+MappedDatasetLayout::SizeType MappedDatasetLayout::FileSize() const
+{
+  if (shapes.empty())
+  {
+    return HEADER_SIZE;
+  }
+
+  SizeType const last = shapes.size() - 1;
+  return offsets.at(last) + CheckedMultiply(num_samples, SampleBytes(last));
+}
+
+/**
+ * Lays out the columns one after another, following the header and column descriptors
+ */
+void MappedDatasetLayout::ComputeOffsets()
+{
+  SizeType header_size = HEADER_SIZE;
+  for (auto const &shape : shapes)
+  {
+    header_size += (2 + shape.size()) * sizeof(uint64_t);
+  }
+
+  offsets.clear();
+
+  SizeType offset = AlignUp(header_size);
+  for (SizeType column = 0; column < shapes.size(); ++column)
+  {
+    offsets.emplace_back(offset);
+    offset = AlignUp(offset + CheckedMultiply(num_samples, SampleBytes(column)));
+  }
+}
+
+std::vector<uint8_t> MappedDatasetLayout::Encode() const
+{
+  std::vector<uint8_t> buffer(std::begin(MAGIC), std::end(MAGIC));
+
+  Put(buffer, VERSION);
+  Put(buffer, element_type);
+  Put(buffer, element_size);
+  Put(buffer, static_cast<uint32_t>(shapes.size()));
+  Put(buffer, static_cast<uint64_t>(num_samples));
+
+  for (SizeType column = 0; column < shapes.size(); ++column)
+  {
+    Put(buffer, static_cast<uint64_t>(offsets.at(column)));
+    Put(buffer, static_cast<uint64_t>(shapes.at(column).size()));
+
+    for (auto const &dim : shapes.at(column))
+    {
+      Put(buffer, static_cast<uint64_t>(dim));
+    }
+  }
+
+  return buffer;
+}
+
+/**
+ * Decodes and validates the layout at the start of a mapped dataset file
+ * @param data start of the file
+ * @param size size of the file in bytes
+ * @return the layout of the file
+ */
+MappedDatasetLayout MappedDatasetLayout::Decode(uint8_t const *data, SizeType size)
+{
+  Reader reader{data, size};
+
+  reader.Skip(sizeof(MAGIC));
+  if (std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0)
+  {
+    throw exceptions::InvalidFile("Not a mapped dataset file");
+  }
+
+  if (reader.Get<uint32_t>() != VERSION)
+  {
+    throw exceptions::InvalidFile("Unsupported mapped dataset version");
+  }
+
+  MappedDatasetLayout layout;
+  layout.element_type    = reader.Get<uint32_t>();
+  layout.element_size    = reader.Get<uint32_t>();
+  auto const num_columns = reader.Get<uint32_t>();
+  layout.num_samples     = reader.Get<uint64_t>();
+
+  if ((layout.element_size == 0) || (layout.element_size > MAX_ELEM_SIZE))
+  {
+    throw exceptions::InvalidFile("Invalid mapped dataset element size");
+  }
+
+  if ((num_columns < 2) || (num_columns > MAX_COLUMNS))
+  {
+    throw exceptions::InvalidFile("Invalid number of columns in mapped dataset");
+  }
+
+  for (SizeType column = 0; column < num_columns; ++column)
+  {
+    auto const offset = reader.Get<uint64_t>();
+    auto const rank   = reader.Get<uint64_t>();
+
+    if ((rank == 0) || (rank > MAX_RANK))
+    {
+      throw exceptions::InvalidFile("Invalid column rank in mapped dataset");
+    }
+
+    SizeVector shape{};
+    for (SizeType i = 0; i < rank; ++i)
+    {
+      shape.emplace_back(reader.Get<uint64_t>());
+
+      if (shape.back() == 0)
+      {
+        throw exceptions::InvalidFile("Invalid column shape in mapped dataset");
+      }
+    }
+
+    layout.offsets.emplace_back(offset);
+    layout.shapes.emplace_back(std::move(shape));
+  }
+
+  // every column must be aligned and lie entirely within the file
+  for (SizeType column = 0; column < num_columns; ++column)
+  {
+    SizeType const offset = layout.offsets.at(column);
+    SizeType const length = CheckedMultiply(layout.num_samples, layout.SampleBytes(column));
+
+    if ((offset % ALIGNMENT != 0) || (offset > size) || (length > size - offset))
+    {
+      throw exceptions::InvalidFile("Mapped dataset column lies outside of the file");
+    }
+  }
+
+  return layout;
+}
+
+/**
+ * Creates the file and lays out its columns. The columns are filled in by Write
+ * @param filename file to write the dataset to
+ * @param label_shape shape of a single label, without the batch dimension
+ * @param data_shapes shapes of a single sample of each data input, without the batch dimension
+ * @param num_samples number of samples in the dataset
+ */
+template <typename TensorType>
+MappedDatasetWriter<TensorType>::MappedDatasetWriter(std::string const &            filename,
+                                                     SizeVector const &             label_shape,
+                                                     std::vector<SizeVector> const &data_shapes,
+                                                     SizeType                       num_samples)
+  : filename_{filename}
+{
+  if (data_shapes.empty())
+  {
+    throw exceptions::InvalidInput("Mapped dataset needs at least one data input");
+  }
+
+  layout_.element_type = MappedElementType<DataType>();
+  layout_.element_size = static_cast<uint32_t>(sizeof(DataType));
+  layout_.num_samples  = num_samples;
+  layout_.shapes.emplace_back(label_shape);
+  layout_.shapes.insert(layout_.shapes.end(), data_shapes.begin(), data_shapes.end());
+
+  for (auto const &shape : layout_.shapes)
+  {
+    if (shape.empty() || (shape.size() > MAX_RANK) ||
+        (std::find(shape.begin(), shape.end(), SizeType{0}) != shape.end()))
+    {
+      throw exceptions::InvalidInput("Invalid sample shape for mapped dataset");
+    }
+  }
+
+  layout_.ComputeOffsets();
+
+  file_.open(filename_, std::ios::binary | std::ios::trunc);
+  if (!file_.is_open())
+  {
+    throw exceptions::InvalidFile("Cannot open file `" + filename_ + "`!");
+  }
+
+  auto const header = layout_.Encode();
+  file_.write(reinterpret_cast<char const *>(header.data()),
+              static_cast<std::streamsize>(header.size()));
+
+  // size the file up front, leaving the columns to be filled in
+  file_.seekp(static_cast<std::streamoff>(layout_.FileSize() - 1));
+  file_.put('\0');
+}
+
+template <typename TensorType>
+MappedDatasetWriter<TensorType>::~MappedDatasetWriter()
+{
+  file_.close();
+}
+
+/**
+ * Appends a batch of samples to the dataset
+ * @param labels labels of the samples, the trailing dimension being the batch dimension
+ * @param data data inputs of the samples, the trailing dimension being the batch dimension
+ */
+template <typename TensorType>
+void MappedDatasetWriter<TensorType>::Write(TensorType const &             labels,
+                                            std::vector<TensorType> const &data)
+{
+  if (!file_.is_open())
+  {
+    throw exceptions::InvalidMode("Mapped dataset `" + filename_ + "` is already closed");
+  }
+
+  if (data.size() + 1 != layout_.shapes.size())
+  {
+    throw exceptions::InvalidInput("Wrong number of data inputs for mapped dataset");
+  }
+
+  SizeType const batch_size = labels.shape().back();
+
+  for (SizeType column = 0; column < layout_.shapes.size(); ++column)
+  {
+    SizeVector expected = layout_.shapes.at(column);
+    expected.emplace_back(batch_size);
+
+    if ((column == 0 ? labels : data.at(column - 1)).shape() != expected)
+    {
+      throw exceptions::InvalidInput("Batch does not match the shape of the mapped dataset");
+    }
+  }
+
+  if (batch_size > layout_.num_samples - written_)
+  {
+    throw exceptions::InvalidInput("More samples written than the mapped dataset holds");
+  }
+
+  WriteColumn(0, labels);
+  for (SizeType column = 1; column < layout_.shapes.size(); ++column)
+  {
+    WriteColumn(column, data.at(column - 1));
+  }
+
+  written_ += batch_size;
+}
+
+/**
+ * Flushes the file, checking that all of the samples have been written
+ */
+template <typename TensorType>
+void MappedDatasetWriter<TensorType>::Close()
+{
+  if (!file_.is_open())
+  {
+    return;
+  }
+
+  file_.close();
+
+  if (file_.fail())
+  {
+    throw exceptions::InvalidFile("Failed to write mapped dataset `" + filename_ + "`");
+  }
+
+  if (written_ != layout_.num_samples)
+  {
+    throw exceptions::InvalidInput("Mapped dataset `" + filename_ + "` closed after " +
+                                   std::to_string(written_) + " of " +
+                                   std::to_string(layout_.num_samples) + " samples");
+  }
+}
+
+template <typename TensorType>
+typename MappedDatasetWriter<TensorType>::SizeType MappedDatasetWriter<TensorType>::size() const
+{
+  return written_;
+}
+
+template <typename TensorType>
+void MappedDatasetWriter<TensorType>::WriteColumn(SizeType column, TensorType const &tensor)
+{
+  // the tensor iterator skips the padding, giving the samples one after another
+  buffer_.clear();
+  buffer_.reserve(tensor.size());
+  for (auto it = tensor.cbegin(); it.is_valid(); ++it)
+  {
+    buffer_.emplace_back(*it);
+  }
+
+  SizeType const offset = layout_.offsets.at(column) + written_ * layout_.SampleBytes(column);
+
+  file_.seekp(static_cast<std::streamoff>(offset));
+  file_.write(reinterpret_cast<char const *>(buffer_.data()),
+              static_cast<std::streamsize>(buffer_.size() * sizeof(DataType)));
+
+  if (file_.fail())
+  {
+    throw exceptions::InvalidFile("Failed to write mapped dataset `" + filename_ + "`");
+  }
+}
+
+///////////////////////////////
+/// EXPLICIT INSTANTIATIONS ///
+///////////////////////////////
+
+template class MappedDatasetWriter<math::Tensor<std::int8_t>>;
+template class MappedDatasetWriter<math::Tensor<std::int16_t>>;
+template class MappedDatasetWriter<math::Tensor<std::int32_t>>;
+template class MappedDatasetWriter<math::Tensor<std::int64_t>>;
+template class MappedDatasetWriter<math::Tensor<float>>;
+template class MappedDatasetWriter<math::Tensor<double>>;
+template class MappedDatasetWriter<math::Tensor<fixed_point::fp32_t>>;
+template class MappedDatasetWriter<math::Tensor<fixed_point::fp64_t>>;
+template class MappedDatasetWriter<math::Tensor<fixed_point::fp128_t>>;
+
+}  // namespace dataloaders
+}  // namespace ml
+}  // namespace fetch
@@ -0,0 +1,469 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ml/dataloaders/prefetching_dataloader.hpp"
+
+#include "math/tensor/tensor.hpp"
+#include "ml/exceptions/exceptions.hpp"
+
+#include <utility>
+
+namespace fetch {
+namespace ml {
+namespace dataloaders {
+
+template <typename TensorType>
+constexpr typename PrefetchingDataLoader<TensorType>::SizeType
+    PrefetchingDataLoader<TensorType>::DEFAULT_RING_SIZE;
+
+/**
+ * @param loader the dataloader to prefetch batches from
+ * @param ring_size number of batches in the ring, including the one held by the training thread
+ * @param shuffle_buffer_size number of samples to shuffle over, 0 to disable shuffling
+ */
+template <typename TensorType>
+PrefetchingDataLoader<TensorType>::PrefetchingDataLoader(DataLoaderPtr loader, SizeType ring_size,
+                                                         SizeType shuffle_buffer_size)
+  : loader_(std::move(loader))
+  , ring_size_(ring_size)
+  , shuffle_buffer_size_(shuffle_buffer_size)
+{
+  if (!loader_)
+  {
+    throw exceptions::InvalidInput("Prefetching dataloader requires a dataloader to wrap");
+  }
+
+  if (ring_size_ < 2)
+  {
+    throw exceptions::InvalidInput("Prefetching dataloader requires a ring of at least 2 batches");
+  }
+
+  this->mode_ = DataLoaderMode::TRAIN;
+}
+
+template <typename TensorType>
+PrefetchingDataLoader<TensorType>::~PrefetchingDataLoader()
+{
+  Stop(false);
+}
+
+/**
+ * Returns the next sample, stopping any prefetching
+ */
+template <typename TensorType>
+typename PrefetchingDataLoader<TensorType>::ReturnType PrefetchingDataLoader<TensorType>::GetNext()
+{
+  Stop();
+  return NextSample();
+}
+
+/**
+ * Returns the next prefetched batch, starting the pipeline if required. The returned tensors are
+ * owned by the ring and are valid until the next call.
+ * @param batch_size i.e. batch size of returned Tensors
+ * @param is_done_set set if the wrapped loader was reset while assembling the batch
+ * @return pair of label tensor and vector of data tensors with specified batch size
+ */
+template <typename TensorType>
+typename PrefetchingDataLoader<TensorType>::ReturnType
+PrefetchingDataLoader<TensorType>::PrepareBatch(SizeType batch_size, bool &is_done_set)
+{
+  if (!worker_.joinable() || (batch_size != batch_size_))
+  {
+    Stop();
+    Start(batch_size);
+  }
+
+  std::unique_lock<std::mutex> lock(lock_);
+
+  // hand the previously returned batch back to the worker
+  if (holding_)
+  {
+    ++released_;
+    holding_ = false;
+
+    if (paused_ && (released_ >= paused_at_))
+    {
+      paused_ = false;
+    }
+
+    condition_.notify_all();
+  }
+
+  condition_.wait(lock, [this] { return produced_ > released_; });
+
+  auto &slot = ring_.at(released_ % ring_size_);
+  holding_   = true;
+  is_done_   = slot.is_done;
+
+  if (slot.error)
+  {
+    std::exception_ptr error{};
+    std::swap(error, slot.error);
+    std::rethrow_exception(error);
+  }
+
+  if (slot.is_done_set)
+  {
+    is_done_set = true;
+  }
+
+  return slot.batch;
+}
+
+template <typename TensorType>
+bool PrefetchingDataLoader<TensorType>::AddData(std::vector<TensorType> const &data,
+                                                TensorType const &             label)
+{
+  Stop();
+  shuffle_buffer_.clear();
+
+  // the shapes of the samples may have changed
+  label_shape_.clear();
+  ring_.clear();
+
+  return loader_->AddData(data, label);
+}
+
+template <typename TensorType>
+typename PrefetchingDataLoader<TensorType>::SizeType PrefetchingDataLoader<TensorType>::Size() const
+{
+  return loader_->Size();
+}
+
+/**
+ * Whether the wrapped loader is done, as of the last batch returned by PrepareBatch
+ */
+template <typename TensorType>
+bool PrefetchingDataLoader<TensorType>::IsDone() const
+{
+  if (worker_.joinable())
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    return is_done_;
+  }
+
+  return SourceDone();
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::Reset()
+{
+  Stop();
+  shuffle_buffer_.clear();
+  loader_->Reset();
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::SetTestRatio(fixed_point::fp32_t new_test_ratio)
+{
+  Stop();
+  shuffle_buffer_.clear();
+  loader_->SetTestRatio(new_test_ratio);
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::SetValidationRatio(fixed_point::fp32_t new_validation_ratio)
+{
+  Stop();
+  shuffle_buffer_.clear();
+  loader_->SetValidationRatio(new_validation_ratio);
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::SetMode(DataLoaderMode new_mode)
+{
+  if (this->mode_ == new_mode)
+  {
+    return;
+  }
+
+  Stop();
+  shuffle_buffer_.clear();
+  loader_->SetMode(new_mode);
+  this->mode_ = new_mode;
+}
+
+template <typename TensorType>
+bool PrefetchingDataLoader<TensorType>::IsModeAvailable(DataLoaderMode mode)
+{
+  return loader_->IsModeAvailable(mode);
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::SetRandomMode(bool random_mode_state)
+{
+  Stop();
+  shuffle_buffer_.clear();
+  loader_->SetRandomMode(random_mode_state);
+  this->random_mode_ = random_mode_state;
+}
+
+/**
+ * Seeds both the wrapped loader and the shuffle
+ */
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::SetSeed(SizeType seed)
+{
+  Stop();
+  loader_->SetSeed(seed);
+  shuffle_rng_.Seed(seed);
+}
+
+/**
+ * The cursors belong to the wrapped loader, which is updated by SetMode
+ */
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::UpdateCursor()
+{}
+
+/**
+ * Allocates the ring for the batch size and starts the worker
+ */
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::Start(SizeType batch_size)
+{
+  if (label_shape_.empty())
+  {
+    // as with DataLoader::PrepareBatch, a dummy GetNext identifies the tensor shapes
+    auto const sample = loader_->GetNext();
+    loader_->Reset();
+
+    label_shape_ = sample.first.shape();
+    data_shapes_.clear();
+    for (auto const &tensor : sample.second)
+    {
+      data_shapes_.emplace_back(tensor.shape());
+    }
+
+    ring_.clear();
+  }
+
+  if (ring_.empty() || (batch_size != batch_size_))
+  {
+    auto const batch_shape = [batch_size](SizeVector shape) {
+      shape.back() = batch_size;
+      return shape;
+    };
+
+    ring_ = Slots(ring_size_);
+    for (auto &slot : ring_)
+    {
+      slot.batch.first = TensorType{batch_shape(label_shape_)};
+      for (auto const &shape : data_shapes_)
+      {
+        slot.batch.second.emplace_back(batch_shape(shape));
+      }
+    }
+
+    batch_size_ = batch_size;
+  }
+
+  produced_  = 0;
+  released_  = 0;
+  paused_at_ = 0;
+  holding_   = false;
+  paused_    = false;
+  idle_      = false;
+  stop_      = false;
+  is_done_   = SourceDone();
+
+  worker_ = std::thread([this] { Run(); });
+}
+
+/**
+ * Stops the worker, dropping any batches which have not been returned
+ * @param wait_until_idle wait until the ring is full or prefetching has paused, so that the state
+ * of the wrapped loader does not depend on how far the worker got
+ */
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::Stop(bool wait_until_idle)
+{
+  if (!worker_.joinable())
+  {
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(lock_);
+
+    if (wait_until_idle)
+    {
+      condition_.wait(lock, [this] { return idle_ && !CanProduce(); });
+    }
+
+    stop_ = true;
+  }
+
+  condition_.notify_all();
+  worker_.join();
+}
+
+template <typename TensorType>
+bool PrefetchingDataLoader<TensorType>::CanProduce() const
+{
+  return !paused_ && ((produced_ - released_) < ring_size_);
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::Run()
+{
+  std::unique_lock<std::mutex> lock(lock_);
+
+  for (;;)
+  {
+    idle_ = true;
+    condition_.notify_all();
+    condition_.wait(lock, [this] { return stop_ || CanProduce(); });
+
+    if (stop_)
+    {
+      break;
+    }
+
+    idle_      = false;
+    auto &slot = ring_.at(produced_ % ring_size_);
+
+    lock.unlock();
+
+    try
+    {
+      FillBatch(slot);
+    }
+    catch (...)
+    {
+      slot.error = std::current_exception();
+    }
+
+    lock.lock();
+
+    ++produced_;
+
+    // wait for the training thread to finish the epoch before starting on the next one
+    if (slot.error || slot.is_done_set || slot.is_done)
+    {
+      paused_    = true;
+      paused_at_ = produced_;
+    }
+
+    condition_.notify_all();
+  }
+}
+
+/**
+ * Assembles a batch in the same way as DataLoader::PrepareBatch
+ */
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::FillBatch(Slot &slot)
+{
+  slot.is_done_set = false;
+
+  for (SizeType data_idx{0}; data_idx < batch_size_; ++data_idx)
+  {
+    // check if end of data
+    if (SourceDone())
+    {
+      slot.is_done_set = true;
+      ResetSource();
+    }
+
+    auto const sample = NextSample();
+
+    auto label_view = slot.batch.first.View(data_idx);
+    label_view.Assign(sample.first);
+
+    for (SizeType j{0}; j < sample.second.size(); ++j)
+    {
+      auto data_view = slot.batch.second.at(j).View(data_idx);
+      data_view.Assign(sample.second.at(j));
+    }
+  }
+
+  slot.is_done = SourceDone();
+}
+
+template <typename TensorType>
+bool PrefetchingDataLoader<TensorType>::SourceDone() const
+{
+  return shuffle_buffer_.empty() && loader_->IsDone();
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::ResetSource()
+{
+  shuffle_buffer_.clear();
+  loader_->Reset();
+}
+
+/**
+ * Draws the next sample from the wrapped loader, through the shuffle buffer if enabled
+ */
+template <typename TensorType>
+typename PrefetchingDataLoader<TensorType>::ReturnType
+PrefetchingDataLoader<TensorType>::NextSample()
+{
+  if (shuffle_buffer_size_ == 0)
+  {
+    return loader_->GetNext();
+  }
+
+  while ((shuffle_buffer_.size() < shuffle_buffer_size_) && !loader_->IsDone())
+  {
+    auto const sample = loader_->GetNext();
+
+    // loaders may reuse the tensors they return, so buffered samples are copied
+    ReturnType copy{sample.first.Copy(), {}};
+    for (auto const &tensor : sample.second)
+    {
+      copy.second.emplace_back(tensor.Copy());
+    }
+
+    shuffle_buffer_.emplace_back(std::move(copy));
+  }
+
+  if (shuffle_buffer_.empty())
+  {
+    return loader_->GetNext();
+  }
+
+  auto const index = static_cast<SizeType>(shuffle_rng_() % shuffle_buffer_.size());
+  std::swap(shuffle_buffer_.at(index), shuffle_buffer_.back());
+
+  ReturnType sample = std::move(shuffle_buffer_.back());
+  shuffle_buffer_.pop_back();
+
+  return sample;
+}
+
+///////////////////////////////
+/// EXPLICIT INSTANTIATIONS ///
+///////////////////////////////
+
+template class PrefetchingDataLoader<math::Tensor<std::int8_t>>;
+template class PrefetchingDataLoader<math::Tensor<std::int16_t>>;
+template class PrefetchingDataLoader<math::Tensor<std::int32_t>>;
+template class PrefetchingDataLoader<math::Tensor<std::int64_t>>;
+template class PrefetchingDataLoader<math::Tensor<float>>;
+template class PrefetchingDataLoader<math::Tensor<double>>;
+template class PrefetchingDataLoader<math::Tensor<fixed_point::fp32_t>>;
+template class PrefetchingDataLoader<math::Tensor<fixed_point::fp64_t>>;
+template class PrefetchingDataLoader<math::Tensor<fixed_point::fp128_t>>;
+
+}  // namespace dataloaders
+}  // namespace ml
+}  // namespace fetch
@@ -28,15 +28,29 @@ namespace dataloaders {
 template <typename TensorType>
 typename TensorDataLoader<TensorType>::ReturnType TensorDataLoader<TensorType>::GetNext()
 {
+  SizeType const index = NextIndex();
+
   std::vector<TensorType> ret_data;
-  TensorType ret_labels = labels_.View(*this->current_cursor_).Copy(one_sample_label_shape_);
+  TensorType              ret_labels = labels_.View(index).Copy(one_sample_label_shape_);
 
   for (SizeType i{0}; i < data_.size(); i++)
   {
-    ret_data.emplace_back(
-        data_.at(i).View(*this->current_cursor_).Copy(one_sample_data_shapes_.at(i)));
+    ret_data.emplace_back(data_.at(i).View(index).Copy(one_sample_data_shapes_.at(i)));
   }
 
+  return ReturnType(ret_labels, ret_data);
+}
+
+/**
+ * Returns the index of the sample at the cursor and moves the cursor on to the next sample
+ * @tparam TensorType
+ * @return index of the next sample
+ */
+template <typename TensorType>
+typename TensorDataLoader<TensorType>::SizeType TensorDataLoader<TensorType>::NextIndex()
+{
+  SizeType const index = *this->current_cursor_;
+
   if (this->random_mode_)
   {
     *this->current_cursor_ = this->current_min_ + SizeType{this->rand()} % this->current_size_;
@@ -47,7 +61,7 @@ typename TensorDataLoader<TensorType>::ReturnType TensorDataLoader<TensorType>::
     (*this->current_cursor_)++;
   }
 
-  return ReturnType(ret_labels, ret_data);
+  return index;
 }
 
 template <typename TensorType>
@@ -19,6 +19,7 @@
 #include "core/macros.hpp"
 #include "core/random/lfg.hpp"
 #include "math/fundamental_operators.hpp"
+#include "math/kernels/elementwise.hpp"
 #include "ml/ops/activations/dropout.hpp"
 
 #include <cassert>
@@ -125,7 +126,9 @@ std::vector<TensorType> Dropout<TensorType>::Backward(VecTensorType const &input
   // gradient of dropout is 1.0/(1.0-prob) for enabled neurons and 0.0 for disabled
   // multiply by error_signal (chain rule)
 
-  fetch::math::Multiply(error_signal, drop_values_, return_signal);
+  fetch::math::kernels::Evaluate(
+      return_signal, [](auto const &err, auto const &drop, auto &y) { y = err * drop; },
+      error_signal, drop_values_);
 
   return {return_signal};
 }
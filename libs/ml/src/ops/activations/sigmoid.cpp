@@ -18,6 +18,7 @@
 
 #include "math/activation_functions/sigmoid.hpp"
 #include "math/fundamental_operators.hpp"
+#include "math/kernels/elementwise.hpp"
 #include "math/standard_functions/clamp.hpp"
 #include "ml/ops/activations/sigmoid.hpp"
 
@@ -68,13 +69,15 @@ std::vector<TensorType> Sigmoid<TensorType>::Backward(VecTensorType const &input
   TensorType return_signal{error_signal.shape()};
   TensorType t{inputs.front()->shape()};
 
-  // gradient of sigmoid function is s(x)(1 - s(x))
+  // gradient of sigmoid function is s(x)(1 - s(x)), multiplied by error_signal (chain rule)
   Forward(inputs, t);
-  fetch::math::Subtract(DataType{1}, t, return_signal);
-  fetch::math::Multiply(t, return_signal, return_signal);
-
-  // multiply by error_signal (chain rule)
-  fetch::math::Multiply(error_signal, return_signal, return_signal);
+  fetch::math::kernels::Evaluate(
+      return_signal,
+      [](auto const &err, auto const &x, auto &y) {
+        using RegisterType = std::decay_t<decltype(x)>;
+        y                  = err * (x * (RegisterType(DataType{1}) - x));
+      },
+      error_signal, t);
 
   return {return_signal};
 }
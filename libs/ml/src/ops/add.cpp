@@ -16,6 +16,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "math/kernels/elementwise.hpp"
 #include "math/matrix_operations.hpp"
 #include "ml/ops/add.hpp"
 #include "ml/saveparams/saveable_params.hpp"
@@ -56,7 +57,11 @@ void Add<TensorType>::Forward(VecTensorType const &inputs, TensorType &output)
 {
   assert(inputs.size() == 2);
   assert(output.shape() == this->ComputeOutputShape(inputs));
-  fetch::math::Add((*inputs.at(0)), (*inputs.at(1)), output);
+
+  // a bias is broadcast along the batch in the same pass
+  fetch::math::kernels::Evaluate(
+      output, [](auto const &a, auto const &b, auto &c) { c = a + b; }, *inputs.at(0),
+      *inputs.at(1));
 }
 
 template <typename TensorType>
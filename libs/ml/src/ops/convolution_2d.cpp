@@ -81,19 +81,31 @@ void Convolution2D<TensorType>::Forward(VecTensorType const &inputs, TensorType
 
   // Horizontal stride contains input data
   TensorType horizontal_stride{{horizontal_stride_width, horizontal_stride_height}};
-  // Vertical stride contains kernel data
-  TensorType vertical_stride{{vertical_stride_width, horizontal_stride_width}};
 
   // Reshape input data to horizontal stride - im2col
   FillHorizontalStride(input, horizontal_stride, output_height, output_width, input_channels,
                        kernel_height, kernel_width, batch_size);
 
-  // Reshape kernel data to vertical stride - im2col
-  FillVerticalStride(kernels, vertical_stride, output_channels, input_channels, kernel_height,
-                     kernel_width);
+  // Do matmul, with the int8 kernels if they have been quantised for inference
+  TensorType reshaped_output;
+  if (this->IsQuantised() && !this->IsTraining() &&
+      this->quantised_weights_.rows() == vertical_stride_width &&
+      this->quantised_weights_.columns() == horizontal_stride_width)
+  {
+    reshaped_output = TensorType({vertical_stride_width, horizontal_stride_height});
+    this->quantised_weights_.Dot(horizontal_stride, reshaped_output);
+  }
+  else
+  {
+    // Vertical stride contains kernel data
+    TensorType vertical_stride{{vertical_stride_width, horizontal_stride_width}};
 
-  // Do matmul
-  TensorType reshaped_output = fetch::math::Dot(vertical_stride, horizontal_stride);
+    // Reshape kernel data to vertical stride - im2col
+    FillVerticalStride(kernels, vertical_stride, output_channels, input_channels, kernel_height,
+                       kernel_width);
+
+    reshaped_output = fetch::math::Dot(vertical_stride, horizontal_stride);
+  }
 
   // Reshape values after matmul to output
   FillOutput(reshaped_output, output, output_channels, output_height, output_width, batch_size);
@@ -175,6 +187,38 @@ std::vector<TensorType> Convolution2D<TensorType>::Backward(VecTensorType const
   return {input_error, kernel_error};
 }
 
+/**
+ * Quantises the kernels for inference, in the vertical stride layout of the im2col matmul
+ * @param weights kernel data [oC x iC x H x W x N]
+ */
+template <class TensorType>
+void Convolution2D<TensorType>::Quantise(TensorType const &weights)
+{
+  assert(weights.shape().size() == 5);
+
+  TensorType kernels = weights;
+
+  SizeType output_channels = kernels.shape().at(0);
+  SizeType input_channels  = kernels.shape().at(1);
+  SizeType kernel_height   = kernels.shape().at(2);
+  SizeType kernel_width    = kernels.shape().at(3);
+
+  TensorType vertical_stride{{output_channels, kernel_width * kernel_height * input_channels}};
+  FillVerticalStride(kernels, vertical_stride, output_channels, input_channels, kernel_height,
+                     kernel_width);
+
+  this->quantised_weights_ = QuantisedWeights<TensorType>(vertical_stride);
+}
+
+/**
+ * The kernels are the second input
+ */
+template <class TensorType>
+math::SizeType Convolution2D<TensorType>::WeightsInput() const
+{
+  return 1;
+}
+
 template <class TensorType>
 std::vector<typename TensorType::SizeType> Convolution2D<TensorType>::ComputeOutputShape(
     VecTensorType const &inputs) const
@@ -17,6 +17,7 @@
 //------------------------------------------------------------------------------
 
 #include "math/fundamental_operators.hpp"
+#include "math/kernels/elementwise.hpp"
 #include "ml/exceptions/exceptions.hpp"
 #include "ml/ops/divide.hpp"
 #include "ml/saveparams/saveable_params.hpp"
@@ -55,7 +56,13 @@ void Divide<TensorType>::Forward(VecTensorType const &inputs, TensorType &output
   assert(inputs.size() == 2);
   assert(inputs.at(0)->shape() == output.shape());
 
-  if ((inputs.at(0)->shape() == inputs.at(1)->shape()) || (inputs.at(1)->size() > 1))
+  if (inputs.at(0)->shape() == inputs.at(1)->shape())
+  {  // array / array same shape
+    fetch::math::kernels::Evaluate(
+        output, [](auto const &a, auto const &b, auto &c) { c = a / b; }, *inputs.at(0),
+        *inputs.at(1));
+  }
+  else if (inputs.at(1)->size() > 1)
   {  // array / array
     fetch::math::Divide(*inputs.at(0), *inputs.at(1), output);
   }
@@ -76,26 +83,28 @@ std::vector<TensorType> Divide<TensorType>::Backward(VecTensorType const &inputs
   TensorType return_signal_1(inputs.at(0)->shape());
   TensorType return_signal_2(inputs.at(1)->shape());
 
+  if (inputs.at(0)->shape() == inputs.at(1)->shape())
+  {  // array / array same shape
+    fetch::math::kernels::Evaluate(
+        return_signal_1, [](auto const &err, auto const &b, auto &r) { r = err / b; },
+        error_signal, *inputs.at(1));
+    fetch::math::kernels::Evaluate(
+        return_signal_2,
+        [](auto const &err, auto const &a, auto const &b, auto &r) {
+          using RegisterType = std::decay_t<decltype(r)>;
+          r                  = (RegisterType(DataType{0}) - (err * a)) / (b * b);
+        },
+        error_signal, *inputs.at(0), *inputs.at(1));
+
+    return {return_signal_1, return_signal_2};
+  }
+
   auto a_it   = inputs.at(0)->cbegin();
   auto b_it   = inputs.at(1)->cbegin();
   auto err_it = error_signal.cbegin();
   auto r_1_it = return_signal_1.begin();
   auto r_2_it = return_signal_2.begin();
-  if (inputs.at(0)->shape() == inputs.at(1)->shape())
-  {  // array / array same shape
-    while (a_it.is_valid())
-    {
-      *r_1_it = static_cast<DataType>((*err_it) / (*b_it));
-      *r_2_it = static_cast<DataType>(-((*err_it) * (*a_it)) / ((*b_it) * (*b_it)));
-
-      ++a_it;
-      ++b_it;
-      ++err_it;
-      ++r_1_it;
-      ++r_2_it;
-    }
-  }
-  else if (inputs.at(1)->size() == 1)
+  if (inputs.at(1)->size() == 1)
   {  // array / scalar
     while (a_it.is_valid())
     {
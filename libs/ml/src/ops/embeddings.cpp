@@ -68,6 +68,27 @@ void Embeddings<TensorType>::Forward(VecTensorType const &inputs, TensorType &ou
 
   auto indices  = inputs.front()->shape().at(0);
   auto input_it = inputs.front()->begin();
+
+  // the embeddings are dequantised rows of the int8 weights when running inference on them
+  if (this->IsQuantised() && !this->IsTraining() &&
+      this->quantised_weights_.rows() == this->data_->shape().at(1))
+  {
+    SizeType const dimensions = this->quantised_weights_.columns();
+    for (SizeType i{0}; i < indices; i++)
+    {
+      for (SizeType n{0}; n < batch_size; n++)
+      {
+        auto const index = static_cast<SizeType>(*input_it);
+        for (SizeType k{0}; k < dimensions; k++)
+        {
+          output.At(k, i, n) = this->quantised_weights_.At(index, k);
+        }
+        ++input_it;
+      }
+    }
+    return;
+  }
+
   for (SizeType i{0}; i < indices; i++)
   {
     for (SizeType n{0}; n < batch_size; n++)
@@ -122,6 +143,16 @@ std::vector<TensorType> Embeddings<TensorType>::Backward(VecTensorType const &in
   return {TensorType(error_signal.shape())};
 }
 
+/**
+ * Quantises the embeddings for inference, each with its own scale
+ * @param weights embeddings of shape {dimensions, data points}
+ */
+template <class TensorType>
+void Embeddings<TensorType>::Quantise(TensorType const &weights)
+{
+  this->quantised_weights_ = QuantisedWeights<TensorType>(weights.Transpose());
+}
+
 template <class TensorType>
 std::vector<math::SizeType> Embeddings<TensorType>::ComputeOutputShape(
     VecTensorType const &inputs) const
@@ -16,6 +16,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "math/kernels/elementwise.hpp"
 #include "math/standard_functions/log.hpp"
 #include "ml/ops/log.hpp"
 #include "ml/saveparams/saveable_params.hpp"
@@ -74,7 +75,9 @@ std::vector<TensorType> Log<TensorType>::Backward(VecTensorType const &inputs,
   assert(error_signal.shape() == this->ComputeOutputShape(inputs));
 
   TensorType ret_error_signal(inputs.at(0)->shape());
-  fetch::math::Divide(error_signal, (*inputs.at(0)), ret_error_signal);
+  fetch::math::kernels::Evaluate(
+      ret_error_signal, [](auto const &err, auto const &x, auto &y) { y = err / x; },
+      error_signal, *inputs.at(0));
 
   return {ret_error_signal};
 }
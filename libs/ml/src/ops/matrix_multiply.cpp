@@ -285,6 +285,22 @@ std::vector<typename fetch::math::SizeType> MatrixMultiply<T>::ComputeOutputShap
   return output_shape;
 }
 
+/**
+ * Quantises the weights, i.e. the first input, for inference. Only the untransposed product is
+ * computed from int8 weights, so transposed multiplications keep their weights as they are.
+ * @param weights 2D weights of shape {output size, input size}
+ */
+template <typename T>
+void MatrixMultiply<T>::Quantise(TensorType const &weights)
+{
+  if (transpose_a_ || transpose_b_ || weights.shape().size() != 2)
+  {
+    return;
+  }
+
+  this->quantised_weights_ = QuantisedWeights<TensorType>(weights);
+}
+
 template <typename T>
 OperationsCount MatrixMultiply<T>::ChargeForward()
 {
@@ -380,7 +396,11 @@ template <typename TensorType>
 void MatrixMultiply<TensorType>::DotWithTranspose(TensorType const &a, TensorType const &b,
                                                   TensorType &ret)
 {
-  if (!transpose_a_ && !transpose_b_)
+  if (UseQuantisedWeights(a))
+  {
+    this->quantised_weights_.Dot(b, ret);
+  }
+  else if (!transpose_a_ && !transpose_b_)
   {
     fetch::math::Dot(a, b, ret);
   }
@@ -399,6 +419,20 @@ void MatrixMultiply<TensorType>::DotWithTranspose(TensorType const &a, TensorTyp
   }
 }
 
+/**
+ * The int8 weights stand in for a outside of training, as long as they have the same shape
+ * @tparam TensorType
+ * @param a first input to the product
+ * @return
+ */
+template <typename TensorType>
+bool MatrixMultiply<TensorType>::UseQuantisedWeights(TensorType const &a) const
+{
+  return this->IsQuantised() && !this->IsTraining() && a.shape().size() == 2 &&
+         a.shape(0) == this->quantised_weights_.rows() &&
+         a.shape(1) == this->quantised_weights_.columns();
+}
+
 /**
  * Applies the relevant two dot operations in backprop depending on transpose
  * @tparam TensorType
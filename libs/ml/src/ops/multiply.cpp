@@ -17,6 +17,7 @@
 //------------------------------------------------------------------------------
 
 #include "core/assert.hpp"
+#include "math/kernels/elementwise.hpp"
 #include "ml/ops/multiply.hpp"
 
 #include <cassert>
@@ -62,7 +63,9 @@ void Multiply<T>::Forward(const VecTensorType &inputs, TensorType &output)
          inputs.at(1)->shape().size());  // check if addition is broadcastable
   assert(output.shape() == inputs.front()->shape());
 
-  fetch::math::Multiply((*inputs.at(0)), (*inputs.at(1)), output);
+  fetch::math::kernels::Evaluate(
+      output, [](auto const &a, auto const &b, auto &c) { c = a * b; }, *inputs.at(0),
+      *inputs.at(1));
 }
 
 /**
@@ -81,10 +84,12 @@ std::vector<TensorType> Multiply<TensorType>::Backward(const VecTensorType &inpu
          inputs.at(1)->shape().size());  // check if addition is broadcastable
   assert(error_signal.shape() == inputs.front()->shape());
 
+  auto const multiply = [](auto const &a, auto const &b, auto &c) { c = a * b; };
+
   TensorType error_signal_1(error_signal.shape());
   TensorType error_signal_2(error_signal.shape());
-  fetch::math::Multiply(error_signal, (*inputs.at(1)), error_signal_1);
-  fetch::math::Multiply(error_signal, (*inputs.at(0)), error_signal_2);
+  fetch::math::kernels::Evaluate(error_signal_1, multiply, error_signal, *inputs.at(1));
+  fetch::math::kernels::Evaluate(error_signal_2, multiply, error_signal, *inputs.at(0));
 
   if (inputs.at(0)->shape() == inputs.at(1)->shape())
   {
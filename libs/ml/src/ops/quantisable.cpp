@@ -0,0 +1,259 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/exceptions/exceptions.hpp"
+#include "math/tensor/tensor.hpp"
+#include "ml/ops/quantisable.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+#include "vectorise/math/int8_dot.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace fetch {
+namespace ml {
+namespace ops {
+
+namespace {
+
+constexpr double QUANTISED_MAX = 127.0;
+
+/**
+ * Quantises the next n values of an iterator into ret, which is padded with zeros
+ * @return the scale of the quantised values
+ */
+template <typename IteratorType>
+double QuantiseRange(IteratorType it, math::SizeType n, int8_t *ret)
+{
+  double max_magnitude{0};
+  auto   first = it;
+  for (math::SizeType k = 0; k < n; ++k, ++it)
+  {
+    max_magnitude = std::max(max_magnitude, std::abs(static_cast<double>(*it)));
+  }
+
+  if (max_magnitude == 0)
+  {
+    std::fill(ret, ret + n, int8_t{0});
+    return 0;
+  }
+
+  double const scale = max_magnitude / QUANTISED_MAX;
+  for (math::SizeType k = 0; k < n; ++k, ++first)
+  {
+    double const value   = std::round(static_cast<double>(*first) / scale);
+    double const clamped = std::min(std::max(value, -QUANTISED_MAX), QUANTISED_MAX);
+    ret[k]               = static_cast<int8_t>(clamped);
+  }
+
+  return scale;
+}
+
+template <typename T>
+math::meta::IfIsFixedPoint<T, T> FromDouble(double value)
+{
+  return math::AsType<T>(value);
+}
+
+template <typename T>
+math::meta::IfIsNotFixedPoint<T, T> FromDouble(double value)
+{
+  return static_cast<T>(value);
+}
+
+math::SizeType PaddedLength(math::SizeType n)
+{
+  math::SizeType const alignment = vectorise::INT8_DOT_ALIGNMENT;
+  return ((n + alignment - 1) / alignment) * alignment;
+}
+
+}  // namespace
+
+/**
+ * Quantises each row of weights with its own scale
+ * @param weights 2D tensor of shape {output channels, input channels}
+ */
+template <typename TensorType>
+QuantisedWeights<TensorType>::QuantisedWeights(TensorType const &weights)
+{
+  if (weights.shape().size() != 2)
+  {
+    throw fetch::math::exceptions::WrongShape("QuantisedWeights: weights must be 2D");
+  }
+
+  rows_    = weights.shape(0);
+  columns_ = weights.shape(1);
+  stride_  = PaddedLength(columns_);
+  values_.assign(rows_ * stride_, int8_t{0});
+  scales_.resize(rows_);
+
+  // rows are strided in the column major tensor, so they are quantised from its transpose
+  TensorType const transposed = weights.Transpose();
+  auto             it         = transposed.cbegin();
+  for (SizeType i = 0; i < rows_; ++i)
+  {
+    scales_[i] = QuantiseRange(it, columns_, values_.data() + (i * stride_));
+    for (SizeType k = 0; k < columns_; ++k)
+    {
+      ++it;
+    }
+  }
+}
+
+/**
+ * Multiplies the quantised weights with x. The columns of x are quantised on the fly, each with its
+ * own scale, and the products are accumulated in int32 before being scaled back.
+ * @param x 2D tensor of shape {input channels, n}
+ * @param ret 2D tensor of shape {output channels, n}
+ */
+template <typename TensorType>
+void QuantisedWeights<TensorType>::Dot(TensorType const &x, TensorType &ret)
+{
+  assert(x.shape().size() == 2 && x.shape(0) == columns_);
+  assert(ret.shape().size() == 2 && ret.shape(0) == rows_ && ret.shape(1) == x.shape(1));
+
+  SizeType const n = x.shape(1);
+  input_values_.assign(n * stride_, int8_t{0});
+  input_scales_.resize(n);
+  products_.resize(rows_ * n);
+
+  auto x_it = x.cbegin();
+  for (SizeType j = 0; j < n; ++j)
+  {
+    input_scales_[j] = QuantiseRange(x_it, columns_, input_values_.data() + (j * stride_));
+    for (SizeType k = 0; k < columns_; ++k)
+    {
+      ++x_it;
+    }
+  }
+
+  vectorise::Int8DotProducts(values_.data(), rows_, input_values_.data(), n, stride_,
+                             products_.data());
+
+  auto ret_it = ret.begin();
+  for (SizeType j = 0; j < n; ++j)
+  {
+    for (SizeType i = 0; i < rows_; ++i)
+    {
+      double const value =
+          static_cast<double>(products_[(j * rows_) + i]) * scales_[i] * input_scales_[j];
+      *ret_it            = FromDouble<DataType>(value);
+      ++ret_it;
+    }
+  }
+}
+
+/**
+ * The dequantised value of one weight
+ */
+template <typename TensorType>
+typename QuantisedWeights<TensorType>::DataType QuantisedWeights<TensorType>::At(
+    SizeType row, SizeType column) const
+{
+  assert(row < rows_ && column < columns_);
+  return FromDouble<DataType>(static_cast<double>(values_[(row * stride_) + column]) *
+                              scales_[row]);
+}
+
+template <typename TensorType>
+bool QuantisedWeights<TensorType>::empty() const
+{
+  return values_.empty();
+}
+
+template <typename TensorType>
+math::SizeType QuantisedWeights<TensorType>::rows() const
+{
+  return rows_;
+}
+
+template <typename TensorType>
+math::SizeType QuantisedWeights<TensorType>::columns() const
+{
+  return columns_;
+}
+
+/**
+ * Memory taken by the int8 values, including the padding of the rows, and the scales
+ */
+template <typename TensorType>
+math::SizeType QuantisedWeights<TensorType>::SizeInBytes() const
+{
+  return (values_.size() * sizeof(int8_t)) + (scales_.size() * sizeof(double));
+}
+
+template <typename TensorType>
+math::SizeType Quantisable<TensorType>::WeightsInput() const
+{
+  return 0;
+}
+
+/**
+ * Drops the quantised weights, after which forward passes use the weights of the op again
+ */
+template <typename TensorType>
+void Quantisable<TensorType>::Dequantise()
+{
+  quantised_weights_ = QuantisedWeights<TensorType>{};
+}
+
+template <typename TensorType>
+bool Quantisable<TensorType>::IsQuantised() const
+{
+  return !quantised_weights_.empty();
+}
+
+template <typename TensorType>
+math::SizeType Quantisable<TensorType>::QuantisedElements() const
+{
+  return quantised_weights_.rows() * quantised_weights_.columns();
+}
+
+template <typename TensorType>
+math::SizeType Quantisable<TensorType>::QuantisedSizeInBytes() const
+{
+  return quantised_weights_.SizeInBytes();
+}
+
+///////////////////////////////
+/// EXPLICIT INSTANTIATIONS ///
+///////////////////////////////
+
+template class QuantisedWeights<math::Tensor<int8_t>>;
+template class QuantisedWeights<math::Tensor<int16_t>>;
+template class QuantisedWeights<math::Tensor<int32_t>>;
+template class QuantisedWeights<math::Tensor<int64_t>>;
+template class QuantisedWeights<math::Tensor<float>>;
+template class QuantisedWeights<math::Tensor<double>>;
+template class QuantisedWeights<math::Tensor<fixed_point::fp32_t>>;
+template class QuantisedWeights<math::Tensor<fixed_point::fp64_t>>;
+template class QuantisedWeights<math::Tensor<fixed_point::fp128_t>>;
+
+template class Quantisable<math::Tensor<int8_t>>;
+template class Quantisable<math::Tensor<int16_t>>;
+template class Quantisable<math::Tensor<int32_t>>;
+template class Quantisable<math::Tensor<int64_t>>;
+template class Quantisable<math::Tensor<float>>;
+template class Quantisable<math::Tensor<double>>;
+template class Quantisable<math::Tensor<fixed_point::fp32_t>>;
+template class Quantisable<math::Tensor<fixed_point::fp64_t>>;
+template class Quantisable<math::Tensor<fixed_point::fp128_t>>;
+
+}  // namespace ops
+}  // namespace ml
+}  // namespace fetch
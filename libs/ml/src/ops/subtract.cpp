@@ -16,6 +16,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "math/kernels/elementwise.hpp"
 #include "ml/charge_estimation/ops/constants.hpp"
 #include "ml/ops/subtract.hpp"
 
@@ -54,7 +55,16 @@ void Subtract<TensorType>::Forward(VecTensorType const &inputs, TensorType &outp
   assert(inputs.at(0)->size() == inputs.at(1)->size());
   assert(output.shape() == this->ComputeOutputShape(inputs));
 
-  fetch::math::Subtract((*inputs.at(0)), (*inputs.at(1)), output);
+  if (inputs.at(0)->shape() == inputs.at(1)->shape())
+  {
+    fetch::math::kernels::Evaluate(
+        output, [](auto const &a, auto const &b, auto &c) { c = a - b; }, *inputs.at(0),
+        *inputs.at(1));
+  }
+  else
+  {
+    fetch::math::Subtract((*inputs.at(0)), (*inputs.at(1)), output);
+  }
 }
 
 template <class TensorType>
@@ -66,7 +76,16 @@ std::vector<TensorType> Subtract<TensorType>::Backward(VecTensorType const &inpu
   assert(inputs.at(0)->size() == inputs.at(1)->size());
   assert(error_signal.size() == inputs.at(1)->size());
 
-  return {error_signal, fetch::math::Multiply(error_signal, DataType{-1})};
+  TensorType return_signal(error_signal.shape());
+  fetch::math::kernels::Evaluate(
+      return_signal,
+      [](auto const &a, auto &b) {
+        using RegisterType = std::decay_t<decltype(a)>;
+        b                  = a * RegisterType(DataType{-1});
+      },
+      error_signal);
+
+  return {error_signal, return_signal};
 }
 
 template <class TensorType>
@@ -17,6 +17,7 @@
 //------------------------------------------------------------------------------
 
 #include "math/fundamental_operators.hpp"
+#include "math/kernels/elementwise.hpp"
 #include "math/matrix_operations.hpp"
 #include "math/trigonometry.hpp"
 #include "ml/ops/tanh.hpp"
@@ -58,15 +59,18 @@ void TanH<TensorType>::Forward(VecTensorType const &inputs, TensorType &output)
   assert(inputs.size() == 1);
   assert(output.shape() == this->ComputeOutputShape(inputs));
   fetch::math::TanH(*(inputs.front()), output);
-  // ensures numerical stability
-  for (auto &val : output)
-  {
-    // Minimum value of tanh is restricted to -1+epsilon
-    val = fetch::vectorise::Max(val, fetch::math::Add(DataType(-1), epsilon_));
-
-    // Maximum value of tanh is restricted to 1-epsilon
-    val = fetch::vectorise::Min(val, fetch::math::Subtract(DataType{1}, epsilon_));
-  }
+
+  // ensures numerical stability, tanh is restricted to [-1+epsilon, 1-epsilon]
+  DataType const min_value = fetch::math::Add(DataType(-1), epsilon_);
+  DataType const max_value = fetch::math::Subtract(DataType{1}, epsilon_);
+  fetch::math::kernels::Evaluate(
+      output,
+      [min_value, max_value](auto const &x, auto &y) {
+        using RegisterType = std::decay_t<decltype(x)>;
+        y = fetch::vectorise::Min(fetch::vectorise::Max(x, RegisterType(min_value)),
+                                  RegisterType(max_value));
+      },
+      output);
 }
 
 template <class TensorType>
@@ -77,17 +81,19 @@ std::vector<TensorType> TanH<TensorType>::Backward(VecTensorType const &inputs,
 
   assert(inputs.front()->shape() == error_signal.shape());
 
-  TensorType return_signal = error_signal.Copy();
+  TensorType return_signal(error_signal.shape());
 
   TensorType t(this->ComputeOutputShape(inputs));
   Forward(inputs, t);
 
-  // gradient of tanh: 1 - tanh(x)^2
-  fetch::math::Multiply(t, t, t);
-  fetch::math::Subtract(DataType{1}, t, t);
-
-  // apply chain rule
-  fetch::math::Multiply(error_signal, t, return_signal);
+  // gradient of tanh: 1 - tanh(x)^2, multiplied by error_signal (chain rule)
+  fetch::math::kernels::Evaluate(
+      return_signal,
+      [](auto const &err, auto const &x, auto &y) {
+        using RegisterType = std::decay_t<decltype(x)>;
+        y                  = err * (RegisterType(DataType{1}) - (x * x));
+      },
+      error_signal, t);
 
   return {return_signal};
 }
@@ -0,0 +1,290 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ml/dataloaders/mapped_dataloader.hpp"
+
+#include "math/base_types.hpp"
+#include "ml/dataloaders/mapped_dataset.hpp"
+#include "ml/dataloaders/tensor_dataloader.hpp"
+#include "ml/exceptions/exceptions.hpp"
+#include "test_types.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace test {
+
+namespace {
+
+using SizeType = fetch::math::SizeType;
+
+char const *const DATASET_FILE = "/tmp/test_mapped_dataset.bin";
+
+template <typename TensorType>
+struct Dataset
+{
+  TensorType labels = TensorType::UniformRandomIntegers(7 * 10, 0, 100);
+  TensorType data1  = TensorType::UniformRandomIntegers(3 * 5 * 10, 0, 100);
+  TensorType data2  = TensorType::UniformRandomIntegers(8 * 2 * 10, 0, 100);
+
+  static TensorType Batch(TensorType const &tensor, SizeType begin, SizeType end)
+  {
+    auto shape   = tensor.shape();
+    shape.back() = end - begin;
+
+    TensorType batch{shape};
+    for (SizeType i = begin; i < end; ++i)
+    {
+      auto view = batch.View(i - begin);
+      view.Assign(tensor.View(i));
+    }
+
+    return batch;
+  }
+
+  Dataset()
+  {
+    labels.Reshape({7, 10});
+    data1.Reshape({3, 5, 10});
+    data2.Reshape({8, 2, 10});
+  }
+
+  // writes the dataset in two uneven batches
+  void Write(std::string const &filename) const
+  {
+    dataloaders::MappedDatasetWriter<TensorType> writer{filename, {7}, {{3, 5}, {8, 2}}, 10};
+
+    writer.Write(Batch(labels, 0, 4), {Batch(data1, 0, 4), Batch(data2, 0, 4)});
+    writer.Write(Batch(labels, 4, 10), {Batch(data1, 4, 10), Batch(data2, 4, 10)});
+    writer.Close();
+
+    EXPECT_EQ(writer.size(), 10);
+  }
+};
+
+template <typename TensorType>
+void ExpectSameBatches(dataloaders::DataLoader<TensorType> &expected_loader,
+                       dataloaders::DataLoader<TensorType> &loader, SizeType batch_size,
+                       SizeType num_batches)
+{
+  for (SizeType i = 0; i < num_batches; ++i)
+  {
+    bool expected_is_done_set = false;
+    bool is_done_set          = false;
+
+    auto expected = expected_loader.PrepareBatch(batch_size, expected_is_done_set);
+    auto batch    = loader.PrepareBatch(batch_size, is_done_set);
+
+    EXPECT_EQ(is_done_set, expected_is_done_set);
+    ASSERT_EQ(batch.first.shape(), expected.first.shape());
+    EXPECT_TRUE(batch.first.AllClose(expected.first));
+
+    ASSERT_EQ(batch.second.size(), expected.second.size());
+    for (SizeType j = 0; j < batch.second.size(); ++j)
+    {
+      ASSERT_EQ(batch.second.at(j).shape(), expected.second.at(j).shape());
+      EXPECT_TRUE(batch.second.at(j).AllClose(expected.second.at(j)));
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+class MappedDataloaderTest : public ::testing::Test
+{
+protected:
+  void TearDown() override
+  {
+    std::remove(DATASET_FILE);
+  }
+};
+
+TYPED_TEST_CASE(MappedDataloaderTest, math::test::TensorFloatingTypes);
+
+TYPED_TEST(MappedDataloaderTest, get_next_matches_tensor_dataloader)
+{
+  Dataset<TypeParam> dataset;
+  dataset.Write(DATASET_FILE);
+
+  dataloaders::TensorDataLoader<TypeParam> expected_loader;
+  expected_loader.AddData({dataset.data1, dataset.data2}, dataset.labels);
+
+  dataloaders::MappedDataLoader<TypeParam> loader{DATASET_FILE};
+
+  EXPECT_EQ(loader.Size(), expected_loader.Size());
+
+  while (!expected_loader.IsDone())
+  {
+    ASSERT_FALSE(loader.IsDone());
+
+    auto expected = expected_loader.GetNext();
+    auto sample   = loader.GetNext();
+
+    ASSERT_EQ(sample.first.shape(), expected.first.shape());
+    EXPECT_TRUE(sample.first.AllClose(expected.first));
+    ASSERT_EQ(sample.second.size(), 2);
+    EXPECT_TRUE(sample.second.at(0).AllClose(expected.second.at(0)));
+    EXPECT_TRUE(sample.second.at(1).AllClose(expected.second.at(1)));
+  }
+
+  EXPECT_TRUE(loader.IsDone());
+}
+
+TYPED_TEST(MappedDataloaderTest, prepare_batch_matches_tensor_dataloader)
+{
+  Dataset<TypeParam> dataset;
+  dataset.Write(DATASET_FILE);
+
+  for (SizeType batch_size : std::vector<SizeType>{1, 3, 4, 10})
+  {
+    dataloaders::TensorDataLoader<TypeParam> expected_loader;
+    expected_loader.AddData({dataset.data1, dataset.data2}, dataset.labels);
+
+    dataloaders::MappedDataLoader<TypeParam> loader{DATASET_FILE};
+
+    ExpectSameBatches(expected_loader, loader, batch_size, 8);
+  }
+}
+
+TYPED_TEST(MappedDataloaderTest, random_mode_matches_tensor_dataloader)
+{
+  Dataset<TypeParam> dataset;
+  dataset.Write(DATASET_FILE);
+
+  dataloaders::TensorDataLoader<TypeParam> expected_loader;
+  expected_loader.AddData({dataset.data1, dataset.data2}, dataset.labels);
+
+  dataloaders::MappedDataLoader<TypeParam> loader{DATASET_FILE};
+
+  expected_loader.SetRandomMode(true);
+  expected_loader.SetSeed(42);
+  loader.SetRandomMode(true);
+  loader.SetSeed(42);
+
+  for (SizeType i = 0; i < 25; ++i)
+  {
+    EXPECT_EQ(loader.IsDone(), expected_loader.IsDone());
+    if (expected_loader.IsDone())
+    {
+      expected_loader.Reset();
+      loader.Reset();
+    }
+
+    auto expected = expected_loader.GetNext();
+    auto sample   = loader.GetNext();
+
+    EXPECT_TRUE(sample.first.AllClose(expected.first));
+    EXPECT_TRUE(sample.second.at(0).AllClose(expected.second.at(0)));
+    EXPECT_TRUE(sample.second.at(1).AllClose(expected.second.at(1)));
+  }
+}
+
+TYPED_TEST(MappedDataloaderTest, splits_match_tensor_dataloader)
+{
+  Dataset<TypeParam> dataset;
+  dataset.Write(DATASET_FILE);
+
+  dataloaders::TensorDataLoader<TypeParam> expected_loader;
+  expected_loader.AddData({dataset.data1, dataset.data2}, dataset.labels);
+
+  dataloaders::MappedDataLoader<TypeParam> loader{DATASET_FILE};
+
+  for (auto *l : std::vector<dataloaders::DataLoader<TypeParam> *>{&expected_loader, &loader})
+  {
+    l->SetTestRatio(math::AsType<fixed_point::fp32_t>(0.2));
+    l->SetValidationRatio(math::AsType<fixed_point::fp32_t>(0.2));
+  }
+
+  EXPECT_EQ(loader.Size(), expected_loader.Size());
+  ExpectSameBatches(expected_loader, loader, 4, 4);
+
+  expected_loader.SetMode(dataloaders::DataLoaderMode::TEST);
+  loader.SetMode(dataloaders::DataLoaderMode::TEST);
+  EXPECT_EQ(loader.Size(), expected_loader.Size());
+  ExpectSameBatches(expected_loader, loader, 3, 4);
+
+  expected_loader.SetMode(dataloaders::DataLoaderMode::VALIDATE);
+  loader.SetMode(dataloaders::DataLoaderMode::VALIDATE);
+  EXPECT_EQ(loader.Size(), expected_loader.Size());
+  ExpectSameBatches(expected_loader, loader, 3, 4);
+}
+
+TYPED_TEST(MappedDataloaderTest, rejects_invalid_files)
+{
+  using OtherTensorType = typename std::conditional<
+      std::is_same<typename TypeParam::Type, double>::value, math::Tensor<float>,
+      math::Tensor<double>>::type;
+
+  // written with another element type
+  {
+    Dataset<OtherTensorType> dataset;
+    dataset.Write(DATASET_FILE);
+  }
+  EXPECT_THROW(dataloaders::MappedDataLoader<TypeParam>{DATASET_FILE}, exceptions::InvalidFile);
+
+  // truncated
+  {
+    Dataset<TypeParam> dataset;
+    dataset.Write(DATASET_FILE);
+
+    std::ifstream        in(DATASET_FILE, std::ios::binary);
+    std::vector<uint8_t> contents{std::istreambuf_iterator<char>(in),
+                                  std::istreambuf_iterator<char>()};
+    in.close();
+
+    std::ofstream out(DATASET_FILE, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<char const *>(contents.data()),
+              static_cast<std::streamsize>(contents.size() - 1));
+  }
+  EXPECT_THROW(dataloaders::MappedDataLoader<TypeParam>{DATASET_FILE}, exceptions::InvalidFile);
+
+  // not a dataset at all
+  {
+    std::ofstream out(DATASET_FILE, std::ios::binary | std::ios::trunc);
+    out << "label,data\n1,2\n";
+  }
+  EXPECT_THROW(dataloaders::MappedDataLoader<TypeParam>{DATASET_FILE}, exceptions::InvalidFile);
+
+  EXPECT_THROW(dataloaders::MappedDataLoader<TypeParam>{"/tmp/no_such_mapped_dataset.bin"},
+               exceptions::InvalidFile);
+}
+
+TYPED_TEST(MappedDataloaderTest, writer_checks_shapes_and_sample_count)
+{
+  dataloaders::MappedDatasetWriter<TypeParam> writer{DATASET_FILE, {2}, {{3}}, 4};
+
+  EXPECT_THROW(writer.Write(TypeParam({2, 2}), {TypeParam({4, 2})}), exceptions::InvalidInput);
+  EXPECT_THROW(writer.Write(TypeParam({2, 5}), {TypeParam({3, 5})}), exceptions::InvalidInput);
+
+  writer.Write(TypeParam({2, 3}), {TypeParam({3, 3})});
+  EXPECT_EQ(writer.size(), 3);
+
+  EXPECT_THROW(writer.Close(), exceptions::InvalidInput);
+}
+
+}  // namespace test
+}  // namespace ml
+}  // namespace fetch
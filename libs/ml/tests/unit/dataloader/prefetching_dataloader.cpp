@@ -0,0 +1,243 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ml/dataloaders/code2vec_context_loaders/context_loader.hpp"
+#include "ml/dataloaders/prefetching_dataloader.hpp"
+#include "ml/dataloaders/tensor_dataloader.hpp"
+#include "ml/dataloaders/word2vec_loaders/sgns_w2v_dataloader.hpp"
+
+#include "math/base_types.hpp"
+#include "test_types.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace test {
+
+template <typename T>
+class PrefetchingDataloaderTest : public ::testing::Test
+{
+protected:
+  using SizeType = fetch::math::SizeType;
+
+  static std::shared_ptr<dataloaders::TensorDataLoader<T>> MakeTensorLoader()
+  {
+    T label_tensor{{1, 10}};
+    T data_tensor{{2, 3, 10}};
+    for (SizeType i = 0; i < 10; ++i)
+    {
+      label_tensor(0, i) = static_cast<typename T::Type>(i);
+      for (SizeType j = 0; j < 3; ++j)
+      {
+        data_tensor(0, j, i) = static_cast<typename T::Type>(i * 10 + j);
+        data_tensor(1, j, i) = static_cast<typename T::Type>(i * 10 + j + 5);
+      }
+    }
+
+    auto loader = std::make_shared<dataloaders::TensorDataLoader<T>>();
+    loader->AddData({data_tensor}, label_tensor);
+    return loader;
+  }
+
+  static std::shared_ptr<dataloaders::GraphW2VLoader<T>> MakeW2VLoader()
+  {
+    auto loader = std::make_shared<dataloaders::GraphW2VLoader<T>>(
+        1, 2, fetch::fixed_point::fp64_t{1}, 100);
+    loader->BuildVocabAndData({"This is a test sentence of total length ten words.",
+                               "and a second sentence of a few more words"});
+    loader->InitUnigramTable(100);
+    return loader;
+  }
+
+  static std::shared_ptr<dataloaders::C2VLoader<T>> MakeC2VLoader()
+  {
+    auto loader = std::make_shared<dataloaders::C2VLoader<T>>(10);
+    loader->AddDataAsString(
+        "get|timestamp override,-726273290,long override,-733851942,METHOD_NAME "
+        "long,1625949899,METHOD_NAME long,-54675710,timestamp METHOD_NAME,263491700,timestamp\n"
+        "get|type override,-1057165453,type override,-733851942,METHOD_NAME "
+        "type,1387642418,METHOD_NAME type,774787451,type METHOD_NAME,263491700,type\n"
+        "content override,-1256194184,subview override,-733851942,METHOD_NAME "
+        "subview,1466431311,METHOD_NAME subview,-1710811525,aboutblock "
+        "METHOD_NAME,-345275919,aboutblock");
+    return loader;
+  }
+
+  static void ExpectEqualBatches(std::pair<T, std::vector<T>> const &expected,
+                                 std::pair<T, std::vector<T>> const &actual)
+  {
+    ASSERT_EQ(expected.first.shape(), actual.first.shape());
+    EXPECT_TRUE(expected.first.AllClose(actual.first));
+
+    ASSERT_EQ(expected.second.size(), actual.second.size());
+    for (SizeType i = 0; i < expected.second.size(); ++i)
+    {
+      ASSERT_EQ(expected.second.at(i).shape(), actual.second.at(i).shape());
+      EXPECT_TRUE(expected.second.at(i).AllClose(actual.second.at(i)));
+    }
+  }
+
+  // runs epochs in the same way as the optimiser
+  static void ExpectSameAsSynchronous(dataloaders::DataLoader<T> &        synchronous,
+                                      dataloaders::PrefetchingDataLoader<T> &prefetching,
+                                      SizeType batch_size, SizeType num_epochs)
+  {
+    for (SizeType epoch = 0; epoch < num_epochs; ++epoch)
+    {
+      ASSERT_EQ(synchronous.IsDone(), prefetching.IsDone());
+      if (synchronous.IsDone())
+      {
+        synchronous.Reset();
+        prefetching.Reset();
+      }
+
+      bool sync_done{false};
+      bool prefetch_done{false};
+      while (!sync_done && !synchronous.IsDone())
+      {
+        auto const expected = synchronous.PrepareBatch(batch_size, sync_done);
+        auto const actual   = prefetching.PrepareBatch(batch_size, prefetch_done);
+
+        ExpectEqualBatches(expected, actual);
+        ASSERT_EQ(sync_done, prefetch_done);
+        ASSERT_EQ(synchronous.IsDone(), prefetching.IsDone());
+      }
+    }
+  }
+};
+
+TYPED_TEST_CASE(PrefetchingDataloaderTest, math::test::TensorFloatingTypes);
+
+TYPED_TEST(PrefetchingDataloaderTest, tensor_loader_batches_match_synchronous)
+{
+  for (fetch::math::SizeType batch_size : {1u, 3u, 5u, 10u})
+  {
+    auto synchronous = this->MakeTensorLoader();
+    dataloaders::PrefetchingDataLoader<TypeParam> prefetching{this->MakeTensorLoader()};
+
+    this->ExpectSameAsSynchronous(*synchronous, prefetching, batch_size, 4);
+  }
+}
+
+TYPED_TEST(PrefetchingDataloaderTest, tensor_loader_random_mode_matches_synchronous)
+{
+  auto synchronous = this->MakeTensorLoader();
+  synchronous->SetRandomMode(true);
+  synchronous->SetSeed(7);
+
+  dataloaders::PrefetchingDataLoader<TypeParam> prefetching{this->MakeTensorLoader(), 3};
+  prefetching.SetRandomMode(true);
+  prefetching.SetSeed(7);
+
+  this->ExpectSameAsSynchronous(*synchronous, prefetching, 4, 3);
+}
+
+TYPED_TEST(PrefetchingDataloaderTest, w2v_loader_batches_match_synchronous)
+{
+  auto synchronous = this->MakeW2VLoader();
+  dataloaders::PrefetchingDataLoader<TypeParam> prefetching{this->MakeW2VLoader()};
+
+  this->ExpectSameAsSynchronous(*synchronous, prefetching, 8, 3);
+}
+
+TYPED_TEST(PrefetchingDataloaderTest, c2v_loader_batches_match_synchronous)
+{
+  auto synchronous = this->MakeC2VLoader();
+  dataloaders::PrefetchingDataLoader<TypeParam> prefetching{this->MakeC2VLoader()};
+
+  this->ExpectSameAsSynchronous(*synchronous, prefetching, 2, 3);
+}
+
+TYPED_TEST(PrefetchingDataloaderTest, shuffle_is_deterministic_and_covers_each_epoch)
+{
+  using DataType = typename TypeParam::Type;
+
+  dataloaders::PrefetchingDataLoader<TypeParam> first{this->MakeTensorLoader(), 4, 6};
+  dataloaders::PrefetchingDataLoader<TypeParam> second{this->MakeTensorLoader(), 2, 6};
+  first.SetSeed(11);
+  second.SetSeed(11);
+
+  bool shuffled{false};
+  for (fetch::math::SizeType epoch = 0; epoch < 3; ++epoch)
+  {
+    std::vector<DataType> labels{};
+
+    bool first_done{false};
+    bool second_done{false};
+    while (!first_done && !first.IsDone())
+    {
+      auto const batch = first.PrepareBatch(2, first_done);
+      this->ExpectEqualBatches(batch, second.PrepareBatch(2, second_done));
+      EXPECT_EQ(first_done, second_done);
+
+      for (fetch::math::SizeType i = 0; i < 2; ++i)
+      {
+        labels.emplace_back(batch.first(0, i));
+
+        // the data stays with its label
+        EXPECT_EQ(batch.second.at(0)(0, 0, i), labels.back() * DataType{10});
+      }
+    }
+
+    first.Reset();
+    second.Reset();
+
+    // every sample is seen once per epoch
+    std::vector<DataType> sorted{labels};
+    std::sort(sorted.begin(), sorted.end());
+    ASSERT_EQ(sorted.size(), 10);
+    for (fetch::math::SizeType i = 0; i < sorted.size(); ++i)
+    {
+      EXPECT_EQ(sorted.at(i), static_cast<DataType>(i));
+    }
+
+    shuffled |= (sorted != labels);
+  }
+
+  EXPECT_TRUE(shuffled);
+}
+
+TYPED_TEST(PrefetchingDataloaderTest, reset_and_batch_size_changes_restart_pipeline)
+{
+  dataloaders::PrefetchingDataLoader<TypeParam> prefetching{this->MakeTensorLoader()};
+
+  bool is_done_set{false};
+  prefetching.PrepareBatch(3, is_done_set);
+  prefetching.PrepareBatch(3, is_done_set);
+  prefetching.Reset();
+
+  auto const synchronous = this->MakeTensorLoader();
+
+  bool sync_done{false};
+  this->ExpectEqualBatches(synchronous->PrepareBatch(4, sync_done),
+                           prefetching.PrepareBatch(4, is_done_set));
+
+  EXPECT_FALSE(is_done_set);
+  EXPECT_EQ(prefetching.Size(), synchronous->Size());
+}
+
+}  // namespace test
+}  // namespace ml
+}  // namespace fetch
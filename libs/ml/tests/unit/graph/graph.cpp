@@ -16,6 +16,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "math/matrix_operations.hpp"
 #include "math/tensor/tensor.hpp"
 #include "ml/charge_estimation/ops/constants.hpp"
 #include "ml/core/graph.hpp"
@@ -1306,6 +1307,71 @@ TYPED_TEST(GraphTest, graph_charge_matmul)
   ASSERT_EQ(batch_charge, expected_charge);
 }
 
+TYPED_TEST(GraphTest, graph_quantise_dense_layers)
+{
+  using TensorType = TypeParam;
+  using DataType   = typename TensorType::Type;
+  using Dense      = fetch::ml::layers::FullyConnected<TensorType>;
+  using math::SizeType;
+
+  fetch::ml::Graph<TensorType> g;
+
+  std::string input  = g.template AddNode<fetch::ml::ops::PlaceHolder<TensorType>>("Input", {});
+  std::string layer  = g.template AddNode<Dense>("FC1", {input}, 20u, 8u);
+  std::string output = g.template AddNode<Dense>("FC2", {layer}, 8u, 4u);
+
+  TensorType data({20, 5});
+  data.FillUniformRandom();
+  g.SetInput(input, data);
+
+  TensorType const gt         = g.Evaluate(output, false);
+  SizeType const   float_size = g.WeightsSizeInBytes();
+  EXPECT_EQ(float_size, (20 * 8 + 8 + 8 * 4 + 4) * sizeof(DataType));
+
+  g.Quantise();
+
+  DataType const tolerance = math::Type<DataType>("0.05");
+  EXPECT_TRUE(g.Evaluate(output, false).AllClose(gt, tolerance, tolerance));
+
+  // rows of 20 and 8 weights are padded to 32, with a scale per row, and the biases are unchanged
+  EXPECT_EQ(g.WeightsSizeInBytes(),
+            (8 + 4) * 32 + (8 + 4) * sizeof(double) + (8 + 4) * sizeof(DataType));
+
+  // training keeps using the original weights, once the cached outputs are cleared
+  g.SetInput(input, data);
+  EXPECT_TRUE(g.Evaluate(output, true).AllClose(gt));
+
+  g.Dequantise();
+  EXPECT_TRUE(g.Evaluate(output, false).AllClose(gt));
+  EXPECT_EQ(g.WeightsSizeInBytes(), float_size);
+}
+
+TYPED_TEST(GraphTest, graph_quantise_skips_products_of_inputs)
+{
+  using namespace fetch::ml::ops;
+  using TensorType = TypeParam;
+
+  TensorType weights_data = TensorType::FromString(R"(01,02,03,04; 11,12,13,14)");
+  TensorType input_data   = TensorType::FromString(R"(01,02; 11,12; 21,22; 31,32)");
+
+  fetch::ml::Graph<TensorType> g;
+
+  std::string weights = g.template AddNode<PlaceHolder<TensorType>>("Weights", {});
+  std::string input   = g.template AddNode<PlaceHolder<TensorType>>("Input", {});
+  std::string matmul =
+      g.template AddNode<MatrixMultiply<TensorType>>("MatMul", {"Weights", "Input"});
+
+  g.SetInput(weights, weights_data);
+  g.SetInput(input, input_data);
+  g.Quantise();
+
+  auto op = std::dynamic_pointer_cast<MatrixMultiply<TensorType>>(g.GetNode(matmul)->GetOp());
+  ASSERT_TRUE(op);
+  EXPECT_FALSE(op->IsQuantised());
+  EXPECT_EQ(g.WeightsSizeInBytes(), 0);
+  EXPECT_TRUE(g.Evaluate(matmul, false).AllClose(math::Dot(weights_data, input_data)));
+}
+
 }  // namespace test
 }  // namespace ml
 }  // namespace fetch
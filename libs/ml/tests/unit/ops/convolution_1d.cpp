@@ -292,4 +292,53 @@ TYPED_TEST(Convolution1DTest, backward_3x3x2_5x3x3x2)
                                      fetch::math::function_tolerance<DataType>()));
 }
 
+TYPED_TEST(Convolution1DTest, quantised_forward_3x10x2_4x3x3x1)
+{
+  using DataType   = typename TypeParam::Type;
+  using TensorType = TypeParam;
+  using SizeType   = fetch::math::SizeType;
+
+  auto value = [](int n) { return fetch::math::AsType<DataType>(n) / DataType{32}; };
+
+  // every kernel and every patch of the input has a largest magnitude of 127 / 32, which makes
+  // quantising them exact
+  TensorType input({3, 10, 2});
+  TensorType weights({4, 3, 3, 1});
+  for (SizeType c{0}; c < 3; ++c)
+  {
+    for (SizeType h{0}; h < 10; ++h)
+    {
+      input.At(c, h, 0) = value(((c + h) % 2 == 0) ? 127 : -127);
+      input.At(c, h, 1) = value((c == 1) ? -127 : 127);
+    }
+  }
+  for (SizeType o{0}; o < 4; ++o)
+  {
+    for (SizeType c{0}; c < 3; ++c)
+    {
+      for (SizeType h{0}; h < 3; ++h)
+      {
+        weights.At(o, c, h, 0) = value(static_cast<int>((o * 31 + c * 17 + h * 5) % 255) - 127);
+      }
+    }
+    weights.At(o, o % 3, 1, 0) = value(127);
+  }
+
+  fetch::ml::ops::Convolution1D<TensorType> c;
+  TensorType                                gt(c.ComputeOutputShape(
+      {std::make_shared<TensorType>(input), std::make_shared<TensorType>(weights)}));
+  c.Forward({std::make_shared<TensorType>(input), std::make_shared<TensorType>(weights)}, gt);
+
+  c.Quantise(weights);
+  c.SetTraining(false);
+  ASSERT_TRUE(c.IsQuantised());
+  EXPECT_EQ(c.WeightsInput(), 1);
+
+  TensorType output(gt.shape());
+  c.Forward({std::make_shared<TensorType>(input), std::make_shared<TensorType>(weights)}, output);
+
+  ASSERT_EQ(output.shape(), std::vector<SizeType>({4, 8, 2}));
+  EXPECT_TRUE(output.AllClose(gt));
+}
+
 }  // namespace
@@ -249,4 +249,60 @@ TYPED_TEST(Convolution2DTest, backward_3x3x3x2_5x3x3x3x2)
                                      fetch::math::function_tolerance<DataType>()));
 }
 
+TYPED_TEST(Convolution2DTest, quantised_forward_2x5x5x2_3x2x3x3x1)
+{
+  using DataType   = typename TypeParam::Type;
+  using TensorType = TypeParam;
+  using SizeType   = fetch::math::SizeType;
+
+  auto value = [](int n) { return fetch::math::AsType<DataType>(n) / DataType{32}; };
+
+  // every kernel and every patch of the input has a largest magnitude of 127 / 32, which makes
+  // quantising them exact
+  TensorType input({2, 5, 5, 2});
+  TensorType weights({3, 2, 3, 3, 1});
+  for (SizeType c{0}; c < 2; ++c)
+  {
+    for (SizeType h{0}; h < 5; ++h)
+    {
+      for (SizeType w{0}; w < 5; ++w)
+      {
+        input.At(c, h, w, 0) = value(((c + h + w) % 2 == 0) ? 127 : -127);
+        input.At(c, h, w, 1) = value((h < 2) ? -127 : 127);
+      }
+    }
+  }
+  for (SizeType o{0}; o < 3; ++o)
+  {
+    for (SizeType c{0}; c < 2; ++c)
+    {
+      for (SizeType h{0}; h < 3; ++h)
+      {
+        for (SizeType w{0}; w < 3; ++w)
+        {
+          weights.At(o, c, h, w, 0) =
+              value(static_cast<int>((o * 31 + c * 17 + h * 5 + w * 3) % 255) - 127);
+        }
+      }
+    }
+    weights.At(o, o % 2, 1, 1, 0) = value(-127);
+  }
+
+  fetch::ml::ops::Convolution2D<TensorType> c;
+  TensorType                                gt(c.ComputeOutputShape(
+      {std::make_shared<TensorType>(input), std::make_shared<TensorType>(weights)}));
+  c.Forward({std::make_shared<TensorType>(input), std::make_shared<TensorType>(weights)}, gt);
+
+  c.Quantise(weights);
+  c.SetTraining(false);
+  ASSERT_TRUE(c.IsQuantised());
+  EXPECT_EQ(c.WeightsInput(), 1);
+
+  TensorType output(gt.shape());
+  c.Forward({std::make_shared<TensorType>(input), std::make_shared<TensorType>(weights)}, output);
+
+  ASSERT_EQ(output.shape(), std::vector<SizeType>({3, 3, 3, 2}));
+  EXPECT_TRUE(output.AllClose(gt));
+}
+
 }  // namespace
@@ -147,4 +147,44 @@ TYPED_TEST(EmbeddingsTest, backward)
   }
 }
 
+TYPED_TEST(EmbeddingsTest, quantised_forward)
+{
+  fetch::ml::ops::Embeddings<TypeParam> e(6, 10);
+
+  // every embedding has a largest magnitude of 127, which makes quantising them exact
+  TypeParam weights(std::vector<uint64_t>({6, 10}));
+  for (uint32_t i(0); i < 10; ++i)
+  {
+    for (uint32_t j(0); j < 5; ++j)
+    {
+      weights(j, i) = typename TypeParam::Type(i * 10 + j);
+    }
+    weights(5, i) = typename TypeParam::Type(127);
+  }
+
+  e.SetData(weights);
+
+  TypeParam input(std::vector<uint64_t>({2, 2}));
+  input.At(0, 0) = typename TypeParam::Type(3);
+  input.At(1, 0) = typename TypeParam::Type(5);
+  input.At(0, 1) = typename TypeParam::Type(9);
+  input.At(1, 1) = typename TypeParam::Type(0);
+
+  TypeParam gt(e.ComputeOutputShape({std::make_shared<TypeParam>(input)}));
+  e.Forward({std::make_shared<TypeParam>(input)}, gt);
+
+  e.Quantise(weights);
+  e.SetTraining(false);
+  ASSERT_TRUE(e.IsQuantised());
+
+  TypeParam output(gt.shape());
+  e.Forward({std::make_shared<TypeParam>(input)}, output);
+
+  ASSERT_EQ(output.shape(), std::vector<typename TypeParam::SizeType>({6, 2, 2}));
+  EXPECT_TRUE(output.AllClose(gt));
+
+  // 10 embeddings of 6 values, each padded to 32, and their scales
+  EXPECT_EQ(e.QuantisedSizeInBytes(), 10 * 32 + 10 * sizeof(double));
+}
+
 }  // namespace
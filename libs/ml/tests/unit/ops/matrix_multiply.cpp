@@ -16,6 +16,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "math/matrix_operations.hpp"
 #include "ml/ops/matrix_multiply.hpp"
 #include "test_types.hpp"
 
@@ -34,6 +35,13 @@ class MatrixMultiplyTest : public ::testing::Test
 
 TYPED_TEST_CASE(MatrixMultiplyTest, fetch::math::test::TensorIntAndFloatingTypes);
 
+template <typename T>
+class MatrixMultiplyQuantisedTest : public ::testing::Test
+{
+};
+
+TYPED_TEST_CASE(MatrixMultiplyQuantisedTest, fetch::math::test::TensorFloatingTypes);
+
 TYPED_TEST(MatrixMultiplyTest, forward_test)
 {
   TypeParam a = TypeParam::FromString(R"(1, 2, -3, 4, 5)");
@@ -118,4 +126,63 @@ TYPED_TEST(MatrixMultiplyTest, backward_batch_test)
   EXPECT_TRUE(backpropagated_signals[1].AllClose(gradient_b));
 }
 
+/**
+ * Every row of a and every column of b have a largest magnitude of 127 / 32, so quantising them is
+ * exact and the int8 product has to match the float one
+ */
+TYPED_TEST(MatrixMultiplyQuantisedTest, quantised_forward_test)
+{
+  using DataType = typename TypeParam::Type;
+  using SizeType = typename TypeParam::SizeType;
+
+  auto value = [](int n) { return fetch::math::AsType<DataType>(n) / DataType{32}; };
+
+  TypeParam a({5, 40});
+  TypeParam b({40, 3});
+  TypeParam b_batch({40, 3, 2});
+  for (SizeType k{0}; k < 40; ++k)
+  {
+    for (SizeType i{0}; i < 5; ++i)
+    {
+      a.At(i, k) = (i == k) ? value(127) : value(static_cast<int>((i * 13 + k * 7) % 255) - 127);
+    }
+    for (SizeType j{0}; j < 3; ++j)
+    {
+      b.At(k, j) = (j == k) ? value(-127) : value(static_cast<int>((j * 5 + k * 11) % 255) - 127);
+      b_batch.At(k, j, 0) = b.At(k, j);
+      b_batch.At(k, j, 1) = -b.At(k, j);
+    }
+  }
+
+  fetch::ml::ops::MatrixMultiply<TypeParam> op;
+  op.Quantise(a);
+  op.SetTraining(false);
+  ASSERT_TRUE(op.IsQuantised());
+
+  TypeParam prediction(
+      op.ComputeOutputShape({std::make_shared<TypeParam>(a), std::make_shared<TypeParam>(b)}));
+  op.Forward({std::make_shared<TypeParam>(a), std::make_shared<TypeParam>(b)}, prediction);
+  EXPECT_TRUE(prediction.AllClose(fetch::math::Dot(a, b)));
+
+  TypeParam batch_prediction(op.ComputeOutputShape(
+      {std::make_shared<TypeParam>(a), std::make_shared<TypeParam>(b_batch)}));
+  op.Forward({std::make_shared<TypeParam>(a), std::make_shared<TypeParam>(b_batch)},
+             batch_prediction);
+  ASSERT_EQ(batch_prediction.shape(), std::vector<SizeType>({5, 3, 2}));
+  for (SizeType i{0}; i < 5; ++i)
+  {
+    for (SizeType j{0}; j < 3; ++j)
+    {
+      EXPECT_EQ(batch_prediction.At(i, j, 0), prediction.At(i, j));
+      EXPECT_EQ(batch_prediction.At(i, j, 1), -prediction.At(i, j));
+    }
+  }
+
+  // 5 rows of 40 values, each padded to 64, and their scales
+  EXPECT_EQ(op.QuantisedSizeInBytes(), 5 * 64 + 5 * sizeof(double));
+
+  op.Dequantise();
+  EXPECT_FALSE(op.IsQuantised());
+}
+
 }  // namespace
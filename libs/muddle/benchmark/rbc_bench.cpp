@@ -16,9 +16,11 @@
 //
 //------------------------------------------------------------------------------
 
+#include "muddle/erasure_coded_rbc.hpp"
 #include "muddle/punishment_broadcast_channel.hpp"
 #include "muddle/rbc.hpp"
 
+#include "core/byte_array/byte_array.hpp"
 #include "core/byte_array/const_byte_array.hpp"
 #include "core/reactor.hpp"
 #include "crypto/ecdsa.hpp"
@@ -31,6 +33,8 @@
 
 #include "muddle/create_muddle_fake.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <type_traits>
 #include <vector>
 
@@ -390,3 +394,196 @@ void DKGWithEcho(benchmark::State &state)
 
 BENCHMARK_TEMPLATE(DKGWithEcho, PBCNode)->Range(4, 100)->Unit(benchmark::kMillisecond);
 BENCHMARK_TEMPLATE(DKGWithEcho, RBCNode)->Range(4, 64)->Unit(benchmark::kMillisecond);
+
+// Counts the bytes a reliable channel sends to the other cabinet members
+template <typename Channel, typename Message>
+class CountingChannel : public Channel
+{
+public:
+  using Channel::Channel;
+  using MuddleAddress = typename Channel::MuddleAddress;
+
+  uint64_t bytes_sent() const
+  {
+    return bytes_sent_;
+  }
+
+protected:
+  void Send(Message const &msg, MuddleAddress const &address) override
+  {
+    bytes_sent_ += SerialisedSize(msg);
+    Channel::Send(msg, address);
+  }
+
+  void InternalBroadcast(Message const &msg) override
+  {
+    bytes_sent_ += SerialisedSize(msg) * (this->current_cabinet().size() - 1);
+    Channel::InternalBroadcast(msg);
+  }
+
+private:
+  static uint64_t SerialisedSize(Message const &msg)
+  {
+    RBCSerializerCounter counter;
+    counter << msg;
+    return counter.size();
+  }
+
+  std::atomic<uint64_t> bytes_sent_{0};
+};
+
+template <typename Channel>
+struct CountingNode : public AbstractRBCNode
+{
+  static constexpr const char *LOGGING_NAME = "CountingNode";
+
+  CountingNode(uint16_t port_number, uint16_t index)
+    : AbstractRBCNode(port_number, index)
+    , channel{muddle->GetEndpoint(), muddle_certificate->identity().identifier(),
+              [this](MuddleAddress const &from, ConstByteArray const &payload) -> void {
+                FETCH_LOCK(mutex);
+                answers[from] = payload;
+              }}
+  {}
+
+  void ResetCabinet(RBC::CabinetMembers const &members) override
+  {
+    channel.ResetCabinet(members);
+  }
+
+  void SendMessage() override
+  {
+    channel.Broadcast(message);
+  }
+
+  void Enable(bool enable) override
+  {
+    channel.Enable(enable);
+  }
+
+  void PrepareForTest(uint16_t /*test*/) override
+  {}
+
+  ConstByteArray message;
+  Channel        channel;
+};
+
+using RBCBandwidthNode = CountingNode<CountingChannel<RBC, RBCMessage>>;
+using ErasureCodedRBCBandwidthNode =
+    CountingNode<CountingChannel<ErasureCodedRBC, ErasureCodedRBCMessage>>;
+
+// Broadcasts a message of a given size from one or all of the cabinet members and reports the
+// bytes sent by each member. Arguments: cabinet size, message size, all members broadcast (0/1)
+template <class NODE_TYPE>
+void ReliableBroadcastBandwidth(benchmark::State &state)
+{
+  SetGlobalLogLevel(LogLevel::ERROR);
+
+  auto const cabinet_size     = static_cast<uint16_t>(state.range(0));
+  auto const message_size     = static_cast<std::size_t>(state.range(1));
+  auto const num_broadcasters = static_cast<uint16_t>(state.range(2) ? cabinet_size : 1);
+
+  byte_array::ByteArray message;
+  message.Resize(message_size);
+  for (std::size_t i = 0; i < message_size; ++i)
+  {
+    message[i] = static_cast<uint8_t>(i * 7);
+  }
+
+  uint64_t total_bytes{0};
+  uint64_t max_node_bytes{0};
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+
+    std::vector<std::unique_ptr<NODE_TYPE>> nodes;
+    RBC::CabinetMembers                     cabinet;
+
+    for (uint16_t i = 0; i < cabinet_size; ++i)
+    {
+      nodes.emplace_back(std::make_unique<NODE_TYPE>(static_cast<uint16_t>(8000 + i), i));
+      nodes.back()->Start();
+      nodes.back()->message = message;
+      cabinet.insert(nodes.back()->muddle_certificate->identity().identifier());
+
+      for (uint16_t j = 0; j < i; ++j)
+      {
+        nodes[i]->muddle->ConnectTo(nodes[j]->GetMuddleAddress(), nodes[j]->GetHint());
+      }
+    }
+
+    for (auto const &node : nodes)
+    {
+      node->ResetCabinet(cabinet);
+      while (node->muddle->GetNumDirectlyConnectedPeers() != cabinet_size - 1u)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+
+    state.ResumeTiming();
+
+    for (uint16_t i = 0; i < num_broadcasters; ++i)
+    {
+      nodes[i]->SendMessage();
+    }
+
+    // members do not deliver their own message
+    for (uint16_t i = 0; i < cabinet_size; ++i)
+    {
+      uint64_t const expected = num_broadcasters - ((i < num_broadcasters) ? 1u : 0u);
+      while (nodes[i]->MessagesReceived() < expected)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+
+    state.PauseTiming();
+
+    uint64_t iteration_max{0};
+    for (auto const &node : nodes)
+    {
+      total_bytes += node->channel.bytes_sent();
+      iteration_max = std::max(iteration_max, node->channel.bytes_sent());
+    }
+    max_node_bytes += iteration_max;
+
+    nodes.clear();
+
+    state.ResumeTiming();
+  }
+
+  state.counters["bytes_per_node"] =
+      benchmark::Counter(static_cast<double>(total_bytes) / cabinet_size,
+                         benchmark::Counter::kAvgIterations);
+  state.counters["max_bytes_per_node"] =
+      benchmark::Counter(static_cast<double>(max_node_bytes), benchmark::Counter::kAvgIterations);
+}
+
+void BandwidthArguments(benchmark::internal::Benchmark *b)
+{
+  for (int64_t all_broadcast : {0, 1})
+  {
+    for (int64_t cabinet_size : {4, 16, 32})
+    {
+      for (int64_t message_size : {1 << 10, 1 << 16, 1 << 20})
+      {
+        // re-encoding every message is slow for the largest cases
+        if (all_broadcast && (cabinet_size > 16) && (message_size > (1 << 16)))
+        {
+          continue;
+        }
+
+        b->Args({cabinet_size, message_size, all_broadcast});
+      }
+    }
+  }
+}
+
+BENCHMARK_TEMPLATE(ReliableBroadcastBandwidth, RBCBandwidthNode)
+    ->Apply(BandwidthArguments)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(ReliableBroadcastBandwidth, ErasureCodedRBCBandwidthNode)
+    ->Apply(BandwidthArguments)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,148 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "muddle_register.hpp"
+#include "router.hpp"
+
+#include "core/byte_array/byte_array.hpp"
+#include "crypto/ecdsa.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "muddle/network_id.hpp"
+#include "muddle/packet.hpp"
+#include "muddle/router_configuration.hpp"
+#include "muddle/subscription.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::ECDSASigner;
+using fetch::muddle::MuddleRegister;
+using fetch::muddle::NetworkId;
+using fetch::muddle::Packet;
+using fetch::muddle::Router;
+using fetch::muddle::RouterConfiguration;
+
+using PacketPtr     = std::shared_ptr<Packet>;
+using Subscriptions = std::vector<Router::SubscriptionPtr>;
+
+constexpr uint16_t    SERVICE          = 1;
+constexpr uint16_t    NUM_CHANNELS     = 16;
+constexpr std::size_t NUM_SENDERS      = 64;
+constexpr std::size_t PACKETS_PER_PEER = 64;
+constexpr std::size_t PAYLOAD_SIZE     = 2048;
+
+ConstByteArray RandomBytes(std::mt19937_64 &rng, std::size_t size)
+{
+  ByteArray bytes;
+  bytes.Resize(size);
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    bytes[i] = static_cast<uint8_t>(rng());
+  }
+
+  return {bytes};
+}
+
+// Routes packets from many different peers to a router and measures how quickly they are all
+// handed to their subscriptions
+void Router_DispatchThroughput(benchmark::State &state)
+{
+  NetworkId const network{"TEST"};
+  ECDSASigner     signer{};
+  MuddleRegister  reg{network};
+
+  RouterConfiguration config{};
+  config.dispatch_threads = static_cast<std::size_t>(state.range(0));
+
+  Router router{network, signer.identity().identifier(), reg, signer, false, config};
+  router.Start();
+
+  // a handler per channel, each of which does a little work for every message
+  std::atomic<std::size_t> dispatched{0};
+  Subscriptions            subscriptions{};
+  for (uint16_t channel = 0; channel < NUM_CHANNELS; ++channel)
+  {
+    subscriptions.emplace_back(router.Subscribe(SERVICE, channel));
+    subscriptions.back()->SetMessageHandler(
+        [&dispatched](Packet::Address const &, ConstByteArray const &payload) {
+          benchmark::DoNotOptimize(fetch::crypto::Hash<fetch::crypto::SHA256>(payload));
+          ++dispatched;
+        });
+  }
+
+  // generate the traffic, interleaving the peers as it would arrive from the network
+  std::mt19937_64 rng{42};
+
+  std::vector<Packet::Address> senders{};
+  for (std::size_t i = 0; i < NUM_SENDERS; ++i)
+  {
+    senders.emplace_back(RandomBytes(rng, Packet::ADDRESS_SIZE));
+  }
+
+  auto const payload = RandomBytes(rng, PAYLOAD_SIZE);
+
+  std::vector<PacketPtr> packets{};
+  for (std::size_t i = 0; i < NUM_SENDERS * PACKETS_PER_PEER; ++i)
+  {
+    auto const sender = i % NUM_SENDERS;
+
+    auto packet = std::make_shared<Packet>(senders[sender], network.value());
+    packet->SetTarget(router.GetAddress());
+    packet->SetService(SERVICE);
+    packet->SetChannel(static_cast<uint16_t>(sender % NUM_CHANNELS));
+    packet->SetMessageNum(static_cast<uint16_t>(i));
+    packet->SetPayload(payload);
+
+    packets.emplace_back(std::move(packet));
+  }
+
+  for (auto _ : state)
+  {
+    dispatched = 0;
+
+    for (auto const &packet : packets)
+    {
+      router.Route(0, packet);
+    }
+
+    while (dispatched < packets.size())
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  router.Stop();
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * packets.size()));
+}
+
+}  // namespace
+
+BENCHMARK(Router_DispatchThroughput)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16)->UseRealTime();
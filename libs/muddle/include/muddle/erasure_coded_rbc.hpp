@@ -0,0 +1,179 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "core/service_ids.hpp"
+#include "muddle/erasure_coded_rbc_messages.hpp"
+#include "muddle/muddle_endpoint.hpp"
+#include "muddle/rbc.hpp"
+
+#include <bitset>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace muddle {
+
+class ReedSolomon;
+
+/**
+ * Reliable broadcast channel in which the message is erasure coded (AVID / HoneyBadger style
+ * reliable broadcast) rather than echoed in full.
+ *
+ * The broadcaster Reed-Solomon codes the message into one fragment per cabinet member, any
+ * n - 2f of which reconstruct it, and commits to the fragments with a Merkle root. Each member
+ * is sent only its own fragment with its Merkle proof and echoes that fragment to everyone
+ * else. Members signal ready once n - f echoes reconstruct a message which re-encodes to the
+ * root, and deliver after 2f + 1 ready messages.
+ *
+ * Every member sends about n / (n - 2f) ~ 3 times the message size per broadcast, where the RBC
+ * broadcaster sends the full message to every member (its echoes only carry a hash). This removes
+ * the broadcaster bottleneck for large messages, at the cost of more total traffic when all the
+ * members broadcast at once.
+ */
+class ErasureCodedRBC : public BroadcastChannelInterface
+{
+public:
+  using Endpoint         = muddle::MuddleEndpoint;
+  using ConstByteArray   = byte_array::ConstByteArray;
+  using MuddleAddress    = ConstByteArray;
+  using CabinetMembers   = std::set<MuddleAddress>;
+  using SubscriptionPtr  = std::shared_ptr<muddle::Subscription>;
+  using Message          = ErasureCodedRBCMessage;
+  using MessageType      = Message::Type;
+  using CallbackFunction = std::function<void(MuddleAddress const &, ConstByteArray const &)>;
+
+  ErasureCodedRBC(Endpoint &endpoint, MuddleAddress address, CallbackFunction call_back,
+                  uint16_t channel = CHANNEL_ERASURE_CODED_RBC, bool ordered_delivery = true);
+  ErasureCodedRBC(ErasureCodedRBC const &) = delete;
+  ErasureCodedRBC(ErasureCodedRBC &&)      = delete;
+  ~ErasureCodedRBC() override;
+
+  /// @name Channel Operation
+  /// @{
+  void Broadcast(SerialisedMessage const &msg);
+  bool ResetCabinet(CabinetMembers const &cabinet) override;
+  void Enable(bool enable) override;
+  void SetQuestion(ConstByteArray const &unused, ConstByteArray const &answer) override;
+  WeakRunnable GetRunnable() override;
+  /// @}
+
+  // Operators
+  ErasureCodedRBC &operator=(ErasureCodedRBC const &) = delete;
+  ErasureCodedRBC &operator=(ErasureCodedRBC &&) = delete;
+
+protected:
+  /// @name Message communication - not thread safe
+  /// @{
+  virtual void Send(Message const &msg, MuddleAddress const &address);
+  virtual void InternalBroadcast(Message const &msg);
+  /// @}
+
+  Endpoint &endpoint()
+  {
+    return endpoint_;
+  }
+
+  CabinetMembers const &current_cabinet() const
+  {
+    return current_cabinet_;
+  }
+
+  mutable Mutex lock_;
+
+private:
+  using FlagType   = std::bitset<8>;
+  using Fragments  = std::map<std::size_t, ConstByteArray>;
+  using Deliveries = std::vector<std::pair<MuddleAddress, SerialisedMessage>>;
+  using CoderPtr   = std::unique_ptr<ReedSolomon>;
+
+  enum class Decoding
+  {
+    PENDING,
+    VALID,
+    INVALID
+  };
+
+  struct RootState
+  {
+    Fragments         fragments{};  ///< Echoed fragments with valid proofs, indexed by member
+    uint32_t          ready_count{0};
+    Decoding          decoding{Decoding::PENDING};
+    SerialisedMessage message{};  ///< The reconstructed message, once VALID
+  };
+
+  struct BroadcastState
+  {
+    std::unordered_map<ConstByteArray, RootState> roots{};
+    bool                                          echo_sent{false};
+    bool                                          ready_sent{false};
+    bool                                          delivered{false};
+  };
+
+  struct Party
+  {
+    std::unordered_map<TagType, FlagType> flags{};  ///< Message types received for each tag
+    uint8_t deliver_s = 1;  ///< Counter of the next message to be delivered
+    std::map<uint8_t, SerialisedMessage> undelivered{};  ///< Delivered out of order, by counter
+  };
+
+  /// @name Events - not thread safe
+  /// @{
+  void OnMessage(MuddleAddress const &from, Message const &msg);
+  void OnValue(Message const &msg, uint32_t sender_index, Deliveries &deliveries);
+  void OnEcho(Message const &msg, uint32_t sender_index, Deliveries &deliveries);
+  void OnReady(Message const &msg, uint32_t sender_index, Deliveries &deliveries);
+  /// @}
+
+  /// @name Helper functions - not thread safe
+  /// @{
+  bool BasicMessageCheck(MuddleAddress const &from, Message const &msg) const;
+  bool SetPartyFlag(uint32_t sender_index, TagType tag, MessageType msg_type);
+  bool VerifyFragment(Message const &msg) const;
+  bool Reconstruct(ConstByteArray const &root, RootState &state) const;
+  void SendReady(Message const &msg, Deliveries &deliveries);
+  void TryDeliver(Message const &msg, Deliveries &deliveries);
+  void Deliver(uint32_t id, uint8_t counter, SerialisedMessage const &msg, Deliveries &deliveries);
+  void Dispatch(Deliveries const &deliveries);
+  /// @}
+
+  uint16_t const   channel_;
+  bool const       ordered_delivery_;
+  MuddleAddress    address_;   ///< Our muddle address
+  Endpoint &       endpoint_;  ///< The muddle endpoint to communicate on
+  CallbackFunction deliver_msg_callback_;
+  SubscriptionPtr  subscription_;
+
+  bool                                        enabled_{true};
+  CabinetMembers                              current_cabinet_{};
+  std::vector<MuddleAddress>                  cabinet_index_{};  ///< Cabinet members by index
+  uint32_t                                    id_{0};            ///< Our index in the cabinet
+  uint32_t                                    threshold_{0};  ///< Max. number of faulty members
+  uint8_t                                     msg_counter_{0};
+  CoderPtr                                    coder_;
+  std::vector<Party>                          parties_{};
+  std::unordered_map<TagType, BroadcastState> broadcasts_{};
+};
+
+}  // namespace muddle
+}  // namespace fetch
@@ -0,0 +1,122 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/serializers/base_types.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "muddle/rbc_messages.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace fetch {
+namespace muddle {
+
+/**
+ * Message of the erasure coded reliable broadcast channel.
+ *
+ * RValue - a fragment of the coded message together with its Merkle proof, sent by the
+ * broadcaster to the member which the fragment belongs to
+ * REcho - the member's own fragment and proof, forwarded to every member
+ * RReady - signals that the message committed to by the root can be reconstructed
+ */
+struct ErasureCodedRBCMessage
+{
+  using Digest = byte_array::ConstByteArray;
+  using Proof  = std::vector<Digest>;
+
+  enum class Type : uint8_t
+  {
+    R_VALUE = 1,
+    R_ECHO,
+    R_READY
+  };
+
+  Type                       type{Type::R_VALUE};
+  uint16_t                   channel{0};  ///< Channel Id of the broadcast channel
+  uint32_t                   id{0};       ///< Cabinet index of the broadcaster
+  uint8_t                    counter{0};  ///< Counter for messages sent by the broadcaster
+  Digest                     root{};      ///< Merkle root over the fragments of the message
+  uint32_t                   index{0};    ///< Index of the fragment
+  Proof                      proof{};     ///< Merkle proof of the fragment
+  byte_array::ConstByteArray fragment{};  ///< The fragment of the coded message
+
+  TagType tag() const
+  {
+    TagType msg_tag = channel;
+    msg_tag <<= 48;
+    msg_tag |= id;
+    msg_tag <<= 32;
+    return (msg_tag | uint64_t(counter));
+  }
+};
+
+}  // namespace muddle
+
+namespace serializers {
+
+template <typename D>
+struct MapSerializer<muddle::ErasureCodedRBCMessage, D>
+{
+public:
+  using Type       = muddle::ErasureCodedRBCMessage;
+  using DriverType = D;
+
+  static uint8_t const TYPE     = 1;
+  static uint8_t const CHANNEL  = 2;
+  static uint8_t const ID       = 3;
+  static uint8_t const COUNTER  = 4;
+  static uint8_t const ROOT     = 5;
+  static uint8_t const INDEX    = 6;
+  static uint8_t const PROOF    = 7;
+  static uint8_t const FRAGMENT = 8;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &msg)
+  {
+    auto map = map_constructor(8);
+    map.Append(TYPE, static_cast<uint8_t>(msg.type));
+    map.Append(CHANNEL, msg.channel);
+    map.Append(ID, msg.id);
+    map.Append(COUNTER, msg.counter);
+    map.Append(ROOT, msg.root);
+    map.Append(INDEX, msg.index);
+    map.Append(PROOF, msg.proof);
+    map.Append(FRAGMENT, msg.fragment);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &msg)
+  {
+    uint8_t type{0};
+    map.ExpectKeyGetValue(TYPE, type);
+    map.ExpectKeyGetValue(CHANNEL, msg.channel);
+    map.ExpectKeyGetValue(ID, msg.id);
+    map.ExpectKeyGetValue(COUNTER, msg.counter);
+    map.ExpectKeyGetValue(ROOT, msg.root);
+    map.ExpectKeyGetValue(INDEX, msg.index);
+    map.ExpectKeyGetValue(PROOF, msg.proof);
+    map.ExpectKeyGetValue(FRAGMENT, msg.fragment);
+
+    msg.type = static_cast<muddle::ErasureCodedRBCMessage::Type>(type);
+  }
+};
+
+}  // namespace serializers
+}  // namespace fetch
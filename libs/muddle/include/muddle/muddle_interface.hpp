@@ -19,7 +19,9 @@
 
 #include "moment/clock_interfaces.hpp"
 #include "muddle/address.hpp"
+#include "muddle/broadcast_mode.hpp"
 #include "muddle/peer_selection_mode.hpp"
+#include "muddle/router_configuration.hpp"
 #include "muddle/tracker_configuration.hpp"
 #include "network/uri.hpp"
 
@@ -302,6 +304,16 @@ public:
    * @param config The configuration for the peer tracker
    */
   virtual void SetTrackerConfiguration(TrackerConfiguration const &config) = 0;
+
+  /**
+   * Select how broadcasts for a service and channel are propagated. All the nodes of a network
+   * should use the same mode for a given service and channel.
+   *
+   * @param service The service identifier
+   * @param channel The channel identifier
+   * @param mode The broadcast mode
+   */
+  virtual void SetBroadcastMode(uint16_t service, uint16_t channel, BroadcastMode mode) = 0;
   /// @}
 };
 
@@ -309,6 +321,9 @@ using MuddlePtr = std::shared_ptr<MuddleInterface>;
 using ProverPtr = std::shared_ptr<crypto::Prover>;
 
 // creation
+MuddlePtr CreateMuddle(NetworkId const &network, ProverPtr certificate,
+                       network::NetworkManager const &nm, std::string const &external_address,
+                       bool enable_message_signing, RouterConfiguration const &router_config);
 MuddlePtr CreateMuddle(NetworkId const &network, ProverPtr certificate,
                        network::NetworkManager const &nm, std::string const &external_address,
                        bool enable_message_signing);
@@ -20,6 +20,9 @@
 #include "moment/clock_interfaces.hpp"
 #include "network/service/promise.hpp"
 
+#include <cstddef>
+#include <cstdint>
+
 namespace fetch {
 namespace muddle {
 
@@ -33,7 +36,16 @@ struct RouterConfiguration
   uint64_t max_delivery_attempts{3};
   Duration temporary_connection_length{
       std::chrono::seconds(4)};  ///< Time should be slightly longer than the retry period
-  uint32_t retry_delay_ms{2000};
+  uint32_t    retry_delay_ms{2000};
+  std::size_t dispatch_threads{4};  ///< Packets from one peer are always handled by one thread
+
+  /// @name Broadcast Trees
+  /// @{
+  uint32_t broadcast_announce_delay_ms{50};  ///< Announcements to lazy peers are batched this long
+  uint32_t broadcast_graft_timeout_ms{1000};  ///< Wait for an announced broadcast before grafting
+  Duration broadcast_history_length{
+      std::chrono::seconds(60)};  ///< Broadcasts are kept this long to answer grafts
+  /// @}
 };
 
 }  // namespace muddle
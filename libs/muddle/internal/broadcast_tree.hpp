@@ -0,0 +1,156 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "muddle/packet.hpp"
+#include "network/management/abstract_connection.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace fetch {
+namespace muddle {
+
+/**
+ * The peer and message state of the epidemic broadcast trees (Plumtree) used for the broadcasts of
+ * selected services and channels.
+ *
+ * Every direct peer starts out as an eager peer of a tree and receives full broadcasts. A peer
+ * that delivers a broadcast which has already been seen is pruned to a lazy peer, which from then
+ * on only receives batched announcements of the message ids. A node that is announced a message
+ * it never receives grafts the announcing peer back into the tree, which repairs the tree after
+ * connection loss.
+ *
+ * This class only keeps the state, the router is responsible for the messaging and timers.
+ */
+class BroadcastTree
+{
+public:
+  using Handle     = network::AbstractConnection::ConnectionHandleType;
+  using HandleSet  = std::unordered_set<Handle>;
+  using PacketPtr  = std::shared_ptr<Packet>;
+  using MessageId  = uint64_t;
+  using MessageIds = std::vector<MessageId>;
+  using Clock      = std::chrono::steady_clock;
+  using Timepoint  = Clock::time_point;
+  using Duration   = Clock::duration;
+
+  struct GraftTarget
+  {
+    Handle   handle{0};
+    uint16_t service{0};
+    uint16_t channel{0};
+  };
+
+  struct Announcement
+  {
+    uint16_t   service{0};
+    uint16_t   channel{0};
+    MessageIds ids{};
+  };
+
+  using Announcements = std::vector<Announcement>;
+
+  // Construction / Destruction
+  BroadcastTree()                         = default;
+  BroadcastTree(BroadcastTree const &rhs) = delete;
+  BroadcastTree(BroadcastTree &&rhs)      = delete;
+  ~BroadcastTree()                        = default;
+
+  /// @name Configuration
+  /// @{
+  void SetEnabled(uint16_t service, uint16_t channel, bool enabled);
+  bool IsEnabled(uint16_t service, uint16_t channel) const;
+  /// @}
+
+  /// @name Tree Peers
+  /// @{
+  bool      Prune(uint16_t service, uint16_t channel, Handle handle);
+  void      Graft(uint16_t service, uint16_t channel, Handle handle);
+  HandleSet GetLazyPeers(uint16_t service, uint16_t channel) const;
+  /// @}
+
+  /// @name Messages
+  /// @{
+  void      OnDelivered(MessageId id, PacketPtr const &packet, Timepoint const &now = Clock::now());
+  PacketPtr GetMessage(MessageId id) const;
+  bool      OnAnnounced(MessageId id, uint16_t service, uint16_t channel, Handle handle,
+                        Timepoint const &now = Clock::now());
+  bool      NextGraft(MessageId id, GraftTarget &target);
+  /// @}
+
+  /// @name Lazy Announcements
+  /// @{
+  bool          QueueAnnouncement(Handle handle, uint16_t service, uint16_t channel, MessageId id);
+  Announcements TakeAnnouncements(Handle handle);
+  /// @}
+
+  void Trim(HandleSet const &connected, Duration const &history_length,
+            Timepoint const &now = Clock::now());
+
+  // Operators
+  BroadcastTree &operator=(BroadcastTree const &rhs) = delete;
+  BroadcastTree &operator=(BroadcastTree &&rhs) = delete;
+
+private:
+  using TreeId = uint32_t;
+
+  struct Tree
+  {
+    bool      enabled{false};
+    HandleSet lazy_peers{};
+  };
+
+  struct Delivered
+  {
+    PacketPtr packet{};
+    Timepoint timestamp{};
+  };
+
+  struct Missing
+  {
+    TreeId             tree{0};
+    std::deque<Handle> announcers{};
+    Timepoint          timestamp{};
+  };
+
+  using Trees            = std::unordered_map<TreeId, Tree>;
+  using DeliveredMap     = std::unordered_map<MessageId, Delivered>;
+  using MissingMap       = std::unordered_map<MessageId, Missing>;
+  using PendingMap       = std::unordered_map<TreeId, MessageIds>;
+  using PendingByHandles = std::unordered_map<Handle, PendingMap>;
+
+  static TreeId   ToTreeId(uint16_t service, uint16_t channel);
+  static uint16_t ToService(TreeId tree);
+  static uint16_t ToChannel(TreeId tree);
+
+  mutable Mutex    lock_;
+  Trees            trees_;
+  DeliveredMap     delivered_;  ///< Recent broadcasts, kept to answer grafts
+  MissingMap       missing_;    ///< Announced broadcasts that have not been received yet
+  PendingByHandles pending_;    ///< Announcements waiting to be sent to lazy peers
+};
+
+}  // namespace muddle
+}  // namespace fetch
@@ -0,0 +1,100 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/serializers/map_interface.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace fetch {
+namespace muddle {
+
+/**
+ * The control messages exchanged between direct peers to maintain the broadcast trees
+ */
+struct BroadcastTreeMessage
+{
+  using MessageIds = std::vector<uint64_t>;
+
+  enum class Type
+  {
+    PRUNE = 0,  ///< The sender no longer wants eager pushes for the tree
+    ANNOUNCE,   ///< The sender has received the listed broadcasts (the IHAVE of Plumtree)
+    GRAFT,      ///< The sender wants eager pushes again, and the listed broadcasts resent
+
+    MAX_NUM_TYPES
+  };
+
+  Type       type{Type::PRUNE};
+  uint16_t   service{0};
+  uint16_t   channel{0};
+  MessageIds ids{};
+};
+
+}  // namespace muddle
+
+namespace serializers {
+
+template <typename D>
+struct MapSerializer<muddle::BroadcastTreeMessage, D>
+{
+public:
+  using Type       = muddle::BroadcastTreeMessage;
+  using DriverType = D;
+  using EnumType   = uint64_t;
+
+  static const uint8_t TYPE    = 1;
+  static const uint8_t SERVICE = 2;
+  static const uint8_t CHANNEL = 3;
+  static const uint8_t IDS     = 4;
+
+  template <typename T>
+  static void Serialize(T &map_constructor, Type const &msg)
+  {
+    auto map = map_constructor(4);
+    map.Append(TYPE, static_cast<EnumType>(msg.type));
+    map.Append(SERVICE, msg.service);
+    map.Append(CHANNEL, msg.channel);
+    map.Append(IDS, msg.ids);
+  }
+
+  template <typename T>
+  static void Deserialize(T &map, Type &msg)
+  {
+    static constexpr auto MAX_TYPE_VALUE = static_cast<EnumType>(Type::Type::MAX_NUM_TYPES);
+
+    EnumType raw_type{0};
+    map.ExpectKeyGetValue(TYPE, raw_type);
+
+    // validate the type enum
+    if (raw_type >= MAX_TYPE_VALUE)
+    {
+      throw std::runtime_error("Invalid type value");
+    }
+
+    msg.type = static_cast<Type::Type>(raw_type);
+    map.ExpectKeyGetValue(SERVICE, msg.service);
+    map.ExpectKeyGetValue(CHANNEL, msg.channel);
+    map.ExpectKeyGetValue(IDS, msg.ids);
+  }
+};
+
+}  // namespace serializers
+}  // namespace fetch
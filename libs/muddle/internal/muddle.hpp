@@ -143,7 +143,8 @@ public:
 
   // Construction / Destruction
   Muddle(NetworkId network_id, CertificatePtr certificate, NetworkManager const &nm,
-         std::string external_address = "127.0.0.1", bool enabled_message_signing = true);
+         std::string external_address = "127.0.0.1", bool enabled_message_signing = true,
+         RouterConfiguration const &router_config = RouterConfiguration{});
   Muddle(Muddle const &) = delete;
   Muddle(Muddle &&)      = delete;
   ~Muddle() override;
@@ -191,6 +192,7 @@ public:
   void SetConfidence(Addresses const &addresses, Confidence confidence) override;
   void SetConfidence(ConfidenceMap const &map) override;
   void SetTrackerConfiguration(TrackerConfiguration const &config) override;
+  void SetBroadcastMode(uint16_t service, uint16_t channel, BroadcastMode mode) override;
   /// @}
 
   /// @name Internal Accessors
@@ -407,6 +407,11 @@ public:
   {
     throw std::runtime_error("SetTrackerConfiguration functionality not implemented");
   }
+
+  void SetBroadcastMode(uint16_t /*service*/, uint16_t /*channel*/, BroadcastMode /*mode*/) override
+  {
+    // broadcasts are delivered directly by the fake network, so there is nothing to select
+  }
   /// @}
 
 private:
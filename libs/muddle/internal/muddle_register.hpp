@@ -55,6 +55,7 @@ public:
   using Handle                 = ConnectionHandleType;
   using ConnectionLeftCallback = std::function<void(Handle)>;
   using Connections            = std::vector<WeakConnectionPtr>;
+  using HandleSet              = std::unordered_set<Handle>;
   enum class UpdateStatus
   {
     HANDLE_NOT_FOUND,
@@ -89,6 +90,7 @@ public:
 
   void              OnConnectionLeft(ConnectionLeftCallback cb);
   void              Broadcast(ConstByteArray const &data) const;
+  void              Broadcast(ConstByteArray const &data, HandleSet const &excluded) const;
   WeakConnectionPtr LookupConnection(ConnectionHandle handle) const;
   WeakConnectionPtr LookupConnection(Address const &address) const;
   Connections       LookupConnections(Address const &address) const;
@@ -101,6 +103,7 @@ public:
   std::unordered_set<Address> GetCurrentAddressSet() const;
   std::unordered_set<Address> GetIncomingAddressSet() const;
   std::unordered_set<Address> GetOutgoingAddressSet() const;
+  HandleSet                   GetCurrentConnectionHandles() const;
 
   // Raw Access
   HandleIndex  GetHandleIndex() const;
@@ -0,0 +1,74 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace fetch {
+namespace muddle {
+
+/**
+ * Systematic Reed-Solomon erasure code over GF(2^8).
+ *
+ * Data is split into `data_shards` equally sized shards, which are extended with parity shards to
+ * a total of `total_shards`. The parity rows are taken from a Cauchy matrix, so the data can be
+ * recovered from any `data_shards` of the shards.
+ */
+class ReedSolomon
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using Shards         = std::vector<ConstByteArray>;
+  using ShardMap       = std::map<std::size_t, ConstByteArray>;
+
+  static constexpr std::size_t MAX_SHARDS = 256;
+
+  // Construction / Destruction
+  ReedSolomon(std::size_t data_shards, std::size_t total_shards);
+  ReedSolomon(ReedSolomon const &) = default;
+  ReedSolomon(ReedSolomon &&)      = default;
+  ~ReedSolomon()                   = default;
+
+  /// @name Coding
+  /// @{
+  Shards Encode(ConstByteArray const &data) const;
+  bool   Decode(ShardMap const &shards, ConstByteArray &data) const;
+  /// @}
+
+  std::size_t data_shards() const;
+  std::size_t total_shards() const;
+
+  // Operators
+  ReedSolomon &operator=(ReedSolomon const &) = default;
+  ReedSolomon &operator=(ReedSolomon &&) = default;
+
+private:
+  using Matrix = std::vector<uint8_t>;
+
+  std::size_t data_shards_;
+  std::size_t total_shards_;
+  Matrix      parity_;  ///< (total - data) x data coefficients of the parity shards
+};
+
+}  // namespace muddle
+}  // namespace fetch
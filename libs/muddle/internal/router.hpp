@@ -18,11 +18,14 @@
 //------------------------------------------------------------------------------
 
 #include "blacklist.hpp"
+#include "broadcast_tree.hpp"
+#include "broadcast_tree_message.hpp"
 #include "subscription_registrar.hpp"
 
 #include "core/mutex.hpp"
 #include "crypto/prover.hpp"
 #include "crypto/secure_channel.hpp"
+#include "muddle/broadcast_mode.hpp"
 #include "muddle/muddle_endpoint.hpp"
 #include "muddle/network_id.hpp"
 #include "muddle/packet.hpp"
@@ -31,6 +34,7 @@
 #include "network/management/abstract_connection.hpp"
 #include "telemetry/telemetry.hpp"
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
@@ -39,6 +43,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace fetch {
 namespace muddle {
@@ -59,6 +64,7 @@ public:
   using ConnectionPtr        = std::weak_ptr<network::AbstractConnection>;
   using Handle               = network::AbstractConnection::ConnectionHandleType;
   using ThreadPool           = network::ThreadPool;
+  using ThreadPools          = std::vector<ThreadPool>;
   using HandleDirectAddrMap  = std::unordered_map<Handle, Address>;
   using Prover               = crypto::Prover;
   using DirectMessageHandler = std::function<void(Handle, PacketPtr)>;
@@ -82,7 +88,7 @@ public:
 
   // Construction / Destruction
   Router(NetworkId network_id, Address address, MuddleRegister &reg, Prover const &prover,
-         bool enable_message_signing);
+         bool enable_message_signing, RouterConfiguration const &config = RouterConfiguration{});
   Router(Router const &) = delete;
   Router(Router &&)      = delete;
   ~Router() override     = default;
@@ -130,6 +136,8 @@ public:
   void Whitelist(Address const &target);
   bool IsBlacklisted(Address const &target) const;
 
+  void SetBroadcastMode(uint16_t service, uint16_t channel, BroadcastMode mode);
+
   Handle LookupHandle(Packet::RawAddress const &raw_address) const;
 
   void SetDirectHandler(DirectMessageHandler handler)
@@ -161,7 +169,25 @@ private:
     UPDATED
   };
 
-  static constexpr std::size_t NUMBER_OF_ROUTER_THREADS = 1;
+  using DeliveryAttempts = std::unordered_map<PacketPtr, uint64_t>;
+
+  static constexpr std::size_t NUMBER_OF_SHARDS = 16;
+
+  struct EchoCacheShard
+  {
+    mutable Mutex lock;
+    EchoCache     cache;
+  };
+
+  struct DeliveryAttemptsShard
+  {
+    Mutex            lock;
+    DeliveryAttempts attempts;
+  };
+
+  ThreadPool const &DispatchPool(std::size_t key) const;
+  ThreadPool const &DispatchPool(Packet::RawAddress const &address) const;
+  ThreadPool const &DispatchPool(uint16_t service, uint16_t channel) const;
 
   void SendToConnection(Handle handle, PacketPtr const &packet, bool external = true,
                         bool reschedule_on_fail = false);
@@ -170,8 +196,19 @@ private:
 
   void DispatchPacket(PacketPtr const &packet, Address const &transmitter);
 
-  bool IsEcho(Packet const &packet, bool register_echo = true);
-  void CleanEchoCache();
+  bool            IsEcho(Packet const &packet, bool register_echo = true);
+  bool            IsEcho(std::size_t echo_id, bool register_echo);
+  void            CleanEchoCache();
+  EchoCacheShard &EchoShard(std::size_t echo_id);
+
+  /// @name Broadcast Trees
+  /// @{
+  void RouteTreeBroadcast(Handle handle, PacketPtr const &packet, bool external);
+  void OnBroadcastTreeMessage(Handle handle, PacketPtr const &packet);
+  void SendBroadcastTreeMessage(Handle handle, BroadcastTreeMessage const &msg);
+  void SendAnnouncements(Handle handle);
+  void OnGraftTimeout(BroadcastTree::MessageId id);
+  /// @}
 
   PacketPtr const &Sign(PacketPtr const &p) const;
   bool             Genuine(PacketPtr const &p) const;
@@ -197,22 +234,22 @@ private:
 
   PeerTrackerPtr tracker_{nullptr};
 
-  mutable Mutex echo_cache_lock_;
-  EchoCache     echo_cache_;
+  /// Echo cache, sharded by echo id so that concurrent receivers rarely contend
+  std::array<EchoCacheShard, NUMBER_OF_SHARDS> echo_cache_;
 
-  ThreadPool dispatch_thread_pool_;
+  /// One single threaded pool per dispatch lane, packets are assigned to lanes by peer or, when
+  /// they are delivered to the local subscriptions, by service and channel
+  ThreadPools dispatch_pools_;
+
+  BroadcastTree broadcast_tree_;
 
   /// Redelivery of packages
   /// @{
-  mutable Mutex                           delivery_attempts_lock_;
-  std::unordered_map<PacketPtr, uint64_t> delivery_attempts_;
+  std::array<DeliveryAttemptsShard, NUMBER_OF_SHARDS> delivery_attempts_;
 
-  void ClearDeliveryAttempt(PacketPtr const &packet)
-  {
-    FETCH_LOCK(delivery_attempts_lock_);
-    delivery_attempts_.erase(packet);
-  }
-  void SchedulePacketForRedelivery(PacketPtr const &packet, bool external);
+  DeliveryAttemptsShard &AttemptsShard(PacketPtr const &packet);
+  void                   ClearDeliveryAttempt(PacketPtr const &packet);
+  void                   SchedulePacketForRedelivery(PacketPtr const &packet, bool external);
   /// @}
 
   /// Message "entropy"
@@ -236,6 +273,10 @@ private:
   telemetry::CounterPtr         rx_packet_total_;
   telemetry::CounterPtr         tx_packet_total_;
   telemetry::CounterPtr         bx_packet_total_;
+  telemetry::CounterPtr         bx_duplicate_packet_total_;
+  telemetry::CounterPtr         broadcast_tree_prunes_total_;
+  telemetry::CounterPtr         broadcast_tree_grafts_total_;
+  telemetry::CounterPtr         broadcast_tree_announcements_total_;
   telemetry::CounterPtr         rx_encrypted_packet_failures_total_;
   telemetry::CounterPtr         rx_encrypted_packet_success_total_;
   telemetry::CounterPtr         tx_encrypted_packet_failures_total_;
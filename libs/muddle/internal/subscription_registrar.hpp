@@ -75,6 +75,11 @@ class NetworkId;
  *                              └──────▶│   Subscription    │───▶│      Client       │
  *                                      │                   │
  *                                      └───────────────────┘    └ ─ ─ ─ ─ ─ ─ ─ ─ ─ ┘
+ *
+ * Packets are dispatched without holding the registrar lock. The router delivers all the packets
+ * for a service / channel on the same lane, so a handler is never run concurrently with itself,
+ * but the handlers of different services / channels can run in parallel. Clients which subscribe
+ * to several channels must therefore protect any state that their handlers share.
  */
 class SubscriptionRegistrar
 {
@@ -0,0 +1,335 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "broadcast_tree.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace fetch {
+namespace muddle {
+
+/**
+ * Enable or disable the broadcast tree for a service and channel
+ *
+ * @param service The service identifier
+ * @param channel The channel identifier
+ * @param enabled true if broadcasts should be sent along the tree, false to flood them
+ */
+void BroadcastTree::SetEnabled(uint16_t service, uint16_t channel, bool enabled)
+{
+  FETCH_LOCK(lock_);
+
+  if (enabled)
+  {
+    trees_[ToTreeId(service, channel)].enabled = true;
+  }
+  else
+  {
+    trees_.erase(ToTreeId(service, channel));
+  }
+}
+
+/**
+ * Determine if broadcasts for a service and channel should be sent along the tree
+ *
+ * @param service The service identifier
+ * @param channel The channel identifier
+ * @return true if the tree is enabled, otherwise false
+ */
+bool BroadcastTree::IsEnabled(uint16_t service, uint16_t channel) const
+{
+  FETCH_LOCK(lock_);
+
+  auto const it = trees_.find(ToTreeId(service, channel));
+  return (it != trees_.end()) && it->second.enabled;
+}
+
+/**
+ * Move a peer out of the tree, after which it only receives announcements
+ *
+ * @param service The service identifier
+ * @param channel The channel identifier
+ * @param handle The connection handle of the peer
+ * @return true if the peer was an eager peer of the tree, otherwise false
+ */
+bool BroadcastTree::Prune(uint16_t service, uint16_t channel, Handle handle)
+{
+  FETCH_LOCK(lock_);
+
+  auto const it = trees_.find(ToTreeId(service, channel));
+  if (it == trees_.end())
+  {
+    return false;
+  }
+
+  return it->second.lazy_peers.insert(handle).second;
+}
+
+/**
+ * Move a peer (back) into the tree, after which it receives full broadcasts
+ *
+ * @param service The service identifier
+ * @param channel The channel identifier
+ * @param handle The connection handle of the peer
+ */
+void BroadcastTree::Graft(uint16_t service, uint16_t channel, Handle handle)
+{
+  FETCH_LOCK(lock_);
+
+  auto const it = trees_.find(ToTreeId(service, channel));
+  if (it != trees_.end())
+  {
+    it->second.lazy_peers.erase(handle);
+  }
+}
+
+/**
+ * Get the peers which only receive announcements for a tree. All other connected peers are eager.
+ *
+ * @param service The service identifier
+ * @param channel The channel identifier
+ * @return The set of lazy peers
+ */
+BroadcastTree::HandleSet BroadcastTree::GetLazyPeers(uint16_t service, uint16_t channel) const
+{
+  FETCH_LOCK(lock_);
+
+  auto const it = trees_.find(ToTreeId(service, channel));
+  return (it == trees_.end()) ? HandleSet{} : it->second.lazy_peers;
+}
+
+/**
+ * Record that a broadcast has been received, so that it can be resent to grafting peers and any
+ * pending graft for it is cancelled
+ *
+ * @param id The message id of the broadcast
+ * @param packet The broadcast packet
+ * @param now The current time
+ */
+void BroadcastTree::OnDelivered(MessageId id, PacketPtr const &packet, Timepoint const &now)
+{
+  FETCH_LOCK(lock_);
+
+  delivered_[id] = Delivered{packet, now};
+  missing_.erase(id);
+}
+
+/**
+ * Look up a recently received broadcast
+ *
+ * @param id The message id of the broadcast
+ * @return The packet if it is still available, otherwise an empty pointer
+ */
+BroadcastTree::PacketPtr BroadcastTree::GetMessage(MessageId id) const
+{
+  FETCH_LOCK(lock_);
+
+  auto const it = delivered_.find(id);
+  return (it == delivered_.end()) ? PacketPtr{} : it->second.packet;
+}
+
+/**
+ * Record that a peer has announced a broadcast
+ *
+ * @param id The message id of the broadcast
+ * @param service The service identifier
+ * @param channel The channel identifier
+ * @param handle The connection handle of the announcing peer
+ * @param now The current time
+ * @return true if this is the first announcement of a missing broadcast, in which case the caller
+ * should start the graft timer for it
+ */
+bool BroadcastTree::OnAnnounced(MessageId id, uint16_t service, uint16_t channel, Handle handle,
+                                Timepoint const &now)
+{
+  FETCH_LOCK(lock_);
+
+  if (delivered_.find(id) != delivered_.end())
+  {
+    return false;
+  }
+
+  bool const first = (missing_.find(id) == missing_.end());
+
+  auto &missing = missing_[id];
+  if (first)
+  {
+    missing.tree      = ToTreeId(service, channel);
+    missing.timestamp = now;
+  }
+
+  if (std::find(missing.announcers.begin(), missing.announcers.end(), handle) ==
+      missing.announcers.end())
+  {
+    missing.announcers.push_back(handle);
+  }
+
+  return first;
+}
+
+/**
+ * Called when the graft timer of a missing broadcast expires. Selects the next announcing peer to
+ * graft back into the tree and request the broadcast from.
+ *
+ * @param id The message id of the broadcast
+ * @param target The peer to graft, if any
+ * @return true if a graft should be sent and the timer restarted, otherwise false
+ */
+bool BroadcastTree::NextGraft(MessageId id, GraftTarget &target)
+{
+  FETCH_LOCK(lock_);
+
+  auto it = missing_.find(id);
+  if (it == missing_.end())
+  {
+    return false;
+  }
+
+  auto &missing = it->second;
+  if (missing.announcers.empty())
+  {
+    missing_.erase(it);
+    return false;
+  }
+
+  target.handle  = missing.announcers.front();
+  target.service = ToService(missing.tree);
+  target.channel = ToChannel(missing.tree);
+  missing.announcers.pop_front();
+
+  // the grafted peer becomes an eager peer again
+  auto const tree_it = trees_.find(missing.tree);
+  if (tree_it != trees_.end())
+  {
+    tree_it->second.lazy_peers.erase(target.handle);
+  }
+
+  return true;
+}
+
+/**
+ * Queue the announcement of a broadcast to a lazy peer. Announcements are sent in batches.
+ *
+ * @param handle The connection handle of the lazy peer
+ * @param service The service identifier
+ * @param channel The channel identifier
+ * @param id The message id of the broadcast
+ * @return true if there were no announcements pending for the peer, in which case the caller
+ * should schedule sending them
+ */
+bool BroadcastTree::QueueAnnouncement(Handle handle, uint16_t service, uint16_t channel,
+                                      MessageId id)
+{
+  FETCH_LOCK(lock_);
+
+  auto &pending = pending_[handle];
+
+  bool const first = pending.empty();
+  pending[ToTreeId(service, channel)].push_back(id);
+
+  return first;
+}
+
+/**
+ * Take all the pending announcements for a peer
+ *
+ * @param handle The connection handle of the lazy peer
+ * @return The announcements, grouped by tree
+ */
+BroadcastTree::Announcements BroadcastTree::TakeAnnouncements(Handle handle)
+{
+  Announcements announcements{};
+
+  FETCH_LOCK(lock_);
+
+  auto it = pending_.find(handle);
+  if (it != pending_.end())
+  {
+    for (auto &element : it->second)
+    {
+      announcements.emplace_back(Announcement{ToService(element.first), ToChannel(element.first),
+                                              std::move(element.second)});
+    }
+
+    pending_.erase(it);
+  }
+
+  return announcements;
+}
+
+/**
+ * Periodic maintenance: forget disconnected peers as well as broadcasts that are too old to be
+ * requested any more
+ *
+ * @param connected The set of currently connected peers
+ * @param history_length The time for which broadcasts are retained
+ * @param now The current time
+ */
+void BroadcastTree::Trim(HandleSet const &connected, Duration const &history_length,
+                         Timepoint const &now)
+{
+  auto const is_disconnected = [&connected](Handle handle) {
+    return connected.find(handle) == connected.end();
+  };
+
+  FETCH_LOCK(lock_);
+
+  for (auto &tree : trees_)
+  {
+    auto &lazy_peers = tree.second.lazy_peers;
+    for (auto it = lazy_peers.begin(); it != lazy_peers.end();)
+    {
+      it = is_disconnected(*it) ? lazy_peers.erase(it) : std::next(it);
+    }
+  }
+
+  for (auto it = pending_.begin(); it != pending_.end();)
+  {
+    it = is_disconnected(it->first) ? pending_.erase(it) : std::next(it);
+  }
+
+  for (auto it = delivered_.begin(); it != delivered_.end();)
+  {
+    it = ((now - it->second.timestamp) > history_length) ? delivered_.erase(it) : std::next(it);
+  }
+
+  for (auto it = missing_.begin(); it != missing_.end();)
+  {
+    it = ((now - it->second.timestamp) > history_length) ? missing_.erase(it) : std::next(it);
+  }
+}
+
+BroadcastTree::TreeId BroadcastTree::ToTreeId(uint16_t service, uint16_t channel)
+{
+  return (static_cast<TreeId>(service) << 16u) | static_cast<TreeId>(channel);
+}
+
+uint16_t BroadcastTree::ToService(TreeId tree)
+{
+  return static_cast<uint16_t>(tree >> 16u);
+}
+
+uint16_t BroadcastTree::ToChannel(TreeId tree)
+{
+  return static_cast<uint16_t>(tree & 0xFFFFu);
+}
+
+}  // namespace muddle
+}  // namespace fetch
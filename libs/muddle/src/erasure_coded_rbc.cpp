@@ -0,0 +1,642 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "reed_solomon.hpp"
+
+#include "core/byte_array/byte_array.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/merkle_tree.hpp"
+#include "crypto/sha256.hpp"
+#include "logging/logging.hpp"
+#include "muddle/erasure_coded_rbc.hpp"
+#include "muddle/subscription.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <iterator>
+
+namespace fetch {
+namespace muddle {
+namespace {
+
+constexpr char const *LOGGING_NAME = "ErasureCodedRBC";
+
+using byte_array::ByteArray;
+using byte_array::ConstByteArray;
+
+// The coded payload is prefixed with the length of the message so that the padding added by the
+// erasure code can be removed, and so that the length is also committed to by the Merkle root
+constexpr std::size_t LENGTH_PREFIX_SIZE = sizeof(uint64_t);
+
+ConstByteArray FrameMessage(ConstByteArray const &msg)
+{
+  uint64_t const length = msg.size();
+
+  ByteArray framed{};
+  framed.Resize(LENGTH_PREFIX_SIZE + msg.size());
+  for (std::size_t i = 0; i < LENGTH_PREFIX_SIZE; ++i)
+  {
+    framed[i] = static_cast<uint8_t>(length >> (8u * i));
+  }
+
+  if (!msg.empty())
+  {
+    std::memcpy(framed.pointer() + LENGTH_PREFIX_SIZE, msg.pointer(), msg.size());
+  }
+
+  return {framed};
+}
+
+bool UnframeMessage(ConstByteArray const &framed, SerialisedMessage &msg)
+{
+  if (framed.size() < LENGTH_PREFIX_SIZE)
+  {
+    return false;
+  }
+
+  uint64_t length{0};
+  for (std::size_t i = 0; i < LENGTH_PREFIX_SIZE; ++i)
+  {
+    length |= static_cast<uint64_t>(framed[i]) << (8u * i);
+  }
+
+  if (length > framed.size() - LENGTH_PREFIX_SIZE)
+  {
+    return false;
+  }
+
+  msg = framed.SubArray(LENGTH_PREFIX_SIZE, length);
+  return true;
+}
+
+crypto::MerkleTree BuildTree(ReedSolomon::Shards const &fragments)
+{
+  crypto::MerkleTree tree{fragments.size()};
+  for (std::size_t i = 0; i < fragments.size(); ++i)
+  {
+    tree[i] = crypto::Hash<crypto::SHA256>(fragments[i]);
+  }
+  tree.CalculateRoot();
+
+  return tree;
+}
+
+}  // namespace
+
+/**
+ * Creates an erasure coded reliable broadcast channel
+ *
+ * @param endpoint The muddle endpoint to communicate on
+ * @param address The muddle address of this node
+ * @param call_back The callback for delivered messages
+ * @param channel The channel to communicate on
+ * @param ordered_delivery Whether messages from each member are delivered in the order sent
+ */
+ErasureCodedRBC::ErasureCodedRBC(Endpoint &endpoint, MuddleAddress address,
+                                 CallbackFunction call_back, uint16_t channel,
+                                 bool ordered_delivery)
+  : channel_{channel}
+  , ordered_delivery_{ordered_delivery}
+  , address_{std::move(address)}
+  , endpoint_{endpoint}
+  , deliver_msg_callback_{std::move(call_back)}
+  , subscription_{endpoint.Subscribe(SERVICE_RBC, channel_)}
+{
+  subscription_->SetMessageHandler([this](MuddleAddress const &from, uint16_t, uint16_t, uint16_t,
+                                          muddle::Packet::Payload const &payload, MuddleAddress) {
+    RBCSerializer serialiser{payload};
+
+    Message msg;
+    try
+    {
+      serialiser >> msg;
+    }
+    catch (...)
+    {
+      FETCH_LOG_ERROR(LOGGING_NAME, "Node ", id_, " failed to deserialise message");
+      return;
+    }
+
+    try
+    {
+      OnMessage(from, msg);
+    }
+    catch (...)
+    {
+      FETCH_LOG_CRITICAL(LOGGING_NAME, "Node ", id_,
+                         ": critical failure, possibly due to malformed message.");
+    }
+  });
+}
+
+ErasureCodedRBC::~ErasureCodedRBC() = default;
+
+/**
+ * Enables or disables the channel. Disabling will clear all state that would continue the
+ * protocol
+ */
+void ErasureCodedRBC::Enable(bool enable)
+{
+  FETCH_LOCK(lock_);
+  enabled_ = enable;
+
+  if (!enabled_)
+  {
+    parties_.clear();
+    parties_.resize(current_cabinet_.size());
+    broadcasts_.clear();
+    msg_counter_ = 0;
+  }
+}
+
+/**
+ * Resets the channel for a new cabinet
+ */
+bool ErasureCodedRBC::ResetCabinet(CabinetMembers const &cabinet)
+{
+  FETCH_LOCK(lock_);
+
+  auto const iterator = cabinet.find(address_);
+  if (iterator == cabinet.end() || cabinet.size() > ReedSolomon::MAX_SHARDS)
+  {
+    return false;
+  }
+
+  current_cabinet_ = cabinet;
+  cabinet_index_.assign(cabinet.begin(), cabinet.end());
+  id_ = static_cast<uint32_t>(std::distance(cabinet.begin(), iterator));
+
+  // same fault threshold as the RBC, n > 3f
+  auto const size = static_cast<uint32_t>(cabinet.size());
+  threshold_      = (size % 3 == 0) ? (size / 3 - 1) : (size / 3);
+  assert(size > 3 * threshold_);
+
+  // any n - 2f fragments reconstruct the message
+  coder_ = std::make_unique<ReedSolomon>(size - 2 * threshold_, size);
+
+  parties_.clear();
+  parties_.resize(current_cabinet_.size());
+  broadcasts_.clear();
+  msg_counter_ = 0;
+
+  return true;
+}
+
+/**
+ * Codes the message into fragments and sends each cabinet member its own fragment
+ *
+ * @param msg Serialised message to be broadcast
+ */
+void ErasureCodedRBC::Broadcast(SerialisedMessage const &msg)
+{
+  Deliveries deliveries{};
+
+  {
+    FETCH_LOCK(lock_);
+
+    if (!coder_)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to broadcast without a cabinet");
+      return;
+    }
+
+    auto const fragments = coder_->Encode(FrameMessage(msg));
+    auto const tree      = BuildTree(fragments);
+    auto const proofs    = tree.GetProofs();
+
+    Message value{};
+    value.type    = MessageType::R_VALUE;
+    value.channel = channel_;
+    value.id      = id_;
+    value.counter = ++msg_counter_;
+    value.root    = tree.root();
+
+    for (uint32_t index = 0; index < cabinet_index_.size(); ++index)
+    {
+      value.index    = index;
+      value.proof    = proofs[index];
+      value.fragment = fragments[index];
+
+      if (index == id_)
+      {
+        OnValue(value, id_, deliveries);
+      }
+      else
+      {
+        Send(value, cabinet_index_[index]);
+      }
+    }
+  }
+
+  Dispatch(deliveries);
+}
+
+void ErasureCodedRBC::SetQuestion(ConstByteArray const & /*unused*/, ConstByteArray const &answer)
+{
+  Broadcast(answer);
+}
+
+ErasureCodedRBC::WeakRunnable ErasureCodedRBC::GetRunnable()
+{
+  return {};
+}
+
+/**
+ * Sends a message to a particular cabinet member
+ */
+void ErasureCodedRBC::Send(Message const &msg, MuddleAddress const &address)
+{
+  RBCSerializerCounter counter;
+  counter << msg;
+
+  RBCSerializer serializer;
+  serializer.Reserve(counter.size());
+  serializer << msg;
+
+  endpoint_.Send(address, SERVICE_RBC, channel_, serializer.data());
+}
+
+/**
+ * Sends a message to all the other cabinet members
+ */
+void ErasureCodedRBC::InternalBroadcast(Message const &msg)
+{
+  RBCSerializerCounter counter;
+  counter << msg;
+
+  RBCSerializer serializer;
+  serializer.Reserve(counter.size());
+  serializer << msg;
+
+  for (auto const &address : current_cabinet_)
+  {
+    if (address != address_)
+    {
+      endpoint_.Send(address, SERVICE_RBC, channel_, serializer.data());
+    }
+  }
+}
+
+/**
+ * Handler for all the messages of the channel
+ *
+ * @param from Muddle address of the sender
+ * @param msg The message
+ */
+void ErasureCodedRBC::OnMessage(MuddleAddress const &from, Message const &msg)
+{
+  Deliveries deliveries{};
+
+  {
+    FETCH_LOCK(lock_);
+
+    if (!BasicMessageCheck(from, msg))
+    {
+      return;
+    }
+
+    auto const sender_index = static_cast<uint32_t>(
+        std::distance(current_cabinet_.begin(), current_cabinet_.find(from)));
+
+    switch (msg.type)
+    {
+    case MessageType::R_VALUE:
+      OnValue(msg, sender_index, deliveries);
+      break;
+    case MessageType::R_ECHO:
+      OnEcho(msg, sender_index, deliveries);
+      break;
+    case MessageType::R_READY:
+      OnReady(msg, sender_index, deliveries);
+      break;
+    default:
+      FETCH_LOG_WARN(LOGGING_NAME, "Node: ", id_, " can not process payload from node ",
+                     sender_index);
+    }
+  }
+
+  Dispatch(deliveries);
+}
+
+/**
+ * Handler for the fragment sent by the broadcaster. If it is ours and valid, echo it to everyone
+ *
+ * @param msg The value message
+ * @param sender_index Index of the sender in the cabinet
+ * @param deliveries Messages delivered as a result
+ */
+void ErasureCodedRBC::OnValue(Message const &msg, uint32_t sender_index, Deliveries &deliveries)
+{
+  TagType const tag = msg.tag();
+
+  if (!SetPartyFlag(sender_index, tag, MessageType::R_VALUE))
+  {
+    return;
+  }
+
+  if ((sender_index != msg.id) || (msg.index != id_) || !VerifyFragment(msg))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "onValue: Node ", id_, " received invalid fragment from node ",
+                   sender_index, " for msg ", tag);
+    return;
+  }
+
+  auto &broadcast = broadcasts_[tag];
+  if (broadcast.echo_sent || broadcast.delivered)
+  {
+    return;
+  }
+  broadcast.echo_sent = true;
+
+  Message echo{msg};
+  echo.type = MessageType::R_ECHO;
+
+  InternalBroadcast(echo);
+  OnEcho(echo, id_, deliveries);
+}
+
+/**
+ * Handler for the fragments echoed by the other members. Once n - f fragments are known the
+ * message is reconstructed and, if consistent with the root, a ready message is sent.
+ *
+ * @param msg The echo message
+ * @param sender_index Index of the sender in the cabinet
+ * @param deliveries Messages delivered as a result
+ */
+void ErasureCodedRBC::OnEcho(Message const &msg, uint32_t sender_index, Deliveries &deliveries)
+{
+  TagType const tag = msg.tag();
+
+  if (!SetPartyFlag(sender_index, tag, MessageType::R_ECHO))
+  {
+    return;
+  }
+
+  // members may only echo their own fragment
+  if ((msg.index != sender_index) || !VerifyFragment(msg))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "onEcho: Node ", id_, " received invalid fragment from node ",
+                   sender_index, " for msg ", tag);
+    return;
+  }
+
+  auto &broadcast = broadcasts_[tag];
+  if (broadcast.delivered)
+  {
+    return;
+  }
+
+  auto &state = broadcast.roots[msg.root];
+  state.fragments.emplace(msg.index, msg.fragment);
+
+  if (!broadcast.ready_sent && (state.fragments.size() >= current_cabinet_.size() - threshold_))
+  {
+    if (Reconstruct(msg.root, state))
+    {
+      SendReady(msg, deliveries);
+    }
+    else
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "onEcho: Node ", id_,
+                     " received inconsistent fragments for msg ", tag, " from node ", msg.id);
+    }
+  }
+
+  TryDeliver(msg, deliveries);
+}
+
+/**
+ * Handler for ready messages. f + 1 ready messages are amplified and 2f + 1 deliver the message
+ *
+ * @param msg The ready message
+ * @param sender_index Index of the sender in the cabinet
+ * @param deliveries Messages delivered as a result
+ */
+void ErasureCodedRBC::OnReady(Message const &msg, uint32_t sender_index, Deliveries &deliveries)
+{
+  TagType const tag = msg.tag();
+
+  if (!SetPartyFlag(sender_index, tag, MessageType::R_READY))
+  {
+    return;
+  }
+
+  auto &broadcast = broadcasts_[tag];
+  if (broadcast.delivered)
+  {
+    return;
+  }
+
+  auto &state = broadcast.roots[msg.root];
+  ++state.ready_count;
+
+  if (!broadcast.ready_sent && (state.ready_count == threshold_ + 1))
+  {
+    SendReady(msg, deliveries);
+  }
+
+  TryDeliver(msg, deliveries);
+}
+
+/**
+ * Helper function to check basic details of the message to determine if it should be processed
+ */
+bool ErasureCodedRBC::BasicMessageCheck(MuddleAddress const &from, Message const &msg) const
+{
+  if (!enabled_ || !coder_)
+  {
+    return false;
+  }
+
+  if ((current_cabinet_.find(from) == current_cabinet_.end()) || (msg.channel != channel_))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Received message from unknown sender/wrong channel");
+    return false;
+  }
+
+  if ((msg.id >= parties_.size()) || (msg.index >= parties_.size()))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Node ", id_, " received message with unknown id or index");
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Marks the receipt of a message type for a tag from a party
+ *
+ * @return false if the message has already been received, otherwise true
+ */
+bool ErasureCodedRBC::SetPartyFlag(uint32_t sender_index, TagType tag, MessageType msg_type)
+{
+  assert(parties_.size() == current_cabinet_.size());
+
+  auto &     flags = parties_[sender_index].flags[tag];
+  auto const index = static_cast<std::size_t>(msg_type);
+  if (flags[index])
+  {
+    FETCH_LOG_TRACE(LOGGING_NAME, "Node ", id_, " repeated msg type ",
+                    static_cast<uint32_t>(msg_type), " with tag ", tag);
+    return false;
+  }
+
+  flags.set(index);
+  return true;
+}
+
+/**
+ * Checks the Merkle proof of the fragment in a message against its root
+ */
+bool ErasureCodedRBC::VerifyFragment(Message const &msg) const
+{
+  return crypto::MerkleTree::VerifyProof(crypto::Hash<crypto::SHA256>(msg.fragment), msg.index,
+                                         current_cabinet_.size(), msg.proof, msg.root);
+}
+
+/**
+ * Reconstructs the message from the echoed fragments, and checks that the sender coded it
+ * correctly by re-encoding it and comparing the roots. The outcome only depends on the root, so
+ * all honest members reach the same conclusion from any set of fragments.
+ *
+ * @param root The Merkle root of the fragments
+ * @param state The fragments received for the root
+ * @return true if the message has been reconstructed and is consistent with the root
+ */
+bool ErasureCodedRBC::Reconstruct(ConstByteArray const &root, RootState &state) const
+{
+  if (state.decoding == Decoding::PENDING && state.fragments.size() >= coder_->data_shards())
+  {
+    ConstByteArray    framed{};
+    SerialisedMessage message{};
+
+    bool const valid = coder_->Decode(state.fragments, framed) &&
+                       UnframeMessage(framed, message) &&
+                       (BuildTree(coder_->Encode(framed)).root() == root);
+
+    state.decoding = valid ? Decoding::VALID : Decoding::INVALID;
+    state.message  = valid ? message : SerialisedMessage{};
+  }
+
+  return state.decoding == Decoding::VALID;
+}
+
+/**
+ * Sends a ready message for the root of a message to everyone, including ourselves
+ */
+void ErasureCodedRBC::SendReady(Message const &msg, Deliveries &deliveries)
+{
+  broadcasts_[msg.tag()].ready_sent = true;
+
+  Message ready{};
+  ready.type    = MessageType::R_READY;
+  ready.channel = msg.channel;
+  ready.id      = msg.id;
+  ready.counter = msg.counter;
+  ready.root    = msg.root;
+
+  InternalBroadcast(ready);
+  OnReady(ready, id_, deliveries);
+}
+
+/**
+ * Delivers the message once 2f + 1 ready messages and n - 2f fragments have been received for it
+ */
+void ErasureCodedRBC::TryDeliver(Message const &msg, Deliveries &deliveries)
+{
+  TagType const tag       = msg.tag();
+  auto &        broadcast = broadcasts_[tag];
+
+  auto it = broadcast.roots.find(msg.root);
+  if (broadcast.delivered || (it == broadcast.roots.end()))
+  {
+    return;
+  }
+
+  auto &state = it->second;
+  if ((state.ready_count < 2 * threshold_ + 1) || !Reconstruct(msg.root, state))
+  {
+    return;
+  }
+
+  broadcast.delivered = true;
+
+  // the protocol is complete for this tag, only the flags are needed to ignore late messages
+  SerialisedMessage const message = state.message;
+  broadcast.roots.clear();
+
+  if (msg.id != id_)
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Node ", id_, " delivered msg ", tag, " with counter ",
+                    static_cast<uint32_t>(msg.counter), " and id ", msg.id);
+
+    Deliver(msg.id, msg.counter, message, deliveries);
+  }
+}
+
+/**
+ * Queues a message for the callback, in the order it was sent if ordered delivery is enabled
+ */
+void ErasureCodedRBC::Deliver(uint32_t id, uint8_t counter, SerialisedMessage const &msg,
+                              Deliveries &deliveries)
+{
+  auto &      party  = parties_[id];
+  auto const &sender = cabinet_index_[id];
+
+  if (!ordered_delivery_)
+  {
+    deliveries.emplace_back(sender, msg);
+    return;
+  }
+
+  if (counter != party.deliver_s)
+  {
+    if (counter > party.deliver_s)
+    {
+      party.undelivered.emplace(counter, msg);
+    }
+    return;
+  }
+
+  deliveries.emplace_back(sender, msg);
+  ++party.deliver_s;
+
+  // deliver any messages which were held back
+  auto it = party.undelivered.begin();
+  while (it != party.undelivered.end() && it->first == party.deliver_s)
+  {
+    deliveries.emplace_back(sender, it->second);
+    ++party.deliver_s;
+    it = party.undelivered.erase(it);
+  }
+}
+
+/**
+ * Passes delivered messages to the callback, which is done without holding the lock so that the
+ * callback can use the channel
+ */
+void ErasureCodedRBC::Dispatch(Deliveries const &deliveries)
+{
+  for (auto const &delivery : deliveries)
+  {
+    deliver_msg_callback_(delivery.first, delivery.second);
+  }
+}
+
+}  // namespace muddle
+}  // namespace fetch
@@ -51,16 +51,19 @@ static std::size_t const PEER_SELECTION_INTERVAL_MS = 2500;
  * Constructs the muddle node instances
  *
  * @param certificate The certificate/identity of this node
+ * @param router_config The configuration of the router, including its number of dispatch threads
  */
 Muddle::Muddle(NetworkId network_id, CertificatePtr certificate, NetworkManager const &nm,
-               std::string external_address, bool enabled_message_signing)
+               std::string external_address, bool enabled_message_signing,
+               RouterConfiguration const &router_config)
   : name_{GenerateLoggingName("Muddle", network_id)}
   , certificate_(std::move(certificate))
   , external_address_(std::move(external_address))
   , node_address_(certificate_->identity().identifier())
   , network_manager_(nm)
   , register_(std::make_shared<MuddleRegister>(network_id))
-  , router_(network_id, node_address_, *register_, *certificate_, enabled_message_signing)
+  , router_(network_id, node_address_, *register_, *certificate_, enabled_message_signing,
+            router_config)
   , clients_(network_id)
   , network_id_(network_id)
   , reactor_{"muddle"}
@@ -495,6 +498,11 @@ void Muddle::SetTrackerConfiguration(TrackerConfiguration const &config)
   peer_tracker_->SetConfiguration(config);
 }
 
+void Muddle::SetBroadcastMode(uint16_t service, uint16_t channel, BroadcastMode mode)
+{
+  router_.SetBroadcastMode(service, channel, mode);
+}
+
 /**
  * Update a map of address to confidence level
  *
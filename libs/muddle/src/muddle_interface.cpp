@@ -28,10 +28,18 @@ namespace muddle {
 
 MuddlePtr CreateMuddle(NetworkId const &network, ProverPtr certificate,
                        network::NetworkManager const &nm, std::string const &external_address,
-                       bool enable_message_signing)
+                       bool enable_message_signing, RouterConfiguration const &router_config)
 {
   return std::make_shared<Muddle>(network, certificate, nm, external_address,
-                                  enable_message_signing);
+                                  enable_message_signing, router_config);
+}
+
+MuddlePtr CreateMuddle(NetworkId const &network, ProverPtr certificate,
+                       network::NetworkManager const &nm, std::string const &external_address,
+                       bool enable_message_signing)
+{
+  return CreateMuddle(network, std::move(certificate), nm, external_address,
+                      enable_message_signing, RouterConfiguration{});
 }
 
 MuddlePtr CreateMuddle(NetworkId const &network, ProverPtr certificate,
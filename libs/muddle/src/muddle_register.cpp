@@ -57,6 +57,17 @@ void MuddleRegister::OnConnectionLeft(ConnectionLeftCallback cb)
  * @param data The data to be broadcast
  */
 void MuddleRegister::Broadcast(ConstByteArray const &data) const
+{
+  Broadcast(data, HandleSet{});
+}
+
+/**
+ * Broadcast data to all active connections, except for a set of excluded ones
+ *
+ * @param data The data to be broadcast
+ * @param excluded The handles of the connections which should not be sent the data
+ */
+void MuddleRegister::Broadcast(ConstByteArray const &data, HandleSet const &excluded) const
 {
   using ConnectionPtr  = std::shared_ptr<network::AbstractConnection>;
   using ConnectionPtrs = std::vector<ConnectionPtr>;
@@ -73,6 +84,11 @@ void MuddleRegister::Broadcast(ConstByteArray const &data) const
     // loop through all of our current connections
     for (auto const &elem : handle_index_)
     {
+      if (excluded.find(elem.first) != excluded.end())
+      {
+        continue;
+      }
+
       // ensure the connection is valid
       auto connection = elem.second->connection.lock();
       if (connection)
@@ -270,6 +286,20 @@ std::unordered_set<Address> MuddleRegister::GetOutgoingAddressSet() const
   return addresses;
 }
 
+MuddleRegister::HandleSet MuddleRegister::GetCurrentConnectionHandles() const
+{
+  HandleSet handles{};
+
+  FETCH_LOCK(lock_);
+  handles.reserve(handle_index_.size());
+  for (auto const &element : handle_index_)
+  {
+    handles.emplace(element.first);
+  }
+
+  return handles;
+}
+
 MuddleRegister::HandleIndex MuddleRegister::GetHandleIndex() const
 {
   FETCH_LOCK(lock_);
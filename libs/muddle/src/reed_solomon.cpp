@@ -0,0 +1,355 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "reed_solomon.hpp"
+
+#include "core/byte_array/byte_array.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace fetch {
+namespace muddle {
+namespace {
+
+using byte_array::ByteArray;
+
+/**
+ * Arithmetic tables for GF(2^8) with the reduction polynomial x^8 + x^4 + x^3 + x^2 + 1
+ */
+struct GaloisField
+{
+  GaloisField()
+  {
+    uint32_t value = 1;
+    for (uint32_t i = 0; i < 255; ++i)
+    {
+      exp[i]       = static_cast<uint8_t>(value);
+      exp[i + 255] = static_cast<uint8_t>(value);
+      log[value]   = static_cast<uint8_t>(i);
+
+      value <<= 1u;
+      if (value & 0x100u)
+      {
+        value ^= 0x11Du;
+      }
+    }
+
+    for (uint32_t a = 1; a < 256; ++a)
+    {
+      for (uint32_t b = 1; b < 256; ++b)
+      {
+        mul[a][b] = exp[log[a] + log[b]];
+      }
+    }
+  }
+
+  uint8_t Inverse(uint8_t value) const
+  {
+    return exp[255 - log[value]];
+  }
+
+  std::array<uint8_t, 510>                  exp{};
+  std::array<uint8_t, 256>                  log{};
+  std::array<std::array<uint8_t, 256>, 256> mul{};  ///< Full product table for the inner loops
+};
+
+GaloisField const &Field()
+{
+  static GaloisField const field{};
+  return field;
+}
+
+// output += coefficient * input
+void MultiplyAccumulate(uint8_t coefficient, uint8_t const *input, uint8_t *output,
+                        std::size_t length)
+{
+  if (coefficient == 0)
+  {
+    return;
+  }
+
+  auto const &row = Field().mul[coefficient];
+  if (coefficient == 1)
+  {
+    for (std::size_t i = 0; i < length; ++i)
+    {
+      output[i] ^= input[i];
+    }
+  }
+  else
+  {
+    for (std::size_t i = 0; i < length; ++i)
+    {
+      output[i] ^= row[input[i]];
+    }
+  }
+}
+
+/**
+ * Invert a square matrix in place with Gauss-Jordan elimination
+ *
+ * @return false if the matrix is singular
+ */
+bool Invert(std::vector<uint8_t> &matrix, std::size_t size)
+{
+  auto const &field = Field();
+
+  std::vector<uint8_t> inverse(size * size, 0);
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    inverse[i * size + i] = 1;
+  }
+
+  for (std::size_t column = 0; column < size; ++column)
+  {
+    // find a pivot and move it onto the diagonal
+    std::size_t pivot = column;
+    while (pivot < size && matrix[pivot * size + column] == 0)
+    {
+      ++pivot;
+    }
+
+    if (pivot == size)
+    {
+      return false;
+    }
+
+    if (pivot != column)
+    {
+      std::swap_ranges(&matrix[pivot * size], &matrix[pivot * size] + size, &matrix[column * size]);
+      std::swap_ranges(&inverse[pivot * size], &inverse[pivot * size] + size,
+                       &inverse[column * size]);
+    }
+
+    // normalise the pivot row
+    uint8_t const scale = field.Inverse(matrix[column * size + column]);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      matrix[column * size + i]  = field.mul[scale][matrix[column * size + i]];
+      inverse[column * size + i] = field.mul[scale][inverse[column * size + i]];
+    }
+
+    // eliminate the column from all the other rows
+    for (std::size_t row = 0; row < size; ++row)
+    {
+      uint8_t const factor = matrix[row * size + column];
+      if ((row == column) || (factor == 0))
+      {
+        continue;
+      }
+
+      MultiplyAccumulate(factor, &matrix[column * size], &matrix[row * size], size);
+      MultiplyAccumulate(factor, &inverse[column * size], &inverse[row * size], size);
+    }
+  }
+
+  matrix = std::move(inverse);
+  return true;
+}
+
+}  // namespace
+
+/**
+ * Construct the code
+ *
+ * @param data_shards The number of shards the data is split into
+ * @param total_shards The total number of shards, data and parity
+ */
+ReedSolomon::ReedSolomon(std::size_t data_shards, std::size_t total_shards)
+  : data_shards_{data_shards}
+  , total_shards_{total_shards}
+{
+  if ((data_shards_ == 0) || (data_shards_ > total_shards_) || (total_shards_ > MAX_SHARDS))
+  {
+    throw std::invalid_argument("Invalid Reed-Solomon shard configuration");
+  }
+
+  // Cauchy matrix with x_i = data_shards + i and y_j = j, all of which are distinct field elements
+  auto const &      field         = Field();
+  std::size_t const parity_shards = total_shards_ - data_shards_;
+
+  parity_.resize(parity_shards * data_shards_);
+  for (std::size_t i = 0; i < parity_shards; ++i)
+  {
+    for (std::size_t j = 0; j < data_shards_; ++j)
+    {
+      parity_[i * data_shards_ + j] = field.Inverse(static_cast<uint8_t>((data_shards_ + i) ^ j));
+    }
+  }
+}
+
+/**
+ * Encode data into shards. The data is zero padded to a multiple of the number of data shards.
+ *
+ * @param data The data to be encoded
+ * @return The data shards followed by the parity shards
+ */
+ReedSolomon::Shards ReedSolomon::Encode(ConstByteArray const &data) const
+{
+  std::size_t const shard_size =
+      std::max<std::size_t>(1, (data.size() + data_shards_ - 1) / data_shards_);
+
+  Shards shards{};
+  shards.reserve(total_shards_);
+
+  // data shards
+  for (std::size_t i = 0; i < data_shards_; ++i)
+  {
+    ByteArray shard{};
+    shard.Resize(shard_size);
+
+    std::size_t const offset = std::min(i * shard_size, data.size());
+    std::size_t const length = std::min(shard_size, data.size() - offset);
+    if (length > 0)
+    {
+      std::memcpy(shard.pointer(), data.pointer() + offset, length);
+    }
+
+    shards.emplace_back(std::move(shard));
+  }
+
+  // parity shards
+  for (std::size_t i = 0; i < total_shards_ - data_shards_; ++i)
+  {
+    ByteArray shard{};
+    shard.Resize(shard_size);
+
+    for (std::size_t j = 0; j < data_shards_; ++j)
+    {
+      ConstByteArray const &source = shards[j];
+      MultiplyAccumulate(parity_[i * data_shards_ + j], source.pointer(), shard.pointer(),
+                         shard_size);
+    }
+
+    shards.emplace_back(std::move(shard));
+  }
+
+  return shards;
+}
+
+/**
+ * Recover the (padded) data from a set of shards
+ *
+ * @param shards The available shards indexed by shard number, at least `data_shards` are needed
+ * @param data The output data
+ * @return true if successful, otherwise false
+ */
+bool ReedSolomon::Decode(ShardMap const &shards, ConstByteArray &data) const
+{
+  if (shards.size() < data_shards_)
+  {
+    return false;
+  }
+
+  // select the first data_shards of the shards, which prefers the data shards themselves
+  std::vector<std::pair<std::size_t, ConstByteArray const *>> selected{};
+  selected.reserve(data_shards_);
+  for (auto const &shard : shards)
+  {
+    if (selected.size() == data_shards_)
+    {
+      break;
+    }
+
+    if ((shard.first >= total_shards_) || shard.second.empty() ||
+        (shard.second.size() != shards.begin()->second.size()))
+    {
+      return false;
+    }
+
+    selected.emplace_back(shard.first, &shard.second);
+  }
+
+  std::size_t const shard_size = shards.begin()->second.size();
+
+  ByteArray output{};
+  output.Resize(data_shards_ * shard_size);
+
+  // the rows of the coding matrix which produced the selected shards
+  std::vector<uint8_t> matrix(data_shards_ * data_shards_, 0);
+  bool                 complete = true;
+  for (std::size_t row = 0; row < data_shards_; ++row)
+  {
+    std::size_t const index = selected[row].first;
+
+    if (index < data_shards_)
+    {
+      matrix[row * data_shards_ + index] = 1;
+      std::memcpy(output.pointer() + index * shard_size, selected[row].second->pointer(),
+                  shard_size);
+    }
+    else
+    {
+      std::copy_n(&parity_[(index - data_shards_) * data_shards_], data_shards_,
+                  &matrix[row * data_shards_]);
+      complete = false;
+    }
+  }
+
+  // only the missing data shards need to be reconstructed
+  if (!complete)
+  {
+    if (!Invert(matrix, data_shards_))
+    {
+      return false;
+    }
+
+    std::vector<bool> present(data_shards_, false);
+    for (auto const &shard : selected)
+    {
+      if (shard.first < data_shards_)
+      {
+        present[shard.first] = true;
+      }
+    }
+
+    for (std::size_t i = 0; i < data_shards_; ++i)
+    {
+      if (present[i])
+      {
+        continue;
+      }
+
+      for (std::size_t row = 0; row < data_shards_; ++row)
+      {
+        MultiplyAccumulate(matrix[i * data_shards_ + row], selected[row].second->pointer(),
+                           output.pointer() + i * shard_size, shard_size);
+      }
+    }
+  }
+
+  data = output;
+  return true;
+}
+
+std::size_t ReedSolomon::data_shards() const
+{
+  return data_shards_;
+}
+
+std::size_t ReedSolomon::total_shards() const
+{
+  return total_shards_;
+}
+
+}  // namespace muddle
+}  // namespace fetch
@@ -191,6 +191,20 @@ std::string DescribePacket(Packet const &packet)
   return oss.str();
 }
 
+Router::ThreadPools CreateDispatchPools(std::size_t count)
+{
+  Router::ThreadPools pools{};
+  pools.reserve(std::max(count, std::size_t{1}));
+
+  // a single thread per pool keeps the packets from any one peer in order
+  do
+  {
+    pools.emplace_back(network::MakeThreadPool(1, "Router" + std::to_string(pools.size())));
+  } while (pools.size() < count);
+
+  return pools;
+}
+
 telemetry::Measurement::Labels CreateLabels(Router const &router)
 {
   telemetry::Measurement::Labels labels{};
@@ -236,9 +250,10 @@ Packet::Address Router::ConvertAddress(Packet::RawAddress const &address)
  *
  * @param address The address of the current node
  * @param reg The connection register
+ * @param config The router configuration, which also determines the number of dispatch threads
  */
 Router::Router(NetworkId network_id, Address address, MuddleRegister &reg, Prover const &prover,
-               bool enable_message_signing)
+               bool enable_message_signing, RouterConfiguration const &config)
   : name_{GenerateLoggingName(BASE_NAME, network_id)}
   , signing_enabled_{enable_message_signing}
   , address_(std::move(address))
@@ -247,7 +262,8 @@ Router::Router(NetworkId network_id, Address address, MuddleRegister &reg, Prove
   , registrar_(network_id)
   , network_id_(network_id)
   , prover_(prover)
-  , dispatch_thread_pool_(network::MakeThreadPool(NUMBER_OF_ROUTER_THREADS, "Router"))
+  , config_(config)
+  , dispatch_pools_(CreateDispatchPools(config_.dispatch_threads))
   , rx_max_packet_length(
         CreateGauge("ledger_router_rx_max_packet_length", "The max received packet length"))
   , tx_max_packet_length(
@@ -266,6 +282,18 @@ Router::Router(NetworkId network_id, Address address, MuddleRegister &reg, Prove
         CreateCounter("ledger_router_tx_packet_total", "The total number of transmitted packets"))
   , bx_packet_total_(
         CreateCounter("ledger_router_bx_packet_total", "The total number of broadcasted packets"))
+  , bx_duplicate_packet_total_(
+        CreateCounter("ledger_router_bx_duplicate_packet_total",
+                      "The total number of broadcast packets which had already been received"))
+  , broadcast_tree_prunes_total_(
+        CreateCounter("ledger_router_broadcast_tree_prunes_total",
+                      "The total number of peers pruned from the broadcast trees"))
+  , broadcast_tree_grafts_total_(
+        CreateCounter("ledger_router_broadcast_tree_grafts_total",
+                      "The total number of grafts sent to repair the broadcast trees"))
+  , broadcast_tree_announcements_total_(
+        CreateCounter("ledger_router_broadcast_tree_announcements_total",
+                      "The total number of broadcast announcements sent to lazy peers"))
   , rx_encrypted_packet_failures_total_(
         (CreateCounter("ledger_router_rx_encrypted_packet_failures_total",
                        "The total number of received encrypted packets that could not be read")))
@@ -323,7 +351,10 @@ Router::Router(NetworkId network_id, Address address, MuddleRegister &reg, Prove
  */
 void Router::Start()
 {
-  dispatch_thread_pool_->Start();
+  for (auto const &pool : dispatch_pools_)
+  {
+    pool->Start();
+  }
   stopping_ = false;
 }
 
@@ -334,12 +365,16 @@ void Router::Stop()
 {
   stopping_ = true;
 
+  for (auto &shard : delivery_attempts_)
   {
-    FETCH_LOCK(delivery_attempts_lock_);
-    delivery_attempts_.clear();
+    FETCH_LOCK(shard.lock);
+    shard.attempts.clear();
   }
 
-  dispatch_thread_pool_->Stop();
+  for (auto const &pool : dispatch_pools_)
+  {
+    pool->Stop();
+  }
 }
 
 bool Router::Genuine(PacketPtr const &p) const
@@ -399,8 +434,27 @@ void Router::Route(Handle handle, PacketPtr const &packet)
 
   if (packet->IsDirect())
   {
-    // when it is a direct message we must handle this
-    DispatchDirect(handle, packet);
+    if ((packet->GetService() == SERVICE_MUDDLE) &&
+        (packet->GetChannel() == CHANNEL_BROADCAST_TREE))
+    {
+      // broadcast tree maintenance is handled by the router itself
+      DispatchPool(static_cast<std::size_t>(handle))->Post([this, handle, packet]() {
+        if (!stopping_)
+        {
+          OnBroadcastTreeMessage(handle, packet);
+        }
+      });
+    }
+    else
+    {
+      // when it is a direct message we must handle this
+      DispatchDirect(handle, packet);
+    }
+  }
+  else if (packet->IsBroadcast() &&
+           broadcast_tree_.IsEnabled(packet->GetService(), packet->GetChannel()))
+  {
+    RouteTreeBroadcast(handle, packet, true);
   }
   else if (packet->GetTargetRaw() == address_)
   {
@@ -514,7 +568,14 @@ void Router::Broadcast(uint16_t service, uint16_t channel, Payload const &payloa
   packet->SetBroadcast(true);
   Sign(packet);
 
-  RoutePacket(packet, false);
+  if (broadcast_tree_.IsEnabled(service, channel))
+  {
+    RouteTreeBroadcast(0, packet, false);
+  }
+  else
+  {
+    RoutePacket(packet, false);
+  }
 }
 
 /**
@@ -524,6 +585,10 @@ void Router::Broadcast(uint16_t service, uint16_t channel, Payload const &payloa
 void Router::Cleanup()
 {
   CleanEchoCache();
+
+  broadcast_tree_.Trim(
+      register_.GetCurrentConnectionHandles(),
+      std::chrono::duration_cast<BroadcastTree::Duration>(config_.broadcast_history_length));
 }
 
 /**
@@ -683,6 +748,8 @@ void Router::RoutePacket(PacketPtr const &packet, bool external)
     // if this packet is a broadcast echo we should no longer route this packet
     if (packet->IsBroadcast() && IsEcho(*packet))
     {
+      bx_duplicate_packet_total_->increment();
+
       ClearDeliveryAttempt(packet);
       return;
     }
@@ -735,12 +802,11 @@ void Router::RoutePacket(PacketPtr const &packet, bool external)
 
     // this should never be necessary, but in the case where the routing table is not correctly
     // updated by the peer is directly connected, then we should always use that peer
-    auto const address_index = register_.GetAddressIndex();
-    auto const index_it      = address_index.find(packet->GetTarget());
-    if (index_it != address_index.end())
+    auto const connection = register_.LookupConnection(packet->GetTarget()).lock();
+    if (connection)
     {
-      // extract the handle from the index
-      handle = (index_it->second) ? index_it->second->handle : 0u;
+      // extract the handle from the connection
+      handle = connection->handle();
 
       if (handle != 0u)
       {
@@ -775,17 +841,18 @@ void Router::SchedulePacketForRedelivery(PacketPtr const &packet, bool external)
   // This is only suppose to happen in extraordinary circumstansed
   uint64_t attempts{0};
   {
-    FETCH_LOCK(delivery_attempts_lock_);
+    auto &shard = AttemptsShard(packet);
+    FETCH_LOCK(shard.lock);
 
-    if (delivery_attempts_.find(packet) == delivery_attempts_.end())
+    if (shard.attempts.find(packet) == shard.attempts.end())
     {
-      delivery_attempts_[packet] = 0;
+      shard.attempts[packet] = 0;
 
       // Ensuring that the tracker is looking for the desired connection
       tracker_->AddDesiredPeer(packet->GetTarget(), config_.temporary_connection_length);
     }
 
-    attempts = ++delivery_attempts_[packet];
+    attempts = ++shard.attempts[packet];
   }
 
   // Giving up
@@ -817,7 +884,9 @@ void Router::SchedulePacketForRedelivery(PacketPtr const &packet, bool external)
 
   if (!stopping_)
   {
-    dispatch_thread_pool_->Post(
+    // retries for one target share a dispatch lane
+    auto const &pool = DispatchPool(packet->GetTargetRaw());
+    pool->Post(
         [this, packet, external]() {
           if (stopping_)
           {
@@ -844,7 +913,10 @@ void Router::DispatchDirect(Handle handle, PacketPtr const &packet)
 
   if (!stopping_)
   {
-    dispatch_thread_pool_->Post([this, packet, handle]() {
+    // packets from the same connection are always dispatched in order on the same lane
+    auto const &pool = DispatchPool(static_cast<std::size_t>(handle));
+
+    pool->Post([this, packet, handle, &pool]() {
       if (stopping_)
       {
         return;
@@ -854,7 +926,7 @@ void Router::DispatchDirect(Handle handle, PacketPtr const &packet)
       if (register_.UpdateAddress(handle, packet->GetSender()) ==
           MuddleRegister::UpdateStatus::NEW_ADDRESS)
       {
-        dispatch_thread_pool_->Post([this, packet, handle]() {
+        pool->Post([this, packet, handle]() {
           tracker_->DownloadPeerDetails(handle, packet->GetSender());
         });
       }
@@ -883,7 +955,9 @@ void Router::DispatchPacket(PacketPtr const &packet, Address const &transmitter)
 {
   dispatch_enqueued_total_->increment();
 
-  dispatch_thread_pool_->Post([this, packet, transmitter]() {
+  // all the packets for a subscription are dispatched in order on the same lane, so its handler
+  // only ever runs on one thread
+  DispatchPool(packet->GetService(), packet->GetChannel())->Post([this, packet, transmitter]() {
     // decrypt encrypted messages
     if (packet->IsEncrypted())
     {
@@ -931,22 +1005,33 @@ void Router::DispatchPacket(PacketPtr const &packet, Address const &transmitter)
  */
 bool Router::IsEcho(Packet const &packet, bool register_echo)
 {
-  bool is_echo = true;
-
   // combine the 3 fields together into a single index
-  std::size_t const index = GenerateEchoId(packet);
+  return IsEcho(GenerateEchoId(packet), register_echo);
+}
+
+/**
+ * Check to see if the packet with the given echo id is an echo
+ *
+ * @param index The echo id of the packet
+ * @param register_echo Signal if the echo should be registered (if not already in cache)
+ * @return true if the packet is an echo, otherwise false
+ */
+bool Router::IsEcho(std::size_t index, bool register_echo)
+{
+  bool is_echo = true;
 
   {
-    FETCH_LOCK(echo_cache_lock_);
+    auto &shard = EchoShard(index);
+    FETCH_LOCK(shard.lock);
 
     // look up if the echo is in the cache
-    auto it = echo_cache_.find(index);
-    if (it == echo_cache_.end())
+    auto it = shard.cache.find(index);
+    if (it == shard.cache.end())
     {
       // register the echo (in needed)
       if (register_echo)
       {
-        echo_cache_[index] = Clock::now();
+        shard.cache[index] = Clock::now();
       }
 
       is_echo = false;
@@ -961,33 +1046,120 @@ bool Router::IsEcho(Packet const &packet, bool register_echo)
  */
 void Router::CleanEchoCache()
 {
-  FETCH_LOCK(echo_cache_lock_);
-
   echo_cache_trims_total_->increment();
 
   auto const now = Clock::now();
 
-  auto it = echo_cache_.begin();
-  while (it != echo_cache_.end())
+  for (auto &shard : echo_cache_)
   {
-    // calculate the time delta
-    auto const delta = now - it->second;
+    FETCH_LOCK(shard.lock);
 
-    if (delta > std::chrono::seconds{600})
+    auto it = shard.cache.begin();
+    while (it != shard.cache.end())
     {
-      // remove the element
-      it = echo_cache_.erase(it);
+      // calculate the time delta
+      auto const delta = now - it->second;
 
-      echo_cache_removals_total_->increment();
-    }
-    else
-    {
-      // move on to the next element in the cache
-      ++it;
+      if (delta > std::chrono::seconds{600})
+      {
+        // remove the element
+        it = shard.cache.erase(it);
+
+        echo_cache_removals_total_->increment();
+      }
+      else
+      {
+        // move on to the next element in the cache
+        ++it;
+      }
     }
   }
 }
 
+/**
+ * Look up the echo cache shard responsible for an echo id
+ *
+ * @param echo_id The echo id of the packet
+ * @return The shard
+ */
+Router::EchoCacheShard &Router::EchoShard(std::size_t echo_id)
+{
+  return echo_cache_[echo_id % NUMBER_OF_SHARDS];
+}
+
+/**
+ * Look up the dispatch lane for a given key. The same key always maps to the same lane, which
+ * preserves the ordering of the packets posted with it.
+ *
+ * @param key The key, typically a connection handle
+ * @return The thread pool of the lane
+ */
+Router::ThreadPool const &Router::DispatchPool(std::size_t key) const
+{
+  return dispatch_pools_[key % dispatch_pools_.size()];
+}
+
+/**
+ * Look up the dispatch lane for a given peer address
+ *
+ * @param address The raw address of the peer
+ * @return The thread pool of the lane
+ */
+Router::ThreadPool const &Router::DispatchPool(Packet::RawAddress const &address) const
+{
+  // addresses are public keys, so their leading bytes are already well distributed
+  std::size_t key{0};
+  std::memcpy(&key, address.data(), std::min(sizeof(key), address.size()));
+
+  return DispatchPool(key);
+}
+
+/**
+ * Look up the dispatch lane for the subscriptions of a given service and channel
+ *
+ * @param service The service identifier
+ * @param channel The channel identifier
+ * @return The thread pool of the lane
+ */
+Router::ThreadPool const &Router::DispatchPool(uint16_t service, uint16_t channel) const
+{
+  // the multiplier is odd, so different services on the same channel still land on different lanes
+  return DispatchPool((std::size_t{service} * 31u) + channel);
+}
+
+/**
+ * Look up the delivery attempts shard responsible for a packet
+ *
+ * @param packet The packet being delivered
+ * @return The shard
+ */
+Router::DeliveryAttemptsShard &Router::AttemptsShard(PacketPtr const &packet)
+{
+  // packets are keyed by pointer and the low bits of a pointer are always zero because of
+  // alignment, so the bits are mixed (with the MurmurHash3 64-bit finaliser) before picking a shard
+  auto key = static_cast<uint64_t>(reinterpret_cast<std::uintptr_t>(packet.get()));
+  key ^= key >> 33u;
+  key *= 0xff51afd7ed558ccdull;
+  key ^= key >> 33u;
+  key *= 0xc4ceb9fe1a85ec53ull;
+  key ^= key >> 33u;
+
+  return delivery_attempts_[key % NUMBER_OF_SHARDS];
+}
+
+/**
+ * Forget the delivery attempts made for a packet
+ *
+ * @param packet The packet which has been delivered or dropped
+ */
+void Router::ClearDeliveryAttempt(PacketPtr const &packet)
+{
+  auto &shard = AttemptsShard(packet);
+
+  FETCH_LOCK(shard.lock);
+  shard.attempts.erase(packet);
+}
+
 void Router::Blacklist(Address const &target)
 {
   blacklist_.Add(target);
@@ -1003,10 +1175,259 @@ bool Router::IsBlacklisted(Address const &target) const
   return blacklist_.Contains(target);
 }
 
+/**
+ * Select how broadcasts for a service and channel are propagated
+ *
+ * @param service The service identifier
+ * @param channel The channel identifier
+ * @param mode The broadcast mode
+ */
+void Router::SetBroadcastMode(uint16_t service, uint16_t channel, BroadcastMode mode)
+{
+  broadcast_tree_.SetEnabled(service, channel, mode == BroadcastMode::TREE);
+}
+
+/**
+ * Internal: Route a broadcast packet along the broadcast tree of its service and channel. The
+ * packet is pushed to the eager peers and announced to the lazy ones.
+ *
+ * @param handle The handle of the connection the packet was received from (0 for local packets)
+ * @param packet The broadcast packet
+ * @param external Flag to signal that this packet originated from the network
+ */
+void Router::RouteTreeBroadcast(Handle handle, PacketPtr const &packet, bool external)
+{
+  auto const service = packet->GetService();
+  auto const channel = packet->GetChannel();
+  auto const id      = GenerateEchoId(*packet);
+
+  if (external)
+  {
+    // Handle TTL based routing timeout
+    if (packet->GetTTL() <= 2u)
+    {
+      ttl_expired_packet_total_->increment();
+
+      FETCH_LOG_WARN(logging_name_, "Message has timed out (TTL): ", DescribePacket(*packet));
+      return;
+    }
+    // decrement the TTL
+    packet->SetTTL(static_cast<uint8_t>(packet->GetTTL() - 1u));
+
+    if (IsEcho(id, true))
+    {
+      bx_duplicate_packet_total_->increment();
+
+      // the connection is a redundant path in the tree, from now on it only needs announcements
+      if (broadcast_tree_.Prune(service, channel, handle))
+      {
+        broadcast_tree_prunes_total_->increment();
+        SendBroadcastTreeMessage(
+            handle, BroadcastTreeMessage{BroadcastTreeMessage::Type::PRUNE, service, channel, {}});
+      }
+
+      return;
+    }
+
+    // the first peer to deliver a broadcast is always part of the tree
+    broadcast_tree_.Graft(service, channel, handle);
+  }
+  else
+  {
+    // register our own broadcasts so that copies coming back are recognised as duplicates
+    IsEcho(id, true);
+  }
+
+  broadcast_tree_.OnDelivered(id, packet);
+
+  if (packet->GetSender() != address_)
+  {
+    DispatchPacket(packet, address_);
+  }
+
+  // eager push to every peer which has not been pruned
+  auto const lazy_peers = broadcast_tree_.GetLazyPeers(service, channel);
+
+  auto excluded = lazy_peers;
+  excluded.emplace(handle);
+
+  ByteArray buffer{};
+  buffer.Resize(packet->GetPacketSize());
+  if (Packet::ToBuffer(*packet, buffer.pointer(), buffer.size()))
+  {
+    FETCH_LOG_TRACE(logging_name_, "BX (tree):    ", DescribePacket(*packet));
+
+    register_.Broadcast(buffer, excluded);
+    bx_packet_total_->increment();
+    bx_max_packet_length->max(buffer.size());
+    bx_packet_length->Add(static_cast<double>(buffer.size()));
+  }
+  else
+  {
+    FETCH_LOG_WARN(logging_name_, "Failed to serialise muddle packet to stream");
+  }
+
+  // lazy push of the message id to the remaining peers
+  for (auto const lazy_peer : lazy_peers)
+  {
+    if ((lazy_peer != handle) &&
+        broadcast_tree_.QueueAnnouncement(lazy_peer, service, channel, id))
+    {
+      DispatchPool(static_cast<std::size_t>(lazy_peer))
+          ->Post(
+              [this, lazy_peer]() {
+                if (!stopping_)
+                {
+                  SendAnnouncements(lazy_peer);
+                }
+              },
+              config_.broadcast_announce_delay_ms);
+    }
+  }
+}
+
+/**
+ * Internal: Handle a broadcast tree control message from a direct peer
+ *
+ * @param handle The handle of the connection the message was received from
+ * @param packet The packet containing the message
+ */
+void Router::OnBroadcastTreeMessage(Handle handle, PacketPtr const &packet)
+{
+  BroadcastTreeMessage msg{};
+  try
+  {
+    serializers::MsgPackSerializer serializer{packet->GetPayload()};
+    serializer >> msg;
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(logging_name_, "Unable to extract broadcast tree message: ", ex.what());
+    return;
+  }
+
+  switch (msg.type)
+  {
+  case BroadcastTreeMessage::Type::PRUNE:
+    broadcast_tree_.Prune(msg.service, msg.channel, handle);
+    break;
+
+  case BroadcastTreeMessage::Type::ANNOUNCE:
+    for (auto const id : msg.ids)
+    {
+      // wait for a while for the broadcast to arrive along the tree, before grafting
+      if (!IsEcho(id, false) &&
+          broadcast_tree_.OnAnnounced(id, msg.service, msg.channel, handle))
+      {
+        DispatchPool(static_cast<std::size_t>(id))
+            ->Post(
+                [this, id]() {
+                  if (!stopping_)
+                  {
+                    OnGraftTimeout(id);
+                  }
+                },
+                config_.broadcast_graft_timeout_ms);
+      }
+    }
+    break;
+
+  case BroadcastTreeMessage::Type::GRAFT:
+    broadcast_tree_.Graft(msg.service, msg.channel, handle);
+
+    for (auto const id : msg.ids)
+    {
+      auto const broadcast = broadcast_tree_.GetMessage(id);
+      if (broadcast)
+      {
+        SendToConnection(handle, broadcast, false, false);
+      }
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+/**
+ * Internal: Send a broadcast tree control message to a direct peer
+ *
+ * @param handle The handle of the connection to the peer
+ * @param msg The message to be sent
+ */
+void Router::SendBroadcastTreeMessage(Handle handle, BroadcastTreeMessage const &msg)
+{
+  serializers::MsgPackSerializer serializer{};
+  serializer << msg;
+
+  auto packet = std::make_shared<Packet>(address_, network_id_.value());
+  packet->SetService(SERVICE_MUDDLE);
+  packet->SetChannel(CHANNEL_BROADCAST_TREE);
+  packet->SetDirect(true);
+  packet->SetPayload(serializer.data());
+
+  SendToConnection(handle, Sign(packet), false, false);
+}
+
+/**
+ * Internal: Send the batched announcements to a lazy peer
+ *
+ * @param handle The handle of the connection to the peer
+ */
+void Router::SendAnnouncements(Handle handle)
+{
+  for (auto &announcement : broadcast_tree_.TakeAnnouncements(handle))
+  {
+    broadcast_tree_announcements_total_->increment();
+    SendBroadcastTreeMessage(
+        handle, BroadcastTreeMessage{BroadcastTreeMessage::Type::ANNOUNCE, announcement.service,
+                                     announcement.channel, std::move(announcement.ids)});
+  }
+}
+
+/**
+ * Internal: Called when an announced broadcast has not arrived in time. Grafts the next announcing
+ * peer back into the tree and requests the broadcast from it.
+ *
+ * @param id The message id of the missing broadcast
+ */
+void Router::OnGraftTimeout(BroadcastTree::MessageId id)
+{
+  BroadcastTree::GraftTarget target{};
+  if (!broadcast_tree_.NextGraft(id, target))
+  {
+    return;
+  }
+
+  broadcast_tree_grafts_total_->increment();
+  SendBroadcastTreeMessage(target.handle, BroadcastTreeMessage{BroadcastTreeMessage::Type::GRAFT,
+                                                               target.service, target.channel,
+                                                               {id}});
+
+  // try the next announcing peer if this one does not deliver either
+  DispatchPool(static_cast<std::size_t>(id))
+      ->Post(
+          [this, id]() {
+            if (!stopping_)
+            {
+              OnGraftTimeout(id);
+            }
+          },
+          config_.broadcast_graft_timeout_ms);
+}
+
 Router::EchoCache Router::echo_cache() const
 {
-  FETCH_LOCK(echo_cache_lock_);
-  return echo_cache_;
+  EchoCache cache{};
+
+  for (auto const &shard : echo_cache_)
+  {
+    FETCH_LOCK(shard.lock);
+    cache.insert(shard.cache.begin(), shard.cache.end());
+  }
+
+  return cache;
 }
 
 NetworkId const &Router::network() const
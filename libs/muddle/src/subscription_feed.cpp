@@ -24,6 +24,7 @@
 #include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace fetch {
 namespace muddle {
@@ -56,32 +57,39 @@ SubscriptionFeed::SubscriptionPtr SubscriptionFeed::Subscribe()
  */
 bool SubscriptionFeed::Dispatch(Packet const &packet, Address const &last_hop)
 {
-  FETCH_LOCK(feed_lock_);
+  std::vector<SubscriptionPtr> subscriptions{};
 
-  bool success = false;
-
-  // loop through the subscriptions
-  auto it = feed_.cbegin();
-  while (it != feed_.cend())
+  // collect the live subscriptions, so that the handlers are not called with the feed lock held
   {
-    // check
-    auto subscription = it->lock();
-    if (subscription)
-    {
-      // dispatch the message to the handler
-      subscription->Dispatch(packet, last_hop);
+    FETCH_LOCK(feed_lock_);
 
-      success = true;
-      ++it;
-    }
-    else
+    subscriptions.reserve(feed_.size());
+
+    auto it = feed_.cbegin();
+    while (it != feed_.cend())
     {
-      // if the subscription is dead then remove it from our list
-      it = feed_.erase(it);
+      // check
+      auto subscription = it->lock();
+      if (subscription)
+      {
+        subscriptions.emplace_back(std::move(subscription));
+        ++it;
+      }
+      else
+      {
+        // if the subscription is dead then remove it from our list
+        it = feed_.erase(it);
+      }
     }
   }
 
-  return success;
+  // dispatch the message to the handlers
+  for (auto const &subscription : subscriptions)
+  {
+    subscription->Dispatch(packet, last_hop);
+  }
+
+  return !subscriptions.empty();
 }
 
 }  // namespace muddle
@@ -117,34 +117,48 @@ bool SubscriptionRegistrar::Dispatch(PacketPtr const &packet, Address const &tra
   Index const  index = Combine(packet->GetService(), packet->GetChannel());
   AddressIndex address_index{index, packet->GetTarget()};
 
+  // Feeds are never removed from the maps and map nodes do not move, so the feeds can be looked up
+  // under the registrar lock and dispatched to without it. This allows the router to dispatch
+  // packets for different services / channels in parallel.
+  SubscriptionFeed *feed{nullptr};
+  SubscriptionFeed *address_feed{nullptr};
+
   {
     FETCH_LOCK(lock_);
+
     auto it = dispatch_map_.find(index);
     if (it != dispatch_map_.end())
     {
-      // dispatch the packet to the subscription feed
-      success = it->second.Dispatch(*packet, transmitter);
+      feed = &it->second;
+    }
 
-      if (!success)
-      {
-        FETCH_LOG_WARN(logging_name_, "Failed to dispatch message to a given subscription");
-      }
+    auto address_it = address_dispatch_map_.find(address_index);
+    if (address_it != address_dispatch_map_.end())
+    {
+      address_feed = &address_it->second;
     }
   }
 
+  if (feed)
   {
-    FETCH_LOCK(lock_);
-    auto it = address_dispatch_map_.find(address_index);
-    if (it != address_dispatch_map_.end())
+    // dispatch the packet to the subscription feed
+    success = feed->Dispatch(*packet, transmitter);
+
+    if (!success)
+    {
+      FETCH_LOG_WARN(logging_name_, "Failed to dispatch message to a given subscription");
+    }
+  }
+
+  if (address_feed)
+  {
+    // dispatch the packet to the subscription feed
+    success = address_feed->Dispatch(*packet, transmitter);
+
+    if (!success)
     {
-      // dispatch the packet to the subscription feed
-      success = it->second.Dispatch(*packet, transmitter);
-
-      if (!success)
-      {
-        FETCH_LOG_WARN(logging_name_,
-                       "Failed to dispatch message to a given subscription (address specific)");
-      }
+      FETCH_LOG_WARN(logging_name_,
+                     "Failed to dispatch message to a given subscription (address specific)");
     }
   }
 
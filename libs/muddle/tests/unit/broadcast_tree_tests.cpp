@@ -0,0 +1,183 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "broadcast_tree.hpp"
+#include "broadcast_tree_message.hpp"
+
+#include "core/serializers/main_serializer.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace {
+
+using fetch::muddle::BroadcastTree;
+using fetch::muddle::BroadcastTreeMessage;
+using fetch::muddle::Packet;
+
+using HandleSet = BroadcastTree::HandleSet;
+
+constexpr uint16_t SERVICE = 10;
+constexpr uint16_t CHANNEL = 20;
+
+class BroadcastTreeTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    tree_.SetEnabled(SERVICE, CHANNEL, true);
+  }
+
+  BroadcastTree tree_;
+};
+
+TEST_F(BroadcastTreeTests, trees_are_only_enabled_for_selected_channels)
+{
+  EXPECT_TRUE(tree_.IsEnabled(SERVICE, CHANNEL));
+  EXPECT_FALSE(tree_.IsEnabled(SERVICE, CHANNEL + 1));
+  EXPECT_FALSE(tree_.IsEnabled(SERVICE + 1, CHANNEL));
+
+  tree_.SetEnabled(SERVICE, CHANNEL, false);
+  EXPECT_FALSE(tree_.IsEnabled(SERVICE, CHANNEL));
+}
+
+TEST_F(BroadcastTreeTests, pruned_peers_are_lazy_until_grafted)
+{
+  EXPECT_TRUE(tree_.GetLazyPeers(SERVICE, CHANNEL).empty());
+
+  EXPECT_TRUE(tree_.Prune(SERVICE, CHANNEL, 1));
+  EXPECT_FALSE(tree_.Prune(SERVICE, CHANNEL, 1));
+  EXPECT_TRUE(tree_.Prune(SERVICE, CHANNEL, 2));
+  EXPECT_EQ(tree_.GetLazyPeers(SERVICE, CHANNEL), (HandleSet{1, 2}));
+
+  tree_.Graft(SERVICE, CHANNEL, 1);
+  EXPECT_EQ(tree_.GetLazyPeers(SERVICE, CHANNEL), (HandleSet{2}));
+
+  // trees which are not enabled do not track peers
+  EXPECT_FALSE(tree_.Prune(SERVICE, CHANNEL + 1, 1));
+  EXPECT_TRUE(tree_.GetLazyPeers(SERVICE, CHANNEL + 1).empty());
+}
+
+TEST_F(BroadcastTreeTests, missing_broadcasts_are_grafted_from_each_announcer_in_turn)
+{
+  tree_.Prune(SERVICE, CHANNEL, 1);
+  tree_.Prune(SERVICE, CHANNEL, 2);
+
+  // only the first announcement starts the timer
+  EXPECT_TRUE(tree_.OnAnnounced(100, SERVICE, CHANNEL, 1));
+  EXPECT_FALSE(tree_.OnAnnounced(100, SERVICE, CHANNEL, 2));
+  EXPECT_FALSE(tree_.OnAnnounced(100, SERVICE, CHANNEL, 1));
+
+  BroadcastTree::GraftTarget target{};
+  ASSERT_TRUE(tree_.NextGraft(100, target));
+  EXPECT_EQ(target.handle, 1);
+  EXPECT_EQ(target.service, SERVICE);
+  EXPECT_EQ(target.channel, CHANNEL);
+  EXPECT_EQ(tree_.GetLazyPeers(SERVICE, CHANNEL), (HandleSet{2}));
+
+  ASSERT_TRUE(tree_.NextGraft(100, target));
+  EXPECT_EQ(target.handle, 2);
+  EXPECT_TRUE(tree_.GetLazyPeers(SERVICE, CHANNEL).empty());
+
+  EXPECT_FALSE(tree_.NextGraft(100, target));
+  EXPECT_FALSE(tree_.NextGraft(100, target));
+}
+
+TEST_F(BroadcastTreeTests, delivery_cancels_grafts_and_keeps_the_broadcast)
+{
+  auto packet = std::make_shared<Packet>();
+
+  EXPECT_TRUE(tree_.OnAnnounced(100, SERVICE, CHANNEL, 1));
+  tree_.OnDelivered(100, packet);
+
+  BroadcastTree::GraftTarget target{};
+  EXPECT_FALSE(tree_.NextGraft(100, target));
+  EXPECT_EQ(tree_.GetMessage(100), packet);
+  EXPECT_FALSE(tree_.GetMessage(101));
+
+  // announcements of delivered broadcasts are ignored
+  EXPECT_FALSE(tree_.OnAnnounced(100, SERVICE, CHANNEL, 2));
+}
+
+TEST_F(BroadcastTreeTests, announcements_are_batched_per_peer_and_tree)
+{
+  EXPECT_TRUE(tree_.QueueAnnouncement(1, SERVICE, CHANNEL, 100));
+  EXPECT_FALSE(tree_.QueueAnnouncement(1, SERVICE, CHANNEL, 101));
+  EXPECT_FALSE(tree_.QueueAnnouncement(1, SERVICE, CHANNEL + 1, 102));
+  EXPECT_TRUE(tree_.QueueAnnouncement(2, SERVICE, CHANNEL, 100));
+
+  auto announcements = tree_.TakeAnnouncements(1);
+  ASSERT_EQ(announcements.size(), 2);
+
+  std::size_t total{0};
+  for (auto const &announcement : announcements)
+  {
+    EXPECT_EQ(announcement.service, SERVICE);
+    total += announcement.ids.size();
+
+    if (announcement.channel == CHANNEL)
+    {
+      EXPECT_EQ(announcement.ids, (BroadcastTree::MessageIds{100, 101}));
+    }
+  }
+  EXPECT_EQ(total, 3);
+
+  EXPECT_TRUE(tree_.TakeAnnouncements(1).empty());
+  EXPECT_TRUE(tree_.QueueAnnouncement(1, SERVICE, CHANNEL, 103));
+  EXPECT_EQ(tree_.TakeAnnouncements(2).size(), 1);
+}
+
+TEST_F(BroadcastTreeTests, trimming_forgets_old_broadcasts_and_disconnected_peers)
+{
+  auto const now = BroadcastTree::Clock::now();
+
+  tree_.Prune(SERVICE, CHANNEL, 1);
+  tree_.Prune(SERVICE, CHANNEL, 2);
+  tree_.QueueAnnouncement(1, SERVICE, CHANNEL, 100);
+  tree_.OnDelivered(100, std::make_shared<Packet>(), now - std::chrono::seconds{120});
+  tree_.OnDelivered(101, std::make_shared<Packet>(), now);
+
+  tree_.Trim(HandleSet{2}, std::chrono::seconds{60}, now);
+
+  EXPECT_EQ(tree_.GetLazyPeers(SERVICE, CHANNEL), (HandleSet{2}));
+  EXPECT_TRUE(tree_.TakeAnnouncements(1).empty());
+  EXPECT_FALSE(tree_.GetMessage(100));
+  EXPECT_TRUE(tree_.GetMessage(101));
+}
+
+TEST_F(BroadcastTreeTests, messages_survive_serialisation)
+{
+  BroadcastTreeMessage msg{BroadcastTreeMessage::Type::GRAFT, SERVICE, CHANNEL, {1, 2, 3}};
+
+  fetch::serializers::MsgPackSerializer serializer{};
+  serializer << msg;
+
+  BroadcastTreeMessage output{};
+  fetch::serializers::MsgPackSerializer deserializer{serializer.data()};
+  deserializer >> output;
+
+  EXPECT_EQ(output.type, msg.type);
+  EXPECT_EQ(output.service, msg.service);
+  EXPECT_EQ(output.channel, msg.channel);
+  EXPECT_EQ(output.ids, msg.ids);
+}
+
+}  // namespace
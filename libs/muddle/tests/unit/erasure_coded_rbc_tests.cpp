@@ -0,0 +1,291 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/mutex.hpp"
+#include "crypto/ecdsa.hpp"
+#include "muddle/create_muddle_fake.hpp"
+#include "muddle/erasure_coded_rbc.hpp"
+#include "network/management/network_manager.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace fetch;
+using namespace fetch::muddle;
+
+using byte_array::ByteArray;
+using byte_array::ConstByteArray;
+
+using Messages = std::vector<ConstByteArray>;
+
+// Corrupts the fragment of every echo it sends
+class FaultyErasureCodedRBC : public ErasureCodedRBC
+{
+public:
+  using ErasureCodedRBC::ErasureCodedRBC;
+
+protected:
+  void InternalBroadcast(Message const &msg) override
+  {
+    if (msg.type != MessageType::R_ECHO)
+    {
+      ErasureCodedRBC::InternalBroadcast(msg);
+      return;
+    }
+
+    Message   corrupted{msg};
+    ByteArray fragment = msg.fragment.Copy();
+    fragment[0]        = static_cast<uint8_t>(fragment[0] ^ 0xFFu);
+    corrupted.fragment = fragment;
+
+    ErasureCodedRBC::InternalBroadcast(corrupted);
+  }
+};
+
+struct Member
+{
+  Member(uint16_t index, bool faulty)
+    : network_manager{"NetworkManager" + std::to_string(index), 1}
+    , certificate{std::make_shared<crypto::ECDSASigner>()}
+    , muddle{CreateMuddleFake("Test", certificate, network_manager, "127.0.0.1")}
+  {
+    auto callback = [this](ConstByteArray const &from, ConstByteArray const &payload) {
+      FETCH_LOCK(lock);
+      delivered[from].push_back(payload);
+    };
+
+    auto const address = certificate->identity().identifier();
+    if (faulty)
+    {
+      channel = std::make_unique<FaultyErasureCodedRBC>(muddle->GetEndpoint(), address, callback);
+    }
+    else
+    {
+      channel = std::make_unique<ErasureCodedRBC>(muddle->GetEndpoint(), address, callback);
+    }
+
+    muddle->Start({static_cast<uint16_t>(9000 + index)});
+  }
+
+  ~Member()
+  {
+    muddle->Stop();
+  }
+
+  ConstByteArray address() const
+  {
+    return certificate->identity().identifier();
+  }
+
+  std::size_t NumDelivered()
+  {
+    FETCH_LOCK(lock);
+
+    std::size_t count{0};
+    for (auto const &messages : delivered)
+    {
+      count += messages.second.size();
+    }
+
+    return count;
+  }
+
+  network::NetworkManager              network_manager;
+  std::shared_ptr<crypto::ECDSASigner> certificate;
+  MuddlePtr                            muddle;
+  std::unique_ptr<ErasureCodedRBC>     channel;
+  Mutex                                lock;
+  std::map<ConstByteArray, Messages>   delivered;
+};
+
+using MemberPtr = std::unique_ptr<Member>;
+using Members   = std::vector<MemberPtr>;
+
+class ErasureCodedRBCTests : public ::testing::Test
+{
+protected:
+  void CreateCabinet(std::size_t size, std::size_t num_faulty = 0)
+  {
+    BroadcastChannelInterface::CabinetMembers cabinet{};
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      members_.emplace_back(std::make_unique<Member>(static_cast<uint16_t>(i), i < num_faulty));
+      cabinet.insert(members_.back()->address());
+    }
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      for (std::size_t j = 0; j < i; ++j)
+      {
+        members_[i]->muddle->ConnectTo(members_[j]->address());
+      }
+    }
+
+    for (auto &member : members_)
+    {
+      ASSERT_TRUE(member->channel->ResetCabinet(cabinet));
+    }
+
+    // wait for the cabinet to be fully connected
+    for (auto &member : members_)
+    {
+      while (member->muddle->GetNumDirectlyConnectedPeers() != size - 1)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      }
+    }
+  }
+
+  bool WaitForDeliveries(std::vector<std::size_t> const &receivers, std::size_t expected)
+  {
+    for (std::size_t attempt = 0; attempt < 1000; ++attempt)
+    {
+      bool complete = true;
+      for (auto receiver : receivers)
+      {
+        complete &= (members_[receiver]->NumDelivered() >= expected);
+      }
+
+      if (complete)
+      {
+        return true;
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    return false;
+  }
+
+  static ConstByteArray MakeMessage(std::size_t sender, std::size_t number, std::size_t size)
+  {
+    ByteArray message;
+    message.Resize(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      message[i] = static_cast<uint8_t>(sender * 31 + number * 7 + i);
+    }
+
+    return {message};
+  }
+
+  Members members_;
+};
+
+TEST_F(ErasureCodedRBCTests, members_deliver_every_broadcast_in_order)
+{
+  constexpr std::size_t CABINET_SIZE = 7;
+  constexpr std::size_t NUM_MESSAGES = 3;
+
+  CreateCabinet(CABINET_SIZE);
+
+  for (std::size_t number = 0; number < NUM_MESSAGES; ++number)
+  {
+    for (std::size_t sender = 0; sender < CABINET_SIZE; ++sender)
+    {
+      members_[sender]->channel->Broadcast(MakeMessage(sender, number, 1000 + number * 999));
+    }
+  }
+
+  std::vector<std::size_t> receivers{0, 1, 2, 3, 4, 5, 6};
+  ASSERT_TRUE(WaitForDeliveries(receivers, (CABINET_SIZE - 1) * NUM_MESSAGES));
+
+  for (std::size_t receiver = 0; receiver < CABINET_SIZE; ++receiver)
+  {
+    FETCH_LOCK(members_[receiver]->lock);
+    auto const &delivered = members_[receiver]->delivered;
+
+    // members do not deliver their own messages
+    EXPECT_EQ(delivered.count(members_[receiver]->address()), 0);
+
+    for (std::size_t sender = 0; sender < CABINET_SIZE; ++sender)
+    {
+      if (sender == receiver)
+      {
+        continue;
+      }
+
+      auto const &messages = delivered.at(members_[sender]->address());
+      ASSERT_EQ(messages.size(), NUM_MESSAGES);
+      for (std::size_t number = 0; number < NUM_MESSAGES; ++number)
+      {
+        EXPECT_EQ(messages[number], MakeMessage(sender, number, 1000 + number * 999));
+      }
+    }
+  }
+}
+
+TEST_F(ErasureCodedRBCTests, silent_members_are_tolerated)
+{
+  constexpr std::size_t CABINET_SIZE = 7;
+
+  CreateCabinet(CABINET_SIZE);
+
+  // two of the seven members (the maximum number of faults) take no part
+  members_[0]->channel->Enable(false);
+  members_[1]->channel->Enable(false);
+
+  for (std::size_t sender = 2; sender < CABINET_SIZE; ++sender)
+  {
+    members_[sender]->channel->Broadcast(MakeMessage(sender, 0, 4096));
+  }
+
+  EXPECT_TRUE(WaitForDeliveries({2, 3, 4, 5, 6}, CABINET_SIZE - 3));
+  EXPECT_EQ(members_[0]->NumDelivered(), 0);
+}
+
+TEST_F(ErasureCodedRBCTests, corrupted_fragments_are_rejected)
+{
+  constexpr std::size_t CABINET_SIZE = 4;
+
+  // the first member echoes corrupted fragments for every message
+  CreateCabinet(CABINET_SIZE, 1);
+
+  for (std::size_t sender = 0; sender < CABINET_SIZE; ++sender)
+  {
+    members_[sender]->channel->Broadcast(MakeMessage(sender, 0, 2048));
+  }
+
+  ASSERT_TRUE(WaitForDeliveries({0, 1, 2, 3}, CABINET_SIZE - 1));
+
+  for (std::size_t receiver = 1; receiver < CABINET_SIZE; ++receiver)
+  {
+    FETCH_LOCK(members_[receiver]->lock);
+    for (std::size_t sender = 0; sender < CABINET_SIZE; ++sender)
+    {
+      if (sender != receiver)
+      {
+        EXPECT_EQ(members_[receiver]->delivered.at(members_[sender]->address()).front(),
+                  MakeMessage(sender, 0, 2048));
+      }
+    }
+  }
+}
+
+}  // namespace
@@ -0,0 +1,129 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "reed_solomon.hpp"
+
+#include "core/byte_array/byte_array.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::muddle::ReedSolomon;
+
+ConstByteArray RandomData(std::mt19937_64 &rng, std::size_t size)
+{
+  ByteArray data;
+  data.Resize(size);
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    data[i] = static_cast<uint8_t>(rng());
+  }
+
+  return {data};
+}
+
+TEST(ReedSolomonTests, invalid_configurations_are_rejected)
+{
+  EXPECT_THROW(ReedSolomon(0, 4), std::invalid_argument);
+  EXPECT_THROW(ReedSolomon(5, 4), std::invalid_argument);
+  EXPECT_THROW(ReedSolomon(4, 257), std::invalid_argument);
+  EXPECT_NO_THROW(ReedSolomon(1, 1));
+}
+
+TEST(ReedSolomonTests, data_shards_hold_the_padded_data)
+{
+  std::mt19937_64   rng{1};
+  ReedSolomon const code{3, 7};
+
+  auto const data   = RandomData(rng, 100);
+  auto const shards = code.Encode(data);
+
+  ASSERT_EQ(shards.size(), 7);
+  for (auto const &shard : shards)
+  {
+    EXPECT_EQ(shard.size(), 34);
+  }
+
+  EXPECT_EQ(shards[0] + shards[1] + shards[2].SubArray(0, 32), data);
+  EXPECT_EQ(shards[2][32], 0);
+  EXPECT_EQ(shards[2][33], 0);
+}
+
+TEST(ReedSolomonTests, data_is_recovered_from_any_subset_of_shards)
+{
+  std::mt19937_64 rng{2};
+
+  for (auto const &config : std::vector<std::pair<std::size_t, std::size_t>>{
+           {1, 1}, {1, 4}, {2, 4}, {3, 7}, {11, 31}, {22, 64}, {86, 256}})
+  {
+    ReedSolomon const code{config.first, config.second};
+
+    auto const data   = RandomData(rng, 1000);
+    auto const shards = code.Encode(data);
+
+    std::vector<std::size_t> order(shards.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    for (std::size_t trial = 0; trial < 10; ++trial)
+    {
+      std::shuffle(order.begin(), order.end(), rng);
+
+      ReedSolomon::ShardMap available{};
+      for (std::size_t i = 0; i < code.data_shards(); ++i)
+      {
+        available.emplace(order[i], shards[order[i]]);
+      }
+
+      ConstByteArray decoded{};
+      ASSERT_TRUE(code.Decode(available, decoded));
+      EXPECT_EQ(decoded.SubArray(0, data.size()), data);
+    }
+  }
+}
+
+TEST(ReedSolomonTests, decoding_needs_enough_consistent_shards)
+{
+  std::mt19937_64   rng{3};
+  ReedSolomon const code{3, 7};
+
+  auto const shards = code.Encode(RandomData(rng, 90));
+
+  ConstByteArray        decoded{};
+  ReedSolomon::ShardMap available{{1, shards[1]}, {5, shards[5]}};
+  EXPECT_FALSE(code.Decode(available, decoded));
+
+  available.emplace(9, shards[6]);
+  EXPECT_FALSE(code.Decode(available, decoded));
+
+  available.erase(9);
+  available.emplace(6, shards[6].SubArray(0, 10));
+  EXPECT_FALSE(code.Decode(available, decoded));
+}
+
+}  // namespace
@@ -27,8 +27,11 @@
 
 #include "gmock/gmock.h"
 
+#include <chrono>
 #include <cstdint>
+#include <future>
 #include <memory>
+#include <thread>
 #include <utility>
 
 using fetch::muddle::NetworkId;
@@ -170,3 +173,37 @@ TEST_F(SubscriptionManagerTests, MultipleDifferentHandlers)
 
   EXPECT_EQ(dispatches, 5);
 }
+
+TEST_F(SubscriptionManagerTests, DifferentChannelsDispatchConcurrently)
+{
+  auto subscription1 = registrar_->Register(1, 2);
+  auto subscription2 = registrar_->Register(1, 3);
+
+  std::promise<void> first_started;
+  std::promise<void> second_finished;
+  auto               second_finished_future = second_finished.get_future();
+
+  // the first handler only completes once the second one has run alongside it
+  bool overlapped = false;
+  subscription1->SetMessageHandler([&](Address const &, uint16_t, uint16_t, uint16_t,
+                                       Packet::Payload const &, Address const &) {
+    first_started.set_value();
+    overlapped = second_finished_future.wait_for(std::chrono::seconds{5}) ==
+                 std::future_status::ready;
+  });
+  subscription2->SetMessageHandler(
+      [&](Address const &, uint16_t, uint16_t, uint16_t, Packet::Payload const &,
+          Address const &) { second_finished.set_value(); });
+
+  auto first_packet  = CreatePacket(1, 2);
+  auto second_packet = CreatePacket(1, 3);
+
+  std::thread first_dispatch{[&]() { registrar_->Dispatch(first_packet, Address()); }};
+
+  first_started.get_future().wait();
+  registrar_->Dispatch(second_packet, Address());
+
+  first_dispatch.join();
+
+  EXPECT_TRUE(overlapped);
+}
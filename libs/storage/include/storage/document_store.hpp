@@ -25,6 +25,8 @@
 #include <cassert>
 #include <fstream>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "core/mutex.hpp"
 #include "network/service/protocol.hpp"
@@ -60,6 +62,7 @@ public:
   using IndexType = typename KeyValueIndexType::IndexType;
 
   using ByteArray = byte_array::ByteArray;
+  using Documents = std::vector<std::pair<ResourceID, byte_array::ConstByteArray>>;
 
   static constexpr char const *LOGGING_NAME = "DocumentStore";
 
@@ -131,30 +134,40 @@ public:
     return GetOrCreate(rid, false);
   }
 
+  bool Has(ResourceID const &rid)
+  {
+    IndexType index = 0;
+
+    FETCH_LOCK(mutex_);
+    return key_index_.GetIfExists(rid.id(), index);
+  }
+
   void Set(ResourceID const &rid, byte_array::ConstByteArray const &value)
   {
-    byte_array::ConstByteArray const &address = rid.id();
-    IndexType                         index   = 0;
+    FETCH_LOCK(mutex_);
+
+    Write(rid, value);
 
+    file_object_.Flush();
+    key_index_.Flush();
+  }
+
+  /**
+   * Write a batch of documents under a single lock, flushing the documents and the key index once
+   * for the whole batch rather than after every document
+   *
+   * @param: documents The keys and the documents to be written
+   */
+  void SetBatch(Documents const &documents)
+  {
     FETCH_LOCK(mutex_);
 
-    if (key_index_.GetIfExists(address, index))
+    for (auto const &document : documents)
     {
-      file_object_.SeekFile(index);
+      Write(document.first, document.second);
     }
-    else
-    {
-      // Create new file, with new index etc.
-      // write this to the key index
-      file_object_.CreateNewFile(value.size());
-    }
-
-    file_object_.Resize(value.size());
 
-    file_object_.Write(value);
     file_object_.Flush();
-
-    key_index_.Set(address, file_object_.id(), file_object_.Hash());
     key_index_.Flush();
   }
 
@@ -341,6 +354,32 @@ public:
   }
 
 protected:
+  /**
+   * Write a document to the file object and record it in the key index, without locking or
+   * flushing either of them
+   */
+  void Write(ResourceID const &rid, byte_array::ConstByteArray const &value)
+  {
+    byte_array::ConstByteArray const &address = rid.id();
+    IndexType                         index   = 0;
+
+    if (key_index_.GetIfExists(address, index))
+    {
+      file_object_.SeekFile(index);
+    }
+    else
+    {
+      // Create new file, with new index etc.
+      // write this to the key index
+      file_object_.CreateNewFile(value.size());
+    }
+
+    file_object_.Resize(value.size());
+    file_object_.Write(value);
+
+    key_index_.Set(address, file_object_.id(), file_object_.Hash());
+  }
+
   Mutex             mutex_;
   KeyValueIndexType key_index_;
   FileObjectType    file_object_;
@@ -24,6 +24,8 @@
 #include <cstddef>
 #include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -51,6 +53,7 @@ public:
   using type           = T;
   using SelfType       = ObjectStore<T, S>;
   using SerializerType = serializers::MsgPackSerializer;
+  using KeyObjectPairs = std::vector<std::pair<ResourceID, type>>;
 
   class Iterator;
 
@@ -130,6 +133,18 @@ public:
     LocklessSet(rid, object);
   }
 
+  /**
+   * Put a batch of objects into the store
+   *
+   * @param: objects The keys and the objects
+   *
+   */
+  void SetBatch(KeyObjectPairs const &objects)
+  {
+    FETCH_LOCK(mutex_);
+    LocklessSetBatch(objects);
+  }
+
   /**
    * Obtain a lock then execute closure to reduce overhead from requiring
    * multiple locks to be
@@ -185,8 +200,7 @@ public:
    */
   bool LocklessHas(ResourceID const &rid)
   {
-    Document doc = store_.Get(rid);
-    return !doc.failed;
+    return store_.Has(rid);
   }
 
   /**
@@ -205,6 +219,29 @@ public:
     store_.Set(rid, ser.data());  // temporarily disable disk writes
   }
 
+  /**
+   * Do a set of a batch of objects without locking the structure. The underlying document store
+   * is flushed once for the whole batch
+   *
+   * @param: objects The keys and the objects
+   *
+   */
+  void LocklessSetBatch(KeyObjectPairs const &objects)
+  {
+    typename KeyByteArrayStore<S>::Documents documents;
+    documents.reserve(objects.size());
+
+    for (auto const &object : objects)
+    {
+      SerializerType ser;
+      ser << object.second;
+
+      documents.emplace_back(object.first, ser.data());
+    }
+
+    store_.SetBatch(documents);
+  }
+
   std::size_t size() const
   {
     FETCH_LOCK(mutex_);
@@ -382,6 +382,46 @@ TEST(storage_object_store, correlated_strings_work_correctly)
   ASSERT_EQ(testStore.size(), unique_ids.size()) << "ERROR: Failed to verify final size!";
 }
 
+TEST(storage_object_store, batched_sets_match_individual_sets)
+{
+  ObjectStore<std::string> individual;
+  individual.New("testFile_02.db", "testIndex_02.db");
+
+  ObjectStore<std::string> batched;
+  batched.New("testFile_03.db", "testIndex_03.db");
+
+  auto const                    id_set = GenerateUniqueIDs(256);
+  std::vector<ResourceID> const unique_ids(id_set.begin(), id_set.end());
+
+  // the second batch overwrites half of the first one
+  for (std::size_t start : {std::size_t{0}, unique_ids.size() / 2})
+  {
+    ObjectStore<std::string>::KeyObjectPairs batch{};
+    for (std::size_t i = start; i < start + (unique_ids.size() / 2); ++i)
+    {
+      auto const value = unique_ids[i].ToString() + std::to_string(start);
+
+      individual.Set(unique_ids[i], value);
+      batch.emplace_back(unique_ids[i], value);
+    }
+
+    batched.SetBatch(batch);
+  }
+
+  ASSERT_EQ(batched.size(), individual.size());
+
+  for (auto const &id : unique_ids)
+  {
+    std::string expected{};
+    std::string actual{};
+
+    ASSERT_TRUE(batched.Has(id));
+    ASSERT_TRUE(individual.Get(id, expected));
+    ASSERT_TRUE(batched.Get(id, actual));
+    EXPECT_EQ(actual, expected);
+  }
+}
+
 TEST(storage_object_store_with_STL_gtest, iterator_over_basic_struct_with_key_info)
 {
   std::vector<uint64_t> keyTests{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 99, 100, 1010, 9999};
@@ -84,7 +84,7 @@ private:
   using Measurements   = std::vector<MeasurementPtr>;
 
   // Construction / Destruction
-  Registry()  = default;
+  Registry();
   ~Registry() = default;
 
   static bool ValidateName(std::string const &name);
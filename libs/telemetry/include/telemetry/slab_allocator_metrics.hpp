@@ -0,0 +1,48 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "telemetry/measurement.hpp"
+
+#include <string>
+
+namespace fetch {
+namespace telemetry {
+
+/**
+ * Exports the statistics of the buffer allocator used by all byte arrays and shared arrays. This
+ * measurement is always present in the registry.
+ */
+class SlabAllocatorMetrics : public Measurement
+{
+public:
+  // Construction / Destruction
+  SlabAllocatorMetrics();
+  SlabAllocatorMetrics(SlabAllocatorMetrics const &) = delete;
+  SlabAllocatorMetrics(SlabAllocatorMetrics &&)      = delete;
+  ~SlabAllocatorMetrics() override                   = default;
+
+  void ToStream(OutputStream &stream) const override;
+
+  // Operators
+  SlabAllocatorMetrics &operator=(SlabAllocatorMetrics const &) = delete;
+  SlabAllocatorMetrics &operator=(SlabAllocatorMetrics &&) = delete;
+};
+
+}  // namespace telemetry
+}  // namespace fetch
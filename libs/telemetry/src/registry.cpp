@@ -22,6 +22,7 @@
 #include "telemetry/histogram.hpp"
 #include "telemetry/histogram_map.hpp"
 #include "telemetry/registry.hpp"
+#include "telemetry/slab_allocator_metrics.hpp"
 
 #include <initializer_list>
 #include <memory>
@@ -43,6 +44,12 @@ Registry &Registry::Instance()
   return instance;
 }
 
+Registry::Registry()
+{
+  // process wide metrics which are always exported
+  measurements_.push_back(std::make_shared<SlabAllocatorMetrics>());
+}
+
 /**
  * Ensure the name consists of lowercase letters and underscores
  *
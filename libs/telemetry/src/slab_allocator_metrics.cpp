@@ -0,0 +1,70 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "telemetry/slab_allocator_metrics.hpp"
+#include "vectorise/memory/slab_allocator.hpp"
+
+#include <cstdint>
+#include <ostream>
+
+namespace fetch {
+namespace telemetry {
+namespace {
+
+constexpr char const *BYTES_IN_USE_NAME = "slab_allocator_bytes_in_use";
+
+}  // namespace
+
+SlabAllocatorMetrics::SlabAllocatorMetrics()
+  : Measurement("slab_allocator_operations_total", "The number of buffer allocator operations")
+{}
+
+/**
+ * Write the current allocator statistics to the stream
+ *
+ * @param stream The stream to be updated
+ */
+void SlabAllocatorMetrics::ToStream(OutputStream &stream) const
+{
+  auto const stats = memory::SlabAllocator::GetStatistics();
+
+  WriteHeader(stream, "counter");
+
+  auto const write_operation = [this, &stream](char const *operation, uint64_t value) {
+    stream << name() << "{operation=\"" << operation << "\"} " << value << '\n';
+  };
+
+  write_operation("allocate", stats.allocations);
+  write_operation("deallocate", stats.deallocations);
+  write_operation("thread_cache_hit", stats.thread_cache_hits);
+  write_operation("shared_cache_hit", stats.shared_cache_hits);
+  write_operation("system_allocate", stats.system_allocations);
+  write_operation("system_free", stats.system_deallocations);
+
+  if (stream.HeaderIsRequired(BYTES_IN_USE_NAME))
+  {
+    stream << "# HELP " << BYTES_IN_USE_NAME
+           << " The number of bytes currently allocated by the buffer allocator\n"
+           << "# TYPE " << BYTES_IN_USE_NAME << " gauge\n";
+  }
+
+  stream << BYTES_IN_USE_NAME << ' ' << stats.bytes_in_use << '\n';
+}
+
+}  // namespace telemetry
+}  // namespace fetch
@@ -0,0 +1,59 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "telemetry/slab_allocator_metrics.hpp"
+#include "vectorise/memory/shared_array.hpp"
+
+#include "gmock/gmock.h"
+
+#include <sstream>
+#include <thread>
+
+namespace {
+
+using fetch::memory::SharedArray;
+using fetch::telemetry::OutputStream;
+using fetch::telemetry::SlabAllocatorMetrics;
+
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+TEST(SlabAllocatorMetricsTests, CheckSerialisation)
+{
+  // allocator statistics are published at the latest when a thread exits
+  std::thread worker([]() {
+    SharedArray<uint8_t> array{100};
+    array[0] = 1;
+  });
+  worker.join();
+
+  SlabAllocatorMetrics metrics{};
+
+  std::ostringstream oss;
+  OutputStream       stream{oss};
+  metrics.ToStream(stream);
+
+  auto const text = oss.str();
+  EXPECT_THAT(text, HasSubstr("# TYPE slab_allocator_operations_total counter\n"));
+  EXPECT_THAT(text, HasSubstr("slab_allocator_operations_total{operation=\"allocate\"} "));
+  EXPECT_THAT(text, HasSubstr("slab_allocator_operations_total{operation=\"system_free\"} "));
+  EXPECT_THAT(text, HasSubstr("# TYPE slab_allocator_bytes_in_use gauge\n"));
+  EXPECT_THAT(text, Not(HasSubstr("slab_allocator_operations_total{operation=\"allocate\"} 0\n")));
+}
+
+}  // namespace
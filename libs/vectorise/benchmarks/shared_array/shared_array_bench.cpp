@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/memory/shared_array.hpp"
+#include "vectorise/memory/slab_allocator.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <mm_malloc.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using fetch::memory::SharedArray;
+
+// The allocation path previously used by SharedArray: an aligned allocation owned by a
+// std::shared_ptr with a separately allocated control block
+class LegacyBuffer
+{
+public:
+  explicit LegacyBuffer(std::size_t size)
+    : data_(static_cast<uint8_t *>(_mm_malloc(size, 64)), _mm_free)
+  {}
+
+  uint8_t *data()
+  {
+    return data_.get();
+  }
+
+private:
+  std::shared_ptr<uint8_t> data_;
+};
+
+class SlabBuffer
+{
+public:
+  explicit SlabBuffer(std::size_t size)
+    : data_(size)
+  {}
+
+  uint8_t *data()
+  {
+    return data_.pointer();
+  }
+
+private:
+  SharedArray<uint8_t> data_;
+};
+
+// Allocate, fill and release a buffer, as done for every serialised message
+template <typename Buffer>
+void Buffer_AllocateRelease(benchmark::State &state)
+{
+  auto const size = static_cast<std::size_t>(state.range(0));
+
+  for (auto _ : state)
+  {
+    Buffer buffer{size};
+    std::memset(buffer.data(), 0xAA, size);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// Keep a window of live buffers which are copied (shared) and released in a rolling fashion,
+// mimicking packets held in the network queues
+template <typename Buffer>
+void Buffer_RollingWindow(benchmark::State &state)
+{
+  static constexpr std::size_t WINDOW = 1024;
+
+  auto const size = static_cast<std::size_t>(state.range(0));
+
+  std::vector<Buffer> window(WINDOW, Buffer{size});
+  std::size_t         index{0};
+
+  for (auto _ : state)
+  {
+    Buffer buffer{size};
+    buffer.data()[0] = static_cast<uint8_t>(index);
+
+    Buffer shared{buffer};
+    window[index % WINDOW] = shared;
+    ++index;
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(Buffer_AllocateRelease, LegacyBuffer)->Range(16, 16384)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(Buffer_AllocateRelease, SlabBuffer)->Range(16, 16384)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(Buffer_RollingWindow, LegacyBuffer)->Range(16, 16384)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(Buffer_RollingWindow, SlabBuffer)->Range(16, 16384)->ThreadRange(1, 8);
+
+BENCHMARK_MAIN();
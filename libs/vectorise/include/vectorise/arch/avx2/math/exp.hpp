@@ -0,0 +1,441 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/arch/avx2/register_fixed32.hpp"
+#include "vectorise/arch/avx2/register_fixed64.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+#include <cstdint>
+#include <immintrin.h>
+#include <limits>
+
+/**
+ * Exp, and TanH and Sigmoid that are computed from it, for fixed point registers.
+ *
+ * These follow the scalar FixedPoint implementations step by step, so that every lane is bit-exact
+ * with the scalar result and fp_state is raised with the same flags. The integer divisions of the
+ * scalar code are done in double precision, where the operands are small enough for the quotient
+ * to be exact (32-bit) or to be off by at most one and corrected with the remainder (64-bit).
+ */
+
+namespace fetch {
+namespace vectorise {
+namespace details {
+
+/**
+ * Truncated quotient (n * scale) / d, for non-negative 32-bit lanes n and positive d, small
+ * enough for n * scale and the quotient to be exact in double precision
+ */
+inline __m256i TruncatedQuotient32(__m256i const &n, __m256i const &d, double scale)
+{
+  __m256d s  = _mm256_set1_pd(scale);
+  __m256d lo = _mm256_div_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(n)), s),
+                             _mm256_cvtepi32_pd(_mm256_castsi256_si128(d)));
+  __m256d hi = _mm256_div_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(n, 1)), s),
+                             _mm256_cvtepi32_pd(_mm256_extracti128_si256(d, 1)));
+  return _mm256_set_m128i(_mm256_cvttpd_epi32(hi), _mm256_cvttpd_epi32(lo));
+}
+
+/**
+ * Converts non-negative 64-bit lanes to double, each 32-bit half is placed in the mantissa of 2^52
+ */
+inline __m256d ToDouble64(__m256i const &x)
+{
+  __m256i magic = _mm256_set1_epi64x(0x4330000000000000);
+  __m256d two52 = _mm256_set1_pd(4503599627370496.0);
+
+  __m256i low_bits  = _mm256_and_si256(x, _mm256_set1_epi64x(0xFFFFFFFF));
+  __m256i high_bits = _mm256_srli_epi64(x, 32);
+  __m256d lo        = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(low_bits, magic)), two52);
+  __m256d hi        = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(high_bits, magic)), two52);
+
+  return _mm256_add_pd(_mm256_mul_pd(hi, _mm256_set1_pd(4294967296.0)), lo);
+}
+
+/**
+ * Converts non-negative doubles holding integers below 2^52 to 64-bit lanes
+ */
+inline __m256i ToInt64(__m256d const &x)
+{
+  __m256d two52 = _mm256_set1_pd(4503599627370496.0);
+  return _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(x, two52)),
+                          _mm256_castpd_si256(two52));
+}
+
+/**
+ * Lower 64 bits of the products of 64-bit lanes
+ */
+inline __m256i MultiplyLow64(__m256i const &a, __m256i const &b)
+{
+  __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                   _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+  return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(cross, 32));
+}
+
+/**
+ * Quotient (n << 32) / d of the 64-bit fixed point division, for non-negative n, positive d and
+ * quotients below 2^52. The double precision estimate is biased to be at most one too small, and
+ * is then corrected using the remainder, which lies in [0, 2d)
+ */
+inline __m256i ShiftedQuotient64(__m256i const &n, __m256i const &d)
+{
+  __m256d estimate = _mm256_div_pd(_mm256_mul_pd(ToDouble64(n), _mm256_set1_pd(4294967296.0)),
+                                   ToDouble64(d));
+  estimate         = _mm256_max_pd(_mm256_sub_pd(estimate, _mm256_set1_pd(1.0 / 1024.0)),
+                           _mm256_setzero_pd());
+  __m256i q = ToInt64(_mm256_round_pd(estimate, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+
+  // the remainder may not fit in a signed 64-bit integer, so it is compared unsigned
+  __m256i sign_bit  = _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+  __m256i remainder = _mm256_sub_epi64(_mm256_slli_epi64(n, 32), MultiplyLow64(q, d));
+  __m256i mask_below =
+      _mm256_cmpgt_epi64(_mm256_xor_si256(d, sign_bit), _mm256_xor_si256(remainder, sign_bit));
+
+  // q + 1, unless the remainder is below d
+  return _mm256_add_epi64(_mm256_add_epi64(q, _mm256_set1_epi64x(1)), mask_below);
+}
+
+/**
+ * Signed quotient n / d of the 64-bit fixed point division, for positive d and |n| <= d
+ */
+inline __m256i BoundedQuotient64(__m256i const &n, __m256i const &d)
+{
+  __m256i zero          = _mm256_setzero_si256();
+  __m256i mask_negative = _mm256_cmpgt_epi64(zero, n);
+  __m256i q = ShiftedQuotient64(_mm256_blendv_epi8(n, _mm256_sub_epi64(zero, n), mask_negative), d);
+  return _mm256_blendv_epi8(q, _mm256_sub_epi64(zero, q), mask_negative);
+}
+
+}  // namespace details
+
+inline VectorRegister<fixed_point::fp32_t, 256> Exp(
+    VectorRegister<fixed_point::fp32_t, 256> const &x)
+{
+  using Type = fixed_point::fp32_t;
+
+  __m256i zero = _mm256_setzero_si256();
+  __m256i one  = _mm256_set1_epi32(Type::_1.Data());
+  __m256i max  = _mm256_set1_epi32(Type::MAX);
+  __m256i ln2  = _mm256_set1_epi32(Type::CONST_LN2.Data());
+
+  // Special values, in the order the scalar implementation checks them
+  __m256i mask_nan = _mm256_cmpeq_epi32(x.data(), _mm256_set1_epi32(Type::NaN.Data()));
+  __m256i mask_pos_inf =
+      _mm256_cmpeq_epi32(x.data(), _mm256_set1_epi32(Type::POSITIVE_INFINITY.Data()));
+  __m256i mask_zero      = _mm256_cmpeq_epi32(x.data(), zero);
+  __m256i mask_underflow = _mm256_or_si256(
+      _mm256_cmpeq_epi32(x.data(), _mm256_set1_epi32(Type::NEGATIVE_INFINITY.Data())),
+      _mm256_cmpgt_epi32(_mm256_set1_epi32(Type::MIN_EXP.Data()), x.data()));
+  __m256i mask_overflow = _mm256_andnot_si256(
+      mask_pos_inf, _mm256_cmpgt_epi32(x.data(), _mm256_set1_epi32(Type::MAX_EXP.Data())));
+  __m256i mask_negative = _mm256_cmpgt_epi32(zero, x.data());
+  __m256i mask_special =
+      _mm256_or_si256(_mm256_or_si256(mask_nan, mask_pos_inf),
+                      _mm256_or_si256(mask_zero, _mm256_or_si256(mask_underflow, mask_overflow)));
+
+  // The remaining lanes are evaluated at |x|, as e^x = 1 / e^-x for negative x
+  __m256i a = _mm256_andnot_si256(mask_special, _mm256_abs_epi32(x.data()));
+
+  // Find integer k and r in [0, ln2) such as: |x| = k*ln2 + r, then exp(|x|) = 2^k * e^r
+  __m256i k = details::TruncatedQuotient32(a, ln2, 1.0);
+  __m256i r = _mm256_sub_epi32(a, _mm256_mullo_epi32(k, ln2));
+
+  // All the products are non-negative and below 2^31
+  __m256i r2 = _mm256_srli_epi32(_mm256_mullo_epi32(r, r), Type::FRACTIONAL_BITS);
+  __m256i r3 = _mm256_srli_epi32(_mm256_mullo_epi32(r2, r), Type::FRACTIONAL_BITS);
+  __m256i r4 = _mm256_srli_epi32(_mm256_mullo_epi32(r3, r), Type::FRACTIONAL_BITS);
+  __m256i r5 = _mm256_srli_epi32(_mm256_mullo_epi32(r4, r), Type::FRACTIONAL_BITS);
+
+  __m256i p1 = _mm256_set1_epi32(static_cast<Type>(fixed_point::Exp_P01).Data());
+  __m256i p2 = _mm256_set1_epi32(static_cast<Type>(fixed_point::Exp_P02).Data());
+  __m256i p3 = _mm256_set1_epi32(static_cast<Type>(fixed_point::Exp_P03).Data());
+  __m256i p4 = _mm256_set1_epi32(static_cast<Type>(fixed_point::Exp_P04).Data());
+  __m256i p5 = _mm256_set1_epi32(static_cast<Type>(fixed_point::Exp_P05).Data());
+
+  r  = _mm256_srli_epi32(_mm256_mullo_epi32(r, p1), Type::FRACTIONAL_BITS);
+  r2 = _mm256_srli_epi32(_mm256_mullo_epi32(r2, p2), Type::FRACTIONAL_BITS);
+  r3 = _mm256_srli_epi32(_mm256_mullo_epi32(r3, p3), Type::FRACTIONAL_BITS);
+  r4 = _mm256_srli_epi32(_mm256_mullo_epi32(r4, p4), Type::FRACTIONAL_BITS);
+  r5 = _mm256_srli_epi32(_mm256_mullo_epi32(r5, p5), Type::FRACTIONAL_BITS);
+
+  __m256i even = _mm256_add_epi32(_mm256_add_epi32(one, r2), r4);
+  __m256i odd  = _mm256_add_epi32(_mm256_add_epi32(r, r3), r5);
+  __m256i e    = details::TruncatedQuotient32(_mm256_add_epi32(even, odd),
+                                           _mm256_sub_epi32(even, odd),
+                                           static_cast<double>(Type::ONE_MASK));
+
+  // e1 * e2 = e2 << k, which saturates at FP_MAX
+  __m256i mask_saturated =
+      _mm256_andnot_si256(mask_special, _mm256_cmpgt_epi32(e, _mm256_srlv_epi32(max, k)));
+  e = _mm256_blendv_epi8(_mm256_sllv_epi32(e, k), max, mask_saturated);
+
+  // e^1 is exactly CONST_E
+  __m256i mask_e = _mm256_cmpeq_epi32(a, one);
+  mask_saturated = _mm256_andnot_si256(mask_e, mask_saturated);
+  e              = _mm256_blendv_epi8(e, _mm256_set1_epi32(Type::CONST_E.Data()), mask_e);
+
+  __m256i ret = _mm256_blendv_epi8(
+      e, details::TruncatedQuotient32(one, e, static_cast<double>(Type::ONE_MASK)), mask_negative);
+  ret = _mm256_blendv_epi8(ret, max, mask_overflow);
+  ret = _mm256_blendv_epi8(ret, zero, mask_underflow);
+  ret = _mm256_blendv_epi8(ret, one, mask_zero);
+  ret = _mm256_blendv_epi8(ret, _mm256_set1_epi32(Type::POSITIVE_INFINITY.Data()), mask_pos_inf);
+  ret = _mm256_blendv_epi8(ret, _mm256_set1_epi32(Type::NaN.Data()), mask_nan);
+
+  bool is_nan      = _mm256_movemask_epi8(mask_nan) != 0;
+  bool is_infinity = _mm256_movemask_epi8(mask_pos_inf) != 0;
+  bool is_overflow = _mm256_movemask_epi8(_mm256_or_si256(mask_overflow, mask_saturated)) != 0;
+  Type::fp_state |= Type::STATE_NAN * static_cast<uint32_t>(is_nan);
+  Type::fp_state |= Type::STATE_INFINITY * static_cast<uint32_t>(is_infinity);
+  Type::fp_state |= Type::STATE_OVERFLOW * static_cast<uint32_t>(is_overflow);
+
+  return {ret};
+}
+
+inline VectorRegister<fixed_point::fp64_t, 256> Exp(
+    VectorRegister<fixed_point::fp64_t, 256> const &x)
+{
+  using Type = fixed_point::fp64_t;
+
+  __m256i zero = _mm256_setzero_si256();
+  __m256i one  = _mm256_set1_epi64x(Type::_1.Data());
+  __m256i max  = _mm256_set1_epi64x(Type::MAX);
+  __m256i ln2  = _mm256_set1_epi64x(Type::CONST_LN2.Data());
+
+  // Special values, in the order the scalar implementation checks them
+  __m256i mask_nan = _mm256_cmpeq_epi64(x.data(), _mm256_set1_epi64x(Type::NaN.Data()));
+  __m256i mask_pos_inf =
+      _mm256_cmpeq_epi64(x.data(), _mm256_set1_epi64x(Type::POSITIVE_INFINITY.Data()));
+  __m256i mask_zero      = _mm256_cmpeq_epi64(x.data(), zero);
+  __m256i mask_underflow = _mm256_or_si256(
+      _mm256_cmpeq_epi64(x.data(), _mm256_set1_epi64x(Type::NEGATIVE_INFINITY.Data())),
+      _mm256_cmpgt_epi64(_mm256_set1_epi64x(Type::MIN_EXP.Data()), x.data()));
+  __m256i mask_overflow = _mm256_andnot_si256(
+      mask_pos_inf, _mm256_cmpgt_epi64(x.data(), _mm256_set1_epi64x(Type::MAX_EXP.Data())));
+  __m256i mask_negative = _mm256_cmpgt_epi64(zero, x.data());
+  __m256i mask_special =
+      _mm256_or_si256(_mm256_or_si256(mask_nan, mask_pos_inf),
+                      _mm256_or_si256(mask_zero, _mm256_or_si256(mask_underflow, mask_overflow)));
+
+  // The remaining lanes are evaluated at |x|, as e^x = 1 / e^-x for negative x
+  __m256i a = _mm256_blendv_epi8(x.data(), _mm256_sub_epi64(zero, x.data()), mask_negative);
+  a         = _mm256_andnot_si256(mask_special, a);
+
+  // Find integer k and r in [0, ln2) such as: |x| = k*ln2 + r, then exp(|x|) = 2^k * e^r. |x| is
+  // below 2^37, so the quotient is exact in double precision
+  __m256d quotient = _mm256_div_pd(details::ToDouble64(a), details::ToDouble64(ln2));
+  quotient         = _mm256_round_pd(quotient, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+  __m256i k        = details::ToInt64(quotient);
+  __m256i r        = _mm256_sub_epi64(a, _mm256_mul_epu32(k, ln2));
+
+  // r and its powers are below 2^32, so the products are unsigned 32-bit multiplications
+  __m256i r2 = _mm256_srli_epi64(_mm256_mul_epu32(r, r), Type::FRACTIONAL_BITS);
+  __m256i r3 = _mm256_srli_epi64(_mm256_mul_epu32(r2, r), Type::FRACTIONAL_BITS);
+  __m256i r4 = _mm256_srli_epi64(_mm256_mul_epu32(r3, r), Type::FRACTIONAL_BITS);
+  __m256i r5 = _mm256_srli_epi64(_mm256_mul_epu32(r4, r), Type::FRACTIONAL_BITS);
+
+  __m256i p1 = _mm256_set1_epi64x(static_cast<Type>(fixed_point::Exp_P01).Data());
+  __m256i p2 = _mm256_set1_epi64x(static_cast<Type>(fixed_point::Exp_P02).Data());
+  __m256i p3 = _mm256_set1_epi64x(static_cast<Type>(fixed_point::Exp_P03).Data());
+  __m256i p4 = _mm256_set1_epi64x(static_cast<Type>(fixed_point::Exp_P04).Data());
+  __m256i p5 = _mm256_set1_epi64x(static_cast<Type>(fixed_point::Exp_P05).Data());
+
+  r  = _mm256_srli_epi64(_mm256_mul_epu32(r, p1), Type::FRACTIONAL_BITS);
+  r2 = _mm256_srli_epi64(_mm256_mul_epu32(r2, p2), Type::FRACTIONAL_BITS);
+  r3 = _mm256_srli_epi64(_mm256_mul_epu32(r3, p3), Type::FRACTIONAL_BITS);
+  r4 = _mm256_srli_epi64(_mm256_mul_epu32(r4, p4), Type::FRACTIONAL_BITS);
+  r5 = _mm256_srli_epi64(_mm256_mul_epu32(r5, p5), Type::FRACTIONAL_BITS);
+
+  __m256i even = _mm256_add_epi64(_mm256_add_epi64(one, r2), r4);
+  __m256i odd  = _mm256_add_epi64(_mm256_add_epi64(r, r3), r5);
+  __m256i e =
+      details::ShiftedQuotient64(_mm256_add_epi64(even, odd), _mm256_sub_epi64(even, odd));
+
+  // e1 * e2 = e2 << k, which saturates at FP_MAX
+  __m256i mask_saturated =
+      _mm256_andnot_si256(mask_special, _mm256_cmpgt_epi64(e, _mm256_srlv_epi64(max, k)));
+  e = _mm256_blendv_epi8(_mm256_sllv_epi64(e, k), max, mask_saturated);
+
+  // e^1 is exactly CONST_E
+  __m256i mask_e = _mm256_cmpeq_epi64(a, one);
+  mask_saturated = _mm256_andnot_si256(mask_e, mask_saturated);
+  e              = _mm256_blendv_epi8(e, _mm256_set1_epi64x(Type::CONST_E.Data()), mask_e);
+
+  __m256i ret = _mm256_blendv_epi8(e, details::ShiftedQuotient64(one, e), mask_negative);
+  ret         = _mm256_blendv_epi8(ret, max, mask_overflow);
+  ret         = _mm256_blendv_epi8(ret, zero, mask_underflow);
+  ret         = _mm256_blendv_epi8(ret, one, mask_zero);
+  ret = _mm256_blendv_epi8(ret, _mm256_set1_epi64x(Type::POSITIVE_INFINITY.Data()), mask_pos_inf);
+  ret = _mm256_blendv_epi8(ret, _mm256_set1_epi64x(Type::NaN.Data()), mask_nan);
+
+  bool is_nan      = _mm256_movemask_epi8(mask_nan) != 0;
+  bool is_infinity = _mm256_movemask_epi8(mask_pos_inf) != 0;
+  bool is_overflow = _mm256_movemask_epi8(_mm256_or_si256(mask_overflow, mask_saturated)) != 0;
+  Type::fp_state |= Type::STATE_NAN * static_cast<uint32_t>(is_nan);
+  Type::fp_state |= Type::STATE_INFINITY * static_cast<uint32_t>(is_infinity);
+  Type::fp_state |= Type::STATE_OVERFLOW * static_cast<uint32_t>(is_overflow);
+
+  return {ret};
+}
+
+inline VectorRegister<fixed_point::fp32_t, 256> TanH(
+    VectorRegister<fixed_point::fp32_t, 256> const &x)
+{
+  using Type               = fixed_point::fp32_t;
+  using VectorRegisterType = VectorRegister<Type, 256>;
+
+  __m256i mask_nan = _mm256_cmpeq_epi32(x.data(), _mm256_set1_epi32(Type::NaN.Data()));
+  __m256i mask_pos_inf =
+      _mm256_cmpeq_epi32(x.data(), _mm256_set1_epi32(Type::POSITIVE_INFINITY.Data()));
+  __m256i mask_neg_inf =
+      _mm256_cmpeq_epi32(x.data(), _mm256_set1_epi32(Type::NEGATIVE_INFINITY.Data()));
+  __m256i mask_special = _mm256_or_si256(mask_nan, _mm256_or_si256(mask_pos_inf, mask_neg_inf));
+
+  // the special lanes are evaluated at zero, so that they raise no flags of their own
+  VectorRegisterType y(_mm256_andnot_si256(mask_special, x.data()));
+  VectorRegisterType e1 = Exp(y);
+  VectorRegisterType e2 = Exp(-y);
+
+  __m256i ret = ((e1 - e2) / (e1 + e2)).data();
+  ret = _mm256_blendv_epi8(ret, _mm256_set1_epi32(Type::POSITIVE_INFINITY.Data()), mask_pos_inf);
+  ret = _mm256_blendv_epi8(ret, _mm256_set1_epi32(Type::NEGATIVE_INFINITY.Data()), mask_neg_inf);
+  ret = _mm256_blendv_epi8(ret, _mm256_set1_epi32(Type::NaN.Data()), mask_nan);
+
+  bool is_nan      = _mm256_movemask_epi8(mask_nan) != 0;
+  bool is_infinity = _mm256_movemask_epi8(_mm256_or_si256(mask_pos_inf, mask_neg_inf)) != 0;
+  Type::fp_state |= Type::STATE_NAN * static_cast<uint32_t>(is_nan);
+  Type::fp_state |= Type::STATE_INFINITY * static_cast<uint32_t>(is_infinity);
+
+  return {ret};
+}
+
+inline VectorRegister<fixed_point::fp64_t, 256> TanH(
+    VectorRegister<fixed_point::fp64_t, 256> const &x)
+{
+  using Type               = fixed_point::fp64_t;
+  using VectorRegisterType = VectorRegister<Type, 256>;
+
+  __m256i mask_nan = _mm256_cmpeq_epi64(x.data(), _mm256_set1_epi64x(Type::NaN.Data()));
+  __m256i mask_pos_inf =
+      _mm256_cmpeq_epi64(x.data(), _mm256_set1_epi64x(Type::POSITIVE_INFINITY.Data()));
+  __m256i mask_neg_inf =
+      _mm256_cmpeq_epi64(x.data(), _mm256_set1_epi64x(Type::NEGATIVE_INFINITY.Data()));
+  __m256i mask_special = _mm256_or_si256(mask_nan, _mm256_or_si256(mask_pos_inf, mask_neg_inf));
+
+  // the special lanes are evaluated at zero, so that they raise no flags of their own
+  VectorRegisterType y(_mm256_andnot_si256(mask_special, x.data()));
+  VectorRegisterType e1 = Exp(y);
+  VectorRegisterType e2 = Exp(-y);
+
+  // |e1 - e2| <= e1 + e2, even when the sum saturates
+  __m256i ret = details::BoundedQuotient64((e1 - e2).data(), (e1 + e2).data());
+  ret = _mm256_blendv_epi8(ret, _mm256_set1_epi64x(Type::POSITIVE_INFINITY.Data()), mask_pos_inf);
+  ret = _mm256_blendv_epi8(ret, _mm256_set1_epi64x(Type::NEGATIVE_INFINITY.Data()), mask_neg_inf);
+  ret = _mm256_blendv_epi8(ret, _mm256_set1_epi64x(Type::NaN.Data()), mask_nan);
+
+  bool is_nan      = _mm256_movemask_epi8(mask_nan) != 0;
+  bool is_infinity = _mm256_movemask_epi8(_mm256_or_si256(mask_pos_inf, mask_neg_inf)) != 0;
+  Type::fp_state |= Type::STATE_NAN * static_cast<uint32_t>(is_nan);
+  Type::fp_state |= Type::STATE_INFINITY * static_cast<uint32_t>(is_infinity);
+
+  return {ret};
+}
+
+/**
+ * The numerically stable sigmoid, 1 / (1 + e^-x) for x >= 0 and e^x / (e^x + 1) otherwise, as
+ * computed by math::Sigmoid
+ */
+inline VectorRegister<fixed_point::fp32_t, 256> Sigmoid(
+    VectorRegister<fixed_point::fp32_t, 256> const &x)
+{
+  using Type               = fixed_point::fp32_t;
+  using VectorRegisterType = VectorRegister<Type, 256>;
+
+  __m256i zero     = _mm256_setzero_si256();
+  __m256i one      = _mm256_set1_epi32(Type::_1.Data());
+  __m256i mask_nan = _mm256_cmpeq_epi32(x.data(), _mm256_set1_epi32(Type::NaN.Data()));
+  __m256i mask_pos_inf =
+      _mm256_cmpeq_epi32(x.data(), _mm256_set1_epi32(Type::POSITIVE_INFINITY.Data()));
+  __m256i mask_neg_inf =
+      _mm256_cmpeq_epi32(x.data(), _mm256_set1_epi32(Type::NEGATIVE_INFINITY.Data()));
+  __m256i mask_special = _mm256_or_si256(mask_nan, _mm256_or_si256(mask_pos_inf, mask_neg_inf));
+
+  // the special lanes are evaluated at zero, so that they raise no flags of their own
+  __m256i            y = _mm256_andnot_si256(mask_special, x.data());
+  VectorRegisterType e = Exp(VectorRegisterType(_mm256_sub_epi32(zero, _mm256_abs_epi32(y))));
+
+  VectorRegisterType numerator(_mm256_blendv_epi8(one, e.data(), _mm256_cmpgt_epi32(zero, y)));
+  __m256i            ret = (numerator / (e + VectorRegisterType(one))).data();
+
+  // sigmoid(+inf) = 1, sigmoid(-inf) = 0
+  ret = _mm256_blendv_epi8(ret, one, mask_pos_inf);
+  ret = _mm256_blendv_epi8(ret, zero, mask_neg_inf);
+  ret = _mm256_blendv_epi8(ret, _mm256_set1_epi32(Type::NaN.Data()), mask_nan);
+
+  // the scalar implementation raises the infinity flag when negating +inf
+  bool is_nan      = _mm256_movemask_epi8(mask_nan) != 0;
+  bool is_infinity = _mm256_movemask_epi8(mask_pos_inf) != 0;
+  Type::fp_state |= Type::STATE_NAN * static_cast<uint32_t>(is_nan);
+  Type::fp_state |= Type::STATE_INFINITY * static_cast<uint32_t>(is_infinity);
+
+  return {ret};
+}
+
+inline VectorRegister<fixed_point::fp64_t, 256> Sigmoid(
+    VectorRegister<fixed_point::fp64_t, 256> const &x)
+{
+  using Type               = fixed_point::fp64_t;
+  using VectorRegisterType = VectorRegister<Type, 256>;
+
+  __m256i zero     = _mm256_setzero_si256();
+  __m256i one      = _mm256_set1_epi64x(Type::_1.Data());
+  __m256i mask_nan = _mm256_cmpeq_epi64(x.data(), _mm256_set1_epi64x(Type::NaN.Data()));
+  __m256i mask_pos_inf =
+      _mm256_cmpeq_epi64(x.data(), _mm256_set1_epi64x(Type::POSITIVE_INFINITY.Data()));
+  __m256i mask_neg_inf =
+      _mm256_cmpeq_epi64(x.data(), _mm256_set1_epi64x(Type::NEGATIVE_INFINITY.Data()));
+  __m256i mask_special = _mm256_or_si256(mask_nan, _mm256_or_si256(mask_pos_inf, mask_neg_inf));
+
+  // the special lanes are evaluated at zero, so that they raise no flags of their own
+  __m256i y             = _mm256_andnot_si256(mask_special, x.data());
+  __m256i mask_negative = _mm256_cmpgt_epi64(zero, y);
+  __m256i minus_abs_y   = _mm256_blendv_epi8(_mm256_sub_epi64(zero, y), y, mask_negative);
+
+  VectorRegisterType e = Exp(VectorRegisterType(minus_abs_y));
+
+  // the numerator is at most the denominator, which is at least one
+  __m256i numerator = _mm256_blendv_epi8(one, e.data(), mask_negative);
+  __m256i ret = details::ShiftedQuotient64(numerator, (e + VectorRegisterType(one)).data());
+
+  // sigmoid(+inf) = 1, sigmoid(-inf) = 0
+  ret = _mm256_blendv_epi8(ret, one, mask_pos_inf);
+  ret = _mm256_blendv_epi8(ret, zero, mask_neg_inf);
+  ret = _mm256_blendv_epi8(ret, _mm256_set1_epi64x(Type::NaN.Data()), mask_nan);
+
+  // the scalar implementation raises the infinity flag when negating +inf
+  bool is_nan      = _mm256_movemask_epi8(mask_nan) != 0;
+  bool is_infinity = _mm256_movemask_epi8(mask_pos_inf) != 0;
+  Type::fp_state |= Type::STATE_NAN * static_cast<uint32_t>(is_nan);
+  Type::fp_state |= Type::STATE_INFINITY * static_cast<uint32_t>(is_infinity);
+
+  return {ret};
+}
+
+}  // namespace vectorise
+}  // namespace fetch
@@ -0,0 +1,102 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+/**
+ * Dot products of int8 vectors with int32 accumulation.
+ *
+ * _mm256_maddubs_epi16 multiplies unsigned bytes with signed bytes, so the sign of the first
+ * operand is moved onto the second. The pairwise sums of the products fit in 16 bits as long as no
+ * element is -128, which is why quantised values are kept in [-127, 127].
+ */
+
+namespace fetch {
+namespace vectorise {
+namespace details {
+
+/// sums of the products of 32 pairs of int8 lanes, in 8 int32 lanes
+inline __m256i Int8MultiplyAdd(__m256i const &a, __m256i const &b)
+{
+  __m256i const products = _mm256_maddubs_epi16(_mm256_sign_epi8(a, a), _mm256_sign_epi8(b, a));
+  return _mm256_madd_epi16(products, _mm256_set1_epi16(1));
+}
+
+inline int32_t HorizontalSum(__m256i const &x)
+{
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
+  sum         = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum         = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(sum);
+}
+
+inline __m256i Load(int8_t const *x)
+{
+  return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(x));
+}
+
+}  // namespace details
+
+/**
+ * The dot product of a and b, of which the length is a multiple of 32
+ */
+inline int32_t Int8DotProductAVX2(int8_t const *a, int8_t const *b, std::size_t n)
+{
+  __m256i sum = _mm256_setzero_si256();
+  for (std::size_t k = 0; k < n; k += 32)
+  {
+    __m256i const products = details::Int8MultiplyAdd(details::Load(a + k), details::Load(b + k));
+    sum                    = _mm256_add_epi32(sum, products);
+  }
+
+  return details::HorizontalSum(sum);
+}
+
+/**
+ * The dot products of four rows of a, stride apart, with b, of which the length is a multiple of
+ * 32. Each load of b is shared between the four rows.
+ */
+inline void Int8DotProduct4AVX2(int8_t const *a, std::size_t stride, int8_t const *b,
+                                std::size_t n, int32_t *ret)
+{
+  __m256i sum0 = _mm256_setzero_si256();
+  __m256i sum1 = _mm256_setzero_si256();
+  __m256i sum2 = _mm256_setzero_si256();
+  __m256i sum3 = _mm256_setzero_si256();
+
+  for (std::size_t k = 0; k < n; k += 32)
+  {
+    __m256i const x = details::Load(b + k);
+
+    sum0 = _mm256_add_epi32(sum0, details::Int8MultiplyAdd(details::Load(a + k), x));
+    sum1 = _mm256_add_epi32(sum1, details::Int8MultiplyAdd(details::Load(a + stride + k), x));
+    sum2 = _mm256_add_epi32(sum2, details::Int8MultiplyAdd(details::Load(a + 2 * stride + k), x));
+    sum3 = _mm256_add_epi32(sum3, details::Int8MultiplyAdd(details::Load(a + 3 * stride + k), x));
+  }
+
+  ret[0] = details::HorizontalSum(sum0);
+  ret[1] = details::HorizontalSum(sum1);
+  ret[2] = details::HorizontalSum(sum2);
+  ret[3] = details::HorizontalSum(sum3);
+}
+
+}  // namespace vectorise
+}  // namespace fetch
@@ -611,14 +611,18 @@ inline VectorRegister<fixed_point::fp32_t, 128> operator*(
   __m256i vb      = _mm256_cvtepi32_epi64(b.data());
   __m256i prod256 = _mm256_mul_epi32(va, vb);
 
+  // shift the products right by 16-bits, there is no arithmetic shift for 64-bit elements so the
+  // sign bits are filled in separately
+  __m256i sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), prod256);
+  prod256      = _mm256_or_si256(_mm256_srli_epi64(prod256, 16), _mm256_slli_epi64(sign, 48));
+
   // compute mask of elements larger than FP_MAX and smaller than FP_MIN
   __m256i max      = _mm256_set1_epi64x(fixed_point::fp32_t::MAX);
   __m256i min      = _mm256_set1_epi64x(fixed_point::fp32_t::MIN);
   __m256i mask_max = _mm256_cmpgt_epi64(prod256, max);
   __m256i mask_min = _mm256_cmpgt_epi64(min, prod256);
 
-  // shift the products right by 16-bits, keep only the lower 32-bits
-  prod256 = _mm256_srli_epi64(prod256, 16);
+  // keep only the lower 32-bits
   prod256 = _mm256_blendv_epi8(prod256, max, mask_max);
   prod256 = _mm256_blendv_epi8(prod256, min, mask_min);
 
@@ -711,21 +715,99 @@ inline VectorRegister<fixed_point::fp32_t, 128> operator/(
     VectorRegister<fixed_point::fp32_t, 128> const &a,
     VectorRegister<fixed_point::fp32_t, 128> const &b)
 {
-  // TODO(private 440): AVX implementation required
-  alignas(VectorRegister<fixed_point::fp32_t, 128>::E_REGISTER_SIZE) fixed_point::fp32_t d1[4];
-  a.Store(d1);
-
-  alignas(VectorRegister<fixed_point::fp32_t, 128>::E_REGISTER_SIZE) fixed_point::fp32_t d2[4];
-  b.Store(d2);
-
-  alignas(VectorRegister<fixed_point::fp32_t, 128>::E_REGISTER_SIZE) fixed_point::fp32_t ret[4];
-
-  // don't divide by zero
-  // set each of the 4 values in the vector register to either the solution of the division or 0
-  ret[0] = d1[0] / d2[0];
-  ret[1] = d1[1] / d2[1];
-  ret[2] = d1[2] / d2[2];
-  ret[3] = d1[3] / d2[3];
+  __m128i zero     = _mm_setzero_si128();
+  __m128i nan      = _mm_set1_epi32(fixed_point::fp32_t::NaN.Data());
+  __m128i pos_inf  = _mm_set1_epi32(fixed_point::fp32_t::POSITIVE_INFINITY.Data());
+  __m128i neg_inf  = _mm_set1_epi32(fixed_point::fp32_t::NEGATIVE_INFINITY.Data());
+  __m128i max      = _mm_set1_epi32(fixed_point::fp32_t::MAX);
+  __m128i min      = _mm_set1_epi32(fixed_point::fp32_t::MIN);
+  __m128i all_bits = _mm_cmpeq_epi32(zero, zero);
+
+  // The numerator |a| << 16 needs at most 48 bits, so the quotient is computed exactly in double
+  // precision and truncated towards zero, as the integer division of the scalar implementation
+  __m256d one_mask    = _mm256_set1_pd(static_cast<double>(fixed_point::fp32_t::ONE_MASK));
+  __m256d numerator   = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm_abs_epi32(a.data())), one_mask);
+  __m256d denominator = _mm256_cvtepi32_pd(b.data());
+  __m256d quotient    = _mm256_round_pd(_mm256_div_pd(numerator, denominator),
+                                     _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+
+  // The quotient fits in 52 bits, adding 1.5 * 2^52 leaves it in the lower bits of the mantissa,
+  // from where the lower 32-bits are kept
+  quotient        = _mm256_add_pd(quotient, _mm256_set1_pd(6755399441055744.0));
+  __m256i posmask = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+  __m128i q       = _mm256_extractf128_si256(
+      _mm256_permutevar8x32_epi32(_mm256_castpd_si256(quotient), posmask), 0);
+
+  // The result is sign(a) * q, which saturates or becomes infinity/NaN as a multiplication would
+  __m128i a_pos       = _mm_cmpgt_epi32(a.data(), zero);
+  __m128i a_neg       = _mm_cmpgt_epi32(zero, a.data());
+  __m128i q_nan       = _mm_cmpeq_epi32(q, nan);
+  __m128i q_pos_inf   = _mm_cmpeq_epi32(q, pos_inf);
+  __m128i q_neg_inf   = _mm_cmpeq_epi32(q, neg_inf);
+  __m128i q_above_max = _mm_cmpgt_epi32(q, max);
+  __m128i q_below_min = _mm_andnot_si128(_mm_or_si128(q_nan, q_neg_inf), _mm_cmpgt_epi32(min, q));
+  q_above_max         = _mm_andnot_si128(q_pos_inf, q_above_max);
+
+  __m128i mask_max =
+      _mm_or_si128(_mm_and_si128(a_pos, q_above_max), _mm_and_si128(a_neg, q_below_min));
+  __m128i mask_min =
+      _mm_or_si128(_mm_and_si128(a_pos, q_below_min), _mm_and_si128(a_neg, q_above_max));
+  __m128i mask_q_pos_inf =
+      _mm_or_si128(_mm_and_si128(a_pos, q_pos_inf), _mm_and_si128(a_neg, q_neg_inf));
+  __m128i mask_q_neg_inf =
+      _mm_or_si128(_mm_and_si128(a_pos, q_neg_inf), _mm_and_si128(a_neg, q_pos_inf));
+
+  __m128i ret = _mm_sign_epi32(q, a.data());
+  ret         = _mm_blendv_epi8(ret, max, mask_max);
+  ret         = _mm_blendv_epi8(ret, min, mask_min);
+  ret         = _mm_blendv_epi8(ret, pos_inf, mask_q_pos_inf);
+  ret         = _mm_blendv_epi8(ret, neg_inf, mask_q_neg_inf);
+  ret         = _mm_blendv_epi8(ret, nan, q_nan);
+
+  // Special values of the operands, in the order the scalar implementation checks them: NaN
+  // operands, division by zero, then infinite numerators
+  __m128i a_zero    = _mm_cmpeq_epi32(a.data(), zero);
+  __m128i b_zero    = _mm_cmpeq_epi32(b.data(), zero);
+  __m128i a_pos_inf = _mm_cmpeq_epi32(a.data(), pos_inf);
+  __m128i a_neg_inf = _mm_cmpeq_epi32(a.data(), neg_inf);
+  __m128i a_inf     = _mm_or_si128(a_pos_inf, a_neg_inf);
+  __m128i b_pos_inf = _mm_cmpeq_epi32(b.data(), pos_inf);
+  __m128i b_neg_inf = _mm_cmpeq_epi32(b.data(), neg_inf);
+  __m128i b_inf     = _mm_or_si128(b_pos_inf, b_neg_inf);
+  __m128i b_pos     = _mm_cmpgt_epi32(b.data(), zero);
+
+  __m128i mask_nan_in =
+      _mm_or_si128(_mm_cmpeq_epi32(a.data(), nan), _mm_cmpeq_epi32(b.data(), nan));
+  __m128i mask_div0    = _mm_andnot_si128(mask_nan_in, b_zero);
+  __m128i mask_special = _mm_or_si128(mask_nan_in, mask_div0);
+  __m128i mask_inf_num = _mm_andnot_si128(mask_special, a_inf);
+  __m128i mask_inf_inf = _mm_and_si128(mask_inf_num, b_inf);
+  mask_inf_num         = _mm_andnot_si128(b_inf, mask_inf_num);
+  __m128i mask_generic = _mm_andnot_si128(_mm_or_si128(mask_special, a_inf), all_bits);
+
+  // +inf / b > 0 and -inf / b < 0 are +inf, otherwise -inf
+  __m128i inf = _mm_blendv_epi8(pos_inf, neg_inf, _mm_xor_si128(a_pos_inf, b_pos));
+
+  ret = _mm_blendv_epi8(ret, inf, mask_inf_num);
+  ret = _mm_blendv_epi8(ret, nan, _mm_or_si128(mask_special, mask_inf_inf));
+
+  mask_max  = _mm_and_si128(mask_generic, _mm_or_si128(mask_max, mask_min));
+  q_nan     = _mm_and_si128(mask_generic, q_nan);
+  q_pos_inf = _mm_and_si128(mask_generic, _mm_or_si128(q_pos_inf, q_neg_inf));
+
+  // assigning the NaN result also flags division by zero as NaN
+  bool is_nan =
+      _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(mask_special, mask_inf_inf), q_nan)) != 0;
+  bool is_division_by_zero = _mm_movemask_epi8(_mm_andnot_si128(a_zero, mask_div0)) != 0;
+  bool is_infinity         = _mm_movemask_epi8(_mm_or_si128(mask_inf_num, q_pos_inf)) != 0;
+  bool is_overflow         = _mm_movemask_epi8(mask_max) != 0;
+  fixed_point::fp32_t::fp_state |= fixed_point::fp32_t::STATE_NAN * static_cast<uint32_t>(is_nan);
+  fixed_point::fp32_t::fp_state |=
+      fixed_point::fp32_t::STATE_DIVISION_BY_ZERO * static_cast<uint32_t>(is_division_by_zero);
+  fixed_point::fp32_t::fp_state |=
+      fixed_point::fp32_t::STATE_INFINITY * static_cast<uint32_t>(is_infinity);
+  fixed_point::fp32_t::fp_state |=
+      fixed_point::fp32_t::STATE_OVERFLOW * static_cast<uint32_t>(is_overflow);
 
   return {ret};
 }
@@ -734,23 +816,17 @@ inline VectorRegister<fixed_point::fp32_t, 256> operator/(
     VectorRegister<fixed_point::fp32_t, 256> const &a,
     VectorRegister<fixed_point::fp32_t, 256> const &b)
 {
-  // TODO(private 440): SSE implementation required
-  alignas(VectorRegister<fixed_point::fp32_t, 256>::E_REGISTER_SIZE) fixed_point::fp32_t d1[8];
-  a.Store(d1);
-
-  alignas(VectorRegister<fixed_point::fp32_t, 256>::E_REGISTER_SIZE) fixed_point::fp32_t d2[8];
-  b.Store(d2);
-
-  alignas(VectorRegister<fixed_point::fp32_t, 256>::E_REGISTER_SIZE) fixed_point::fp32_t ret[8];
+  // Use the above division in 2 steps, for each 128bit lane
+  VectorRegister<fixed_point::fp32_t, 128> a_lo(_mm256_extractf128_si256(a.data(), 0));
+  VectorRegister<fixed_point::fp32_t, 128> a_hi(_mm256_extractf128_si256(a.data(), 1));
+  VectorRegister<fixed_point::fp32_t, 128> b_lo(_mm256_extractf128_si256(b.data(), 0));
+  VectorRegister<fixed_point::fp32_t, 128> b_hi(_mm256_extractf128_si256(b.data(), 1));
 
-  // don't divide by zero
-  // set each of the 4 values in the vector register to either the solution of the division or 0
-  for (std::size_t i = 0; i < 8; i++)
-  {
-    ret[i] = d1[i] / d2[i];
-  }
+  VectorRegister<fixed_point::fp32_t, 128> quot_lo = a_lo / b_lo;
+  VectorRegister<fixed_point::fp32_t, 128> quot_hi = a_hi / b_hi;
 
-  return {ret};
+  VectorRegister<fixed_point::fp32_t, 256> quot(_mm256_set_m128i(quot_hi.data(), quot_lo.data()));
+  return quot;
 }
 
 inline VectorRegister<fixed_point::fp32_t, 128> vector_zero_below_element(
@@ -231,7 +231,10 @@ inline VectorRegister<int8_t, 128> operator*(VectorRegister<int8_t, 128> const &
   __m256i a16 = _mm256_cvtepi8_epi16(a.data());
   __m256i b16 = _mm256_cvtepi8_epi16(b.data());
   __m256i c16 = _mm256_mullo_epi16(a16, b16);
-  return {_mm256_cvtepi16_epi8(c16)};
+
+  // _mm256_cvtepi16_epi8 needs AVX-512, so keep the low bytes and pack them instead
+  c16 = _mm256_and_si256(c16, _mm256_set1_epi16(0xFF));
+  return {_mm_packus_epi16(_mm256_castsi256_si128(c16), _mm256_extracti128_si256(c16, 1))};
 }
 
 inline VectorRegister<int8_t, 256> operator*(VectorRegister<int8_t, 256> const &a,
@@ -240,7 +240,8 @@ public:
     STATE_OVERFLOW         = 1 << 3,
     STATE_INFINITY         = 1 << 4,
   };
-  static uint32_t fp_state;
+  // kept per thread, so that operations running in parallel do not race on it
+  static thread_local uint32_t fp_state;
 
   static constexpr void StateClear();
   static constexpr bool IsState(uint32_t state);
@@ -603,7 +604,7 @@ std::function<FixedPoint<I, F>(FixedPoint<I, F> const &x)>
         [](FixedPoint<I, F> const &x) { return FixedPoint<I, F>::SinPi2(x); }};
 
 template <uint16_t I, uint16_t F>
-uint32_t FixedPoint<I, F>::fp_state{FixedPoint<I, F>::STATE_OK};
+thread_local uint32_t FixedPoint<I, F>::fp_state{FixedPoint<I, F>::STATE_OK};
 
 template <uint16_t I, uint16_t F>
 constexpr typename FixedPoint<I, F>::Type FixedPoint<I, F>::SMALLEST_FRACTION;
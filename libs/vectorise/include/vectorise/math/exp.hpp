@@ -0,0 +1,59 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/vectorise.hpp"
+#ifdef __AVX2__
+#include "vectorise/arch/avx2/math/exp.hpp"
+#endif
+
+namespace fetch {
+namespace vectorise {
+
+template <typename T>
+inline fetch::math::meta::IfIsFixedPoint<T, VectorRegister<T, 8 * sizeof(T)>> Exp(
+    VectorRegister<T, 8 * sizeof(T)> const &x)
+{
+  return VectorRegister<T, 8 * sizeof(T)>(T::Exp(x.data()));
+}
+
+template <typename T>
+inline fetch::math::meta::IfIsFixedPoint<T, VectorRegister<T, 8 * sizeof(T)>> TanH(
+    VectorRegister<T, 8 * sizeof(T)> const &x)
+{
+  return VectorRegister<T, 8 * sizeof(T)>(T::TanH(x.data()));
+}
+
+/**
+ * The numerically stable sigmoid, 1 / (1 + e^-x) for x >= 0 and e^x / (e^x + 1) otherwise
+ */
+template <typename T>
+inline fetch::math::meta::IfIsFixedPoint<T, VectorRegister<T, 8 * sizeof(T)>> Sigmoid(
+    VectorRegister<T, 8 * sizeof(T)> const &x)
+{
+  if (x.data() >= T{0})
+  {
+    return VectorRegister<T, 8 * sizeof(T)>(T{1} / (T{1} + T::Exp(-x.data())));
+  }
+
+  T const e = T::Exp(x.data());
+  return VectorRegister<T, 8 * sizeof(T)>(e / (e + T{1}));
+}
+
+}  // namespace vectorise
+}  // namespace fetch
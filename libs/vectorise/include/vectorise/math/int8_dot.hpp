@@ -0,0 +1,82 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#ifdef __AVX2__
+#include "vectorise/arch/avx2/math/int8_dot.hpp"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fetch {
+namespace vectorise {
+
+/// int8 vectors passed to the dot products are padded with zeros to a multiple of this length
+constexpr std::size_t INT8_DOT_ALIGNMENT = 32;
+
+/**
+ * The dot product of a and b with int32 accumulation
+ * @param n length of the vectors, a multiple of INT8_DOT_ALIGNMENT
+ */
+inline int32_t Int8DotProduct(int8_t const *a, int8_t const *b, std::size_t n)
+{
+#ifdef __AVX2__
+  return Int8DotProductAVX2(a, b, n);
+#else
+  int32_t sum{0};
+  for (std::size_t k = 0; k < n; ++k)
+  {
+    sum += static_cast<int32_t>(a[k]) * static_cast<int32_t>(b[k]);
+  }
+  return sum;
+#endif
+}
+
+/**
+ * The dot products of every row of a with every row of b, with int32 accumulation, i.e. the
+ * product of a with the transpose of b. The elements must be in [-127, 127].
+ * @param a rows x stride matrix in row major order
+ * @param b columns x stride matrix in row major order
+ * @param stride length of the rows, a multiple of INT8_DOT_ALIGNMENT
+ * @param ret rows x columns result in column major order
+ */
+inline void Int8DotProducts(int8_t const *a, std::size_t rows, int8_t const *b,
+                            std::size_t columns, std::size_t stride, int32_t *ret)
+{
+  for (std::size_t j = 0; j < columns; ++j)
+  {
+    int8_t const *column = b + (j * stride);
+    int32_t *     out    = ret + (j * rows);
+
+    std::size_t i = 0;
+#ifdef __AVX2__
+    for (; i + 4 <= rows; i += 4)
+    {
+      Int8DotProduct4AVX2(a + (i * stride), stride, column, stride, out + i);
+    }
+#endif
+    for (; i < rows; ++i)
+    {
+      out[i] = Int8DotProduct(a + (i * stride), column, stride);
+    }
+  }
+}
+
+}  // namespace vectorise
+}  // namespace fetch
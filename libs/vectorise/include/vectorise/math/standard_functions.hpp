@@ -21,6 +21,7 @@
 #ifdef __AVX2__
 #include "vectorise/arch/avx2/math/standard_functions.hpp"
 #endif
+#include "vectorise/math/exp.hpp"
 #include "vectorise/math/max.hpp"
 #include "vectorise/math/min.hpp"
 
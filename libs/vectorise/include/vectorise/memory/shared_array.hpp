@@ -19,17 +19,17 @@
 
 #include "meta/log2.hpp"
 #include "vectorise/memory/iterator.hpp"
+#include "vectorise/memory/slab_allocator.hpp"
 #include "vectorise/memory/vector_slice.hpp"
 
-#include <mm_malloc.h>
-
 #include <algorithm>
-#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <utility>
 
 namespace fetch {
@@ -45,7 +45,7 @@ public:
   //  static_assert(std::is_pod<T>::value, "Can only be used with POD types");
   //  static_assert(meta::IfIsPodOrFixedPoint<T>::value, "can only be used with POD or FixedPoint");
   using size_type = std::size_t;
-  using DataType  = std::shared_ptr<T>;
+  using DataType  = T *;
   using SuperType = VectorSlice<T, type_size>;
   using SelfType  = SharedArray<T, type_size>;
   using type      = T;
@@ -57,15 +57,18 @@ public:
 
     if (n > 0)
     {
-      data_ = std::shared_ptr<T>(
-          static_cast<T *>(_mm_malloc(this->padded_size() * sizeof(type), 64)), _mm_free);
+      data_ = static_cast<T *>(SlabAllocator::Allocate(this->padded_size() * sizeof(type)));
 
-      if (!data_)
+      if (data_ == nullptr)
       {
         throw std::runtime_error("Can't allocate array of size " + std::to_string(n));
       }
 
-      this->pointer_ = data_.get();
+      this->pointer_ = data_;
+
+      // recycled blocks still hold the data of their previous owner, so the padding is cleared to
+      // keep reads past the end of the array (e.g. of whole SIMD registers) deterministic
+      this->SetPaddedZero();
     }
   }
 
@@ -74,12 +77,16 @@ public:
   SharedArray(SharedArray const &other) noexcept
     : SuperType(other.pointer_, other.size())
     , data_(other.data_)
-  {}
+  {
+    AddRef();
+  }
 
   SharedArray(SharedArray const &other, uint64_t offset, uint64_t size) noexcept
-    : SuperType(other.data_.get() + offset, size)
+    : SuperType(other.data_ + offset, size)
     , data_(other.data_)
-  {}
+  {
+    AddRef();
+  }
 
   SharedArray(SharedArray &&other) noexcept
   {
@@ -103,23 +110,29 @@ public:
       return *this;
     }
 
+    Release();
+
     this->size_ = other.size_;
 
     if (other.data_)
     {
       this->data_    = other.data_;
       this->pointer_ = other.pointer_;
+      AddRef();
     }
     else
     {
-      this->data_.reset();
+      this->data_    = nullptr;
       this->pointer_ = nullptr;
     }
 
     return *this;
   }
 
-  ~SharedArray() = default;
+  ~SharedArray()
+  {
+    Release();
+  }
 
   SelfType Copy() const
   {
@@ -135,16 +148,32 @@ public:
 
   bool IsUnique() const noexcept
   {
-    return data_.use_count() < 2;
+    return UseCount() < 2;
   }
 
   uint64_t UseCount() const noexcept
   {
-    long const use_count = data_.use_count();
-    return use_count < 0 ? 0 : static_cast<uint64_t>(use_count);
+    return data_ ? SlabAllocator::UseCount(data_) : 0;
   }
 
 private:
+  void AddRef() noexcept
+  {
+    if (data_)
+    {
+      SlabAllocator::AddRef(data_);
+    }
+  }
+
+  void Release() noexcept
+  {
+    if (data_)
+    {
+      SlabAllocator::Release(data_);
+      data_ = nullptr;
+    }
+  }
+
   DataType data_ = nullptr;
 };
 
@@ -0,0 +1,122 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace fetch {
+namespace memory {
+
+/**
+ * Size classed, thread caching allocator for reference counted buffers.
+ *
+ * Every block starts with a cache line sized header holding an intrusive reference count,
+ * followed by a 64 byte aligned payload. Payloads of up to MAX_POOLED_SIZE bytes are rounded up
+ * to a power of two size class and recycled: freed blocks are first kept in a per thread free
+ * list and, once that is full, handed back in batches to a shared per class free list. Larger
+ * payloads are allocated and freed directly.
+ *
+ * Statistics are accumulated per thread and published periodically, so they may lag the true
+ * values slightly.
+ */
+class SlabAllocator
+{
+public:
+  static constexpr std::size_t ALIGNMENT       = 64;
+  static constexpr std::size_t HEADER_SIZE     = 64;
+  static constexpr std::size_t MIN_CLASS_LOG2  = 6;   // 64 bytes
+  static constexpr std::size_t MAX_CLASS_LOG2  = 15;  // 32 KiB
+  static constexpr std::size_t NUM_CLASSES     = MAX_CLASS_LOG2 - MIN_CLASS_LOG2 + 1;
+  static constexpr std::size_t MAX_POOLED_SIZE = std::size_t{1} << MAX_CLASS_LOG2;
+
+  struct Statistics
+  {
+    uint64_t allocations{0};           ///< Total number of blocks handed out
+    uint64_t deallocations{0};         ///< Total number of blocks returned
+    uint64_t thread_cache_hits{0};     ///< Allocations served from a per thread free list
+    uint64_t shared_cache_hits{0};     ///< Allocations served from the shared free lists
+    uint64_t system_allocations{0};    ///< Allocations which required new memory
+    uint64_t system_deallocations{0};  ///< Blocks given back to the system
+    uint64_t bytes_in_use{0};          ///< Bytes (including headers) currently handed out
+  };
+
+  /**
+   * The header which precedes every payload
+   */
+  struct Header
+  {
+    std::atomic<uint64_t> ref_count{1};
+    std::size_t           size_class{0};
+    std::size_t           block_size{0};
+    Header *              next{nullptr};
+  };
+
+  static_assert(sizeof(Header) <= HEADER_SIZE, "Block header does not fit in its cache line");
+
+  static void *   Allocate(std::size_t size);
+  static void     AddRef(void *payload) noexcept;
+  static void     Release(void *payload) noexcept;
+  static uint64_t UseCount(void const *payload) noexcept;
+
+  static Statistics GetStatistics();
+
+private:
+  static Header *ToHeader(void const *payload) noexcept;
+  static void    Free(Header *header) noexcept;
+};
+
+inline SlabAllocator::Header *SlabAllocator::ToHeader(void const *payload) noexcept
+{
+  return reinterpret_cast<Header *>(
+      const_cast<uint8_t *>(static_cast<uint8_t const *>(payload) - HEADER_SIZE));
+}
+
+/**
+ * Take an additional reference to an allocated payload
+ *
+ * @param payload The payload returned from Allocate
+ */
+inline void SlabAllocator::AddRef(void *payload) noexcept
+{
+  ToHeader(payload)->ref_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Drop a reference to an allocated payload, freeing the block when it was the last one
+ *
+ * @param payload The payload returned from Allocate
+ */
+inline void SlabAllocator::Release(void *payload) noexcept
+{
+  Header *header = ToHeader(payload);
+
+  if (header->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+  {
+    Free(header);
+  }
+}
+
+inline uint64_t SlabAllocator::UseCount(void const *payload) noexcept
+{
+  return ToHeader(payload)->ref_count.load(std::memory_order_relaxed);
+}
+
+}  // namespace memory
+}  // namespace fetch
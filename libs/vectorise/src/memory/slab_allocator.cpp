@@ -0,0 +1,442 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/memory/slab_allocator.hpp"
+
+#include <mm_malloc.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace fetch {
+namespace memory {
+namespace {
+
+using Header     = SlabAllocator::Header;
+using Statistics = SlabAllocator::Statistics;
+
+constexpr std::size_t NUM_CLASSES          = SlabAllocator::NUM_CLASSES;
+constexpr std::size_t LARGE_CLASS          = NUM_CLASSES;
+constexpr std::size_t THREAD_CACHE_BYTES   = 256u * 1024u;        // per size class
+constexpr std::size_t SHARED_CACHE_BYTES   = 4u * 1024u * 1024u;  // per size class
+constexpr std::size_t MIN_CACHED_BLOCKS    = 8;
+constexpr uint64_t    STATS_PUBLISH_PERIOD = 256;
+
+// The smallest size class which can hold the payload, otherwise LARGE_CLASS
+std::size_t ClassIndex(std::size_t size)
+{
+  std::size_t index{0};
+  std::size_t capacity{std::size_t{1} << SlabAllocator::MIN_CLASS_LOG2};
+
+  while ((index < NUM_CLASSES) && (size > capacity))
+  {
+    ++index;
+    capacity <<= 1u;
+  }
+
+  return index;
+}
+
+std::size_t BlockSize(std::size_t size_class)
+{
+  return SlabAllocator::HEADER_SIZE +
+         (std::size_t{1} << (size_class + SlabAllocator::MIN_CLASS_LOG2));
+}
+
+std::size_t CacheLimit(std::size_t size_class, std::size_t cache_bytes)
+{
+  return std::max(MIN_CACHED_BLOCKS, cache_bytes / BlockSize(size_class));
+}
+
+Header *SystemAllocate(std::size_t block_size)
+{
+  void *block = _mm_malloc(block_size, SlabAllocator::ALIGNMENT);
+  if (block == nullptr)
+  {
+    return nullptr;
+  }
+
+  return new (block) Header{};
+}
+
+void SystemFree(Header *header)
+{
+  header->~Header();
+  _mm_free(header);
+}
+
+/**
+ * Intrusive singly linked list of free blocks
+ */
+struct FreeList
+{
+  Header *    head{nullptr};
+  std::size_t count{0};
+
+  void Push(Header *header)
+  {
+    header->next = head;
+    head         = header;
+    ++count;
+  }
+
+  Header *Pop()
+  {
+    Header *header = head;
+    if (header != nullptr)
+    {
+      head         = header->next;
+      header->next = nullptr;
+      --count;
+    }
+
+    return header;
+  }
+};
+
+// Global statistics, updated in batches by each of the threads
+struct SharedStatistics
+{
+  std::atomic<uint64_t> allocations{0};
+  std::atomic<uint64_t> deallocations{0};
+  std::atomic<uint64_t> thread_cache_hits{0};
+  std::atomic<uint64_t> shared_cache_hits{0};
+  std::atomic<uint64_t> system_allocations{0};
+  std::atomic<uint64_t> system_deallocations{0};
+  std::atomic<int64_t>  bytes_in_use{0};
+};
+
+SharedStatistics shared_stats;
+
+struct LocalStatistics
+{
+  uint64_t allocations{0};
+  uint64_t deallocations{0};
+  uint64_t thread_cache_hits{0};
+  uint64_t shared_cache_hits{0};
+  uint64_t system_allocations{0};
+  uint64_t system_deallocations{0};
+  int64_t  bytes_in_use{0};
+  uint64_t operations{0};
+
+  void Update()
+  {
+    if (++operations >= STATS_PUBLISH_PERIOD)
+    {
+      Publish();
+    }
+  }
+
+  void Publish()
+  {
+    shared_stats.allocations += allocations;
+    shared_stats.deallocations += deallocations;
+    shared_stats.thread_cache_hits += thread_cache_hits;
+    shared_stats.shared_cache_hits += shared_cache_hits;
+    shared_stats.system_allocations += system_allocations;
+    shared_stats.system_deallocations += system_deallocations;
+    shared_stats.bytes_in_use += bytes_in_use;
+
+    *this = LocalStatistics{};
+  }
+};
+
+/**
+ * Free lists shared between all the threads, used to rebalance blocks between the thread caches
+ */
+class SharedCache
+{
+public:
+  static SharedCache &Instance()
+  {
+    // intentionally never destroyed so that thread caches can always be flushed, even during
+    // static destruction
+    static auto *instance = new SharedCache{};
+    return *instance;
+  }
+
+  std::size_t Take(std::size_t size_class, FreeList &destination, std::size_t count)
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+
+    auto &source = lists_[size_class];
+
+    std::size_t taken{0};
+    for (; (taken < count) && (source.head != nullptr); ++taken)
+    {
+      destination.Push(source.Pop());
+    }
+
+    return taken;
+  }
+
+  // returns the number of blocks which did not fit and were given back to the system
+  std::size_t Give(std::size_t size_class, FreeList &source, std::size_t count)
+  {
+    FreeList overflow{};
+
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+
+      auto &     destination = lists_[size_class];
+      auto const limit       = CacheLimit(size_class, SHARED_CACHE_BYTES);
+
+      for (std::size_t i = 0; (i < count) && (source.head != nullptr); ++i)
+      {
+        if (destination.count < limit)
+        {
+          destination.Push(source.Pop());
+        }
+        else
+        {
+          overflow.Push(source.Pop());
+        }
+      }
+    }
+
+    std::size_t const freed = overflow.count;
+    while (overflow.head != nullptr)
+    {
+      SystemFree(overflow.Pop());
+    }
+
+    return freed;
+  }
+
+private:
+  std::mutex                        lock_;
+  std::array<FreeList, NUM_CLASSES> lists_{};
+};
+
+thread_local bool thread_cache_gone{false};
+
+/**
+ * Per thread free lists. Allocations and deallocations on the same thread do not need any
+ * synchronisation in the common case.
+ */
+class ThreadCache
+{
+public:
+  ThreadCache()                    = default;
+  ThreadCache(ThreadCache const &) = delete;
+  ThreadCache(ThreadCache &&)      = delete;
+
+  ~ThreadCache()
+  {
+    for (std::size_t size_class = 0; size_class < NUM_CLASSES; ++size_class)
+    {
+      auto &list = lists_[size_class];
+      stats_.system_deallocations += SharedCache::Instance().Give(size_class, list, list.count);
+    }
+
+    stats_.Publish();
+    thread_cache_gone = true;
+  }
+
+  Header *Allocate(std::size_t size_class)
+  {
+    auto &list = lists_[size_class];
+
+    Header *header = list.Pop();
+    if (header != nullptr)
+    {
+      ++stats_.thread_cache_hits;
+    }
+    else
+    {
+      // refill half of the thread cache from the shared lists
+      auto const batch = CacheLimit(size_class, THREAD_CACHE_BYTES) / 2;
+      if (SharedCache::Instance().Take(size_class, list, batch) != 0)
+      {
+        header = list.Pop();
+        ++stats_.shared_cache_hits;
+      }
+      else
+      {
+        header = SystemAllocate(BlockSize(size_class));
+        if (header == nullptr)
+        {
+          return nullptr;
+        }
+
+        ++stats_.system_allocations;
+      }
+    }
+
+    ++stats_.allocations;
+    stats_.bytes_in_use += static_cast<int64_t>(BlockSize(size_class));
+    stats_.Update();
+
+    return header;
+  }
+
+  void Deallocate(Header *header)
+  {
+    auto const size_class = header->size_class;
+    auto &     list       = lists_[size_class];
+
+    list.Push(header);
+
+    // when the thread cache is full, move half of it across to the shared lists
+    auto const limit = CacheLimit(size_class, THREAD_CACHE_BYTES);
+    if (list.count > limit)
+    {
+      stats_.system_deallocations += SharedCache::Instance().Give(size_class, list, limit / 2);
+    }
+
+    ++stats_.deallocations;
+    stats_.bytes_in_use -= static_cast<int64_t>(BlockSize(size_class));
+    stats_.Update();
+  }
+
+  ThreadCache &operator=(ThreadCache const &) = delete;
+  ThreadCache &operator=(ThreadCache &&) = delete;
+
+private:
+  std::array<FreeList, NUM_CLASSES> lists_{};
+  LocalStatistics                   stats_{};
+};
+
+ThreadCache *LocalCache()
+{
+  // once the cache of this thread has been torn down (during thread exit) blocks are allocated
+  // and freed without caching
+  if (thread_cache_gone)
+  {
+    return nullptr;
+  }
+
+  thread_local ThreadCache cache;
+  return &cache;
+}
+
+}  // namespace
+
+/**
+ * Allocate a new reference counted block. The part of the block beyond the requested size is
+ * cleared, so that reads past the end of a payload see the same (zero) bytes whether the block is
+ * fresh or recycled.
+ *
+ * @param size The size of the payload in bytes
+ * @return The 64 byte aligned payload with a reference count of one, or nullptr on failure
+ */
+void *SlabAllocator::Allocate(std::size_t size)
+{
+  std::size_t const size_class = ClassIndex(size);
+
+  Header *header{nullptr};
+  if (size_class == LARGE_CLASS)
+  {
+    std::size_t const block_size = HEADER_SIZE + size;
+
+    header = SystemAllocate(block_size);
+    if (header == nullptr)
+    {
+      return nullptr;
+    }
+
+    header->block_size = block_size;
+
+    shared_stats.allocations.fetch_add(1, std::memory_order_relaxed);
+    shared_stats.system_allocations.fetch_add(1, std::memory_order_relaxed);
+    shared_stats.bytes_in_use.fetch_add(static_cast<int64_t>(block_size),
+                                        std::memory_order_relaxed);
+  }
+  else
+  {
+    auto *cache = LocalCache();
+
+    if (cache != nullptr)
+    {
+      header = cache->Allocate(size_class);
+    }
+    else
+    {
+      header = SystemAllocate(BlockSize(size_class));
+
+      shared_stats.allocations.fetch_add(1, std::memory_order_relaxed);
+      shared_stats.system_allocations.fetch_add(1, std::memory_order_relaxed);
+      shared_stats.bytes_in_use.fetch_add(static_cast<int64_t>(BlockSize(size_class)),
+                                          std::memory_order_relaxed);
+    }
+
+    if (header == nullptr)
+    {
+      return nullptr;
+    }
+
+    header->block_size = BlockSize(size_class);
+  }
+
+  header->ref_count.store(1, std::memory_order_relaxed);
+  header->size_class = size_class;
+
+  auto *payload = reinterpret_cast<uint8_t *>(header) + HEADER_SIZE;
+  std::memset(payload + size, 0, header->block_size - HEADER_SIZE - size);
+
+  return payload;
+}
+
+void SlabAllocator::Free(Header *header) noexcept
+{
+  if (header->size_class != LARGE_CLASS)
+  {
+    auto *cache = LocalCache();
+
+    if (cache != nullptr)
+    {
+      cache->Deallocate(header);
+      return;
+    }
+  }
+
+  shared_stats.deallocations.fetch_add(1, std::memory_order_relaxed);
+  shared_stats.system_deallocations.fetch_add(1, std::memory_order_relaxed);
+  shared_stats.bytes_in_use.fetch_sub(static_cast<int64_t>(header->block_size),
+                                      std::memory_order_relaxed);
+
+  SystemFree(header);
+}
+
+/**
+ * Get a snapshot of the allocator statistics
+ *
+ * @return The statistics
+ */
+SlabAllocator::Statistics SlabAllocator::GetStatistics()
+{
+  Statistics stats{};
+  stats.allocations          = shared_stats.allocations;
+  stats.deallocations        = shared_stats.deallocations;
+  stats.thread_cache_hits    = shared_stats.thread_cache_hits;
+  stats.shared_cache_hits    = shared_stats.shared_cache_hits;
+  stats.system_allocations   = shared_stats.system_allocations;
+  stats.system_deallocations = shared_stats.system_deallocations;
+  stats.bytes_in_use = static_cast<uint64_t>(std::max<int64_t>(0, shared_stats.bytes_in_use));
+
+  return stats;
+}
+
+}  // namespace memory
+}  // namespace fetch
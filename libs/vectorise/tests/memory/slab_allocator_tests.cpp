@@ -0,0 +1,172 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/memory/shared_array.hpp"
+#include "vectorise/memory/slab_allocator.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::memory::SharedArray;
+using fetch::memory::SlabAllocator;
+
+TEST(SlabAllocatorTests, PayloadsAreAligned)
+{
+  for (std::size_t size : {1u, 63u, 64u, 65u, 1000u, 32768u, 32769u, 1000000u})
+  {
+    void *payload = SlabAllocator::Allocate(size);
+    ASSERT_NE(payload, nullptr);
+
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(payload) % SlabAllocator::ALIGNMENT, 0u);
+    EXPECT_EQ(SlabAllocator::UseCount(payload), 1u);
+
+    SlabAllocator::Release(payload);
+  }
+}
+
+TEST(SlabAllocatorTests, BlocksAreRecycledWithinAThread)
+{
+  void *first = SlabAllocator::Allocate(100);
+  SlabAllocator::Release(first);
+
+  // the same size class should be served from the thread cache
+  void *second = SlabAllocator::Allocate(128);
+  EXPECT_EQ(first, second);
+
+  SlabAllocator::Release(second);
+}
+
+TEST(SlabAllocatorTests, RecycledBlocksAreClearedPastTheRequestedSize)
+{
+  auto *first = static_cast<uint8_t *>(SlabAllocator::Allocate(128));
+  std::memset(first, 0xAB, 128);
+  SlabAllocator::Release(first);
+
+  // the recycled block must not expose the data of its previous owner beyond the new size
+  auto *second = static_cast<uint8_t *>(SlabAllocator::Allocate(100));
+  ASSERT_EQ(first, second);
+
+  for (std::size_t i = 100; i < 128; ++i)
+  {
+    EXPECT_EQ(second[i], 0u) << "at " << i;
+  }
+
+  SlabAllocator::Release(second);
+}
+
+TEST(SlabAllocatorTests, BlockIsOnlyFreedByTheLastReference)
+{
+  void *payload = SlabAllocator::Allocate(256);
+
+  SlabAllocator::AddRef(payload);
+  EXPECT_EQ(SlabAllocator::UseCount(payload), 2u);
+
+  SlabAllocator::Release(payload);
+  EXPECT_EQ(SlabAllocator::UseCount(payload), 1u);
+
+  // a new allocation of the same size must not alias the live block
+  void *other = SlabAllocator::Allocate(256);
+  EXPECT_NE(other, payload);
+
+  SlabAllocator::Release(other);
+  SlabAllocator::Release(payload);
+}
+
+TEST(SlabAllocatorTests, BlocksCanBeFreedOnAnotherThread)
+{
+  static constexpr std::size_t NUM_BLOCKS = 10000;
+
+  std::vector<SharedArray<uint8_t>> arrays;
+  for (std::size_t i = 0; i < NUM_BLOCKS; ++i)
+  {
+    arrays.emplace_back(1 + (i % 2000));
+    arrays.back()[0] = static_cast<uint8_t>(i);
+  }
+
+  std::thread consumer([&arrays]() {
+    for (std::size_t i = 0; i < NUM_BLOCKS; ++i)
+    {
+      EXPECT_EQ(arrays[i][0], static_cast<uint8_t>(i));
+    }
+
+    arrays.clear();
+  });
+  consumer.join();
+
+  // the freed blocks are available to this thread again through the shared lists
+  std::vector<SharedArray<uint8_t>> reused(NUM_BLOCKS, SharedArray<uint8_t>{64});
+  EXPECT_EQ(reused.size(), NUM_BLOCKS);
+}
+
+TEST(SlabAllocatorTests, StatisticsArePublished)
+{
+  auto const before = SlabAllocator::GetStatistics();
+
+  // statistics are published when the thread cache is torn down
+  std::thread worker([]() {
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+      SharedArray<uint64_t> array{i + 1};
+      SharedArray<uint64_t> copy{array};
+      EXPECT_EQ(copy.UseCount(), 2u);
+    }
+  });
+  worker.join();
+
+  auto const after = SlabAllocator::GetStatistics();
+
+  EXPECT_GE(after.allocations - before.allocations, 100u);
+  EXPECT_GE(after.deallocations - before.deallocations, 100u);
+}
+
+TEST(SharedArrayTests, ReferencesAreCounted)
+{
+  SharedArray<uint32_t> array{16};
+  EXPECT_TRUE(array.IsUnique());
+
+  {
+    SharedArray<uint32_t> copy{array};
+    SharedArray<uint32_t> slice{array, 4, 8};
+    EXPECT_EQ(array.UseCount(), 3u);
+    EXPECT_FALSE(array.IsUnique());
+
+    SharedArray<uint32_t> assigned{4};
+    assigned = copy;
+    EXPECT_EQ(array.UseCount(), 4u);
+
+    SharedArray<uint32_t> moved{std::move(assigned)};
+    EXPECT_EQ(array.UseCount(), 4u);
+  }
+
+  EXPECT_EQ(array.UseCount(), 1u);
+
+  SharedArray<uint32_t> empty{};
+  EXPECT_EQ(empty.UseCount(), 0u);
+
+  array = empty;
+  EXPECT_EQ(array.UseCount(), 0u);
+}
+
+}  // namespace
@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/math/int8_dot.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+using fetch::vectorise::INT8_DOT_ALIGNMENT;
+
+std::vector<int8_t> RandomValues(std::size_t n, std::mt19937 &rng)
+{
+  std::uniform_int_distribution<int> distribution(-127, 127);
+
+  std::vector<int8_t> ret(n);
+  for (auto &x : ret)
+  {
+    x = static_cast<int8_t>(distribution(rng));
+  }
+  return ret;
+}
+
+int32_t ReferenceDot(int8_t const *a, int8_t const *b, std::size_t n)
+{
+  int32_t ret{0};
+  for (std::size_t k = 0; k < n; ++k)
+  {
+    ret += static_cast<int32_t>(a[k]) * static_cast<int32_t>(b[k]);
+  }
+  return ret;
+}
+
+}  // namespace
+
+TEST(vectorise_int8_dot_gtest, dot_product)
+{
+  std::mt19937 rng(42);
+  for (std::size_t n : {INT8_DOT_ALIGNMENT, 2 * INT8_DOT_ALIGNMENT, 33 * INT8_DOT_ALIGNMENT})
+  {
+    auto const a = RandomValues(n, rng);
+    auto const b = RandomValues(n, rng);
+
+    EXPECT_EQ(fetch::vectorise::Int8DotProduct(a.data(), b.data(), n),
+              ReferenceDot(a.data(), b.data(), n));
+  }
+}
+
+TEST(vectorise_int8_dot_gtest, dot_product_of_extremes)
+{
+  // every pairwise sum of products is at the edge of the 16 bit range
+  std::size_t const         n = 4 * INT8_DOT_ALIGNMENT;
+  std::vector<int8_t> const a(n, int8_t{-127});
+  std::vector<int8_t> const b(n, int8_t{-127});
+  std::vector<int8_t> const c(n, int8_t{127});
+
+  EXPECT_EQ(fetch::vectorise::Int8DotProduct(a.data(), b.data(), n), 127 * 127 * int32_t(n));
+  EXPECT_EQ(fetch::vectorise::Int8DotProduct(a.data(), c.data(), n), -127 * 127 * int32_t(n));
+}
+
+TEST(vectorise_int8_dot_gtest, dot_products)
+{
+  std::mt19937 rng(7);
+
+  // row counts which do and do not fill the blocks of four rows
+  for (std::size_t rows : {1, 4, 7, 13})
+  {
+    std::size_t const columns = 5;
+    std::size_t const stride  = 3 * INT8_DOT_ALIGNMENT;
+
+    auto const a = RandomValues(rows * stride, rng);
+    auto const b = RandomValues(columns * stride, rng);
+
+    std::vector<int32_t> ret(rows * columns);
+    fetch::vectorise::Int8DotProducts(a.data(), rows, b.data(), columns, stride, ret.data());
+
+    for (std::size_t j = 0; j < columns; ++j)
+    {
+      for (std::size_t i = 0; i < rows; ++i)
+      {
+        EXPECT_EQ(ret[(j * rows) + i],
+                  ReferenceDot(a.data() + (i * stride), b.data() + (j * stride), stride));
+      }
+    }
+  }
+}
@@ -0,0 +1,172 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/compiler.hpp"
+#include "vm/ir.hpp"
+#include "vm/vm.hpp"
+#include "vm_modules/vm_factory.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace vm_modules {
+namespace benchmark {
+namespace map {
+
+namespace {
+
+using fetch::vm::Executable;
+using fetch::vm::Variant;
+using fetch::vm::VM;
+using fetch::vm_modules::VMFactory;
+
+char const *INTEGER_INSERT_SRC = R"(
+  function main(n : Int32)
+    var m = Map<Int32, Int32>();
+    for (i in 0:n)
+      m[i * 17] = i;
+    endfor
+  endfunction
+)";
+
+char const *INTEGER_LOOKUP_SRC = R"(
+  function main(n : Int32)
+    var m = Map<Int32, Int32>();
+    for (i in 0:n)
+      m[i * 17] = i;
+    endfor
+    var sum = 0;
+    for (round in 0:8)
+      for (i in 0:n)
+        sum = sum + m[i * 17];
+      endfor
+    endfor
+  endfunction
+)";
+
+char const *STRING_LOOKUP_SRC = R"(
+  function main(n : Int32)
+    var m = Map<String, Int32>();
+    for (i in 0:n)
+      m["account-" + toString(i)] = i;
+    endfor
+    var sum = 0;
+    for (i in 0:n)
+      sum = sum + m["account-" + toString(i)];
+    endfor
+  endfunction
+)";
+
+// token ledger style contract: repeated transfers between a fixed set of accounts
+char const *TRANSFER_SRC = R"(
+  function main(n : Int32)
+    var balances = Map<Address, UInt64>();
+    var accounts = Array<Address>(4);
+    accounts[0] = Address("2BPa4uCe2EtgG2sijn2f4dz1osdiUJkABQ3y6ei8mvhvLWmX6x");
+    accounts[1] = Address("MnrRHdvCkdZodEwM855vemS5V3p2hiWmcSQ8JEzD4ZjPdsYtB");
+    accounts[2] = Address("2KP7BjerxYJTtKtAsyUi2xzDyVTtz8Ynn7E2ANxjBqNv4oHZ3j");
+    accounts[3] = Address("28TTPbCF5ASxqQoTGoLGDHSGqQiuhdkE5VzgXtUFUdT7tkdcRb");
+    for (i in 0:4)
+      balances[accounts[i]] = 1000000u64;
+    endfor
+    for (i in 0:n)
+      var from = accounts[i % 4];
+      var to = accounts[(i + 1) % 4];
+      balances[from] = balances[from] - 1u64;
+      balances[to] = balances[to] + 1u64;
+    endfor
+  endfunction
+)";
+
+class MapContract
+{
+public:
+  explicit MapContract(char const *source)
+    : module_{VMFactory::GetModule(VMFactory::USE_ALL)}
+  {
+    auto const errors = VMFactory::Compile(module_, {{"map.etch", source}}, executable_);
+    if (!errors.empty())
+    {
+      throw std::runtime_error("Failed to compile benchmark contract: " + errors.front());
+    }
+  }
+
+  void Run(int32_t n)
+  {
+    VM          vm{module_.get()};
+    std::string error;
+    Variant     output;
+    if (!vm.Execute(executable_, "main", error, output, n))
+    {
+      throw std::runtime_error("Benchmark contract failed: " + error);
+    }
+  }
+
+private:
+  std::shared_ptr<fetch::vm::Module> module_;
+  Executable                         executable_;
+};
+
+void RunContract(::benchmark::State &state, char const *source)
+{
+  MapContract contract{source};
+  auto const  n = static_cast<int32_t>(state.range(0));
+
+  for (auto _ : state)
+  {
+    contract.Run(n);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_MapInsertIntegerKeys(::benchmark::State &state)
+{
+  RunContract(state, INTEGER_INSERT_SRC);
+}
+
+void BM_MapLookupIntegerKeys(::benchmark::State &state)
+{
+  RunContract(state, INTEGER_LOOKUP_SRC);
+}
+
+void BM_MapLookupStringKeys(::benchmark::State &state)
+{
+  RunContract(state, STRING_LOOKUP_SRC);
+}
+
+void BM_MapTransfers(::benchmark::State &state)
+{
+  RunContract(state, TRANSFER_SRC);
+}
+
+}  // namespace
+
+BENCHMARK(BM_MapInsertIntegerKeys)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(BM_MapLookupIntegerKeys)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(BM_MapLookupStringKeys)->RangeMultiplier(10)->Range(10, 10000);
+BENCHMARK(BM_MapTransfers)->RangeMultiplier(10)->Range(10, 100000);
+
+}  // namespace map
+}  // namespace benchmark
+}  // namespace vm_modules
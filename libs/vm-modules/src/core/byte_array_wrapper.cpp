@@ -23,7 +23,9 @@
 #include "vm/vm.hpp"
 #include "vm_modules/core/byte_array_wrapper.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 
 using namespace fetch::vm;
 using namespace fetch::byte_array;
@@ -159,6 +161,11 @@ bool ByteArrayWrapper::FromBase58(fetch::vm::Ptr<vm::String> const &value_b58)
   }
 }
 
+std::size_t ByteArrayWrapper::GetHashCode()
+{
+  return std::hash<byte_array::ConstByteArray>{}(byte_array_);
+}
+
 bool ByteArrayWrapper::IsEqual(fetch::vm::Ptr<Object> const &lhso,
                                fetch::vm::Ptr<Object> const &rhso)
 {
@@ -24,7 +24,9 @@
 #include "vm_modules/core/byte_array_wrapper.hpp"
 #include "vm_modules/math/bignumber.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <stdexcept>
 #include <utility>
 
@@ -339,6 +341,16 @@ void UInt256Wrapper::InplaceDivide(Ptr<Object> const &lhso, Ptr<Object> const &r
   }
 }
 
+std::size_t UInt256Wrapper::GetHashCode()
+{
+  std::size_t hash{0};
+  for (std::size_t i = 0; i < UInt256::WIDE_ELEMENTS; ++i)
+  {
+    hash = (hash * 31u) ^ std::hash<uint64_t>{}(number_.ElementAt(i));
+  }
+  return hash;
+}
+
 bool UInt256Wrapper::IsEqual(Ptr<Object> const &lhso, Ptr<Object> const &rhso)
 {
   auto &lhs = static_cast<Ptr<UInt256Wrapper> const &>(lhso);
@@ -0,0 +1,294 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm_test_toolkit.hpp"
+
+#include "gmock/gmock.h"
+
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+using namespace testing;
+
+// The optimiser runs on every generated executable, so these tests check that the rewritten
+// instruction sequences behave exactly like the ones they replace
+class OptimiserTests : public Test
+{
+public:
+  std::stringstream stdout;
+  VmTestToolkit     toolkit{&stdout};
+};
+
+TEST_F(OptimiserTests, folded_constant_expressions_evaluate_as_at_runtime)
+{
+  static char const *TEXT = R"(
+    function main() : Int32
+      return (2 + 3) * -4 - 10 / 3 + 7 % 4;
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+
+  Variant res;
+  ASSERT_TRUE(toolkit.Run(&res));
+  EXPECT_EQ(res.Get<int32_t>(), -20);
+}
+
+TEST_F(OptimiserTests, folded_constant_arithmetic_wraps_around)
+{
+  static char const *TEXT = R"(
+    function main()
+      print(250u8 + 10u8);
+      print(' ');
+      print(0u16 - 1u16);
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+  ASSERT_TRUE(toolkit.Run());
+
+  EXPECT_EQ(stdout.str(), "4 65535");
+}
+
+TEST_F(OptimiserTests, constant_division_by_zero_still_fails_at_runtime)
+{
+  static char const *TEXT = R"(
+    function main()
+      var x = 1;
+      x = 10 / 0;
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+  ASSERT_FALSE(toolkit.Run());
+
+  EXPECT_THAT(stdout.str(), HasSubstr("line 4: division by zero"));
+}
+
+TEST_F(OptimiserTests, local_plus_constant_into_local_accumulates)
+{
+  static char const *TEXT = R"(
+    function main() : Int64
+      var total = 0i64;
+      var i = 0i64;
+      while (i < 10i64)
+        total = total + 3i64;
+        total = total * 2i64;
+        total = total - 1i64;
+        i = i + 1i64;
+      endwhile
+      total = total / 5i64;
+      return total;
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+
+  Variant res;
+  ASSERT_TRUE(toolkit.Run(&res));
+
+  int64_t expected = 0;
+  for (int64_t i = 0; i < 10; ++i)
+  {
+    expected = ((expected + 3) * 2) - 1;
+  }
+  expected /= 5;
+  EXPECT_EQ(res.Get<int64_t>(), expected);
+}
+
+TEST_F(OptimiserTests, local_divided_by_zero_constant_fails_at_runtime)
+{
+  static char const *TEXT = R"(
+    function main()
+      var x = 10;
+      var y = 0;
+      x = x / 0;
+      print(x);
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+  ASSERT_FALSE(toolkit.Run());
+
+  EXPECT_THAT(stdout.str(), HasSubstr("line 5: division by zero"));
+}
+
+TEST_F(OptimiserTests, fused_comparisons_branch_correctly)
+{
+  static char const *TEXT = R"(
+    function check(a : Int32, b : Int32)
+      if (a == b)
+        print('eq ');
+      endif
+      if (a != b)
+        print('ne ');
+      endif
+      if (a < b)
+        print('lt ');
+      endif
+      if (a <= b)
+        print('le ');
+      endif
+      if (a > b)
+        print('gt ');
+      endif
+      if (a >= b)
+        print('ge ');
+      endif
+      print('| ');
+    endfunction
+
+    function main()
+      check(1, 2);
+      check(2, 2);
+      check(3, 2);
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+  ASSERT_TRUE(toolkit.Run());
+
+  EXPECT_EQ(stdout.str(), "ne lt le | eq le ge | ne gt ge | ");
+}
+
+TEST_F(OptimiserTests, short_circuit_conditions_are_not_broken_by_fusion)
+{
+  static char const *TEXT = R"(
+    function main()
+      var i = 0;
+      while (i < 6 && i != 4)
+        if (i == 1 || i > 2)
+          print(i);
+        endif
+        i = i + 1;
+      endwhile
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+  ASSERT_TRUE(toolkit.Run());
+
+  EXPECT_EQ(stdout.str(), "13");
+}
+
+TEST_F(OptimiserTests, for_range_loops_with_continue_and_break_iterate_correctly)
+{
+  static char const *TEXT = R"(
+    function main()
+      for (i in 0:10:2)
+        if (i == 4)
+          continue;
+        endif
+        if (i == 8)
+          break;
+        endif
+        print(i);
+      endfor
+      print(' ');
+      for (j in 0u8:3u8)
+        for (k in 0u8:2u8)
+          print(j * 10u8 + k);
+          print(',');
+        endfor
+      endfor
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+  ASSERT_TRUE(toolkit.Run());
+
+  EXPECT_EQ(stdout.str(), "026 0,1,10,11,20,21,");
+}
+
+TEST_F(OptimiserTests, overwritten_stores_do_not_change_results)
+{
+  static char const *TEXT = R"(
+    function main() : Int32
+      var x = 1;
+      x = 2;
+      var y = x;
+      x = 3;
+      x = y + x;
+      return x;
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+
+  Variant res;
+  ASSERT_TRUE(toolkit.Run(&res));
+  EXPECT_EQ(res.Get<int32_t>(), 5);
+}
+
+TEST_F(OptimiserTests, folding_and_dead_stores_keep_the_charge_of_the_original_code)
+{
+  // Both have the same instructions before optimisation, but only the first one folds a constant
+  // and drops a dead store
+  static char const *OPTIMISED = R"(
+    function main() : Int32
+      var y = 7;
+      return 2 + 3;
+    endfunction
+  )";
+
+  static char const *UNOPTIMISED = R"(
+    function main() : Int32
+      var y = 2;
+      return y + 3;
+    endfunction
+  )";
+
+  std::unordered_map<std::string, ChargeAmount> const charges{
+      {"PushConstant", 3}, {"PushLocalVariable", 3}, {"PrimitiveAdd", 5},
+      {"LocalVariableDeclareAssign", 11}};
+
+  ASSERT_TRUE(toolkit.Compile(OPTIMISED));
+  toolkit.vm().UpdateCharges(charges);
+  ASSERT_TRUE(toolkit.Run());
+  ChargeAmount const optimised_charge = toolkit.vm().GetChargeTotal();
+
+  ASSERT_TRUE(toolkit.Compile(UNOPTIMISED));
+  toolkit.vm().UpdateCharges(charges);
+  ASSERT_TRUE(toolkit.Run());
+
+  EXPECT_EQ(optimised_charge, toolkit.vm().GetChargeTotal());
+}
+
+TEST_F(OptimiserTests, runtime_errors_report_original_line_numbers)
+{
+  static char const *TEXT = R"(
+    function main()
+      var x = 1 + 2;
+      var y = x - 3;
+      x = x + 1;
+      if (x > 3)
+        print(x / y);
+      endif
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+  ASSERT_FALSE(toolkit.Run());
+
+  EXPECT_THAT(stdout.str(), HasSubstr("line 7: division by zero"));
+}
+
+}  // namespace
@@ -0,0 +1,263 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/map.hpp"
+#include "vm_test_toolkit.hpp"
+
+#include "gmock/gmock.h"
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using ::testing::HasSubstr;
+
+using fetch::vm::MapStorage;
+using fetch::vm::Object;
+using fetch::vm::Ptr;
+using fetch::vm::TemplateParameter1;
+namespace TypeIds = fetch::vm::TypeIds;
+
+/// A key of which every instance has the same hash code
+class CollidingKey : public Object
+{
+public:
+  explicit CollidingKey(int32_t value)
+    : Object(nullptr, TypeIds::Unknown)
+    , value_{value}
+  {}
+
+  std::size_t GetHashCode() override
+  {
+    return 42;
+  }
+
+  bool IsEqual(Ptr<Object> const &lhso, Ptr<Object> const &rhso) override
+  {
+    return Value(lhso) == Value(rhso);
+  }
+
+  bool IsLessThan(Ptr<Object> const &lhso, Ptr<Object> const &rhso) override
+  {
+    return Value(lhso) < Value(rhso);
+  }
+
+  static TemplateParameter1 Make(int32_t value)
+  {
+    return TemplateParameter1(Ptr<Object>(new CollidingKey(value)), TypeIds::Unknown);
+  }
+
+private:
+  static int32_t Value(Ptr<Object> const &object)
+  {
+    Ptr<CollidingKey> key = object;
+    return key->value_;
+  }
+
+  int32_t value_;
+};
+
+class MapTests : public ::testing::Test
+{
+public:
+  std::stringstream stdout;
+  VmTestToolkit     toolkit{&stdout};
+
+  std::vector<uint8_t> ReadState(std::string const &key)
+  {
+    std::vector<uint8_t> buffer(1024);
+    uint64_t             size = buffer.size();
+    EXPECT_EQ(toolkit.observer().fake_.Read(key, buffer.data(), size),
+              fetch::vm::IoObserverInterface::Status::OK);
+    buffer.resize(size);
+    return buffer;
+  }
+};
+
+TEST_F(MapTests, integer_keys_survive_growth_of_the_table)
+{
+  static char const *TEXT = R"(
+    function main() : Int64
+      var m = Map<Int64, Int64>();
+      for (i in 0i64:1000i64)
+        m[i * 1024i64] = i;
+      endfor
+      var sum = 0i64;
+      for (i in 0i64:1000i64)
+        sum = sum + m[i * 1024i64];
+      endfor
+      return sum + toInt64(m.count());
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+
+  Variant res;
+  ASSERT_TRUE(toolkit.Run(&res));
+  EXPECT_EQ(res.Get<int64_t>(), 999 * 1000 / 2 + 1000);
+}
+
+TEST_F(MapTests, object_keys_are_compared_by_value)
+{
+  static char const *TEXT = R"(
+    function main()
+      var m = Map<String, Int32>();
+      var prefix = "key";
+      m["key1"] = 1;
+      m[prefix + "1"] = 2;
+      m["key2"] = 3;
+      print(m.count());
+      print(' ');
+      print(m["key1"]);
+      print(' ');
+      print(m[prefix + "2"]);
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+  ASSERT_TRUE(toolkit.Run());
+
+  EXPECT_EQ(stdout.str(), "2 2 3");
+}
+
+TEST_F(MapTests, fixed_point_and_bool_keys)
+{
+  static char const *TEXT = R"(
+    function main()
+      var f = Map<Fixed64, Int32>();
+      f[1.5fp64] = 1;
+      f[-1.5fp64] = 2;
+      f[1.5fp64] = 3;
+      var b = Map<Bool, Int32>();
+      b[true] = 4;
+      b[false] = 5;
+      print(f.count());
+      print(f[1.5fp64]);
+      print(f[-1.5fp64]);
+      print(b[true]);
+      print(b[false]);
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+  ASSERT_TRUE(toolkit.Run());
+
+  EXPECT_EQ(stdout.str(), "23245");
+}
+
+TEST_F(MapTests, querying_missing_key_fails)
+{
+  static char const *TEXT = R"(
+    function main()
+      var m = Map<String, Int32>();
+      m["present"] = 1;
+      print(m["absent"]);
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+  ASSERT_FALSE(toolkit.Run());
+
+  EXPECT_THAT(stdout.str(), HasSubstr("map key does not exist"));
+}
+
+TEST_F(MapTests, serialisation_does_not_depend_on_insertion_order)
+{
+  static char const *TEXT = R"(
+    function main()
+      var a = Map<String, UInt64>();
+      a["carol"] = 3u64;
+      a["alice"] = 1u64;
+      a["bob"] = 2u64;
+      State<Map<String, UInt64>>("a").set(a);
+
+      var b = Map<String, UInt64>();
+      b["bob"] = 2u64;
+      b["carol"] = 3u64;
+      b["alice"] = 1u64;
+      State<Map<String, UInt64>>("b").set(b);
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+  ASSERT_TRUE(toolkit.Run());
+
+  EXPECT_EQ(ReadState("a"), ReadState("b"));
+}
+
+TEST_F(MapTests, colliding_keys_fall_back_to_an_ordered_index)
+{
+  MapStorage<Ptr<Object>> map;
+
+  int32_t const count = 1000;
+  for (int32_t i = 0; i < count; ++i)
+  {
+    auto const inserted = map.Emplace(CollidingKey::Make(i));
+    ASSERT_TRUE(inserted.second);
+    *inserted.first = fetch::vm::TemplateParameter2(i * 2, TypeIds::Int32);
+  }
+
+  EXPECT_TRUE(map.IsOrdered());
+  EXPECT_EQ(map.size(), count);
+  EXPECT_FALSE(map.Emplace(CollidingKey::Make(7)).second);
+  EXPECT_EQ(map.Find(CollidingKey::Make(count)), nullptr);
+
+  for (int32_t i = 0; i < count; ++i)
+  {
+    auto const *value = map.Find(CollidingKey::Make(i));
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(value->Get<int32_t>(), i * 2);
+  }
+}
+
+TEST_F(MapTests, map_round_trips_through_state)
+{
+  static char const *ser_src = R"(
+    function main()
+      var m = Map<Int32, String>();
+      for (i in 0:100)
+        m[i * 7] = toString(i);
+      endfor
+      State<Map<Int32, String>>("m").set(m);
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(ser_src));
+  ASSERT_TRUE(toolkit.Run());
+
+  static char const *deser_src = R"(
+    function main()
+      var m = State<Map<Int32, String>>("m").get();
+      print(m.count());
+      print(' ');
+      print(m[0]);
+      print(' ');
+      print(m[693]);
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(deser_src));
+  ASSERT_TRUE(toolkit.Run());
+
+  EXPECT_EQ(stdout.str(), "100 0 99");
+}
+
+}  // namespace
@@ -808,4 +808,196 @@ TEST_F(StateTests, test_serialisation_of_fixed_point128)
             retval->PopFrontOne().Get<Ptr<fetch::vm::Fixed128>>()->data_);
 }
 
+TEST_F(StateTests, state_map_entries_are_stored_under_individual_keys)
+{
+  static char const *ser_src = R"(
+    function main()
+      var balances = StateMap<String, UInt64>("balances");
+      balances.set("alice", 10u64);
+      balances["bob"] = 20u64;
+    endfunction
+  )";
+
+  EXPECT_CALL(toolkit.observer(), Write("balances.alice", _, _));
+  EXPECT_CALL(toolkit.observer(), Write("balances.bob", _, _));
+  EXPECT_CALL(toolkit.observer(), Write("balances", _, _)).Times(0);
+
+  ASSERT_TRUE(toolkit.Compile(ser_src));
+  ASSERT_TRUE(toolkit.Run());
+
+  static char const *deser_src = R"(
+    function main() : UInt64
+      var balances = StateMap<String, UInt64>("balances");
+      var total = balances.get("alice") + balances["alice"] + balances.get("bob");
+      if (balances.has("carol"))
+        return 0u64;
+      endif
+      return total + balances.get("carol", 5u64);
+    endfunction
+  )";
+
+  // each entry is read at most once, and untouched entries are never read
+  EXPECT_CALL(toolkit.observer(), Read("balances.alice", _, _)).Times(1);
+  EXPECT_CALL(toolkit.observer(), Read("balances.bob", _, _)).Times(1);
+  EXPECT_CALL(toolkit.observer(), Exists("balances.carol")).Times(1);
+  EXPECT_CALL(toolkit.observer(), Write(_, _, _)).Times(0);
+
+  ASSERT_TRUE(toolkit.Compile(deser_src));
+
+  Variant res;
+  ASSERT_TRUE(toolkit.Run(&res));
+  EXPECT_EQ(res.Get<uint64_t>(), 45u);
+}
+
+TEST_F(StateTests, state_map_only_writes_modified_entries)
+{
+  toolkit.AddState("accounts.1", "0a00000000000000");
+  toolkit.AddState("accounts.2", "1400000000000000");
+
+  static char const *TEXT = R"(
+    function main() : Int64
+      var accounts = StateMap<Int32, Int64>("accounts");
+      accounts[2] = accounts[2] + accounts[1];
+      accounts[2] = accounts[2] * 2i64;
+      return accounts[2];
+    endfunction
+  )";
+
+  EXPECT_CALL(toolkit.observer(), Write("accounts.1", _, _)).Times(0);
+  EXPECT_CALL(toolkit.observer(), Write("accounts.2", _, _)).Times(1);
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+
+  Variant res;
+  ASSERT_TRUE(toolkit.Run(&res));
+  EXPECT_EQ(res.Get<int64_t>(), 60);
+}
+
+TEST_F(StateTests, state_map_of_objects_round_trips)
+{
+  static char const *ser_src = R"(
+    function main()
+      var names = StateMap<Address, String>("names");
+      names[Address("MnrRHdvCkdZodEwM855vemS5V3p2hiWmcSQ8JEzD4ZjPdsYtB")] = "alice";
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(ser_src));
+  ASSERT_TRUE(toolkit.Run());
+
+  static char const *deser_src = R"(
+    function main()
+      var names = StateMap<Address, String>("names");
+      print(names[Address("MnrRHdvCkdZodEwM855vemS5V3p2hiWmcSQ8JEzD4ZjPdsYtB")]);
+    endfunction
+  )";
+
+  EXPECT_CALL(toolkit.observer(),
+              Read("names.MnrRHdvCkdZodEwM855vemS5V3p2hiWmcSQ8JEzD4ZjPdsYtB", _, _));
+
+  ASSERT_TRUE(toolkit.Compile(deser_src));
+  ASSERT_TRUE(toolkit.Run());
+
+  EXPECT_EQ(out.str(), "alice");
+}
+
+TEST_F(StateTests, getting_missing_state_map_entry_fails)
+{
+  static char const *TEXT = R"(
+    function main()
+      var m = StateMap<String, Int32>("m");
+      m.get("missing");
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+  ASSERT_FALSE(toolkit.Run());
+}
+
+TEST_F(StateTests, state_array_elements_are_stored_under_individual_keys)
+{
+  static char const *ser_src = R"(
+    function main()
+      var log = StateArray<String>("log");
+      log.append("first");
+      log.append("second");
+      log.append("third");
+      log[1] = "SECOND";
+    endfunction
+  )";
+
+  EXPECT_CALL(toolkit.observer(), Write("log", _, _)).Times(1);
+  EXPECT_CALL(toolkit.observer(), Write("log.0", _, _)).Times(1);
+  EXPECT_CALL(toolkit.observer(), Write("log.1", _, _)).Times(1);
+  EXPECT_CALL(toolkit.observer(), Write("log.2", _, _)).Times(1);
+
+  ASSERT_TRUE(toolkit.Compile(ser_src));
+  ASSERT_TRUE(toolkit.Run());
+
+  static char const *deser_src = R"(
+    function main()
+      var log = StateArray<String>("log");
+      print(log.count());
+      print(' ');
+      print(log[1]);
+      print(' ');
+      print(log.popBack());
+      print(' ');
+      print(log.count());
+    endfunction
+  )";
+
+  EXPECT_CALL(toolkit.observer(), Read("log.0", _, _)).Times(0);
+  EXPECT_CALL(toolkit.observer(), Read("log.1", _, _)).Times(1);
+  EXPECT_CALL(toolkit.observer(), Read("log.2", _, _)).Times(1);
+  EXPECT_CALL(toolkit.observer(), Write("log", _, _)).Times(1);
+  EXPECT_CALL(toolkit.observer(), Write("log.2", _, _)).Times(0);
+
+  ASSERT_TRUE(toolkit.Compile(deser_src));
+  ASSERT_TRUE(toolkit.Run());
+
+  EXPECT_EQ(out.str(), "3 SECOND third 2");
+}
+
+TEST_F(StateTests, indexing_state_array_out_of_bounds_fails)
+{
+  static char const *TEXT = R"(
+    function main()
+      var a = StateArray<Int32>("a");
+      a.append(1);
+      print(a[1]);
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+  ASSERT_FALSE(toolkit.Run());
+  EXPECT_THAT(out.str(), ::testing::HasSubstr("index out of bounds"));
+}
+
+TEST_F(StateTests, state_collection_charges_scale_with_bytes_written)
+{
+  static char const *SHORT_TEXT = R"(
+    function main()
+      var m = StateMap<Int32, String>("m");
+      m[0] = "x";
+    endfunction
+  )";
+  static char const *LONG_TEXT = R"(
+    function main()
+      var m = StateMap<Int32, String>("m");
+      m[0] = "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx";
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(SHORT_TEXT));
+  ASSERT_TRUE(toolkit.Run());
+  auto const short_charge = toolkit.vm().GetChargeTotal();
+
+  ASSERT_TRUE(toolkit.Compile(LONG_TEXT));
+  ASSERT_TRUE(toolkit.Run());
+  auto const long_charge = toolkit.vm().GetChargeTotal();
+
+  EXPECT_GE(long_charge, short_charge + 63u);
+}
+
 }  // namespace
@@ -292,6 +292,8 @@ private:
   TypePtr        map_type_;
   TypePtr        pair_type_;
   TypePtr        sharded_state_type_;
+  TypePtr        state_map_type_;
+  TypePtr        state_array_type_;
   TypePtr        state_type_;
   TypePtr        initialiser_list_type_;
 
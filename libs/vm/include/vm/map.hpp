@@ -20,9 +20,14 @@
 #include "vectorise/fixed_point/fixed_point.hpp"
 #include "vm/vm.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <map>
+#include <random>
+#include <utility>
+#include <vector>
 
 namespace fetch {
 namespace vm {
@@ -71,6 +76,283 @@ struct MapComparator<T, IfIsPtr<T>>
   }
 };
 
+template <typename T, typename = void>
+struct MapKeyHasher;
+
+template <typename T>
+struct MapKeyHasher<T, std::enable_if_t<IsPrimitive<T> && !math::meta::IsFixedPoint<T>>>
+{
+  std::size_t operator()(fetch::vm::TemplateParameter1 const &key) const
+  {
+    return std::hash<T>{}(key.primitive.Get<T>());
+  }
+};
+
+template <typename T>
+struct MapKeyHasher<T, std::enable_if_t<math::meta::IsFixedPoint<T>>>
+{
+  std::size_t operator()(fetch::vm::TemplateParameter1 const &key) const
+  {
+    return std::hash<typename T::Type>{}(key.primitive.Get<T>().Data());
+  }
+};
+
+template <typename T>
+struct MapKeyHasher<T, IfIsPtr<T>>
+{
+  std::size_t operator()(fetch::vm::TemplateParameter1 const &key) const
+  {
+    return key.object->GetHashCode();
+  }
+};
+
+template <typename T, typename = void>
+struct MapKeyEqual;
+
+template <typename T>
+struct MapKeyEqual<T, IfIsPrimitive<T>>
+{
+  bool operator()(fetch::vm::TemplateParameter1 const &lhs,
+                  fetch::vm::TemplateParameter1 const &rhs) const
+  {
+    return lhs.primitive.Get<T>() == rhs.primitive.Get<T>();
+  }
+};
+
+template <typename T>
+struct MapKeyEqual<T, IfIsPtr<T>>
+{
+  bool operator()(fetch::vm::TemplateParameter1 const &lhs,
+                  fetch::vm::TemplateParameter1 const &rhs) const
+  {
+    return lhs.object->IsEqual(lhs.object, rhs.object);
+  }
+};
+
+/**
+ * Flat hash table holding the entries of a Map.
+ *
+ * Entries are kept contiguously in insertion order and are located through an open addressing
+ * index (linear probing) of offsets into the entry array, so a lookup touches at most a couple of
+ * cache lines and an insertion does not allocate a node. Object keys are hashed with
+ * Object::GetHashCode and compared with Object::IsEqual.
+ *
+ * Contracts choose the keys, so they could pick ones which collide in the index and make every
+ * operation a linear scan while each is charged a fixed amount. Hashes are therefore mixed with a
+ * seed which is random to each node, and no key may be placed further than MAX_PROBE_DISTANCE
+ * slots from where its hash points. Should that ever be necessary, e.g. because the hash codes of
+ * object keys collide outright, the table falls back to an ordered index of the entries, so that
+ * every operation stays within O(log n) like the std::map this replaced.
+ *
+ * The position of an entry depends on the hash of its key, which need not be the same on every
+ * node, so anything observable (i.e. serialisation) must go through Sorted().
+ */
+template <typename Key>
+class MapStorage
+{
+public:
+  struct Entry
+  {
+    TemplateParameter1 key;
+    TemplateParameter2 value;
+    std::size_t        hash;
+  };
+
+  using EntryArray    = std::vector<Entry>;
+  using EntryPtrArray = std::vector<Entry const *>;
+
+  std::size_t size() const
+  {
+    return entries_.size();
+  }
+
+  TemplateParameter2 *Find(TemplateParameter1 const &key)
+  {
+    if (entries_.empty())
+    {
+      return nullptr;
+    }
+
+    if (ordered_)
+    {
+      auto const it = ordered_index_.find(key);
+      return (it == ordered_index_.end()) ? nullptr : &entries_[it->second].value;
+    }
+
+    // no key is further than max_distance_ from its slot, so the probe can stop there
+    std::size_t const hash = Hash(key);
+    std::size_t       slot = hash & mask_;
+    for (std::size_t distance = 0; distance <= max_distance_; ++distance)
+    {
+      uint32_t const offset = slots_[slot];
+      if (offset == EMPTY)
+      {
+        return nullptr;
+      }
+
+      Entry &entry = entries_[offset - 1];
+      if ((entry.hash == hash) && MapKeyEqual<Key>{}(entry.key, key))
+      {
+        return &entry.value;
+      }
+
+      slot = (slot + 1) & mask_;
+    }
+
+    return nullptr;
+  }
+
+  /// Returns the value stored under `key`, inserting a default constructed one if there is none.
+  /// The flag is set if the entry has been inserted.
+  std::pair<TemplateParameter2 *, bool> Emplace(TemplateParameter1 const &key)
+  {
+    // keep the load factor of the index at most 3/4
+    if (!ordered_ && ((entries_.size() + 1) * 4 > slots_.size() * 3))
+    {
+      Rehash(slots_.empty() ? MIN_SLOTS : slots_.size() * 2);
+    }
+
+    if (!ordered_)
+    {
+      std::size_t const hash = Hash(key);
+      std::size_t       slot = hash & mask_;
+      for (std::size_t distance = 0; distance <= MAX_PROBE_DISTANCE; ++distance)
+      {
+        uint32_t const offset = slots_[slot];
+        if (offset == EMPTY)
+        {
+          entries_.push_back(Entry{key, TemplateParameter2{}, hash});
+          slots_[slot]  = static_cast<uint32_t>(entries_.size());
+          max_distance_ = std::max(max_distance_, distance);
+          return {&entries_.back().value, true};
+        }
+
+        Entry &entry = entries_[offset - 1];
+        if ((entry.hash == hash) && MapKeyEqual<Key>{}(entry.key, key))
+        {
+          return {&entry.value, false};
+        }
+
+        slot = (slot + 1) & mask_;
+      }
+
+      // the key is not in the table, nor can it be placed within reach of its slot
+      SwitchToOrderedIndex();
+    }
+
+    auto const inserted = ordered_index_.emplace(key, entries_.size());
+    if (!inserted.second)
+    {
+      return {&entries_[inserted.first->second].value, false};
+    }
+
+    entries_.push_back(Entry{key, TemplateParameter2{}, 0});
+    return {&entries_.back().value, true};
+  }
+
+  /// Entries ordered by key, independently of the insertion order and of the hashes of the keys
+  EntryPtrArray Sorted() const
+  {
+    EntryPtrArray sorted;
+    sorted.reserve(entries_.size());
+    for (auto const &entry : entries_)
+    {
+      sorted.push_back(&entry);
+    }
+
+    MapComparator<Key> const less{};
+    std::sort(sorted.begin(), sorted.end(),
+              [&less](Entry const *lhs, Entry const *rhs) { return less(lhs->key, rhs->key); });
+
+    return sorted;
+  }
+
+  /// Whether the entries are located through the ordered index rather than by hash
+  bool IsOrdered() const
+  {
+    return ordered_;
+  }
+
+private:
+  using OrderedIndex = std::map<TemplateParameter1, std::size_t, MapComparator<Key>>;
+
+  static constexpr uint32_t    EMPTY              = 0;
+  static constexpr std::size_t MIN_SLOTS          = 8;
+  static constexpr std::size_t MAX_PROBE_DISTANCE = 64;
+
+  static std::size_t Seed()
+  {
+    static std::size_t const seed = []() {
+      std::random_device device;
+      return (static_cast<std::size_t>(device()) << 32u) ^ static_cast<std::size_t>(device());
+    }();
+    return seed;
+  }
+
+  static std::size_t Hash(TemplateParameter1 const &key)
+  {
+    // seeded finaliser, as the standard hashes are commonly the identity for integers
+    auto h = static_cast<uint64_t>(MapKeyHasher<Key>{}(key)) ^ static_cast<uint64_t>(Seed());
+    h ^= h >> 33u;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33u;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33u;
+    return static_cast<std::size_t>(h);
+  }
+
+  void Rehash(std::size_t num_slots)
+  {
+    slots_.assign(num_slots, EMPTY);
+    mask_         = num_slots - 1;
+    max_distance_ = 0;
+
+    for (std::size_t i = 0; i < entries_.size(); ++i)
+    {
+      std::size_t slot     = entries_[i].hash & mask_;
+      std::size_t distance = 0;
+      while (slots_[slot] != EMPTY)
+      {
+        slot = (slot + 1) & mask_;
+        if (++distance > MAX_PROBE_DISTANCE)
+        {
+          SwitchToOrderedIndex();
+          return;
+        }
+      }
+      slots_[slot]  = static_cast<uint32_t>(i + 1);
+      max_distance_ = std::max(max_distance_, distance);
+    }
+  }
+
+  void SwitchToOrderedIndex()
+  {
+    ordered_ = true;
+    for (std::size_t i = 0; i < entries_.size(); ++i)
+    {
+      ordered_index_.emplace(entries_[i].key, i);
+    }
+
+    slots_        = std::vector<uint32_t>{};
+    mask_         = 0;
+    max_distance_ = 0;
+  }
+
+  EntryArray            entries_;
+  std::vector<uint32_t> slots_;  // offset + 1 into entries_, or EMPTY
+  std::size_t           mask_{0};
+  std::size_t           max_distance_{0};  // furthest any entry is from the slot its hash points to
+  bool                  ordered_{false};
+  OrderedIndex          ordered_index_;
+};
+
+template <typename Key>
+constexpr uint32_t MapStorage<Key>::EMPTY;
+template <typename Key>
+constexpr std::size_t MapStorage<Key>::MIN_SLOTS;
+template <typename Key>
+constexpr std::size_t MapStorage<Key>::MAX_PROBE_DISTANCE;
+
 template <typename Key, typename Value>
 struct Map : public IMap
 {
@@ -86,11 +368,10 @@ struct Map : public IMap
 
   TemplateParameter2 *Find(TemplateParameter1 const &key)
   {
-    auto it = map.find(key);
-    if (it != map.end())
+    TemplateParameter2 *value = map.Find(key);
+    if (value != nullptr)
     {
-      TemplateParameter2 &value = it->second;
-      return &value;
+      return value;
     }
     RuntimeError("map key does not exist");
     return nullptr;
@@ -127,7 +408,7 @@ struct Map : public IMap
   template <typename U>
   IfIsPrimitive<U> Store(TemplateParameter1 const &key, TemplateParameter2 const &value)
   {
-    map[key] = value;
+    *map.Emplace(key).first = value;
   }
 
   template <typename U>
@@ -135,7 +416,7 @@ struct Map : public IMap
   {
     if (key.object)
     {
-      map[key] = value;
+      *map.Emplace(key).first = value;
       return;
     }
     RuntimeError("map key is null reference");
@@ -151,14 +432,14 @@ struct Map : public IMap
     auto constructor = buffer.NewMapConstructor();
     auto map_ser     = constructor(map.size());
 
-    for (auto const &v : map)
+    for (auto const *v : map.Sorted())
     {
-      auto f1 = [&v, this](MsgPackSerializer &serializer) {
-        return SerializeElement<Key>(serializer, v.first);
+      auto f1 = [v, this](MsgPackSerializer &serializer) {
+        return SerializeElement<Key>(serializer, v->key);
       };
 
-      auto f2 = [&v, this](MsgPackSerializer &serializer) {
-        return SerializeElement<Value>(serializer, v.second);
+      auto f2 = [v, this](MsgPackSerializer &serializer) {
+        return SerializeElement<Value>(serializer, v->value);
       };
 
       if (!map_ser.AppendUsingFunction(f1, f2))
@@ -195,13 +476,17 @@ struct Map : public IMap
         return false;
       }
 
-      map.insert({key, value});
+      auto const inserted = map.Emplace(key);
+      if (inserted.second)
+      {
+        *inserted.first = value;
+      }
     }
 
     return true;
   }
 
-  std::map<TemplateParameter1, TemplateParameter2, MapComparator<Key>> map;
+  MapStorage<Key> map;
 
 private:
   template <typename U, typename TemplateParameterType>
@@ -127,7 +127,27 @@ static constexpr uint16_t MemberVariablePrimitiveInplaceModulo     = 100;
 static constexpr uint16_t PushSelf                                 = 101;
 static constexpr uint16_t InvokeUserDefinedConstructor             = 102;
 static constexpr uint16_t InvokeUserDefinedMemberFunction          = 103;
-static constexpr uint16_t NumReserved                              = 104;
+// Superinstructions (only ever emitted by the Optimiser)
+static constexpr uint16_t LocalVariablePrimitiveAddConstant        = 104;
+static constexpr uint16_t LocalVariablePrimitiveSubtractConstant   = 105;
+static constexpr uint16_t LocalVariablePrimitiveMultiplyConstant   = 106;
+static constexpr uint16_t LocalVariablePrimitiveDivideConstant     = 107;
+static constexpr uint16_t PrimitiveEqualJumpIfFalse                = 108;
+static constexpr uint16_t PrimitiveNotEqualJumpIfFalse             = 109;
+static constexpr uint16_t PrimitiveLessThanJumpIfFalse             = 110;
+static constexpr uint16_t PrimitiveLessThanOrEqualJumpIfFalse      = 111;
+static constexpr uint16_t PrimitiveGreaterThanJumpIfFalse          = 112;
+static constexpr uint16_t PrimitiveGreaterThanOrEqualJumpIfFalse   = 113;
+static constexpr uint16_t ForRangeIterateJump                      = 114;
+static constexpr uint16_t PushFoldedNegate                         = 115;
+static constexpr uint16_t PushFoldedAdd                            = 116;
+static constexpr uint16_t PushFoldedSubtract                       = 117;
+static constexpr uint16_t PushFoldedMultiply                       = 118;
+static constexpr uint16_t PushFoldedDivide                         = 119;
+static constexpr uint16_t PushFoldedModulo                         = 120;
+static constexpr uint16_t DeadConstantStore                        = 121;
+static constexpr uint16_t LocalVariableDeclareDeadConstant         = 122;
+static constexpr uint16_t NumReserved                              = 123;
 }  // namespace Opcodes
 
 }  // namespace vm
@@ -0,0 +1,89 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/generator.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fetch {
+namespace vm {
+
+/**
+ * Peephole optimiser run by the Generator over the instructions of every function in a freshly
+ * generated executable.
+ *
+ * The passes are, in order:
+ *
+ *  - constant folding of integral arithmetic on constants:
+ *      constant <op> constant       ->  PushFolded<Op>
+ *  - dead store elimination of constants stored to primitive locals which are overwritten (or the
+ *    function returns) before being read again within the same basic block:
+ *      local = constant             ->  DeadConstantStore
+ *      var local = constant         ->  LocalVariableDeclareDeadConstant
+ *  - fusion of common instruction sequences into superinstructions:
+ *      local = local <op> constant  ->  LocalVariablePrimitive<Op>Constant
+ *      <relational op>, JumpIfFalse ->  Primitive<RelationalOp>JumpIfFalse
+ *      Jump to ForRangeIterate      ->  ForRangeIterateJump
+ *
+ * Every rewrite produces a superinstruction, which is charged the sum of the static charges of the
+ * instructions it replaces (see VM::UpdateSuperInstructionCharges), so the optimiser never alters
+ * the charge of a contract. For the same reason folded constants are not folded again.
+ */
+class Optimiser
+{
+public:
+  Optimiser()  = default;
+  ~Optimiser() = default;
+
+  void Optimise(Executable &executable);
+
+private:
+  using Instruction      = Executable::Instruction;
+  using InstructionArray = Executable::InstructionArray;
+  using Flags            = std::vector<bool>;
+
+  static const uint16_t MAX_CONSTANTS = 2048;
+
+  Executable *executable_{};
+
+  void OptimiseFunction(Executable::Function &function);
+  bool FoldConstants(Executable::Function &function);
+  bool EliminateDeadStores(Executable::Function &function);
+  bool FuseSuperInstructions(Executable::Function &function);
+  void FuseForRangeLoops(Executable::Function &function);
+  void Compact(Executable::Function &function, Flags const &removed);
+
+  bool FoldOp(Instruction const &lhs, Instruction const *rhs, Instruction const &op,
+              uint16_t &index);
+  bool AddConstant(Variant const &c, uint16_t &index);
+
+  static Flags    FindJumpTargets(InstructionArray const &instructions);
+  static bool     IsDeadStore(InstructionArray const &instructions, Flags const &jump_targets,
+                              std::size_t pc);
+  static bool     HasJumpDestination(uint16_t opcode);
+  static bool     IsLocalVariableAccess(uint16_t opcode);
+  static uint16_t GetFoldedOpcode(uint16_t opcode);
+  static uint16_t GetFusedConstantOpcode(uint16_t opcode);
+  static uint16_t GetFusedJumpIfFalseOpcode(uint16_t opcode);
+};
+
+}  // namespace vm
+}  // namespace fetch
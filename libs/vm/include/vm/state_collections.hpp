@@ -0,0 +1,93 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/address.hpp"
+#include "vm/vm.hpp"
+
+#include <cstdint>
+
+namespace fetch {
+namespace vm {
+
+/**
+ * Persistent map whose entries are stored as individual keys ("<name>.<key>") in the state
+ * database rather than as a single serialised object.
+ *
+ * Entries are read lazily on first access and cached for the lifetime of the object. Updated
+ * entries are only written back when the object is destroyed, and only the entries which have
+ * actually been modified are written. Every entry read from or written to storage is charged by
+ * the number of bytes transferred.
+ *
+ * Keys must be integral, String or Address.
+ */
+class IStateMap : public Object
+{
+public:
+  IStateMap()           = delete;
+  ~IStateMap() override = default;
+
+  static Ptr<IStateMap> ConstructorFromString(VM *vm, TypeId type_id, Ptr<String> const &name);
+  static Ptr<IStateMap> ConstructorFromAddress(VM *vm, TypeId type_id, Ptr<Address> const &name);
+
+  virtual TemplateParameter2 Get(TemplateParameter1 const &key) = 0;
+  virtual TemplateParameter2 GetWithDefault(TemplateParameter1 const &key,
+                                            TemplateParameter2 const &default_value) = 0;
+  virtual void Set(TemplateParameter1 const &key, TemplateParameter2 const &value)   = 0;
+  virtual bool Has(TemplateParameter1 const &key)                                    = 0;
+
+  virtual TemplateParameter2 GetIndexedValue(TemplateParameter1 const &key)                    = 0;
+  virtual void SetIndexedValue(TemplateParameter1 const &key, TemplateParameter2 const &value) = 0;
+
+protected:
+  IStateMap(VM *vm, TypeId type_id)
+    : Object(vm, type_id)
+  {}
+};
+
+/**
+ * Persistent array whose elements are stored as individual keys ("<name>.<index>") in the state
+ * database, with the number of elements stored under "<name>" itself.
+ *
+ * Has the same lazy loading, write-back and charging behaviour as IStateMap.
+ */
+class IStateArray : public Object
+{
+public:
+  IStateArray()           = delete;
+  ~IStateArray() override = default;
+
+  static Ptr<IStateArray> ConstructorFromString(VM *vm, TypeId type_id, Ptr<String> const &name);
+  static Ptr<IStateArray> ConstructorFromAddress(VM *vm, TypeId type_id,
+                                                 Ptr<Address> const &name);
+
+  virtual int32_t            Count()                            = 0;
+  virtual void               Append(TemplateParameter1 const &) = 0;
+  virtual TemplateParameter1 PopBack()                          = 0;
+
+  virtual TemplateParameter1 GetIndexedValue(AnyInteger const &index)                    = 0;
+  virtual void SetIndexedValue(AnyInteger const &index, TemplateParameter1 const &value) = 0;
+
+protected:
+  IStateArray(VM *vm, TypeId type_id)
+    : Object(vm, type_id)
+  {}
+};
+
+}  // namespace vm
+}  // namespace fetch
@@ -597,8 +597,9 @@ private:
   static const int STACK_SIZE       = 1024;
   static const int MAX_RANGE_LOOPS  = 16;
 
-  using OpcodeInfoArray = std::vector<OpcodeInfo>;
-  using OpcodeMap       = std::unordered_map<std::string, uint16_t>;
+  using OpcodeInfoArray     = std::vector<OpcodeInfo>;
+  using OpcodeMap           = std::unordered_map<std::string, uint16_t>;
+  using SuperInstructionMap = std::unordered_map<uint16_t, std::vector<uint16_t>>;
 
   struct Frame
   {
@@ -646,6 +647,7 @@ private:
   RegisteredTypes                registered_types_;
   OpcodeInfoArray                opcode_info_array_;
   OpcodeMap                      opcode_map_;
+  SuperInstructionMap            super_instructions_;
   Generator                      generator_;
   Executable const *             executable_{};
   Executable::Function const *   function_{};
@@ -686,8 +688,20 @@ private:
         OpcodeInfo(std::move(unique_name), std::move(handler), static_charge);
   }
 
+  /// Registers an opcode which stands in for a sequence of other opcodes. Its static charge is
+  /// kept equal to the sum of the static charges of that sequence.
+  void AddSuperInstructionInfo(uint16_t opcode, std::string unique_name, Handler handler,
+                               std::vector<uint16_t> constituents)
+  {
+    AddOpcodeInfo(opcode, std::move(unique_name), std::move(handler));
+    super_instructions_[opcode] = std::move(constituents);
+  }
+
+  void UpdateSuperInstructionCharges();
+
   bool Execute(std::string &error, Variant &output);
   void Destruct(uint16_t scope_number);
+  bool ForRangeStep();
 
   TypeId FindType(std::string const &name) const
   {
@@ -1587,6 +1601,20 @@ private:
     rhsv.Reset();
   }
 
+  template <typename Op>
+  void DoPrimitiveRelationalJumpIfFalseOp()
+  {
+    Variant &rhsv = Pop();
+    Variant &lhsv = Pop();
+    ExecutePrimitiveRelationalOp<Op>(instruction_->type_id, lhsv, rhsv);
+    if (lhsv.primitive.ui8 == 0)
+    {
+      pc_ = instruction_->index;
+    }
+    lhsv.Reset();
+    rhsv.Reset();
+  }
+
   template <typename Op>
   void DoObjectRelationalOp()
   {
@@ -1789,6 +1817,14 @@ private:
     DoNumericInplaceOp<Op>(instruction_->type_id, &variable.primitive);
   }
 
+  template <typename Op>
+  void DoLocalVariableNumericConstantOp()
+  {
+    Variant &variable = GetLocalVariable(instruction_->index);
+    Variant  constant = executable_->constants[instruction_->data];
+    ExecuteNumericInplaceOp<Op>(instruction_->type_id, &variable.primitive, constant);
+  }
+
   template <typename Op>
   void DoLocalVariableObjectInplaceOp()
   {
@@ -1983,6 +2019,17 @@ private:
   void Handler__PushSelf();
   void Handler__InvokeUserDefinedConstructor();
   void Handler__InvokeUserDefinedMemberFunction();
+  void Handler__LocalVariablePrimitiveAddConstant();
+  void Handler__LocalVariablePrimitiveSubtractConstant();
+  void Handler__LocalVariablePrimitiveMultiplyConstant();
+  void Handler__LocalVariablePrimitiveDivideConstant();
+  void Handler__PrimitiveEqualJumpIfFalse();
+  void Handler__PrimitiveNotEqualJumpIfFalse();
+  void Handler__PrimitiveLessThanJumpIfFalse();
+  void Handler__PrimitiveLessThanOrEqualJumpIfFalse();
+  void Handler__PrimitiveGreaterThanJumpIfFalse();
+  void Handler__PrimitiveGreaterThanOrEqualJumpIfFalse();
+  void Handler__ForRangeIterateJump();
 
   friend class Object;
   friend class Module;
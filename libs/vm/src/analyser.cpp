@@ -24,6 +24,7 @@
 #include "vm/pair.hpp"
 #include "vm/sharded_state.hpp"
 #include "vm/state.hpp"
+#include "vm/state_collections.hpp"
 #include "vm/string.hpp"
 
 #include <cassert>
@@ -201,6 +202,10 @@ void Analyser::Initialise(bool use_test_annotations)
                      state_type_);
   CreateTemplateType("ShardedState", TypeIndex(typeid(IShardedState)), {any_type_},
                      TypeIds::Unknown, sharded_state_type_);
+  CreateTemplateType("StateMap", TypeIndex(typeid(IStateMap)), {any_type_, any_type_},
+                     TypeIds::Unknown, state_map_type_);
+  CreateTemplateType("StateArray", TypeIndex(typeid(IStateArray)), {any_type_}, TypeIds::Unknown,
+                     state_array_type_);
 }
 
 void Analyser::UnInitialise()
@@ -245,6 +250,8 @@ void Analyser::UnInitialise()
   state_type_               = nullptr;
   address_type_             = nullptr;
   sharded_state_type_       = nullptr;
+  state_map_type_           = nullptr;
+  state_array_type_         = nullptr;
   initialiser_list_type_    = nullptr;
 }
 
@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <string>
 
 namespace fetch {
@@ -46,6 +47,13 @@ Ptr<Fixed128> Fixed128::Copy() const
   return Ptr<Fixed128>{new Fixed128{this->vm_, this->data_}};
 }
 
+std::size_t Fixed128::GetHashCode()
+{
+  auto const raw = static_cast<uint128_t>(data_.Data());
+  return std::hash<uint64_t>{}(static_cast<uint64_t>(raw)) ^
+         (std::hash<uint64_t>{}(static_cast<uint64_t>(raw >> 64u)) * 31u);
+}
+
 bool Fixed128::IsEqual(Ptr<Object> const &lhso, Ptr<Object> const &rhso)
 {
   Ptr<Fixed128> lhs = lhso;
@@ -17,6 +17,7 @@
 //------------------------------------------------------------------------------
 
 #include "vm/generator.hpp"
+#include "vm/optimiser.hpp"
 #include "vm/vm.hpp"
 
 #include <cstddef>
@@ -103,6 +104,9 @@ bool Generator::GenerateExecutable(IR const &ir, std::string const &executable_n
     return false;
   }
 
+  Optimiser optimiser;
+  optimiser.Optimise(executable_);
+
   executable = executable_;
   return true;
 }
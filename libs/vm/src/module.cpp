@@ -26,6 +26,7 @@
 #include "vm/pair.hpp"
 #include "vm/sharded_state.hpp"
 #include "vm/state.hpp"
+#include "vm/state_collections.hpp"
 #include "vm/string.hpp"
 #include "vm/variant.hpp"
 #include "vm/vm.hpp"
@@ -361,6 +362,23 @@ Module::Module()
       .CreateMemberFunction("set", &IShardedState::SetFromString)
       .CreateMemberFunction("set", &IShardedState::SetFromAddress);
 
+  GetClassInterface<IStateMap>()
+      .CreateConstructor(&IStateMap::ConstructorFromString)
+      .CreateConstructor(&IStateMap::ConstructorFromAddress)
+      .CreateMemberFunction("get", &IStateMap::Get)
+      .CreateMemberFunction("get", &IStateMap::GetWithDefault)
+      .CreateMemberFunction("set", &IStateMap::Set)
+      .CreateMemberFunction("has", &IStateMap::Has)
+      .EnableIndexOperator(&IStateMap::GetIndexedValue, &IStateMap::SetIndexedValue);
+
+  GetClassInterface<IStateArray>()
+      .CreateConstructor(&IStateArray::ConstructorFromString)
+      .CreateConstructor(&IStateArray::ConstructorFromAddress)
+      .CreateMemberFunction("append", &IStateArray::Append)
+      .CreateMemberFunction("count", &IStateArray::Count)
+      .CreateMemberFunction("popBack", &IStateArray::PopBack)
+      .EnableIndexOperator(&IStateArray::GetIndexedValue, &IStateArray::SetIndexedValue);
+
   GetClassInterface<Fixed128>()
       .CreateSerializeDefaultConstructor([](VM *vm, TypeId) -> Ptr<Fixed128> {
         return Ptr<Fixed128>{new Fixed128(vm, fixed_point::fp128_t::_0)};
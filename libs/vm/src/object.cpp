@@ -95,7 +95,10 @@ bool Object::GetNonNegativeInteger(Variant const &v, std::size_t &index)
 
 std::size_t Object::GetHashCode()
 {
-  return std::hash<const void *>()(this);
+  // Types which can be compared with IsEqual must hash by value as well, an identity hash would
+  // make equal keys miss each other
+  RuntimeError(std::string(__func__) + ": operator not implemented");
+  return 0;
 }
 
 bool Object::IsEqual(Ptr<Object> const & /* lhso */, Ptr<Object> const & /* rhso */)
@@ -0,0 +1,783 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/opcodes.hpp"
+#include "vm/optimiser.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace vm {
+
+namespace {
+
+bool IsNumeric(TypeId type_id)
+{
+  return (type_id >= TypeIds::Int8) && (type_id <= TypeIds::Fixed64);
+}
+
+template <typename T>
+bool Evaluate(uint16_t opcode, Variant const &lhsv, Variant const *rhsv, TypeId type_id,
+              Variant &result)
+{
+  T const lhs = lhsv.Get<T>();
+  T const rhs = (rhsv != nullptr) ? rhsv->Get<T>() : T{0};
+  T       value{0};
+
+  // NOTE: The expressions below mirror the VM's Primitive* opcode handlers exactly so that a
+  // folded constant is bit-for-bit identical to the value computed at runtime
+  switch (opcode)
+  {
+  case Opcodes::PrimitiveNegate:
+  {
+    value = T(-lhs);
+    break;
+  }
+  case Opcodes::PrimitiveAdd:
+  {
+    value = T(lhs + rhs);
+    break;
+  }
+  case Opcodes::PrimitiveSubtract:
+  {
+    value = T(lhs - rhs);
+    break;
+  }
+  case Opcodes::PrimitiveMultiply:
+  {
+    value = T(lhs * rhs);
+    break;
+  }
+  case Opcodes::PrimitiveDivide:
+  case Opcodes::PrimitiveModulo:
+  {
+    // Division by zero (and the overflowing min / -1) must still fail at runtime
+    if ((rhs == 0) || ((lhs == std::numeric_limits<T>::min()) && (rhs == T(-1))))
+    {
+      return false;
+    }
+    value = (opcode == Opcodes::PrimitiveDivide) ? T(lhs / rhs) : T(lhs % rhs);
+    break;
+  }
+  default:
+  {
+    return false;
+  }
+  }  // switch
+
+  result = Variant(value, type_id);
+  return true;
+}
+
+bool IsSameConstant(Variant const &lhs, Variant const &rhs)
+{
+  if (lhs.type_id != rhs.type_id)
+  {
+    return false;
+  }
+  switch (lhs.type_id)
+  {
+  case TypeIds::Int8:
+  {
+    return lhs.primitive.i8 == rhs.primitive.i8;
+  }
+  case TypeIds::UInt8:
+  {
+    return lhs.primitive.ui8 == rhs.primitive.ui8;
+  }
+  case TypeIds::Int16:
+  {
+    return lhs.primitive.i16 == rhs.primitive.i16;
+  }
+  case TypeIds::UInt16:
+  {
+    return lhs.primitive.ui16 == rhs.primitive.ui16;
+  }
+  case TypeIds::Int32:
+  case TypeIds::Fixed32:
+  {
+    return lhs.primitive.i32 == rhs.primitive.i32;
+  }
+  case TypeIds::UInt32:
+  {
+    return lhs.primitive.ui32 == rhs.primitive.ui32;
+  }
+  case TypeIds::Int64:
+  case TypeIds::Fixed64:
+  {
+    return lhs.primitive.i64 == rhs.primitive.i64;
+  }
+  case TypeIds::UInt64:
+  {
+    return lhs.primitive.ui64 == rhs.primitive.ui64;
+  }
+  default:
+  {
+    return false;
+  }
+  }  // switch
+}
+
+}  // namespace
+
+void Optimiser::Optimise(Executable &executable)
+{
+  executable_ = &executable;
+
+  for (auto &function : executable.functions)
+  {
+    OptimiseFunction(function);
+  }
+
+  for (auto &type : executable.user_defined_types)
+  {
+    for (auto &function : type.functions)
+    {
+      OptimiseFunction(function);
+    }
+  }
+
+  executable_ = nullptr;
+}
+
+void Optimiser::OptimiseFunction(Executable::Function &function)
+{
+  // Folded constants are not folded again, since their charge already covers the instructions
+  // they replaced. Store elimination can expose further dead stores, so it is repeated until the
+  // function stops shrinking
+  FoldConstants(function);
+
+  while (EliminateDeadStores(function))
+  {
+  }
+
+  FuseSuperInstructions(function);
+
+  // Must run last: it introduces a new jump destination which earlier passes may not remove
+  FuseForRangeLoops(function);
+}
+
+bool Optimiser::FoldConstants(Executable::Function &function)
+{
+  InstructionArray &instructions = function.instructions;
+  std::size_t const size         = instructions.size();
+  Flags const       jump_targets = FindJumpTargets(instructions);
+  Flags             removed(size, false);
+  bool              changed = false;
+
+  std::size_t pc = 0;
+  while (pc + 1 < size)
+  {
+    Instruction &first = instructions[pc];
+    uint16_t     index = 0;
+
+    if (first.opcode == Opcodes::PushConstant)
+    {
+      // PushConstant, PrimitiveNegate
+      if (!jump_targets[pc + 1] && FoldOp(first, nullptr, instructions[pc + 1], index))
+      {
+        first.opcode    = GetFoldedOpcode(instructions[pc + 1].opcode);
+        first.index     = index;
+        removed[pc + 1] = true;
+        changed         = true;
+        pc += 2;
+        continue;
+      }
+
+      // PushConstant, PushConstant, Primitive<ArithmeticOp>
+      if ((pc + 2 < size) && !jump_targets[pc + 1] && !jump_targets[pc + 2] &&
+          FoldOp(first, &instructions[pc + 1], instructions[pc + 2], index))
+      {
+        first.opcode    = GetFoldedOpcode(instructions[pc + 2].opcode);
+        first.index     = index;
+        removed[pc + 1] = true;
+        removed[pc + 2] = true;
+        changed         = true;
+        pc += 3;
+        continue;
+      }
+    }
+
+    ++pc;
+  }
+
+  if (changed)
+  {
+    Compact(function, removed);
+  }
+
+  return changed;
+}
+
+bool Optimiser::EliminateDeadStores(Executable::Function &function)
+{
+  InstructionArray &instructions = function.instructions;
+  std::size_t const size         = instructions.size();
+  Flags const       jump_targets = FindJumpTargets(instructions);
+  Flags             removed(size, false);
+  bool              changed = false;
+
+  for (std::size_t pc = 1; pc < size; ++pc)
+  {
+    Instruction &      store = instructions[pc];
+    Instruction const &push  = instructions[pc - 1];
+
+    bool const is_store = (store.opcode == Opcodes::PopToLocalVariable) ||
+                          (store.opcode == Opcodes::LocalVariableDeclareAssign);
+
+    // Only a constant immediately feeding a store of a primitive can be dropped, and only when no
+    // other path can reach the store with a different stack
+    if (!is_store || (store.type_id > TypeIds::PrimitiveMaxId) || jump_targets[pc] ||
+        removed[pc - 1] || (push.opcode != Opcodes::PushConstant) ||
+        !IsDeadStore(instructions, jump_targets, pc))
+    {
+      continue;
+    }
+
+    // The pair is replaced by a single instruction charged for both. A declaration must still
+    // take place so that the variable carries its type
+    uint16_t const opcode = (store.opcode == Opcodes::LocalVariableDeclareAssign)
+                                ? Opcodes::LocalVariableDeclareDeadConstant
+                                : Opcodes::DeadConstantStore;
+
+    Instruction replacement(opcode);
+    replacement.type_id = store.type_id;
+    replacement.index   = store.index;
+    replacement.data    = store.data;
+    store               = replacement;
+
+    removed[pc - 1] = true;
+    changed         = true;
+  }
+
+  if (changed)
+  {
+    Compact(function, removed);
+  }
+
+  return changed;
+}
+
+bool Optimiser::FuseSuperInstructions(Executable::Function &function)
+{
+  InstructionArray &instructions = function.instructions;
+  std::size_t const size         = instructions.size();
+  Flags const       jump_targets = FindJumpTargets(instructions);
+  Flags             removed(size, false);
+  bool              changed = false;
+
+  for (std::size_t pc = 0; pc < size; ++pc)
+  {
+    Instruction &instruction = instructions[pc];
+
+    // PushLocalVariable x, PushConstant c, Primitive<Op>, PopToLocalVariable x
+    if ((pc + 3 < size) && (instruction.opcode == Opcodes::PushLocalVariable) &&
+        IsNumeric(instruction.type_id))
+    {
+      Instruction const &constant     = instructions[pc + 1];
+      Instruction const &op           = instructions[pc + 2];
+      Instruction const &store        = instructions[pc + 3];
+      uint16_t const     fused_opcode = GetFusedConstantOpcode(op.opcode);
+
+      if ((fused_opcode != Opcodes::Unknown) && (constant.opcode == Opcodes::PushConstant) &&
+          (store.opcode == Opcodes::PopToLocalVariable) && (store.index == instruction.index) &&
+          (op.type_id == instruction.type_id) && (store.type_id == instruction.type_id) &&
+          (executable_->constants[constant.index].type_id == instruction.type_id) &&
+          !jump_targets[pc + 1] && !jump_targets[pc + 2] && !jump_targets[pc + 3])
+      {
+        Instruction fused(fused_opcode);
+        fused.type_id = instruction.type_id;
+        fused.index   = instruction.index;
+        fused.data    = constant.index;
+        instruction   = fused;
+
+        removed[pc + 1] = true;
+        removed[pc + 2] = true;
+        removed[pc + 3] = true;
+        changed         = true;
+        pc += 3;
+        continue;
+      }
+    }
+
+    // Primitive<RelationalOp>, JumpIfFalse
+    if (pc + 1 < size)
+    {
+      Instruction const &jump         = instructions[pc + 1];
+      uint16_t const     fused_opcode = GetFusedJumpIfFalseOpcode(instruction.opcode);
+
+      if ((fused_opcode != Opcodes::Unknown) && (jump.opcode == Opcodes::JumpIfFalse) &&
+          !jump_targets[pc + 1])
+      {
+        Instruction fused(fused_opcode);
+        fused.type_id = instruction.type_id;
+        fused.index   = jump.index;
+        fused.data    = instruction.data;
+        instruction   = fused;
+
+        removed[pc + 1] = true;
+        changed         = true;
+        ++pc;
+        continue;
+      }
+    }
+  }
+
+  if (changed)
+  {
+    Compact(function, removed);
+  }
+
+  return changed;
+}
+
+void Optimiser::FuseForRangeLoops(Executable::Function &function)
+{
+  InstructionArray &instructions = function.instructions;
+  std::size_t const size         = instructions.size();
+
+  // The generator closes every for-loop body with a Jump back to its ForRangeIterate, which is
+  // immediately followed by the ForRangeTerminate that the iterate exits to
+  for (std::size_t pc = 0; pc + 1 < size; ++pc)
+  {
+    Instruction &instruction = instructions[pc];
+    if ((instruction.opcode != Opcodes::Jump) || (instruction.index >= size))
+    {
+      continue;
+    }
+
+    uint16_t const     iterate_pc = instruction.index;
+    Instruction const &iterate    = instructions[iterate_pc];
+    if ((iterate.opcode == Opcodes::ForRangeIterate) && (iterate.index == pc + 1))
+    {
+      Instruction fused(Opcodes::ForRangeIterateJump);
+      fused.index = static_cast<uint16_t>(iterate_pc + 1);  // first pc of the loop body
+      fused.data  = iterate.data;
+      instruction = fused;
+    }
+  }
+}
+
+void Optimiser::Compact(Executable::Function &function, Flags const &removed)
+{
+  InstructionArray &instructions = function.instructions;
+  std::size_t const size         = instructions.size();
+
+  // new_pcs[pc] is the new location of the first surviving instruction at or after pc
+  std::vector<uint16_t> new_pcs(size + 1);
+  uint16_t              next_pc = 0;
+  for (std::size_t pc = 0; pc < size; ++pc)
+  {
+    new_pcs[pc] = next_pc;
+    if (!removed[pc])
+    {
+      ++next_pc;
+    }
+  }
+  new_pcs[size] = next_pc;
+
+  InstructionArray compacted;
+  compacted.reserve(next_pc);
+  for (std::size_t pc = 0; pc < size; ++pc)
+  {
+    if (removed[pc])
+    {
+      continue;
+    }
+    Instruction instruction = instructions[pc];
+    if (HasJumpDestination(instruction.opcode))
+    {
+      assert(instruction.index <= size);
+      instruction.index = new_pcs[instruction.index];
+    }
+    compacted.push_back(instruction);
+  }
+  instructions = std::move(compacted);
+
+  // Where several lines collapse onto the same pc, the later (surviving) instruction's line wins
+  Executable::PcToLineMap pc_to_line_map;
+  for (auto const &it : function.pc_to_line_map)
+  {
+    pc_to_line_map[new_pcs[it.first]] = it.second;
+  }
+  function.pc_to_line_map = std::move(pc_to_line_map);
+}
+
+bool Optimiser::FoldOp(Instruction const &lhs, Instruction const *rhs, Instruction const &op,
+                       uint16_t &index)
+{
+  bool const is_unary = (rhs == nullptr);
+  if ((lhs.opcode != Opcodes::PushConstant) ||
+      (!is_unary && (rhs->opcode != Opcodes::PushConstant)))
+  {
+    return false;
+  }
+
+  switch (op.opcode)
+  {
+  case Opcodes::PrimitiveNegate:
+  {
+    if (!is_unary)
+    {
+      return false;
+    }
+    break;
+  }
+  case Opcodes::PrimitiveAdd:
+  case Opcodes::PrimitiveSubtract:
+  case Opcodes::PrimitiveMultiply:
+  case Opcodes::PrimitiveDivide:
+  case Opcodes::PrimitiveModulo:
+  {
+    if (is_unary)
+    {
+      return false;
+    }
+    break;
+  }
+  default:
+  {
+    return false;
+  }
+  }  // switch
+
+  TypeId const   type_id = op.type_id;
+  Variant const &lhsv    = executable_->constants[lhs.index];
+  Variant const *rhsv    = is_unary ? nullptr : &executable_->constants[rhs->index];
+  if ((lhsv.type_id != type_id) || ((rhsv != nullptr) && (rhsv->type_id != type_id)))
+  {
+    return false;
+  }
+
+  // NOTE: Fixed point arithmetic is deliberately not folded, its rounding and overflow behaviour
+  // is left to the runtime
+  Variant result;
+  bool    folded = false;
+  switch (type_id)
+  {
+  case TypeIds::Int8:
+  {
+    folded = Evaluate<int8_t>(op.opcode, lhsv, rhsv, type_id, result);
+    break;
+  }
+  case TypeIds::UInt8:
+  {
+    folded = Evaluate<uint8_t>(op.opcode, lhsv, rhsv, type_id, result);
+    break;
+  }
+  case TypeIds::Int16:
+  {
+    folded = Evaluate<int16_t>(op.opcode, lhsv, rhsv, type_id, result);
+    break;
+  }
+  case TypeIds::UInt16:
+  {
+    folded = Evaluate<uint16_t>(op.opcode, lhsv, rhsv, type_id, result);
+    break;
+  }
+  case TypeIds::Int32:
+  {
+    folded = Evaluate<int32_t>(op.opcode, lhsv, rhsv, type_id, result);
+    break;
+  }
+  case TypeIds::UInt32:
+  {
+    folded = Evaluate<uint32_t>(op.opcode, lhsv, rhsv, type_id, result);
+    break;
+  }
+  case TypeIds::Int64:
+  {
+    folded = Evaluate<int64_t>(op.opcode, lhsv, rhsv, type_id, result);
+    break;
+  }
+  case TypeIds::UInt64:
+  {
+    folded = Evaluate<uint64_t>(op.opcode, lhsv, rhsv, type_id, result);
+    break;
+  }
+  default:
+  {
+    break;
+  }
+  }  // switch
+
+  return folded && AddConstant(result, index);
+}
+
+bool Optimiser::AddConstant(Variant const &c, uint16_t &index)
+{
+  auto &constants = executable_->constants;
+  for (std::size_t i = 0; i < constants.size(); ++i)
+  {
+    if (IsSameConstant(constants[i], c))
+    {
+      index = static_cast<uint16_t>(i);
+      return true;
+    }
+  }
+
+  if (constants.size() >= MAX_CONSTANTS)
+  {
+    return false;
+  }
+
+  index = static_cast<uint16_t>(constants.size());
+  constants.push_back(c);
+  return true;
+}
+
+Optimiser::Flags Optimiser::FindJumpTargets(InstructionArray const &instructions)
+{
+  // One extra slot, a jump may land one past the final instruction
+  Flags jump_targets(instructions.size() + 1, false);
+  for (auto const &instruction : instructions)
+  {
+    if (HasJumpDestination(instruction.opcode) && (instruction.index < jump_targets.size()))
+    {
+      jump_targets[instruction.index] = true;
+    }
+  }
+  return jump_targets;
+}
+
+bool Optimiser::IsDeadStore(InstructionArray const &instructions, Flags const &jump_targets,
+                            std::size_t pc)
+{
+  // A store is dead if, on the straight-line path following it, the variable is overwritten or
+  // the function returns before anything reads it
+  uint16_t const variable_index = instructions[pc].index;
+  for (std::size_t next = pc + 1; next < instructions.size(); ++next)
+  {
+    if (jump_targets[next])
+    {
+      return false;
+    }
+
+    Instruction const &instruction = instructions[next];
+    switch (instruction.opcode)
+    {
+    case Opcodes::PopToLocalVariable:
+    {
+      if (instruction.index == variable_index)
+      {
+        return true;
+      }
+      break;
+    }
+    case Opcodes::Return:
+    case Opcodes::ReturnValue:
+    {
+      return true;
+    }
+    case Opcodes::ForRangeInit:
+    case Opcodes::ForRangeTerminate:
+    {
+      return false;
+    }
+    default:
+    {
+      break;
+    }
+    }  // switch
+
+    if (HasJumpDestination(instruction.opcode))
+    {
+      return false;
+    }
+
+    if (IsLocalVariableAccess(instruction.opcode) && (instruction.index == variable_index))
+    {
+      return false;
+    }
+  }
+  return false;
+}
+
+bool Optimiser::HasJumpDestination(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::Break:
+  case Opcodes::Continue:
+  case Opcodes::Jump:
+  case Opcodes::JumpIfFalse:
+  case Opcodes::JumpIfTrue:
+  case Opcodes::ForRangeIterate:
+  case Opcodes::JumpIfFalseOrPop:
+  case Opcodes::JumpIfTrueOrPop:
+  case Opcodes::PrimitiveEqualJumpIfFalse:
+  case Opcodes::PrimitiveNotEqualJumpIfFalse:
+  case Opcodes::PrimitiveLessThanJumpIfFalse:
+  case Opcodes::PrimitiveLessThanOrEqualJumpIfFalse:
+  case Opcodes::PrimitiveGreaterThanJumpIfFalse:
+  case Opcodes::PrimitiveGreaterThanOrEqualJumpIfFalse:
+  case Opcodes::ForRangeIterateJump:
+  {
+    return true;
+  }
+  default:
+  {
+    return false;
+  }
+  }  // switch
+}
+
+bool Optimiser::IsLocalVariableAccess(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::LocalVariableDeclare:
+  case Opcodes::LocalVariableDeclareAssign:
+  case Opcodes::LocalVariableDeclareDeadConstant:
+  case Opcodes::PushLocalVariable:
+  case Opcodes::PopToLocalVariable:
+  case Opcodes::LocalVariablePrefixInc:
+  case Opcodes::LocalVariablePrefixDec:
+  case Opcodes::LocalVariablePostfixInc:
+  case Opcodes::LocalVariablePostfixDec:
+  case Opcodes::LocalVariablePrimitiveInplaceAdd:
+  case Opcodes::LocalVariableObjectInplaceAdd:
+  case Opcodes::LocalVariableObjectInplaceRightAdd:
+  case Opcodes::LocalVariablePrimitiveInplaceSubtract:
+  case Opcodes::LocalVariableObjectInplaceSubtract:
+  case Opcodes::LocalVariableObjectInplaceRightSubtract:
+  case Opcodes::LocalVariablePrimitiveInplaceMultiply:
+  case Opcodes::LocalVariableObjectInplaceMultiply:
+  case Opcodes::LocalVariableObjectInplaceRightMultiply:
+  case Opcodes::LocalVariablePrimitiveInplaceDivide:
+  case Opcodes::LocalVariableObjectInplaceDivide:
+  case Opcodes::LocalVariableObjectInplaceRightDivide:
+  case Opcodes::LocalVariablePrimitiveInplaceModulo:
+  case Opcodes::LocalVariablePrimitiveAddConstant:
+  case Opcodes::LocalVariablePrimitiveSubtractConstant:
+  case Opcodes::LocalVariablePrimitiveMultiplyConstant:
+  case Opcodes::LocalVariablePrimitiveDivideConstant:
+  {
+    return true;
+  }
+  default:
+  {
+    return false;
+  }
+  }  // switch
+}
+
+uint16_t Optimiser::GetFoldedOpcode(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::PrimitiveNegate:
+  {
+    return Opcodes::PushFoldedNegate;
+  }
+  case Opcodes::PrimitiveAdd:
+  {
+    return Opcodes::PushFoldedAdd;
+  }
+  case Opcodes::PrimitiveSubtract:
+  {
+    return Opcodes::PushFoldedSubtract;
+  }
+  case Opcodes::PrimitiveMultiply:
+  {
+    return Opcodes::PushFoldedMultiply;
+  }
+  case Opcodes::PrimitiveDivide:
+  {
+    return Opcodes::PushFoldedDivide;
+  }
+  case Opcodes::PrimitiveModulo:
+  {
+    return Opcodes::PushFoldedModulo;
+  }
+  default:
+  {
+    return Opcodes::Unknown;
+  }
+  }  // switch
+}
+
+uint16_t Optimiser::GetFusedConstantOpcode(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::PrimitiveAdd:
+  {
+    return Opcodes::LocalVariablePrimitiveAddConstant;
+  }
+  case Opcodes::PrimitiveSubtract:
+  {
+    return Opcodes::LocalVariablePrimitiveSubtractConstant;
+  }
+  case Opcodes::PrimitiveMultiply:
+  {
+    return Opcodes::LocalVariablePrimitiveMultiplyConstant;
+  }
+  case Opcodes::PrimitiveDivide:
+  {
+    return Opcodes::LocalVariablePrimitiveDivideConstant;
+  }
+  default:
+  {
+    return Opcodes::Unknown;
+  }
+  }  // switch
+}
+
+uint16_t Optimiser::GetFusedJumpIfFalseOpcode(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::PrimitiveEqual:
+  {
+    return Opcodes::PrimitiveEqualJumpIfFalse;
+  }
+  case Opcodes::PrimitiveNotEqual:
+  {
+    return Opcodes::PrimitiveNotEqualJumpIfFalse;
+  }
+  case Opcodes::PrimitiveLessThan:
+  {
+    return Opcodes::PrimitiveLessThanJumpIfFalse;
+  }
+  case Opcodes::PrimitiveLessThanOrEqual:
+  {
+    return Opcodes::PrimitiveLessThanOrEqualJumpIfFalse;
+  }
+  case Opcodes::PrimitiveGreaterThan:
+  {
+    return Opcodes::PrimitiveGreaterThanJumpIfFalse;
+  }
+  case Opcodes::PrimitiveGreaterThanOrEqual:
+  {
+    return Opcodes::PrimitiveGreaterThanOrEqualJumpIfFalse;
+  }
+  default:
+  {
+    return Opcodes::Unknown;
+  }
+  }  // switch
+}
+
+}  // namespace vm
+}  // namespace fetch
@@ -32,7 +32,7 @@ namespace fetch {
 namespace vm {
 
 Parser::Parser()
-  : template_names_{"Array", "Map", "State", "ShardedState", "Pair"}
+  : template_names_{"Array", "Map", "State", "ShardedState", "StateMap", "StateArray", "Pair"}
 {}
 
 void Parser::AddTemplateName(std::string name)
@@ -18,6 +18,14 @@
 
 #include "vm/io_observer_interface.hpp"
 #include "vm/state.hpp"
+#include "vm/state_collections.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include <utility>
 
 namespace fetch {
 namespace vm {
@@ -25,7 +33,8 @@ namespace vm {
 namespace {
 
 template <typename T, typename = std::enable_if_t<IsPrimitive<T>>>
-bool ReadHelper(TypeId /*type_id*/, std::string const &name, T &val, VM *vm)
+bool ReadHelper(TypeId /*type_id*/, std::string const &name, T &val, VM *vm,
+                uint64_t *bytes_read = nullptr)
 {
   if (!vm->HasIoObserver())
   {
@@ -34,22 +43,31 @@ bool ReadHelper(TypeId /*type_id*/, std::string const &name, T &val, VM *vm)
 
   uint64_t   buffer_size = sizeof(T);
   auto const result      = vm->GetIOObserver().Read(name, &val, buffer_size);
+  if (bytes_read != nullptr)
+  {
+    *bytes_read = buffer_size;
+  }
   return result == IoObserverInterface::Status::OK;
 }
 
 template <typename T, typename = std::enable_if_t<IsPrimitive<T>>>
-bool WriteHelper(std::string const &name, T const &val, VM *vm)
+bool WriteHelper(std::string const &name, T const &val, VM *vm, uint64_t *bytes_written = nullptr)
 {
   if (!vm->HasIoObserver())
   {
     return true;
   }
 
+  if (bytes_written != nullptr)
+  {
+    *bytes_written = sizeof(T);
+  }
   auto const result = vm->GetIOObserver().Write(name, &val, sizeof(T));
   return result == IoObserverInterface::Status::OK;
 }
 
-bool ReadHelper(TypeId type_id, std::string const &name, Ptr<Object> &val, VM *vm)
+bool ReadHelper(TypeId type_id, std::string const &name, Ptr<Object> &val, VM *vm,
+                uint64_t *bytes_read = nullptr)
 {
   using fetch::byte_array::ByteArray;
 
@@ -96,6 +114,11 @@ bool ReadHelper(TypeId type_id, std::string const &name, Ptr<Object> &val, VM *v
   // if we successfully extracted the data
   if (IoObserverInterface::Status::OK == result)
   {
+    if (bytes_read != nullptr)
+    {
+      *bytes_read = buffer_size;
+    }
+
     MsgPackSerializer byte_buffer{buffer};
 
     retval = val->DeserializeFrom(byte_buffer);
@@ -111,7 +134,8 @@ bool ReadHelper(TypeId type_id, std::string const &name, Ptr<Object> &val, VM *v
   return retval;
 }
 
-bool WriteHelper(std::string const &name, Ptr<Object> const &val, VM *vm)
+bool WriteHelper(std::string const &name, Ptr<Object> const &val, VM *vm,
+                 uint64_t *bytes_written = nullptr)
 {
   if (!vm->HasIoObserver())
   {
@@ -135,6 +159,10 @@ bool WriteHelper(std::string const &name, Ptr<Object> const &val, VM *vm)
     return false;
   }
 
+  if (bytes_written != nullptr)
+  {
+    *bytes_written = buffer.data().size();
+  }
   auto const result =
       vm->GetIOObserver().Write(name, buffer.data().pointer(), buffer.data().size());
   return result == IoObserverInterface::Status::OK;
@@ -309,6 +337,536 @@ struct StateFactory<T, std::enable_if_t<IsMetatype<T>>>
   }
 };
 
+template <typename Value>
+bool ExtractValue(VM * /*vm*/, Variant const &input, Value &output)
+{
+  output = input.Get<Value>();
+  return true;
+}
+
+bool ExtractValue(VM *vm, Variant const &input, Ptr<Object> &output)
+{
+  output = input.Get<Ptr<Object>>();
+  if (!output)
+  {
+    vm->RuntimeError("Input value is null reference.");
+    return false;
+  }
+  return true;
+}
+
+void ChargeIO(VM *vm, uint64_t bytes)
+{
+  vm->IncreaseChargeTotal(static_cast<ChargeAmount>(bytes));
+}
+
+template <typename Flush>
+void FlushOnDestruction(VM *vm, std::string const &type_name, Flush &&flush)
+{
+  try
+  {
+    flush();
+  }
+  catch (std::exception const &ex)
+  {
+    // TODO(issue 1094): Support for nested runtime error(s) and/or exception(s)
+    vm->RuntimeError("An exception has been thrown from " + type_name +
+                     "<...>::FlushIO(). Desc.: " + std::string(ex.what()));
+  }
+  catch (...)
+  {
+    // TODO(issue 1094): Support for nested runtime error(s) and/or exception(s)
+    vm->RuntimeError("An exception has been thrown from " + type_name + "<...>::FlushIO().");
+  }
+}
+
+/**
+ * Write-back cache for the entries of a state collection, each of which lives under its own key
+ * in the state database. Entries are read on first access, and only the modified ones are
+ * written by Flush().
+ */
+template <typename T>
+class EntryCache
+{
+public:
+  using Value = typename GetStorageType<T>::type;
+
+  EntryCache(VM *vm, TypeId value_type_id)
+    : vm_{vm}
+    , value_type_id_{value_type_id}
+  {}
+
+  /// Returns the cached value stored under `key`, or null if there is no such entry (or it could
+  /// not be read, in which case a runtime error has been raised)
+  Value *Find(std::string const &key)
+  {
+    auto it = entries_.find(key);
+    if (it == entries_.end())
+    {
+      Entry entry{};
+      if (vm_->HasIoObserver() && (Status::OK == vm_->GetIOObserver().Exists(key)))
+      {
+        uint64_t bytes_read{0};
+        if (!ReadHelper(value_type_id_, key, entry.value, vm_, &bytes_read))
+        {
+          if (!vm_->HasError())
+          {
+            vm_->RuntimeError("Failure of reading state from the storage.");
+          }
+          return nullptr;
+        }
+        ChargeIO(vm_, bytes_read);
+        entry.present = true;
+      }
+      it = entries_.emplace(key, std::move(entry)).first;
+    }
+
+    Entry &entry = it->second;
+    return entry.present ? &entry.value : nullptr;
+  }
+
+  void Store(std::string const &key, Value value)
+  {
+    Entry &entry  = entries_[key];
+    entry.value   = std::move(value);
+    entry.present = true;
+    entry.dirty   = true;
+  }
+
+  void Flush()
+  {
+    for (auto &it : entries_)
+    {
+      Entry &entry = it.second;
+      if (vm_->HasError())
+      {
+        return;
+      }
+      if (!entry.dirty)
+      {
+        continue;
+      }
+
+      uint64_t bytes_written{0};
+      if (!WriteHelper(it.first, entry.value, vm_, &bytes_written))
+      {
+        if (!vm_->HasError())
+        {
+          vm_->RuntimeError("Failure of writing state to the storage.");
+        }
+        return;
+      }
+      ChargeIO(vm_, bytes_written);
+      entry.dirty = false;
+    }
+  }
+
+private:
+  using Status = IoObserverInterface::Status;
+
+  struct Entry
+  {
+    Value value{};
+    bool  present{false};
+    bool  dirty{false};
+  };
+
+  // ordered, so that the sequence of writes to the storage is deterministic
+  using EntryMap = std::map<std::string, Entry>;
+
+  VM *     vm_;
+  TypeId   value_type_id_;
+  EntryMap entries_;
+};
+
+bool IsValidStateMapKeyType(TypeId type_id)
+{
+  return ((TypeIds::Bool <= type_id) && (type_id <= TypeIds::UInt64)) ||
+         (type_id == TypeIds::String) || (type_id == TypeIds::Address);
+}
+
+bool EncodeStateMapKey(Variant const &key, std::string &encoded)
+{
+  switch (key.type_id)
+  {
+  case TypeIds::Bool:
+    encoded = key.Get<bool>() ? "1" : "0";
+    return true;
+  case TypeIds::Int8:
+    encoded = std::to_string(key.Get<int8_t>());
+    return true;
+  case TypeIds::UInt8:
+    encoded = std::to_string(key.Get<uint8_t>());
+    return true;
+  case TypeIds::Int16:
+    encoded = std::to_string(key.Get<int16_t>());
+    return true;
+  case TypeIds::UInt16:
+    encoded = std::to_string(key.Get<uint16_t>());
+    return true;
+  case TypeIds::Int32:
+    encoded = std::to_string(key.Get<int32_t>());
+    return true;
+  case TypeIds::UInt32:
+    encoded = std::to_string(key.Get<uint32_t>());
+    return true;
+  case TypeIds::Int64:
+    encoded = std::to_string(key.Get<int64_t>());
+    return true;
+  case TypeIds::UInt64:
+    encoded = std::to_string(key.Get<uint64_t>());
+    return true;
+  case TypeIds::String:
+  {
+    auto const &str = key.Get<Ptr<String>>();
+    if (str)
+    {
+      encoded = str->string();
+      return true;
+    }
+    return false;
+  }
+  case TypeIds::Address:
+  {
+    auto const &address = key.Get<Ptr<Address>>();
+    if (address)
+    {
+      encoded = address->AsString()->string();
+      return true;
+    }
+    return false;
+  }
+  default:
+    return false;
+  }
+}
+
+template <typename T>
+class StateMap : public IStateMap
+{
+public:
+  StateMap(VM *vm, TypeId type_id, TypeId value_type_id, Ptr<String> const &name)
+    : IStateMap(vm, type_id)
+    , name_{name->string()}
+    , value_type_id_{value_type_id}
+    , entries_{vm, value_type_id}
+  {}
+
+  ~StateMap() override
+  {
+    FlushOnDestruction(vm_, "StateMap", [this]() { entries_.Flush(); });
+  }
+
+  TemplateParameter2 Get(TemplateParameter1 const &key) override
+  {
+    Value const *value = Find(key);
+    if (value != nullptr)
+    {
+      return {*value, value_type_id_};
+    }
+    if (!vm_->HasError())
+    {
+      RuntimeError("map key does not exist");
+    }
+    return {};
+  }
+
+  TemplateParameter2 GetWithDefault(TemplateParameter1 const &key,
+                                    TemplateParameter2 const &default_value) override
+  {
+    Value const *value = Find(key);
+    if (value != nullptr)
+    {
+      return {*value, value_type_id_};
+    }
+    if (vm_->HasError())
+    {
+      return {};
+    }
+    return default_value;
+  }
+
+  void Set(TemplateParameter1 const &key, TemplateParameter2 const &value) override
+  {
+    std::string full_key;
+    Value       v{};
+    if (ComposeFullKey(key, full_key) && ExtractValue(vm_, value, v))
+    {
+      entries_.Store(full_key, std::move(v));
+    }
+  }
+
+  bool Has(TemplateParameter1 const &key) override
+  {
+    return Find(key) != nullptr;
+  }
+
+  TemplateParameter2 GetIndexedValue(TemplateParameter1 const &key) override
+  {
+    return Get(key);
+  }
+
+  void SetIndexedValue(TemplateParameter1 const &key, TemplateParameter2 const &value) override
+  {
+    Set(key, value);
+  }
+
+private:
+  using Value = typename EntryCache<T>::Value;
+
+  bool ComposeFullKey(TemplateParameter1 const &key, std::string &full_key)
+  {
+    std::string encoded;
+    if (!EncodeStateMapKey(key, encoded))
+    {
+      RuntimeError("Key is null reference.");
+      return false;
+    }
+    full_key = name_ + "." + encoded;
+    return true;
+  }
+
+  Value *Find(TemplateParameter1 const &key)
+  {
+    std::string full_key;
+    if (!ComposeFullKey(key, full_key))
+    {
+      return nullptr;
+    }
+    return entries_.Find(full_key);
+  }
+
+  std::string   name_;
+  TypeId        value_type_id_;
+  EntryCache<T> entries_;
+};
+
+template <typename T>
+class StateArray : public IStateArray
+{
+public:
+  StateArray(VM *vm, TypeId type_id, TypeId value_type_id, Ptr<String> const &name)
+    : IStateArray(vm, type_id)
+    , name_{name->string()}
+    , value_type_id_{value_type_id}
+    , elements_{vm, value_type_id}
+  {}
+
+  ~StateArray() override
+  {
+    FlushOnDestruction(vm_, "StateArray", [this]() { FlushIO(); });
+  }
+
+  int32_t Count() override
+  {
+    LoadCount();
+    return static_cast<int32_t>(count_);
+  }
+
+  void Append(TemplateParameter1 const &value) override
+  {
+    LoadCount();
+    if (vm_->HasError())
+    {
+      return;
+    }
+    if (count_ >= static_cast<uint64_t>(std::numeric_limits<int32_t>::max()))
+    {
+      RuntimeError("StateArray has reached its maximum size");
+      return;
+    }
+
+    Value v{};
+    if (ExtractValue(vm_, value, v))
+    {
+      elements_.Store(ElementKey(count_), std::move(v));
+      ++count_;
+      count_modified_ = true;
+    }
+  }
+
+  TemplateParameter1 PopBack() override
+  {
+    LoadCount();
+    if (vm_->HasError())
+    {
+      return {};
+    }
+    if (count_ == 0)
+    {
+      RuntimeError("popBack called on empty StateArray");
+      return {};
+    }
+
+    // The popped element is left in the storage, it is simply no longer addressable
+    Value const *value = FindElement(count_ - 1);
+    if (value == nullptr)
+    {
+      return {};
+    }
+    TemplateParameter1 popped{*value, value_type_id_};
+    --count_;
+    count_modified_ = true;
+    return popped;
+  }
+
+  TemplateParameter1 GetIndexedValue(AnyInteger const &index) override
+  {
+    std::size_t i{0};
+    if (CheckIndex(index, i))
+    {
+      Value const *value = FindElement(i);
+      if (value != nullptr)
+      {
+        return {*value, value_type_id_};
+      }
+    }
+    return {};
+  }
+
+  void SetIndexedValue(AnyInteger const &index, TemplateParameter1 const &value) override
+  {
+    std::size_t i{0};
+    Value       v{};
+    if (CheckIndex(index, i) && ExtractValue(vm_, value, v))
+    {
+      elements_.Store(ElementKey(i), std::move(v));
+    }
+  }
+
+private:
+  using Value  = typename EntryCache<T>::Value;
+  using Status = IoObserverInterface::Status;
+
+  std::string ElementKey(uint64_t index) const
+  {
+    return name_ + "." + std::to_string(index);
+  }
+
+  void LoadCount()
+  {
+    if (count_loaded_)
+    {
+      return;
+    }
+    count_loaded_ = true;
+
+    if (vm_->HasIoObserver() && (Status::OK == vm_->GetIOObserver().Exists(name_)))
+    {
+      uint64_t bytes_read{0};
+      if (!ReadHelper(TypeIds::UInt64, name_, count_, vm_, &bytes_read))
+      {
+        RuntimeError("Failure of reading state from the storage.");
+        return;
+      }
+      ChargeIO(vm_, bytes_read);
+    }
+  }
+
+  bool CheckIndex(AnyInteger const &index, std::size_t &i)
+  {
+    LoadCount();
+    if (vm_->HasError())
+    {
+      return false;
+    }
+    if (!GetNonNegativeInteger(index, i))
+    {
+      RuntimeError("negative index");
+      return false;
+    }
+    if (i >= count_)
+    {
+      RuntimeError("index out of bounds");
+      return false;
+    }
+    return true;
+  }
+
+  Value *FindElement(uint64_t index)
+  {
+    Value *value = elements_.Find(ElementKey(index));
+    if ((value == nullptr) && !vm_->HasError())
+    {
+      RuntimeError("StateArray element " + std::to_string(index) + " is missing from the storage");
+    }
+    return value;
+  }
+
+  void FlushIO()
+  {
+    if (count_modified_ && !vm_->HasError())
+    {
+      uint64_t bytes_written{0};
+      if (!WriteHelper(name_, count_, vm_, &bytes_written))
+      {
+        if (!vm_->HasError())
+        {
+          RuntimeError("Failure of writing state to the storage.");
+        }
+        return;
+      }
+      ChargeIO(vm_, bytes_written);
+      count_modified_ = false;
+    }
+
+    elements_.Flush();
+  }
+
+  std::string   name_;
+  TypeId        value_type_id_;
+  EntryCache<T> elements_;
+  uint64_t      count_{0};
+  bool          count_loaded_{false};
+  bool          count_modified_{false};
+};
+
+template <typename T, typename = void>
+struct StateMapFactory;
+
+template <typename T>
+struct StateMapFactory<T, std::enable_if_t<!IsMetatype<T>>>
+{
+  template <typename... Args>
+  Ptr<IStateMap> operator()(Args &&... args)
+  {
+    return Ptr<IStateMap>{new StateMap<T>{std::forward<Args>(args)...}};
+  }
+};
+
+template <typename T>
+struct StateMapFactory<T, std::enable_if_t<IsMetatype<T>>>
+{
+  template <typename... Args>
+  Ptr<IStateMap> operator()(Args &&... /*unused*/)
+  {
+    return {};
+  }
+};
+
+template <typename T, typename = void>
+struct StateArrayFactory;
+
+template <typename T>
+struct StateArrayFactory<T, std::enable_if_t<!IsMetatype<T>>>
+{
+  template <typename... Args>
+  Ptr<IStateArray> operator()(Args &&... args)
+  {
+    return Ptr<IStateArray>{new StateArray<T>{std::forward<Args>(args)...}};
+  }
+};
+
+template <typename T>
+struct StateArrayFactory<T, std::enable_if_t<IsMetatype<T>>>
+{
+  template <typename... Args>
+  Ptr<IStateArray> operator()(Args &&... /*unused*/)
+  {
+    return {};
+  }
+};
+
 }  // namespace
 
 Ptr<IState> IState::ConstructorFromString(VM *vm, TypeId type_id, Ptr<String> const &name)
@@ -340,5 +898,51 @@ Ptr<IState> IState::ConstructIntrinsic(VM *vm, TypeId type_id, TypeId template_p
                                              template_param_type_id, name);
 }
 
+Ptr<IStateMap> IStateMap::ConstructorFromString(VM *vm, TypeId type_id, Ptr<String> const &name)
+{
+  if (!name)
+  {
+    vm->RuntimeError("Failed to construct StateMap: the `name` is null reference");
+    return {};
+  }
+
+  TypeInfo const &type_info     = vm->GetTypeInfo(type_id);
+  TypeId const    key_type_id   = type_info.template_parameter_type_ids[0];
+  TypeId const    value_type_id = type_info.template_parameter_type_ids[1];
+  if (!IsValidStateMapKeyType(key_type_id))
+  {
+    vm->RuntimeError("Failed to construct StateMap: keys of type " + vm->GetTypeName(key_type_id) +
+                     " are not supported");
+    return {};
+  }
+
+  return TypeIdAsCanonicalType<StateMapFactory>(value_type_id, vm, type_id, value_type_id, name);
+}
+
+Ptr<IStateMap> IStateMap::ConstructorFromAddress(VM *vm, TypeId type_id, Ptr<Address> const &name)
+{
+  return ConstructorFromString(vm, type_id, name ? name->AsString() : Ptr<String>{});
+}
+
+Ptr<IStateArray> IStateArray::ConstructorFromString(VM *vm, TypeId type_id,
+                                                    Ptr<String> const &name)
+{
+  if (!name)
+  {
+    vm->RuntimeError("Failed to construct StateArray: the `name` is null reference");
+    return {};
+  }
+
+  TypeInfo const &type_info     = vm->GetTypeInfo(type_id);
+  TypeId const    value_type_id = type_info.template_parameter_type_ids[0];
+  return TypeIdAsCanonicalType<StateArrayFactory>(value_type_id, vm, type_id, value_type_id, name);
+}
+
+Ptr<IStateArray> IStateArray::ConstructorFromAddress(VM *vm, TypeId type_id,
+                                                     Ptr<Address> const &name)
+{
+  return ConstructorFromString(vm, type_id, name ? name->AsString() : Ptr<String>{});
+}
+
 }  // namespace vm
 }  // namespace fetch
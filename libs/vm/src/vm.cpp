@@ -235,6 +235,77 @@ VM::VM(Module *module)
   AddOpcodeInfo(Opcodes::InvokeUserDefinedMemberFunction, "InvokeUserDefinedMemberFunction",
                 [](VM *vm) { vm->Handler__InvokeUserDefinedMemberFunction(); });
 
+  AddSuperInstructionInfo(
+      Opcodes::LocalVariablePrimitiveAddConstant, "LocalVariablePrimitiveAddConstant",
+      [](VM *vm) { vm->Handler__LocalVariablePrimitiveAddConstant(); },
+      {Opcodes::PushLocalVariable, Opcodes::PushConstant, Opcodes::PrimitiveAdd,
+       Opcodes::PopToLocalVariable});
+  AddSuperInstructionInfo(
+      Opcodes::LocalVariablePrimitiveSubtractConstant, "LocalVariablePrimitiveSubtractConstant",
+      [](VM *vm) { vm->Handler__LocalVariablePrimitiveSubtractConstant(); },
+      {Opcodes::PushLocalVariable, Opcodes::PushConstant, Opcodes::PrimitiveSubtract,
+       Opcodes::PopToLocalVariable});
+  AddSuperInstructionInfo(
+      Opcodes::LocalVariablePrimitiveMultiplyConstant, "LocalVariablePrimitiveMultiplyConstant",
+      [](VM *vm) { vm->Handler__LocalVariablePrimitiveMultiplyConstant(); },
+      {Opcodes::PushLocalVariable, Opcodes::PushConstant, Opcodes::PrimitiveMultiply,
+       Opcodes::PopToLocalVariable});
+  AddSuperInstructionInfo(
+      Opcodes::LocalVariablePrimitiveDivideConstant, "LocalVariablePrimitiveDivideConstant",
+      [](VM *vm) { vm->Handler__LocalVariablePrimitiveDivideConstant(); },
+      {Opcodes::PushLocalVariable, Opcodes::PushConstant, Opcodes::PrimitiveDivide,
+       Opcodes::PopToLocalVariable});
+  AddSuperInstructionInfo(Opcodes::PrimitiveEqualJumpIfFalse, "PrimitiveEqualJumpIfFalse",
+                          [](VM *vm) { vm->Handler__PrimitiveEqualJumpIfFalse(); },
+                          {Opcodes::PrimitiveEqual, Opcodes::JumpIfFalse});
+  AddSuperInstructionInfo(Opcodes::PrimitiveNotEqualJumpIfFalse, "PrimitiveNotEqualJumpIfFalse",
+                          [](VM *vm) { vm->Handler__PrimitiveNotEqualJumpIfFalse(); },
+                          {Opcodes::PrimitiveNotEqual, Opcodes::JumpIfFalse});
+  AddSuperInstructionInfo(Opcodes::PrimitiveLessThanJumpIfFalse, "PrimitiveLessThanJumpIfFalse",
+                          [](VM *vm) { vm->Handler__PrimitiveLessThanJumpIfFalse(); },
+                          {Opcodes::PrimitiveLessThan, Opcodes::JumpIfFalse});
+  AddSuperInstructionInfo(Opcodes::PrimitiveLessThanOrEqualJumpIfFalse,
+                          "PrimitiveLessThanOrEqualJumpIfFalse",
+                          [](VM *vm) { vm->Handler__PrimitiveLessThanOrEqualJumpIfFalse(); },
+                          {Opcodes::PrimitiveLessThanOrEqual, Opcodes::JumpIfFalse});
+  AddSuperInstructionInfo(Opcodes::PrimitiveGreaterThanJumpIfFalse,
+                          "PrimitiveGreaterThanJumpIfFalse",
+                          [](VM *vm) { vm->Handler__PrimitiveGreaterThanJumpIfFalse(); },
+                          {Opcodes::PrimitiveGreaterThan, Opcodes::JumpIfFalse});
+  AddSuperInstructionInfo(Opcodes::PrimitiveGreaterThanOrEqualJumpIfFalse,
+                          "PrimitiveGreaterThanOrEqualJumpIfFalse",
+                          [](VM *vm) { vm->Handler__PrimitiveGreaterThanOrEqualJumpIfFalse(); },
+                          {Opcodes::PrimitiveGreaterThanOrEqual, Opcodes::JumpIfFalse});
+  AddSuperInstructionInfo(Opcodes::ForRangeIterateJump, "ForRangeIterateJump",
+                          [](VM *vm) { vm->Handler__ForRangeIterateJump(); },
+                          {Opcodes::Jump, Opcodes::ForRangeIterate});
+
+  // Folded constants and dead stores execute as a plain push (or nothing at all) but are still
+  // charged for the instructions they replace
+  auto const push_folded = [](VM *vm) { vm->Handler__PushConstant(); };
+  AddSuperInstructionInfo(Opcodes::PushFoldedNegate, "PushFoldedNegate", push_folded,
+                          {Opcodes::PushConstant, Opcodes::PrimitiveNegate});
+  AddSuperInstructionInfo(Opcodes::PushFoldedAdd, "PushFoldedAdd", push_folded,
+                          {Opcodes::PushConstant, Opcodes::PushConstant, Opcodes::PrimitiveAdd});
+  AddSuperInstructionInfo(
+      Opcodes::PushFoldedSubtract, "PushFoldedSubtract", push_folded,
+      {Opcodes::PushConstant, Opcodes::PushConstant, Opcodes::PrimitiveSubtract});
+  AddSuperInstructionInfo(
+      Opcodes::PushFoldedMultiply, "PushFoldedMultiply", push_folded,
+      {Opcodes::PushConstant, Opcodes::PushConstant, Opcodes::PrimitiveMultiply});
+  AddSuperInstructionInfo(
+      Opcodes::PushFoldedDivide, "PushFoldedDivide", push_folded,
+      {Opcodes::PushConstant, Opcodes::PushConstant, Opcodes::PrimitiveDivide});
+  AddSuperInstructionInfo(
+      Opcodes::PushFoldedModulo, "PushFoldedModulo", push_folded,
+      {Opcodes::PushConstant, Opcodes::PushConstant, Opcodes::PrimitiveModulo});
+  AddSuperInstructionInfo(Opcodes::DeadConstantStore, "DeadConstantStore", [](VM * /*vm*/) {},
+                          {Opcodes::PushConstant, Opcodes::PopToLocalVariable});
+  AddSuperInstructionInfo(Opcodes::LocalVariableDeclareDeadConstant,
+                          "LocalVariableDeclareDeadConstant",
+                          [](VM *vm) { vm->Handler__LocalVariableDeclare(); },
+                          {Opcodes::PushConstant, Opcodes::LocalVariableDeclareAssign});
+
   opcode_map_.clear();
   for (uint16_t i = 0; i < num_functions; ++i)
   {
@@ -244,6 +315,8 @@ VM::VM(Module *module)
     opcode_map_[info.unique_name] = opcode;
   }
 
+  UpdateSuperInstructionCharges();
+
   generator_.Initialise(this, num_types);
 }
 
@@ -426,6 +499,29 @@ void VM::UpdateCharges(std::unordered_map<std::string, ChargeAmount> const &opco
       it->static_charge = entry.second;
     }
   }
+
+  UpdateSuperInstructionCharges();
+}
+
+void VM::UpdateSuperInstructionCharges()
+{
+  // A superinstruction costs exactly what the sequence it replaces would have cost
+  for (auto const &entry : super_instructions_)
+  {
+    ChargeAmount charge{0};
+    for (auto const opcode : entry.second)
+    {
+      ChargeAmount const amount =
+          std::max(opcode_info_array_[opcode].static_charge, ChargeAmount{1});
+      if ((std::numeric_limits<ChargeAmount>::max() - charge) < amount)
+      {
+        charge = std::numeric_limits<ChargeAmount>::max();
+        break;
+      }
+      charge += amount;
+    }
+    opcode_info_array_[entry.first].static_charge = charge;
+  }
 }
 
 }  // namespace vm
@@ -337,7 +337,8 @@ void VM::Handler__ForRangeInit()
   RuntimeError("for stack overflow");
 }
 
-void VM::Handler__ForRangeIterate()
+// Advances the innermost range loop, returning true once it has run its course
+bool VM::ForRangeStep()
 {
   ForRangeLoop &loop     = range_loop_stack_[range_loop_sp_];
   Variant &     variable = GetLocalVariable(loop.variable_index);
@@ -467,7 +468,12 @@ void VM::Handler__ForRangeIterate()
     }
     }  // switch
   }
-  if (finished)
+  return finished;
+}
+
+void VM::Handler__ForRangeIterate()
+{
+  if (ForRangeStep())
   {
     pc_ = instruction_->index;
   }
@@ -1093,5 +1099,65 @@ void VM::Handler__InvokeUserDefinedMemberFunction()
   RuntimeError("null reference");
 }
 
+void VM::Handler__LocalVariablePrimitiveAddConstant()
+{
+  DoLocalVariableNumericConstantOp<PrimitiveAdd>();
+}
+
+void VM::Handler__LocalVariablePrimitiveSubtractConstant()
+{
+  DoLocalVariableNumericConstantOp<PrimitiveSubtract>();
+}
+
+void VM::Handler__LocalVariablePrimitiveMultiplyConstant()
+{
+  DoLocalVariableNumericConstantOp<PrimitiveMultiply>();
+}
+
+void VM::Handler__LocalVariablePrimitiveDivideConstant()
+{
+  DoLocalVariableNumericConstantOp<PrimitiveDivide>();
+}
+
+void VM::Handler__PrimitiveEqualJumpIfFalse()
+{
+  DoPrimitiveRelationalJumpIfFalseOp<PrimitiveEqual>();
+}
+
+void VM::Handler__PrimitiveNotEqualJumpIfFalse()
+{
+  DoPrimitiveRelationalJumpIfFalseOp<PrimitiveNotEqual>();
+}
+
+void VM::Handler__PrimitiveLessThanJumpIfFalse()
+{
+  DoPrimitiveRelationalJumpIfFalseOp<PrimitiveLessThan>();
+}
+
+void VM::Handler__PrimitiveLessThanOrEqualJumpIfFalse()
+{
+  DoPrimitiveRelationalJumpIfFalseOp<PrimitiveLessThanOrEqual>();
+}
+
+void VM::Handler__PrimitiveGreaterThanJumpIfFalse()
+{
+  DoPrimitiveRelationalJumpIfFalseOp<PrimitiveGreaterThan>();
+}
+
+void VM::Handler__PrimitiveGreaterThanOrEqualJumpIfFalse()
+{
+  DoPrimitiveRelationalJumpIfFalseOp<PrimitiveGreaterThanOrEqual>();
+}
+
+// Replaces the Jump back to a ForRangeIterate at the end of a loop body: loop back to the start of
+// the body while iterating, otherwise fall through to the ForRangeTerminate
+void VM::Handler__ForRangeIterateJump()
+{
+  if (!ForRangeStep())
+  {
+    pc_ = instruction_->index;
+  }
+}
+
 }  // namespace vm
 }  // namespace fetch